@@ -0,0 +1,40 @@
+from typing import Any
+
+from hwprobe.models.cpu_models import CPUCacheInfo, CPUInfo
+from hwprobe.models.size_models import Kilobyte
+
+# Mirrors CPU_CACHE_* in interops/common/include/cpu_topology.h
+CACHE_TYPE_ENUM = {
+    0: "Unified",
+    1: "Instruction",
+    2: "Data",
+    3: "Trace",
+}
+
+
+def apply_cpu_topology(cpu_info: CPUInfo, topology: Any) -> None:
+    """
+    Fills the package count, the performance / efficiency core split and the cache hierarchy of `cpu_info` from a
+    native `CPUTopology` (interops/common/cpu_topology.py). Core and thread counts are left to the caller.
+    """
+    cpu_info.packages = topology.packages or None
+
+    classes = topology.core_classes
+    hybrid = len(classes) > 1
+    if hybrid:
+        # Fastest class first; everything slower counts as efficiency cores
+        cpu_info.performance_cores = classes[0].cores
+        cpu_info.efficiency_cores = sum(c.cores for c in classes[1:])
+
+    cpu_info.caches = [
+        CPUCacheInfo(
+            level=cache.level,
+            type=CACHE_TYPE_ENUM.get(cache.type, "Unknown"),
+            size=Kilobyte(capacity=cache.size_bytes // 1024) if cache.size_bytes else None,
+            instances=cache.instances or 1,
+            shared_by_threads=cache.threads_per_instance or None,
+            core_type=("Performance" if cache.core_class == 0 else "Efficiency")
+            if hybrid and cache.core_class is not None else None,
+        )
+        for cache in topology.caches
+    ]
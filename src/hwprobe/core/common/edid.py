@@ -1,3 +1,5 @@
+from typing import Any, Dict, Tuple
+
 from hwprobe.models.display_models import DisplayModuleInfo, ResolutionInfo
 
 BIT_DEPTH_ENUM = {
@@ -24,6 +26,14 @@ DESCRIPTOR_TAG_ENUM = {
     0xFC: "Display Product Name",
 }
 
+# Mirrors EDID_INTERFACE_* / EDID_FLAG_HDMI in interops/common/include/edid.h
+_NATIVE_INTERFACE_ANALOG = 0xFE
+_NATIVE_INTERFACE_NOT_REPORTED = 0xFF
+_NATIVE_FLAG_HDMI = 0x10
+
+# device_path -> (EDID hash, fields derived from it), see module_from_native_edid
+_native_fields_cache: Dict[str, Tuple[int, Dict[str, Any]]] = {}
+
 
 def _get_bits(data: bytes, start_bit: int, end_bit: int) -> int:
     # Get the bit values in an offset, given a bytes object.
@@ -125,4 +135,48 @@ def parse_edid(edid_data: bytes) -> DisplayModuleInfo:
 
     return module
 
-# todo: parse extension blocks
\ No newline at end of file
+# todo: parse extension blocks (the native reader behind module_from_native_edid does)
+
+
+def _native_edid_fields(monitor) -> Dict[str, Any]:
+    fields: Dict[str, Any] = {
+        "name": monitor.name,
+        "year": monitor.year,
+        "serial_number": monitor.serial_text,
+        "manufacturer_code": monitor.manufacturer_code,
+    }
+    resolution: Dict[str, Any] = {}
+
+    if monitor.interface == _NATIVE_INTERFACE_ANALOG:
+        fields["interface"] = "Analog"
+    elif monitor.interface != _NATIVE_INTERFACE_NOT_REPORTED:
+        if monitor.interface == 0 and monitor.flags & _NATIVE_FLAG_HDMI:
+            fields["interface"] = INTERFACE_ENUM[2]
+        else:
+            fields["interface"] = INTERFACE_ENUM.get(monitor.interface, "Unknown")
+        resolution["bit_depth"] = monitor.bit_depth
+
+    # Largest detailed timing, CTA-861 and DisplayID extensions included
+    if monitor.max_width:
+        resolution["width"] = monitor.max_width
+        resolution["height"] = monitor.max_height
+        resolution["refresh_rate"] = round(monitor.max_refresh_mhz / 1000, 2)
+
+    fields["resolution"] = resolution
+    return fields
+
+
+def module_from_native_edid(monitor) -> DisplayModuleInfo:
+    """
+    The DisplayModuleInfo `parse_edid` would build, from an EDID decoded by the native library
+    (`interops/common/edid_info.py` EDIDProperties). What is derived from a monitor is kept until its
+    (device_path, hash) changes, so unchanged monitors are not decoded again on the next poll.
+    """
+    cached = _native_fields_cache.get(monitor.device_path)
+    if cached is None or cached[0] != monitor.hash:
+        cached = (monitor.hash, _native_edid_fields(monitor))
+        _native_fields_cache[monitor.device_path] = cached
+
+    fields = dict(cached[1])
+    fields["resolution"] = ResolutionInfo(**fields["resolution"])
+    return DisplayModuleInfo(**fields)
@@ -2,6 +2,7 @@ import re
 import subprocess
 from typing import Optional, List
 
+from hwprobe.core.common.cpu import apply_cpu_topology
 from hwprobe.models.cpu_models import CPUInfo
 from hwprobe.models.status_models import StatusType
 
@@ -64,35 +65,45 @@ def _x86_flags(cpu_lines: str) -> Optional[List[str]]:
     if not flags_match:
         return None
 
-    flags = flags_match.group(1)
+    return _normalize_flags(flags_match.group(1))
+
+
+def _normalize_flags(flags: str) -> List[str]:
+    """`sse4_1 sse4_2 lm` -> `["SSE4.1", "SSE4.2", "LM"]`"""
     flags = [x.lower().strip() for x in flags.split(" ")]
-    flags = [
+    return [
         flag.replace("_", ".").upper() for flag in flags if flag
     ]
-    return flags
 
 
 def fetch_arm_cpu_info(raw_cpu_info: str) -> CPUInfo:
+    return _build_arm_cpu_info(
+        _arm_cpu_model(raw_cpu_info), _arm_version(raw_cpu_info), _cpu_threads(raw_cpu_info), _arm_cpu_cores()
+    )
+
+
+def _build_arm_cpu_info(name: Optional[str], arch_version: Optional[str], threads: Optional[int],
+                        cores: Optional[int]) -> CPUInfo:
     cpu_info = CPUInfo()
 
     cpu_info.architecture = "ARM"
 
-    cpu_info.name = _arm_cpu_model(raw_cpu_info)
+    cpu_info.name = name
     if not cpu_info.name:
         cpu_info.status.type = StatusType.PARTIAL
         cpu_info.status.messages.append("Could not find model name")
 
-    cpu_info.arch_version = _arm_version(raw_cpu_info)
+    cpu_info.arch_version = arch_version
     if not cpu_info.arch_version:
         cpu_info.status.type = StatusType.PARTIAL
         cpu_info.status.messages.append("Could not find architecture")
 
-    cpu_info.threads = _cpu_threads(raw_cpu_info)
+    cpu_info.threads = threads
     if not cpu_info.threads:
         cpu_info.status.type = StatusType.PARTIAL
         cpu_info.status.messages.append("Could not find CPU threads")
 
-    cpu_info.cores = _arm_cpu_cores()
+    cpu_info.cores = cores
     if not cpu_info.cores:
         cpu_info.status.type = StatusType.PARTIAL
         cpu_info.status.messages.append("Could not find CPU cores")
@@ -102,13 +113,11 @@ def fetch_arm_cpu_info(raw_cpu_info: str) -> CPUInfo:
 
 
 def fetch_x86_cpu_info(raw_cpu_info: str) -> CPUInfo:
-    cpu_info = CPUInfo()
-
-    cpu_info.architecture = "x86"
-
     info_lines = [x for x in raw_cpu_info.split("\n\n") if x.strip("\n")]
 
     if not info_lines:
+        cpu_info = CPUInfo()
+        cpu_info.architecture = "x86"
         cpu_info.status.type = StatusType.FAILED
         cpu_info.status.messages.append("Could not parse CPU info")
         return cpu_info
@@ -117,7 +126,18 @@ def fetch_x86_cpu_info(raw_cpu_info: str) -> CPUInfo:
     # To get the info, we only need to parse the first entry - i.e. the first CPU Thread
     cpu_lines = info_lines[0]
 
-    if name := _x86_cpu_model(cpu_lines):
+    # The number of CPU Threads is the number of times the processor data is enumerated.
+    return _build_x86_cpu_info(_x86_cpu_model(cpu_lines), _x86_flags(cpu_lines), _x86_cpu_cores(cpu_lines),
+                               len(info_lines))
+
+
+def _build_x86_cpu_info(name: Optional[str], flags: Optional[List[str]], cores: Optional[int],
+                        threads: int) -> CPUInfo:
+    cpu_info = CPUInfo()
+
+    cpu_info.architecture = "x86"
+
+    if name:
         cpu_info.name = name
         cpu_info.vendor = "intel" if "intel" in name.lower() else "amd" if "amd" in name.lower() else "unknown"
     else:
@@ -125,8 +145,6 @@ def fetch_x86_cpu_info(raw_cpu_info: str) -> CPUInfo:
         cpu_info.status.messages.append("Could not find CPU name and vendor")
 
     # The CPU flags are in the format of "flags : sse sse2 sse3 ssse3 sse4_1 sse4_2 lm"
-    flags = _x86_flags(cpu_lines)
-
     if flags:
         cpu_info.sse_flags = [f for f in flags if "SSE" in f]
         # If "lm" is in flags, then x86-64 Long Mode is supported
@@ -139,19 +157,58 @@ def fetch_x86_cpu_info(raw_cpu_info: str) -> CPUInfo:
         cpu_info.bitness = 32
 
     # Cores are in the format of "cores : 6"
-    if cores := _x86_cpu_cores(cpu_lines):
+    if cores:
         cpu_info.cores = cores
     else:
         cpu_info.status.type = StatusType.PARTIAL
         cpu_info.status.messages.append("Could not find cpu cores")
 
-    # The number of CPU Threads is the number of times the processor data is enumerated.
-    cpu_info.threads = len(info_lines)
+    cpu_info.threads = threads
 
     return cpu_info
 
 
-def fetch_cpu_info() -> CPUInfo:
+def _native_cpu_info() -> Optional[CPUInfo]:
+    """
+    The same result built from interops/linux, which parses /proc/cpuinfo and reads the sysfs topology
+    in-process instead of running `uname` and `lscpu`, plus the packages, core classes and caches of the
+    native topology probe. None if libdevice_info.so is not available.
+    """
+    try:
+        from hwprobe.interops.linux.bindings.cpu_info import get_cpu_info
+        cpu = get_cpu_info()
+    except (FileNotFoundError, OSError, RuntimeError):
+        return None
+
+    machine = cpu.machine or ""
+    if ("aarch64" in machine) or ("arm" in machine):
+        cpu_info = _build_arm_cpu_info(cpu.model_name, cpu.arch_version, cpu.threads or None, cpu.cores or None)
+    else:
+        flags = _normalize_flags(cpu.flags) if cpu.flags else None
+        cpu_info = _build_x86_cpu_info(cpu.model_name, flags, cpu.cores_per_package or None, cpu.threads)
+
+    if (topology := _native_topology()) is not None:
+        apply_cpu_topology(cpu_info, topology)
+    return cpu_info
+
+
+def _native_topology():
+    """Packages, core classes and caches from interops/linux; None if the library lacks them."""
+    try:
+        from hwprobe.interops.linux.bindings.cpu_topology import topology
+        return topology.read()
+    except (FileNotFoundError, OSError):
+        return None
+
+
+def fetch_cpu_info(native: bool = False) -> CPUInfo:
+    """
+    Args:
+        native: Read through libdevice_info.so when it is available (see `_native_cpu_info`).
+    """
+    if native and (cpu_info := _native_cpu_info()) is not None:
+        return cpu_info
+
     cpu_info = CPUInfo()
 
     # todo: Check if any of the regexes may suffer from string having two `\t`s
@@ -2,7 +2,7 @@ import os
 import re
 from typing import Optional
 
-from hwprobe.core.common.edid import parse_edid, INTERFACE_ENUM
+from hwprobe.core.common.edid import module_from_native_edid, parse_edid, INTERFACE_ENUM
 from hwprobe.core.linux.common import pci_path_linux
 from hwprobe.models.display_models import DisplayInfo, DisplayModuleInfo
 from hwprobe.models.status_models import StatusType
@@ -69,7 +69,46 @@ def _fetch_individual_monitor_info(device_path: str) -> Optional[DisplayModuleIn
     return monitor_data
 
 
-def fetch_display_info():
+def _native_display_info() -> Optional[DisplayInfo]:
+    """
+    The same result built from interops/linux, which reads every connector's EDID in one call and decodes it
+    natively, extension blocks included. None if libdevice_info.so (or its EDID reader) is not available.
+    """
+    try:
+        from hwprobe.interops.linux.bindings.edid_info import edid
+    except (FileNotFoundError, OSError):
+        return None
+
+    monitors = edid.read()
+    if monitors is None:
+        return None
+
+    display_info = DisplayInfo()
+    for monitor in monitors:
+        if not monitor.valid:
+            if monitor.size:
+                display_info.status.type = StatusType.PARTIAL
+                display_info.status.messages.append(f"Display Info ({monitor.device_path}): EDID could not be decoded")
+            continue
+
+        module = module_from_native_edid(monitor)
+        if connector_type := _parse_connector_type(monitor.device_path):
+            module.interface = connector_type
+        module.pci_path = monitor.pci_path
+        module.acpi_path = monitor.acpi_path
+        display_info.modules.append(module)
+
+    return display_info
+
+
+def fetch_display_info(native: bool = False) -> DisplayInfo:
+    """
+    Args:
+        native: Read through libdevice_info.so when it is available (see `_native_display_info`).
+    """
+    if native and (display_info := _native_display_info()) is not None:
+        return display_info
+
     display_info = DisplayInfo()
     pattern = re.compile(r"^card\d+$")
     root_path = "/sys/class/drm"
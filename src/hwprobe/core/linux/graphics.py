@@ -117,7 +117,69 @@ def _populate_lspci_info(gpu: GPUInfo, device: str) -> GPUInfo:
     return gpu
 
 
-def fetch_graphics_info() -> GraphicsInfo:
+def _native_graphics_info() -> Optional[GraphicsInfo]:
+    """
+    The same result built from interops/linux, which reads every display controller's attributes through one
+    directory descriptor and names it from pci.ids in-process instead of running `lspci` per GPU.
+    NVIDIA GPUs get their VRAM from NVML, loaded in-process, instead of one `nvidia-smi` per GPU.
+    None if libdevice_info.so is not available.
+    """
+    try:
+        from hwprobe.interops.linux.bindings.gpu_info import get_gpu_info
+        gpus = get_gpu_info()
+    except (FileNotFoundError, OSError, RuntimeError):
+        return None
+
+    graphics_info = GraphicsInfo()
+
+    for raw in gpus:
+        gpu = GPUInfo()
+        gpu.vendor_id = f"0x{raw.vendor_id:04x}"
+        gpu.device_id = f"0x{raw.device_id:04x}"
+        if raw.pcie_width > 0:
+            gpu.pcie_width = raw.pcie_width
+
+        if raw.acpi_path:
+            gpu.acpi_path = raw.acpi_path
+        else:
+            graphics_info.status.make_partial(f"Could not get ACPI path for GPU {raw.slot}")
+        gpu.pci_path = raw.pci_path
+
+        if raw.pcie_gen:
+            gpu.pcie_gen = raw.pcie_gen
+        else:
+            graphics_info.status.make_partial("Could not get PCI gen")
+
+        if raw.vram_mb:
+            gpu.vram = Megabyte(capacity=raw.vram_mb)
+        elif raw.vendor_id == 0x10DE:
+            # nvidia-smi is an NVML client too: when the library could not use NVML, neither could it
+            graphics_info.status.make_partial(f"Could not get VRAM for NVIDIA GPU {raw.slot}: NVML not available")
+
+        # pci.ids names, as `lspci -vmm` would report them
+        if raw.device_name:
+            gpu.manufacturer = raw.vendor_name
+            gpu.name = raw.device_name
+            gpu.subsystem_manufacturer = raw.subsystem_vendor_name
+            gpu.subsystem_model = raw.subsystem_device_name
+        elif raw.product_name:
+            gpu.name = raw.product_name
+        else:
+            graphics_info.status.make_partial(f"Could not find GPU {raw.slot} in pci.ids")
+
+        graphics_info.modules.append(gpu)
+
+    return graphics_info
+
+
+def fetch_graphics_info(native: bool = False) -> GraphicsInfo:
+    """
+    Args:
+        native: Read through libdevice_info.so when it is available (see `_native_graphics_info`).
+    """
+    if native and (graphics_info := _native_graphics_info()) is not None:
+        return graphics_info
+
     graphics_info = GraphicsInfo()
 
     if not os.path.exists(PCI_ROOT_PATH):
@@ -22,7 +22,15 @@ class LinuxHardwareManager(HardwareManagerInterface):
     Uses the `sysfs` pseudo file system to extract info.
     """
 
-    def __init__(self):
+    def __init__(self, native: bool = True):
+        """
+        Args:
+            native: Read CPU, graphics and network info through the native library
+                (`interops/linux`, libdevice_info.so) instead of spawning `lscpu`, `uname`, `lspci` and
+                `ip`, decode monitor EDIDs there, and take memory modules from its SMBIOS table. Falls back
+                to the pure-Python readers when the library is not available.
+        """
+        self._native = native
         self.info = LinuxHardwareInfo(
             cpu=CPUInfo(),
             graphics=GraphicsInfo(),
@@ -32,11 +40,11 @@ class LinuxHardwareManager(HardwareManagerInterface):
         )
 
     def fetch_cpu_info(self) -> CPUInfo:
-        self.info.cpu = fetch_cpu_info()
+        self.info.cpu = fetch_cpu_info(native=self._native)
         return self.info.cpu
 
     def fetch_memory_info(self) -> MemoryInfo:
-        self.info.memory = fetch_memory_info()
+        self.info.memory = fetch_memory_info(native=self._native)
         return self.info.memory
 
     def fetch_storage_info(self) -> StorageInfo:
@@ -44,7 +52,7 @@ class LinuxHardwareManager(HardwareManagerInterface):
         return self.info.storage
 
     def fetch_graphics_info(self) -> GraphicsInfo:
-        self.info.graphics = fetch_graphics_info()
+        self.info.graphics = fetch_graphics_info(native=self._native)
         return self.info.graphics
 
     def fetch_hardware_info(self) -> HardwareInfo:
@@ -56,7 +64,7 @@ class LinuxHardwareManager(HardwareManagerInterface):
         return self.info
 
     def fetch_display_info(self) -> DisplayInfo:
-        return fetch_display_info()
+        return fetch_display_info(native=self._native)
 
     def fetch_network_info(self) -> NetworkInfo:
-        return fetch_network_info()
+        return fetch_network_info(native=self._native)
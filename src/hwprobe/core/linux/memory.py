@@ -97,7 +97,79 @@ def _dimm_speed(value: bytes) -> Optional[int]:
     return None
 
 
-def fetch_memory_info() -> MemoryInfo:
+def _add_module(memory_info: MemoryInfo, value: bytes) -> None:
+    """Decodes one Type 17 structure, formatted area and string-set (a `raw` DMI entry), into `memory_info`."""
+    module = MemoryModuleInfo()
+    try:
+        length_field = value[0x1]
+        strings = value[length_field:len(value)].split(b'\0')
+
+        module.part_number = _part_no(strings, value)
+
+        if (t := _dimm_type(value)) is not None:
+            module.type = t
+        else:
+            memory_info.status.type = StatusType.PARTIAL
+            memory_info.status.messages.append("Could not get DIMM Type")
+
+        if (slot := _dimm_slot(strings, value)) is not None:
+            module.slot = slot
+        else:
+            memory_info.status.type = StatusType.PARTIAL
+            memory_info.status.messages.append("Could not get DIMM Location")
+
+        module.manufacturer = get_string_entry(strings, value[0x17])
+        if not module.manufacturer:
+            memory_info.status.type = StatusType.PARTIAL
+            memory_info.status.messages.append("Could not get DIMM Manufacturer")
+
+        if (capacity := _dimm_capacity(value)) is not None:
+            module.capacity = capacity
+        else:
+            memory_info.status.type = StatusType.PARTIAL
+            memory_info.status.messages.append("Could not get DIMM Capacity")
+
+        module.supports_ecc = _ecc_support(value)
+        module.frequency_mhz = _dimm_speed(value)
+
+        memory_info.modules.append(module)
+
+    except Exception as e:
+        memory_info.status.type = StatusType.PARTIAL
+        memory_info.status.messages.append("Error while fetching Memory Info: " + str(e))
+
+
+def _native_memory_info() -> Optional[MemoryInfo]:
+    """
+    The same result decoded from the SMBIOS table interops/linux reads once (/sys/firmware/dmi/tables/DMI), instead
+    of opening one /sys/firmware/dmi/entries/17-*/raw file per module. None if libdevice_info.so is not available
+    or could not read the table (the file is root-only), so the caller falls back and reports why.
+    """
+    try:
+        from hwprobe.interops.linux.bindings.smbios_info import get_structures, get_version, read_structure
+        if get_version() is None:
+            return None
+        structures = [read_structure(s.handle) for s in get_structures(17)]
+    except (FileNotFoundError, OSError):
+        return None
+    if any(raw is None for raw in structures):
+        # Library built before smbios_read_structure()
+        return None
+
+    memory_info = MemoryInfo()
+    for value in structures:
+        _add_module(memory_info, value)
+    return memory_info
+
+
+def fetch_memory_info(native: bool = False) -> MemoryInfo:
+    """
+    Args:
+        native: Read through libdevice_info.so when it is available (see `_native_memory_info`).
+    """
+    if native and (memory_info := _native_memory_info()) is not None:
+        return memory_info
+
     memory_info = MemoryInfo()
 
     if not os.path.isdir("/sys/firmware/dmi/entries"):
@@ -120,7 +192,6 @@ def fetch_memory_info() -> MemoryInfo:
     parent_dirs = [p for p in dmi_entries if p.path.split("/")[-1].startswith(memory_dmi_types)]
 
     for parent_dir in parent_dirs:
-        module = MemoryModuleInfo()
         try:
             with open(f"{parent_dir.path}/raw", "rb") as f:
                 value = f.read()
@@ -134,41 +205,5 @@ def fetch_memory_info() -> MemoryInfo:
             memory_info.status.messages.append("Error Reading DMI Entries: " + str(e))
             continue
 
-        try:
-            length_field = value[0x1]
-            strings = value[length_field:len(value)].split(b'\0')
-
-            module.part_number = _part_no(strings, value)
-
-            if (t := _dimm_type(value)) is not None:
-                module.type = t
-            else:
-                memory_info.status.type = StatusType.PARTIAL
-                memory_info.status.messages.append("Could not get DIMM Type")
-
-            if (slot := _dimm_slot(strings, value)) is not None:
-                module.slot = slot
-            else:
-                memory_info.status.type = StatusType.PARTIAL
-                memory_info.status.messages.append("Could not get DIMM Location")
-
-            module.manufacturer = get_string_entry(strings, value[0x17])
-            if not module.manufacturer:
-                memory_info.status.type = StatusType.PARTIAL
-                memory_info.status.messages.append("Could not get DIMM Manufacturer")
-
-            if (capacity := _dimm_capacity(value)) is not None:
-                module.capacity = capacity
-            else:
-                memory_info.status.type = StatusType.PARTIAL
-                memory_info.status.messages.append("Could not get DIMM Capacity")
-
-            module.supports_ecc = _ecc_support(value)
-            module.frequency_mhz = _dimm_speed(value)
-
-            memory_info.modules.append(module)
-
-        except Exception as e:
-            memory_info.status.type = StatusType.PARTIAL
-            memory_info.status.messages.append("Error while fetching Memory Info: " + str(e))
+        _add_module(memory_info, value)
     return memory_info
@@ -1,6 +1,7 @@
 import json
 import os
 import subprocess
+from typing import Optional
 
 from hwprobe.core.linux.common import pci_path_linux
 from hwprobe.models.network_models import NetworkInfo, NICInfo
@@ -88,6 +89,57 @@ def _fetch_ip_data() -> NetworkInfo:
     return network_info
 
 
-def fetch_network_info() -> NetworkInfo:
+def _native_network_info() -> Optional[NetworkInfo]:
+    """
+    The same result built from interops/linux, which reads sysfs and getifaddrs() in-process instead of
+    running `ip -json addr show`. None if libdevice_info.so is not available.
+    """
+    try:
+        from hwprobe.interops.linux.bindings.network_info import get_network_info
+        nics = get_network_info()
+    except (FileNotFoundError, OSError, RuntimeError):
+        return None
+
+    network_info = NetworkInfo()
+
+    for raw in nics:
+        # Virtual interfaces have no backing device
+        if not raw.device_slot:
+            continue
+
+        nic = NICInfo()
+        nic.interface = raw.interface
+        nic.type = raw.link_type
+        nic.mac_address = raw.mac_address
+        # Prefer IPv4, fallback to IPv6
+        nic.ip_address = raw.ipv4_address or raw.ipv6_address
+
+        if raw.vendor_id:
+            nic.vendor_id = f"0x{raw.vendor_id:04x}"
+        else:
+            network_info.status.make_partial(f"Vendor ID not found for interface {raw.interface}")
+        if raw.device_id:
+            nic.device_id = f"0x{raw.device_id:04x}"
+        else:
+            network_info.status.make_partial(f"Device ID not found for interface {raw.interface}")
+        if raw.acpi_path:
+            nic.acpi_path = raw.acpi_path
+        else:
+            network_info.status.make_partial(f"Path not found for interface {raw.interface}")
+        nic.pci_path = raw.pci_path
+
+        network_info.modules.append(nic)
+
+    return network_info
+
+
+def fetch_network_info(native: bool = False) -> NetworkInfo:
+    """
+    Args:
+        native: Read through libdevice_info.so when it is available (see `_native_network_info`).
+    """
+    if native and (network_info := _native_network_info()) is not None:
+        return network_info
+
     ip_data = _fetch_ip_data()
     return ip_data
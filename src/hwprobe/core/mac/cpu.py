@@ -1,9 +1,22 @@
 import subprocess
 
+from hwprobe.core.common.cpu import apply_cpu_topology
 from hwprobe.models.cpu_models import CPUInfo
 from hwprobe.models.status_models import StatusType
 
 
+def _native_topology():
+    """
+    Packages, performance levels and caches from libdevice_info.dylib (interops/mac, hw.perflevel* sysctls).
+    None if the dylib is not available or predates the export.
+    """
+    try:
+        from hwprobe.interops.mac.bindings.cpu_topology import topology
+        return topology.read()
+    except (FileNotFoundError, OSError):
+        return None
+
+
 def fetch_cpu_info() -> CPUInfo:
     cpu_info = CPUInfo()
 
@@ -138,4 +151,7 @@ def fetch_cpu_info() -> CPUInfo:
             cpu_info.status.type = StatusType.PARTIAL
             cpu_info.status.messages.append("Unable to determine ARM Version: " + str(e))
 
+    if (topology := _native_topology()) is not None:
+        apply_cpu_topology(cpu_info, topology)
+
     return cpu_info
@@ -1,9 +1,15 @@
+from contextlib import nullcontext
+from typing import Optional
+
 from hwprobe.core.mac.cpu import fetch_cpu_info
 from hwprobe.core.mac.display import fetch_display_info
 from hwprobe.core.mac.graphics import fetch_graphics_info
 from hwprobe.core.mac.memory import fetch_memory_info
 from hwprobe.core.mac.network import fetch_network_info
 from hwprobe.core.mac.storage import fetch_storage_info
+from hwprobe.interops.common.device_watch import (
+    DEVICE_WATCH_GPU, DEVICE_WATCH_STORAGE, ChangeCache, DeviceWatch,
+)
 from hwprobe.models.cpu_models import CPUInfo
 from hwprobe.models.gpu_models import GraphicsInfo
 from hwprobe.models.info_models import HardwareInfo
@@ -11,15 +17,52 @@ from hwprobe.models.info_models import HardwareManagerInterface
 from hwprobe.models.info_models import MacHardwareInfo
 from hwprobe.models.memory_models import MemoryInfo
 from hwprobe.models.network_models import NetworkInfo
+from hwprobe.models.status_models import StatusType
 from hwprobe.models.storage_models import StorageInfo
 
 
+def _open_device_watch() -> Optional[DeviceWatch]:
+    """The process-wide hot-plug watch, started; None if the native library cannot provide one."""
+    try:
+        from hwprobe.interops.mac.bindings.device_watch import watch
+    except (FileNotFoundError, OSError):
+        return None
+    return watch if watch.start() else None
+
+
+def _snapshot_binding():
+    """The native snapshot binding, or None if the native library is not available."""
+    try:
+        from hwprobe.interops.mac.bindings import device_snapshot
+    except (FileNotFoundError, OSError):
+        return None
+    return device_snapshot
+
+
+def _probe_binding():
+    """The native parallel probe binding, or None if the native library is not available."""
+    try:
+        from hwprobe.interops.mac.bindings import probe_all
+    except (FileNotFoundError, OSError):
+        return None
+    return probe_all
+
+
 class MacHardwareManager(HardwareManagerInterface):
     """
     Uses `sysctl` and IOreg to extract info.
     """
 
-    def __init__(self):
+    def __init__(self, watch_changes: bool = False, snapshot_path: Optional[str] = None):
+        """
+        Args:
+            watch_changes: Subscribe to hot-plug notifications and reuse the previous storage and
+                graphics results until a device of that category is added or removed. Network and
+                display results carry live state (addresses, current mode) and are always re-probed.
+            snapshot_path: Inventory snapshot file for short-lived processes. If it is valid for this
+                boot and this set of devices, native GPU/storage queries are served from it; otherwise
+                ``fetch_hardware_info()`` probes live and rewrites it.
+        """
         self.info = MacHardwareInfo(
             cpu=CPUInfo(),
             graphics=GraphicsInfo(),
@@ -27,6 +70,15 @@ class MacHardwareManager(HardwareManagerInterface):
             storage=StorageInfo(),
             network=NetworkInfo(),
         )
+        self._cache = ChangeCache(
+            _open_device_watch() if watch_changes else None,
+            keep=lambda info: info.status.type != StatusType.FAILED,
+        )
+
+        self._snapshot_path = snapshot_path
+        self._snapshot = _snapshot_binding() if snapshot_path else None
+        self._snapshot_loaded = self._snapshot.load(snapshot_path) if self._snapshot is not None else None
+        self._snapshot_current = self._snapshot_loaded is not None
 
     def fetch_cpu_info(self) -> CPUInfo:
         self.info.cpu = fetch_cpu_info()
@@ -37,11 +89,13 @@ class MacHardwareManager(HardwareManagerInterface):
         return self.info.memory
 
     def fetch_storage_info(self) -> StorageInfo:
-        self.info.storage = fetch_storage_info()
+        with self._serve_snapshot():
+            self.info.storage = self._cache.get(DEVICE_WATCH_STORAGE, fetch_storage_info)
         return self.info.storage
 
     def fetch_graphics_info(self) -> GraphicsInfo:
-        self.info.graphics = fetch_graphics_info()
+        with self._serve_snapshot():
+            self.info.graphics = self._cache.get(DEVICE_WATCH_GPU, fetch_graphics_info)
         return self.info.graphics
 
     def fetch_display_info(self):
@@ -52,10 +106,33 @@ class MacHardwareManager(HardwareManagerInterface):
         self.info.network = fetch_network_info()
         return self.info.network
 
+    def _serve_snapshot(self):
+        """Answer the native GPU / storage queries inside the block from the loaded snapshot, if there is one."""
+        if self._snapshot_loaded is None:
+            return nullcontext()
+        return self._snapshot.activate(self._snapshot_loaded)
+
+    def _prefetch(self):
+        """Enumerate GPUs and storage concurrently, skipping what a cache or snapshot already answers."""
+        probe = _probe_binding()
+        if probe is None or self._snapshot_current:
+            return nullcontext()
+
+        jobs = []
+        if not self._cache.fresh(DEVICE_WATCH_GPU):
+            jobs.append(probe.GPU_JOB)
+        if not self._cache.fresh(DEVICE_WATCH_STORAGE):
+            jobs.append(probe.STORAGE_JOB)
+        return probe.prefetch(jobs)
+
     def fetch_hardware_info(self) -> HardwareInfo:
-        self.fetch_cpu_info()
-        self.fetch_graphics_info()
-        self.fetch_memory_info()
-        self.fetch_storage_info()
-        self.fetch_network_info()
+        with self._serve_snapshot(), self._prefetch():
+            self.fetch_cpu_info()
+            self.fetch_graphics_info()
+            self.fetch_memory_info()
+            self.fetch_storage_info()
+            self.fetch_network_info()
+
+        if self._snapshot is not None and not self._snapshot_current:
+            self._snapshot_current = self._snapshot.store(self._snapshot_path)
         return self.info
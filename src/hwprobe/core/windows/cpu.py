@@ -4,6 +4,7 @@ import winreg
 from ctypes import wintypes
 from typing import List
 
+from hwprobe.core.common.cpu import apply_cpu_topology
 from hwprobe.core.windows.win_enum import FEATURE_ID_MAP
 from hwprobe.models.cpu_models import CPUInfo
 from hwprobe.models.status_models import StatusType
@@ -11,6 +12,8 @@ from hwprobe.models.status_models import StatusType
 kernel32 = ctypes.WinDLL("kernel32", use_last_error=True)
 kernel32.IsProcessorFeaturePresent.argtypes = [wintypes.DWORD]
 kernel32.IsProcessorFeaturePresent.restype = wintypes.BOOL
+kernel32.GetLogicalProcessorInformationEx.argtypes = [ctypes.c_int, ctypes.c_void_p, ctypes.POINTER(wintypes.DWORD)]
+kernel32.GetLogicalProcessorInformationEx.restype = wintypes.BOOL
 
 
 def is_processor_feature_present(feature_id: int) -> bool:
@@ -83,58 +86,57 @@ def parse_registry():
 
 def get_core_count() -> int:
     """
-    Uses the GetLogicalProcessorInformation function in the Win32 API to get the number of physical cores.
-    https://learn.microsoft.com/en-us/windows/win32/api/sysinfoapi/nf-sysinfoapi-getlogicalprocessorinformation
+    Uses the GetLogicalProcessorInformationEx function in the Win32 API to get the number of physical cores.
+    https://learn.microsoft.com/en-us/windows/win32/api/sysinfoapi/nf-sysinfoapi-getlogicalprocessorinformationex
+
+    GetLogicalProcessorInformation only reports the processor group of the calling thread, i.e. at most
+    64 logical processors; the Ex form reports the cores of every group.
     """
 
     """
-    typedef struct _SYSTEM_LOGICAL_PROCESSOR_INFORMATION {
-        ULONG_PTR ProcessorMask;
+    typedef struct _SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX {
         LOGICAL_PROCESSOR_RELATIONSHIP Relationship;
-        union {
-            struct {
-                BYTE Flags;
-            } ProcessorCore;
-            struct {
-                DWORD NodeNumber;
-            } NumaNode;
-            CACHE_DESCRIPTOR Cache;
-            ULONGLONG Reserved[2];
-        };
-    } SYSTEM_LOGICAL_PROCESSOR_INFORMATION;
-    
-    ProcessorMask - Pointer - 8 bytes
-    Relationship - DWORD - 4 bytes
-    Padding - 4 byt
-    Union - must be large enough to hold the largest member - 16 bytes
-    Total size = 8 + 4 + 4 + 16 = 32 bytes
-    """
-
-    class SYSTEM_LOGICAL_PROCESSOR_INFORMATION(ctypes.Structure):
-        _fields_ = [
-            ("ProcessorMask", ctypes.c_size_t),
-            ("Relationship", ctypes.c_int),
-            ("Reserved", ctypes.c_byte * 20),
-        ]
+        DWORD Size;
+        union { ... };
+    } SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX;
 
+    The records are variable-sized: each one starts with its Relationship and its Size in bytes.
+    Queried with RelationProcessorCore, there is one record per physical core.
+    """
     RelationProcessorCore = 0
 
-    buffer_size = ctypes.c_ulong(0)
-    ctypes.windll.kernel32.GetLogicalProcessorInformation(None, ctypes.byref(buffer_size))
-
-    count = buffer_size.value // ctypes.sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION)
-    buffer = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION * count)()
+    buffer_size = wintypes.DWORD(0)
+    kernel32.GetLogicalProcessorInformationEx(RelationProcessorCore, None, ctypes.byref(buffer_size))
+    if not buffer_size.value:
+        return 0
+
+    buffer = ctypes.create_string_buffer(buffer_size.value)
+    if not kernel32.GetLogicalProcessorInformationEx(RelationProcessorCore, buffer, ctypes.byref(buffer_size)):
+        return 0
+
+    data = buffer.raw[:buffer_size.value]
+    physical_cores = 0
+    offset = 0
+    while offset + 8 <= len(data):
+        size = int.from_bytes(data[offset + 4:offset + 8], "little")
+        if not size:
+            break
+        physical_cores += 1
+        offset += size
 
-    ctypes.windll.kernel32.GetLogicalProcessorInformation(
-        buffer,
-        ctypes.byref(buffer_size)
-    )
+    return physical_cores
 
-    physical_cores = sum(
-        1 for info in buffer if info.Relationship == RelationProcessorCore
-    )
 
-    return physical_cores
+def _native_topology():
+    """
+    The processor topology from device_info.dll (interops/win), which also reads the core classes of hybrid CPUs
+    and the cache hierarchy. None if the DLL is not available or predates the export.
+    """
+    try:
+        from hwprobe.interops.win.bindings.cpu_topology import topology
+        return topology.read()
+    except (FileNotFoundError, OSError):
+        return None
 
 
 def fetch_cpu_info() -> CPUInfo:
@@ -176,12 +178,16 @@ def fetch_cpu_info() -> CPUInfo:
         cpu_info.status.type = StatusType.PARTIAL
         cpu_info.status.messages.append("Unknown architecture: " + architecture)
 
-    cpu_info.cores = get_core_count()
+    topology = _native_topology()
+    if topology is not None:
+        apply_cpu_topology(cpu_info, topology)
+
+    cpu_info.cores = (topology.cores if topology is not None else 0) or get_core_count()
     if not cpu_info.cores:
         cpu_info.status.type = StatusType.PARTIAL
         cpu_info.status.messages.append(f"Unable to fetch Core Count: {cpu_info.cores}")
 
-    cpu_info.threads = os.cpu_count()
+    cpu_info.threads = (topology.threads if topology is not None else 0) or os.cpu_count()
     if not cpu_info.threads:
         cpu_info.status.type = StatusType.PARTIAL
         cpu_info.status.messages.append(f"Unable to fetch Threads: {cpu_info.threads}")
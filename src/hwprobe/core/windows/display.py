@@ -44,6 +44,8 @@ from hwprobe.interops.win.legacy.signatures import (
     EnumDisplaySettingsA,
     EnumDisplayDevicesA,
     GetDisplayPathInfo,
+    GetDisplayAdapterMap,
+    GetDisplayTopology,
     EnumDisplayMonitors,
 )
 from hwprobe.interops.win.legacy.structs import (
@@ -52,6 +54,8 @@ from hwprobe.interops.win.legacy.structs import (
     MONITORINFOEXA,
     DEVMODEA,
     DISPLAY_DEVICEA,
+    DisplayAdapterEntry,
+    DisplayPathRecord,
     MONITORENUMPROC,
 )
 from hwprobe.models.display_models import DisplayInfo, DisplayModuleInfo
@@ -75,6 +79,18 @@ _EDID_HEIGHT_CM_OFFSET = 22
 _EDID_SERIAL_MARKER = b"\x00\x00\x00\xff"
 _EDID_NAME_MARKER = b"\x00\x00\x00\xfc"
 
+# Initial capacity for GetDisplayAdapterMap; retried once with the reported count if exceeded
+_ADAPTER_MAP_CAPACITY = 16
+
+# Initial capacity for GetDisplayTopology, grown the same way
+_TOPOLOGY_CAPACITY = 16
+
+# Last GetDisplayTopology result; reused while the native generation counter is unchanged
+_topology_cache = {"generation": None, "connector_info": None}
+
+# Upper-cased monitor interface path -> (EDID hash, parsed EDID dict), see _fetch_edid_map
+_edid_cache = {}
+
 # Orientation display names
 _ORIENTATION_NAMES = {
     DMDO_DEFAULT: "Landscape",
@@ -129,8 +145,8 @@ def parse_connector_info(connector_info_string: str) -> Optional[dict]:
     Parse connector information string into a structured dictionary.
 
     The connector info string format (from interop DLL):
-        "DisplayID=\\\\.\\DISPLAY1|DisplayPath=\\\\?\\DISPLAY#...|OutputTechnology=5\\n
-         DisplayID=\\\\.\\DISPLAY2|DisplayPath=\\\\?\\DISPLAY#...|OutputTechnology=10"
+        "DisplayID=\\\\.\\DISPLAY1|DisplayPath=\\\\?\\DISPLAY#...|OutputTechnology=5|AdapterLUID=...\\n
+         DisplayID=\\\\.\\DISPLAY2|DisplayPath=\\\\?\\DISPLAY#...|OutputTechnology=10|AdapterLUID=..."
 
     Args:
         connector_info_string: Raw connector info string with newline-separated devices
@@ -333,6 +349,66 @@ def find_monitor_gpu(device_name: str) -> tuple[Optional[str], int]:
     return (gpu_name if gpu_name else None), result_code
 
 
+def _fetch_display_adapter_map() -> Optional[dict]:
+    """
+    Resolve every display output to its GPU in one DXGI pass (batched ``find_monitor_gpu``).
+
+    Returns:
+        Dictionary with two views of the same entries, or None if the DLL lacks
+        GetDisplayAdapterMap or the call fails:
+        {
+            "by_device": {"\\\\.\\DISPLAY1": "NVIDIA GeForce ...", ...},
+            "by_luid": {"0000000000012C4F": "NVIDIA GeForce ...", ...}
+        }
+        LUID keys use the same format as ``AdapterLUID`` in the connector info.
+    """
+    if GetDisplayAdapterMap is None:
+        return None
+
+    capacity = _ADAPTER_MAP_CAPACITY
+    count = ctypes.c_int(0)
+    for _ in range(2):
+        entries = (DisplayAdapterEntry * capacity)()
+        result_code = GetDisplayAdapterMap(entries, capacity, ctypes.byref(count))
+        if result_code == STATUS_OK:
+            break
+        if count.value <= capacity:
+            return None
+        capacity = count.value
+    else:
+        return None
+
+    by_device = {}
+    by_luid = {}
+    for entry in entries[:count.value]:
+        gpu_name = entry.adapterName.decode("utf-8", errors="ignore") or None
+        luid = f"{entry.adapterLuidHigh & 0xFFFFFFFF:08X}{entry.adapterLuidLow:08X}"
+        by_device[entry.deviceName.decode("utf-8", errors="ignore")] = gpu_name
+        by_luid[luid] = gpu_name
+
+    return {"by_device": by_device, "by_luid": by_luid}
+
+
+def _resolve_monitor_gpu(
+    device_id: str, connector_info: Optional[dict], adapter_map: Optional[dict]
+) -> Optional[str]:
+    """
+    GPU name for a monitor, from the batched adapter map when one was fetched.
+
+    Falls back to matching the connector's adapter LUID (outputs DXGI does not list,
+    e.g. indirect displays), then to a per-monitor ``find_monitor_gpu`` call.
+    """
+    if adapter_map is not None:
+        gpu_name = adapter_map["by_device"].get(device_id)
+        if gpu_name is None and connector_info:
+            gpu_name = adapter_map["by_luid"].get(connector_info.get("AdapterLUID"))
+        if gpu_name is not None:
+            return gpu_name
+
+    gpu_name, gpu_result_code = find_monitor_gpu(device_id)
+    return gpu_name if gpu_result_code == STATUS_OK else None
+
+
 # =============================================================================
 # Registry EDID Lookup
 # =============================================================================
@@ -516,6 +592,63 @@ def _try_get_edid_for_interface(device_info_set, interface_data, hwid_upper: str
         RegCloseKey(registry_key)
 
 
+def _edid_from_native(monitor) -> Optional[dict]:
+    """The ``parse_edid`` dictionary for an EDID decoded by device_info.dll (EDIDProperties)."""
+    if not monitor.valid:
+        return None
+
+    return {
+        "manufacturer_code": monitor.manufacturer_code,
+        "vendor_id": monitor.vendor_id,
+        "product_id": monitor.product_id,
+        "serial": monitor.serial_text,
+        "name": monitor.name,
+        "inches": _calculate_diagonal_inches(monitor.width_cm, monitor.height_cm),
+    }
+
+
+def _fetch_edid_map() -> Optional[dict]:
+    """
+    Parsed EDID of every monitor from one native call (batched ``get_edid_by_hwid``).
+
+    A monitor whose EDID hash is unchanged since the previous call keeps its earlier dictionary.
+
+    Returns:
+        Dictionary keyed by upper-cased monitor interface path (the ``DisplayPath`` of the connector
+        info), or None if the DLL lacks the EDID reader or the call fails.
+    """
+    try:
+        from hwprobe.interops.win.bindings.edid_info import edid
+    except (FileNotFoundError, OSError):
+        return None
+
+    monitors = edid.read()
+    if monitors is None:
+        return None
+
+    edid_map = {}
+    for monitor in monitors:
+        key = monitor.device_path.upper()
+        cached = _edid_cache.get(key)
+        if cached is None or cached[0] != monitor.hash:
+            cached = (monitor.hash, _edid_from_native(monitor))
+            _edid_cache[key] = cached
+        edid_map[key] = cached[1]
+    return edid_map
+
+
+def _lookup_edid(edid_map: dict, hwid: str) -> Optional[dict]:
+    """``get_edid_by_hwid`` against the batched map: the first readable EDID whose path contains `hwid`."""
+    hwid_upper = hwid.upper()
+    if edid_map.get(hwid_upper) is not None:
+        return edid_map[hwid_upper]
+
+    for path, edid in edid_map.items():
+        if hwid_upper in path and edid is not None:
+            return edid
+    return None
+
+
 # =============================================================================
 # Monitor Enumeration
 # =============================================================================
@@ -548,7 +681,8 @@ def _get_connection_type(connector_info: Optional[dict]) -> Optional[str]:
 
 def _fetch_edid_for_monitor(
         connector_info: Optional[dict],
-        pnp_device_id: str
+        pnp_device_id: str,
+        edid_map: Optional[dict] = None,
 ) -> tuple[Optional[dict], Optional[str]]:
     """
     Fetch EDID data for a monitor, preferring display path over PNP ID.
@@ -556,17 +690,21 @@ def _fetch_edid_for_monitor(
     Args:
         connector_info: Connector info dict with DisplayPath (may be None)
         pnp_device_id: PNP device ID as fallback
+        edid_map: Result of ``_fetch_edid_map``; without it each lookup is a SetupAPI walk
 
     Returns:
         Tuple of (edid_dict, device_path) where device_path may be None.
     """
+    def lookup(hwid: str) -> Optional[dict]:
+        return _lookup_edid(edid_map, hwid) if edid_map is not None else get_edid_by_hwid(hwid)
+
     device_path = None
 
     # Prefer display path for more accurate EDID matching
     if connector_info:
         device_path = connector_info.get("DisplayPath")
         if device_path:
-            edid = get_edid_by_hwid(device_path)
+            edid = lookup(device_path)
             if edid:
                 return edid, device_path
 
@@ -574,7 +712,7 @@ def _fetch_edid_for_monitor(
     if pnp_device_id:
         parts = pnp_device_id.split("\\")
         if len(parts) > 1:
-            edid = get_edid_by_hwid(parts[1])
+            edid = lookup(parts[1])
             return edid, device_path
 
     return None, device_path
@@ -692,10 +830,10 @@ def _monitor_enum_callback(hmonitor, hdc, rect, lparam) -> bool:
     connector_info = connector_info_map.get(device_id) if connector_info_map else None
 
     # Get GPU association
-    gpu_name, gpu_result_code = find_monitor_gpu(device_id)
+    gpu_name = _resolve_monitor_gpu(device_id, connector_info, getattr(display_info, "_adapterMap", None))
 
     # Get EDID and connection type
-    edid, device_path = _fetch_edid_for_monitor(connector_info, pnp_device_id)
+    edid, device_path = _fetch_edid_for_monitor(connector_info, pnp_device_id, getattr(display_info, "_edidMap", None))
     connection_type = _get_connection_type(connector_info)
 
     # Build and add monitor info
@@ -705,7 +843,7 @@ def _monitor_enum_callback(hmonitor, hdc, rect, lparam) -> bool:
         device_path=device_path,
         display_mode=display_mode,
         edid=edid,
-        gpu_name=gpu_name if gpu_result_code == STATUS_OK else None,
+        gpu_name=gpu_name,
         connection_type=connection_type,
     )
 
@@ -722,15 +860,78 @@ monitor_enum_proc = _monitor_enum_callback
 # =============================================================================
 
 
+def _connector_info_from_record(record: DisplayPathRecord) -> dict:
+    """Connector info entry for one topology record, with the same keys as ``parse_connector_info``."""
+    refresh_rate = None
+    if record.refreshDenominator:
+        refresh_rate = record.refreshNumerator / record.refreshDenominator
+
+    return {
+        "DisplayPath": record.monitorDevicePath.decode("utf-8", errors="ignore"),
+        "OutputTechnology": str(record.outputTechnology),
+        "AdapterLUID": f"{record.adapterLuidHigh & 0xFFFFFFFF:08X}{record.adapterLuidLow:08X}",
+        "RefreshRate": refresh_rate,
+        "Width": record.width or None,
+        "Height": record.height or None,
+    }
+
+
+def _fetch_display_topology() -> Optional[dict]:
+    """
+    Fetch connector information as binary records via GetDisplayTopology.
+
+    The records are only converted when the DLL reports a new topology generation;
+    otherwise the previous result is returned as is.
+
+    Returns:
+        Connector info dictionary keyed by display ID (see ``parse_connector_info``),
+        or None if the DLL lacks GetDisplayTopology or the call fails.
+    """
+    if GetDisplayTopology is None:
+        return None
+
+    capacity = _TOPOLOGY_CAPACITY
+    count = ctypes.c_int(0)
+    generation = ctypes.c_uint64(0)
+    for _ in range(2):
+        records = (DisplayPathRecord * capacity)()
+        result_code = GetDisplayTopology(records, capacity, ctypes.byref(count), ctypes.byref(generation))
+        if result_code == STATUS_OK:
+            break
+        if count.value <= capacity:
+            return None
+        capacity = count.value
+    else:
+        return None
+
+    if generation.value == _topology_cache["generation"]:
+        return _topology_cache["connector_info"]
+
+    connector_info = {
+        record.gdiDeviceName.decode("utf-8", errors="ignore"): _connector_info_from_record(record)
+        for record in records[:count.value]
+    }
+    _topology_cache["generation"] = generation.value
+    _topology_cache["connector_info"] = connector_info
+    return connector_info
+
+
 def _fetch_connector_info() -> tuple[Optional[dict], Optional[tuple[StatusType, str]]]:
     """
     Fetch display connector information from the interop DLL.
 
+    Uses the binary GetDisplayTopology records when available, the
+    GetDisplayPathInfo string otherwise.
+
     Returns:
         Tuple of (connector_info_dict, error_info):
         - connector_info_dict: Parsed connector info, or None on failure
         - error_info: Tuple of (StatusType, message) if failed, None on success
     """
+    connector_info = _fetch_display_topology()
+    if connector_info:
+        return connector_info, None
+
     buffer = ctypes.create_string_buffer(4096)
     result_code = GetDisplayPathInfo(buffer, 4096)
 
@@ -746,7 +947,7 @@ def fetch_display_info_internal() -> DisplayInfo:
     Enumerate all display monitors and collect their information.
 
     This is the main entry point for display enumeration. It:
-    1. Fetches connector information from the interop DLL
+    1. Fetches connector information and the display-to-GPU map from the interop DLL
     2. Enumerates all active monitors using EnumDisplayMonitors
     3. For each monitor, collects resolution, EDID data, GPU association, etc.
 
@@ -764,6 +965,12 @@ def fetch_display_info_internal() -> DisplayInfo:
     else:
         display_info._connectorInfo = connector_info
 
+    # Resolve all monitors to their GPUs up front instead of one DXGI factory per monitor
+    display_info._adapterMap = _fetch_display_adapter_map()
+
+    # Read every monitor's EDID in one native call instead of one SetupAPI walk per monitor
+    display_info._edidMap = _fetch_edid_map()
+
     # Enumerate all monitors
     display_info_ptr = ctypes.py_object(display_info)
     enum_callback = MONITORENUMPROC(_monitor_enum_callback)
@@ -1,11 +1,20 @@
+from contextlib import nullcontext
+from typing import Optional
+
 from hwprobe.core.windows.audio import fetch_audio_info_fast
 from hwprobe.core.windows.baseboard import fetch_baseboard_info
 from hwprobe.core.windows.cpu import fetch_cpu_info
 from hwprobe.core.windows.display import fetch_display_info_internal
 from hwprobe.core.windows.graphics import fetch_graphics_info
-from hwprobe.core.windows.memory import fetch_memory_info
+from hwprobe.core.windows.memory import (
+    ECC_COLUMNS, ECC_QUERY, MEMORY_COLUMNS, MEMORY_NAMESPACE, MEMORY_QUERY, fetch_memory_info,
+)
 from hwprobe.core.windows.network import fetch_network_info_fast
-from hwprobe.core.windows.storage import fetch_storage_info
+from hwprobe.core.windows.storage import STORAGE_COLUMNS, STORAGE_NAMESPACE, STORAGE_QUERY, fetch_storage_info
+from hwprobe.interops.common.device_watch import (
+    DEVICE_WATCH_AUDIO, DEVICE_WATCH_GPU, DEVICE_WATCH_STORAGE, ChangeCache, DeviceWatch,
+)
+from hwprobe.interops.win.bindings.wmi_info import session_pool
 from hwprobe.models.cpu_models import CPUInfo
 from hwprobe.models.display_models import DisplayInfo
 from hwprobe.models.gpu_models import GraphicsInfo
@@ -14,15 +23,53 @@ from hwprobe.models.info_models import HardwareManagerInterface
 from hwprobe.models.info_models import WindowsHardwareInfo
 from hwprobe.models.memory_models import MemoryInfo
 from hwprobe.models.network_models import NetworkInfo
+from hwprobe.models.status_models import StatusType
 from hwprobe.models.storage_models import StorageInfo
 
 
+def _open_device_watch() -> Optional[DeviceWatch]:
+    """The process-wide hot-plug watch, started; None if the native library cannot provide one."""
+    try:
+        from hwprobe.interops.win.bindings.device_watch import watch
+    except (FileNotFoundError, OSError):
+        return None
+    return watch if watch.start() else None
+
+
+def _snapshot_binding():
+    """The native snapshot binding, or None if the native library is not available."""
+    try:
+        from hwprobe.interops.win.bindings import device_snapshot
+    except (FileNotFoundError, OSError):
+        return None
+    return device_snapshot
+
+
+def _probe_binding():
+    """The native parallel probe binding, or None if the native library is not available."""
+    try:
+        from hwprobe.interops.win.bindings import probe_all
+    except (FileNotFoundError, OSError):
+        return None
+    return probe_all
+
+
 class WindowsHardwareManager(HardwareManagerInterface):
     """
     Uses Registry and WMI to extract info.
     """
 
-    def __init__(self):
+    def __init__(self, watch_changes: bool = False, snapshot_path: Optional[str] = None):
+        """
+        Args:
+            watch_changes: Subscribe to hot-plug notifications and reuse the previous storage,
+                graphics and audio results until a device of that category is added or removed.
+                Network and display results carry live state (addresses, current mode) and are
+                always re-probed.
+            snapshot_path: Inventory snapshot file for short-lived processes. If it is valid for this
+                boot and this set of devices, native GPU/storage queries are served from it; otherwise
+                ``fetch_hardware_info()`` probes live and rewrites it.
+        """
         self.info = WindowsHardwareInfo(
             cpu=CPUInfo(),
             graphics=GraphicsInfo(),
@@ -30,6 +77,15 @@ class WindowsHardwareManager(HardwareManagerInterface):
             storage=StorageInfo(),
             network=NetworkInfo(),
         )
+        self._cache = ChangeCache(
+            _open_device_watch() if watch_changes else None,
+            keep=lambda info: info.status.type != StatusType.FAILED,
+        )
+
+        self._snapshot_path = snapshot_path
+        self._snapshot = _snapshot_binding() if snapshot_path else None
+        self._snapshot_loaded = self._snapshot.load(snapshot_path) if self._snapshot is not None else None
+        self._snapshot_current = self._snapshot_loaded is not None
 
     def fetch_cpu_info(self) -> CPUInfo:
         self.info.cpu = fetch_cpu_info()
@@ -40,11 +96,13 @@ class WindowsHardwareManager(HardwareManagerInterface):
         return self.info.memory
 
     def fetch_storage_info(self) -> StorageInfo:
-        self.info.storage = fetch_storage_info()
+        with self._serve_snapshot():
+            self.info.storage = self._cache.get(DEVICE_WATCH_STORAGE, fetch_storage_info)
         return self.info.storage
 
     def fetch_graphics_info(self) -> GraphicsInfo:
-        self.info.graphics = fetch_graphics_info()
+        with self._serve_snapshot():
+            self.info.graphics = self._cache.get(DEVICE_WATCH_GPU, fetch_graphics_info)
         return self.info.graphics
 
     def fetch_network_info(self) -> NetworkInfo:
@@ -56,17 +114,48 @@ class WindowsHardwareManager(HardwareManagerInterface):
         return self.info.display
 
     def fetch_audio_info(self):
-        self.info.audio = fetch_audio_info_fast()
+        self.info.audio = self._cache.get(DEVICE_WATCH_AUDIO, fetch_audio_info_fast)
         return self.info.audio
 
     def fetch_baseboard_info(self):
         self.info.baseboard = fetch_baseboard_info()
         return self.info.baseboard
 
+    def _serve_snapshot(self):
+        """Answer the native GPU / storage queries inside the block from the loaded snapshot, if there is one."""
+        if self._snapshot_loaded is None:
+            return nullcontext()
+        return self._snapshot.activate(self._snapshot_loaded)
+
+    def _prefetch(self):
+        """Run the sweep's native queries concurrently, skipping the ones a cache or snapshot already answers."""
+        probe = _probe_binding()
+        if probe is None:
+            return nullcontext()
+
+        jobs = [probe.wmi_job(MEMORY_QUERY, MEMORY_COLUMNS, MEMORY_NAMESPACE),
+                probe.wmi_job(ECC_QUERY, ECC_COLUMNS, MEMORY_NAMESPACE)]
+        if not self._cache.fresh(DEVICE_WATCH_STORAGE):
+            # The native enumeration is snapshot-backed like the GPU one; the WMI fallback is not
+            if probe.STORAGE_JOB is None:
+                jobs.append(probe.wmi_job(STORAGE_QUERY, STORAGE_COLUMNS, STORAGE_NAMESPACE))
+            elif not self._snapshot_current:
+                jobs.append(probe.STORAGE_JOB)
+        if not self._snapshot_current and not self._cache.fresh(DEVICE_WATCH_GPU):
+            jobs.append(probe.GPU_JOB)
+        return probe.prefetch(jobs)
+
     def fetch_hardware_info(self) -> HardwareInfo:
-        self.fetch_cpu_info()
-        self.fetch_memory_info()
-        self.fetch_storage_info()
-        self.fetch_graphics_info()
-        self.fetch_network_info()
+        # Memory (and storage, on a DLL without the native enumeration) goes through WMI; share one
+        # session per namespace across the sweep, and let the probe batch issue those queries and the
+        # DXGI and disk enumerations side by side.
+        with session_pool(), self._serve_snapshot(), self._prefetch():
+            self.fetch_cpu_info()
+            self.fetch_memory_info()
+            self.fetch_storage_info()
+            self.fetch_graphics_info()
+            self.fetch_network_info()
+
+        if self._snapshot is not None and not self._snapshot_current:
+            self._snapshot_current = self._snapshot.store(self._snapshot_path)
         return self.info
@@ -1,10 +1,9 @@
-import ctypes
 from typing import Tuple
 
 from hwprobe.core.windows.win_enum import ECC_MEMORY_TYPE, MEMORY_TYPE
 # todo: refactor to new bindings
 from hwprobe.interops.win.legacy.constants import ECC_MULTI_BIT, ECC_SINGLE_BIT
-from hwprobe.interops.win.legacy.signatures import GetWmiInfo
+from hwprobe.interops.win.bindings.wmi_info import QUERY_TIMEOUT_MS, query_wmi_table, wmi_uint
 from hwprobe.models.memory_models import (
     MemoryInfo,
     MemoryModuleInfo,
@@ -13,6 +12,17 @@ from hwprobe.models.memory_models import (
 from hwprobe.models.size_models import Megabyte
 from hwprobe.models.status_models import StatusType
 
+# Shared with the manager, which prefetches both queries in its parallel probe batch
+ECC_COLUMNS = ["MemoryErrorCorrection"]
+ECC_QUERY = "SELECT MemoryErrorCorrection FROM Win32_PhysicalMemoryArray"
+
+MEMORY_COLUMNS = [
+    "BankLabel", "Capacity", "Manufacturer", "PartNumber", "Speed",
+    "DeviceLocator", "SMBIOSMemoryType", "DataWidth", "TotalWidth",
+]
+MEMORY_QUERY = f"SELECT {', '.join(MEMORY_COLUMNS)} FROM Win32_PhysicalMemory"
+MEMORY_NAMESPACE = "ROOT\\CIMV2"
+
 
 def check_ecc() -> Tuple[bool, str]:
     """
@@ -26,35 +36,20 @@ def check_ecc() -> Tuple[bool, str]:
         Tuple[bool, str]: A tuple where the first element indicates if ECC is supported,
                           and the second element is the ECC type as a string.
     """
-    query = b"SELECT MemoryErrorCorrection FROM Win32_PhysicalMemoryArray"
-
     # NOTE[kernel]:
     #   I don't really know how to implement support for multiple memory arrays,
     #   so we'll just check the first one for now.
-    buf_size = 256 * 1
-
-    buffer = ctypes.create_string_buffer(buf_size)
-    GetWmiInfo(query, b"ROOT\\CIMV2", buffer, buf_size)
+    rows = query_wmi_table(ECC_QUERY, ECC_COLUMNS, MEMORY_NAMESPACE, timeout_ms=QUERY_TIMEOUT_MS)
 
-    raw_data = buffer.value.decode("utf-8", errors="ignore")
-
-    if not raw_data:
+    if not rows:
         return False, "Unknown"
 
-    first_line = raw_data.split("\n")[0]
-    parsed_data = {
-        x.split("=", 1)[0]: x.split("=", 1)[1]
-        for x in first_line.split("|")
-        if "=" in x
-    }
-    ecc_type = parsed_data.get("MemoryErrorCorrection", "Unknown")
+    ecc_type = wmi_uint(rows[0]["MemoryErrorCorrection"])
 
     supported = False
 
-    if ecc_type.isdigit():
-        ecc_type = int(ecc_type)
-        if ecc_type == ECC_SINGLE_BIT or ecc_type == ECC_MULTI_BIT:
-            supported = True
+    if ecc_type == ECC_SINGLE_BIT or ecc_type == ECC_MULTI_BIT:
+        supported = True
 
     return supported, (
         ECC_MEMORY_TYPE[ecc_type] if ecc_type in ECC_MEMORY_TYPE else "Unknown"
@@ -64,56 +59,27 @@ def check_ecc() -> Tuple[bool, str]:
 def fetch_wmi_memory_info() -> MemoryInfo:
     memory_info = MemoryInfo()
 
-    # 256 bytes per property, 9 properties, 6 modules
-    buf_size = 256 * 9 * 8
-    buffer = ctypes.create_string_buffer(buf_size)
-
-    GetWmiInfo(
-        b"SELECT BankLabel, Capacity, Manufacturer, PartNumber, Speed, DeviceLocator, SMBIOSMemoryType, DataWidth, TotalWidth FROM Win32_PhysicalMemory",
-        b"ROOT\\CIMV2",
-        buffer,
-        buf_size,
-    )
+    rows = query_wmi_table(MEMORY_QUERY, MEMORY_COLUMNS, MEMORY_NAMESPACE, timeout_ms=QUERY_TIMEOUT_MS)
 
-    """
-    `raw_data` is in the following format:
-    BankLabel=...|Capacity=...|...
-    BankLabel=...|Capacity=...|...
-    ...
-    
-    Each module is separated by a newline; and for each module,
-    its properties are separated by a '|' character
-    """
-
-    raw_data = buffer.value.decode("utf-8", errors="ignore")
-
-    if not raw_data:
+    if rows is None:
         memory_info.status.type = StatusType.FAILED
-        memory_info.status.messages.append("WMI query returned no data")
+        memory_info.status.messages.append("WMI query failed")
         return memory_info
 
-    for line in raw_data.split("\n"):
-        if not line or "|" not in line:
-            continue
-
+    for row in rows:
         module = MemoryModuleInfo()
-        unparsed = line.split("|")
-
-        parsed_data = {
-            x.split("=", 1)[0]: x.split("=", 1)[1] for x in unparsed if "=" in x
-        }
 
-        bank_label = parsed_data["BankLabel"]
-        capacity = parsed_data["Capacity"]
-        manufacturer = parsed_data["Manufacturer"]
-        part_number = parsed_data["PartNumber"]
-        speed = parsed_data["Speed"]
-        device_locator = parsed_data["DeviceLocator"]
-        smbios_mem_type = parsed_data["SMBIOSMemoryType"]
-        data_width = parsed_data["DataWidth"]
-        total_width = parsed_data["TotalWidth"]
+        bank_label = row["BankLabel"]
+        capacity = wmi_uint(row["Capacity"])
+        manufacturer = row["Manufacturer"]
+        part_number = row["PartNumber"]
+        speed = wmi_uint(row["Speed"])
+        device_locator = row["DeviceLocator"]
+        smbios_mem_type = wmi_uint(row["SMBIOSMemoryType"])
+        data_width = wmi_uint(row["DataWidth"])
+        total_width = wmi_uint(row["TotalWidth"])
 
-        capacity = int(capacity) if capacity.isdigit() else 0
+        capacity = capacity if isinstance(capacity, int) else 0
 
         module.capacity = Megabyte(capacity=capacity // (1024 * 1024))
         module.manufacturer = manufacturer.strip() if manufacturer else None
@@ -126,14 +92,13 @@ def fetch_wmi_memory_info() -> MemoryInfo:
         module.slot = slot
 
         # The speed is already reported as MHz
-        module.frequency_mhz = int(speed) if speed.isdigit() else None
+        module.frequency_mhz = speed if isinstance(speed, int) else None
 
-        if smbios_mem_type:
-            smbios_mem_type = smbios_mem_type.strip()
-            module.type = MEMORY_TYPE.get(int(smbios_mem_type), "Unknown")
+        if isinstance(smbios_mem_type, int):
+            module.type = MEMORY_TYPE.get(smbios_mem_type, "Unknown")
 
-        if data_width and total_width:
-            if int(total_width) > int(data_width):
+        if isinstance(data_width, int) and isinstance(total_width, int):
+            if total_width > data_width:
                 module.supports_ecc = True
             else:
                 module.supports_ecc = False
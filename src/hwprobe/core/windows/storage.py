@@ -1,86 +1,52 @@
-import ctypes
+from typing import Optional
 
 from hwprobe.core.windows.win_enum import MEDIA_TYPE, BUS_TYPE
-# todo: refactor to new bindings
-from hwprobe.interops.win.legacy.signatures import GetWmiInfo
+from hwprobe.interops.win.bindings.wmi_info import QUERY_TIMEOUT_MS, query_wmi_table, wmi_uint
 from hwprobe.models.size_models import Megabyte
 from hwprobe.models.status_models import StatusType
 from hwprobe.models.storage_models import StorageInfo, DiskInfo
 
+# Shared with the manager, which prefetches this query in its parallel probe batch
+STORAGE_COLUMNS = ["FriendlyName", "MediaType", "BusType", "Size", "Manufacturer", "Model"]
+STORAGE_QUERY = f"SELECT {', '.join(STORAGE_COLUMNS)} FROM MSFT_PhysicalDisk"
+STORAGE_NAMESPACE = "ROOT\\Microsoft\\Windows\\Storage"
 
-def fetch_wmi_storage_info() -> StorageInfo:
-    """
-    Fetch storage information via WMI using the GetWmiInfo interop.
-    Returns a StorageInfo object with all detected disks.
-    """
-    storage_info = StorageInfo()
 
-    # 256 bytes per property, 6 properties, 10 modules (mostly for NAS systems)
-    buf_size = 256 * 6 * 10
-    buffer = ctypes.create_string_buffer(buf_size)
+def _map_disk(model, manufacturer, media_type, bus_type, size) -> DiskInfo:
+    """A DiskInfo from MSFT_PhysicalDisk-style values; the native enumeration reports the same codes."""
+    disk = DiskInfo()
 
-    query = (
-        b"SELECT FriendlyName, MediaType, BusType, Size, Manufacturer, Model FROM "
-        b"MSFT_PhysicalDisk"
+    disk.model = model.strip() if model else None
+    disk.manufacturer = manufacturer.strip() if manufacturer else None
+    disk.type = (
+        MEDIA_TYPE.get(media_type, "Unknown")
+        if isinstance(media_type, int)
+        else "Unknown"
+    )
+    disk.size = (
+        Megabyte(capacity=size // (1024 * 1024))
+        if isinstance(size, int)
+        else None
     )
 
-    GetWmiInfo(query, b"ROOT\\Microsoft\\Windows\\Storage", buffer, buf_size)
-
-    raw_data = buffer.value.decode("utf-8", errors="ignore")
-    if not raw_data:
-        storage_info.status.type = StatusType.FAILED
-        storage_info.status.messages.append("WMI query returned no data")
-        return storage_info
-
-    for line in raw_data.split("\n"):
-        if not line or "|" not in line:
-            continue
-
-        disk = DiskInfo()
-        props = {
-            x.split("=", 1)[0]: x.split("=", 1)[1] for x in line.split("|") if "=" in x
-        }
-
-        friendly_name = props.get("FriendlyName")
-        media_type = props.get("MediaType")
-        bus_type = props.get("BusType")
-        size = props.get("Size")
-        manufacturer = props.get("Manufacturer")
-        model = props.get("Model")
-
-        print(manufacturer)
-
-        disk.model = (
-            model.strip() if model else friendly_name.strip() if friendly_name else None
-        )
-        disk.manufacturer = manufacturer.strip() if manufacturer else None
-        disk.type = (
-            MEDIA_TYPE.get(int(media_type), "Unknown")
-            if media_type and media_type.isdigit()
-            else "Unknown"
-        )
-        disk.size = (
-            Megabyte(capacity=int(size) // (1024 * 1024))
-            if size and size.isdigit()
-            else None
-        )
+    # Map bus type
+    conn_type, location = None, None
+    if isinstance(bus_type, int):
+        bt = BUS_TYPE.get(bus_type)
+        if bt:
+            conn_type = bt["type"]
+            location = bt["location"]
 
-        # Map bus type
-        conn_type, location = None, None
-        if bus_type and bus_type.isdigit():
-            bt = BUS_TYPE.get(int(bus_type))
-            if bt:
-                conn_type = bt["type"]
-                location = bt["location"]
+    disk.connector = conn_type
+    disk.location = location
 
-        disk.connector = conn_type
-        disk.location = location
+    if conn_type and "nvme" in conn_type.lower():
+        disk.type = MEDIA_TYPE.get(4)  # SSD
 
-        if conn_type and "nvme" in conn_type.lower():
-            disk.type = MEDIA_TYPE.get(4)  # SSD
+    return disk
 
-        storage_info.modules.append(disk)
 
+def _finish(storage_info: StorageInfo) -> StorageInfo:
     # If at least one module was parsed, mark as success
     if storage_info.modules:
         storage_info.status.type = StatusType.SUCCESS
@@ -91,5 +57,54 @@ def fetch_wmi_storage_info() -> StorageInfo:
     return storage_info
 
 
+def fetch_native_storage_info() -> Optional[StorageInfo]:
+    """
+    Fetch storage information straight from the disk drivers (IOCTL_STORAGE_QUERY_PROPERTY).
+    Returns None if the native library cannot enumerate disks, so the caller can fall back to WMI.
+    """
+    try:
+        from hwprobe.interops.win.bindings.storage_info import get_storage_info
+        devices = get_storage_info()
+    except (ImportError, OSError, RuntimeError):
+        return None
+
+    storage_info = StorageInfo()
+    for device in devices:
+        disk = _map_disk(device.product_name, device.vendor_name, device.media_type, device.bus_type,
+                         device.size_bytes if device.size_bytes else None)
+        if device.device_path:
+            disk.identifier = device.device_path.rpartition("\\")[2]  # PhysicalDriveN
+        storage_info.modules.append(disk)
+
+    return _finish(storage_info)
+
+
+def fetch_wmi_storage_info() -> StorageInfo:
+    """
+    Fetch storage information via WMI using the wmi_query_table interop.
+    Returns a StorageInfo object with all detected disks.
+    """
+    storage_info = StorageInfo()
+
+    rows = query_wmi_table(STORAGE_QUERY, STORAGE_COLUMNS, STORAGE_NAMESPACE, timeout_ms=QUERY_TIMEOUT_MS)
+    if rows is None:
+        storage_info.status.type = StatusType.FAILED
+        storage_info.status.messages.append("WMI query failed")
+        return storage_info
+
+    for row in rows:
+        model = row["Model"] or row["FriendlyName"]
+        storage_info.modules.append(
+            _map_disk(model, row["Manufacturer"], wmi_uint(row["MediaType"]), wmi_uint(row["BusType"]),
+                      wmi_uint(row["Size"]))
+        )
+
+    return _finish(storage_info)
+
+
 def fetch_storage_info() -> StorageInfo:
+    """The native enumeration when it finds disks; the Storage WMI provider otherwise."""
+    storage_info = fetch_native_storage_info()
+    if storage_info is not None and storage_info.status.type == StatusType.SUCCESS:
+        return storage_info
     return fetch_wmi_storage_info()
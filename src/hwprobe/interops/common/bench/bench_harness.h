@@ -0,0 +1,280 @@
+#pragma once
+
+// Shared driver for the per-platform `device_info_bench` executables: runs every case N times
+// in cold and warm mode and prints one JSON document with latency percentiles, allocation
+// counts and the share of time spent in each internal stage (see include/bench_stages.h).
+//
+//   cold: before every call, drop what the libraries keep between calls (WMI session pool,
+//         SMBIOS table...). The first cold sample is also the first call in the process.
+//   warm: one untimed call first, caches and pools kept for the whole run.
+//
+// --record FILE / --replay FILE (see include/device_replay.h) capture what the OS answered to
+// one pass over the cases, and rerun the cases on that corpus, e.g. an edited one with a
+// thousand GPUs, on a machine without the hardware.
+//
+// Header-only, so each platform's bench is a single translation unit.
+
+#include "bench_stages.h"
+#include "device_replay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+// The stage exports of a device_info build, resolved at runtime; all null if it has none.
+struct StageApi {
+    int (*count)(void) = nullptr;
+    int (*get)(int, DeviceInfoStageStats *) = nullptr;
+    void (*reset)(void) = nullptr;
+    uint64_t (*allocations)(void) = nullptr;
+
+    bool available() const { return count && get && reset && allocations; }
+};
+
+struct Case {
+    Case(std::string case_name, std::string case_library, std::function<bool()> call, bool uses_stages)
+        : name(std::move(case_name)), library(std::move(case_library)), run(std::move(call)),
+          instrumented(uses_stages) {}
+
+    std::string name;
+    std::string library;                 // which binary the export lives in
+    std::function<bool()> run;           // one call; false if the export reported failure
+    std::function<void()> cold_reset;    // before each cold call (optional)
+    std::function<void()> warm_begin;    // before the warm run (optional)
+    std::function<void()> warm_end;      // after the warm run (optional)
+    bool instrumented;                   // stages/allocations come from `StageApi`
+};
+
+struct Options {
+    int iterations = 50;
+    bool cold = true;
+    bool warm = true;
+};
+
+// Parses --iterations N and --mode cold|warm|both, leaving the other arguments in `rest`.
+// Returns false (after printing usage) on a malformed command line.
+inline bool ParseOptions(int argc, char **argv, Options &options, std::vector<std::string> &rest) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--iterations" && i + 1 < argc) {
+            options.iterations = std::atoi(argv[++i]);
+        } else if (arg == "--mode" && i + 1 < argc) {
+            const std::string mode = argv[++i];
+            options.cold = mode == "cold" || mode == "both";
+            options.warm = mode == "warm" || mode == "both";
+            if (!options.cold && !options.warm) break;
+        } else {
+            rest.push_back(arg);
+        }
+    }
+    if (options.iterations <= 0 || (!options.cold && !options.warm)) {
+        std::fprintf(stderr, "usage: %s [--iterations N] [--mode cold|warm|both] ...\n", argv[0]);
+        return false;
+    }
+    return true;
+}
+
+// The replay exports of a device_info build, resolved at runtime; all null if it has none.
+struct ReplayApi {
+    int (*record_start)(void) = nullptr;
+    int (*record_stop)(DeviceReplayCorpus **) = nullptr;
+    uint64_t (*corpus_size)(const DeviceReplayCorpus *) = nullptr;
+    int (*corpus_copy)(const DeviceReplayCorpus *, void *, uint64_t) = nullptr;
+    void (*corpus_free)(DeviceReplayCorpus *) = nullptr;
+    int (*start)(const void *, uint64_t) = nullptr;
+    void (*stop)(void) = nullptr;
+
+    bool available() const {
+        return record_start && record_stop && corpus_size && corpus_copy && corpus_free && start && stop;
+    }
+};
+
+// Runs every case once while recording and writes the corpus to `path`.
+inline bool RecordCorpus(const ReplayApi &api, const std::vector<Case> &cases, const std::string &path) {
+    if (!api.available() || api.record_start() != DEVICE_REPLAY_STATUS_OK) {
+        std::fprintf(stderr, "Error: this build cannot record\n");
+        return false;
+    }
+    for (const Case &c : cases)
+        if (c.instrumented) c.run();  // replay hooks live in device_info only
+
+    DeviceReplayCorpus *corpus = nullptr;
+    if (api.record_stop(&corpus) != DEVICE_REPLAY_STATUS_OK || !corpus) return false;
+    std::vector<unsigned char> blob(static_cast<size_t>(api.corpus_size(corpus)));
+    const bool copied = api.corpus_copy(corpus, blob.data(), blob.size()) == DEVICE_REPLAY_STATUS_OK;
+    api.corpus_free(corpus);
+
+    FILE *file = copied ? std::fopen(path.c_str(), "wb") : nullptr;
+    if (!file) {
+        std::fprintf(stderr, "Error: could not write %s\n", path.c_str());
+        return false;
+    }
+    const bool written = std::fwrite(blob.data(), 1, blob.size(), file) == blob.size();
+    return std::fclose(file) == 0 && written;
+}
+
+// Answers every hooked read from the corpus at `path` until the process exits.
+inline bool ReplayCorpus(const ReplayApi &api, const std::string &path) {
+    std::vector<unsigned char> blob;
+    if (FILE *file = std::fopen(path.c_str(), "rb")) {
+        unsigned char chunk[65536];
+        size_t n;
+        while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+            blob.insert(blob.end(), chunk, chunk + n);
+        std::fclose(file);
+    }
+    if (!api.available() || blob.empty() || api.start(blob.data(), blob.size()) != DEVICE_REPLAY_STATUS_OK) {
+        std::fprintf(stderr, "Error: could not replay %s\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+namespace detail {
+
+struct StageTotals {
+    uint64_t calls = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+};
+
+inline std::map<std::string, StageTotals> ReadStages(const StageApi &api) {
+    std::map<std::string, StageTotals> out;
+    const int count = api.count();
+    for (int i = 0; i < count; ++i) {
+        DeviceInfoStageStats stats = {};
+        if (api.get(i, &stats) != 0 || stats.calls == 0) continue;
+        stats.name[sizeof(stats.name) - 1] = '\0';
+        out[stats.name] = {stats.calls, stats.total_ns, stats.max_ns};
+    }
+    return out;
+}
+
+// Nearest-rank percentile of sorted samples.
+inline double Percentile(const std::vector<double> &sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size()) + 0.999999);
+    rank = std::min(std::max<size_t>(rank, 1), sorted.size());
+    return sorted[rank - 1];
+}
+
+inline void PrintJsonString(FILE *out, const std::string &value) {
+    std::fputc('"', out);
+    for (unsigned char c : value) {
+        if (c == '"' || c == '\\') std::fprintf(out, "\\%c", c);
+        else if (c < 0x20) std::fprintf(out, "\\u%04x", c);
+        else std::fputc(c, out);
+    }
+    std::fputc('"', out);
+}
+
+// Prints one report record; returns true if at least one call succeeded.
+inline bool RunMode(const Case &c, const char *mode, bool cold, const Options &options, const StageApi &api,
+                    FILE *out, bool &first_record) {
+    const bool instrumented = c.instrumented && api.available();
+
+    if (!cold) {
+        if (c.warm_begin) c.warm_begin();
+        c.run();
+    }
+
+    std::vector<double> samples_us;
+    samples_us.reserve(static_cast<size_t>(options.iterations));
+    int failures = 0;
+    double total_us = 0.0;
+    uint64_t allocations = 0;
+    std::map<std::string, StageTotals> stages;
+    for (int i = 0; i < options.iterations; ++i) {
+        if (cold && c.cold_reset) c.cold_reset();
+
+        // Counters are re-read around every call, so work done by cold_reset / warm_begin is never counted.
+        uint64_t allocations_before = 0;
+        if (instrumented) {
+            api.reset();
+            allocations_before = api.allocations();
+        }
+        const auto start = std::chrono::steady_clock::now();
+        const bool ok = c.run();
+        const double us =
+            std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        if (instrumented) {
+            allocations += api.allocations() - allocations_before;
+            for (const auto &entry : ReadStages(api)) {
+                StageTotals &total = stages[entry.first];
+                total.calls += entry.second.calls;
+                total.total_ns += entry.second.total_ns;
+                total.max_ns = std::max(total.max_ns, entry.second.max_ns);
+            }
+        }
+
+        samples_us.push_back(us);
+        total_us += us;
+        if (!ok) ++failures;
+    }
+    if (!cold && c.warm_end) c.warm_end();
+
+    const double first_us = samples_us.front();
+    std::sort(samples_us.begin(), samples_us.end());
+    const double n = static_cast<double>(options.iterations);
+
+    std::fprintf(out, "%s\n    {\"name\": ", first_record ? "" : ",");
+    first_record = false;
+    PrintJsonString(out, c.name);
+    std::fprintf(out, ", \"library\": ");
+    PrintJsonString(out, c.library);
+    std::fprintf(out,
+                 ", \"mode\": \"%s\", \"iterations\": %d, \"failures\": %d, \"first_us\": %.1f, \"mean_us\": %.1f,"
+                 " \"p50_us\": %.1f, \"p99_us\": %.1f, \"max_us\": %.1f",
+                 mode, options.iterations, failures, first_us, total_us / n, Percentile(samples_us, 50),
+                 Percentile(samples_us, 99), samples_us.back());
+
+    if (!instrumented) {
+        std::fprintf(out, ", \"allocations_per_call\": null, \"stages\": null}");
+        return failures < options.iterations;
+    }
+
+    std::fprintf(out, ", \"allocations_per_call\": %.1f, \"stages\": [", static_cast<double>(allocations) / n);
+    bool first_stage = true;
+    for (const auto &entry : stages) {
+        std::fprintf(out, "%s\n      {\"name\": ", first_stage ? "" : ",");
+        first_stage = false;
+        PrintJsonString(out, entry.first);
+        const StageTotals &s = entry.second;
+        std::fprintf(out, ", \"calls_per_call\": %.2f, \"mean_us\": %.1f, \"max_us\": %.1f, \"share\": %.3f}",
+                     static_cast<double>(s.calls) / n, static_cast<double>(s.total_ns) / 1000.0 / n,
+                     static_cast<double>(s.max_ns) / 1000.0,
+                     total_us > 0 ? static_cast<double>(s.total_ns) / 1000.0 / total_us : 0.0);
+    }
+    std::fprintf(out, "%s]}", first_stage ? "" : "\n    ");
+    return failures < options.iterations;
+}
+
+} // namespace detail
+
+// Runs every case (all cold runs first, so each cold case includes the process's first call),
+// then prints the report to `out`. Returns 0, or 1 if every call of every case failed.
+inline int Run(const char *platform, const std::vector<Case> &cases, const Options &options, const StageApi &api,
+               FILE *out = stdout) {
+    std::fprintf(out, "{\"platform\": \"%s\", \"iterations\": %d, \"stages_available\": %s, \"cases\": [", platform,
+                 options.iterations, api.available() ? "true" : "false");
+    bool first_record = true;
+    bool any_succeeded = false;
+    if (options.cold)
+        for (const Case &c : cases) any_succeeded |= detail::RunMode(c, "cold", true, options, api, out, first_record);
+    if (options.warm)
+        for (const Case &c : cases) any_succeeded |= detail::RunMode(c, "warm", false, options, api, out, first_record);
+    std::fprintf(out, "\n]}\n");
+    return any_succeeded ? 0 : 1;
+}
+
+} // namespace bench
@@ -0,0 +1,250 @@
+"""
+cpu_topology.py  -  Python mirror of interops/common/include/cpu_topology.h
+
+Native processor topology exported by device_info (get_cpu_topology_arena): packages, physical cores, SMT, the core
+classes of hybrid CPUs, the cache hierarchy with the logical processors sharing each cache, and the instruction-set
+extensions as a bitset, all in one call. The platform bindings (`interops/win/bindings/cpu_topology.py`,
+`interops/mac/bindings/cpu_topology.py`, `interops/linux/bindings/cpu_topology.py`) wrap their library in a
+`CpuTopologyReader`.
+
+Usage:
+    info = topology.read()
+    if info:
+        print(info.packages, info.cores, info.threads, [c.cores for c in info.core_classes])
+        print(info.has(CPU_FEATURE_AVX2), info.feature_names)
+"""
+
+import ctypes
+from dataclasses import dataclass
+from typing import Any, List, Optional
+
+from hwprobe.interops.common.device_arena import (
+    DEVICE_ARENA_KIND_CPU_TOPOLOGY, ArenaString, bind_arena_exports, fetch_arena,
+)
+
+CPU_TOPOLOGY_MAX_CORE_CLASSES = 4
+CPU_TOPOLOGY_MAX_CACHES = 16
+
+CPU_CACHE_UNIFIED = 0
+CPU_CACHE_INSTRUCTION = 1
+CPU_CACHE_DATA = 2
+CPU_CACHE_TRACE = 3
+
+CPU_CACHE_FULLY_ASSOCIATIVE = 0xFF
+CPU_CACHE_ALL_CLASSES = 0xFFFFFFFF
+
+CPU_FEATURE_SSE = 1 << 0
+CPU_FEATURE_SSE2 = 1 << 1
+CPU_FEATURE_SSE3 = 1 << 2
+CPU_FEATURE_SSSE3 = 1 << 3
+CPU_FEATURE_SSE4_1 = 1 << 4
+CPU_FEATURE_SSE4_2 = 1 << 5
+CPU_FEATURE_SSE4A = 1 << 6
+CPU_FEATURE_POPCNT = 1 << 7
+CPU_FEATURE_AES = 1 << 8
+CPU_FEATURE_PCLMULQDQ = 1 << 9
+CPU_FEATURE_AVX = 1 << 10
+CPU_FEATURE_F16C = 1 << 11
+CPU_FEATURE_FMA = 1 << 12
+CPU_FEATURE_AVX2 = 1 << 13
+CPU_FEATURE_BMI1 = 1 << 14
+CPU_FEATURE_BMI2 = 1 << 15
+CPU_FEATURE_LZCNT = 1 << 16
+CPU_FEATURE_SHA = 1 << 17
+CPU_FEATURE_AVX512F = 1 << 18
+CPU_FEATURE_AVX512DQ = 1 << 19
+CPU_FEATURE_AVX512BW = 1 << 20
+CPU_FEATURE_AVX512VL = 1 << 21
+CPU_FEATURE_AVX512VNNI = 1 << 22
+CPU_FEATURE_AVX_VNNI = 1 << 23
+CPU_FEATURE_AMX_TILE = 1 << 24
+CPU_FEATURE_LM = 1 << 25
+CPU_FEATURE_HYBRID = 1 << 26
+
+CPU_FEATURE_NEON = 1 << 32
+CPU_FEATURE_ARM_AES = 1 << 33
+CPU_FEATURE_ARM_SHA2 = 1 << 34
+CPU_FEATURE_CRC32 = 1 << 35
+CPU_FEATURE_LSE = 1 << 36
+CPU_FEATURE_DOTPROD = 1 << 37
+CPU_FEATURE_FP16 = 1 << 38
+CPU_FEATURE_BF16 = 1 << 39
+CPU_FEATURE_I8MM = 1 << 40
+CPU_FEATURE_SVE = 1 << 41
+CPU_FEATURE_SVE2 = 1 << 42
+CPU_FEATURE_SME = 1 << 43
+CPU_FEATURE_SME2 = 1 << 44
+
+# Display names, in bit order; the SSE ones are spelled like CPUInfo.sse_flags
+FEATURE_NAMES = {
+    CPU_FEATURE_SSE: "SSE", CPU_FEATURE_SSE2: "SSE2", CPU_FEATURE_SSE3: "SSE3", CPU_FEATURE_SSSE3: "SSSE3",
+    CPU_FEATURE_SSE4_1: "SSE4.1", CPU_FEATURE_SSE4_2: "SSE4.2", CPU_FEATURE_SSE4A: "SSE4A",
+    CPU_FEATURE_POPCNT: "POPCNT", CPU_FEATURE_AES: "AES", CPU_FEATURE_PCLMULQDQ: "PCLMULQDQ", CPU_FEATURE_AVX: "AVX",
+    CPU_FEATURE_F16C: "F16C", CPU_FEATURE_FMA: "FMA", CPU_FEATURE_AVX2: "AVX2", CPU_FEATURE_BMI1: "BMI1",
+    CPU_FEATURE_BMI2: "BMI2", CPU_FEATURE_LZCNT: "LZCNT", CPU_FEATURE_SHA: "SHA", CPU_FEATURE_AVX512F: "AVX512F",
+    CPU_FEATURE_AVX512DQ: "AVX512DQ", CPU_FEATURE_AVX512BW: "AVX512BW", CPU_FEATURE_AVX512VL: "AVX512VL",
+    CPU_FEATURE_AVX512VNNI: "AVX512VNNI", CPU_FEATURE_AVX_VNNI: "AVX-VNNI", CPU_FEATURE_AMX_TILE: "AMX-TILE",
+    CPU_FEATURE_LM: "LM", CPU_FEATURE_HYBRID: "HYBRID",
+    CPU_FEATURE_NEON: "NEON", CPU_FEATURE_ARM_AES: "AES", CPU_FEATURE_ARM_SHA2: "SHA2", CPU_FEATURE_CRC32: "CRC32",
+    CPU_FEATURE_LSE: "LSE", CPU_FEATURE_DOTPROD: "DOTPROD", CPU_FEATURE_FP16: "FP16", CPU_FEATURE_BF16: "BF16",
+    CPU_FEATURE_I8MM: "I8MM", CPU_FEATURE_SVE: "SVE", CPU_FEATURE_SVE2: "SVE2", CPU_FEATURE_SME: "SME",
+    CPU_FEATURE_SME2: "SME2",
+}
+
+
+class _CPUCoreClass(ctypes.Structure):
+    _fields_ = [
+        ("cpus", ArenaString),
+        ("efficiency_class", ctypes.c_uint32),
+        ("cores", ctypes.c_uint32),
+        ("threads", ctypes.c_uint32),
+        ("reserved", ctypes.c_uint32),
+    ]
+
+
+class _CPUCacheRecord(ctypes.Structure):
+    _fields_ = [
+        ("shared_cpus", ArenaString),
+        ("size_bytes", ctypes.c_uint64),
+        ("level", ctypes.c_uint32),
+        ("type", ctypes.c_uint32),
+        ("line_size", ctypes.c_uint32),
+        ("associativity", ctypes.c_uint32),
+        ("core_class", ctypes.c_uint32),
+        ("instances", ctypes.c_uint32),
+        ("threads_per_instance", ctypes.c_uint32),
+        ("reserved", ctypes.c_uint32),
+    ]
+
+
+class _CPUTopologyRecord(ctypes.Structure):
+    _fields_ = [
+        ("vendor", ArenaString),
+        ("brand", ArenaString),
+        ("features", ctypes.c_uint64),
+        ("family", ctypes.c_uint32),
+        ("model", ctypes.c_uint32),
+        ("stepping", ctypes.c_uint32),
+        ("packages", ctypes.c_uint32),
+        ("cores", ctypes.c_uint32),
+        ("threads", ctypes.c_uint32),
+        ("smt_width", ctypes.c_uint32),
+        ("numa_nodes", ctypes.c_uint32),
+        ("processor_groups", ctypes.c_uint32),
+        ("core_class_count", ctypes.c_uint32),
+        ("cache_count", ctypes.c_uint32),
+        ("reserved", ctypes.c_uint32),
+        ("core_classes", _CPUCoreClass * CPU_TOPOLOGY_MAX_CORE_CLASSES),
+        ("caches", _CPUCacheRecord * CPU_TOPOLOGY_MAX_CACHES),
+    ]
+
+
+@dataclass
+class CoreClass:
+    efficiency_class: int             # 0 is the most power-efficient class
+    cores: int
+    threads: int
+    cpus: Optional[str]               # CPU list, e.g. "0-15"; None on macOS
+
+
+@dataclass
+class CacheLevel:
+    level: int
+    type: int                         # CPU_CACHE_*
+    size_bytes: int                   # one instance
+    line_size: int                    # 0 if not reported
+    associativity: int                # ways, CPU_CACHE_FULLY_ASSOCIATIVE, or 0 if not reported
+    core_class: Optional[int]         # index into CPUTopology.core_classes; None if shared across classes
+    instances: int
+    threads_per_instance: int
+    shared_cpus: List[str]            # one CPU list per instance; empty on macOS
+
+
+@dataclass
+class CPUTopology:
+    vendor: Optional[str]             # CPUID vendor, None on ARM
+    brand: Optional[str]
+    features: int                     # CPU_FEATURE_* bitset
+    family: int
+    model: int
+    stepping: int
+    packages: int
+    cores: int
+    threads: int
+    smt_width: int
+    numa_nodes: int
+    processor_groups: int
+    core_classes: List[CoreClass]     # fastest first
+    caches: List[CacheLevel]          # by level, then instruction / data / unified
+
+    def has(self, feature: int) -> bool:
+        return bool(self.features & feature)
+
+    @property
+    def feature_names(self) -> List[str]:
+        return [name for bit, name in FEATURE_NAMES.items() if self.features & bit]
+
+    @property
+    def hybrid(self) -> bool:
+        return len(self.core_classes) > 1
+
+
+def _topology(raw: _CPUTopologyRecord, strings) -> CPUTopology:
+    classes = [
+        CoreClass(efficiency_class=c.efficiency_class, cores=c.cores, threads=c.threads, cpus=strings.get(c.cpus))
+        for c in raw.core_classes[:min(raw.core_class_count, CPU_TOPOLOGY_MAX_CORE_CLASSES)]
+    ]
+    caches = [
+        CacheLevel(
+            level=c.level,
+            type=c.type,
+            size_bytes=c.size_bytes,
+            line_size=c.line_size,
+            associativity=c.associativity,
+            core_class=None if c.core_class == CPU_CACHE_ALL_CLASSES else c.core_class,
+            instances=c.instances,
+            threads_per_instance=c.threads_per_instance,
+            shared_cpus=(strings.get(c.shared_cpus) or "").split(),
+        )
+        for c in raw.caches[:min(raw.cache_count, CPU_TOPOLOGY_MAX_CACHES)]
+    ]
+    return CPUTopology(
+        vendor=strings.get(raw.vendor),
+        brand=strings.get(raw.brand),
+        features=raw.features,
+        family=raw.family,
+        model=raw.model,
+        stepping=raw.stepping,
+        packages=raw.packages,
+        cores=raw.cores,
+        threads=raw.threads,
+        smt_width=raw.smt_width,
+        numa_nodes=raw.numa_nodes,
+        processor_groups=raw.processor_groups,
+        core_classes=classes,
+        caches=caches,
+    )
+
+
+class CpuTopologyReader:
+    """Topology export of one native library; `read()` returns None if it lacks it."""
+
+    def __init__(self, lib: Any):
+        self._lib = lib if hasattr(lib, "get_cpu_topology_arena") else None
+        if self._lib is not None:
+            bind_arena_exports(lib, lib.get_cpu_topology_arena)
+
+    @property
+    def supported(self) -> bool:
+        return self._lib is not None
+
+    def read(self) -> Optional[CPUTopology]:
+        """The processor topology; None if unsupported or the query failed."""
+        if self._lib is None:
+            return None
+        arena = fetch_arena(self._lib.get_cpu_topology_arena, self._lib, DEVICE_ARENA_KIND_CPU_TOPOLOGY,
+                            _CPUTopologyRecord)
+        if arena is None or len(arena[0]) != 1:
+            return None
+        records, strings = arena
+        return _topology(records[0], strings)
@@ -0,0 +1,143 @@
+"""
+device_arena.py  -  Python mirror of interops/common/include/device_arena.h
+
+Decodes the blob behind the `*_arena` exports of device_info (get_gpu_info_arena, get_storage_info_arena, ...):
+a header, `record_count` compact fixed-size records and one string pool. The blob is copied out of the library
+once; records are then read in place with `from_buffer` and only the strings that are asked for are decoded.
+
+Usage (from a platform binding):
+    records, strings = fetch_arena(_lib.get_gpu_info_arena, _lib, DEVICE_ARENA_KIND_WIN_GPU, _WinGPURecord)
+    name = strings.get(records[0].name)
+"""
+
+import ctypes
+from typing import Any, Callable, Optional, Tuple
+
+# Set inside device_snapshot.activate() / device_probe.prefetched_arenas(): (kind, record_type) -> (records, strings),
+# or None to query live
+_arena_source: Optional[Callable[[int, type], Optional[Tuple[Any, "ArenaStrings"]]]] = None
+
+DEVICE_ARENA_STATUS_OK = 0
+DEVICE_ARENA_STATUS_FAILURE = 1
+DEVICE_ARENA_STATUS_INVALID_ARG = 2
+DEVICE_ARENA_STATUS_BUFFER_TOO_SMALL = 3
+
+DEVICE_ARENA_MAGIC = 0x4E524144
+DEVICE_ARENA_VERSION = 1
+
+DEVICE_ARENA_KIND_WIN_GPU = 1
+DEVICE_ARENA_KIND_MAC_GPU = 2
+DEVICE_ARENA_KIND_MAC_STORAGE = 3
+DEVICE_ARENA_KIND_LINUX_CPU = 4
+DEVICE_ARENA_KIND_LINUX_GPU = 5
+DEVICE_ARENA_KIND_LINUX_NIC = 6
+DEVICE_ARENA_KIND_EDID = 7
+DEVICE_ARENA_KIND_CPU_TOPOLOGY = 8
+DEVICE_ARENA_KIND_SNAPSHOT_DELTA = 9
+DEVICE_ARENA_KIND_WIN_STORAGE = 10
+
+
+# ---- Mirror the C structs ----
+
+class ArenaString(ctypes.Structure):
+    _fields_ = [
+        ("offset", ctypes.c_uint32),
+        ("length", ctypes.c_uint32),
+    ]
+
+
+class _DeviceArenaHeader(ctypes.Structure):
+    _fields_ = [
+        ("magic", ctypes.c_uint32),
+        ("version", ctypes.c_uint32),
+        ("header_size", ctypes.c_uint32),
+        ("kind", ctypes.c_uint32),
+        ("record_size", ctypes.c_uint32),
+        ("record_count", ctypes.c_uint32),
+        ("records_offset", ctypes.c_uint64),
+        ("strings_offset", ctypes.c_uint64),
+        ("strings_size", ctypes.c_uint64),
+        ("total_size", ctypes.c_uint64),
+    ]
+
+
+class ArenaStrings:
+    """Read-only view of the string pool; `get()` decodes one ArenaString on demand."""
+
+    def __init__(self, pool: memoryview):
+        self._pool = pool
+
+    def get(self, ref: ArenaString) -> Optional[str]:
+        """The referenced string, or None if it is empty / was not reported."""
+        if ref.length == 0 or ref.offset + ref.length > len(self._pool):
+            return None
+        return bytes(self._pool[ref.offset:ref.offset + ref.length]).decode("utf-8", errors="replace")
+
+
+def decode_arena(blob: Any, kind: int, record_type: type) -> Tuple[Any, ArenaStrings]:
+    """
+    Map a blob produced by `device_arena_copy` as (records, strings) without copying the records.
+    `blob` is any writable buffer (bytearray, or a memoryview of a mapped snapshot). `records` is a ctypes
+    array of `record_type` backed by `blob`, so keep `blob` alive while reading it.
+    Raises ValueError if the blob is not an arena of `kind` with this binding's record layout.
+    """
+    if len(blob) < ctypes.sizeof(_DeviceArenaHeader):
+        raise ValueError("Device arena blob is truncated")
+
+    header = _DeviceArenaHeader.from_buffer(blob)
+    if (
+        header.magic != DEVICE_ARENA_MAGIC
+        or header.version != DEVICE_ARENA_VERSION
+        or header.kind != kind
+        or header.record_size != ctypes.sizeof(record_type)
+        or header.total_size != len(blob)
+        or header.records_offset + header.record_count * header.record_size > header.strings_offset
+        or header.strings_offset + header.strings_size > header.total_size
+    ):
+        raise ValueError("Unexpected device arena layout")
+
+    records = (record_type * header.record_count).from_buffer(blob, header.records_offset)
+    pool = memoryview(blob)[header.strings_offset:header.strings_offset + header.strings_size]
+    return records, ArenaStrings(pool)
+
+
+def bind_arena_exports(lib: Any, query: Callable) -> None:
+    """Set argtypes/restypes for one `*_arena` export and the shared device_arena_* functions."""
+    query.restype = ctypes.c_int
+    query.argtypes = [ctypes.POINTER(ctypes.c_void_p)]
+
+    lib.device_arena_size.restype = ctypes.c_uint64
+    lib.device_arena_size.argtypes = [ctypes.c_void_p]
+    lib.device_arena_copy.restype = ctypes.c_int
+    lib.device_arena_copy.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint64]
+    lib.device_arena_free.restype = None
+    lib.device_arena_free.argtypes = [ctypes.c_void_p]
+
+
+def fetch_arena(query: Callable, lib: Any, kind: int, record_type: type) -> Optional[Tuple[Any, ArenaStrings]]:
+    """
+    Phase 1: run `query` (enumerates once, natively) and ask for the exact blob size.
+    Phase 2: copy into one buffer of that size and map it.
+    Returns None if the native query fails.
+
+    While an on-disk snapshot is active (see device_snapshot.py), its arena of `kind` is returned instead.
+    """
+    if _arena_source is not None:
+        cached = _arena_source(kind, record_type)
+        if cached is not None:
+            return cached
+
+    handle = ctypes.c_void_p()
+    if query(ctypes.byref(handle)) != DEVICE_ARENA_STATUS_OK or not handle:
+        return None
+
+    try:
+        size = lib.device_arena_size(handle)
+        blob = bytearray(size)
+        buffer = (ctypes.c_char * size).from_buffer(blob)
+        if lib.device_arena_copy(handle, buffer, size) != DEVICE_ARENA_STATUS_OK:
+            return None
+    finally:
+        lib.device_arena_free(handle)
+
+    return decode_arena(blob, kind, record_type)
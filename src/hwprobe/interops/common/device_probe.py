@@ -0,0 +1,152 @@
+"""
+device_probe.py  -  Python mirror of interops/common/include/device_probe.h
+
+Runs several native enumerations (GPU and storage arenas, WMI tables) concurrently in one call, so a full sweep costs
+about as much as its slowest category. Each job yields the same blob its single-shot export returns; the
+`prefetched_arenas()` context manager hands arena blobs to `fetch_arena()`, so the regular bindings decode them as if
+they had queried the library themselves.
+
+Usage (from a platform binding):
+    blobs = probe_all(_lib, [ProbeJob(DEVICE_PROBE_GPU)])
+    with prefetched_arenas(blob for blob in blobs if blob is not None):
+        ...fetch_graphics_info()...
+"""
+
+import ctypes
+from contextlib import contextmanager
+from dataclasses import dataclass
+from typing import Any, Dict, Iterable, List, Optional, Sequence, Tuple
+
+from hwprobe.interops.common import device_arena
+from hwprobe.interops.common.device_arena import DEVICE_ARENA_MAGIC, _DeviceArenaHeader, decode_arena
+
+DEVICE_PROBE_STATUS_OK = 0
+DEVICE_PROBE_STATUS_FAILURE = 1
+DEVICE_PROBE_STATUS_INVALID_ARG = 2
+DEVICE_PROBE_STATUS_UNSUPPORTED = 3
+DEVICE_PROBE_STATUS_TIMED_OUT = 4
+
+DEVICE_PROBE_GPU = 1
+DEVICE_PROBE_STORAGE = 2
+DEVICE_PROBE_WMI_TABLE = 3
+
+
+# ---- Mirror the C structs ----
+
+class _DeviceProbeJob(ctypes.Structure):
+    _fields_ = [
+        ("type", ctypes.c_uint32),
+        ("query", ctypes.c_char_p),
+        ("cim_namespace", ctypes.c_char_p),
+        ("columns", ctypes.POINTER(ctypes.c_char_p)),
+        ("column_count", ctypes.c_int),
+        ("timeout_ms", ctypes.c_uint32),
+    ]
+
+
+@dataclass(frozen=True)
+class ProbeJob:
+    type: int
+    query: Optional[str] = None
+    namespace: Optional[str] = None
+    columns: Tuple[str, ...] = ()
+    timeout_ms: int = 0  # WMI only: deadline of the query, 0 for none
+
+
+def bind_probe_exports(lib: Any) -> bool:
+    """Set argtypes/restypes of the device_probe_* exports; False if `lib` predates them."""
+    if not hasattr(lib, "device_probe_all"):
+        return False
+    lib.device_probe_all.restype = ctypes.c_int
+    lib.device_probe_all.argtypes = [
+        ctypes.POINTER(_DeviceProbeJob), ctypes.c_int, ctypes.c_int, ctypes.POINTER(ctypes.c_void_p),
+    ]
+    lib.device_probe_result_get.restype = ctypes.c_int
+    lib.device_probe_result_get.argtypes = [
+        ctypes.c_void_p, ctypes.c_int, ctypes.POINTER(ctypes.c_int),
+        ctypes.POINTER(ctypes.c_void_p), ctypes.POINTER(ctypes.c_uint64),
+    ]
+    lib.device_probe_result_free.restype = None
+    lib.device_probe_result_free.argtypes = [ctypes.c_void_p]
+    return True
+
+
+def probe_all(lib: Any, jobs: Sequence[ProbeJob], max_threads: int = 0) -> List[Optional[bytearray]]:
+    """
+    Run `jobs` concurrently (the GIL is released for the whole batch) and return one blob per job,
+    in order; None for a job that failed or is not supported on this platform. A WMI job that hit its
+    deadline returns the rows it read until then.
+    """
+    if not jobs:
+        return []
+
+    raw = (_DeviceProbeJob * len(jobs))()
+    keep_alive = []  # encoded strings must outlive the native call
+    for slot, job in zip(raw, jobs):
+        slot.type = job.type
+        if job.type == DEVICE_PROBE_WMI_TABLE:
+            encoded = [c.encode("utf-8") for c in job.columns]
+            columns = (ctypes.c_char_p * len(encoded))(*encoded)
+            keep_alive.append(columns)
+            slot.query = job.query.encode("utf-8")
+            slot.cim_namespace = job.namespace.encode("utf-8")
+            slot.columns = columns
+            slot.column_count = len(encoded)
+            slot.timeout_ms = job.timeout_ms
+
+    handle = ctypes.c_void_p()
+    if lib.device_probe_all(raw, len(jobs), max_threads, ctypes.byref(handle)) != DEVICE_PROBE_STATUS_OK:
+        return [None] * len(jobs)
+
+    out: List[Optional[bytearray]] = []
+    try:
+        status = ctypes.c_int()
+        data = ctypes.c_void_p()
+        size = ctypes.c_uint64()
+        for index in range(len(jobs)):
+            res = lib.device_probe_result_get(handle, index, ctypes.byref(status), ctypes.byref(data), ctypes.byref(size))
+            ok = status.value in (DEVICE_PROBE_STATUS_OK, DEVICE_PROBE_STATUS_TIMED_OUT)
+            if res != DEVICE_PROBE_STATUS_OK or not ok or not data.value:
+                out.append(None)
+            else:
+                out.append(bytearray(ctypes.string_at(data.value, size.value)))
+    finally:
+        lib.device_probe_result_free(handle)
+    return out
+
+
+def _arena_kind(blob: bytearray) -> Optional[int]:
+    if len(blob) < ctypes.sizeof(_DeviceArenaHeader):
+        return None
+    header = _DeviceArenaHeader.from_buffer(blob)
+    return header.kind if header.magic == DEVICE_ARENA_MAGIC else None
+
+
+@contextmanager
+def prefetched_arenas(blobs: Iterable[bytearray]):
+    """
+    Serve each arena blob to the first `fetch_arena()` of its kind inside the block; later calls (and kinds
+    that were not prefetched) go to the previous source, a snapshot or the live query.
+    """
+    pending: Dict[int, bytearray] = {}
+    for blob in blobs:
+        kind = _arena_kind(blob)
+        if kind is not None:
+            pending[kind] = blob
+
+    previous = device_arena._arena_source
+
+    def source(kind: int, record_type: type):
+        blob = pending.pop(kind, None)
+        if blob is not None:
+            try:
+                return decode_arena(blob, kind, record_type)
+            except ValueError:
+                pass
+        return previous(kind, record_type) if previous is not None else None
+
+    device_arena._arena_source = source
+    try:
+        yield
+    finally:
+        device_arena._arena_source = previous
@@ -0,0 +1,224 @@
+"""
+device_replay.py  -  Python mirror of interops/common/include/device_replay.h
+
+Record / replay of the raw OS responses the native probes parse (sysfs and procfs reads, the SMBIOS table, WMI
+results, and on Windows the DXGI / SetupAPI / registry / devnode property / disk IOCTL answers behind the GPU and
+storage enumeration). Record once on a machine that has the hardware, then replay the corpus anywhere: the same
+parsing code runs, so a benchmark or profile of it no longer needs the machine. `Corpus` reads and writes the corpus
+format, and `Corpus.clone()` turns one recorded sysfs device into many for scaling runs.
+
+Usage (from a platform binding):
+    with record(_lib) as recording:
+        ...call the exports...
+    open(path, "wb").write(recording.corpus.to_bytes())
+
+    corpus = Corpus.from_bytes(open(path, "rb").read())
+    corpus.clone("/sys/bus/pci/devices", "0000:01:00.0", [pci_slot(i) for i in range(1000)])
+    with replay(_lib, corpus.to_bytes()):
+        ...call the exports: they see 1001 GPUs...
+"""
+
+import ctypes
+import struct
+from contextlib import contextmanager
+from typing import Any, Dict, Iterable, Iterator, List, Optional, Tuple
+
+DEVICE_REPLAY_STATUS_OK = 0
+DEVICE_REPLAY_STATUS_FAILURE = 1
+DEVICE_REPLAY_STATUS_INVALID_ARG = 2
+DEVICE_REPLAY_STATUS_CORRUPT = 3
+DEVICE_REPLAY_STATUS_BUSY = 4
+DEVICE_REPLAY_STATUS_BUFFER_TOO_SMALL = 5
+
+DEVICE_REPLAY_SYSFS_FILE = 1
+DEVICE_REPLAY_SYSFS_LINK = 2
+DEVICE_REPLAY_SYSFS_LIST = 3
+DEVICE_REPLAY_SYSFS_DIR = 4
+DEVICE_REPLAY_SMBIOS = 5
+DEVICE_REPLAY_WMI_TABLE = 6
+DEVICE_REPLAY_WMI_TEXT = 7
+DEVICE_REPLAY_WMI_COLUMNS = 8
+DEVICE_REPLAY_WIN_DXGI_ADAPTERS = 9
+DEVICE_REPLAY_WIN_DEVICE_LIST = 10
+DEVICE_REPLAY_WIN_REGISTRY_KEYS = 11
+DEVICE_REPLAY_WIN_REGISTRY_VALUE = 12
+DEVICE_REPLAY_WIN_DEVNODE_PROPERTY = 13
+DEVICE_REPLAY_WIN_DEVICE_IOCTL = 14
+
+DEVICE_REPLAY_MAGIC = 0x4C505244  # "DRPL"
+DEVICE_REPLAY_VERSION = 1
+
+_SYSFS_CHANNELS = (DEVICE_REPLAY_SYSFS_FILE, DEVICE_REPLAY_SYSFS_LINK, DEVICE_REPLAY_SYSFS_LIST,
+                   DEVICE_REPLAY_SYSFS_DIR)
+
+# DeviceReplayHeader and DeviceReplayEntry
+_HEADER = struct.Struct("<IIIIQ")
+_ENTRY = struct.Struct("<IIQ")
+
+
+def _align8(size: int) -> int:
+    return (size + 7) & ~7
+
+
+class Corpus:
+    """The entries of a corpus: (channel, key) -> value, all bytes. Keys of sysfs channels are absolute paths."""
+
+    def __init__(self, entries: Optional[Dict[Tuple[int, bytes], bytes]] = None):
+        self.entries: Dict[Tuple[int, bytes], bytes] = dict(entries or {})
+
+    @classmethod
+    def from_bytes(cls, data: bytes) -> "Corpus":
+        """Parse a corpus; ValueError if `data` is not one, or a layout this module does not read."""
+        if len(data) < _HEADER.size:
+            raise ValueError("corpus: too small")
+        magic, version, header_size, count, total_size = _HEADER.unpack_from(data)
+        if magic != DEVICE_REPLAY_MAGIC or version != DEVICE_REPLAY_VERSION:
+            raise ValueError("corpus: bad magic or version")
+        if header_size < _HEADER.size or total_size != len(data):
+            raise ValueError("corpus: bad header")
+
+        entries = {}
+        offset = header_size
+        for _ in range(count):
+            if offset + _ENTRY.size > len(data):
+                raise ValueError("corpus: truncated entry")
+            channel, key_size, value_size = _ENTRY.unpack_from(data, offset)
+            body = offset + _ENTRY.size
+            if body + key_size + value_size > len(data):
+                raise ValueError("corpus: truncated entry")
+            key = bytes(data[body:body + key_size])
+            entries[(channel, key)] = bytes(data[body + key_size:body + key_size + value_size])
+            offset = _align8(body + key_size + value_size)
+        return cls(entries)
+
+    def to_bytes(self) -> bytes:
+        """The corpus in the native layout, entries sorted by channel and key as device_replay_start() expects."""
+        parts = []
+        for (channel, key), value in sorted(self.entries.items()):
+            record = _ENTRY.pack(channel, len(key), len(value)) + key + value
+            parts.append(record + b"\0" * (_align8(len(record)) - len(record)))
+        body = b"".join(parts)
+        return _HEADER.pack(DEVICE_REPLAY_MAGIC, DEVICE_REPLAY_VERSION, _HEADER.size, len(parts),
+                            _HEADER.size + len(body)) + body
+
+    def __len__(self) -> int:
+        return len(self.entries)
+
+    def get(self, channel: int, key: str) -> Optional[bytes]:
+        return self.entries.get((channel, key.encode()))
+
+    def put(self, channel: int, key: str, value: bytes = b"") -> None:
+        self.entries[(channel, key.encode())] = value
+
+    def listing(self, path: str) -> List[str]:
+        """Names recorded for the directory `path` (empty if it was never listed)."""
+        value = self.get(DEVICE_REPLAY_SYSFS_LIST, path) or b""
+        return [name.decode(errors="surrogateescape") for name in value.split(b"\0")[:-1]]
+
+    def clone(self, parent: str, name: str, new_names: Iterable[str]) -> int:
+        """
+        Make every sysfs entry recorded under `parent`/`name` appear again under `parent`/<new name>, for each new
+        name, and add the names to the listing of `parent`. Occurrences of `name` in the copied values (a PCI slot in
+        a link target or a uevent file) are renamed too, so each clone is described consistently. Returns the number of
+        clones added; entries of other channels (SMBIOS, WMI) are left alone.
+        """
+        prefix = f"{parent}/{name}".encode()
+        sources = [(channel, key, value) for (channel, key), value in self.entries.items()
+                   if channel in _SYSFS_CHANNELS and (key == prefix or key.startswith(prefix + b"/"))]
+        old = name.encode()
+
+        names = self.listing(parent)
+        added = 0
+        for new_name in new_names:
+            if new_name == name or new_name in names:
+                continue
+            new = new_name.encode()
+            new_prefix = f"{parent}/{new_name}".encode()
+            for channel, key, value in sources:
+                self.entries[(channel, new_prefix + key[len(prefix):])] = value.replace(old, new)
+            names.append(new_name)
+            added += 1
+
+        self.put(DEVICE_REPLAY_SYSFS_LIST, parent, b"".join(n.encode(errors="surrogateescape") + b"\0" for n in names))
+        return added
+
+
+def pci_slot(index: int) -> str:
+    """A distinct PCI address for synthetic device `index`: one device per bus, 256 buses per domain above 0x1000."""
+    return f"{0x1000 + (index >> 8):04x}:{index & 0xff:02x}:00.0"
+
+
+# ---- Native exports ----
+
+def bind_replay_exports(lib: Any) -> bool:
+    """Set argtypes/restypes of the device_replay_* exports; False if `lib` predates them."""
+    if not hasattr(lib, "device_replay_start"):
+        return False
+    lib.device_replay_record_start.restype = ctypes.c_int
+    lib.device_replay_record_start.argtypes = []
+    lib.device_replay_record_stop.restype = ctypes.c_int
+    lib.device_replay_record_stop.argtypes = [ctypes.POINTER(ctypes.c_void_p)]
+    lib.device_replay_corpus_size.restype = ctypes.c_uint64
+    lib.device_replay_corpus_size.argtypes = [ctypes.c_void_p]
+    lib.device_replay_corpus_copy.restype = ctypes.c_int
+    lib.device_replay_corpus_copy.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint64]
+    lib.device_replay_corpus_free.restype = None
+    lib.device_replay_corpus_free.argtypes = [ctypes.c_void_p]
+    lib.device_replay_start.restype = ctypes.c_int
+    lib.device_replay_start.argtypes = [ctypes.c_void_p, ctypes.c_uint64]
+    lib.device_replay_stop.restype = None
+    lib.device_replay_stop.argtypes = []
+    return True
+
+
+class Recording:
+    """What a `record()` block captured; `corpus` is set when the block exits."""
+
+    def __init__(self):
+        self.corpus: Optional[Corpus] = None
+
+
+def _take_corpus(lib: Any) -> Corpus:
+    handle = ctypes.c_void_p()
+    if lib.device_replay_record_stop(ctypes.byref(handle)) != DEVICE_REPLAY_STATUS_OK or not handle.value:
+        raise RuntimeError("device_replay_record_stop() failed")
+    try:
+        size = lib.device_replay_corpus_size(handle)
+        buffer = (ctypes.c_char * size)()
+        if lib.device_replay_corpus_copy(handle, buffer, size) != DEVICE_REPLAY_STATUS_OK:
+            raise RuntimeError("device_replay_corpus_copy() failed")
+    finally:
+        lib.device_replay_corpus_free(handle)
+    return Corpus.from_bytes(buffer.raw)
+
+
+@contextmanager
+def record(lib: Any) -> Iterator[Recording]:
+    """Record every hooked read the exports of `lib` make inside the block. RuntimeError if already active."""
+    status = lib.device_replay_record_start()
+    if status != DEVICE_REPLAY_STATUS_OK:
+        raise RuntimeError(f"device_replay_record_start() failed ({status})")
+    recording = Recording()
+    try:
+        yield recording
+    except BaseException:
+        lib.device_replay_stop()
+        raise
+    recording.corpus = _take_corpus(lib)
+
+
+@contextmanager
+def replay(lib: Any, data: bytes) -> Iterator[None]:
+    """
+    Answer every hooked read of `lib` from the corpus `data` inside the block. ValueError if the library rejects the
+    corpus, RuntimeError if it is already recording or replaying.
+    """
+    status = lib.device_replay_start(data, len(data))
+    if status == DEVICE_REPLAY_STATUS_CORRUPT:
+        raise ValueError("device_replay_start(): not a corpus this library reads")
+    if status != DEVICE_REPLAY_STATUS_OK:
+        raise RuntimeError(f"device_replay_start() failed ({status})")
+    try:
+        yield
+    finally:
+        lib.device_replay_stop()
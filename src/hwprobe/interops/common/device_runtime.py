@@ -0,0 +1,64 @@
+"""
+device_runtime.py  -  Python mirror of interops/common/include/device_runtime.h
+
+Process lifecycle of a device_info library: device_info_init, device_info_shutdown. Every export of the libraries may
+be called from any thread at once (the contract is in device_runtime.h), and the bindings load them with
+`ctypes.CDLL` / `ctypes.WinDLL`, which release the GIL for the duration of each native call: probes issued from
+several Python threads run in parallel with each other and with the caller's own Python code, with no lock on the
+Python side.
+
+init() is optional; it moves the process-wide set-up to a point the caller chooses, and on Windows keeps COM loaded
+between calls made from short-lived threads. The platform bindings (`interops/win/bindings/device_runtime.py`,
+`interops/mac/bindings/device_runtime.py`, `interops/linux/bindings/device_runtime.py`) wrap their library in a
+`DeviceRuntime`.
+
+Usage:
+    with runtime.session():
+        with ThreadPoolExecutor() as pool:
+            graphics, cpu = pool.submit(fetch_graphics_info), pool.submit(fetch_cpu_info)
+"""
+
+import contextlib
+import ctypes
+from typing import Any, Iterator
+
+DEVICE_RUNTIME_STATUS_OK = 0
+DEVICE_RUNTIME_STATUS_FAILURE = 1
+
+
+class DeviceRuntime:
+    """Lifecycle exports of one native library; every method is a no-op if it lacks them."""
+
+    def __init__(self, lib: Any):
+        self._lib = lib if hasattr(lib, "device_info_init") else None
+        if self._lib is None:
+            return
+
+        lib.device_info_init.restype = ctypes.c_int
+        lib.device_info_init.argtypes = []
+        lib.device_info_shutdown.restype = None
+        lib.device_info_shutdown.argtypes = []
+
+    @property
+    def supported(self) -> bool:
+        return self._lib is not None
+
+    def init(self) -> bool:
+        """Process-wide set-up; nests, so every successful init() needs a shutdown(). False if it failed."""
+        if self._lib is None:
+            return False
+        return self._lib.device_info_init() == DEVICE_RUNTIME_STATUS_OK
+
+    def shutdown(self) -> None:
+        if self._lib is not None:
+            self._lib.device_info_shutdown()
+
+    @contextlib.contextmanager
+    def session(self) -> Iterator[bool]:
+        """init() around the block, shutdown() after it if init() succeeded; yields whether it did."""
+        initialized = self.init()
+        try:
+            yield initialized
+        finally:
+            if initialized:
+                self.shutdown()
@@ -0,0 +1,246 @@
+"""
+device_snapshot.py  -  Python mirror of interops/common/include/device_snapshot.h
+
+Memory-mapped inventory snapshot for short-lived processes: `device_snapshot_write()` stores the native enumeration
+results (one DeviceArena per category) in a single file, and a later process on the same boot maps it, validates it
+natively and reads the records in place. Inside an `activate()` block, `fetch_arena()` serves its arenas instead of
+enumerating.
+
+Usage (from a platform binding):
+    snapshot = load_snapshot(_lib, path)
+    if snapshot is None:
+        ...probe live, then write_snapshot(_lib, path)
+    else:
+        with activate(snapshot):
+            ...native queries are answered from the file
+
+`diff_snapshots()` compares a snapshot file with another one or with the live system natively, keyed by stable
+device identities (PCI path, BSD name, PnP instance ID, ...), and returns only what was added, removed or changed.
+"""
+
+import contextlib
+import ctypes
+import mmap
+import os
+from typing import Any, Dict, Iterator, List, Optional, Tuple
+
+from hwprobe.interops.common import device_arena
+from hwprobe.interops.common.device_arena import (
+    DEVICE_ARENA_KIND_SNAPSHOT_DELTA, ArenaString, ArenaStrings, bind_arena_exports, decode_arena, fetch_arena,
+)
+
+DEVICE_SNAPSHOT_STATUS_OK = 0
+DEVICE_SNAPSHOT_STATUS_FAILURE = 1
+DEVICE_SNAPSHOT_STATUS_INVALID_ARG = 2
+DEVICE_SNAPSHOT_STATUS_CORRUPT = 3
+DEVICE_SNAPSHOT_STATUS_STALE = 4
+
+DEVICE_SNAPSHOT_BOOT_ID_SIZE = 40
+
+DEVICE_DELTA_ADDED = 1
+DEVICE_DELTA_REMOVED = 2
+DEVICE_DELTA_CHANGED = 3
+
+
+# ---- Mirror the C structs ----
+
+class _DeviceSnapshotKey(ctypes.Structure):
+    _fields_ = [
+        ("boot_id", ctypes.c_char * DEVICE_SNAPSHOT_BOOT_ID_SIZE),
+        ("hardware_fingerprint", ctypes.c_uint64),
+    ]
+
+
+class _DeviceSnapshotHeader(ctypes.Structure):
+    _fields_ = [
+        ("magic", ctypes.c_uint32),
+        ("version", ctypes.c_uint32),
+        ("header_size", ctypes.c_uint32),
+        ("section_count", ctypes.c_uint32),
+        ("key", _DeviceSnapshotKey),
+        ("created_unix", ctypes.c_uint64),
+        ("total_size", ctypes.c_uint64),
+    ]
+
+
+class _DeviceSnapshotSection(ctypes.Structure):
+    _fields_ = [
+        ("kind", ctypes.c_uint32),
+        ("reserved", ctypes.c_uint32),
+        ("offset", ctypes.c_uint64),
+        ("size", ctypes.c_uint64),
+    ]
+
+
+class _DeviceDeltaRecord(ctypes.Structure):
+    _fields_ = [
+        ("kind", ctypes.c_uint32),
+        ("change", ctypes.c_uint32),
+        ("key", ArenaString),
+        ("field", ArenaString),
+        ("old_value", ArenaString),
+        ("new_value", ArenaString),
+    ]
+
+
+class DeviceSnapshot:
+    """A validated snapshot file. The mapping is private (copy-on-write), so records can be mapped in place."""
+
+    def __init__(self, mapping: mmap.mmap, sections: Dict[int, Tuple[int, int]]):
+        self._mapping = mapping
+        self._sections = sections
+        self._decoded: Dict[int, Tuple[Any, ArenaStrings]] = {}
+
+    def kinds(self):
+        return sorted(self._sections)
+
+    def arena(self, kind: int, record_type: type) -> Optional[Tuple[Any, ArenaStrings]]:
+        """(records, strings) of the section of `kind`, or None if the snapshot has none / a different layout."""
+        if kind not in self._decoded:
+            if kind not in self._sections:
+                return None
+            offset, size = self._sections[kind]
+            try:
+                self._decoded[kind] = decode_arena(memoryview(self._mapping)[offset:offset + size], kind, record_type)
+            except ValueError:
+                return None
+        return self._decoded[kind]
+
+
+class SnapshotDelta:
+    """
+    What changed between two inventories, per device. Devices are `(kind, key)` pairs: the DeviceArenaKind of the
+    category and the stable key the library assigned, e.g. `(DEVICE_ARENA_KIND_WIN_GPU, "pci_path=PciRoot(0x0)/...")`.
+    Values are text as the library rendered them (integers in decimal); None means empty / not reported.
+    """
+
+    def __init__(self):
+        self.added: Dict[Tuple[int, str], Dict[str, Optional[str]]] = {}
+        self.removed: List[Tuple[int, str]] = []
+        self.changed: Dict[Tuple[int, str], Dict[str, Tuple[Optional[str], Optional[str]]]] = {}
+
+    def __bool__(self) -> bool:
+        return bool(self.added or self.removed or self.changed)
+
+    def to_dict(self) -> Dict[str, list]:
+        """JSON-ready form, for uploading the delta instead of the whole inventory."""
+        return {
+            "added": [{"kind": kind, "key": key, "fields": fields} for (kind, key), fields in self.added.items()],
+            "removed": [{"kind": kind, "key": key} for kind, key in self.removed],
+            "changed": [
+                {"kind": kind, "key": key, "fields": {name: {"old": old, "new": new}
+                                                      for name, (old, new) in fields.items()}}
+                for (kind, key), fields in self.changed.items()
+            ],
+        }
+
+
+def bind_snapshot_exports(lib: Any) -> bool:
+    """Set argtypes/restypes of the device_snapshot_* exports; False if `lib` predates them."""
+    if not hasattr(lib, "device_snapshot_write"):
+        return False
+    lib.device_snapshot_write.restype = ctypes.c_int
+    lib.device_snapshot_write.argtypes = [ctypes.c_char_p]
+    lib.device_snapshot_validate.restype = ctypes.c_int
+    lib.device_snapshot_validate.argtypes = [ctypes.c_void_p, ctypes.c_uint64]
+    lib.device_snapshot_current_key.restype = ctypes.c_int
+    lib.device_snapshot_current_key.argtypes = [ctypes.POINTER(_DeviceSnapshotKey)]
+    if hasattr(lib, "device_snapshot_diff"):
+        # The delta comes back as a device arena; bind device_arena_*, then the diff's own signature.
+        bind_arena_exports(lib, lib.device_snapshot_diff)
+        lib.device_snapshot_diff.restype = ctypes.c_int
+        lib.device_snapshot_diff.argtypes = [ctypes.c_void_p, ctypes.c_uint64, ctypes.c_void_p, ctypes.c_uint64,
+                                             ctypes.POINTER(ctypes.c_void_p)]
+    return True
+
+
+def write_snapshot(lib: Any, path: str) -> bool:
+    """Probe natively and atomically replace `path` with the result."""
+    return lib.device_snapshot_write(os.fsencode(path)) == DEVICE_SNAPSHOT_STATUS_OK
+
+
+def load_snapshot(lib: Any, path: str) -> Optional[DeviceSnapshot]:
+    """Map `path` and validate it for this boot and this set of devices; None if missing, corrupt or stale."""
+    try:
+        with open(path, "rb") as file:
+            size = os.fstat(file.fileno()).st_size
+            if size < ctypes.sizeof(_DeviceSnapshotHeader):
+                return None
+            mapping = mmap.mmap(file.fileno(), size, access=mmap.ACCESS_COPY)
+    except (OSError, ValueError):
+        return None
+
+    data = (ctypes.c_char * size).from_buffer(mapping)
+    status = lib.device_snapshot_validate(ctypes.addressof(data), size)
+    if status != DEVICE_SNAPSHOT_STATUS_OK:
+        del data
+        mapping.close()
+        return None
+
+    header = _DeviceSnapshotHeader.from_buffer(mapping)
+    table = (_DeviceSnapshotSection * header.section_count).from_buffer(mapping, ctypes.sizeof(header))
+    sections = {section.kind: (section.offset, section.size) for section in table}
+    return DeviceSnapshot(mapping, sections)
+
+
+@contextlib.contextmanager
+def activate(snapshot: Optional[DeviceSnapshot]) -> Iterator[None]:
+    """Serve `fetch_arena()` from `snapshot` inside the block (None: live queries), then restore the previous source."""
+    previous = device_arena._arena_source
+    device_arena._arena_source = snapshot.arena if snapshot is not None else None
+    try:
+        yield
+    finally:
+        device_arena._arena_source = previous
+
+
+def _read_snapshot(path: str) -> Optional[bytearray]:
+    try:
+        with open(path, "rb") as file:
+            return bytearray(file.read())
+    except OSError:
+        return None
+
+
+def diff_snapshots(lib: Any, previous_path: Optional[str], current_path: Optional[str] = None) -> Optional[SnapshotDelta]:
+    """
+    Compare the snapshot at `previous_path` with the one at `current_path`, or with the live system if that is None.
+    A missing `previous_path` (or None) reports every device as added. None if the library cannot diff, a snapshot
+    file is corrupt, or the live probe fails.
+    """
+    if not hasattr(lib, "device_snapshot_diff"):
+        return None
+
+    previous = _read_snapshot(previous_path) if previous_path else None
+    current = None
+    if current_path is not None:
+        current = _read_snapshot(current_path)
+        if current is None:
+            return None
+
+    def buffer(data):
+        return (ctypes.c_char * len(data)).from_buffer(data) if data else None
+
+    previous_buffer, current_buffer = buffer(previous), buffer(current)
+    arena = fetch_arena(
+        lambda out: lib.device_snapshot_diff(previous_buffer, len(previous or b""), current_buffer,
+                                             len(current or b""), out),
+        lib, DEVICE_ARENA_KIND_SNAPSHOT_DELTA, _DeviceDeltaRecord,
+    )
+    if arena is None:
+        return None
+
+    records, strings = arena
+    delta = SnapshotDelta()
+    for record in records:
+        device = (record.kind, strings.get(record.key) or "")
+        if record.change == DEVICE_DELTA_REMOVED:
+            delta.removed.append(device)
+        elif record.change == DEVICE_DELTA_ADDED:
+            fields = delta.added.setdefault(device, {})
+            if record.field.length:
+                fields[strings.get(record.field)] = strings.get(record.new_value)
+        elif record.change == DEVICE_DELTA_CHANGED:
+            delta.changed.setdefault(device, {})[strings.get(record.field)] = (
+                strings.get(record.old_value), strings.get(record.new_value))
+    return delta
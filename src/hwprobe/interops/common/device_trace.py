@@ -0,0 +1,119 @@
+"""
+device_trace.py  -  Python mirror of interops/common/include/device_trace.h
+
+Hot-path tracing exported by device_info (and by hw_helper.dll when it is built with the trace ring):
+device_info_trace_enable, device_info_get_trace. Every OS call site instrumented with DEVICE_INFO_STAGE /
+DEVICE_TRACE_SCOPE records (name, thread, start, duration) while tracing is on, so a slow or hung
+fetch_hardware_info() can be narrowed down to the DXGI, SetupAPI, WMI or IOKit call that stalls.
+
+The platform bindings (`interops/win/bindings/device_trace.py`, `interops/mac/bindings/device_trace.py`,
+`interops/win/legacy/signatures.py` for hw_helper.dll) wrap their library in a `DeviceTrace`.
+
+Usage:
+    with trace.capture() as events:
+        manager.fetch_hardware_info()
+    for event in slowest(events):
+        print(event.name, event.duration_ns / 1e6, "ms")
+"""
+
+import contextlib
+import ctypes
+import threading
+from dataclasses import dataclass
+from typing import Any, Iterator, List
+
+DEVICE_TRACE_NAME_SIZE = 48
+DEVICE_TRACE_CAPACITY = 4096
+
+
+class _DeviceTraceEvent(ctypes.Structure):
+    _fields_ = [
+        ("sequence", ctypes.c_uint64),
+        ("start_ns", ctypes.c_uint64),
+        ("duration_ns", ctypes.c_uint64),
+        ("thread_id", ctypes.c_uint32),
+        ("reserved", ctypes.c_uint32),
+        ("name", ctypes.c_char * DEVICE_TRACE_NAME_SIZE),
+    ]
+
+
+@dataclass(frozen=True)
+class TraceEvent:
+    name: str
+    thread_id: int
+    start_ns: int        # monotonic clock of the native library, arbitrary origin
+    duration_ns: int
+    sequence: int
+
+
+class DeviceTrace:
+    """Trace ring of one native library; every method is a no-op if it lacks the exports."""
+
+    def __init__(self, lib: Any):
+        self._lib = lib if hasattr(lib, "device_info_get_trace") else None
+        self._lock = threading.Lock()
+        self._cursor = 0
+        self.dropped = 0  # events overwritten before they were read, since this instance was created
+        if self._lib is None:
+            return
+
+        lib.device_info_trace_enable.restype = None
+        lib.device_info_trace_enable.argtypes = [ctypes.c_int]
+        lib.device_info_get_trace.restype = ctypes.c_int
+        lib.device_info_get_trace.argtypes = [
+            ctypes.POINTER(_DeviceTraceEvent),
+            ctypes.c_int,
+            ctypes.POINTER(ctypes.c_uint64),
+            ctypes.POINTER(ctypes.c_uint64),
+        ]
+
+    @property
+    def supported(self) -> bool:
+        return self._lib is not None
+
+    def enable(self) -> None:
+        if self._lib is not None:
+            self._lib.device_info_trace_enable(1)
+
+    def disable(self) -> None:
+        if self._lib is not None:
+            self._lib.device_info_trace_enable(0)
+
+    def read(self) -> List[TraceEvent]:
+        """Events recorded since the previous read(), oldest first."""
+        if self._lib is None:
+            return []
+
+        events: List[TraceEvent] = []
+        buffer = (_DeviceTraceEvent * DEVICE_TRACE_CAPACITY)()
+        with self._lock:
+            while True:
+                cursor = ctypes.c_uint64(self._cursor)
+                dropped = ctypes.c_uint64(0)
+                count = self._lib.device_info_get_trace(buffer, DEVICE_TRACE_CAPACITY, ctypes.byref(cursor),
+                                                        ctypes.byref(dropped))
+                self._cursor = cursor.value
+                self.dropped += dropped.value
+                events.extend(
+                    TraceEvent(e.name.decode("utf-8", "replace"), e.thread_id, e.start_ns, e.duration_ns, e.sequence)
+                    for e in buffer[:count]
+                )
+                if count < DEVICE_TRACE_CAPACITY and dropped.value == 0:
+                    return events
+
+    @contextlib.contextmanager
+    def capture(self) -> Iterator[List[TraceEvent]]:
+        """Traces the block; the yielded list is filled with its events when the block exits."""
+        events: List[TraceEvent] = []
+        self.read()  # skip whatever an earlier capture left behind
+        self.enable()
+        try:
+            yield events
+        finally:
+            self.disable()
+            events.extend(self.read())
+
+
+def slowest(events: List[TraceEvent], count: int = 10) -> List[TraceEvent]:
+    """The `count` longest events, longest first."""
+    return sorted(events, key=lambda e: e.duration_ns, reverse=True)[:count]
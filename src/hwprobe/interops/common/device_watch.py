@@ -0,0 +1,112 @@
+"""
+device_watch.py  -  Python mirror of interops/common/include/device_watch.h
+
+Hot-plug change notifications exported by device_info (device_watch_start, device_watch_generation, ...).
+The platform bindings (`interops/win/bindings/device_watch.py`, `interops/mac/bindings/device_watch.py`)
+wrap their library in a `DeviceWatch`; managers keep results in a `ChangeCache` and only re-probe a category
+after its generation moved on.
+
+Usage:
+    cache = ChangeCache(watch)
+    graphics = cache.get(DEVICE_WATCH_GPU, fetch_graphics_info)
+"""
+
+import ctypes
+import threading
+from typing import Any, Callable, Dict, Optional, Tuple
+
+DEVICE_WATCH_STATUS_OK = 0
+DEVICE_WATCH_STATUS_FAILURE = 1
+DEVICE_WATCH_STATUS_INVALID_ARG = 2
+DEVICE_WATCH_STATUS_UNSUPPORTED = 3
+
+DEVICE_WATCH_GPU = 0
+DEVICE_WATCH_STORAGE = 1
+DEVICE_WATCH_NETWORK = 2
+DEVICE_WATCH_AUDIO = 3
+DEVICE_WATCH_DISPLAY = 4
+
+
+class DeviceWatch:
+    """Change notifications of one native library; every method is a no-op if it lacks the exports."""
+
+    def __init__(self, lib: Any):
+        self._lib = lib if hasattr(lib, "device_watch_start") else None
+        self._started = False
+        if self._lib is None:
+            return
+
+        lib.device_watch_start.restype = ctypes.c_int
+        lib.device_watch_start.argtypes = []
+        lib.device_watch_stop.restype = None
+        lib.device_watch_stop.argtypes = []
+        lib.device_watch_generation.restype = ctypes.c_uint64
+        lib.device_watch_generation.argtypes = [ctypes.c_int]
+        lib.device_watch_invalidate.restype = ctypes.c_int
+        lib.device_watch_invalidate.argtypes = [ctypes.c_int]
+
+    @property
+    def supported(self) -> bool:
+        return self._lib is not None
+
+    def start(self) -> bool:
+        """Register the OS notifications (once per instance). False if unsupported or registration failed."""
+        if self._lib is None:
+            return False
+        if not self._started:
+            self._started = self._lib.device_watch_start() == DEVICE_WATCH_STATUS_OK
+        return self._started
+
+    def stop(self) -> None:
+        if self._started:
+            self._lib.device_watch_stop()
+            self._started = False
+
+    def generation(self, category: int) -> int:
+        """Current generation of `category`; 0 means "not watching", i.e. always re-probe."""
+        if not self._started:
+            return 0
+        return self._lib.device_watch_generation(category)
+
+    def invalidate(self, category: int) -> None:
+        if self._lib is not None:
+            self._lib.device_watch_invalidate(category)
+
+
+class ChangeCache:
+    """Per-category results, reused until the category's generation changes."""
+
+    def __init__(self, watch: Optional[DeviceWatch], keep: Optional[Callable[[Any], bool]] = None):
+        """`keep(value)` returning False (e.g. for a failed probe) leaves `value` out of the cache."""
+        self._watch = watch
+        self._keep = keep
+        self._entries: Dict[int, Tuple[int, Any]] = {}
+        self._lock = threading.Lock()
+
+    def get(self, category: int, fetch: Callable[[], Any]) -> Any:
+        # Read before probing: a change during `fetch` then makes the next call miss.
+        generation = self._watch.generation(category) if self._watch else 0
+        if generation:
+            with self._lock:
+                cached = self._entries.get(category)
+            if cached is not None and cached[0] == generation:
+                return cached[1]
+
+        value = fetch()
+        if generation and (self._keep is None or self._keep(value)):
+            with self._lock:
+                self._entries[category] = (generation, value)
+        return value
+
+    def fresh(self, category: int) -> bool:
+        """True if `get(category, ...)` would return the cached value without probing."""
+        generation = self._watch.generation(category) if self._watch else 0
+        if not generation:
+            return False
+        with self._lock:
+            cached = self._entries.get(category)
+        return cached is not None and cached[0] == generation
+
+    def clear(self) -> None:
+        with self._lock:
+            self._entries.clear()
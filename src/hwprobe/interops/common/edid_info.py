@@ -0,0 +1,176 @@
+"""
+edid_info.py  -  Python mirror of interops/common/include/edid.h
+
+Native EDID reader exported by device_info (get_edid_info_arena, edid_parse): one call enumerates every monitor,
+reads its raw EDID with the extension blocks and decodes it in C++. The platform bindings
+(`interops/win/bindings/edid_info.py`, `interops/linux/bindings/edid_info.py`) wrap their library in an `EdidReader`.
+
+Every `EDIDProperties` carries `hash`, an FNV-1a of the raw EDID: what was derived from a monitor can be kept and
+reused while (device_path, hash) is unchanged.
+
+Usage:
+    for monitor in edid.read() or []:
+        print(monitor.device_path, monitor.name, monitor.max_width, monitor.max_height)
+"""
+
+import ctypes
+from dataclasses import dataclass
+from typing import Any, List, Optional
+
+from hwprobe.interops.common.device_arena import (
+    DEVICE_ARENA_KIND_EDID, DEVICE_ARENA_STATUS_OK, ArenaString, bind_arena_exports, decode_arena, fetch_arena,
+)
+
+EDID_INTERFACE_ANALOG = 0xFE
+EDID_INTERFACE_NOT_REPORTED = 0xFF
+
+EDID_FLAG_VALID = 0x01
+EDID_FLAG_CHECKSUM_OK = 0x02
+EDID_FLAG_CTA = 0x04
+EDID_FLAG_DISPLAYID = 0x08
+EDID_FLAG_HDMI = 0x10
+EDID_FLAG_HDR = 0x20
+
+
+class _EDIDRecord(ctypes.Structure):
+    _fields_ = [
+        ("device_path", ArenaString),
+        ("name", ArenaString),
+        ("serial_text", ArenaString),
+        ("manufacturer_code", ArenaString),
+        ("acpi_path", ArenaString),
+        ("pci_path", ArenaString),
+        ("hash", ctypes.c_uint64),
+        ("vendor_id", ctypes.c_uint32),
+        ("product_id", ctypes.c_uint32),
+        ("serial_number", ctypes.c_uint32),
+        ("size", ctypes.c_uint32),
+        ("year", ctypes.c_uint16),
+        ("version", ctypes.c_uint8),
+        ("revision", ctypes.c_uint8),
+        ("extension_count", ctypes.c_uint8),
+        ("interface", ctypes.c_uint8),
+        ("bit_depth", ctypes.c_uint8),
+        ("flags", ctypes.c_uint8),
+        ("width_cm", ctypes.c_uint16),
+        ("height_cm", ctypes.c_uint16),
+        ("preferred_width", ctypes.c_uint32),
+        ("preferred_height", ctypes.c_uint32),
+        ("preferred_refresh_mhz", ctypes.c_uint32),
+        ("max_width", ctypes.c_uint32),
+        ("max_height", ctypes.c_uint32),
+        ("max_refresh_mhz", ctypes.c_uint32),
+        ("reserved", ctypes.c_uint32),
+    ]
+
+
+@dataclass
+class EDIDProperties:
+    device_path: str                       # Windows monitor interface path, or Linux DRM connector ("card0-DP-1")
+    name: Optional[str]                    # display product name descriptor
+    serial_text: Optional[str]             # display serial number descriptor
+    manufacturer_code: Optional[str]       # PNP ID, e.g. "DEL"
+    acpi_path: Optional[str]               # Linux only
+    pci_path: Optional[str]                # Linux only: the GPU driving the connector
+    hash: int
+    vendor_id: int
+    product_id: int
+    serial_number: int
+    size: int
+    year: int
+    version: int
+    revision: int
+    extension_count: int
+    interface: int                         # EDID 1.4 interface code, EDID_INTERFACE_ANALOG or _NOT_REPORTED
+    bit_depth: int                         # 0 if undefined
+    flags: int
+    width_cm: int
+    height_cm: int
+    preferred_width: int                   # timings are 0 when not reported
+    preferred_height: int
+    preferred_refresh_mhz: int
+    max_width: int
+    max_height: int
+    max_refresh_mhz: int
+
+    @property
+    def valid(self) -> bool:
+        return bool(self.flags & EDID_FLAG_VALID)
+
+
+def _properties(raw: _EDIDRecord, strings) -> EDIDProperties:
+    return EDIDProperties(
+        device_path=strings.get(raw.device_path) or "",
+        name=strings.get(raw.name),
+        serial_text=strings.get(raw.serial_text),
+        manufacturer_code=strings.get(raw.manufacturer_code),
+        acpi_path=strings.get(raw.acpi_path),
+        pci_path=strings.get(raw.pci_path),
+        hash=raw.hash,
+        vendor_id=raw.vendor_id,
+        product_id=raw.product_id,
+        serial_number=raw.serial_number,
+        size=raw.size,
+        year=raw.year,
+        version=raw.version,
+        revision=raw.revision,
+        extension_count=raw.extension_count,
+        interface=raw.interface,
+        bit_depth=raw.bit_depth,
+        flags=raw.flags,
+        width_cm=raw.width_cm,
+        height_cm=raw.height_cm,
+        preferred_width=raw.preferred_width,
+        preferred_height=raw.preferred_height,
+        preferred_refresh_mhz=raw.preferred_refresh_mhz,
+        max_width=raw.max_width,
+        max_height=raw.max_height,
+        max_refresh_mhz=raw.max_refresh_mhz,
+    )
+
+
+class EdidReader:
+    """EDID exports of one native library; `read()` / `parse()` return None if it lacks them."""
+
+    def __init__(self, lib: Any):
+        self._lib = lib if hasattr(lib, "get_edid_info_arena") else None
+        if self._lib is None:
+            return
+
+        bind_arena_exports(lib, lib.get_edid_info_arena)
+        lib.edid_parse.restype = ctypes.c_int
+        lib.edid_parse.argtypes = [ctypes.c_char_p, ctypes.c_uint64, ctypes.POINTER(ctypes.c_void_p)]
+
+    @property
+    def supported(self) -> bool:
+        return self._lib is not None
+
+    def read(self) -> Optional[List[EDIDProperties]]:
+        """Every connected monitor, in enumeration order; None if unsupported or enumeration failed."""
+        if self._lib is None:
+            return None
+        arena = fetch_arena(self._lib.get_edid_info_arena, self._lib, DEVICE_ARENA_KIND_EDID, _EDIDRecord)
+        if arena is None:
+            return None
+        records, strings = arena
+        return [_properties(raw, strings) for raw in records]
+
+    def parse(self, data: bytes) -> Optional[EDIDProperties]:
+        """Decodes raw EDID bytes obtained elsewhere; `device_path` is empty. None if unsupported."""
+        if self._lib is None:
+            return None
+
+        handle = ctypes.c_void_p()
+        if self._lib.edid_parse(data, len(data), ctypes.byref(handle)) != DEVICE_ARENA_STATUS_OK or not handle:
+            return None
+        try:
+            size = self._lib.device_arena_size(handle)
+            blob = bytearray(size)
+            buffer = (ctypes.c_char * size).from_buffer(blob)
+            if self._lib.device_arena_copy(handle, buffer, size) != DEVICE_ARENA_STATUS_OK:
+                return None
+        finally:
+            self._lib.device_arena_free(handle)
+
+        records, strings = decode_arena(blob, DEVICE_ARENA_KIND_EDID, _EDIDRecord)
+        return _properties(records[0], strings) if len(records) else None
@@ -0,0 +1,175 @@
+"""
+gpu_telemetry.py  -  Python mirror of interops/common/include/gpu_telemetry.h
+
+Live GPU telemetry exported by device_info (gpu_telemetry_start, gpu_telemetry_read, ...): a sampler thread inside
+the library reads memory in use, utilization and the current PCIe link of every GPU each interval into a ring
+buffer, and `read()` drains whatever accumulated in one call. Draining only copies memory, so polling it at any rate
+costs no OS calls.
+
+The platform bindings (`interops/win/bindings/gpu_telemetry.py`, `interops/mac/bindings/gpu_telemetry.py`,
+`interops/linux/bindings/gpu_telemetry.py`) wrap their library in a `GpuTelemetry`. `gpu_index` is the GPU's
+position in the platform's `get_gpu_info()` result.
+
+Usage:
+    with telemetry.sampling(interval_ms=100):
+        while rendering():
+            time.sleep(1)
+            for index, sample in latest(telemetry.read()).items():
+                print(index, sample.utilization_percent, sample.memory_used_bytes)
+"""
+
+import contextlib
+import ctypes
+import threading
+from dataclasses import dataclass
+from typing import Any, Dict, Iterator, List, Optional
+
+GPU_TELEMETRY_CAPACITY = 4096
+
+GPU_TELEMETRY_STATUS_OK = 0
+GPU_TELEMETRY_STATUS_FAILURE = 1
+GPU_TELEMETRY_STATUS_INVALID_ARG = 2
+GPU_TELEMETRY_STATUS_UNSUPPORTED = 3
+
+GPU_TELEMETRY_FIELD_MEMORY_USED = 0x01
+GPU_TELEMETRY_FIELD_MEMORY_BUDGET = 0x02
+GPU_TELEMETRY_FIELD_SHARED_MEMORY_USED = 0x04
+GPU_TELEMETRY_FIELD_UTILIZATION = 0x08
+GPU_TELEMETRY_FIELD_PCIE_LINK = 0x10
+GPU_TELEMETRY_FIELD_PROCESS_MEMORY_USED = 0x20
+
+
+class _GpuTelemetrySample(ctypes.Structure):
+    _fields_ = [
+        ("sequence", ctypes.c_uint64),
+        ("timestamp_ns", ctypes.c_uint64),
+        ("memory_used_bytes", ctypes.c_uint64),
+        ("memory_budget_bytes", ctypes.c_uint64),
+        ("shared_memory_used_bytes", ctypes.c_uint64),
+        ("process_memory_used_bytes", ctypes.c_uint64),
+        ("gpu_index", ctypes.c_uint32),
+        ("fields", ctypes.c_uint32),
+        ("utilization_percent", ctypes.c_uint32),
+        ("pcie_gen", ctypes.c_int32),
+        ("pcie_width", ctypes.c_int32),
+        ("reserved", ctypes.c_uint32),
+    ]
+
+
+@dataclass(frozen=True)
+class GpuSample:
+    """One GPU at one point in time; a value the backend could not read is None."""
+    gpu_index: int
+    timestamp_ns: int                           # monotonic clock of the native library, arbitrary origin
+    sequence: int
+    memory_used_bytes: Optional[int]            # dedicated video memory in use, all processes
+    memory_budget_bytes: Optional[int]          # Windows: this process's budget; elsewhere total dedicated memory
+    shared_memory_used_bytes: Optional[int]     # system memory mapped for the GPU (unified memory on Apple Silicon)
+    process_memory_used_bytes: Optional[int]    # Windows: dedicated memory used by this process
+    utilization_percent: Optional[int]          # busiest engine
+    pcie_gen: Optional[int]                     # current link
+    pcie_width: Optional[int]
+
+
+def _sample(raw: _GpuTelemetrySample) -> GpuSample:
+    fields = raw.fields
+
+    def field(flag: int, value: int) -> Optional[int]:
+        return value if fields & flag else None
+
+    link = bool(fields & GPU_TELEMETRY_FIELD_PCIE_LINK)
+    return GpuSample(
+        gpu_index=raw.gpu_index,
+        timestamp_ns=raw.timestamp_ns,
+        sequence=raw.sequence,
+        memory_used_bytes=field(GPU_TELEMETRY_FIELD_MEMORY_USED, raw.memory_used_bytes),
+        memory_budget_bytes=field(GPU_TELEMETRY_FIELD_MEMORY_BUDGET, raw.memory_budget_bytes),
+        shared_memory_used_bytes=field(GPU_TELEMETRY_FIELD_SHARED_MEMORY_USED, raw.shared_memory_used_bytes),
+        process_memory_used_bytes=field(GPU_TELEMETRY_FIELD_PROCESS_MEMORY_USED, raw.process_memory_used_bytes),
+        utilization_percent=field(GPU_TELEMETRY_FIELD_UTILIZATION, raw.utilization_percent),
+        pcie_gen=(raw.pcie_gen or None) if link else None,
+        pcie_width=(raw.pcie_width or None) if link else None,
+    )
+
+
+class GpuTelemetry:
+    """GPU sampler of one native library; every method is a no-op if it lacks the exports."""
+
+    def __init__(self, lib: Any):
+        self._lib = lib if hasattr(lib, "gpu_telemetry_read") else None
+        self._lock = threading.Lock()
+        self._started = False
+        self._cursor = 0
+        self._buffer = None  # one ring's worth of samples, allocated on the first read
+        self.dropped = 0  # samples overwritten before they were read, since this instance was created
+        if self._lib is None:
+            return
+
+        lib.gpu_telemetry_start.restype = ctypes.c_int
+        lib.gpu_telemetry_start.argtypes = [ctypes.c_uint32]
+        lib.gpu_telemetry_stop.restype = None
+        lib.gpu_telemetry_stop.argtypes = []
+        lib.gpu_telemetry_read.restype = ctypes.c_int
+        lib.gpu_telemetry_read.argtypes = [
+            ctypes.POINTER(_GpuTelemetrySample),
+            ctypes.c_int,
+            ctypes.POINTER(ctypes.c_uint64),
+            ctypes.POINTER(ctypes.c_uint64),
+        ]
+
+    @property
+    def supported(self) -> bool:
+        return self._lib is not None
+
+    def start(self, interval_ms: int = 100) -> bool:
+        """Start sampling (once per instance). False if unsupported or no GPU can be sampled.
+
+        The sampler is shared by the process: if another instance already started it, it keeps its interval.
+        """
+        if self._lib is None:
+            return False
+        with self._lock:
+            if not self._started:
+                self._started = self._lib.gpu_telemetry_start(interval_ms) == GPU_TELEMETRY_STATUS_OK
+            return self._started
+
+    def stop(self) -> None:
+        with self._lock:
+            if self._started:
+                self._lib.gpu_telemetry_stop()
+                self._started = False
+
+    def read(self) -> List[GpuSample]:
+        """Samples published since the previous read(), oldest first."""
+        if self._lib is None:
+            return []
+
+        samples: List[GpuSample] = []
+        with self._lock:
+            if self._buffer is None:
+                self._buffer = (_GpuTelemetrySample * GPU_TELEMETRY_CAPACITY)()
+            while True:
+                cursor = ctypes.c_uint64(self._cursor)
+                dropped = ctypes.c_uint64(0)
+                count = self._lib.gpu_telemetry_read(self._buffer, GPU_TELEMETRY_CAPACITY, ctypes.byref(cursor),
+                                                     ctypes.byref(dropped))
+                self._cursor = cursor.value
+                self.dropped += dropped.value
+                samples.extend(_sample(raw) for raw in self._buffer[:count])
+                if count < GPU_TELEMETRY_CAPACITY and dropped.value == 0:
+                    return samples
+
+    @contextlib.contextmanager
+    def sampling(self, interval_ms: int = 100) -> Iterator[bool]:
+        """Samples during the block; yields whether sampling could be started."""
+        self.read()  # skip whatever an earlier session left behind
+        started = self.start(interval_ms)
+        try:
+            yield started
+        finally:
+            self.stop()
+
+
+def latest(samples: List[GpuSample]) -> Dict[int, GpuSample]:
+    """The most recent sample of each GPU, by gpu_index."""
+    return {sample.gpu_index: sample for sample in samples}
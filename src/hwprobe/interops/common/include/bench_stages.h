@@ -0,0 +1,101 @@
+#pragma once
+
+// Per-stage latency counters for the benchmark build of device_info.
+//
+// DEVICE_INFO_STAGE("name") opens a scope that adds its wall time to the named stage. Without
+// DEVICE_INFO_BENCH_STAGES (every regular build) the macro expands to nothing and the exports
+// below do not exist; the benchmark (`device_info_bench`, -DDEVICE_INFO_BUILD_BENCHMARKS=ON)
+// resolves them at runtime and reports "stages": null for a library built without them.
+//
+// Stages nest (a query stage contains its connect stage), so their shares of a call may add up
+// to more than 100%.
+//
+// Every stage is also a trace point (DEVICE_TRACE_SCOPE, include/device_trace.h), so the call
+// sites instrumented for the benchmark show up in a runtime trace of a regular build too.
+
+#include "device_trace.h"
+
+#include <cstdint>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DEVICE_INFO_STAGE_NAME_SIZE 48
+#define DEVICE_INFO_STAGE_MAX 64
+
+typedef struct {
+    char name[DEVICE_INFO_STAGE_NAME_SIZE];
+    uint64_t calls;
+    uint64_t total_ns;
+    uint64_t max_ns;
+} DeviceInfoStageStats;
+
+#ifdef DEVICE_INFO_BENCH_STAGES
+
+// Number of stages registered so far (a stage registers the first time its scope runs).
+int device_info_stage_count(void);
+
+// Counters of stage `index` (0 <= index < device_info_stage_count()). Returns 0 on success.
+int device_info_stage_get(int index, DeviceInfoStageStats *out);
+
+// Zeroes every counter; registered names are kept.
+void device_info_stage_reset(void);
+
+// operator new calls made by the library since it was loaded.
+uint64_t device_info_alloc_count(void);
+
+#endif
+
+#ifdef __cplusplus
+}
+
+#ifdef DEVICE_INFO_BENCH_STAGES
+
+#include <atomic>
+#include <chrono>
+
+namespace bench_stages {
+
+struct Slot {
+    char name[DEVICE_INFO_STAGE_NAME_SIZE];
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+};
+
+// Returns the slot for `name`, creating it on first use; nullptr once DEVICE_INFO_STAGE_MAX
+// stages exist. `name` must be a string literal.
+Slot *Register(const char *name);
+
+class Scope {
+public:
+    explicit Scope(Slot *slot) : slot_(slot), start_(std::chrono::steady_clock::now()) {}
+    ~Scope();
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+private:
+    Slot *slot_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace bench_stages
+
+#define DEVICE_INFO_STAGE_CONCAT_(a, b) a##b
+#define DEVICE_INFO_STAGE_CONCAT(a, b) DEVICE_INFO_STAGE_CONCAT_(a, b)
+#define DEVICE_INFO_STAGE(name)                                                                   \
+    static bench_stages::Slot *const DEVICE_INFO_STAGE_CONCAT(stage_slot_, __LINE__) =           \
+        bench_stages::Register(name);                                                             \
+    bench_stages::Scope DEVICE_INFO_STAGE_CONCAT(stage_scope_, __LINE__)(                        \
+        DEVICE_INFO_STAGE_CONCAT(stage_slot_, __LINE__));                                         \
+    DEVICE_TRACE_SCOPE(name)
+
+#else
+
+#define DEVICE_INFO_STAGE(name) DEVICE_TRACE_SCOPE(name)
+
+#endif // DEVICE_INFO_BENCH_STAGES
+
+#endif // __cplusplus
@@ -0,0 +1,201 @@
+#pragma once
+
+// Processor topology in one native call: packages, physical cores, SMT, core classes of hybrid
+// CPUs (Intel P/E cores, Apple Silicon performance levels, ARM big.LITTLE), the cache hierarchy
+// with what shares each cache, and the instruction-set extensions as a bitset.
+//
+// The platform backend supplies the topology (GetLogicalProcessorInformationEx over every
+// processor group on Windows, the sysfs CPU topology and cache directories on Linux, the
+// hw.perflevel* sysctls on macOS); on x86 the identity and the features come from CPUID, and on
+// ARM from the OS (IsProcessorFeaturePresent, hwcaps, hw.optional.*).
+
+#include <cstdint>
+
+#include "device_arena.h"
+
+#ifdef __cplusplus
+#include <string>
+#include <vector>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CPU_TOPOLOGY_MAX_CORE_CLASSES 4
+#define CPU_TOPOLOGY_MAX_CACHES 16
+
+// CPUCacheRecord.type, the PROCESSOR_CACHE_TYPE values
+#define CPU_CACHE_UNIFIED 0
+#define CPU_CACHE_INSTRUCTION 1
+#define CPU_CACHE_DATA 2
+#define CPU_CACHE_TRACE 3
+
+#define CPU_CACHE_FULLY_ASSOCIATIVE 0xFF   // CPUCacheRecord.associativity
+#define CPU_CACHE_ALL_CLASSES 0xFFFFFFFFu  // CPUCacheRecord.core_class of a cache shared across core classes
+
+// CPUTopologyRecord.features: x86 (CPUID, with OS support for the AVX state checked through XGETBV)
+#define CPU_FEATURE_SSE (1ull << 0)
+#define CPU_FEATURE_SSE2 (1ull << 1)
+#define CPU_FEATURE_SSE3 (1ull << 2)
+#define CPU_FEATURE_SSSE3 (1ull << 3)
+#define CPU_FEATURE_SSE4_1 (1ull << 4)
+#define CPU_FEATURE_SSE4_2 (1ull << 5)
+#define CPU_FEATURE_SSE4A (1ull << 6)
+#define CPU_FEATURE_POPCNT (1ull << 7)
+#define CPU_FEATURE_AES (1ull << 8)
+#define CPU_FEATURE_PCLMULQDQ (1ull << 9)
+#define CPU_FEATURE_AVX (1ull << 10)
+#define CPU_FEATURE_F16C (1ull << 11)
+#define CPU_FEATURE_FMA (1ull << 12)
+#define CPU_FEATURE_AVX2 (1ull << 13)
+#define CPU_FEATURE_BMI1 (1ull << 14)
+#define CPU_FEATURE_BMI2 (1ull << 15)
+#define CPU_FEATURE_LZCNT (1ull << 16)
+#define CPU_FEATURE_SHA (1ull << 17)
+#define CPU_FEATURE_AVX512F (1ull << 18)
+#define CPU_FEATURE_AVX512DQ (1ull << 19)
+#define CPU_FEATURE_AVX512BW (1ull << 20)
+#define CPU_FEATURE_AVX512VL (1ull << 21)
+#define CPU_FEATURE_AVX512VNNI (1ull << 22)
+#define CPU_FEATURE_AVX_VNNI (1ull << 23)
+#define CPU_FEATURE_AMX_TILE (1ull << 24)
+#define CPU_FEATURE_LM (1ull << 25)      // x86-64 long mode
+#define CPU_FEATURE_HYBRID (1ull << 26)  // CPUID reports a hybrid part
+
+// ARM (OS-reported)
+#define CPU_FEATURE_NEON (1ull << 32)
+#define CPU_FEATURE_ARM_AES (1ull << 33)
+#define CPU_FEATURE_ARM_SHA2 (1ull << 34)
+#define CPU_FEATURE_CRC32 (1ull << 35)
+#define CPU_FEATURE_LSE (1ull << 36)      // large system extensions (atomics)
+#define CPU_FEATURE_DOTPROD (1ull << 37)
+#define CPU_FEATURE_FP16 (1ull << 38)
+#define CPU_FEATURE_BF16 (1ull << 39)
+#define CPU_FEATURE_I8MM (1ull << 40)
+#define CPU_FEATURE_SVE (1ull << 41)
+#define CPU_FEATURE_SVE2 (1ull << 42)
+#define CPU_FEATURE_SME (1ull << 43)
+#define CPU_FEATURE_SME2 (1ull << 44)
+
+// Cores of one kind. Classes are listed fastest first; a CPU that is not hybrid has one.
+typedef struct {
+    ArenaString cpus;           // its logical processors as a CPU list ("0-15,32-47"); empty on macOS
+    uint32_t efficiency_class;  // 0 is the most power-efficient class, as in Windows' EfficiencyClass
+    uint32_t cores;
+    uint32_t threads;
+    uint32_t reserved;
+} CPUCoreClass;
+
+// The caches of one kind: same level, type and geometry, serving one core class.
+typedef struct {
+    ArenaString shared_cpus;        // one CPU list per instance, space-separated: what shares each
+                                    // instance ("0-1 2-3 ..."); empty on macOS
+    uint64_t size_bytes;            // one instance
+    uint32_t level;
+    uint32_t type;                  // CPU_CACHE_*
+    uint32_t line_size;             // bytes, 0 if not reported
+    uint32_t associativity;         // ways, CPU_CACHE_FULLY_ASSOCIATIVE, or 0 if not reported
+    uint32_t core_class;            // index into core_classes, or CPU_CACHE_ALL_CLASSES
+    uint32_t instances;
+    uint32_t threads_per_instance;  // largest number of logical processors sharing one instance
+    uint32_t reserved;
+} CPUCacheRecord;
+
+// The whole processor complex; values are 0 (strings empty) when not reported.
+typedef struct {
+    ArenaString vendor;         // CPUID vendor, e.g. "GenuineIntel"; empty on ARM
+    ArenaString brand;          // CPUID brand string; macOS: machdep.cpu.brand_string
+    uint64_t features;          // CPU_FEATURE_*
+    uint32_t family;            // x86 display family / model / stepping
+    uint32_t model;
+    uint32_t stepping;
+    uint32_t packages;
+    uint32_t cores;             // physical cores, all packages
+    uint32_t threads;           // logical processors, all packages and processor groups
+    uint32_t smt_width;         // most logical processors on one core
+    uint32_t numa_nodes;
+    uint32_t processor_groups;  // Windows processor groups; 1 elsewhere
+    uint32_t core_class_count;
+    uint32_t cache_count;
+    uint32_t reserved;
+    CPUCoreClass core_classes[CPU_TOPOLOGY_MAX_CORE_CLASSES];
+    CPUCacheRecord caches[CPU_TOPOLOGY_MAX_CACHES];  // by level, then instruction / data / unified
+} CPUTopologyRecord;
+
+// Reads the processor topology into a DeviceArena holding one CPUTopologyRecord (kind
+// DEVICE_ARENA_KIND_CPU_TOPOLOGY). On success `*out` must be released with device_arena_free().
+int get_cpu_topology_arena(DeviceArena **out);
+
+#ifdef __cplusplus
+}
+
+namespace cpu_topology {
+
+// One logical processor. `id` is the Linux CPU number, or on Windows the processor's index
+// across groups (group offset + number in group); `core` identifies its physical core uniquely
+// across packages.
+struct Processor {
+    uint32_t id = 0;
+    uint32_t package = 0;
+    uint32_t core = 0;
+    uint32_t efficiency_class = 0;
+};
+
+// One cache instance and the logical processors sharing it.
+struct Cache {
+    uint32_t level = 0;
+    uint32_t type = CPU_CACHE_UNIFIED;
+    uint64_t size_bytes = 0;
+    uint32_t line_size = 0;
+    uint32_t associativity = 0;
+    std::vector<uint32_t> cpus;
+};
+
+// Already-aggregated counts, for a backend that cannot tell which processor is which (macOS).
+struct CoreClassSummary {
+    uint32_t efficiency_class = 0;
+    uint32_t cores = 0;
+    uint32_t threads = 0;
+};
+
+struct CacheSummary {
+    uint32_t level = 0;
+    uint32_t type = CPU_CACHE_UNIFIED;
+    uint64_t size_bytes = 0;
+    uint32_t line_size = 0;
+    uint32_t associativity = 0;
+    uint32_t core_class = CPU_CACHE_ALL_CLASSES;  // index into `classes`
+    uint32_t instances = 0;
+    uint32_t threads_per_instance = 0;
+};
+
+struct Topology {
+    // Either per-processor data (Windows, Linux)...
+    std::vector<Processor> processors;
+    std::vector<Cache> caches;
+
+    // ...or summaries with the totals below (macOS), used when `processors` is empty.
+    std::vector<CoreClassSummary> classes;
+    std::vector<CacheSummary> cache_summaries;
+    uint32_t packages = 0;
+
+    uint32_t numa_nodes = 0;
+    uint32_t processor_groups = 1;
+
+    // Filled from CPUID on x86 before the backend runs; the backend adds the ARM features and
+    // sets `brand` where CPUID has none.
+    std::string vendor;
+    std::string brand;
+    uint64_t features = 0;
+    uint32_t family = 0;
+    uint32_t model = 0;
+    uint32_t stepping = 0;
+};
+
+// Implemented once per platform; false if the topology cannot be read at all.
+bool PlatformTopology(Topology &out);
+
+} // namespace cpu_topology
+
+#endif
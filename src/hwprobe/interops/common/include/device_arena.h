@@ -0,0 +1,132 @@
+#pragma once
+
+// Variable-length, caller-sized results for the device enumeration exports (get_gpu_info_arena,
+// get_storage_info_arena, ...). A query enumerates once into an opaque DeviceArena; the caller
+// asks for its exact size, allocates one buffer and copies it out in a single call:
+//
+//   DeviceArenaHeader
+//   Record[record_count]   compact fixed-size records, `record_size` bytes each
+//   string pool            UTF-8, every string NUL-terminated, referenced by ArenaString
+//
+// Records never embed fixed char arrays, so a name or path is never truncated and a machine
+// with more devices than the caller expected is never silently cut short.
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __cplusplus
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DEVICE_ARENA_MAGIC 0x4E524144u  // "DARN"
+#define DEVICE_ARENA_VERSION 1
+
+typedef enum {
+    DEVICE_ARENA_STATUS_OK = 0,
+    DEVICE_ARENA_STATUS_FAILURE = 1,
+    DEVICE_ARENA_STATUS_INVALID_ARG = 2,
+    DEVICE_ARENA_STATUS_BUFFER_TOO_SMALL = 3
+} DeviceArenaStatus;
+
+// Identifies the record layout, so a decoder can reject a blob meant for another export.
+typedef enum {
+    DEVICE_ARENA_KIND_WIN_GPU = 1,
+    DEVICE_ARENA_KIND_MAC_GPU = 2,
+    DEVICE_ARENA_KIND_MAC_STORAGE = 3,
+    DEVICE_ARENA_KIND_LINUX_CPU = 4,
+    DEVICE_ARENA_KIND_LINUX_GPU = 5,
+    DEVICE_ARENA_KIND_LINUX_NIC = 6,
+    DEVICE_ARENA_KIND_EDID = 7,
+    DEVICE_ARENA_KIND_CPU_TOPOLOGY = 8,
+    DEVICE_ARENA_KIND_SNAPSHOT_DELTA = 9,
+    DEVICE_ARENA_KIND_WIN_STORAGE = 10
+} DeviceArenaKind;
+
+// `length` bytes at `offset` from the start of the string pool (a NUL follows them).
+// length == 0 means the value is empty or was not reported.
+typedef struct {
+    uint32_t offset;
+    uint32_t length;
+} ArenaString;
+
+typedef struct {
+    uint32_t magic;           // DEVICE_ARENA_MAGIC
+    uint32_t version;         // DEVICE_ARENA_VERSION
+    uint32_t header_size;     // sizeof(DeviceArenaHeader)
+    uint32_t kind;            // DeviceArenaKind
+    uint32_t record_size;     // sizeof(Record)
+    uint32_t record_count;
+    uint64_t records_offset;  // from the start of the blob
+    uint64_t strings_offset;  // from the start of the blob
+    uint64_t strings_size;
+    uint64_t total_size;      // size of the whole blob, equal to device_arena_size()
+} DeviceArenaHeader;
+
+typedef struct DeviceArena DeviceArena;
+
+// Exact number of bytes device_arena_copy() needs.
+uint64_t device_arena_size(const DeviceArena *arena);
+
+// Copies the blob into `out`. Returns DEVICE_ARENA_STATUS_BUFFER_TOO_SMALL (and copies nothing)
+// if `out_size` is less than device_arena_size().
+int device_arena_copy(const DeviceArena *arena, void *out, uint64_t out_size);
+
+void device_arena_free(DeviceArena *arena);
+
+#ifdef __cplusplus
+}
+
+namespace arena {
+
+// Collects records and their strings, then lays them out as one DeviceArena blob.
+// Identical strings (e.g. a vendor name shared by several devices) are stored once.
+class Builder {
+public:
+    Builder(DeviceArenaKind kind, size_t record_size);
+
+    // The string index refers to strings_ of this object
+    Builder(const Builder &) = delete;
+    Builder &operator=(const Builder &) = delete;
+
+    ArenaString Intern(std::string_view value);
+
+    // Copies `record_size` bytes from `record`.
+    void Append(const void *record);
+
+    size_t count() const { return count_; }
+
+    // Hands the finished arena to the caller (release with device_arena_free()).
+    DeviceArena *Finish();
+
+private:
+    // Hash and equality of a pooled string by its contents in strings_
+    struct PoolHash {
+        const std::string *pool;
+        size_t operator()(const ArenaString &ref) const;
+    };
+    struct PoolEqual {
+        const std::string *pool;
+        bool operator()(const ArenaString &a, const ArenaString &b) const;
+    };
+
+    DeviceArenaKind kind_;
+    size_t record_size_;
+    size_t count_ = 0;
+    std::vector<unsigned char> records_;
+    std::string strings_;
+    std::unordered_set<ArenaString, PoolHash, PoolEqual> interned_;
+};
+
+// Runs an `*_arena` export and copies its blob into `blob`. False if the query failed.
+bool Collect(int (*query)(DeviceArena **), std::vector<unsigned char> &blob);
+
+} // namespace arena
+
+#endif
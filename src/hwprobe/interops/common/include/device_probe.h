@@ -0,0 +1,67 @@
+#pragma once
+
+// Runs several independent enumerations at once. Each job blocks on a different OS subsystem
+// (DXGI, WMI RPC, IOKit...), so on a small worker pool the batch takes about as long as its
+// slowest job instead of the sum. Every job's result is the blob its single-shot export would
+// have produced (a DeviceArena for GPU/storage jobs, a WmiTable for WMI jobs), so callers decode
+// it with the decoder they already have.
+
+#include <cstdint>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    DEVICE_PROBE_STATUS_OK = 0,
+    DEVICE_PROBE_STATUS_FAILURE = 1,
+    DEVICE_PROBE_STATUS_INVALID_ARG = 2,
+    DEVICE_PROBE_STATUS_UNSUPPORTED = 3,  // job type not available on this platform
+    DEVICE_PROBE_STATUS_TIMED_OUT = 4     // WMI job hit its deadline; the blob holds the rows read until then
+} DeviceProbeStatus;
+
+typedef enum {
+    DEVICE_PROBE_GPU = 1,        // get_gpu_info_arena()
+    DEVICE_PROBE_STORAGE = 2,    // get_storage_info_arena() (macOS, Windows)
+    DEVICE_PROBE_WMI_TABLE = 3   // wmi_query_table(query, cim_namespace, columns) (Windows)
+} DeviceProbeJobType;
+
+typedef struct {
+    uint32_t type;                // DeviceProbeJobType
+    const char *query;            // WMI only; the strings must outlive device_probe_all()
+    const char *cim_namespace;
+    const char *const *columns;
+    int column_count;
+    uint32_t timeout_ms;          // WMI only: deadline of the query, 0 for none (wmi_query_table_timeout())
+} DeviceProbeJob;
+
+typedef struct DeviceProbeResult DeviceProbeResult;
+
+// Runs `jobs` on up to `max_threads` workers (0: one per job), never more than 8.
+// Workers join COM's multithreaded apartment on Windows. Returns DEVICE_PROBE_STATUS_OK once
+// every job has finished, even if some of them failed; check each with device_probe_result_get().
+int device_probe_all(const DeviceProbeJob *jobs, int job_count, int max_threads, DeviceProbeResult **out);
+
+// Status and blob of job `index`. `*data` stays valid until device_probe_result_free().
+int device_probe_result_get(const DeviceProbeResult *result, int index, int *status,
+                            const void **data, uint64_t *size);
+
+void device_probe_result_free(DeviceProbeResult *result);
+
+#ifdef __cplusplus
+}
+
+#include <vector>
+
+namespace probe {
+
+// Implemented once per platform: runs one job on the calling worker thread.
+int PlatformRunJob(const DeviceProbeJob &job, std::vector<unsigned char> &blob);
+
+// Per-worker setup/teardown (COM apartment on Windows).
+void PlatformThreadEnter();
+void PlatformThreadExit();
+
+} // namespace probe
+
+#endif
@@ -0,0 +1,126 @@
+#pragma once
+
+// Record / replay of the raw OS responses the probes parse, so that the parsing code can be
+// benchmarked and profiled without the hardware. While recording, every hooked read also stores
+// its answer in an in-memory corpus; while replaying, the same reads are answered from a corpus
+// instead of the OS, and the unchanged parsing code runs on a machine that has none of the
+// devices. A corpus can be edited (e.g. one recorded GPU cloned a thousand times) to measure how
+// a probe scales with the device count.
+//
+// Hooked reads (the channel of each entry):
+//   Linux    every sysfs / procfs read through sysfs::Dir: files, symlinks, listings, directories
+//   Linux, Windows  the raw SMBIOS table
+//   Windows  wmi_query_table(), get_wmi_info() and get_wmi_info_columns() results, keyed by
+//            namespace, query and columns
+//   Windows  the GPU and disk enumeration: DXGI adapter descriptors, the SetupAPI display class and
+//            disk interface lists, display class registry values, devnode properties (location
+//            paths, PCI address, PCIe link) and the disk driver IOCTLs
+// IOKit (macOS), NVML, CPUID, getifaddrs() and the GPU telemetry samplers are not hooked: in
+// replay mode they still answer live.
+//
+// A corpus is one blob (the caller does the file I/O, as for snapshots), entries sorted by
+// channel and key:
+//
+//   DeviceReplayHeader
+//   entry_count times: DeviceReplayEntry, key bytes, value bytes, zero padding to 8
+//
+// A read the corpus has no entry for fails, as the OS call would have for a missing device.
+// Only successful reads are recorded.
+
+#include <cstdint>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DEVICE_REPLAY_MAGIC 0x4C505244u  // "DRPL"
+#define DEVICE_REPLAY_VERSION 1
+
+typedef enum {
+    DEVICE_REPLAY_STATUS_OK = 0,
+    DEVICE_REPLAY_STATUS_FAILURE = 1,
+    DEVICE_REPLAY_STATUS_INVALID_ARG = 2,
+    DEVICE_REPLAY_STATUS_CORRUPT = 3,            // not a corpus, or a layout this build does not read
+    DEVICE_REPLAY_STATUS_BUSY = 4,               // already recording or replaying
+    DEVICE_REPLAY_STATUS_BUFFER_TOO_SMALL = 5
+} DeviceReplayStatus;
+
+typedef enum {
+    DEVICE_REPLAY_SYSFS_FILE = 1,   // key: absolute path; value: the file's contents
+    DEVICE_REPLAY_SYSFS_LINK = 2,   // key: absolute path; value: the link target, as stored
+    DEVICE_REPLAY_SYSFS_LIST = 3,   // key: absolute path; value: entry names, each followed by a NUL
+    DEVICE_REPLAY_SYSFS_DIR = 4,    // key: absolute path of a directory that exists; value empty
+    DEVICE_REPLAY_SMBIOS = 5,       // key empty; value: major, minor, revision, 0, then the table
+    DEVICE_REPLAY_WMI_TABLE = 6,    // key: "namespace\nquery\ncolumn\ncolumn..."; value: the WmiTable blob
+    DEVICE_REPLAY_WMI_TEXT = 7,     // key: "namespace\nquery"; value: the get_wmi_info() text
+    DEVICE_REPLAY_WMI_COLUMNS = 8,  // key as WMI_TABLE; value: the get_wmi_info_columns() text
+    DEVICE_REPLAY_WIN_DXGI_ADAPTERS = 9,   // key empty; value: DXGI_ADAPTER_DESC1 of every adapter, in order
+    DEVICE_REPLAY_WIN_DEVICE_LIST = 10,    // key: SetupAPI class or interface GUID; value: two strings per device,
+                                           // each followed by a NUL (display class: instance ID, SPDRP_DRIVER;
+                                           // disk interface: device path, instance ID)
+    DEVICE_REPLAY_WIN_REGISTRY_KEYS = 11,  // key: path under HKEY_LOCAL_MACHINE; value: subkey names, each
+                                           // followed by a NUL
+    DEVICE_REPLAY_WIN_REGISTRY_VALUE = 12, // key: "path\nvalue name"; value: REG_* type (4 bytes), then the data
+    DEVICE_REPLAY_WIN_DEVNODE_PROPERTY = 13,  // key: "instance ID\n{fmtid} pid"; value: the property data
+    DEVICE_REPLAY_WIN_DEVICE_IOCTL = 14    // key: "device path\ncode\ninput", code and input in hex; value: the
+                                           // output bytes
+} DeviceReplayChannel;
+
+typedef struct {
+    uint32_t magic;          // DEVICE_REPLAY_MAGIC
+    uint32_t version;        // DEVICE_REPLAY_VERSION
+    uint32_t header_size;    // sizeof(DeviceReplayHeader)
+    uint32_t entry_count;
+    uint64_t total_size;     // size of the whole corpus
+} DeviceReplayHeader;
+
+typedef struct {
+    uint32_t channel;        // DeviceReplayChannel
+    uint32_t key_size;
+    uint64_t value_size;
+} DeviceReplayEntry;
+
+typedef struct DeviceReplayCorpus DeviceReplayCorpus;
+
+// Starts recording into an empty corpus. BUSY while recording or replaying.
+int device_replay_record_start(void);
+
+// Stops recording and hands out what was recorded; release it with device_replay_corpus_free().
+int device_replay_record_stop(DeviceReplayCorpus **out);
+
+uint64_t device_replay_corpus_size(const DeviceReplayCorpus *corpus);
+int device_replay_corpus_copy(const DeviceReplayCorpus *corpus, void *out, uint64_t out_size);
+void device_replay_corpus_free(DeviceReplayCorpus *corpus);
+
+// Checks the layout of `size` bytes at `data` and answers every hooked read from a copy of them
+// until device_replay_stop(). BUSY while recording or replaying.
+int device_replay_start(const void *data, uint64_t size);
+
+// Back to live reads; a recording in progress is discarded.
+void device_replay_stop(void);
+
+#ifdef __cplusplus
+}
+
+#include <string>
+#include <string_view>
+
+namespace replay {
+
+// Whether reads are being recorded or replayed: all a hooked read checks when they are not.
+bool Active();
+bool Replaying();
+
+// Replaying: the recorded answer to (channel, key); false if the corpus has none.
+bool Lookup(uint32_t channel, std::string_view key, std::string &out);
+
+// Recording: keeps `value` as the answer to (channel, key). No-op otherwise.
+void Record(uint32_t channel, std::string_view key, std::string_view value);
+
+// Changes on every start and stop, so process-wide caches of a hooked read (the SMBIOS table)
+// know to read again.
+uint64_t Generation();
+
+} // namespace replay
+
+#endif
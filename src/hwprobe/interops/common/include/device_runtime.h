@@ -0,0 +1,53 @@
+#pragma once
+
+// Concurrency contract of the device_info libraries.
+//
+// - Every export may be called from any thread, concurrently with any other export, including
+//   the same one. A call keeps its working state on its own stack (or in thread_local buffers)
+//   and blocks no other call for longer than it takes to copy a shared result.
+// - Process-wide state is created on first use under a once-flag or a lock and is never torn
+//   down behind a caller's back: the sysfs root descriptors and pci.ids index (Linux), the
+//   SMBIOS table, NVML, and the COM process security (Windows). The opt-in services (WMI
+//   session pool, device watch, GPU telemetry, tracing) have their own counted or idempotent
+//   start / stop exports.
+// - Windows: an export that uses COM joins the calling thread to the MTA for the duration of
+//   the call and leaves the thread as it found it. A thread that is already an STA stays one
+//   and is served through private sessions; CoInitializeSecurity runs once per process.
+// - Results are owned by the caller (arenas, tables, fixed buffers) and may be read and freed on
+//   any thread.
+//
+// device_info_init() is optional: it does the process-wide set-up up front instead of on the
+// first probe, and on Windows keeps the MTA alive between calls, so short-lived caller threads
+// do not load and unload COM on every call. Calls nest: every successful init needs a matching
+// device_info_shutdown().
+
+#include <cstdint>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    DEVICE_RUNTIME_STATUS_OK = 0,
+    DEVICE_RUNTIME_STATUS_FAILURE = 1
+} DeviceRuntimeStatus;
+
+int device_info_init(void);
+
+// Undoes device_info_init() once the last nested call is shut down. Exports stay usable; they
+// go back to setting up per call what they need.
+void device_info_shutdown(void);
+
+#ifdef __cplusplus
+}
+
+namespace runtime {
+
+// Implemented once per platform; called under the lifecycle lock, for the first init and the
+// last shutdown only.
+bool PlatformInit();
+void PlatformShutdown();
+
+} // namespace runtime
+
+#endif
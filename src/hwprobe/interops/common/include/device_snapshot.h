@@ -0,0 +1,157 @@
+#pragma once
+
+// On-disk snapshot of the native enumeration results, for short-lived processes that would
+// otherwise re-probe hardware that has not changed since the last run. The file is one
+// fixed-layout blob, meant to be mmap'ed and read in place:
+//
+//   DeviceSnapshotHeader
+//   DeviceSnapshotSection[section_count]
+//   section payloads       each one a complete DeviceArena blob (see device_arena.h), 8-aligned
+//
+// A snapshot is only valid on the boot it was written on and while the hardware fingerprint
+// (present devnodes on Windows, IOPCIDevice / IOBlockStorageDevice entries on macOS) matches.
+// device_snapshot_validate() checks both; on any mismatch the caller probes live instead.
+//
+// Two snapshots (or a snapshot and the live system) can also be compared natively:
+// device_snapshot_diff() matches the records of each section by a stable device key and returns
+// only what was added, removed or changed, field by field.
+
+#include <cstdint>
+
+#include "device_arena.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DEVICE_SNAPSHOT_MAGIC 0x4E534857u  // "WHSN"
+#define DEVICE_SNAPSHOT_VERSION 1
+#define DEVICE_SNAPSHOT_BOOT_ID_SIZE 40
+
+typedef enum {
+    DEVICE_SNAPSHOT_STATUS_OK = 0,
+    DEVICE_SNAPSHOT_STATUS_FAILURE = 1,
+    DEVICE_SNAPSHOT_STATUS_INVALID_ARG = 2,
+    DEVICE_SNAPSHOT_STATUS_CORRUPT = 3,  // not a snapshot, or a layout this build does not read
+    DEVICE_SNAPSHOT_STATUS_STALE = 4     // well-formed, but from another boot or another set of devices
+} DeviceSnapshotStatus;
+
+// What a snapshot is keyed by.
+typedef struct {
+    char boot_id[DEVICE_SNAPSHOT_BOOT_ID_SIZE];  // NUL-terminated, platform-defined
+    uint64_t hardware_fingerprint;
+} DeviceSnapshotKey;
+
+typedef struct {
+    uint32_t magic;          // DEVICE_SNAPSHOT_MAGIC
+    uint32_t version;        // DEVICE_SNAPSHOT_VERSION
+    uint32_t header_size;    // sizeof(DeviceSnapshotHeader)
+    uint32_t section_count;
+    DeviceSnapshotKey key;
+    uint64_t created_unix;   // seconds, informational
+    uint64_t total_size;     // size of the whole file
+} DeviceSnapshotHeader;
+
+typedef struct {
+    uint32_t kind;           // DeviceArenaKind of the payload
+    uint32_t reserved;
+    uint64_t offset;         // from the start of the file
+    uint64_t size;
+} DeviceSnapshotSection;
+
+// Key of the running system.
+int device_snapshot_current_key(DeviceSnapshotKey *out);
+
+// Enumerates every category this library supports and atomically replaces `path` (UTF-8) with
+// the result (written to "<path>.tmp", then renamed over it).
+int device_snapshot_write(const char *path);
+
+// Checks the layout of `size` bytes at `data`, then its key against the running system.
+int device_snapshot_validate(const void *data, uint64_t size);
+
+// DeviceDeltaRecord.change
+typedef enum {
+    DEVICE_DELTA_ADDED = 1,    // one record per field of the new device that is not empty / 0
+    DEVICE_DELTA_REMOVED = 2,  // one record per device, `field` empty
+    DEVICE_DELTA_CHANGED = 3   // one record per field whose value differs
+} DeviceDeltaChange;
+
+// One entry of a snapshot delta; strings live in the arena's string pool. Values are rendered
+// as text: strings as stored, integers in decimal.
+typedef struct {
+    uint32_t kind;            // DeviceArenaKind of the section the device belongs to
+    uint32_t change;          // DeviceDeltaChange
+    ArenaString key;          // stable device key, "<field>=<value>", e.g. "pci_path=PciRoot(0x0)/Pci(0x1,0x0)"
+    ArenaString field;
+    ArenaString old_value;    // CHANGED only
+    ArenaString new_value;    // ADDED and CHANGED
+} DeviceDeltaRecord;
+
+// Compares the snapshot `previous` with `current` (same layout as device_snapshot_write()
+// files, not checked against the running system) into a DeviceArena of DeviceDeltaRecord
+// (kind DEVICE_ARENA_KIND_SNAPSHOT_DELTA), in section, then record order of `current`; removed
+// devices follow in the order of `previous`. With `current` NULL the library enumerates live and
+// compares against that; with `previous` NULL every device is reported as added. A section
+// missing from `current` (its query failed) is not compared, so it never reports removals. An
+// unchanged system gives an empty arena. On success `*out` must be released with
+// device_arena_free().
+int device_snapshot_diff(const void *previous, uint64_t previous_size, const void *current, uint64_t current_size,
+                         DeviceArena **out);
+
+#ifdef __cplusplus
+}
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// RecordField of `field` in the record struct `record`, e.g. SNAPSHOT_FIELD(GPURecord, vram_mb, U64).
+#define SNAPSHOT_FIELD(record, field, type) \
+    snapshot::RecordField { #field, offsetof(record, field), snapshot::FieldType::type }
+
+namespace snapshot {
+
+using ArenaQuery = int (*)(DeviceArena **);
+
+enum class FieldType { String, U8, U16, U32, I32, U64 };
+
+struct RecordField {
+    const char *name;
+    size_t offset;
+    FieldType type;
+};
+
+// How device_snapshot_diff() reads the records of one section. Fields are listed in record
+// order; a field past the record size of an older snapshot reads as empty / 0, so records that
+// only grew at the end still compare.
+struct RecordSchema {
+    DeviceArenaKind kind;
+    std::vector<RecordField> fields;
+    // Candidate key fields, tried in order: the first one that is not empty keys the device. A
+    // record with none of them (or a schema with no key, for one-record sections) is keyed by
+    // position. Devices sharing a key are told apart by occurrence ("...#2").
+    std::vector<const char *> key;
+};
+
+// Implemented once per platform.
+bool PlatformKey(DeviceSnapshotKey &key);
+std::vector<ArenaQuery> PlatformQueries();
+// One schema per kind PlatformQueries() produces; sections of other kinds are not compared.
+std::vector<RecordSchema> PlatformSchemas();
+// Writes `data` next to `path` and renames it over `path`, so readers never see a partial file.
+bool PlatformWriteAtomically(const std::string &path, const std::vector<unsigned char> &data);
+
+// FNV-1a, for hardware fingerprints.
+class Fingerprint {
+public:
+    void Add(const void *data, size_t size);
+    void Add(uint64_t value) { Add(&value, sizeof(value)); }
+    uint64_t value() const { return hash_; }
+
+private:
+    uint64_t hash_ = 0xCBF29CE484222325ull;
+};
+
+} // namespace snapshot
+
+#endif
@@ -0,0 +1,86 @@
+#pragma once
+
+// Hot-path tracing for the native libraries. DEVICE_TRACE_SCOPE("name") around an OS call site
+// records (name, thread, start, duration) into a fixed ring buffer when tracing is switched on
+// with device_info_trace_enable(1). Recording is lock-free: a writer claims a slot with one
+// atomic increment and publishes it with a per-slot sequence number, so a hung call never
+// blocks other threads and a slow reader never blocks writers (it only loses the oldest events).
+//
+// Built only with DEVICE_INFO_TRACE (on by default, -DDEVICE_INFO_TRACE=OFF to drop it). Without
+// it the macro expands to nothing and the exports below do not exist. While compiled in but
+// switched off, a scope costs one relaxed atomic load.
+
+#include <cstdint>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DEVICE_TRACE_NAME_SIZE 48
+#define DEVICE_TRACE_CAPACITY 4096  // events kept; a power of two
+
+typedef struct {
+    uint64_t sequence;      // position in the trace, increasing without gaps while nothing is dropped
+    uint64_t start_ns;      // monotonic clock, arbitrary origin
+    uint64_t duration_ns;
+    uint32_t thread_id;     // OS thread ID
+    uint32_t reserved;
+    char name[DEVICE_TRACE_NAME_SIZE];
+} DeviceTraceEvent;
+
+#ifdef DEVICE_INFO_TRACE
+
+// Switches recording on (1) or off (0). Events already recorded are kept.
+void device_info_trace_enable(int enabled);
+
+// Copies up to `max_count` events recorded at or after `*cursor`, oldest first, and advances
+// `*cursor` past them (start from 0). `*dropped` (optional) receives how many events in that
+// range were overwritten before they could be read. Returns the number of events copied.
+int device_info_get_trace(DeviceTraceEvent *out, int max_count, uint64_t *cursor, uint64_t *dropped);
+
+#endif
+
+#ifdef __cplusplus
+}
+
+#ifdef DEVICE_INFO_TRACE
+
+#include <atomic>
+
+namespace device_trace {
+
+extern std::atomic<bool> g_enabled;
+
+uint64_t NowNs();
+void Record(const char *name, uint64_t start_ns, uint64_t duration_ns);
+
+class Scope {
+public:
+    // `name` must be a string literal: only the pointer is stored until the event is read.
+    explicit Scope(const char *name)
+        : name_(g_enabled.load(std::memory_order_relaxed) ? name : nullptr), start_(name_ ? NowNs() : 0) {}
+    ~Scope() {
+        if (name_) Record(name_, start_, NowNs() - start_);
+    }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+private:
+    const char *name_;
+    uint64_t start_;
+};
+
+} // namespace device_trace
+
+#define DEVICE_TRACE_CONCAT_(a, b) a##b
+#define DEVICE_TRACE_CONCAT(a, b) DEVICE_TRACE_CONCAT_(a, b)
+#define DEVICE_TRACE_SCOPE(name) device_trace::Scope DEVICE_TRACE_CONCAT(trace_scope_, __LINE__)(name)
+
+#else
+
+#define DEVICE_TRACE_SCOPE(name) static_cast<void>(0)
+
+#endif // DEVICE_INFO_TRACE
+
+#endif // __cplusplus
@@ -0,0 +1,61 @@
+#pragma once
+
+// Hot-plug change notifications. While watching, the platform backend (CM_Register_Notification
+// on Windows, IOKit matching notifications on macOS) bumps a per-category generation whenever a
+// device of that category arrives or leaves. A caller keeps the generation it read before its
+// last enumeration and only re-enumerates once the generation has moved on:
+//
+//   uint64_t seen = device_watch_generation(DEVICE_WATCH_GPU);  // before enumerating
+//   ...enumerate, cache the result together with `seen`...
+//   if (device_watch_generation(DEVICE_WATCH_GPU) == seen) reuse the cache
+//
+// Generation 0 means "not watching": the caller must re-enumerate every time.
+
+#include <cstdint>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    DEVICE_WATCH_STATUS_OK = 0,
+    DEVICE_WATCH_STATUS_FAILURE = 1,
+    DEVICE_WATCH_STATUS_INVALID_ARG = 2,
+    DEVICE_WATCH_STATUS_UNSUPPORTED = 3
+} DeviceWatchStatus;
+
+typedef enum {
+    DEVICE_WATCH_GPU = 0,
+    DEVICE_WATCH_STORAGE = 1,
+    DEVICE_WATCH_NETWORK = 2,
+    DEVICE_WATCH_AUDIO = 3,
+    DEVICE_WATCH_DISPLAY = 4,
+    DEVICE_WATCH_CATEGORY_COUNT = 5
+} DeviceWatchCategory;
+
+// Registers the OS notifications. Calls nest: every successful start needs a matching stop.
+int device_watch_start(void);
+
+void device_watch_stop(void);
+
+// Current generation of `category`, 0 if not watching or `category` is out of range.
+uint64_t device_watch_generation(int category);
+
+// Forces the next generation check of `category` to miss (e.g. after a failed enumeration).
+int device_watch_invalidate(int category);
+
+#ifdef __cplusplus
+}
+
+namespace device_watch {
+
+// Called by the platform backend from its notification thread.
+void MarkChanged(DeviceWatchCategory category);
+
+// Implemented once per platform; PlatformStart() returns false if nothing could be registered.
+bool PlatformStart();
+void PlatformStop();
+
+} // namespace device_watch
+
+#endif
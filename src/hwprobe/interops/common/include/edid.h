@@ -0,0 +1,98 @@
+#pragma once
+
+// EDID of every connected monitor, read and parsed natively in one call. The platform backend
+// (SetupAPI monitor interfaces + registry on Windows, DRM connectors in sysfs on Linux) collects the
+// raw blobs, extension blocks included; the parser here decodes the base block, its four 18-byte
+// descriptors, and the detailed timings of CTA-861 and DisplayID extensions.
+//
+// Every record carries an FNV-1a hash of the raw EDID, so a poller can keep what it derived from a
+// monitor and skip it while (device_path, hash) is unchanged.
+
+#include <cstdint>
+
+#include "device_arena.h"
+
+#ifdef __cplusplus
+#include <string>
+#include <vector>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EDID_BLOCK_SIZE 128
+
+// EDIDRecord.interface: 0-5 are the EDID 1.4 digital interface codes (undefined, DVI, HDMI-a,
+// HDMI-b, MDDI, DisplayPort); anything else in 0-15 is a reserved code.
+#define EDID_INTERFACE_ANALOG 0xFE
+#define EDID_INTERFACE_NOT_REPORTED 0xFF  // digital input on an EDID older than 1.4
+
+// EDIDRecord.flags
+#define EDID_FLAG_VALID 0x01        // 128+ bytes starting with the EDID header; nothing else is set otherwise
+#define EDID_FLAG_CHECKSUM_OK 0x02  // base block checksum matches
+#define EDID_FLAG_CTA 0x04          // has a CTA-861 extension
+#define EDID_FLAG_DISPLAYID 0x08    // has a DisplayID extension
+#define EDID_FLAG_HDMI 0x10         // CTA-861 HDMI (or HDMI Forum) vendor-specific data block
+#define EDID_FLAG_HDR 0x20          // CTA-861 HDR static metadata data block
+
+// One monitor; strings live in the arena's string pool. Timings are 0 when not reported.
+typedef struct {
+    ArenaString device_path;        // Windows: monitor interface path, the monitorDevicePath of GetDisplayPathInfo /
+                                    // GetDisplayTopology (compare case-insensitively); Linux: DRM connector,
+                                    // e.g. "card0-HDMI-A-1"
+    ArenaString name;               // display product name descriptor (0xFC)
+    ArenaString serial_text;        // display serial number descriptor (0xFF)
+    ArenaString manufacturer_code;  // PNP ID, e.g. "DEL"
+    ArenaString acpi_path;          // Linux: connector firmware_node/path
+    ArenaString pci_path;           // Linux: PCI path of the GPU driving the connector
+    uint64_t hash;                  // FNV-1a of the raw EDID, extensions included
+    uint32_t vendor_id;             // bytes 8-9, big-endian as stored
+    uint32_t product_id;            // bytes 10-11, little-endian
+    uint32_t serial_number;         // ID serial number, bytes 12-15
+    uint32_t size;                  // bytes of raw EDID
+    uint16_t year;                  // year of manufacture (or model year)
+    uint8_t version;
+    uint8_t revision;
+    uint8_t extension_count;        // extension blocks present in the raw EDID
+    uint8_t interface;              // see EDID_INTERFACE_*
+    uint8_t bit_depth;              // bits per colour (EDID 1.4 digital), 0 if undefined
+    uint8_t flags;                  // EDID_FLAG_*
+    uint16_t width_cm;
+    uint16_t height_cm;
+    uint32_t preferred_width;       // first detailed timing
+    uint32_t preferred_height;
+    uint32_t preferred_refresh_mhz;
+    uint32_t max_width;             // largest detailed timing (by area, then refresh), extensions included
+    uint32_t max_height;
+    uint32_t max_refresh_mhz;
+    uint32_t reserved;
+} EDIDRecord;
+
+// Reads the EDID of every connected monitor into a DeviceArena of EDIDRecord (kind
+// DEVICE_ARENA_KIND_EDID), in enumeration order. A monitor whose EDID cannot be decoded is still
+// listed, without EDID_FLAG_VALID. On success `*out` must be released with device_arena_free().
+int get_edid_info_arena(DeviceArena **out);
+
+// Parses `size` bytes of raw EDID from elsewhere (a file, another API) into a one-record arena.
+int edid_parse(const uint8_t *data, uint64_t size, DeviceArena **out);
+
+#ifdef __cplusplus
+}
+
+namespace edid {
+
+// One monitor as the platform backend found it.
+struct Monitor {
+    std::string device_path;
+    std::string acpi_path;
+    std::string pci_path;
+    std::vector<uint8_t> data;  // raw EDID, empty if it could not be read
+};
+
+// Implemented once per platform; false if monitors cannot be enumerated at all.
+bool PlatformMonitors(std::vector<Monitor> &out);
+
+} // namespace edid
+
+#endif
@@ -0,0 +1,87 @@
+#pragma once
+
+// Live GPU telemetry. gpu_telemetry_start() opens every GPU once and starts a background thread
+// that samples them each `interval_ms` (memory in use, budget, utilization, current PCIe link)
+// into a preallocated ring buffer. gpu_telemetry_read() drains it in bulk: it only copies memory,
+// so polling costs no OS calls on the reader's side however often it runs.
+//
+// The ring has one writer (the sampler thread) and publishes each slot with a sequence number,
+// like the trace ring: a reader never blocks the sampler, and a slow reader only loses the
+// oldest samples, which it is told about.
+//
+// Backends: the "GPU Adapter Memory" / "GPU Engine" performance counters, IDXGIAdapter3::
+// QueryVideoMemoryInfo and the devnode's current PCIe link on Windows; the accelerator's
+// PerformanceStatistics on macOS; amdgpu / PCI sysfs attributes on Linux.
+
+#include <cstdint>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GPU_TELEMETRY_CAPACITY 4096  // samples kept; a power of two
+#define GPU_TELEMETRY_MIN_INTERVAL_MS 10
+#define GPU_TELEMETRY_MAX_INTERVAL_MS 60000
+
+typedef enum {
+    GPU_TELEMETRY_STATUS_OK = 0,
+    GPU_TELEMETRY_STATUS_FAILURE = 1,      // no GPU could be opened for sampling
+    GPU_TELEMETRY_STATUS_INVALID_ARG = 2,
+    GPU_TELEMETRY_STATUS_UNSUPPORTED = 3
+} GpuTelemetryStatus;
+
+// GpuTelemetrySample.fields: which of the values below the backend could read for this GPU
+#define GPU_TELEMETRY_FIELD_MEMORY_USED 0x01
+#define GPU_TELEMETRY_FIELD_MEMORY_BUDGET 0x02
+#define GPU_TELEMETRY_FIELD_SHARED_MEMORY_USED 0x04
+#define GPU_TELEMETRY_FIELD_UTILIZATION 0x08
+#define GPU_TELEMETRY_FIELD_PCIE_LINK 0x10
+#define GPU_TELEMETRY_FIELD_PROCESS_MEMORY_USED 0x20
+
+typedef struct {
+    uint64_t sequence;                  // position in the ring, increasing without gaps while nothing is dropped
+    uint64_t timestamp_ns;              // monotonic clock, arbitrary origin
+    uint64_t memory_used_bytes;         // dedicated (local) video memory in use, all processes
+    uint64_t memory_budget_bytes;       // Windows: the OS budget for this process; elsewhere total dedicated memory
+    uint64_t shared_memory_used_bytes;  // system memory mapped for the GPU (shared segment, GTT), all processes
+    uint64_t process_memory_used_bytes; // Windows: dedicated memory used by this process
+    uint32_t gpu_index;                 // position of the GPU in get_gpu_info_arena()
+    uint32_t fields;                    // GPU_TELEMETRY_FIELD_*
+    uint32_t utilization_percent;       // busiest engine
+    int32_t pcie_gen;                   // current link, which drops below the maximum while idle
+    int32_t pcie_width;
+    uint32_t reserved;
+} GpuTelemetrySample;
+
+// Opens the GPUs and starts sampling every `interval_ms` (clamped to the MIN/MAX above). Calls
+// nest: every successful start needs a matching stop, and a nested start keeps the running
+// interval. GPUs added while sampling are picked up on the next start.
+int gpu_telemetry_start(uint32_t interval_ms);
+
+void gpu_telemetry_stop(void);
+
+// Copies up to `max_count` samples published at or after `*cursor`, oldest first, and advances
+// `*cursor` past them (start from 0). `*dropped` (optional) receives how many samples in that
+// range were overwritten before they could be read. Returns the number of samples copied.
+int gpu_telemetry_read(GpuTelemetrySample *out, int max_count, uint64_t *cursor, uint64_t *dropped);
+
+#ifdef __cplusplus
+}
+
+namespace gpu_telemetry {
+
+// Adds one sample to the ring; `sample.sequence` is assigned here. Sampler thread only.
+void Publish(GpuTelemetrySample &sample);
+
+uint64_t NowNs();
+
+// Implemented once per platform. PlatformOpen() runs on the starting thread and returns false if
+// no GPU can be sampled; PlatformSample() (one Publish() per GPU) and PlatformClose() run on the
+// sampler thread, so the backend's state needs no locking.
+bool PlatformOpen();
+void PlatformSample();
+void PlatformClose();
+
+} // namespace gpu_telemetry
+
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+
+// In-process NVML (NVIDIA Management Library), loaded at runtime instead of linked: the library
+// ships with the NVIDIA driver, not with this project, and is absent on every other machine.
+// libnvidia-ml.so.1 / nvml.dll is opened and nvmlInit_v2() called on the first query; the library
+// stays loaded and initialised for the life of the process, so later queries cost one call per
+// device attribute instead of a process spawn and an init/shutdown each, as with nvidia-smi.
+//
+// Windows and Linux only: NVML does not exist on macOS.
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace nvml {
+
+// One GPU as NVML reports it. Fields NVML could not read are left at 0 / empty.
+struct Device {
+    uint32_t domain = 0;       // PCI address, from nvmlPciInfo_t.busId
+    uint32_t bus = 0;
+    uint32_t slot = 0;
+    uint32_t function = 0;
+    uint32_t pci_device_id = 0;  // device << 16 | vendor, as in nvmlPciInfo_t
+    std::string name;            // e.g. "NVIDIA GeForce RTX 4090"
+    uint64_t memory_total_bytes = 0;
+    int32_t pcie_gen = 0;        // current link
+    int32_t pcie_width = 0;
+};
+
+// Every GPU NVML sees, queried in one pass. False if NVML is not installed or failed to
+// initialise; the result of that attempt is kept, so a machine without NVML pays for it once.
+bool QueryDevices(std::vector<Device> &out);
+
+// The device at PCI address domain:bus:slot.function in `devices`, or nullptr.
+const Device *Find(const std::vector<Device> &devices, uint32_t domain, uint32_t bus, uint32_t slot,
+                   uint32_t function);
+
+} // namespace nvml
+
+#endif
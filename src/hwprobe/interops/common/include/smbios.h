@@ -0,0 +1,136 @@
+#pragma once
+
+// Platform-independent SMBIOS table engine shared by the Windows and Linux interops.
+//
+// The raw table is fetched once (Windows: GetSystemFirmwareTable('RSMB'), Linux:
+// /sys/firmware/dmi/tables/DMI) and indexed by structure type and handle. Formatted fields
+// and strings are read straight out of the retained buffer; strings are only located when
+// they are asked for.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace smbios {
+
+// Location of a string inside Table::data(): `length` bytes starting at `offset`, no NUL.
+struct StringRef {
+    uint32_t offset = 0;
+    uint32_t length = 0;
+};
+
+struct Version {
+    uint8_t major = 0;
+    uint8_t minor = 0;
+    uint8_t revision = 0;
+};
+
+// View of one structure inside a Table. Every read is checked against the structure's
+// formatted length, so fields that an older SMBIOS version does not define read as `fallback`.
+class Structure {
+public:
+    Structure(const uint8_t *data, const char *strings, const char *strings_end)
+        : data_(data), strings_(strings), strings_end_(strings_end) {}
+
+    uint8_t type() const { return data_[0]; }
+    uint8_t length() const { return data_[1]; }
+    uint16_t handle() const { return static_cast<uint16_t>(data_[2] | (data_[3] << 8)); }
+    const uint8_t *data() const { return data_; }
+    // Formatted area plus string-set, both terminating NULs included.
+    size_t size_bytes() const { return static_cast<size_t>(strings_end_ + 1 - reinterpret_cast<const char *>(data_)); }
+
+    bool Has(size_t offset, size_t width) const { return offset + width <= length(); }
+
+    uint8_t Byte(size_t offset, uint8_t fallback = 0) const;
+    uint16_t Word(size_t offset, uint16_t fallback = 0) const;
+    uint32_t Dword(size_t offset, uint32_t fallback = 0) const;
+    uint64_t Qword(size_t offset, uint64_t fallback = 0) const;
+
+    // Reads a field of any trivially copyable type; see SMBIOS_FIELD for packed structs.
+    template <typename T>
+    T Field(size_t offset, T fallback = T{}) const {
+        if (!Has(offset, sizeof(T))) return fallback;
+        T value;
+        std::memcpy(&value, data_ + offset, sizeof(T));
+        return value;
+    }
+
+    // Resolves the string whose 1-based index is stored in the byte at `offset`.
+    // Returns an empty view for index 0, a missing field or an out-of-range index.
+    std::string_view String(size_t offset) const;
+
+    // Resolves the string with 1-based `index` from the string-set.
+    std::string_view StringAt(uint8_t index) const;
+
+private:
+    uint64_t ReadLE(size_t offset, size_t width) const;
+
+    const uint8_t *data_;
+    const char *strings_;
+    const char *strings_end_;  // one past the last byte of the string-set
+};
+
+class Table {
+public:
+    // Indexes `raw` (the structure table only, without any entry point / RSMB header).
+    // Parsing stops at the end-of-table structure (type 127) or at the first structure
+    // that would run past the end of the buffer.
+    Table(std::vector<uint8_t> raw, Version version);
+
+    Table(const Table &) = delete;
+    Table &operator=(const Table &) = delete;
+
+    const Version &version() const { return version_; }
+    const std::vector<Structure> &structures() const { return structures_; }
+    const uint8_t *data() const { return raw_.data(); }
+    size_t size_bytes() const { return raw_.size(); }
+
+    // Converts a string returned by Structure::String / StringAt into a position in data().
+    StringRef Ref(std::string_view str) const;
+
+    size_t Count(uint8_t type) const { return by_type_[type].size(); }
+
+    // `index`-th structure of `type` in table order, or nullptr.
+    const Structure *Find(uint8_t type, size_t index = 0) const;
+
+    // First structure with `handle`, or nullptr.
+    const Structure *FindHandle(uint16_t handle) const;
+
+private:
+    std::vector<uint8_t> raw_;
+    Version version_;
+    std::vector<Structure> structures_;
+    std::array<std::vector<uint32_t>, 256> by_type_;
+    std::unordered_map<uint16_t, uint32_t> by_handle_;
+};
+
+// Reads the firmware SMBIOS table for this platform. Returns false if it is unavailable
+// (unsupported platform, missing sysfs node, insufficient permissions).
+bool ReadFirmwareTable(std::vector<uint8_t> &raw, Version &version);
+
+// Process-wide table: read from firmware on first use and reused afterwards.
+// Returns nullptr if the firmware table could not be read.
+std::shared_ptr<const Table> Current();
+
+// Re-reads the firmware table and replaces the process-wide one if it changed. The 16 most
+// recently replaced tables are retained, so data() pointers and StringRefs handed out earlier stay
+// valid across that many table changes; a re-read of an identical table changes nothing.
+std::shared_ptr<const Table> Reload();
+
+} // namespace smbios
+
+// Length-aware read of a member of one of the packed SMBIOS structs (e.g. SMBIOSProcessor):
+// yields `fallback` when the structure is too short to contain the member, which is the case
+// for fields added by a later SMBIOS version than the firmware implements.
+//
+//   uint16_t threads = SMBIOS_FIELD(cpu, SMBIOSProcessor, ThreadCount2);
+#define SMBIOS_FIELD(structure, Type, member) \
+    (structure).Field<decltype(Type::member)>(offsetof(Type, member))
+
+#define SMBIOS_FIELD_OR(structure, Type, member, fallback) \
+    (structure).Field<decltype(Type::member)>(offsetof(Type, member), (fallback))
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    SMBIOS_STATUS_OK = 0,
+    SMBIOS_STATUS_FAILURE = 1,      // firmware table unavailable
+    SMBIOS_STATUS_INVALID_ARG = 2,
+    SMBIOS_STATUS_NOT_FOUND = 3     // no such structure, or field beyond the structure's length
+} SmbiosStatus;
+
+typedef struct {
+    uint8_t type;
+    uint8_t length;        // formatted area length, header included
+    uint16_t handle;
+} SmbiosStructureInfo;
+
+typedef struct {
+    uint32_t offset;       // byte offset into the buffer returned by smbios_get_table()
+    uint32_t length;       // string length in bytes, no NUL
+} SmbiosStringRef;
+
+// Re-reads the firmware table. All other calls load it lazily on first use and then reuse it.
+int smbios_refresh(void);
+
+int smbios_get_version(uint8_t *major, uint8_t *minor, uint8_t *revision);
+
+// Number of structures of `type` (0-255), or -1 if the table is unavailable.
+int smbios_count(int type);
+
+// Looks up the `index`-th structure of `type`, in table order.
+int smbios_get_structure(int type, int index, SmbiosStructureInfo *out);
+
+int smbios_get_structure_by_handle(uint16_t handle, SmbiosStructureInfo *out);
+
+// Reads a little-endian field of `width` bytes (1, 2, 4 or 8) at `offset` in the formatted area.
+// Returns SMBIOS_STATUS_NOT_FOUND if the field lies beyond the structure's length.
+int smbios_read_field(uint16_t handle, int offset, int width, uint64_t *out);
+
+// Resolves the string referenced by the index byte at `offset`. Writes a NUL-terminated copy
+// (truncated to `max_len`) and returns the full string length, 0 for "no string", or -1 on error.
+int smbios_read_string(uint16_t handle, int offset, char *out, int max_len);
+
+// Copies the formatted area (header included). Returns the number of bytes the area holds,
+// or -1 on error; copies nothing if `max_len` is smaller than that.
+int smbios_read_formatted(uint16_t handle, uint8_t *out, int max_len);
+
+// Copies the whole structure: formatted area and string-set, up to its double NUL (the layout of a
+// Linux /sys/firmware/dmi/entries/*/raw file). Same return convention as smbios_read_formatted().
+int smbios_read_structure(uint16_t handle, uint8_t *out, int max_len);
+
+// ---- Zero-copy access ----
+
+// Returns a pointer to the retained structure table. The buffer is never modified, and is kept
+// until 16 newer tables have replaced it (smbios_refresh() or a record / replay switch that reads
+// a different table; an identical table is not a new one), so it can be read directly by the caller.
+int smbios_get_table(const uint8_t **data, uint64_t *size);
+
+// Locates the string referenced by the index byte at `offset` inside the buffer returned by
+// smbios_get_table(). A structure without that string yields {0, 0} and SMBIOS_STATUS_OK.
+int smbios_get_string_ref(uint16_t handle, int offset, SmbiosStringRef *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,224 @@
+"""
+smbios_info.py  -  Python mirror of interops/common/include/smbios_info.h
+
+Native SMBIOS engine exported by device_info (smbios_*): the table is fetched from firmware once (Windows:
+GetSystemFirmwareTable('RSMB'), Linux: /sys/firmware/dmi/tables/DMI) and indexed natively; every call afterwards is a
+lookup. The platform bindings (`interops/win/bindings/smbios_info.py`, `interops/linux/bindings/smbios_info.py`) wrap
+their library in an `SmbiosReader` and expose its methods as module functions.
+
+Usage:
+    for board in smbios.get_structures(2):          # Type 2: Baseboard
+        print(smbios.read_string(board.handle, 0x04), smbios.read_string(board.handle, 0x05))
+
+    # Zero-copy: (offset, length) into the retained firmware buffer, decoded on demand
+    view = smbios.string_view(board.handle, 0x05)
+"""
+
+import ctypes
+from dataclasses import dataclass
+from typing import Any, List, Optional, Tuple
+
+SMBIOS_STATUS_OK = 0
+SMBIOS_STATUS_FAILURE = 1
+SMBIOS_STATUS_INVALID_ARG = 2
+SMBIOS_STATUS_NOT_FOUND = 3
+
+
+# ---- Mirror the C structs ----
+
+class _SmbiosStringRef(ctypes.Structure):
+    _fields_ = [
+        ("offset", ctypes.c_uint32),
+        ("length", ctypes.c_uint32),
+    ]
+
+
+class _SmbiosStructureInfo(ctypes.Structure):
+    _fields_ = [
+        ("type", ctypes.c_uint8),
+        ("length", ctypes.c_uint8),
+        ("handle", ctypes.c_uint16),
+    ]
+
+
+# ---- Python-facing dataclass ----
+
+@dataclass
+class SmbiosStructure:
+    type: int
+    length: int
+    handle: int
+
+    def __str__(self) -> str:
+        return f"  Type {self.type:3d}  Handle 0x{self.handle:04X}  Length 0x{self.length:02X}"
+
+
+def _to_dataclass(raw: _SmbiosStructureInfo) -> SmbiosStructure:
+    return SmbiosStructure(type=raw.type, length=raw.length, handle=raw.handle)
+
+
+def bind_smbios_exports(lib: Any) -> None:
+    """Set argtypes/restypes of the smbios_* exports."""
+    lib.smbios_refresh.restype = ctypes.c_int
+    lib.smbios_refresh.argtypes = []
+
+    lib.smbios_get_version.restype = ctypes.c_int
+    lib.smbios_get_version.argtypes = [ctypes.POINTER(ctypes.c_uint8)] * 3
+
+    lib.smbios_count.restype = ctypes.c_int
+    lib.smbios_count.argtypes = [ctypes.c_int]
+
+    lib.smbios_get_structure.restype = ctypes.c_int
+    lib.smbios_get_structure.argtypes = [ctypes.c_int, ctypes.c_int, ctypes.POINTER(_SmbiosStructureInfo)]
+
+    lib.smbios_get_structure_by_handle.restype = ctypes.c_int
+    lib.smbios_get_structure_by_handle.argtypes = [ctypes.c_uint16, ctypes.POINTER(_SmbiosStructureInfo)]
+
+    lib.smbios_read_field.restype = ctypes.c_int
+    lib.smbios_read_field.argtypes = [ctypes.c_uint16, ctypes.c_int, ctypes.c_int, ctypes.POINTER(ctypes.c_uint64)]
+
+    lib.smbios_read_string.restype = ctypes.c_int
+    lib.smbios_read_string.argtypes = [ctypes.c_uint16, ctypes.c_int, ctypes.c_char_p, ctypes.c_int]
+
+    lib.smbios_read_formatted.restype = ctypes.c_int
+    lib.smbios_read_formatted.argtypes = [ctypes.c_uint16, ctypes.POINTER(ctypes.c_uint8), ctypes.c_int]
+
+    # Libraries built before smbios_read_structure() still have every other export
+    if hasattr(lib, "smbios_read_structure"):
+        lib.smbios_read_structure.restype = ctypes.c_int
+        lib.smbios_read_structure.argtypes = [ctypes.c_uint16, ctypes.POINTER(ctypes.c_uint8), ctypes.c_int]
+
+    lib.smbios_get_table.restype = ctypes.c_int
+    lib.smbios_get_table.argtypes = [ctypes.POINTER(ctypes.c_void_p), ctypes.POINTER(ctypes.c_uint64)]
+
+    lib.smbios_get_string_ref.restype = ctypes.c_int
+    lib.smbios_get_string_ref.argtypes = [ctypes.c_uint16, ctypes.c_int, ctypes.POINTER(_SmbiosStringRef)]
+
+
+class SmbiosReader:
+    """SMBIOS exports of one native library; every lookup reports "no table" if it lacks them."""
+
+    def __init__(self, lib: Any):
+        self._lib = lib if hasattr(lib, "smbios_count") else None
+        if self._lib is not None:
+            bind_smbios_exports(lib)
+
+    @property
+    def supported(self) -> bool:
+        return self._lib is not None
+
+    def refresh(self) -> bool:
+        """Re-read the firmware table (e.g. after a hot-plugged DIMM on a server)."""
+        return self._lib is not None and self._lib.smbios_refresh() == SMBIOS_STATUS_OK
+
+    def get_version(self) -> Optional[Tuple[int, int, int]]:
+        """(major, minor, revision); None if the table is unavailable (e.g. not readable without root on Linux)."""
+        if self._lib is None:
+            return None
+        major, minor, rev = ctypes.c_uint8(), ctypes.c_uint8(), ctypes.c_uint8()
+        if self._lib.smbios_get_version(ctypes.byref(major), ctypes.byref(minor),
+                                        ctypes.byref(rev)) != SMBIOS_STATUS_OK:
+            return None
+        return major.value, minor.value, rev.value
+
+    def get_structures(self, smbios_type: int) -> List[SmbiosStructure]:
+        """All structures of `smbios_type`, in table order. Empty if none (or no table)."""
+        if self._lib is None:
+            return []
+        count = self._lib.smbios_count(smbios_type)
+        out = []
+        raw = _SmbiosStructureInfo()
+        for i in range(max(count, 0)):
+            if self._lib.smbios_get_structure(smbios_type, i, ctypes.byref(raw)) == SMBIOS_STATUS_OK:
+                out.append(_to_dataclass(raw))
+        return out
+
+    def get_structure_by_handle(self, handle: int) -> Optional[SmbiosStructure]:
+        if self._lib is None:
+            return None
+        raw = _SmbiosStructureInfo()
+        if self._lib.smbios_get_structure_by_handle(handle, ctypes.byref(raw)) != SMBIOS_STATUS_OK:
+            return None
+        return _to_dataclass(raw)
+
+    def read_field(self, handle: int, offset: int, width: int) -> Optional[int]:
+        """Little-endian field of `width` (1/2/4/8) bytes; None if the structure is too short to hold it."""
+        if self._lib is None:
+            return None
+        value = ctypes.c_uint64()
+        if self._lib.smbios_read_field(handle, offset, width, ctypes.byref(value)) != SMBIOS_STATUS_OK:
+            return None
+        return value.value
+
+    def read_string(self, handle: int, offset: int, buf_size: int = 256) -> Optional[str]:
+        """String referenced by the index byte at `offset`; None if the structure has no such string."""
+        if self._lib is None:
+            return None
+        buffer = ctypes.create_string_buffer(buf_size)
+        length = self._lib.smbios_read_string(handle, offset, buffer, buf_size)
+        if length <= 0:
+            return None
+        if length >= buf_size:
+            buffer = ctypes.create_string_buffer(length + 1)
+            self._lib.smbios_read_string(handle, offset, buffer, length + 1)
+        return buffer.value.decode("utf-8", errors="ignore")
+
+    def read_formatted(self, handle: int) -> Optional[bytes]:
+        """Formatted area of the structure (header included), for callers that decode it themselves."""
+        if self._lib is None:
+            return None
+        buffer = (ctypes.c_uint8 * 256)()
+        length = self._lib.smbios_read_formatted(handle, buffer, len(buffer))
+        if length < 0:
+            return None
+        return bytes(buffer[:length])
+
+    def read_structure(self, handle: int) -> Optional[bytes]:
+        """
+        The whole structure, string-set and double NUL included: the bytes of its /sys/firmware/dmi/entries/*/raw
+        file on Linux. None if the structure does not exist or the library predates smbios_read_structure().
+        """
+        if self._lib is None or not hasattr(self._lib, "smbios_read_structure"):
+            return None
+        buffer = (ctypes.c_uint8 * 1024)()
+        length = self._lib.smbios_read_structure(handle, buffer, len(buffer))
+        if length > len(buffer):
+            buffer = (ctypes.c_uint8 * length)()
+            length = self._lib.smbios_read_structure(handle, buffer, len(buffer))
+        if length < 0:
+            return None
+        return bytes(buffer[:length])
+
+    # ---- Zero-copy access ----
+
+    def get_table_buffer(self) -> Optional[memoryview]:
+        """
+        Read-only view of the native table buffer, without copying it.
+        The library never rewrites a published buffer and keeps it until 16 different tables have replaced it, so the
+        view stays valid unless the table changes that often.
+        """
+        if self._lib is None:
+            return None
+        data = ctypes.c_void_p()
+        size = ctypes.c_uint64()
+        if self._lib.smbios_get_table(ctypes.byref(data), ctypes.byref(size)) != SMBIOS_STATUS_OK or not data.value:
+            return None
+        buf = (ctypes.c_ubyte * size.value).from_address(data.value)
+        return memoryview(buf).cast("B").toreadonly()
+
+    def string_ref(self, handle: int, offset: int) -> Optional[Tuple[int, int]]:
+        """(offset, length) of a structure string inside `get_table_buffer()`; (0, 0) if absent."""
+        if self._lib is None:
+            return None
+        ref = _SmbiosStringRef()
+        if self._lib.smbios_get_string_ref(handle, offset, ctypes.byref(ref)) != SMBIOS_STATUS_OK:
+            return None
+        return ref.offset, ref.length
+
+    def string_view(self, handle: int, offset: int) -> Optional[memoryview]:
+        """Structure string as a slice of the table buffer; only decoded if the caller decodes it."""
+        ref = self.string_ref(handle, offset)
+        table = self.get_table_buffer()
+        if ref is None or table is None or ref[1] == 0:
+            return None
+        return table[ref[0]:ref[0] + ref[1]]
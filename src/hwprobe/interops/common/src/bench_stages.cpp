@@ -0,0 +1,108 @@
+#include "bench_stages.h"
+
+#ifdef DEVICE_INFO_BENCH_STAGES
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace bench_stages {
+
+namespace {
+
+Slot g_slots[DEVICE_INFO_STAGE_MAX];
+std::atomic<int> g_count{0};
+std::mutex g_register_mutex;
+
+std::atomic<uint64_t> g_allocations{0};
+
+} // namespace
+
+Slot *Register(const char *name) {
+    std::lock_guard<std::mutex> lock(g_register_mutex);
+    const int count = g_count.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i)
+        if (std::strcmp(g_slots[i].name, name) == 0) return &g_slots[i];
+    if (count == DEVICE_INFO_STAGE_MAX) return nullptr;
+
+    Slot &slot = g_slots[count];
+    std::strncpy(slot.name, name, sizeof(slot.name) - 1);
+    g_count.store(count + 1, std::memory_order_release);
+    return &slot;
+}
+
+Scope::~Scope() {
+    if (!slot_) return;
+    const auto elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_).count());
+    slot_->calls.fetch_add(1, std::memory_order_relaxed);
+    slot_->total_ns.fetch_add(elapsed, std::memory_order_relaxed);
+    uint64_t max = slot_->max_ns.load(std::memory_order_relaxed);
+    while (elapsed > max && !slot_->max_ns.compare_exchange_weak(max, elapsed, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace bench_stages
+
+// ---- Allocation counting ----
+//
+// Replaces the library's own operator new/delete (the runtime is linked statically on Windows,
+// and a dylib binds its own definitions first), so only the library's allocations are counted.
+
+void *operator new(std::size_t size) {
+    bench_stages::g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    bench_stages::g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept {
+    return ::operator new(size, tag);
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { std::free(p); }
+
+// ---- Exports ----
+
+int device_info_stage_count(void) {
+    return bench_stages::g_count.load(std::memory_order_acquire);
+}
+
+int device_info_stage_get(int index, DeviceInfoStageStats *out) {
+    if (!out || index < 0 || index >= device_info_stage_count()) return 1;
+    const bench_stages::Slot &slot = bench_stages::g_slots[index];
+    std::memcpy(out->name, slot.name, sizeof(out->name));
+    out->calls = slot.calls.load(std::memory_order_relaxed);
+    out->total_ns = slot.total_ns.load(std::memory_order_relaxed);
+    out->max_ns = slot.max_ns.load(std::memory_order_relaxed);
+    return 0;
+}
+
+void device_info_stage_reset(void) {
+    const int count = device_info_stage_count();
+    for (int i = 0; i < count; ++i) {
+        bench_stages::g_slots[i].calls.store(0, std::memory_order_relaxed);
+        bench_stages::g_slots[i].total_ns.store(0, std::memory_order_relaxed);
+        bench_stages::g_slots[i].max_ns.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint64_t device_info_alloc_count(void) {
+    return bench_stages::g_allocations.load(std::memory_order_relaxed);
+}
+
+#endif // DEVICE_INFO_BENCH_STAGES
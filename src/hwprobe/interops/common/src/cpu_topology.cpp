@@ -0,0 +1,351 @@
+#include "cpu_topology.h"
+#include "bench_stages.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CPU_TOPOLOGY_X86 1
+#if defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// ---- Internal helpers ----
+
+namespace {
+
+#if defined(CPU_TOPOLOGY_X86)
+
+struct Registers {
+    uint32_t eax = 0, ebx = 0, ecx = 0, edx = 0;
+};
+
+Registers Cpuid(uint32_t leaf, uint32_t subleaf = 0) {
+    Registers r;
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+    r.eax = regs[0], r.ebx = regs[1], r.ecx = regs[2], r.edx = regs[3];
+#else
+    __cpuid_count(leaf, subleaf, r.eax, r.ebx, r.ecx, r.edx);
+#endif
+    return r;
+}
+
+// XCR0: which register states the OS saves on a context switch. Only valid when CPUID reports OSXSAVE.
+uint64_t EnabledXState() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t low, high;
+    __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return (static_cast<uint64_t>(high) << 32) | low;
+#endif
+}
+
+bool Bit(uint32_t value, int bit) {
+    return (value >> bit) & 1;
+}
+
+void AppendRegister(std::string &out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) out += static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+// The brand string is NUL-padded to 48 bytes, and often space-padded in front
+std::string Trimmed(const std::string &text) {
+    const std::string value = text.c_str();
+    const size_t first = value.find_first_not_of(' ');
+    if (first == std::string::npos) return "";
+    return value.substr(first, value.find_last_not_of(' ') - first + 1);
+}
+
+void ReadCpuid(cpu_topology::Topology &out) {
+    const Registers leaf0 = Cpuid(0);
+    const uint32_t max_leaf = leaf0.eax;
+    AppendRegister(out.vendor, leaf0.ebx);
+    AppendRegister(out.vendor, leaf0.edx);
+    AppendRegister(out.vendor, leaf0.ecx);
+    if (max_leaf < 1) return;
+
+    // Display family / model: the extended fields extend family 0xF, and the model of families 6 and 0xF+
+    const Registers leaf1 = Cpuid(1);
+    const uint32_t base_family = (leaf1.eax >> 8) & 0xF;
+    out.stepping = leaf1.eax & 0xF;
+    out.family = base_family == 0xF ? base_family + ((leaf1.eax >> 20) & 0xFF) : base_family;
+    out.model = (leaf1.eax >> 4) & 0xF;
+    if (base_family == 0x6 || base_family == 0xF) out.model |= ((leaf1.eax >> 16) & 0xF) << 4;
+
+    const uint64_t xcr0 = Bit(leaf1.ecx, 27) ? EnabledXState() : 0;
+    const bool avx_state = (xcr0 & 0x6) == 0x6;         // XMM + YMM
+    const bool avx512_state = (xcr0 & 0xE6) == 0xE6;    // + opmask, ZMM_Hi256, Hi16_ZMM
+    const bool amx_state = (xcr0 & 0x60000) == 0x60000;  // XTILECFG + XTILEDATA
+
+    uint64_t &f = out.features;
+    if (Bit(leaf1.edx, 25)) f |= CPU_FEATURE_SSE;
+    if (Bit(leaf1.edx, 26)) f |= CPU_FEATURE_SSE2;
+    if (Bit(leaf1.ecx, 0)) f |= CPU_FEATURE_SSE3;
+    if (Bit(leaf1.ecx, 1)) f |= CPU_FEATURE_PCLMULQDQ;
+    if (Bit(leaf1.ecx, 9)) f |= CPU_FEATURE_SSSE3;
+    if (Bit(leaf1.ecx, 19)) f |= CPU_FEATURE_SSE4_1;
+    if (Bit(leaf1.ecx, 20)) f |= CPU_FEATURE_SSE4_2;
+    if (Bit(leaf1.ecx, 23)) f |= CPU_FEATURE_POPCNT;
+    if (Bit(leaf1.ecx, 25)) f |= CPU_FEATURE_AES;
+    if (avx_state) {
+        if (Bit(leaf1.ecx, 12)) f |= CPU_FEATURE_FMA;
+        if (Bit(leaf1.ecx, 28)) f |= CPU_FEATURE_AVX;
+        if (Bit(leaf1.ecx, 29)) f |= CPU_FEATURE_F16C;
+    }
+
+    if (max_leaf >= 7) {
+        const Registers leaf7 = Cpuid(7, 0);
+        if (Bit(leaf7.ebx, 3)) f |= CPU_FEATURE_BMI1;
+        if (Bit(leaf7.ebx, 8)) f |= CPU_FEATURE_BMI2;
+        if (Bit(leaf7.ebx, 29)) f |= CPU_FEATURE_SHA;
+        if (Bit(leaf7.edx, 15)) f |= CPU_FEATURE_HYBRID;
+        if (avx_state && Bit(leaf7.ebx, 5)) f |= CPU_FEATURE_AVX2;
+        if (avx_state && leaf7.eax >= 1 && Bit(Cpuid(7, 1).eax, 4)) f |= CPU_FEATURE_AVX_VNNI;
+        if (avx512_state) {
+            if (Bit(leaf7.ebx, 16)) f |= CPU_FEATURE_AVX512F;
+            if (Bit(leaf7.ebx, 17)) f |= CPU_FEATURE_AVX512DQ;
+            if (Bit(leaf7.ebx, 30)) f |= CPU_FEATURE_AVX512BW;
+            if (Bit(leaf7.ebx, 31)) f |= CPU_FEATURE_AVX512VL;
+            if (Bit(leaf7.ecx, 11)) f |= CPU_FEATURE_AVX512VNNI;
+        }
+        if (amx_state && Bit(leaf7.edx, 24)) f |= CPU_FEATURE_AMX_TILE;
+    }
+
+    const uint32_t max_extended = Cpuid(0x80000000).eax;
+    if (max_extended >= 0x80000001) {
+        const Registers ext1 = Cpuid(0x80000001);
+        if (Bit(ext1.ecx, 5)) f |= CPU_FEATURE_LZCNT;
+        if (Bit(ext1.ecx, 6)) f |= CPU_FEATURE_SSE4A;
+        if (Bit(ext1.edx, 29)) f |= CPU_FEATURE_LM;
+    }
+    if (max_extended >= 0x80000004) {
+        std::string brand;
+        for (uint32_t leaf = 0x80000002; leaf <= 0x80000004; ++leaf) {
+            const Registers r = Cpuid(leaf);
+            AppendRegister(brand, r.eax);
+            AppendRegister(brand, r.ebx);
+            AppendRegister(brand, r.ecx);
+            AppendRegister(brand, r.edx);
+        }
+        out.brand = Trimmed(brand);
+    }
+}
+
+#else
+
+void ReadCpuid(cpu_topology::Topology &) {}
+
+#endif
+
+// "0-3,8,10-11" from sorted, distinct CPU numbers (the Linux cpulist format)
+std::string FormatCpuList(const std::vector<uint32_t> &cpus) {
+    std::string list;
+    for (size_t i = 0; i < cpus.size();) {
+        size_t j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) ++j;
+        if (!list.empty()) list += ',';
+        list += std::to_string(cpus[i]);
+        if (j > i) list += '-' + std::to_string(cpus[j]);
+        i = j + 1;
+    }
+    return list;
+}
+
+// Instruction before data before unified, as lscpu and Task Manager list them
+int TypeOrder(uint32_t type) {
+    switch (type) {
+        case CPU_CACHE_INSTRUCTION: return 0;
+        case CPU_CACHE_DATA: return 1;
+        case CPU_CACHE_UNIFIED: return 2;
+        default: return 3;
+    }
+}
+
+// Turns per-processor data into the record's counts, classes and cache groups.
+class Summarizer {
+public:
+    Summarizer(arena::Builder &builder, CPUTopologyRecord &record) : builder_(builder), record_(record) {}
+
+    void FromProcessors(const cpu_topology::Topology &topology) {
+        std::vector<cpu_topology::Processor> processors = topology.processors;
+        std::sort(processors.begin(), processors.end(),
+                  [](const auto &a, const auto &b) { return a.id < b.id; });
+
+        // Fastest class first
+        std::set<uint32_t, std::greater<uint32_t>> efficiency_classes;
+        std::set<uint32_t> packages;
+        std::map<uint32_t, uint32_t> threads_per_core;
+        for (const auto &p : processors) {
+            efficiency_classes.insert(p.efficiency_class);
+            packages.insert(p.package);
+            ++threads_per_core[p.core];
+        }
+
+        record_.packages = static_cast<uint32_t>(packages.size());
+        record_.cores = static_cast<uint32_t>(threads_per_core.size());
+        record_.threads = static_cast<uint32_t>(processors.size());
+        for (const auto &core : threads_per_core) record_.smt_width = std::max(record_.smt_width, core.second);
+
+        for (uint32_t efficiency_class : efficiency_classes) {
+            if (record_.core_class_count == CPU_TOPOLOGY_MAX_CORE_CLASSES) break;
+            std::vector<uint32_t> cpus;
+            std::set<uint32_t> cores;
+            for (const auto &p : processors) {
+                if (p.efficiency_class != efficiency_class) continue;
+                cpus.push_back(p.id);
+                cores.insert(p.core);
+                class_of_[p.id] = record_.core_class_count;
+            }
+
+            CPUCoreClass &c = record_.core_classes[record_.core_class_count++];
+            c.efficiency_class = efficiency_class;
+            c.cores = static_cast<uint32_t>(cores.size());
+            c.threads = static_cast<uint32_t>(cpus.size());
+            c.cpus = builder_.Intern(FormatCpuList(cpus));
+        }
+
+        CachesFromInstances(topology.caches);
+    }
+
+    void FromSummaries(const cpu_topology::Topology &topology) {
+        record_.packages = topology.packages;
+        for (const auto &summary : topology.classes) {
+            record_.cores += summary.cores;
+            record_.threads += summary.threads;
+            if (summary.cores) record_.smt_width = std::max(record_.smt_width, summary.threads / summary.cores);
+            if (record_.core_class_count == CPU_TOPOLOGY_MAX_CORE_CLASSES) continue;
+
+            CPUCoreClass &c = record_.core_classes[record_.core_class_count++];
+            c.efficiency_class = summary.efficiency_class;
+            c.cores = summary.cores;
+            c.threads = summary.threads;
+        }
+
+        for (const auto &summary : topology.cache_summaries) {
+            if (record_.cache_count == CPU_TOPOLOGY_MAX_CACHES) break;
+            CPUCacheRecord &cache = record_.caches[record_.cache_count++];
+            cache.level = summary.level;
+            cache.type = summary.type;
+            cache.size_bytes = summary.size_bytes;
+            cache.line_size = summary.line_size;
+            cache.associativity = summary.associativity;
+            cache.core_class = summary.core_class;
+            cache.instances = summary.instances;
+            cache.threads_per_instance = summary.threads_per_instance;
+        }
+    }
+
+private:
+    // Instances with the same level, type, geometry and core class become one CPUCacheRecord.
+    void CachesFromInstances(const std::vector<cpu_topology::Cache> &caches) {
+        using Key = std::tuple<uint32_t, int, uint32_t, uint64_t, uint32_t, uint32_t>;
+        std::map<Key, std::vector<const cpu_topology::Cache *>> groups;
+        for (const auto &cache : caches) {
+            if (cache.cpus.empty()) continue;
+            groups[Key(cache.level, TypeOrder(cache.type), ClassOf(cache.cpus), cache.size_bytes, cache.line_size,
+                       cache.associativity)].push_back(&cache);
+        }
+
+        for (auto &group : groups) {
+            if (record_.cache_count == CPU_TOPOLOGY_MAX_CACHES) break;
+            std::vector<const cpu_topology::Cache *> &instances = group.second;
+            std::sort(instances.begin(), instances.end(),
+                      [](const auto *a, const auto *b) { return a->cpus.front() < b->cpus.front(); });
+
+            const cpu_topology::Cache &first = *instances.front();
+            CPUCacheRecord &record = record_.caches[record_.cache_count++];
+            record.level = first.level;
+            record.type = first.type;
+            record.size_bytes = first.size_bytes;
+            record.line_size = first.line_size;
+            record.associativity = first.associativity;
+            record.core_class = std::get<2>(group.first);
+            record.instances = static_cast<uint32_t>(instances.size());
+
+            std::string shared;
+            for (const auto *instance : instances) {
+                record.threads_per_instance = std::max(record.threads_per_instance,
+                                                       static_cast<uint32_t>(instance->cpus.size()));
+                if (!shared.empty()) shared += ' ';
+                shared += FormatCpuList(instance->cpus);
+            }
+            record.shared_cpus = builder_.Intern(shared);
+        }
+    }
+
+    uint32_t ClassOf(const std::vector<uint32_t> &cpus) const {
+        uint32_t cls = CPU_CACHE_ALL_CLASSES;
+        for (uint32_t cpu : cpus) {
+            const auto it = class_of_.find(cpu);
+            if (it == class_of_.end()) return CPU_CACHE_ALL_CLASSES;
+            if (cls != CPU_CACHE_ALL_CLASSES && it->second != cls) return CPU_CACHE_ALL_CLASSES;
+            cls = it->second;
+        }
+        return cls;
+    }
+
+    arena::Builder &builder_;
+    CPUTopologyRecord &record_;
+    std::map<uint32_t, uint32_t> class_of_;  // logical processor -> core class index
+};
+
+// Backends may list a cache's processors unsorted or twice (Windows reports them per group).
+void Normalize(cpu_topology::Topology &topology) {
+    for (auto &cache : topology.caches) {
+        std::sort(cache.cpus.begin(), cache.cpus.end());
+        cache.cpus.erase(std::unique(cache.cpus.begin(), cache.cpus.end()), cache.cpus.end());
+    }
+}
+
+} // namespace
+
+// ---- Exports ----
+
+int get_cpu_topology_arena(DeviceArena **out) {
+    if (!out) return DEVICE_ARENA_STATUS_INVALID_ARG;
+    *out = nullptr;
+
+    cpu_topology::Topology topology;
+    {
+        DEVICE_INFO_STAGE("cpu_topology::ReadCpuid");
+        ReadCpuid(topology);
+    }
+    {
+        DEVICE_INFO_STAGE("cpu_topology::PlatformTopology");
+        if (!cpu_topology::PlatformTopology(topology)) return DEVICE_ARENA_STATUS_FAILURE;
+    }
+
+    DEVICE_INFO_STAGE("cpu_topology::Summarize");
+    Normalize(topology);
+
+    arena::Builder builder(DEVICE_ARENA_KIND_CPU_TOPOLOGY, sizeof(CPUTopologyRecord));
+    CPUTopologyRecord record{};
+    record.vendor = builder.Intern(topology.vendor);
+    record.brand = builder.Intern(topology.brand);
+    record.features = topology.features;
+    record.family = topology.family;
+    record.model = topology.model;
+    record.stepping = topology.stepping;
+    record.numa_nodes = topology.numa_nodes;
+    record.processor_groups = topology.processor_groups;
+
+    Summarizer summarizer(builder, record);
+    if (!topology.processors.empty()) summarizer.FromProcessors(topology);
+    else summarizer.FromSummaries(topology);
+    builder.Append(&record);
+
+    *out = builder.Finish();
+    return *out ? DEVICE_ARENA_STATUS_OK : DEVICE_ARENA_STATUS_FAILURE;
+}
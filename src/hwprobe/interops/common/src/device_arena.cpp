@@ -0,0 +1,105 @@
+#include "device_arena.h"
+
+#include <cstring>
+#include <functional>
+#include <new>
+#include <utility>
+
+struct DeviceArena {
+    std::vector<unsigned char> blob;
+};
+
+namespace arena {
+
+namespace {
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+size_t Builder::PoolHash::operator()(const ArenaString &ref) const {
+    return std::hash<std::string_view>()(std::string_view(pool->data() + ref.offset, ref.length));
+}
+
+bool Builder::PoolEqual::operator()(const ArenaString &a, const ArenaString &b) const {
+    return std::string_view(pool->data() + a.offset, a.length) == std::string_view(pool->data() + b.offset, b.length);
+}
+
+Builder::Builder(DeviceArenaKind kind, size_t record_size)
+    : kind_(kind), record_size_(record_size), interned_(0, PoolHash{&strings_}, PoolEqual{&strings_}) {}
+
+ArenaString Builder::Intern(std::string_view value) {
+    ArenaString ref = {0, 0};
+    if (value.empty()) return ref;
+
+    // Appended first so the index can compare it in place; taken back off if it is already pooled
+    ref.offset = static_cast<uint32_t>(strings_.size());
+    ref.length = static_cast<uint32_t>(value.size());
+    strings_.append(value.data(), value.size());
+    const auto inserted = interned_.insert(ref);
+    if (!inserted.second) {
+        strings_.resize(ref.offset);
+        return *inserted.first;
+    }
+    strings_.push_back('\0');
+    return ref;
+}
+
+void Builder::Append(const void *record) {
+    const auto *bytes = static_cast<const unsigned char *>(record);
+    records_.insert(records_.end(), bytes, bytes + record_size_);
+    ++count_;
+}
+
+DeviceArena *Builder::Finish() {
+    DeviceArenaHeader header = {};
+    header.magic = DEVICE_ARENA_MAGIC;
+    header.version = DEVICE_ARENA_VERSION;
+    header.header_size = sizeof(DeviceArenaHeader);
+    header.kind = static_cast<uint32_t>(kind_);
+    header.record_size = static_cast<uint32_t>(record_size_);
+    header.record_count = static_cast<uint32_t>(count_);
+    header.records_offset = AlignUp(sizeof(DeviceArenaHeader), 8);
+    header.strings_offset = AlignUp(header.records_offset + records_.size(), 8);
+    header.strings_size = strings_.size();
+    header.total_size = header.strings_offset + header.strings_size;
+
+    auto *out = new (std::nothrow) DeviceArena();
+    if (!out) return nullptr;
+    out->blob.assign(static_cast<size_t>(header.total_size), 0);
+    std::memcpy(out->blob.data(), &header, sizeof(header));
+    if (!records_.empty())
+        std::memcpy(out->blob.data() + header.records_offset, records_.data(), records_.size());
+    if (!strings_.empty())
+        std::memcpy(out->blob.data() + header.strings_offset, strings_.data(), strings_.size());
+    return out;
+}
+
+bool Collect(int (*query)(DeviceArena **), std::vector<unsigned char> &blob) {
+    DeviceArena *handle = nullptr;
+    if (query(&handle) != DEVICE_ARENA_STATUS_OK || !handle) return false;
+    blob = std::move(handle->blob);
+    device_arena_free(handle);
+    return blob.size() >= sizeof(DeviceArenaHeader);
+}
+
+} // namespace arena
+
+// ---- Exports ----
+
+uint64_t device_arena_size(const DeviceArena *arena) {
+    return arena ? arena->blob.size() : 0;
+}
+
+int device_arena_copy(const DeviceArena *arena, void *out, uint64_t out_size) {
+    if (!arena || !out) return DEVICE_ARENA_STATUS_INVALID_ARG;
+    if (out_size < arena->blob.size()) return DEVICE_ARENA_STATUS_BUFFER_TOO_SMALL;
+    std::memcpy(out, arena->blob.data(), arena->blob.size());
+    return DEVICE_ARENA_STATUS_OK;
+}
+
+void device_arena_free(DeviceArena *arena) {
+    delete arena;
+}
@@ -0,0 +1,83 @@
+#include "device_probe.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <new>
+#include <system_error>
+#include <thread>
+
+struct DeviceProbeResult {
+    struct Job {
+        int status = DEVICE_PROBE_STATUS_FAILURE;
+        std::vector<unsigned char> blob;
+    };
+    std::vector<Job> jobs;
+};
+
+namespace {
+
+// Jobs mostly wait on other processes (WMI) or the kernel, so workers are not tied to the CPU count.
+constexpr int kMaxWorkers = 8;
+
+void RunWorker(const DeviceProbeJob *jobs, DeviceProbeResult &result, std::atomic<int> &next) {
+    probe::PlatformThreadEnter();
+    const int count = static_cast<int>(result.jobs.size());
+    for (int i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+        auto &job = result.jobs[i];
+        try {
+            job.status = probe::PlatformRunJob(jobs[i], job.blob);
+        } catch (const std::bad_alloc &) {
+            job.status = DEVICE_PROBE_STATUS_FAILURE;
+        }
+        if (job.status != DEVICE_PROBE_STATUS_OK && job.status != DEVICE_PROBE_STATUS_TIMED_OUT) job.blob.clear();
+    }
+    probe::PlatformThreadExit();
+}
+
+} // namespace
+
+// ---- Exports ----
+
+int device_probe_all(const DeviceProbeJob *jobs, int job_count, int max_threads, DeviceProbeResult **out) {
+    if (!out || job_count < 0 || (job_count > 0 && !jobs) || max_threads < 0)
+        return DEVICE_PROBE_STATUS_INVALID_ARG;
+    *out = nullptr;
+
+    auto *result = new (std::nothrow) DeviceProbeResult();
+    if (!result) return DEVICE_PROBE_STATUS_FAILURE;
+    result->jobs.resize(static_cast<size_t>(job_count));
+
+    const int threads = std::min({max_threads == 0 ? job_count : max_threads, job_count, kMaxWorkers});
+
+    // The calling thread is one of the workers, so a single job never spawns a thread.
+    std::atomic<int> next{0};
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threads; ++i) {
+        try {
+            workers.emplace_back(RunWorker, jobs, std::ref(*result), std::ref(next));
+        } catch (const std::system_error &) {
+            break;  // fewer workers, same result
+        }
+    }
+    if (job_count > 0) RunWorker(jobs, *result, next);
+    for (auto &worker : workers) worker.join();
+
+    *out = result;
+    return DEVICE_PROBE_STATUS_OK;
+}
+
+int device_probe_result_get(const DeviceProbeResult *result, int index, int *status,
+                            const void **data, uint64_t *size) {
+    if (!result || !status || !data || !size || index < 0 || index >= static_cast<int>(result->jobs.size()))
+        return DEVICE_PROBE_STATUS_INVALID_ARG;
+    const auto &job = result->jobs[index];
+    *status = job.status;
+    *data = job.blob.empty() ? nullptr : job.blob.data();
+    *size = job.blob.size();
+    return DEVICE_PROBE_STATUS_OK;
+}
+
+void device_probe_result_free(DeviceProbeResult *result) {
+    delete result;
+}
@@ -0,0 +1,243 @@
+#include "device_replay.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+struct DeviceReplayCorpus {
+    std::vector<unsigned char> blob;
+};
+
+namespace {
+
+enum Mode : int { kLive = 0, kRecording = 1, kReplaying = 2 };
+
+// Points into g_replayBlob.
+struct Entry {
+    uint32_t channel;
+    std::string_view key;
+    std::string_view value;
+};
+
+bool operator<(const Entry &a, const Entry &b) {
+    return a.channel != b.channel ? a.channel < b.channel : a.key < b.key;
+}
+
+std::atomic<int> g_mode{kLive};
+std::atomic<uint64_t> g_generation{0};
+
+// Mode changes take it exclusively, replayed reads shared, so a corpus is never freed under a read.
+std::shared_mutex g_stateMutex;
+std::vector<unsigned char> g_replayBlob;
+std::vector<Entry> g_replayEntries;  // sorted
+
+// Recorded reads come from any number of threads; ordered, so the corpus comes out sorted.
+std::mutex g_recordMutex;
+std::map<std::pair<uint32_t, std::string>, std::string> g_recorded;
+
+constexpr uint64_t Align8(uint64_t size) {
+    return (size + 7) & ~uint64_t(7);
+}
+
+void Append(std::vector<unsigned char> &blob, const void *data, size_t size) {
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    blob.insert(blob.end(), bytes, bytes + size);
+}
+
+std::vector<unsigned char> Serialize(const std::map<std::pair<uint32_t, std::string>, std::string> &entries) {
+    uint64_t total = sizeof(DeviceReplayHeader);
+    for (const auto &entry : entries)
+        total += Align8(sizeof(DeviceReplayEntry) + entry.first.second.size() + entry.second.size());
+
+    std::vector<unsigned char> blob;
+    blob.reserve(static_cast<size_t>(total));
+
+    DeviceReplayHeader header = {};
+    header.magic = DEVICE_REPLAY_MAGIC;
+    header.version = DEVICE_REPLAY_VERSION;
+    header.header_size = sizeof(DeviceReplayHeader);
+    header.entry_count = static_cast<uint32_t>(entries.size());
+    header.total_size = total;
+    Append(blob, &header, sizeof(header));
+
+    for (const auto &entry : entries) {
+        DeviceReplayEntry record = {};
+        record.channel = entry.first.first;
+        record.key_size = static_cast<uint32_t>(entry.first.second.size());
+        record.value_size = entry.second.size();
+        Append(blob, &record, sizeof(record));
+        Append(blob, entry.first.second.data(), entry.first.second.size());
+        Append(blob, entry.second.data(), entry.second.size());
+        blob.resize(static_cast<size_t>(Align8(blob.size())), 0);
+    }
+    return blob;
+}
+
+// Entries of a corpus, pointing into `blob`; false if its layout is not one this build reads.
+bool Parse(const std::vector<unsigned char> &blob, std::vector<Entry> &entries) {
+    DeviceReplayHeader header;
+    if (blob.size() < sizeof(header)) return false;
+    std::memcpy(&header, blob.data(), sizeof(header));
+    if (header.magic != DEVICE_REPLAY_MAGIC || header.version != DEVICE_REPLAY_VERSION ||
+        header.header_size < sizeof(header) || header.total_size != blob.size() || header.header_size > blob.size())
+        return false;
+
+    const auto *base = reinterpret_cast<const char *>(blob.data());
+    uint64_t offset = header.header_size;
+    entries.reserve(header.entry_count);
+    for (uint32_t i = 0; i < header.entry_count; ++i) {
+        DeviceReplayEntry record;
+        if (blob.size() - offset < sizeof(record)) return false;
+        std::memcpy(&record, base + offset, sizeof(record));
+
+        const uint64_t body = offset + sizeof(record);
+        if (record.key_size > blob.size() - body || record.value_size > blob.size() - body - record.key_size)
+            return false;
+        entries.push_back({record.channel, std::string_view(base + body, record.key_size),
+                           std::string_view(base + body + record.key_size, static_cast<size_t>(record.value_size))});
+        offset = std::min<uint64_t>(Align8(body + record.key_size + record.value_size), blob.size());
+    }
+
+    // Written sorted; a hand-edited corpus need not be
+    std::stable_sort(entries.begin(), entries.end());
+    return true;
+}
+
+} // namespace
+
+// ---- Hooks ----
+
+namespace replay {
+
+bool Active() {
+    return g_mode.load(std::memory_order_relaxed) != kLive;
+}
+
+bool Replaying() {
+    return g_mode.load(std::memory_order_relaxed) == kReplaying;
+}
+
+bool Lookup(uint32_t channel, std::string_view key, std::string &out) {
+    std::shared_lock<std::shared_mutex> lock(g_stateMutex);
+    if (g_mode.load() != kReplaying) return false;
+
+    const Entry wanted{channel, key, {}};
+    const auto it = std::lower_bound(g_replayEntries.begin(), g_replayEntries.end(), wanted);
+    if (it == g_replayEntries.end() || it->channel != channel || it->key != key) return false;
+    out.assign(it->value.data(), it->value.size());
+    return true;
+}
+
+void Record(uint32_t channel, std::string_view key, std::string_view value) {
+    std::lock_guard<std::mutex> lock(g_recordMutex);
+    if (g_mode.load() != kRecording) return;
+    try {
+        g_recorded[{channel, std::string(key)}].assign(value.data(), value.size());
+    } catch (const std::bad_alloc &) {
+        // The corpus misses this read; replaying it fails like a missing device
+    }
+}
+
+uint64_t Generation() {
+    return g_generation.load();
+}
+
+} // namespace replay
+
+// ---- Exports ----
+
+int device_replay_record_start(void) {
+    std::unique_lock<std::shared_mutex> lock(g_stateMutex);
+    if (g_mode.load() != kLive) return DEVICE_REPLAY_STATUS_BUSY;
+    {
+        std::lock_guard<std::mutex> record_lock(g_recordMutex);
+        g_recorded.clear();
+    }
+    g_mode.store(kRecording);
+    ++g_generation;
+    return DEVICE_REPLAY_STATUS_OK;
+}
+
+int device_replay_record_stop(DeviceReplayCorpus **out) {
+    if (!out) return DEVICE_REPLAY_STATUS_INVALID_ARG;
+    *out = nullptr;
+
+    std::unique_lock<std::shared_mutex> lock(g_stateMutex);
+    if (g_mode.load() != kRecording) return DEVICE_REPLAY_STATUS_FAILURE;
+
+    std::map<std::pair<uint32_t, std::string>, std::string> recorded;
+    {
+        std::lock_guard<std::mutex> record_lock(g_recordMutex);
+        g_mode.store(kLive);
+        recorded.swap(g_recorded);
+    }
+    ++g_generation;
+
+    auto *corpus = new (std::nothrow) DeviceReplayCorpus();
+    if (!corpus) return DEVICE_REPLAY_STATUS_FAILURE;
+    try {
+        corpus->blob = Serialize(recorded);
+    } catch (const std::bad_alloc &) {
+        delete corpus;
+        return DEVICE_REPLAY_STATUS_FAILURE;
+    }
+    *out = corpus;
+    return DEVICE_REPLAY_STATUS_OK;
+}
+
+uint64_t device_replay_corpus_size(const DeviceReplayCorpus *corpus) {
+    return corpus ? corpus->blob.size() : 0;
+}
+
+int device_replay_corpus_copy(const DeviceReplayCorpus *corpus, void *out, uint64_t out_size) {
+    if (!corpus || !out) return DEVICE_REPLAY_STATUS_INVALID_ARG;
+    if (out_size < corpus->blob.size()) return DEVICE_REPLAY_STATUS_BUFFER_TOO_SMALL;
+    std::memcpy(out, corpus->blob.data(), corpus->blob.size());
+    return DEVICE_REPLAY_STATUS_OK;
+}
+
+void device_replay_corpus_free(DeviceReplayCorpus *corpus) {
+    delete corpus;
+}
+
+int device_replay_start(const void *data, uint64_t size) {
+    if (!data || size == 0) return DEVICE_REPLAY_STATUS_INVALID_ARG;
+
+    std::vector<unsigned char> blob;
+    std::vector<Entry> entries;
+    try {
+        const auto *bytes = static_cast<const unsigned char *>(data);
+        blob.assign(bytes, bytes + size);
+        if (!Parse(blob, entries)) return DEVICE_REPLAY_STATUS_CORRUPT;
+    } catch (const std::bad_alloc &) {
+        return DEVICE_REPLAY_STATUS_FAILURE;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(g_stateMutex);
+    if (g_mode.load() != kLive) return DEVICE_REPLAY_STATUS_BUSY;
+    g_replayBlob.swap(blob);  // moving the vector keeps its buffer, so `entries` stays valid
+    g_replayEntries.swap(entries);
+    g_mode.store(kReplaying);
+    ++g_generation;
+    return DEVICE_REPLAY_STATUS_OK;
+}
+
+void device_replay_stop(void) {
+    std::unique_lock<std::shared_mutex> lock(g_stateMutex);
+    if (g_mode.load() == kLive) return;
+    {
+        std::lock_guard<std::mutex> record_lock(g_recordMutex);
+        g_mode.store(kLive);
+        g_recorded.clear();
+    }
+    g_replayEntries.clear();
+    g_replayBlob.clear();
+    g_replayBlob.shrink_to_fit();
+    ++g_generation;
+}
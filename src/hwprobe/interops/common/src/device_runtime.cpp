@@ -0,0 +1,27 @@
+#include "device_runtime.h"
+#include "bench_stages.h"
+
+#include <mutex>
+
+namespace {
+
+std::mutex g_lifecycleMutex;
+int g_initCount = 0;
+
+} // namespace
+
+int device_info_init(void) {
+    std::lock_guard<std::mutex> lock(g_lifecycleMutex);
+    if (g_initCount == 0) {
+        DEVICE_INFO_STAGE("runtime::PlatformInit");
+        if (!runtime::PlatformInit()) return DEVICE_RUNTIME_STATUS_FAILURE;
+    }
+    ++g_initCount;
+    return DEVICE_RUNTIME_STATUS_OK;
+}
+
+void device_info_shutdown(void) {
+    std::lock_guard<std::mutex> lock(g_lifecycleMutex);
+    if (g_initCount == 0 || --g_initCount > 0) return;
+    runtime::PlatformShutdown();
+}
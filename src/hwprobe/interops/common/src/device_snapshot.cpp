@@ -0,0 +1,353 @@
+#include "device_snapshot.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <string_view>
+#include <utility>
+
+namespace snapshot {
+
+namespace {
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+bool SameKey(const DeviceSnapshotKey &a, const DeviceSnapshotKey &b) {
+    return a.hardware_fingerprint == b.hardware_fingerprint &&
+           std::strncmp(a.boot_id, b.boot_id, DEVICE_SNAPSHOT_BOOT_ID_SIZE) == 0;
+}
+
+// Layout checks shared by validation and diffing: the header and section table of a snapshot.
+int CheckLayout(const unsigned char *bytes, uint64_t size, DeviceSnapshotHeader &header) {
+    if (size < sizeof(DeviceSnapshotHeader)) return DEVICE_SNAPSHOT_STATUS_CORRUPT;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (header.magic != DEVICE_SNAPSHOT_MAGIC || header.version != DEVICE_SNAPSHOT_VERSION ||
+        header.header_size != sizeof(DeviceSnapshotHeader) || header.total_size != size ||
+        header.section_count > (size - sizeof(header)) / sizeof(DeviceSnapshotSection))
+        return DEVICE_SNAPSHOT_STATUS_CORRUPT;
+
+    for (uint32_t i = 0; i < header.section_count; ++i) {
+        DeviceSnapshotSection section;
+        std::memcpy(&section, bytes + sizeof(header) + i * sizeof(section), sizeof(section));
+        if (section.offset > size || section.size > size - section.offset || section.size < sizeof(DeviceArenaHeader))
+            return DEVICE_SNAPSHOT_STATUS_CORRUPT;
+
+        DeviceArenaHeader arena;
+        std::memcpy(&arena, bytes + section.offset, sizeof(arena));
+        if (arena.magic != DEVICE_ARENA_MAGIC || arena.kind != section.kind || arena.total_size != section.size)
+            return DEVICE_SNAPSHOT_STATUS_CORRUPT;
+    }
+    return DEVICE_SNAPSHOT_STATUS_OK;
+}
+
+// ---- Diff ----
+
+// Read-only view of one arena blob, bounds-checked once.
+class ArenaView {
+public:
+    bool Open(const unsigned char *blob, uint64_t size) {
+        if (size < sizeof(DeviceArenaHeader)) return false;
+        std::memcpy(&header_, blob, sizeof(header_));
+        if (header_.magic != DEVICE_ARENA_MAGIC || header_.version != DEVICE_ARENA_VERSION ||
+            header_.total_size != size || header_.strings_offset > size ||
+            header_.strings_size > size - header_.strings_offset || header_.records_offset > header_.strings_offset ||
+            static_cast<uint64_t>(header_.record_count) * header_.record_size >
+                header_.strings_offset - header_.records_offset)
+            return false;
+        blob_ = blob;
+        return true;
+    }
+
+    uint32_t kind() const { return header_.kind; }
+    uint32_t count() const { return blob_ ? header_.record_count : 0; }
+
+    // `field` of record `index` as text; a field the record is too short to hold reads as empty / 0.
+    std::string Value(uint32_t index, const RecordField &field) const {
+        const unsigned char *record = blob_ + header_.records_offset + static_cast<uint64_t>(index) * header_.record_size;
+        char number[24] = "0";
+        switch (field.type) {
+            case FieldType::String: {
+                ArenaString ref = {};
+                if (!Read(record, field.offset, ref)) return {};
+                if (ref.length == 0 || ref.offset > header_.strings_size ||
+                    ref.length > header_.strings_size - ref.offset)
+                    return {};
+                return std::string(reinterpret_cast<const char *>(blob_ + header_.strings_offset + ref.offset),
+                                   ref.length);
+            }
+            case FieldType::U8: {
+                uint8_t value = 0;
+                Read(record, field.offset, value);
+                std::snprintf(number, sizeof(number), "%u", static_cast<unsigned>(value));
+                break;
+            }
+            case FieldType::U16: {
+                uint16_t value = 0;
+                Read(record, field.offset, value);
+                std::snprintf(number, sizeof(number), "%u", static_cast<unsigned>(value));
+                break;
+            }
+            case FieldType::U32: {
+                uint32_t value = 0;
+                Read(record, field.offset, value);
+                std::snprintf(number, sizeof(number), "%" PRIu32, value);
+                break;
+            }
+            case FieldType::I32: {
+                int32_t value = 0;
+                Read(record, field.offset, value);
+                std::snprintf(number, sizeof(number), "%" PRId32, value);
+                break;
+            }
+            case FieldType::U64: {
+                uint64_t value = 0;
+                Read(record, field.offset, value);
+                std::snprintf(number, sizeof(number), "%" PRIu64, value);
+                break;
+            }
+        }
+        return number;
+    }
+
+private:
+    template <typename T>
+    bool Read(const unsigned char *record, size_t offset, T &value) const {
+        if (offset + sizeof(T) > header_.record_size) return false;
+        std::memcpy(&value, record + offset, sizeof(T));
+        return true;
+    }
+
+    const unsigned char *blob_ = nullptr;
+    DeviceArenaHeader header_ = {};
+};
+
+// Not reported: an empty string or a 0.
+bool IsUnset(const RecordField &field, const std::string &value) {
+    return field.type == FieldType::String ? value.empty() : value == "0";
+}
+
+// Stable keys of every record of `view`, in record order.
+std::vector<std::string> DeviceKeys(const ArenaView &view, const RecordSchema &schema) {
+    std::vector<const RecordField *> keyFields;
+    for (const char *name : schema.key)
+        for (const RecordField &field : schema.fields)
+            if (std::strcmp(field.name, name) == 0) keyFields.push_back(&field);
+
+    std::vector<std::string> keys;
+    std::map<std::string, int> seen;
+    for (uint32_t i = 0; i < view.count(); ++i) {
+        std::string key;
+        for (const RecordField *field : keyFields) {
+            std::string value = view.Value(i, *field);
+            if (IsUnset(*field, value)) continue;
+            key = std::string(field->name) + "=" + value;
+            break;
+        }
+        if (key.empty()) key = "#" + std::to_string(i);
+
+        const int occurrence = ++seen[key];
+        if (occurrence > 1) key += "#" + std::to_string(occurrence);
+        keys.push_back(std::move(key));
+    }
+    return keys;
+}
+
+class DeltaWriter {
+public:
+    DeltaWriter() : builder_(DEVICE_ARENA_KIND_SNAPSHOT_DELTA, sizeof(DeviceDeltaRecord)) {}
+
+    void Add(uint32_t kind, DeviceDeltaChange change, std::string_view key, std::string_view field,
+             std::string_view oldValue, std::string_view newValue) {
+        DeviceDeltaRecord record = {};
+        record.kind = kind;
+        record.change = change;
+        record.key = builder_.Intern(key);
+        record.field = builder_.Intern(field);
+        record.old_value = builder_.Intern(oldValue);
+        record.new_value = builder_.Intern(newValue);
+        builder_.Append(&record);
+    }
+
+    DeviceArena *Finish() { return builder_.Finish(); }
+
+private:
+    arena::Builder builder_;
+};
+
+void DiffSection(const ArenaView *previous, const ArenaView &current, const RecordSchema &schema,
+                 DeltaWriter &delta) {
+    const uint32_t kind = schema.kind;
+    const std::vector<std::string> currentKeys = DeviceKeys(current, schema);
+    std::map<std::string, uint32_t> previousIndex;
+    std::vector<std::string> previousKeys;
+    if (previous) {
+        previousKeys = DeviceKeys(*previous, schema);
+        for (uint32_t i = 0; i < previousKeys.size(); ++i) previousIndex.emplace(previousKeys[i], i);
+    }
+
+    std::vector<bool> matched(previousKeys.size(), false);
+    for (uint32_t i = 0; i < currentKeys.size(); ++i) {
+        const auto found = previousIndex.find(currentKeys[i]);
+        if (found == previousIndex.end()) {
+            bool reported = false;
+            for (const RecordField &field : schema.fields) {
+                const std::string value = current.Value(i, field);
+                if (IsUnset(field, value)) continue;
+                delta.Add(kind, DEVICE_DELTA_ADDED, currentKeys[i], field.name, {}, value);
+                reported = true;
+            }
+            if (!reported) delta.Add(kind, DEVICE_DELTA_ADDED, currentKeys[i], {}, {}, {});
+            continue;
+        }
+
+        matched[found->second] = true;
+        for (const RecordField &field : schema.fields) {
+            const std::string before = previous->Value(found->second, field);
+            const std::string after = current.Value(i, field);
+            if (before != after) delta.Add(kind, DEVICE_DELTA_CHANGED, currentKeys[i], field.name, before, after);
+        }
+    }
+
+    for (uint32_t i = 0; i < previousKeys.size(); ++i)
+        if (!matched[i]) delta.Add(kind, DEVICE_DELTA_REMOVED, previousKeys[i], {}, {}, {});
+}
+
+// The arena section of every kind in a snapshot file whose layout CheckLayout() accepted.
+std::map<uint32_t, ArenaView> SnapshotSections(const unsigned char *bytes, const DeviceSnapshotHeader &header) {
+    std::map<uint32_t, ArenaView> views;
+    for (uint32_t i = 0; i < header.section_count; ++i) {
+        DeviceSnapshotSection section;
+        std::memcpy(&section, bytes + sizeof(header) + i * sizeof(section), sizeof(section));
+        ArenaView view;
+        if (view.Open(bytes + section.offset, section.size)) views.emplace(section.kind, view);
+    }
+    return views;
+}
+
+} // namespace
+
+void Fingerprint::Add(const void *data, size_t size) {
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash_ ^= bytes[i];
+        hash_ *= 0x100000001B3ull;
+    }
+}
+
+} // namespace snapshot
+
+// ---- Exports ----
+
+int device_snapshot_current_key(DeviceSnapshotKey *out) {
+    if (!out) return DEVICE_SNAPSHOT_STATUS_INVALID_ARG;
+    DeviceSnapshotKey key = {};
+    if (!snapshot::PlatformKey(key)) return DEVICE_SNAPSHOT_STATUS_FAILURE;
+    key.boot_id[DEVICE_SNAPSHOT_BOOT_ID_SIZE - 1] = '\0';
+    *out = key;
+    return DEVICE_SNAPSHOT_STATUS_OK;
+}
+
+int device_snapshot_write(const char *path) {
+    if (!path || !*path) return DEVICE_SNAPSHOT_STATUS_INVALID_ARG;
+
+    DeviceSnapshotHeader header = {};
+    // Keyed before probing: hardware that changes during the probe makes the file stale, not wrong.
+    if (device_snapshot_current_key(&header.key) != DEVICE_SNAPSHOT_STATUS_OK) return DEVICE_SNAPSHOT_STATUS_FAILURE;
+
+    std::vector<std::vector<unsigned char>> payloads;
+    for (snapshot::ArenaQuery query : snapshot::PlatformQueries()) {
+        std::vector<unsigned char> blob;
+        if (arena::Collect(query, blob)) payloads.push_back(std::move(blob));
+    }
+    if (payloads.empty()) return DEVICE_SNAPSHOT_STATUS_FAILURE;
+
+    header.magic = DEVICE_SNAPSHOT_MAGIC;
+    header.version = DEVICE_SNAPSHOT_VERSION;
+    header.header_size = sizeof(DeviceSnapshotHeader);
+    header.section_count = static_cast<uint32_t>(payloads.size());
+    header.created_unix = static_cast<uint64_t>(std::time(nullptr));
+
+    std::vector<DeviceSnapshotSection> sections(payloads.size());
+    size_t offset = snapshot::AlignUp(sizeof(header) + sections.size() * sizeof(DeviceSnapshotSection), 8);
+    for (size_t i = 0; i < payloads.size(); ++i) {
+        DeviceArenaHeader arena;
+        std::memcpy(&arena, payloads[i].data(), sizeof(arena));
+        sections[i] = {arena.kind, 0, offset, payloads[i].size()};
+        offset = snapshot::AlignUp(offset + payloads[i].size(), 8);
+    }
+    header.total_size = offset;
+
+    std::vector<unsigned char> file(offset, 0);
+    std::memcpy(file.data(), &header, sizeof(header));
+    std::memcpy(file.data() + sizeof(header), sections.data(), sections.size() * sizeof(DeviceSnapshotSection));
+    for (size_t i = 0; i < payloads.size(); ++i)
+        std::memcpy(file.data() + sections[i].offset, payloads[i].data(), payloads[i].size());
+
+    // Readers may have the old file mapped, so it is replaced, never rewritten in place.
+    return snapshot::PlatformWriteAtomically(path, file) ? DEVICE_SNAPSHOT_STATUS_OK : DEVICE_SNAPSHOT_STATUS_FAILURE;
+}
+
+int device_snapshot_validate(const void *data, uint64_t size) {
+    if (!data) return DEVICE_SNAPSHOT_STATUS_INVALID_ARG;
+
+    DeviceSnapshotHeader header;
+    const int layout = snapshot::CheckLayout(static_cast<const unsigned char *>(data), size, header);
+    if (layout != DEVICE_SNAPSHOT_STATUS_OK) return layout;
+
+    DeviceSnapshotKey current = {};
+    if (device_snapshot_current_key(&current) != DEVICE_SNAPSHOT_STATUS_OK) return DEVICE_SNAPSHOT_STATUS_FAILURE;
+    header.key.boot_id[DEVICE_SNAPSHOT_BOOT_ID_SIZE - 1] = '\0';
+    return snapshot::SameKey(header.key, current) ? DEVICE_SNAPSHOT_STATUS_OK : DEVICE_SNAPSHOT_STATUS_STALE;
+}
+
+int device_snapshot_diff(const void *previous, uint64_t previous_size, const void *current, uint64_t current_size,
+                         DeviceArena **out) {
+    if (!out) return DEVICE_SNAPSHOT_STATUS_INVALID_ARG;
+    *out = nullptr;
+
+    std::map<uint32_t, snapshot::ArenaView> before;
+    if (previous) {
+        const auto *bytes = static_cast<const unsigned char *>(previous);
+        DeviceSnapshotHeader header;
+        if (snapshot::CheckLayout(bytes, previous_size, header) != DEVICE_SNAPSHOT_STATUS_OK)
+            return DEVICE_SNAPSHOT_STATUS_CORRUPT;
+        before = snapshot::SnapshotSections(bytes, header);
+    }
+
+    // Live: the same arenas device_snapshot_write() would store, kept in memory.
+    std::vector<std::vector<unsigned char>> live;
+    std::map<uint32_t, snapshot::ArenaView> after;
+    if (current) {
+        const auto *bytes = static_cast<const unsigned char *>(current);
+        DeviceSnapshotHeader header;
+        if (snapshot::CheckLayout(bytes, current_size, header) != DEVICE_SNAPSHOT_STATUS_OK)
+            return DEVICE_SNAPSHOT_STATUS_CORRUPT;
+        after = snapshot::SnapshotSections(bytes, header);
+    } else {
+        for (snapshot::ArenaQuery query : snapshot::PlatformQueries()) {
+            std::vector<unsigned char> blob;
+            if (arena::Collect(query, blob)) live.push_back(std::move(blob));
+        }
+        if (live.empty()) return DEVICE_SNAPSHOT_STATUS_FAILURE;
+        for (const auto &blob : live) {
+            snapshot::ArenaView view;
+            if (view.Open(blob.data(), blob.size())) after.emplace(view.kind(), view);
+        }
+    }
+
+    snapshot::DeltaWriter delta;
+    for (const snapshot::RecordSchema &schema : snapshot::PlatformSchemas()) {
+        const auto currentView = after.find(schema.kind);
+        if (currentView == after.end()) continue;
+        const auto previousView = before.find(schema.kind);
+        snapshot::DiffSection(previousView != before.end() ? &previousView->second : nullptr, currentView->second,
+                              schema, delta);
+    }
+
+    *out = delta.Finish();
+    return *out ? DEVICE_SNAPSHOT_STATUS_OK : DEVICE_SNAPSHOT_STATUS_FAILURE;
+}
@@ -0,0 +1,124 @@
+#include "device_trace.h"
+
+#ifdef DEVICE_INFO_TRACE
+
+#include <chrono>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#elif defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace device_trace {
+
+std::atomic<bool> g_enabled{false};
+
+namespace {
+
+static_assert((DEVICE_TRACE_CAPACITY & (DEVICE_TRACE_CAPACITY - 1)) == 0, "capacity must be a power of two");
+
+// `state` is 2*seq+1 while event `seq` is being written into the slot and 2*seq+2 once it is
+// complete. Fields are relaxed atomics so a reader racing a writer is well-defined; the state
+// check before and after the copy tells it whether the copy is torn.
+struct Slot {
+    std::atomic<uint64_t> state{0};
+    std::atomic<const char *> name{nullptr};
+    std::atomic<uint64_t> start_ns{0};
+    std::atomic<uint64_t> duration_ns{0};
+    std::atomic<uint32_t> thread_id{0};
+};
+
+Slot g_slots[DEVICE_TRACE_CAPACITY];
+std::atomic<uint64_t> g_next{0};
+
+uint32_t CurrentThreadId() {
+#if defined(_WIN32)
+    return static_cast<uint32_t>(GetCurrentThreadId());
+#elif defined(__APPLE__)
+    uint64_t tid = 0;
+    pthread_threadid_np(nullptr, &tid);
+    return static_cast<uint32_t>(tid);
+#elif defined(__linux__)
+    return static_cast<uint32_t>(syscall(SYS_gettid));
+#else
+    return 0;
+#endif
+}
+
+} // namespace
+
+uint64_t NowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Record(const char *name, uint64_t start_ns, uint64_t duration_ns) {
+    static thread_local const uint32_t thread_id = CurrentThreadId();
+
+    const uint64_t seq = g_next.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = g_slots[seq & (DEVICE_TRACE_CAPACITY - 1)];
+    slot.state.store(2 * seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start_ns.store(start_ns, std::memory_order_relaxed);
+    slot.duration_ns.store(duration_ns, std::memory_order_relaxed);
+    slot.thread_id.store(thread_id, std::memory_order_relaxed);
+    slot.state.store(2 * seq + 2, std::memory_order_release);
+}
+
+} // namespace device_trace
+
+// ---- Exports ----
+
+void device_info_trace_enable(int enabled) {
+    device_trace::g_enabled.store(enabled != 0, std::memory_order_relaxed);
+}
+
+int device_info_get_trace(DeviceTraceEvent *out, int max_count, uint64_t *cursor, uint64_t *dropped) {
+    using device_trace::g_slots;
+    if (dropped) *dropped = 0;
+    if (!out || max_count <= 0 || !cursor) return 0;
+
+    const uint64_t end = device_trace::g_next.load(std::memory_order_acquire);
+    uint64_t seq = *cursor;
+    uint64_t lost = 0;
+    if (end > DEVICE_TRACE_CAPACITY && seq < end - DEVICE_TRACE_CAPACITY) {
+        lost += end - DEVICE_TRACE_CAPACITY - seq;
+        seq = end - DEVICE_TRACE_CAPACITY;
+    }
+
+    int count = 0;
+    for (; seq < end && count < max_count; ++seq) {
+        const auto &slot = g_slots[seq & (DEVICE_TRACE_CAPACITY - 1)];
+        const uint64_t before = slot.state.load(std::memory_order_acquire);
+        if (before <= 2 * seq + 1) break;  // not yet published: read it next time
+
+        DeviceTraceEvent &event = out[count];
+        const char *name = slot.name.load(std::memory_order_relaxed);
+        event.sequence = seq;
+        event.start_ns = slot.start_ns.load(std::memory_order_relaxed);
+        event.duration_ns = slot.duration_ns.load(std::memory_order_relaxed);
+        event.thread_id = slot.thread_id.load(std::memory_order_relaxed);
+        event.reserved = 0;
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (before != 2 * seq + 2 || slot.state.load(std::memory_order_relaxed) != before) {
+            ++lost;  // overwritten by a newer event while (or before) we copied it
+            continue;
+        }
+        std::memset(event.name, 0, sizeof(event.name));
+        if (name) std::strncpy(event.name, name, sizeof(event.name) - 1);
+        ++count;
+    }
+
+    *cursor = seq;
+    if (dropped) *dropped = lost;
+    return count;
+}
+
+#endif // DEVICE_INFO_TRACE
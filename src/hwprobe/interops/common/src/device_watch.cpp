@@ -0,0 +1,64 @@
+#include "device_watch.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace {
+
+std::mutex g_lifecycleMutex;
+int g_startCount = 0;
+
+// Generations only grow, even across stop/start, so a value cached before a stop never matches.
+std::atomic<uint64_t> g_generations[DEVICE_WATCH_CATEGORY_COUNT];
+std::atomic<bool> g_active{false};
+
+bool ValidCategory(int category) {
+    return category >= 0 && category < DEVICE_WATCH_CATEGORY_COUNT;
+}
+
+void BumpAll() {
+    for (auto &generation : g_generations) generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+} // namespace
+
+namespace device_watch {
+
+void MarkChanged(DeviceWatchCategory category) {
+    if (ValidCategory(category)) g_generations[category].fetch_add(1, std::memory_order_acq_rel);
+}
+
+} // namespace device_watch
+
+// ---- Exports ----
+
+int device_watch_start(void) {
+    std::lock_guard<std::mutex> lock(g_lifecycleMutex);
+    if (g_startCount == 0) {
+        if (!device_watch::PlatformStart()) return DEVICE_WATCH_STATUS_FAILURE;
+        // Changes made while nobody was watching are unknown: start from fresh generations.
+        BumpAll();
+        g_active.store(true, std::memory_order_release);
+    }
+    ++g_startCount;
+    return DEVICE_WATCH_STATUS_OK;
+}
+
+void device_watch_stop(void) {
+    std::lock_guard<std::mutex> lock(g_lifecycleMutex);
+    if (g_startCount == 0 || --g_startCount > 0) return;
+    g_active.store(false, std::memory_order_release);
+    device_watch::PlatformStop();
+    BumpAll();
+}
+
+uint64_t device_watch_generation(int category) {
+    if (!ValidCategory(category) || !g_active.load(std::memory_order_acquire)) return 0;
+    return g_generations[category].load(std::memory_order_acquire);
+}
+
+int device_watch_invalidate(int category) {
+    if (!ValidCategory(category)) return DEVICE_WATCH_STATUS_INVALID_ARG;
+    g_generations[category].fetch_add(1, std::memory_order_acq_rel);
+    return DEVICE_WATCH_STATUS_OK;
+}
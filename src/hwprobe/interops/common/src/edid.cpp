@@ -0,0 +1,263 @@
+#include "edid.h"
+#include "bench_stages.h"
+
+#include <string_view>
+
+// ---- Internal helpers ----
+
+namespace {
+
+constexpr uint8_t kHeader[8] = {0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00};
+constexpr size_t kDescriptorSize = 18;
+constexpr size_t kFirstDescriptor = 0x36;
+constexpr size_t kDescriptorCount = 4;
+constexpr size_t kDisplayIdTimingSize = 20;
+
+// Bits per colour for input byte bits 6:4 (EDID 1.4)
+constexpr uint8_t kBitDepths[8] = {0, 6, 8, 10, 12, 14, 16, 0};
+
+struct Timing {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t refresh_mhz = 0;
+};
+
+uint32_t RefreshMilliHz(uint64_t clock_hz, uint64_t h_total, uint64_t v_total) {
+    const uint64_t total = h_total * v_total;
+    return total ? static_cast<uint32_t>((clock_hz * 1000 + total / 2) / total) : 0;
+}
+
+// 18-byte detailed timing descriptor (base block and CTA-861); the caller checked the pixel clock is non-zero.
+// Interlaced timings report the frame height and the field rate, as the mode lists of the OS do.
+Timing DetailedTiming(const uint8_t *d) {
+    const uint64_t clock_hz = static_cast<uint64_t>(d[0] | (d[1] << 8)) * 10000;
+    const uint32_t h_active = d[2] | ((d[4] & 0xF0) << 4);
+    const uint32_t h_blank = d[3] | ((d[4] & 0x0F) << 8);
+    const uint32_t v_active = d[5] | ((d[7] & 0xF0) << 4);
+    const uint32_t v_blank = d[6] | ((d[7] & 0x0F) << 8);
+
+    Timing t;
+    t.width = h_active;
+    t.height = (d[17] & 0x80) ? v_active * 2 : v_active;
+    t.refresh_mhz = RefreshMilliHz(clock_hz, h_active + h_blank, v_active + v_blank);
+    return t;
+}
+
+// 20-byte DisplayID Type I (10 kHz clock units) / Type VII (1 kHz) timing; every field is stored minus one.
+Timing DisplayIdTiming(const uint8_t *d, uint64_t clock_unit_hz) {
+    const uint64_t clock_hz = (static_cast<uint64_t>(d[0] | (d[1] << 8) | (d[2] << 16)) + 1) * clock_unit_hz;
+    const uint32_t h_active = (d[4] | (d[5] << 8)) + 1u;
+    const uint32_t h_blank = (d[6] | (d[7] << 8)) + 1u;
+    const uint32_t v_active = (d[12] | (d[13] << 8)) + 1u;
+    const uint32_t v_blank = (d[14] | (d[15] << 8)) + 1u;
+
+    Timing t;
+    t.width = h_active;
+    t.height = (d[3] & 0x10) ? v_active * 2 : v_active;
+    t.refresh_mhz = RefreshMilliHz(clock_hz, h_active + h_blank, v_active + v_blank);
+    return t;
+}
+
+// Text of a display descriptor: up to 13 bytes, ended by a line feed and padded with spaces.
+std::string_view DescriptorText(const uint8_t *d) {
+    std::string_view text(reinterpret_cast<const char *>(d + 5), kDescriptorSize - 5);
+    text = text.substr(0, text.find('\n'));
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\0')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\0' || text.back() == '\r')) text.remove_suffix(1);
+    return text;
+}
+
+uint64_t Fnv1a(const std::vector<uint8_t> &data) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (uint8_t byte : data) {
+        hash ^= byte;
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+// Decodes one monitor's EDID into `record`, interning its strings in `builder`.
+class Decoder {
+public:
+    Decoder(arena::Builder &builder, EDIDRecord &record) : builder_(builder), record_(record) {}
+
+    void Decode(const uint8_t *data, size_t size) {
+        if (size < EDID_BLOCK_SIZE) return;
+        for (size_t i = 0; i < sizeof(kHeader); ++i)
+            if (data[i] != kHeader[i]) return;
+
+        record_.flags |= EDID_FLAG_VALID;
+        DecodeBase(data);
+
+        const size_t present = size / EDID_BLOCK_SIZE - 1;
+        record_.extension_count = static_cast<uint8_t>(present < 255 ? present : 255);
+        for (size_t block = 1; block <= present; ++block) {
+            const uint8_t *ext = data + block * EDID_BLOCK_SIZE;
+            if (ext[0] == 0x02)
+                DecodeCta(ext);
+            else if (ext[0] == 0x70)
+                DecodeDisplayId(ext);
+        }
+    }
+
+private:
+    void DecodeBase(const uint8_t *b) {
+        uint8_t sum = 0;
+        for (size_t i = 0; i < EDID_BLOCK_SIZE; ++i) sum = static_cast<uint8_t>(sum + b[i]);
+        if (sum == 0) record_.flags |= EDID_FLAG_CHECKSUM_OK;
+
+        const uint16_t vendor = static_cast<uint16_t>((b[8] << 8) | b[9]);
+        const char code[3] = {
+            static_cast<char>(((vendor >> 10) & 0x1F) + 64),
+            static_cast<char>(((vendor >> 5) & 0x1F) + 64),
+            static_cast<char>((vendor & 0x1F) + 64),
+        };
+        record_.manufacturer_code = builder_.Intern(std::string_view(code, sizeof(code)));
+        record_.vendor_id = vendor;
+        record_.product_id = b[10] | (b[11] << 8);
+        record_.serial_number = b[12] | (b[13] << 8) | (b[14] << 16) | (static_cast<uint32_t>(b[15]) << 24);
+        record_.year = static_cast<uint16_t>(b[0x11] + 1990);
+        record_.version = b[0x12];
+        record_.revision = b[0x13];
+
+        const uint8_t input = b[0x14];
+        if (!(input & 0x80)) {
+            record_.interface = EDID_INTERFACE_ANALOG;
+        } else if (record_.version > 1 || (record_.version == 1 && record_.revision >= 4)) {
+            record_.interface = input & 0x0F;
+            record_.bit_depth = kBitDepths[(input >> 4) & 0x07];
+        } else {
+            record_.interface = EDID_INTERFACE_NOT_REPORTED;
+        }
+        record_.width_cm = b[0x15];
+        record_.height_cm = b[0x16];
+
+        for (size_t i = 0; i < kDescriptorCount; ++i) {
+            const uint8_t *d = b + kFirstDescriptor + i * kDescriptorSize;
+            if (d[0] | d[1]) {
+                Consider(DetailedTiming(d));
+            } else if (d[3] == 0xFC) {
+                record_.name = builder_.Intern(DescriptorText(d));
+            } else if (d[3] == 0xFF) {
+                record_.serial_text = builder_.Intern(DescriptorText(d));
+            }
+        }
+    }
+
+    // CTA-861: data block collection from byte 4 up to the first detailed timing at byte 2.
+    void DecodeCta(const uint8_t *b) {
+        record_.flags |= EDID_FLAG_CTA;
+        const size_t dtd_start = b[2];
+        if (dtd_start < 4 || dtd_start >= EDID_BLOCK_SIZE) return;
+
+        for (size_t i = 4; i < dtd_start;) {
+            const uint8_t tag = b[i] >> 5;
+            const size_t length = b[i] & 0x1F;
+            if (i + 1 + length > dtd_start) break;
+            const uint8_t *payload = b + i + 1;
+
+            if (tag == 3 && length >= 3) {
+                const uint32_t oui = payload[0] | (payload[1] << 8) | (payload[2] << 16);
+                if (oui == 0x000C03 || oui == 0xC45DD8) record_.flags |= EDID_FLAG_HDMI;
+            } else if (tag == 7 && length >= 1 && payload[0] == 6) {
+                record_.flags |= EDID_FLAG_HDR;
+            }
+            i += 1 + length;
+        }
+
+        for (size_t offset = dtd_start; offset + kDescriptorSize < EDID_BLOCK_SIZE; offset += kDescriptorSize) {
+            const uint8_t *d = b + offset;
+            if (!(d[0] | d[1])) break;
+            Consider(DetailedTiming(d));
+        }
+    }
+
+    // DisplayID section: 5-byte header, then data blocks of (tag, revision, length, payload).
+    void DecodeDisplayId(const uint8_t *b) {
+        record_.flags |= EDID_FLAG_DISPLAYID;
+        size_t end = 5 + static_cast<size_t>(b[2]);
+        if (end > EDID_BLOCK_SIZE - 1) end = EDID_BLOCK_SIZE - 1;
+
+        for (size_t i = 5; i + 3 <= end;) {
+            const uint8_t tag = b[i];
+            const size_t length = b[i + 2];
+            if (i + 3 + length > end) break;
+            const uint8_t *payload = b + i + 3;
+
+            const uint64_t clock_unit_hz = tag == 0x03 ? 10000 : tag == 0x22 ? 1000 : 0;
+            if (clock_unit_hz)
+                for (size_t t = 0; t + kDisplayIdTimingSize <= length; t += kDisplayIdTimingSize)
+                    Consider(DisplayIdTiming(payload + t, clock_unit_hz));
+            i += 3 + length;
+        }
+    }
+
+    void Consider(const Timing &t) {
+        if (!t.width || !t.height) return;
+        if (!record_.preferred_width) {
+            record_.preferred_width = t.width;
+            record_.preferred_height = t.height;
+            record_.preferred_refresh_mhz = t.refresh_mhz;
+        }
+
+        const uint64_t area = static_cast<uint64_t>(t.width) * t.height;
+        const uint64_t max_area = static_cast<uint64_t>(record_.max_width) * record_.max_height;
+        if (area > max_area || (area == max_area && t.refresh_mhz > record_.max_refresh_mhz)) {
+            record_.max_width = t.width;
+            record_.max_height = t.height;
+            record_.max_refresh_mhz = t.refresh_mhz;
+        }
+    }
+
+    arena::Builder &builder_;
+    EDIDRecord &record_;
+};
+
+void AppendMonitor(arena::Builder &builder, const edid::Monitor &monitor) {
+    EDIDRecord record{};
+    record.device_path = builder.Intern(monitor.device_path);
+    record.acpi_path = builder.Intern(monitor.acpi_path);
+    record.pci_path = builder.Intern(monitor.pci_path);
+    record.size = static_cast<uint32_t>(monitor.data.size());
+    if (!monitor.data.empty()) {
+        record.hash = Fnv1a(monitor.data);
+        Decoder(builder, record).Decode(monitor.data.data(), monitor.data.size());
+    }
+    builder.Append(&record);
+}
+
+} // namespace
+
+// ---- Exports ----
+
+int get_edid_info_arena(DeviceArena **out) {
+    if (!out) return DEVICE_ARENA_STATUS_INVALID_ARG;
+    *out = nullptr;
+
+    std::vector<edid::Monitor> monitors;
+    {
+        DEVICE_INFO_STAGE("edid::PlatformMonitors");
+        if (!edid::PlatformMonitors(monitors)) return DEVICE_ARENA_STATUS_FAILURE;
+    }
+
+    DEVICE_INFO_STAGE("edid::Decode");
+    arena::Builder builder(DEVICE_ARENA_KIND_EDID, sizeof(EDIDRecord));
+    for (const edid::Monitor &monitor : monitors) AppendMonitor(builder, monitor);
+
+    *out = builder.Finish();
+    return *out ? DEVICE_ARENA_STATUS_OK : DEVICE_ARENA_STATUS_FAILURE;
+}
+
+int edid_parse(const uint8_t *data, uint64_t size, DeviceArena **out) {
+    if (!out || (!data && size)) return DEVICE_ARENA_STATUS_INVALID_ARG;
+    *out = nullptr;
+
+    edid::Monitor monitor;
+    monitor.data.assign(data, data + size);
+
+    arena::Builder builder(DEVICE_ARENA_KIND_EDID, sizeof(EDIDRecord));
+    AppendMonitor(builder, monitor);
+
+    *out = builder.Finish();
+    return *out ? DEVICE_ARENA_STATUS_OK : DEVICE_ARENA_STATUS_FAILURE;
+}
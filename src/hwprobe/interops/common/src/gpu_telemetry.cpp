@@ -0,0 +1,181 @@
+#include "gpu_telemetry.h"
+#include "bench_stages.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+static_assert((GPU_TELEMETRY_CAPACITY & (GPU_TELEMETRY_CAPACITY - 1)) == 0, "capacity must be a power of two");
+
+// `state` is 2*seq+1 while sample `seq` is being written into the slot and 2*seq+2 once it is
+// complete, as in the trace ring. Fields are relaxed atomics so a reader racing the sampler is
+// well-defined; the state check before and after the copy tells it whether the copy is torn.
+struct Slot {
+    std::atomic<uint64_t> state{0};
+    std::atomic<uint64_t> timestamp_ns{0};
+    std::atomic<uint64_t> memory_used_bytes{0};
+    std::atomic<uint64_t> memory_budget_bytes{0};
+    std::atomic<uint64_t> shared_memory_used_bytes{0};
+    std::atomic<uint64_t> process_memory_used_bytes{0};
+    std::atomic<uint32_t> gpu_index{0};
+    std::atomic<uint32_t> fields{0};
+    std::atomic<uint32_t> utilization_percent{0};
+    std::atomic<int32_t> pcie_gen{0};
+    std::atomic<int32_t> pcie_width{0};
+};
+
+Slot g_slots[GPU_TELEMETRY_CAPACITY];
+// Sequences keep growing across stop/start, so a reader's cursor stays valid.
+std::atomic<uint64_t> g_next{0};
+
+std::mutex g_lifecycleMutex;
+int g_startCount = 0;
+std::thread g_sampler;
+
+std::mutex g_wakeMutex;
+std::condition_variable g_wake;
+bool g_stopping = false;
+
+void Run(std::chrono::milliseconds interval) {
+    auto next = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(g_wakeMutex);
+    while (!g_stopping) {
+        lock.unlock();
+        {
+            DEVICE_INFO_STAGE("gpu_telemetry::PlatformSample");
+            gpu_telemetry::PlatformSample();
+        }
+        lock.lock();
+
+        // Fixed rate; after a stall (a slow driver call, a suspended machine) skip the missed
+        // samples instead of bursting to catch up.
+        next += interval;
+        const auto now = std::chrono::steady_clock::now();
+        if (next < now) next = now;
+        g_wake.wait_until(lock, next, [] { return g_stopping; });
+    }
+    lock.unlock();
+    gpu_telemetry::PlatformClose();
+}
+
+} // namespace
+
+namespace gpu_telemetry {
+
+uint64_t NowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Publish(GpuTelemetrySample &sample) {
+    // Single writer: only the sampler thread advances g_next.
+    const uint64_t seq = g_next.load(std::memory_order_relaxed);
+    sample.sequence = seq;
+
+    Slot &slot = g_slots[seq & (GPU_TELEMETRY_CAPACITY - 1)];
+    slot.state.store(2 * seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timestamp_ns.store(sample.timestamp_ns, std::memory_order_relaxed);
+    slot.memory_used_bytes.store(sample.memory_used_bytes, std::memory_order_relaxed);
+    slot.memory_budget_bytes.store(sample.memory_budget_bytes, std::memory_order_relaxed);
+    slot.shared_memory_used_bytes.store(sample.shared_memory_used_bytes, std::memory_order_relaxed);
+    slot.process_memory_used_bytes.store(sample.process_memory_used_bytes, std::memory_order_relaxed);
+    slot.gpu_index.store(sample.gpu_index, std::memory_order_relaxed);
+    slot.fields.store(sample.fields, std::memory_order_relaxed);
+    slot.utilization_percent.store(sample.utilization_percent, std::memory_order_relaxed);
+    slot.pcie_gen.store(sample.pcie_gen, std::memory_order_relaxed);
+    slot.pcie_width.store(sample.pcie_width, std::memory_order_relaxed);
+    slot.state.store(2 * seq + 2, std::memory_order_release);
+    g_next.store(seq + 1, std::memory_order_release);
+}
+
+} // namespace gpu_telemetry
+
+// ---- Exports ----
+
+int gpu_telemetry_start(uint32_t interval_ms) {
+    if (interval_ms == 0) return GPU_TELEMETRY_STATUS_INVALID_ARG;
+    const uint32_t clamped = std::clamp<uint32_t>(interval_ms, GPU_TELEMETRY_MIN_INTERVAL_MS,
+                                                  GPU_TELEMETRY_MAX_INTERVAL_MS);
+
+    std::lock_guard<std::mutex> lock(g_lifecycleMutex);
+    if (g_startCount == 0) {
+        {
+            DEVICE_INFO_STAGE("gpu_telemetry::PlatformOpen");
+            if (!gpu_telemetry::PlatformOpen()) return GPU_TELEMETRY_STATUS_FAILURE;
+        }
+        {
+            std::lock_guard<std::mutex> wake(g_wakeMutex);
+            g_stopping = false;
+        }
+        try {
+            g_sampler = std::thread(Run, std::chrono::milliseconds(clamped));
+        } catch (const std::exception &) {
+            gpu_telemetry::PlatformClose();
+            return GPU_TELEMETRY_STATUS_FAILURE;
+        }
+    }
+    ++g_startCount;
+    return GPU_TELEMETRY_STATUS_OK;
+}
+
+void gpu_telemetry_stop(void) {
+    std::lock_guard<std::mutex> lock(g_lifecycleMutex);
+    if (g_startCount == 0 || --g_startCount > 0) return;
+    {
+        std::lock_guard<std::mutex> wake(g_wakeMutex);
+        g_stopping = true;
+    }
+    g_wake.notify_all();
+    g_sampler.join();
+}
+
+int gpu_telemetry_read(GpuTelemetrySample *out, int max_count, uint64_t *cursor, uint64_t *dropped) {
+    if (dropped) *dropped = 0;
+    if (!out || max_count <= 0 || !cursor) return 0;
+
+    const uint64_t end = g_next.load(std::memory_order_acquire);
+    uint64_t seq = *cursor;
+    uint64_t lost = 0;
+    if (end > GPU_TELEMETRY_CAPACITY && seq < end - GPU_TELEMETRY_CAPACITY) {
+        lost += end - GPU_TELEMETRY_CAPACITY - seq;
+        seq = end - GPU_TELEMETRY_CAPACITY;
+    }
+
+    int count = 0;
+    for (; seq < end && count < max_count; ++seq) {
+        const Slot &slot = g_slots[seq & (GPU_TELEMETRY_CAPACITY - 1)];
+        const uint64_t before = slot.state.load(std::memory_order_acquire);
+
+        GpuTelemetrySample &sample = out[count];
+        sample.sequence = seq;
+        sample.timestamp_ns = slot.timestamp_ns.load(std::memory_order_relaxed);
+        sample.memory_used_bytes = slot.memory_used_bytes.load(std::memory_order_relaxed);
+        sample.memory_budget_bytes = slot.memory_budget_bytes.load(std::memory_order_relaxed);
+        sample.shared_memory_used_bytes = slot.shared_memory_used_bytes.load(std::memory_order_relaxed);
+        sample.process_memory_used_bytes = slot.process_memory_used_bytes.load(std::memory_order_relaxed);
+        sample.gpu_index = slot.gpu_index.load(std::memory_order_relaxed);
+        sample.fields = slot.fields.load(std::memory_order_relaxed);
+        sample.utilization_percent = slot.utilization_percent.load(std::memory_order_relaxed);
+        sample.pcie_gen = slot.pcie_gen.load(std::memory_order_relaxed);
+        sample.pcie_width = slot.pcie_width.load(std::memory_order_relaxed);
+        sample.reserved = 0;
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (before != 2 * seq + 2 || slot.state.load(std::memory_order_relaxed) != before) {
+            ++lost;  // overwritten by a newer sample while (or before) we copied it
+            continue;
+        }
+        ++count;
+    }
+
+    *cursor = seq;
+    if (dropped) *dropped = lost;
+    return count;
+}
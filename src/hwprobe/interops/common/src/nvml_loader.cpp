@@ -0,0 +1,167 @@
+#include "nvml_loader.h"
+#include "bench_stages.h"
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+// ---- NVML ABI ----
+//
+// The few declarations of nvml.h used here, so the build does not need the CUDA toolkit. These
+// entry points and structs have kept their layout since the _v2 / _v3 revisions named below.
+
+namespace {
+
+typedef int NvmlReturn;  // nvmlReturn_t; NVML_SUCCESS is 0
+typedef struct NvmlDeviceOpaque *NvmlDevice;
+
+constexpr NvmlReturn kNvmlSuccess = 0;
+constexpr unsigned kNameBufferSize = 96;  // NVML_DEVICE_NAME_V2_BUFFER_SIZE
+
+struct NvmlPciInfo {  // nvmlPciInfo_t, as filled by nvmlDeviceGetPciInfo_v3
+    char bus_id_legacy[16];
+    unsigned domain;
+    unsigned bus;
+    unsigned device;
+    unsigned pci_device_id;
+    unsigned pci_subsystem_id;
+    char bus_id[32];  // "00000000:01:00.0"
+};
+
+struct NvmlMemory {  // nvmlMemory_t
+    unsigned long long total;
+    unsigned long long free;
+    unsigned long long used;
+};
+
+struct Api {
+    NvmlReturn (*init)();
+    NvmlReturn (*get_count)(unsigned *);
+    NvmlReturn (*get_handle)(unsigned, NvmlDevice *);
+    NvmlReturn (*get_pci_info)(NvmlDevice, NvmlPciInfo *);
+    NvmlReturn (*get_name)(NvmlDevice, char *, unsigned);
+    NvmlReturn (*get_memory)(NvmlDevice, NvmlMemory *);
+    NvmlReturn (*get_link_gen)(NvmlDevice, unsigned *);
+    NvmlReturn (*get_link_width)(NvmlDevice, unsigned *);
+};
+
+// ---- Loading ----
+
+#if defined(_WIN32)
+typedef HMODULE Library;
+
+// Drivers since R460 install nvml.dll in System32; older ones only under NVSMI.
+Library OpenLibrary() {
+    if (HMODULE lib = LoadLibraryExW(L"nvml.dll", nullptr, LOAD_LIBRARY_SEARCH_SYSTEM32)) return lib;
+    wchar_t program_files[MAX_PATH];
+    const DWORD n = GetEnvironmentVariableW(L"ProgramW6432", program_files, MAX_PATH);
+    if (n == 0 || n >= MAX_PATH) return nullptr;
+    const std::wstring path = std::wstring(program_files) + L"\\NVIDIA Corporation\\NVSMI\\nvml.dll";
+    return LoadLibraryExW(path.c_str(), nullptr, LOAD_WITH_ALTERED_SEARCH_PATH);
+}
+
+void *Symbol(Library lib, const char *name) {
+    return reinterpret_cast<void *>(GetProcAddress(lib, name));
+}
+#else
+typedef void *Library;
+
+// The unversioned name only exists with the driver's development package installed
+Library OpenLibrary() {
+    if (void *lib = dlopen("libnvidia-ml.so.1", RTLD_NOW | RTLD_LOCAL)) return lib;
+    return dlopen("libnvidia-ml.so", RTLD_NOW | RTLD_LOCAL);
+}
+
+void *Symbol(Library lib, const char *name) {
+    return dlsym(lib, name);
+}
+#endif
+
+template <typename Fn>
+bool Bind(Library lib, const char *name, Fn &fn) {
+    fn = reinterpret_cast<Fn>(Symbol(lib, name));
+    return fn != nullptr;
+}
+
+// Loaded and initialised once per process, never unloaded: nvmlShutdown() from a static
+// destructor could run after the driver's own teardown.
+const Api *LoadApi() {
+    static Api api;
+    static bool loaded = false;
+    static std::once_flag once;
+    std::call_once(once, [] {
+        DEVICE_INFO_STAGE("nvml::Load");
+        Library lib = OpenLibrary();
+        if (!lib) return;
+        loaded = Bind(lib, "nvmlInit_v2", api.init) &&
+                 Bind(lib, "nvmlDeviceGetCount_v2", api.get_count) &&
+                 Bind(lib, "nvmlDeviceGetHandleByIndex_v2", api.get_handle) &&
+                 Bind(lib, "nvmlDeviceGetPciInfo_v3", api.get_pci_info) &&
+                 Bind(lib, "nvmlDeviceGetName", api.get_name) &&
+                 Bind(lib, "nvmlDeviceGetMemoryInfo", api.get_memory) &&
+                 Bind(lib, "nvmlDeviceGetCurrPcieLinkGeneration", api.get_link_gen) &&
+                 Bind(lib, "nvmlDeviceGetCurrPcieLinkWidth", api.get_link_width) &&
+                 api.init() == kNvmlSuccess;
+    });
+    return loaded ? &api : nullptr;
+}
+
+} // namespace
+
+namespace nvml {
+
+bool QueryDevices(std::vector<Device> &out) {
+    DEVICE_INFO_STAGE("nvml::QueryDevices");
+    out.clear();
+    const Api *api = LoadApi();
+    unsigned count = 0;
+    if (!api || api->get_count(&count) != kNvmlSuccess) return false;
+
+    for (unsigned i = 0; i < count; ++i) {
+        NvmlDevice handle = nullptr;
+        NvmlPciInfo pci = {};
+        if (api->get_handle(i, &handle) != kNvmlSuccess || api->get_pci_info(handle, &pci) != kNvmlSuccess)
+            continue;
+
+        Device device;
+        unsigned domain = 0, bus = 0, slot = 0, function = 0;
+        if (std::sscanf(pci.bus_id, "%x:%x:%x.%x", &domain, &bus, &slot, &function) != 4) {
+            domain = pci.domain;
+            bus = pci.bus;
+            slot = pci.device;
+        }
+        device.domain = domain;
+        device.bus = bus;
+        device.slot = slot;
+        device.function = function;
+        device.pci_device_id = pci.pci_device_id;
+
+        char name[kNameBufferSize] = {};
+        if (api->get_name(handle, name, kNameBufferSize) == kNvmlSuccess) device.name = name;
+
+        NvmlMemory memory = {};
+        if (api->get_memory(handle, &memory) == kNvmlSuccess) device.memory_total_bytes = memory.total;
+
+        unsigned value = 0;
+        if (api->get_link_gen(handle, &value) == kNvmlSuccess) device.pcie_gen = static_cast<int32_t>(value);
+        if (api->get_link_width(handle, &value) == kNvmlSuccess) device.pcie_width = static_cast<int32_t>(value);
+        out.push_back(std::move(device));
+    }
+    return true;
+}
+
+const Device *Find(const std::vector<Device> &devices, uint32_t domain, uint32_t bus, uint32_t slot,
+                   uint32_t function) {
+    for (const Device &device : devices)
+        if (device.domain == domain && device.bus == bus && device.slot == slot && device.function == function)
+            return &device;
+    return nullptr;
+}
+
+} // namespace nvml
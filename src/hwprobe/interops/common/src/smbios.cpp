@@ -0,0 +1,258 @@
+#include "smbios.h"
+#include "bench_stages.h"
+#include "device_replay.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace smbios {
+
+// ---- Structure ----
+
+uint64_t Structure::ReadLE(size_t offset, size_t width) const {
+    uint64_t value = 0;
+    for (size_t i = 0; i < width; ++i)
+        value |= static_cast<uint64_t>(data_[offset + i]) << (8 * i);
+    return value;
+}
+
+uint8_t Structure::Byte(size_t offset, uint8_t fallback) const {
+    return Has(offset, 1) ? data_[offset] : fallback;
+}
+
+uint16_t Structure::Word(size_t offset, uint16_t fallback) const {
+    return Has(offset, 2) ? static_cast<uint16_t>(ReadLE(offset, 2)) : fallback;
+}
+
+uint32_t Structure::Dword(size_t offset, uint32_t fallback) const {
+    return Has(offset, 4) ? static_cast<uint32_t>(ReadLE(offset, 4)) : fallback;
+}
+
+uint64_t Structure::Qword(size_t offset, uint64_t fallback) const {
+    return Has(offset, 8) ? ReadLE(offset, 8) : fallback;
+}
+
+std::string_view Structure::String(size_t offset) const {
+    return StringAt(Byte(offset));
+}
+
+std::string_view Structure::StringAt(uint8_t index) const {
+    if (index == 0) return {};
+
+    const char *p = strings_;
+    while (p < strings_end_) {
+        const void *nul = std::memchr(p, '\0', static_cast<size_t>(strings_end_ - p));
+        if (!nul) return {};
+        const char *end = static_cast<const char *>(nul);
+        // An empty string terminates the string-set.
+        if (end == p) return {};
+        if (--index == 0) return {p, static_cast<size_t>(end - p)};
+        p = end + 1;
+    }
+    return {};
+}
+
+// ---- Table ----
+
+Table::Table(std::vector<uint8_t> raw, Version version) : raw_(std::move(raw)), version_(version) {
+    DEVICE_INFO_STAGE("smbios::Table::Index");
+    const uint8_t *base = raw_.data();
+    const size_t size = raw_.size();
+    size_t pos = 0;
+
+    while (pos + 4 <= size) {
+        const uint8_t type = base[pos];
+        const uint8_t length = base[pos + 1];
+        if (length < 4 || pos + length > size) break;
+
+        // The string-set follows the formatted area and ends with a double NUL. A structure
+        // without strings still carries the two NULs.
+        size_t scan = pos + length;
+        while (scan + 1 < size && !(base[scan] == 0 && base[scan + 1] == 0)) ++scan;
+        if (scan + 1 >= size) break;
+
+        const auto *strings = reinterpret_cast<const char *>(base + pos + length);
+        const auto *strings_end = reinterpret_cast<const char *>(base + scan + 1);
+
+        auto index = static_cast<uint32_t>(structures_.size());
+        structures_.emplace_back(base + pos, strings, strings_end);
+        by_type_[type].push_back(index);
+        by_handle_.emplace(structures_.back().handle(), index);
+
+        pos = scan + 2;
+        if (type == 127) break;
+    }
+}
+
+const Structure *Table::Find(uint8_t type, size_t index) const {
+    const auto &list = by_type_[type];
+    return index < list.size() ? &structures_[list[index]] : nullptr;
+}
+
+StringRef Table::Ref(std::string_view str) const {
+    StringRef ref;
+    if (str.empty()) return ref;
+    const auto *begin = reinterpret_cast<const char *>(raw_.data());
+    if (str.data() < begin || str.data() + str.size() > begin + raw_.size()) return ref;
+    ref.offset = static_cast<uint32_t>(str.data() - begin);
+    ref.length = static_cast<uint32_t>(str.size());
+    return ref;
+}
+
+const Structure *Table::FindHandle(uint16_t handle) const {
+    auto it = by_handle_.find(handle);
+    return it != by_handle_.end() ? &structures_[it->second] : nullptr;
+}
+
+// ---- Firmware access ----
+
+#if defined(_WIN32)
+
+bool ReadFirmwareTable(std::vector<uint8_t> &raw, Version &version) {
+    // RSMB returns a RawSMBIOSData: 4 version bytes, a DWORD length, then the table.
+    DWORD size = GetSystemFirmwareTable('RSMB', 0, nullptr, 0);
+    if (size <= 8) return false;
+
+    std::vector<uint8_t> buffer(size);
+    DWORD written = GetSystemFirmwareTable('RSMB', 0, buffer.data(), size);
+    if (written <= 8 || written > size) return false;
+
+    uint32_t table_length = 0;
+    std::memcpy(&table_length, buffer.data() + 4, sizeof(table_length));
+    size_t available = written - 8;
+    if (table_length == 0 || table_length > available) table_length = static_cast<uint32_t>(available);
+
+    version.major = buffer[1];
+    version.minor = buffer[2];
+    version.revision = buffer[3];
+    raw.assign(buffer.begin() + 8, buffer.begin() + 8 + table_length);
+    return true;
+}
+
+#elif defined(__linux__)
+
+static bool ReadFile(const char *path, std::vector<uint8_t> &out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !file.bad();
+}
+
+bool ReadFirmwareTable(std::vector<uint8_t> &raw, Version &version) {
+    if (!ReadFile("/sys/firmware/dmi/tables/DMI", raw) || raw.empty())
+        return false;
+
+    // Version lives in the entry point: "_SM_" (2.x, 32-bit) or "_SM3_" (3.x, 64-bit).
+    std::vector<uint8_t> entry;
+    if (ReadFile("/sys/firmware/dmi/tables/smbios_entry_point", entry)) {
+        if (entry.size() >= 10 && std::memcmp(entry.data(), "_SM3_", 5) == 0) {
+            version.major = entry[7];
+            version.minor = entry[8];
+            version.revision = entry[9];
+        } else if (entry.size() >= 8 && std::memcmp(entry.data(), "_SM_", 4) == 0) {
+            version.major = entry[6];
+            version.minor = entry[7];
+        }
+    }
+    return true;
+}
+
+#else
+
+bool ReadFirmwareTable(std::vector<uint8_t> &, Version &) {
+    return false;
+}
+
+#endif
+
+// ---- Process-wide cache ----
+
+namespace {
+
+std::mutex g_mutex;
+std::shared_ptr<const Table> g_table;
+// Tables replaced by a reload, kept so that pointers into them stay valid; the oldest is
+// dropped beyond kMaxRetired. A reload that reads a table already held reuses it instead.
+std::vector<std::shared_ptr<const Table>> g_retired;
+constexpr size_t kMaxRetired = 16;
+bool g_loaded = false;
+uint64_t g_loadedGeneration = 0;  // replay::Generation() the table was loaded under
+
+// The firmware table, or the recorded one while replaying; the replay entry is the 4 version
+// bytes (major, minor, revision, 0) followed by the table.
+bool ReadTable(std::vector<uint8_t> &raw, Version &version) {
+    if (!replay::Active()) return ReadFirmwareTable(raw, version);
+
+    if (replay::Replaying()) {
+        std::string recorded;
+        if (!replay::Lookup(DEVICE_REPLAY_SMBIOS, {}, recorded) || recorded.size() <= 4) return false;
+        version.major = static_cast<uint8_t>(recorded[0]);
+        version.minor = static_cast<uint8_t>(recorded[1]);
+        version.revision = static_cast<uint8_t>(recorded[2]);
+        raw.assign(recorded.begin() + 4, recorded.end());
+        return true;
+    }
+
+    if (!ReadFirmwareTable(raw, version)) return false;
+    std::string entry{static_cast<char>(version.major), static_cast<char>(version.minor),
+                      static_cast<char>(version.revision), '\0'};
+    entry.append(reinterpret_cast<const char *>(raw.data()), raw.size());
+    replay::Record(DEVICE_REPLAY_SMBIOS, {}, entry);
+    return true;
+}
+
+bool SameTable(const Table &table, const std::vector<uint8_t> &raw, const Version &version) {
+    return table.version().major == version.major && table.version().minor == version.minor &&
+           table.version().revision == version.revision && table.size_bytes() == raw.size() &&
+           std::memcmp(table.data(), raw.data(), raw.size()) == 0;
+}
+
+std::shared_ptr<const Table> LoadLocked() {
+    DEVICE_INFO_STAGE("smbios::ReadFirmwareTable");
+    std::vector<uint8_t> raw;
+    Version version;
+    g_loaded = true;
+    g_loadedGeneration = replay::Generation();
+    if (!ReadTable(raw, version)) {
+        if (g_table) g_retired.push_back(std::move(g_table));
+    } else if (!g_table || !SameTable(*g_table, raw, version)) {
+        // Switching back and forth between live and replayed tables keeps reusing the same two
+        auto held = std::find_if(g_retired.begin(), g_retired.end(), [&](const std::shared_ptr<const Table> &table) {
+            return SameTable(*table, raw, version);
+        });
+        std::shared_ptr<const Table> next;
+        if (held != g_retired.end()) {
+            next = std::move(*held);
+            g_retired.erase(held);
+        } else {
+            next = std::make_shared<const Table>(std::move(raw), version);
+        }
+        if (g_table) g_retired.push_back(std::move(g_table));
+        g_table = std::move(next);
+    }
+    if (g_retired.size() > kMaxRetired) g_retired.erase(g_retired.begin());
+    return g_table;
+}
+
+} // namespace
+
+std::shared_ptr<const Table> Current() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    // Reloaded when recording or replaying starts or stops, so each mode sees its own table
+    return g_loaded && g_loadedGeneration == replay::Generation() ? g_table : LoadLocked();
+}
+
+std::shared_ptr<const Table> Reload() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return LoadLocked();
+}
+
+} // namespace smbios
@@ -0,0 +1,139 @@
+#include "smbios_info.h"
+#include "smbios.h"
+
+#include <algorithm>
+#include <cstring>
+
+// ---- Helpers ----
+
+static const smbios::Structure *LookupHandle(const std::shared_ptr<const smbios::Table> &table, uint16_t handle) {
+    return table ? table->FindHandle(handle) : nullptr;
+}
+
+static void FillInfo(const smbios::Structure &s, SmbiosStructureInfo *out) {
+    out->type = s.type();
+    out->length = s.length();
+    out->handle = s.handle();
+}
+
+// ---- Public API ----
+
+extern "C" int smbios_refresh(void) {
+    return smbios::Reload() ? SMBIOS_STATUS_OK : SMBIOS_STATUS_FAILURE;
+}
+
+extern "C" int smbios_get_version(uint8_t *major, uint8_t *minor, uint8_t *revision) {
+    auto table = smbios::Current();
+    if (!table) return SMBIOS_STATUS_FAILURE;
+    if (major) *major = table->version().major;
+    if (minor) *minor = table->version().minor;
+    if (revision) *revision = table->version().revision;
+    return SMBIOS_STATUS_OK;
+}
+
+extern "C" int smbios_count(int type) {
+    if (type < 0 || type > 255) return -1;
+    auto table = smbios::Current();
+    return table ? static_cast<int>(table->Count(static_cast<uint8_t>(type))) : -1;
+}
+
+extern "C" int smbios_get_structure(int type, int index, SmbiosStructureInfo *out) {
+    if (type < 0 || type > 255 || index < 0 || !out) return SMBIOS_STATUS_INVALID_ARG;
+    auto table = smbios::Current();
+    if (!table) return SMBIOS_STATUS_FAILURE;
+
+    const smbios::Structure *s = table->Find(static_cast<uint8_t>(type), static_cast<size_t>(index));
+    if (!s) return SMBIOS_STATUS_NOT_FOUND;
+    FillInfo(*s, out);
+    return SMBIOS_STATUS_OK;
+}
+
+extern "C" int smbios_get_structure_by_handle(uint16_t handle, SmbiosStructureInfo *out) {
+    if (!out) return SMBIOS_STATUS_INVALID_ARG;
+    auto table = smbios::Current();
+    if (!table) return SMBIOS_STATUS_FAILURE;
+
+    const smbios::Structure *s = table->FindHandle(handle);
+    if (!s) return SMBIOS_STATUS_NOT_FOUND;
+    FillInfo(*s, out);
+    return SMBIOS_STATUS_OK;
+}
+
+extern "C" int smbios_read_field(uint16_t handle, int offset, int width, uint64_t *out) {
+    if (!out || offset < 0 || (width != 1 && width != 2 && width != 4 && width != 8))
+        return SMBIOS_STATUS_INVALID_ARG;
+    auto table = smbios::Current();
+    if (!table) return SMBIOS_STATUS_FAILURE;
+
+    const smbios::Structure *s = LookupHandle(table, handle);
+    if (!s || !s->Has(static_cast<size_t>(offset), static_cast<size_t>(width)))
+        return SMBIOS_STATUS_NOT_FOUND;
+
+    switch (width) {
+        case 1: *out = s->Byte(offset); break;
+        case 2: *out = s->Word(offset); break;
+        case 4: *out = s->Dword(offset); break;
+        default: *out = s->Qword(offset); break;
+    }
+    return SMBIOS_STATUS_OK;
+}
+
+extern "C" int smbios_read_string(uint16_t handle, int offset, char *out, int max_len) {
+    if (!out || max_len <= 0 || offset < 0) return -1;
+    out[0] = '\0';
+    auto table = smbios::Current();
+    const smbios::Structure *s = LookupHandle(table, handle);
+    if (!s) return -1;
+
+    std::string_view str = s->String(static_cast<size_t>(offset));
+    size_t copy = std::min(str.size(), static_cast<size_t>(max_len - 1));
+    if (copy) std::memcpy(out, str.data(), copy);
+    out[copy] = '\0';
+    return static_cast<int>(str.size());
+}
+
+extern "C" int smbios_read_formatted(uint16_t handle, uint8_t *out, int max_len) {
+    if (!out || max_len < 0) return -1;
+    auto table = smbios::Current();
+    const smbios::Structure *s = LookupHandle(table, handle);
+    if (!s) return -1;
+
+    if (max_len >= s->length())
+        std::memcpy(out, s->data(), s->length());
+    return s->length();
+}
+
+extern "C" int smbios_read_structure(uint16_t handle, uint8_t *out, int max_len) {
+    if (!out || max_len < 0) return -1;
+    auto table = smbios::Current();
+    const smbios::Structure *s = LookupHandle(table, handle);
+    if (!s) return -1;
+
+    const size_t size = s->size_bytes();
+    if (static_cast<size_t>(max_len) >= size)
+        std::memcpy(out, s->data(), size);
+    return static_cast<int>(size);
+}
+
+extern "C" int smbios_get_table(const uint8_t **data, uint64_t *size) {
+    if (!data || !size) return SMBIOS_STATUS_INVALID_ARG;
+    auto table = smbios::Current();
+    if (!table) return SMBIOS_STATUS_FAILURE;
+    *data = table->data();
+    *size = table->size_bytes();
+    return SMBIOS_STATUS_OK;
+}
+
+extern "C" int smbios_get_string_ref(uint16_t handle, int offset, SmbiosStringRef *out) {
+    if (!out || offset < 0) return SMBIOS_STATUS_INVALID_ARG;
+    auto table = smbios::Current();
+    if (!table) return SMBIOS_STATUS_FAILURE;
+
+    const smbios::Structure *s = table->FindHandle(handle);
+    if (!s) return SMBIOS_STATUS_NOT_FOUND;
+
+    smbios::StringRef ref = table->Ref(s->String(static_cast<size_t>(offset)));
+    out->offset = ref.offset;
+    out->length = ref.length;
+    return SMBIOS_STATUS_OK;
+}
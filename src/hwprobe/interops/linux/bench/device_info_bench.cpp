@@ -0,0 +1,100 @@
+// Regression benchmark for the Linux exports: every case runs N times cold and warm, and the
+// report (JSON on stdout) gives p50/p99/max latency per case. For a libdevice_info.so configured
+// with -DDEVICE_INFO_BUILD_BENCHMARKS=ON it also gives allocations per call and the share of each
+// internal stage (/proc/cpuinfo, collectGpus, PciIds::Load, getifaddrs...).
+//
+//   device_info_bench [--iterations N] [--mode cold|warm|both] [--device-info path/to/libdevice_info.so]
+//                     [--record corpus.bin | --replay corpus.bin]
+//
+// The library is opened at runtime so the same binary can compare two builds side by side.
+// The directory descriptors and the pci.ids index are kept for the life of the process, so the
+// first call pays for them and cold and warm differ by that.
+
+#include "bench_harness.h"
+#include "device_arena.h"
+
+#include <dlfcn.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+template <typename Fn>
+Fn Resolve(void *lib, const char *name) {
+    return reinterpret_cast<Fn>(dlsym(lib, name));
+}
+
+// Query + exact-size copy + free, the way the Python binding reads an arena.
+bench::Case ArenaCase(void *lib, const char *name) {
+    auto query = Resolve<int (*)(DeviceArena **)>(lib, name);
+    auto size = Resolve<uint64_t (*)(const DeviceArena *)>(lib, "device_arena_size");
+    auto copy = Resolve<int (*)(const DeviceArena *, void *, uint64_t)>(lib, "device_arena_copy");
+    auto release = Resolve<void (*)(DeviceArena *)>(lib, "device_arena_free");
+    return bench::Case(name, "device_info", [=] {
+        DeviceArena *arena = nullptr;
+        if (!query || query(&arena) != DEVICE_ARENA_STATUS_OK || !arena) return false;
+        std::vector<unsigned char> blob(static_cast<size_t>(size(arena)));
+        const bool ok = copy(arena, blob.data(), blob.size()) == DEVICE_ARENA_STATUS_OK;
+        release(arena);
+        return ok;
+    }, true);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bench::Options options;
+    std::vector<std::string> rest;
+    if (!bench::ParseOptions(argc, argv, options, rest)) return 2;
+
+    std::string path = "libdevice_info.so", record_path, replay_path;
+    for (size_t i = 0; i + 1 < rest.size(); i += 2) {
+        if (rest[i] == "--device-info") path = rest[i + 1];
+        else if (rest[i] == "--record") record_path = rest[i + 1];
+        else if (rest[i] == "--replay") replay_path = rest[i + 1];
+    }
+
+    void *lib = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!lib) {
+        std::fprintf(stderr, "Error: could not load %s: %s\n", path.c_str(), dlerror());
+        return 1;
+    }
+
+    bench::StageApi stages;
+    stages.count = Resolve<int (*)(void)>(lib, "device_info_stage_count");
+    stages.get = Resolve<int (*)(int, DeviceInfoStageStats *)>(lib, "device_info_stage_get");
+    stages.reset = Resolve<void (*)(void)>(lib, "device_info_stage_reset");
+    stages.allocations = Resolve<uint64_t (*)(void)>(lib, "device_info_alloc_count");
+
+    bench::ReplayApi replay;
+    replay.record_start = Resolve<int (*)(void)>(lib, "device_replay_record_start");
+    replay.record_stop = Resolve<int (*)(DeviceReplayCorpus **)>(lib, "device_replay_record_stop");
+    replay.corpus_size = Resolve<uint64_t (*)(const DeviceReplayCorpus *)>(lib, "device_replay_corpus_size");
+    replay.corpus_copy = Resolve<int (*)(const DeviceReplayCorpus *, void *, uint64_t)>(lib, "device_replay_corpus_copy");
+    replay.corpus_free = Resolve<void (*)(DeviceReplayCorpus *)>(lib, "device_replay_corpus_free");
+    replay.start = Resolve<int (*)(const void *, uint64_t)>(lib, "device_replay_start");
+    replay.stop = Resolve<void (*)(void)>(lib, "device_replay_stop");
+
+    std::vector<bench::Case> cases;
+    cases.push_back(ArenaCase(lib, "get_cpu_info_arena"));
+    cases.push_back(ArenaCase(lib, "get_gpu_info_arena"));
+    cases.push_back(ArenaCase(lib, "get_network_info_arena"));
+    cases.push_back(ArenaCase(lib, "get_cpu_topology_arena"));
+
+    if (!record_path.empty()) {
+        const bool recorded = bench::RecordCorpus(replay, cases, record_path);
+        dlclose(lib);
+        return recorded ? 0 : 1;
+    }
+    if (!replay_path.empty() && !bench::ReplayCorpus(replay, replay_path)) {
+        dlclose(lib);
+        return 1;
+    }
+
+    const int status = bench::Run("linux", cases, options, stages);
+    dlclose(lib);
+    return status;
+}
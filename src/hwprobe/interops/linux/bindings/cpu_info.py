@@ -0,0 +1,88 @@
+"""
+cpu_info.py  –  Python ctypes binding for libdevice_info.so (processor summary)
+
+Usage:
+    from hwprobe.interops.linux.bindings.cpu_info import get_cpu_info
+    print(get_cpu_info())
+
+Source code is in `interops/linux/include/` and `interops/linux/src/`.
+"""
+
+import ctypes
+import pathlib
+from dataclasses import dataclass
+from typing import Optional
+
+from hwprobe.interops.common.device_arena import (
+    DEVICE_ARENA_KIND_LINUX_CPU, ArenaString, bind_arena_exports, fetch_arena,
+)
+
+# ── locate the shared library ───────────────────────────────────────────────
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "libdevice_info.so"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"libdevice_info.so not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake -S src/hwprobe/interops/linux -B build && cmake --build build"
+    )
+
+_lib = ctypes.CDLL(str(_LIB_PATH))
+
+
+# ── mirror the C struct ──────────────────────────────────────────────────────
+
+class _CPURecord(ctypes.Structure):
+    _fields_ = [
+        ("machine", ArenaString),
+        ("model_name", ArenaString),
+        ("vendor", ArenaString),
+        ("arch_version", ArenaString),
+        ("flags", ArenaString),
+        ("threads", ctypes.c_int32),
+        ("cores_per_package", ctypes.c_int32),
+        ("cores", ctypes.c_int32),
+        ("reserved", ctypes.c_int32),
+    ]
+
+
+bind_arena_exports(_lib, _lib.get_cpu_info_arena)
+
+
+# ── Python-facing dataclass ──────────────────────────────────────────────────
+
+@dataclass
+class CPUProperties:
+    machine: Optional[str]        # uname machine, e.g. "x86_64", "aarch64"
+    model_name: Optional[str]
+    vendor: Optional[str]         # x86 vendor_id, e.g. "GenuineIntel"
+    arch_version: Optional[str]   # ARM "CPU architecture"
+    flags: Optional[str]          # space-separated, as in /proc/cpuinfo
+    threads: int
+    cores_per_package: int        # "cpu cores", 0 if not reported
+    cores: int                    # from sysfs topology, 0 if not available
+
+
+def get_cpu_info() -> CPUProperties:
+    """Parse /proc/cpuinfo and the sysfs CPU topology natively."""
+    arena = fetch_arena(_lib.get_cpu_info_arena, _lib, DEVICE_ARENA_KIND_LINUX_CPU, _CPURecord)
+    if arena is None or len(arena[0]) != 1:
+        raise RuntimeError("get_cpu_info_arena() failed")
+
+    records, strings = arena
+    raw = records[0]
+    return CPUProperties(
+        machine=strings.get(raw.machine),
+        model_name=strings.get(raw.model_name),
+        vendor=strings.get(raw.vendor),
+        arch_version=strings.get(raw.arch_version),
+        flags=strings.get(raw.flags),
+        threads=raw.threads,
+        cores_per_package=raw.cores_per_package,
+        cores=raw.cores,
+    )
+
+
+# ── quick self-test ──────────────────────────────────────────────────────────
+if __name__ == "__main__":
+    print(get_cpu_info())
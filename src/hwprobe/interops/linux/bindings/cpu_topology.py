@@ -0,0 +1,30 @@
+"""
+cpu_topology.py  –  Python ctypes binding for libdevice_info.so (processor topology)
+
+Usage:
+    from hwprobe.interops.linux.bindings.cpu_topology import topology
+    info = topology.read()
+    print(info.cores, info.threads, info.core_classes, info.caches)
+
+Source code is in `interops/common/src/cpu_topology.cpp` and `interops/linux/src/cpu_topology_linux.cpp`.
+"""
+
+import ctypes
+import pathlib
+
+from hwprobe.interops.common.cpu_topology import CpuTopologyReader
+
+# ── locate the shared library ───────────────────────────────────────────────
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "libdevice_info.so"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"libdevice_info.so not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake -S src/hwprobe/interops/linux -B build && cmake --build build"
+    )
+
+_lib = ctypes.CDLL(str(_LIB_PATH))
+
+# Inert (read() returns None) if the library predates the topology export
+topology = CpuTopologyReader(_lib)
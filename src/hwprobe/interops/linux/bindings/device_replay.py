@@ -0,0 +1,65 @@
+"""
+device_replay.py  –  Python ctypes binding for libdevice_info.so (record / replay of sysfs and SMBIOS reads)
+
+Usage:
+    from hwprobe.interops.linux.bindings import device_replay
+    from hwprobe.interops.linux.bindings.gpu_info import get_gpu_info
+
+    with device_replay.record() as recording:     # on the machine with the hardware
+        get_gpu_info()
+    open("gpus.corpus", "wb").write(recording.corpus.to_bytes())
+
+    corpus = device_replay.Corpus.from_bytes(open("gpus.corpus", "rb").read())
+    corpus.clone("/sys/bus/pci/devices", "0000:01:00.0", [device_replay.pci_slot(i) for i in range(1000)])
+    with device_replay.replay(corpus.to_bytes()):  # anywhere
+        get_gpu_info()                              # 1001 GPUs
+
+Source code is in `interops/common/src/device_replay.cpp`; the hooks are in `interops/linux/src/sysfs_helpers.cpp`.
+"""
+
+import ctypes
+import pathlib
+from contextlib import contextmanager
+from typing import Iterator
+
+from hwprobe.interops.common import device_replay as _replay
+from hwprobe.interops.common.device_replay import Corpus, Recording, pci_slot  # noqa: F401  (re-exported)
+
+# ── locate the shared library ───────────────────────────────────────────────
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "libdevice_info.so"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"libdevice_info.so not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake -S src/hwprobe/interops/linux -B build && cmake --build build"
+    )
+
+_lib = ctypes.CDLL(str(_LIB_PATH))
+
+_SUPPORTED = _replay.bind_replay_exports(_lib)
+
+
+# ── public API ───────────────────────────────────────────────────────────────
+
+def supported() -> bool:
+    """Whether this build of the library can record and replay."""
+    return _SUPPORTED
+
+
+@contextmanager
+def record() -> Iterator[Recording]:
+    """Record what the library reads inside the block; `.corpus` of the result is set on exit."""
+    if not _SUPPORTED:
+        raise RuntimeError("libdevice_info.so predates device_replay_start()")
+    with _replay.record(_lib) as recording:
+        yield recording
+
+
+@contextmanager
+def replay(data: bytes) -> Iterator[None]:
+    """Serve what the library reads inside the block from the corpus `data`."""
+    if not _SUPPORTED:
+        raise RuntimeError("libdevice_info.so predates device_replay_start()")
+    with _replay.replay(_lib, data):
+        yield
@@ -0,0 +1,30 @@
+"""
+device_runtime.py  –  Python ctypes binding for libdevice_info.so (process lifecycle)
+
+Usage:
+    from hwprobe.interops.linux.bindings.device_runtime import runtime
+    with runtime.session():
+        ...  # probes from any number of threads
+
+Source code is in `interops/common/src/device_runtime.cpp` and `interops/linux/src/device_runtime_linux.cpp`.
+"""
+
+import ctypes
+import pathlib
+
+from hwprobe.interops.common.device_runtime import DeviceRuntime
+
+# ── locate the shared library ───────────────────────────────────────────────
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "libdevice_info.so"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"libdevice_info.so not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake -S src/hwprobe/interops/linux -B build && cmake --build build"
+    )
+
+_lib = ctypes.CDLL(str(_LIB_PATH))
+
+# Inert (init() returns False) if the library predates the lifecycle exports
+runtime = DeviceRuntime(_lib)
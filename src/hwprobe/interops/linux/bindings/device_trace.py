@@ -0,0 +1,32 @@
+"""
+device_trace.py  –  Python ctypes binding for libdevice_info.so (hot-path tracing)
+
+Usage:
+    from hwprobe.interops.linux.bindings.device_trace import trace
+    with trace.capture() as events:
+        fetch_graphics_info(native=True)
+    print(slowest(events))
+
+Source code is in `interops/common/src/device_trace.cpp`; the trace points are the DEVICE_INFO_STAGE
+scopes in `interops/linux/src`.
+"""
+
+import ctypes
+import pathlib
+
+from hwprobe.interops.common.device_trace import DeviceTrace
+
+# ── locate the shared library ───────────────────────────────────────────────
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "libdevice_info.so"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"libdevice_info.so not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake -S src/hwprobe/interops/linux -B build && cmake --build build"
+    )
+
+_lib = ctypes.CDLL(str(_LIB_PATH))
+
+# Shared by the whole process; inert if the library was built without DEVICE_INFO_TRACE
+trace = DeviceTrace(_lib)
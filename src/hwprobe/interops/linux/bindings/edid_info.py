@@ -0,0 +1,30 @@
+"""
+edid_info.py  –  Python ctypes binding for libdevice_info.so (native EDID reader)
+
+Usage:
+    from hwprobe.interops.linux.bindings.edid_info import edid
+    for monitor in edid.read() or []:
+        print(monitor.device_path, monitor.name)
+
+Source code is in `interops/linux/src/edid_linux.cpp` and `interops/common/src/edid.cpp`.
+"""
+
+import ctypes
+import pathlib
+
+from hwprobe.interops.common.edid_info import EdidReader
+
+# ── locate the shared library ───────────────────────────────────────────────
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "libdevice_info.so"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"libdevice_info.so not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake -S src/hwprobe/interops/linux -B build && cmake --build build"
+    )
+
+_lib = ctypes.CDLL(str(_LIB_PATH))
+
+# Inert (read() returns None) if the library predates the EDID exports
+edid = EdidReader(_lib)
@@ -0,0 +1,114 @@
+"""
+gpu_info.py  –  Python ctypes binding for libdevice_info.so (PCI display controllers)
+
+Usage:
+    from hwprobe.interops.linux.bindings.gpu_info import get_gpu_info
+    for g in get_gpu_info():
+        print(g)
+
+Source code is in `interops/linux/include/` and `interops/linux/src/`.
+"""
+
+import ctypes
+import pathlib
+from dataclasses import dataclass
+from typing import List, Optional
+
+from hwprobe.interops.common.device_arena import (
+    DEVICE_ARENA_KIND_LINUX_GPU, ArenaString, bind_arena_exports, fetch_arena,
+)
+
+# ── locate the shared library ───────────────────────────────────────────────
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "libdevice_info.so"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"libdevice_info.so not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake -S src/hwprobe/interops/linux -B build && cmake --build build"
+    )
+
+_lib = ctypes.CDLL(str(_LIB_PATH))
+
+
+# ── mirror the C struct ──────────────────────────────────────────────────────
+
+class _GPURecord(ctypes.Structure):
+    _fields_ = [
+        ("slot", ArenaString),
+        ("vendor_name", ArenaString),
+        ("device_name", ArenaString),
+        ("subsystem_vendor_name", ArenaString),
+        ("subsystem_device_name", ArenaString),
+        ("acpi_path", ArenaString),
+        ("pci_path", ArenaString),
+        ("vendor_id", ctypes.c_uint32),
+        ("device_id", ctypes.c_uint32),
+        ("subsystem_vendor_id", ctypes.c_uint32),
+        ("subsystem_device_id", ctypes.c_uint32),
+        ("pcie_width", ctypes.c_int32),
+        ("pcie_gen", ctypes.c_int32),
+        ("vram_mb", ctypes.c_uint64),
+        ("product_name", ArenaString),
+    ]
+
+
+bind_arena_exports(_lib, _lib.get_gpu_info_arena)
+
+
+# ── Python-facing dataclass ──────────────────────────────────────────────────
+
+@dataclass
+class GPUProperties:
+    slot: str                              # PCI address, e.g. "0000:03:00.0"
+    vendor_name: Optional[str]             # pci.ids names (what `lspci -vmm` prints)
+    device_name: Optional[str]
+    subsystem_vendor_name: Optional[str]
+    subsystem_device_name: Optional[str]
+    acpi_path: Optional[str]
+    pci_path: Optional[str]
+    vendor_id: int
+    device_id: int
+    subsystem_vendor_id: int
+    subsystem_device_id: int
+    pcie_width: int                        # 0 if not reported
+    pcie_gen: int                          # 0 if not reported
+    vram_mb: int                           # amdgpu or NVML, 0 otherwise
+    product_name: Optional[str]            # NVML name (NVIDIA); None without NVML
+
+
+def get_gpu_info() -> List[GPUProperties]:
+    """Return a GPUProperties for every PCI display controller, ordered by slot."""
+    arena = fetch_arena(_lib.get_gpu_info_arena, _lib, DEVICE_ARENA_KIND_LINUX_GPU, _GPURecord)
+    if arena is None:
+        raise RuntimeError("get_gpu_info_arena() failed")
+
+    records, strings = arena
+    return [
+        GPUProperties(
+            slot=strings.get(raw.slot) or "",
+            vendor_name=strings.get(raw.vendor_name),
+            device_name=strings.get(raw.device_name),
+            subsystem_vendor_name=strings.get(raw.subsystem_vendor_name),
+            subsystem_device_name=strings.get(raw.subsystem_device_name),
+            acpi_path=strings.get(raw.acpi_path),
+            pci_path=strings.get(raw.pci_path),
+            vendor_id=raw.vendor_id,
+            device_id=raw.device_id,
+            subsystem_vendor_id=raw.subsystem_vendor_id,
+            subsystem_device_id=raw.subsystem_device_id,
+            pcie_width=raw.pcie_width,
+            pcie_gen=raw.pcie_gen,
+            vram_mb=raw.vram_mb,
+            product_name=strings.get(raw.product_name),
+        )
+        for raw in records
+    ]
+
+
+# ── quick self-test ──────────────────────────────────────────────────────────
+if __name__ == "__main__":
+    gpus = get_gpu_info()
+    print(f"Found {len(gpus)} GPU(s):\n")
+    for g in gpus:
+        print(g)
@@ -0,0 +1,31 @@
+"""
+gpu_telemetry.py  –  Python ctypes binding for libdevice_info.so (live GPU telemetry)
+
+Usage:
+    from hwprobe.interops.linux.bindings.gpu_telemetry import telemetry
+    with telemetry.sampling(interval_ms=100):
+        time.sleep(1)
+        print(latest(telemetry.read()))
+
+Source code is in `interops/common/src/gpu_telemetry.cpp` and `interops/linux/src/gpu_telemetry_linux.cpp`.
+"""
+
+import ctypes
+import pathlib
+
+from hwprobe.interops.common.gpu_telemetry import GpuTelemetry
+
+# ── locate the shared library ───────────────────────────────────────────────
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "libdevice_info.so"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"libdevice_info.so not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake -S src/hwprobe/interops/linux -B build && cmake --build build"
+    )
+
+_lib = ctypes.CDLL(str(_LIB_PATH))
+
+# Shared by the whole process; inert if the library predates the gpu_telemetry_* exports
+telemetry = GpuTelemetry(_lib)
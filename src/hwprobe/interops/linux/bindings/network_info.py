@@ -0,0 +1,101 @@
+"""
+network_info.py  –  Python ctypes binding for libdevice_info.so (network interfaces)
+
+Usage:
+    from hwprobe.interops.linux.bindings.network_info import get_network_info
+    for nic in get_network_info():
+        print(nic)
+
+Source code is in `interops/linux/include/` and `interops/linux/src/`.
+"""
+
+import ctypes
+import pathlib
+from dataclasses import dataclass
+from typing import List, Optional
+
+from hwprobe.interops.common.device_arena import (
+    DEVICE_ARENA_KIND_LINUX_NIC, ArenaString, bind_arena_exports, fetch_arena,
+)
+
+# ── locate the shared library ───────────────────────────────────────────────
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "libdevice_info.so"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"libdevice_info.so not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake -S src/hwprobe/interops/linux -B build && cmake --build build"
+    )
+
+_lib = ctypes.CDLL(str(_LIB_PATH))
+
+
+# ── mirror the C struct ──────────────────────────────────────────────────────
+
+class _NICRecord(ctypes.Structure):
+    _fields_ = [
+        ("interface", ArenaString),
+        ("link_type", ArenaString),
+        ("mac_address", ArenaString),
+        ("ipv4_address", ArenaString),
+        ("ipv6_address", ArenaString),
+        ("device_slot", ArenaString),
+        ("acpi_path", ArenaString),
+        ("pci_path", ArenaString),
+        ("vendor_id", ctypes.c_uint32),
+        ("device_id", ctypes.c_uint32),
+        ("if_index", ctypes.c_uint32),
+        ("reserved", ctypes.c_uint32),
+    ]
+
+
+bind_arena_exports(_lib, _lib.get_network_info_arena)
+
+
+# ── Python-facing dataclass ──────────────────────────────────────────────────
+
+@dataclass
+class NICProperties:
+    interface: str
+    link_type: Optional[str]      # as `ip` names it: "ether", "loopback", ...
+    mac_address: Optional[str]
+    ipv4_address: Optional[str]   # first address of each family
+    ipv6_address: Optional[str]
+    device_slot: Optional[str]    # backing device, e.g. "0000:01:00.0"; None for a virtual interface
+    acpi_path: Optional[str]
+    pci_path: Optional[str]
+    vendor_id: int                # 0 if not reported
+    device_id: int
+    if_index: int
+
+
+def get_network_info() -> List[NICProperties]:
+    """Return a NICProperties for every network interface, ordered by interface index."""
+    arena = fetch_arena(_lib.get_network_info_arena, _lib, DEVICE_ARENA_KIND_LINUX_NIC, _NICRecord)
+    if arena is None:
+        raise RuntimeError("get_network_info_arena() failed")
+
+    records, strings = arena
+    return [
+        NICProperties(
+            interface=strings.get(raw.interface) or "",
+            link_type=strings.get(raw.link_type),
+            mac_address=strings.get(raw.mac_address),
+            ipv4_address=strings.get(raw.ipv4_address),
+            ipv6_address=strings.get(raw.ipv6_address),
+            device_slot=strings.get(raw.device_slot),
+            acpi_path=strings.get(raw.acpi_path),
+            pci_path=strings.get(raw.pci_path),
+            vendor_id=raw.vendor_id,
+            device_id=raw.device_id,
+            if_index=raw.if_index,
+        )
+        for raw in records
+    ]
+
+
+# ── quick self-test ──────────────────────────────────────────────────────────
+if __name__ == "__main__":
+    for nic in get_network_info():
+        print(nic)
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+#include "device_arena.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// One record describing the system's processors; strings live in the arena's string pool.
+typedef struct {
+    ArenaString machine;        // uname(2) machine, e.g. "x86_64", "aarch64"
+    ArenaString model_name;     // "model name" on x86; "Hardware", else "Model" on ARM
+    ArenaString vendor;         // "vendor_id", e.g. "GenuineIntel" (x86 only)
+    ArenaString arch_version;   // "CPU architecture" (ARM only)
+    ArenaString flags;          // "flags" on x86, "Features" on ARM, space-separated as in /proc/cpuinfo
+    int32_t threads;            // "processor" entries in /proc/cpuinfo
+    int32_t cores_per_package;  // "cpu cores" of the first processor, 0 if not reported
+    int32_t cores;              // distinct thread-sibling sets in sysfs topology, 0 if not available
+    int32_t reserved;
+} CPURecord;
+
+// Parses /proc/cpuinfo and the sysfs CPU topology into a DeviceArena holding one CPURecord
+// (kind DEVICE_ARENA_KIND_LINUX_CPU). On success `*out` must be released with device_arena_free().
+int get_cpu_info_arena(DeviceArena **out);
+
+#ifdef __cplusplus
+}
+#endif
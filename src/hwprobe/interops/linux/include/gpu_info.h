@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+#include "device_arena.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// One PCI display controller (class 0x03); strings live in the arena's string pool.
+typedef struct {
+    ArenaString slot;                   // PCI address, e.g. "0000:03:00.0"
+    ArenaString vendor_name;            // pci.ids names, as `lspci -vmm` reports them (Vendor)
+    ArenaString device_name;            // Device
+    ArenaString subsystem_vendor_name;  // SVendor
+    ArenaString subsystem_device_name;  // SDevice
+    ArenaString acpi_path;              // firmware_node/path, e.g. "\_SB_.PCI0.GFX0"
+    ArenaString pci_path;               // e.g. "PciRoot(0x0)/Pci(0x1,0x0)/Pci(0x0,0x0)"
+    uint32_t vendor_id;
+    uint32_t device_id;
+    uint32_t subsystem_vendor_id;
+    uint32_t subsystem_device_id;
+    int32_t pcie_width;                 // current_link_width, 0 if not reported
+    int32_t pcie_gen;                   // from current_link_speed, 0 if not reported
+    uint64_t vram_mb;                   // amdgpu mem_info_vram_total or NVML, 0 if not reported
+    ArenaString product_name;           // NVML name, e.g. "NVIDIA GeForce RTX 4090"; empty without NVML
+} GPURecord;
+
+// Enumerates every display controller under /sys/bus/pci/devices into a DeviceArena of GPURecord
+// (kind DEVICE_ARENA_KIND_LINUX_GPU). On success `*out` must be released with device_arena_free().
+int get_gpu_info_arena(DeviceArena **out);
+
+#ifdef __cplusplus
+}
+
+#include <string>
+#include <vector>
+
+namespace gpu_info {
+
+// PCI slots of every display controller, in get_gpu_info_arena() order.
+std::vector<std::string> ListSlots();
+
+// "16.0 GT/s PCIe" -> 4; 0 if the rate is not a known generation.
+int32_t PcieGeneration(const std::string &speed);
+
+} // namespace gpu_info
+
+#endif
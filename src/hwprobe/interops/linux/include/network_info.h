@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+#include "device_arena.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// One network interface from /sys/class/net; strings live in the arena's string pool.
+typedef struct {
+    ArenaString interface;     // e.g. "enp3s0"
+    ArenaString link_type;     // link type as `ip` names it: "ether", "loopback", "ieee802.11", ...
+    ArenaString mac_address;   // e.g. "00:1a:2b:3c:4d:5e"
+    ArenaString ipv4_address;  // first IPv4 address, empty if none
+    ArenaString ipv6_address;  // first IPv6 address, empty if none
+    ArenaString device_slot;   // name of the backing device, e.g. "0000:01:00.0"; empty for a virtual interface
+    ArenaString acpi_path;     // device/firmware_node/path
+    ArenaString pci_path;      // empty unless the backing device is a PCI function
+    uint32_t vendor_id;        // device/vendor, 0 if not reported
+    uint32_t device_id;        // device/device, 0 if not reported
+    uint32_t if_index;
+    uint32_t reserved;
+} NICRecord;
+
+// Enumerates every network interface, ordered by interface index, into a DeviceArena of NICRecord
+// (kind DEVICE_ARENA_KIND_LINUX_NIC). Addresses come from getifaddrs(). On success `*out` must be
+// released with device_arena_free().
+int get_network_info_arena(DeviceArena **out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Vendor and device names from the system's pci.ids database, the file lspci reads
+// (/usr/share/hwdata/pci.ids, /usr/share/misc/pci.ids, ...). The file is read and its vendor
+// lines indexed once per process; a lookup then only scans the device lines of one vendor.
+
+namespace pci_ids {
+
+// A name is empty if the database does not list the ID or no database is installed.
+struct Names {
+    std::string vendor;
+    std::string device;
+    std::string subsystem_vendor;
+    std::string subsystem_device;
+};
+
+Names Lookup(uint16_t vendor, uint16_t device, uint16_t subsystem_vendor, uint16_t subsystem_device);
+
+// Reads and indexes the database now rather than on the first Lookup().
+void Preload();
+
+} // namespace pci_ids
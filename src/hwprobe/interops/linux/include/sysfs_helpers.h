@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Reads sysfs / procfs attributes relative to directory descriptors instead of by absolute path.
+// The roots (/sys/bus/pci/devices, /sys/class/net, /proc, ...) are opened once per process and
+// kept open; a device directory is opened once per enumeration, and each of its attributes is
+// then one openat() + pread() with no path walk from "/".
+//
+// Every read is also a replay hook (device_replay.h): a Dir remembers its absolute path, and while
+// replaying it answers from the corpus by that path without touching the filesystem.
+
+namespace sysfs {
+
+// Owns an O_PATH directory descriptor.
+class Dir {
+public:
+    Dir() = default;
+    Dir(int fd, std::string path) : fd_(fd), path_(std::move(path)) {}
+    ~Dir();
+
+    Dir(const Dir &) = delete;
+    Dir &operator=(const Dir &) = delete;
+    Dir(Dir &&other) noexcept : fd_(other.fd_), path_(std::move(other.path_)) { other.fd_ = -1; }
+    Dir &operator=(Dir &&other) noexcept;
+
+    int fd() const { return fd_; }
+    const std::string &path() const { return path_; }
+
+    // Whether the directory exists (replaying: whether it existed when the corpus was recorded).
+    explicit operator bool() const;
+
+    // Directory `path` (relative to this one, symlinks followed). Invalid if it does not exist.
+    Dir Open(const char *path) const;
+
+    // Whole contents of the file `path`, read with pread() until EOF. False if it cannot be read.
+    bool ReadFile(const char *path, std::string &out) const;
+
+    // A sysfs attribute: the file's contents with trailing whitespace removed.
+    bool Read(const char *path, std::string &out) const;
+
+    // An integer attribute, hexadecimal with a 0x prefix ("0x10de") or decimal ("16").
+    bool ReadUInt(const char *path, uint64_t &out) const;
+
+    // Target of the symlink `path`, as stored (usually relative).
+    bool ReadLink(const char *path, std::string &out) const;
+
+    // Entry names, without "." and "..". Empty if the directory cannot be listed.
+    std::vector<std::string> List() const;
+
+private:
+    std::string Child(const char *path) const { return path_ + "/" + path; }
+
+    int fd_ = -1;
+    std::string path_;
+};
+
+// Process-wide descriptor of the absolute directory `path`, opened on first use and never closed.
+// Invalid if the directory does not exist (e.g. no PCI bus in a container).
+const Dir &Root(const char *path);
+
+// True for a PCI address in sysfs form, "dddd:bb:ss.f".
+bool IsPciSlot(std::string_view name);
+
+// Last component of a path.
+std::string_view BaseName(std::string_view path);
+
+// UEFI-style device path of a PCI device, e.g. "PciRoot(0x0)/Pci(0x1,0x0)/Pci(0x0,0x0)", from the
+// bridges on its /sys/bus/pci/devices/<slot> link. Empty if `slot` is not a PCI address.
+std::string PciPath(std::string_view slot);
+
+} // namespace sysfs
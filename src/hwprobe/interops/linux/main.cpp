@@ -0,0 +1,111 @@
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <string_view>
+#include <vector>
+#include "include/cpu_info.h"
+#include "include/gpu_info.h"
+#include "include/network_info.h"
+
+// Collects the arena returned by `query` (arena::Collect), then calls fn(index, record, str) for
+// every record; `str` resolves an ArenaString against the string pool.
+// Returns the number of records, or -1 if the query failed.
+template <typename Record, typename Fn>
+static int forEachRecord(int (*query)(DeviceArena **), Fn &&fn) {
+    std::vector<unsigned char> blob;
+    if (!arena::Collect(query, blob))
+        return -1;
+
+    DeviceArenaHeader header;
+    std::memcpy(&header, blob.data(), sizeof(header));
+    if (header.magic != DEVICE_ARENA_MAGIC || header.record_size != sizeof(Record))
+        return -1;
+
+    const char *pool = reinterpret_cast<const char *>(blob.data() + header.strings_offset);
+    auto str = [pool](ArenaString s) { return std::string_view(pool + s.offset, s.length); };
+
+    for (uint32_t i = 0; i < header.record_count; ++i) {
+        Record record;
+        std::memcpy(&record, blob.data() + header.records_offset + i * sizeof(Record), sizeof(Record));
+        fn(i, record, str);
+    }
+    return static_cast<int>(header.record_count);
+}
+
+static void printId(const char *label, uint32_t id) {
+    std::cout << label << "0x" << std::hex << std::setfill('0') << std::setw(4) << id
+              << std::dec << std::setfill(' ') << "\n";
+}
+
+int main() {
+    // ── CPU info ────────────────────────────────────────────────────────────
+    std::cout << "CPU:\n\n";
+    const int cpuCount = forEachRecord<CPURecord>(get_cpu_info_arena, [](uint32_t, const CPURecord &c, auto str) {
+        std::cout << "  Name:         " << str(c.model_name) << "\n";
+        std::cout << "  Machine:      " << str(c.machine) << "\n";
+        if (c.vendor.length)
+            std::cout << "  Vendor:       " << str(c.vendor) << "\n";
+        if (c.arch_version.length)
+            std::cout << "  Architecture: " << str(c.arch_version) << "\n";
+        std::cout << "  Cores:        " << c.cores << "\n";
+        std::cout << "  Threads:      " << c.threads << "\n";
+        std::cout << "\n";
+    });
+
+    if (cpuCount < 0)
+        std::cerr << "Failed to read /proc/cpuinfo.\n\n";
+
+    // ── GPU info ────────────────────────────────────────────────────────────
+    std::cout << "GPU(s):\n\n";
+    const int gpuCount = forEachRecord<GPURecord>(get_gpu_info_arena, [](uint32_t i, const GPURecord &g, auto str) {
+        std::cout << "GPU " << i << " (" << str(g.slot) << "):\n";
+        if (g.device_name.length)
+            std::cout << "  Name:         " << str(g.device_name) << "\n";
+        if (g.vendor_name.length)
+            std::cout << "  Manufacturer: " << str(g.vendor_name) << "\n";
+        printId("  Vendor ID:    ", g.vendor_id);
+        printId("  Device ID:    ", g.device_id);
+        if (g.pcie_width > 0)
+            std::cout << "  PCIe:         Gen " << g.pcie_gen << " x" << g.pcie_width << "\n";
+        if (g.acpi_path.length)
+            std::cout << "  ACPI Path:    " << str(g.acpi_path) << "\n";
+        if (g.pci_path.length)
+            std::cout << "  PCI Path:     " << str(g.pci_path) << "\n";
+        if (g.vram_mb > 0)
+            std::cout << "  VRAM:         " << g.vram_mb << " MB\n";
+        std::cout << "\n";
+    });
+
+    if (gpuCount < 0)
+        std::cerr << "Failed to retrieve GPU info.\n";
+    else
+        std::cout << "Found " << gpuCount << " GPU(s).\n\n";
+
+    // ── Network info ────────────────────────────────────────────────────────
+    std::cout << "Network interface(s):\n\n";
+    const int nicCount = forEachRecord<NICRecord>(
+        get_network_info_arena, [](uint32_t, const NICRecord &n, auto str) {
+            std::cout << str(n.interface) << " (" << str(n.link_type) << "):\n";
+            if (n.mac_address.length)
+                std::cout << "  MAC:          " << str(n.mac_address) << "\n";
+            if (n.ipv4_address.length)
+                std::cout << "  IPv4:         " << str(n.ipv4_address) << "\n";
+            if (n.ipv6_address.length)
+                std::cout << "  IPv6:         " << str(n.ipv6_address) << "\n";
+            if (n.device_slot.length) {
+                std::cout << "  Device:       " << str(n.device_slot) << "\n";
+                printId("  Vendor ID:    ", n.vendor_id);
+                printId("  Device ID:    ", n.device_id);
+            }
+            if (n.pci_path.length)
+                std::cout << "  PCI Path:     " << str(n.pci_path) << "\n";
+            std::cout << "\n";
+        });
+
+    if (nicCount < 0)
+        std::cerr << "Failed to retrieve network info.\n";
+    else
+        std::cout << "Found " << nicCount << " network interface(s).\n";
+
+    return (cpuCount < 0 && gpuCount < 0 && nicCount < 0) ? 1 : 0;
+}
@@ -0,0 +1,145 @@
+#include "cpu_info.h"
+#include "sysfs_helpers.h"
+#include "bench_stages.h"
+
+#include <cctype>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+#include <sys/utsname.h>
+
+// ---- Internal helpers ----
+
+namespace {
+
+std::string_view Trim(std::string_view text) {
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) text.remove_prefix(1);
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) text.remove_suffix(1);
+    return text;
+}
+
+// First value of each field we report, plus the processor count. Every field of the first
+// processor comes before the second one's, so "first value" is "value of processor 0".
+struct CpuInfoFields {
+    std::string_view model_name;
+    std::string_view hardware;
+    std::string_view model;
+    std::string_view vendor;
+    std::string_view arch_version;
+    std::string_view flags;
+    std::string_view features;
+    std::string_view cpu_cores;
+    int processors = 0;
+};
+
+void ParseCpuInfo(std::string_view text, CpuInfoFields &fields) {
+    const struct {
+        std::string_view key;
+        std::string_view CpuInfoFields::*field;
+    } keys[] = {
+        {"model name", &CpuInfoFields::model_name},
+        {"Hardware", &CpuInfoFields::hardware},
+        {"Model", &CpuInfoFields::model},
+        {"vendor_id", &CpuInfoFields::vendor},
+        {"CPU architecture", &CpuInfoFields::arch_version},
+        {"flags", &CpuInfoFields::flags},
+        {"Features", &CpuInfoFields::features},
+        {"cpu cores", &CpuInfoFields::cpu_cores},
+    };
+
+    while (!text.empty()) {
+        const size_t end = text.find('\n');
+        const std::string_view line = text.substr(0, end);
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+        const size_t colon = line.find(':');
+        if (colon == std::string_view::npos) continue;
+        const std::string_view key = Trim(line.substr(0, colon));
+        const std::string_view value = Trim(line.substr(colon + 1));
+
+        if (key == "processor") {
+            ++fields.processors;
+            continue;
+        }
+        for (const auto &entry : keys) {
+            std::string_view &slot = fields.*entry.field;
+            if (key == entry.key && slot.empty()) slot = value;
+        }
+    }
+}
+
+int ParseInt(std::string_view text) {
+    int value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') return 0;
+        value = value * 10 + (c - '0');
+    }
+    return value;
+}
+
+// "cpu<N>", as opposed to cpufreq/, cpuidle/, online, ...
+bool IsCpuDirectory(std::string_view name) {
+    if (name.size() < 4 || name.substr(0, 3) != "cpu") return false;
+    for (char c : name.substr(3))
+        if (c < '0' || c > '9') return false;
+    return true;
+}
+
+// Physical cores: one per distinct thread_siblings_list, the set of logical CPUs sharing a core.
+// Unlike core_id this is unique across packages and clusters.
+int CountCores() {
+    DEVICE_INFO_STAGE("CountCores");
+    const sysfs::Dir &cpus = sysfs::Root("/sys/devices/system/cpu");
+    std::unordered_set<std::string> cores;
+    std::string siblings;
+    for (const std::string &name : cpus.List()) {
+        if (!IsCpuDirectory(name)) continue;
+        if (cpus.Read((name + "/topology/thread_siblings_list").c_str(), siblings) && !siblings.empty())
+            cores.insert(siblings);
+    }
+    return static_cast<int>(cores.size());
+}
+
+} // namespace
+
+// ---- Exports ----
+
+int get_cpu_info_arena(DeviceArena **out) {
+    if (!out) return DEVICE_ARENA_STATUS_INVALID_ARG;
+    *out = nullptr;
+
+    std::string cpuinfo;
+    {
+        DEVICE_INFO_STAGE("/proc/cpuinfo");
+        if (!sysfs::Root("/proc").ReadFile("cpuinfo", cpuinfo) || cpuinfo.empty())
+            return DEVICE_ARENA_STATUS_FAILURE;
+    }
+
+    CpuInfoFields fields;
+    ParseCpuInfo(cpuinfo, fields);
+
+    utsname system{};
+    const std::string machine = uname(&system) == 0 ? system.machine : "";
+    const bool is_arm = machine.find("aarch64") != std::string::npos || machine.find("arm") != std::string::npos;
+
+    arena::Builder builder(DEVICE_ARENA_KIND_LINUX_CPU, sizeof(CPURecord));
+    CPURecord record{};
+    record.machine = builder.Intern(machine);
+    if (is_arm) {
+        record.model_name = builder.Intern(!fields.hardware.empty() ? fields.hardware : fields.model);
+        record.arch_version = builder.Intern(fields.arch_version);
+        record.flags = builder.Intern(fields.features);
+    } else {
+        record.model_name = builder.Intern(fields.model_name);
+        record.vendor = builder.Intern(fields.vendor);
+        record.flags = builder.Intern(fields.flags);
+    }
+    record.threads = fields.processors;
+    record.cores_per_package = ParseInt(fields.cpu_cores);
+    record.cores = CountCores();
+    builder.Append(&record);
+
+    *out = builder.Finish();
+    return *out ? DEVICE_ARENA_STATUS_OK : DEVICE_ARENA_STATUS_FAILURE;
+}
@@ -0,0 +1,197 @@
+#include "cpu_topology.h"
+#include "sysfs_helpers.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <sys/auxv.h>
+
+// ---- Linux backend: /sys/devices/system/cpu/cpu<N>/{topology,cache} ----
+
+namespace {
+
+// "cpu<N>", as opposed to cpufreq/, cpuidle/, online, ...
+bool IsNumbered(std::string_view name, std::string_view prefix, uint32_t &number) {
+    if (name.size() <= prefix.size() || name.substr(0, prefix.size()) != prefix) return false;
+    number = 0;
+    for (char c : name.substr(prefix.size())) {
+        if (c < '0' || c > '9') return false;
+        number = number * 10 + static_cast<uint32_t>(c - '0');
+    }
+    return true;
+}
+
+// "0-3,8,10-11" -> {0, 1, 2, 3, 8, 10, 11}
+std::vector<uint32_t> ParseCpuList(std::string_view text) {
+    std::vector<uint32_t> cpus;
+    while (!text.empty()) {
+        const size_t comma = text.find(',');
+        const std::string_view range = text.substr(0, comma);
+        text.remove_prefix(comma == std::string_view::npos ? text.size() : comma + 1);
+
+        const size_t dash = range.find('-');
+        uint32_t first = 0, last = 0;
+        for (char c : range.substr(0, dash))
+            if (c >= '0' && c <= '9') first = first * 10 + static_cast<uint32_t>(c - '0');
+        if (dash == std::string_view::npos) last = first;
+        else
+            for (char c : range.substr(dash + 1))
+                if (c >= '0' && c <= '9') last = last * 10 + static_cast<uint32_t>(c - '0');
+        for (uint32_t cpu = first; cpu <= last && !range.empty(); ++cpu) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+// cache/index<N>/size: "48K", "2048K", "32M"
+uint64_t ParseSize(std::string_view text) {
+    uint64_t value = 0;
+    size_t i = 0;
+    for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i) value = value * 10 + (text[i] - '0');
+    if (i < text.size()) {
+        if (text[i] == 'K') value <<= 10;
+        else if (text[i] == 'M') value <<= 20;
+        else if (text[i] == 'G') value <<= 30;
+    }
+    return value;
+}
+
+uint32_t CacheType(const std::string &type) {
+    if (type == "Data") return CPU_CACHE_DATA;
+    if (type == "Instruction") return CPU_CACHE_INSTRUCTION;
+    return CPU_CACHE_UNIFIED;
+}
+
+// Hybrid Intel parts register one PMU per core type, each listing its CPUs; elsewhere (ARM
+// big.LITTLE, DynamIQ) the scheduler's cpu_capacity ranks the cores, 1024 being the biggest.
+// Either way the slowest kind ends up as class 0.
+void AssignEfficiencyClasses(const sysfs::Dir &cpus, std::vector<cpu_topology::Processor> &processors) {
+    std::string list;
+    const sysfs::Dir &devices = sysfs::Root("/sys/devices");
+    if (devices.Read("cpu_atom/cpus", list)) {
+        std::set<uint32_t> atoms;
+        for (uint32_t cpu : ParseCpuList(list)) atoms.insert(cpu);
+        for (auto &p : processors) p.efficiency_class = atoms.count(p.id) ? 0 : 1;
+        return;
+    }
+
+    std::map<uint32_t, uint64_t> capacity;
+    std::set<uint64_t> capacities;
+    for (const auto &p : processors) {
+        uint64_t value = 0;
+        if (!cpus.ReadUInt(("cpu" + std::to_string(p.id) + "/cpu_capacity").c_str(), value)) return;
+        capacity[p.id] = value;
+        capacities.insert(value);
+    }
+    for (auto &p : processors)
+        p.efficiency_class = static_cast<uint32_t>(std::distance(capacities.begin(), capacities.find(capacity[p.id])));
+}
+
+// One Cache per distinct (level, type, shared_cpu_list); the attributes of an instance are
+// read once, by the first CPU that lists it.
+void ReadCaches(const sysfs::Dir &cpus, const std::vector<cpu_topology::Processor> &processors,
+                std::vector<cpu_topology::Cache> &out) {
+    std::set<std::tuple<uint64_t, std::string, std::string>> seen;
+    std::string text, type, shared;
+    for (const auto &p : processors) {
+        const sysfs::Dir cache = cpus.Open(("cpu" + std::to_string(p.id) + "/cache").c_str());
+        if (!cache) continue;
+
+        for (const std::string &name : cache.List()) {
+            uint32_t index = 0;
+            if (!IsNumbered(name, "index", index)) continue;
+            const sysfs::Dir entry = cache.Open(name.c_str());
+            uint64_t level = 0;
+            if (!entry || !entry.ReadUInt("level", level) || !entry.Read("shared_cpu_list", shared)) continue;
+            entry.Read("type", type);
+            if (!seen.emplace(level, type, shared).second) continue;
+
+            cpu_topology::Cache instance;
+            instance.level = static_cast<uint32_t>(level);
+            instance.type = CacheType(type);
+            instance.cpus = ParseCpuList(shared);
+            uint64_t value = 0;
+            if (entry.Read("size", text)) instance.size_bytes = ParseSize(text);
+            if (entry.ReadUInt("coherency_line_size", value)) instance.line_size = static_cast<uint32_t>(value);
+            if (entry.ReadUInt("ways_of_associativity", value)) instance.associativity = static_cast<uint32_t>(value);
+            out.push_back(std::move(instance));
+        }
+    }
+}
+
+void ReadArmFeatures(uint64_t &features) {
+#if defined(__aarch64__)
+    // HWCAP_* / HWCAP2_* of arch/arm64/include/uapi/asm/hwcap.h
+    const unsigned long hwcap = getauxval(AT_HWCAP);
+    const unsigned long hwcap2 = getauxval(AT_HWCAP2);
+    const struct {
+        unsigned long caps;
+        unsigned long bit;
+        uint64_t feature;
+    } map[] = {
+        {hwcap, 1ul << 1, CPU_FEATURE_NEON},      // ASIMD
+        {hwcap, 1ul << 3, CPU_FEATURE_ARM_AES},
+        {hwcap, 1ul << 6, CPU_FEATURE_ARM_SHA2},
+        {hwcap, 1ul << 7, CPU_FEATURE_CRC32},
+        {hwcap, 1ul << 8, CPU_FEATURE_LSE},       // ATOMICS
+        {hwcap, 1ul << 10, CPU_FEATURE_FP16},     // ASIMDHP
+        {hwcap, 1ul << 20, CPU_FEATURE_DOTPROD},  // ASIMDDP
+        {hwcap, 1ul << 22, CPU_FEATURE_SVE},
+        {hwcap2, 1ul << 1, CPU_FEATURE_SVE2},
+        {hwcap2, 1ul << 13, CPU_FEATURE_I8MM},
+        {hwcap2, 1ul << 14, CPU_FEATURE_BF16},
+        {hwcap2, 1ul << 23, CPU_FEATURE_SME},
+        {hwcap2, 1ul << 37, CPU_FEATURE_SME2},
+    };
+    for (const auto &entry : map)
+        if (entry.caps & entry.bit) features |= entry.feature;
+#elif defined(__arm__)
+    if (getauxval(AT_HWCAP) & (1ul << 12)) features |= CPU_FEATURE_NEON;  // HWCAP_NEON
+#else
+    (void)features;
+#endif
+}
+
+} // namespace
+
+namespace cpu_topology {
+
+bool PlatformTopology(Topology &out) {
+    const sysfs::Dir &cpus = sysfs::Root("/sys/devices/system/cpu");
+    if (!cpus) return false;
+
+    // Physical cores: one per distinct thread_siblings_list, unique across packages and clusters
+    // (unlike core_id). Offline CPUs have no topology directory and are left out.
+    std::map<std::string, uint32_t> cores;
+    std::string siblings;
+    for (const std::string &name : cpus.List()) {
+        uint32_t id = 0;
+        if (!IsNumbered(name, "cpu", id)) continue;
+        const sysfs::Dir topology = cpus.Open((name + "/topology").c_str());
+        if (!topology || !topology.Read("thread_siblings_list", siblings) || siblings.empty()) continue;
+
+        Processor p;
+        p.id = id;
+        p.core = cores.emplace(siblings, static_cast<uint32_t>(cores.size())).first->second;
+        uint64_t package = 0;
+        if (topology.ReadUInt("physical_package_id", package)) p.package = static_cast<uint32_t>(package);
+        out.processors.push_back(p);
+    }
+    if (out.processors.empty()) return false;
+
+    AssignEfficiencyClasses(cpus, out.processors);
+    ReadCaches(cpus, out.processors, out.caches);
+    ReadArmFeatures(out.features);
+
+    for (const std::string &name : sysfs::Root("/sys/devices/system/node").List()) {
+        uint32_t node = 0;
+        if (IsNumbered(name, "node", node)) ++out.numa_nodes;
+    }
+    return true;
+}
+
+} // namespace cpu_topology
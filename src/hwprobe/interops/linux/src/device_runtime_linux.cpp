@@ -0,0 +1,23 @@
+#include "device_runtime.h"
+#include "pci_ids.h"
+#include "smbios.h"
+#include "sysfs_helpers.h"
+
+// ---- Linux backend: open the sysfs roots and index pci.ids up front ----
+//
+// All of it would otherwise happen on the first probe that needs it, under the same locks; none
+// of it is released by shutdown, since later probes keep using it either way.
+
+namespace runtime {
+
+bool PlatformInit() {
+    for (const char *root : {"/sys/bus/pci/devices", "/sys/class/drm", "/sys/class/net", "/sys/devices/system/cpu"})
+        sysfs::Root(root);
+    pci_ids::Preload();
+    smbios::Current();
+    return true;
+}
+
+void PlatformShutdown() {}
+
+} // namespace runtime
@@ -0,0 +1,111 @@
+#include "device_snapshot.h"
+#include "cpu_info.h"
+#include "edid.h"
+#include "gpu_info.h"
+#include "sysfs_helpers.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// ---- Linux snapshot key and file I/O ----
+//
+// Network interfaces are left out: their addresses change within a boot, so a snapshot would
+// serve stale ones.
+
+namespace snapshot {
+
+namespace {
+
+void AddSorted(std::vector<std::string> names, Fingerprint &fingerprint) {
+    std::sort(names.begin(), names.end());
+    for (const std::string &name : names) fingerprint.Add(name.data(), name.size() + 1);
+}
+
+} // namespace
+
+bool PlatformKey(DeviceSnapshotKey &key) {
+    // A random UUID the kernel draws on every boot.
+    std::string bootId;
+    if (!sysfs::Root("/proc/sys/kernel/random").Read("boot_id", bootId)) return false;
+    std::snprintf(key.boot_id, sizeof(key.boot_id), "%s", bootId.c_str());
+
+    // Every PCI function, the online CPUs, and every DRM connector with its status: adding or
+    // removing a card, taking a CPU offline or plugging a monitor changes it.
+    Fingerprint fingerprint;
+    AddSorted(sysfs::Root("/sys/bus/pci/devices").List(), fingerprint);
+
+    std::string online;
+    if (sysfs::Root("/sys/devices/system/cpu").Read("online", online)) fingerprint.Add(online.data(), online.size());
+
+    const sysfs::Dir &drm = sysfs::Root("/sys/class/drm");
+    std::vector<std::string> connectors;
+    for (const std::string &name : drm.List()) {
+        if (name.find('-') == std::string::npos) continue;  // card0, renderD128
+        std::string status;
+        drm.Read((name + "/status").c_str(), status);
+        connectors.push_back(name + "=" + status);
+    }
+    AddSorted(std::move(connectors), fingerprint);
+
+    key.hardware_fingerprint = fingerprint.value();
+    return true;
+}
+
+std::vector<ArenaQuery> PlatformQueries() {
+    return {get_cpu_info_arena, get_gpu_info_arena, get_edid_info_arena};
+}
+
+std::vector<RecordSchema> PlatformSchemas() {
+    return {
+        {DEVICE_ARENA_KIND_LINUX_CPU,
+         {SNAPSHOT_FIELD(CPURecord, machine, String), SNAPSHOT_FIELD(CPURecord, model_name, String),
+          SNAPSHOT_FIELD(CPURecord, vendor, String), SNAPSHOT_FIELD(CPURecord, arch_version, String),
+          SNAPSHOT_FIELD(CPURecord, flags, String), SNAPSHOT_FIELD(CPURecord, threads, I32),
+          SNAPSHOT_FIELD(CPURecord, cores_per_package, I32), SNAPSHOT_FIELD(CPURecord, cores, I32)},
+         {}},
+        {DEVICE_ARENA_KIND_LINUX_GPU,
+         {SNAPSHOT_FIELD(GPURecord, slot, String), SNAPSHOT_FIELD(GPURecord, vendor_name, String),
+          SNAPSHOT_FIELD(GPURecord, device_name, String), SNAPSHOT_FIELD(GPURecord, subsystem_vendor_name, String),
+          SNAPSHOT_FIELD(GPURecord, subsystem_device_name, String), SNAPSHOT_FIELD(GPURecord, acpi_path, String),
+          SNAPSHOT_FIELD(GPURecord, pci_path, String), SNAPSHOT_FIELD(GPURecord, vendor_id, U32),
+          SNAPSHOT_FIELD(GPURecord, device_id, U32), SNAPSHOT_FIELD(GPURecord, subsystem_vendor_id, U32),
+          SNAPSHOT_FIELD(GPURecord, subsystem_device_id, U32), SNAPSHOT_FIELD(GPURecord, pcie_width, I32),
+          SNAPSHOT_FIELD(GPURecord, pcie_gen, I32), SNAPSHOT_FIELD(GPURecord, vram_mb, U64),
+          SNAPSHOT_FIELD(GPURecord, product_name, String)},
+         {"pci_path", "slot"}},
+        {DEVICE_ARENA_KIND_EDID,
+         {SNAPSHOT_FIELD(EDIDRecord, device_path, String), SNAPSHOT_FIELD(EDIDRecord, name, String),
+          SNAPSHOT_FIELD(EDIDRecord, serial_text, String), SNAPSHOT_FIELD(EDIDRecord, manufacturer_code, String),
+          SNAPSHOT_FIELD(EDIDRecord, acpi_path, String), SNAPSHOT_FIELD(EDIDRecord, pci_path, String),
+          SNAPSHOT_FIELD(EDIDRecord, hash, U64), SNAPSHOT_FIELD(EDIDRecord, vendor_id, U32),
+          SNAPSHOT_FIELD(EDIDRecord, product_id, U32), SNAPSHOT_FIELD(EDIDRecord, serial_number, U32),
+          SNAPSHOT_FIELD(EDIDRecord, size, U32), SNAPSHOT_FIELD(EDIDRecord, year, U16),
+          SNAPSHOT_FIELD(EDIDRecord, version, U8), SNAPSHOT_FIELD(EDIDRecord, revision, U8),
+          SNAPSHOT_FIELD(EDIDRecord, extension_count, U8), SNAPSHOT_FIELD(EDIDRecord, interface, U8),
+          SNAPSHOT_FIELD(EDIDRecord, bit_depth, U8), SNAPSHOT_FIELD(EDIDRecord, flags, U8),
+          SNAPSHOT_FIELD(EDIDRecord, width_cm, U16), SNAPSHOT_FIELD(EDIDRecord, height_cm, U16),
+          SNAPSHOT_FIELD(EDIDRecord, preferred_width, U32), SNAPSHOT_FIELD(EDIDRecord, preferred_height, U32),
+          SNAPSHOT_FIELD(EDIDRecord, preferred_refresh_mhz, U32), SNAPSHOT_FIELD(EDIDRecord, max_width, U32),
+          SNAPSHOT_FIELD(EDIDRecord, max_height, U32), SNAPSHOT_FIELD(EDIDRecord, max_refresh_mhz, U32)},
+         // The connector: a different monitor on the same port shows as changed fields
+         {"device_path"}},
+    };
+}
+
+bool PlatformWriteAtomically(const std::string &path, const std::vector<unsigned char> &data) {
+    const std::string temp = path + ".tmp";
+    FILE *file = std::fopen(temp.c_str(), "wb");
+    if (!file) return false;
+
+    bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::remove(temp.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace snapshot
@@ -0,0 +1,54 @@
+#include "edid.h"
+#include "sysfs_helpers.h"
+
+#include <algorithm>
+#include <string>
+
+// ---- Linux backend: DRM connectors under /sys/class/drm ----
+
+namespace {
+
+// "card0-HDMI-A-1", as opposed to the "card0" device itself or "renderD128", "version", ...
+bool IsConnector(const std::string &name) {
+    if (name.compare(0, 4, "card") != 0) return false;
+    size_t i = 4;
+    while (i < name.size() && name[i] >= '0' && name[i] <= '9') ++i;
+    return i > 4 && i < name.size() && name[i] == '-';
+}
+
+} // namespace
+
+namespace edid {
+
+bool PlatformMonitors(std::vector<Monitor> &out) {
+    const sysfs::Dir &drm = sysfs::Root("/sys/class/drm");
+    if (!drm) return false;
+
+    std::vector<std::string> connectors = drm.List();
+    connectors.erase(std::remove_if(connectors.begin(), connectors.end(),
+                                    [](const std::string &name) { return !IsConnector(name); }),
+                     connectors.end());
+    std::sort(connectors.begin(), connectors.end());
+
+    std::string text;
+    for (const std::string &name : connectors) {
+        const sysfs::Dir connector = drm.Open(name.c_str());
+        if (!connector) continue;
+
+        Monitor monitor;
+        if (connector.ReadFile("edid", text)) monitor.data.assign(text.begin(), text.end());
+        // The edid attribute is empty while nothing is plugged in
+        if (monitor.data.empty() && !(connector.Read("status", text) && text == "connected")) continue;
+
+        monitor.device_path = name;
+        if (connector.Read("firmware_node/path", text)) monitor.acpi_path = text;
+
+        // connector/device is the DRM card; its own device link names the GPU's PCI function
+        const sysfs::Dir card = connector.Open("device");
+        if (card.ReadLink("device", text)) monitor.pci_path = sysfs::PciPath(sysfs::BaseName(text));
+        out.push_back(std::move(monitor));
+    }
+    return true;
+}
+
+} // namespace edid
@@ -0,0 +1,178 @@
+#include "gpu_info.h"
+#include "nvml_loader.h"
+#include "pci_ids.h"
+#include "sysfs_helpers.h"
+#include "bench_stages.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// ---- Internal helpers ----
+
+namespace {
+
+struct GpuEntry {
+    std::string slot;
+    pci_ids::Names names;
+    std::string acpi_path;
+    std::string pci_path;
+    std::string product_name;
+    uint32_t vendor_id = 0;
+    uint32_t device_id = 0;
+    uint32_t subsystem_vendor_id = 0;
+    uint32_t subsystem_device_id = 0;
+    int32_t pcie_width = 0;
+    int32_t pcie_gen = 0;
+    uint64_t vram_mb = 0;
+};
+
+constexpr uint32_t kVendorAmd = 0x1002;
+constexpr uint32_t kVendorNvidia = 0x10DE;
+
+uint32_t ReadId(const sysfs::Dir &device, const char *name) {
+    uint64_t value = 0;
+    return device.ReadUInt(name, value) ? static_cast<uint32_t>(value) : 0;
+}
+
+// amdgpu reports dedicated VRAM in bytes under its DRM card: drm/card<N>/device/mem_info_vram_total.
+uint64_t AmdVramMB(const sysfs::Dir &device) {
+    const sysfs::Dir drm = device.Open("drm");
+    for (const std::string &card : drm.List()) {
+        if (card.compare(0, 4, "card") != 0 || card.find('-') != std::string::npos) continue;
+        uint64_t bytes = 0;
+        if (drm.ReadUInt((card + "/device/mem_info_vram_total").c_str(), bytes))
+            return bytes / (1024 * 1024);
+    }
+    return 0;
+}
+
+// The proprietary driver exposes no VRAM size in sysfs; NVML has it, along with the marketing name.
+// One NVML pass serves every NVIDIA GPU. Without NVML the sysfs attributes are all there is.
+void AddNvmlInfo(std::vector<GpuEntry> &gpus) {
+    std::vector<nvml::Device> devices;
+    if (!nvml::QueryDevices(devices)) return;
+
+    for (GpuEntry &entry : gpus) {
+        unsigned domain = 0, bus = 0, slot = 0, function = 0;
+        if (entry.vendor_id != kVendorNvidia ||
+            std::sscanf(entry.slot.c_str(), "%x:%x:%x.%x", &domain, &bus, &slot, &function) != 4)
+            continue;
+        const nvml::Device *device = nvml::Find(devices, domain, bus, slot, function);
+        if (!device) continue;
+
+        entry.product_name = device->name;
+        if (!entry.vram_mb) entry.vram_mb = device->memory_total_bytes / (1024 * 1024);
+        if (!entry.pcie_width) entry.pcie_width = device->pcie_width;
+        if (!entry.pcie_gen) entry.pcie_gen = device->pcie_gen;
+    }
+}
+
+bool CollectGpus(std::vector<GpuEntry> &gpus) {
+    DEVICE_INFO_STAGE("collectGpus");
+    const sysfs::Dir &devices = sysfs::Root("/sys/bus/pci/devices");
+    if (!devices) return false;
+
+    std::string text;
+    for (std::string &slot : gpu_info::ListSlots()) {
+        // One directory descriptor per device; every attribute below is read relative to it
+        const sysfs::Dir device = devices.Open(slot.c_str());
+        if (!device) continue;
+
+        GpuEntry entry;
+        entry.vendor_id = ReadId(device, "vendor");
+        entry.device_id = ReadId(device, "device");
+        entry.subsystem_vendor_id = ReadId(device, "subsystem_vendor");
+        entry.subsystem_device_id = ReadId(device, "subsystem_device");
+
+        uint64_t width = 0;
+        if (device.ReadUInt("current_link_width", width)) entry.pcie_width = static_cast<int32_t>(width);
+        if (device.Read("current_link_speed", text)) entry.pcie_gen = gpu_info::PcieGeneration(text);
+        if (device.Read("firmware_node/path", text)) entry.acpi_path = text;
+        entry.pci_path = sysfs::PciPath(slot);
+        entry.slot = std::move(slot);
+
+        if (entry.vendor_id == kVendorAmd) entry.vram_mb = AmdVramMB(device);
+
+        {
+            DEVICE_INFO_STAGE("pci_ids::Lookup");
+            entry.names = pci_ids::Lookup(static_cast<uint16_t>(entry.vendor_id),
+                                          static_cast<uint16_t>(entry.device_id),
+                                          static_cast<uint16_t>(entry.subsystem_vendor_id),
+                                          static_cast<uint16_t>(entry.subsystem_device_id));
+        }
+        gpus.push_back(std::move(entry));
+    }
+
+    const bool any_nvidia = std::any_of(gpus.begin(), gpus.end(),
+                                        [](const GpuEntry &entry) { return entry.vendor_id == kVendorNvidia; });
+    if (any_nvidia) AddNvmlInfo(gpus);
+    return true;
+}
+
+} // namespace
+
+namespace gpu_info {
+
+std::vector<std::string> ListSlots() {
+    std::vector<std::string> slots;
+    const sysfs::Dir &devices = sysfs::Root("/sys/bus/pci/devices");
+    for (std::string &slot : devices.List()) {
+        uint64_t device_class = 0;
+        const sysfs::Dir device = devices.Open(slot.c_str());
+        if (device && device.ReadUInt("class", device_class) && (device_class >> 16) == 0x03)
+            slots.push_back(std::move(slot));
+    }
+    std::sort(slots.begin(), slots.end());
+    return slots;
+}
+
+int32_t PcieGeneration(const std::string &speed) {
+    const double rate = std::strtod(speed.c_str(), nullptr);
+    const struct {
+        double rate;
+        int32_t generation;
+    } generations[] = {{2.5, 1}, {5.0, 2}, {8.0, 3}, {16.0, 4}, {32.0, 5}, {64.0, 6}};
+    for (const auto &entry : generations)
+        if (rate == entry.rate) return entry.generation;
+    return 0;
+}
+
+} // namespace gpu_info
+
+// ---- Exports ----
+
+int get_gpu_info_arena(DeviceArena **out) {
+    if (!out) return DEVICE_ARENA_STATUS_INVALID_ARG;
+    *out = nullptr;
+
+    std::vector<GpuEntry> gpus;
+    if (!CollectGpus(gpus))
+        return DEVICE_ARENA_STATUS_FAILURE;
+
+    arena::Builder builder(DEVICE_ARENA_KIND_LINUX_GPU, sizeof(GPURecord));
+    for (const GpuEntry &entry : gpus) {
+        GPURecord record{};
+        record.slot = builder.Intern(entry.slot);
+        record.vendor_name = builder.Intern(entry.names.vendor);
+        record.device_name = builder.Intern(entry.names.device);
+        record.subsystem_vendor_name = builder.Intern(entry.names.subsystem_vendor);
+        record.subsystem_device_name = builder.Intern(entry.names.subsystem_device);
+        record.acpi_path = builder.Intern(entry.acpi_path);
+        record.pci_path = builder.Intern(entry.pci_path);
+        record.product_name = builder.Intern(entry.product_name);
+        record.vendor_id = entry.vendor_id;
+        record.device_id = entry.device_id;
+        record.subsystem_vendor_id = entry.subsystem_vendor_id;
+        record.subsystem_device_id = entry.subsystem_device_id;
+        record.pcie_width = entry.pcie_width;
+        record.pcie_gen = entry.pcie_gen;
+        record.vram_mb = entry.vram_mb;
+        builder.Append(&record);
+    }
+
+    *out = builder.Finish();
+    return *out ? DEVICE_ARENA_STATUS_OK : DEVICE_ARENA_STATUS_FAILURE;
+}
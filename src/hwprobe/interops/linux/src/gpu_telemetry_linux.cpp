@@ -0,0 +1,91 @@
+#include "gpu_telemetry.h"
+#include "gpu_info.h"
+#include "sysfs_helpers.h"
+
+#include <string>
+#include <vector>
+
+// ---- Linux backend: PCI link of every display controller, amdgpu counters where present ----
+
+namespace {
+
+constexpr uint32_t kVendorAmd = 0x1002;
+
+struct Gpu {
+    uint32_t index = 0;
+    sysfs::Dir device;  // /sys/bus/pci/devices/<slot>, kept open while sampling
+    bool amdgpu = false;
+};
+
+std::vector<Gpu> g_gpus;
+
+} // namespace
+
+namespace gpu_telemetry {
+
+bool PlatformOpen() {
+    const sysfs::Dir &devices = sysfs::Root("/sys/bus/pci/devices");
+    if (!devices) return false;
+
+    g_gpus.clear();
+    std::string driver;
+    uint32_t index = 0;
+    for (const std::string &slot : gpu_info::ListSlots()) {
+        Gpu gpu;
+        gpu.index = index++;
+        gpu.device = devices.Open(slot.c_str());
+        if (!gpu.device) continue;
+
+        uint64_t vendor = 0;
+        gpu.amdgpu = gpu.device.ReadUInt("vendor", vendor) && vendor == kVendorAmd &&
+                     gpu.device.ReadLink("driver", driver) && sysfs::BaseName(driver) == "amdgpu";
+        g_gpus.push_back(std::move(gpu));
+    }
+    return !g_gpus.empty();
+}
+
+void PlatformSample() {
+    std::string text;
+    for (const Gpu &gpu : g_gpus) {
+        GpuTelemetrySample sample = {};
+        sample.gpu_index = gpu.index;
+        sample.timestamp_ns = NowNs();
+
+        uint64_t value = 0;
+        if (gpu.device.ReadUInt("current_link_width", value)) {
+            sample.pcie_width = static_cast<int32_t>(value);
+            if (gpu.device.Read("current_link_speed", text)) sample.pcie_gen = gpu_info::PcieGeneration(text);
+            sample.fields |= GPU_TELEMETRY_FIELD_PCIE_LINK;
+        }
+
+        // Older kernels resume a runtime-suspended GPU to answer the amdgpu counters; an idle
+        // laptop dGPU is reported idle instead of being woken up every interval.
+        if (gpu.amdgpu && gpu.device.Read("power/runtime_status", text) && text == "suspended") {
+            sample.fields |= GPU_TELEMETRY_FIELD_UTILIZATION;
+        } else if (gpu.amdgpu) {
+            if (gpu.device.ReadUInt("gpu_busy_percent", value)) {
+                sample.utilization_percent = static_cast<uint32_t>(value);
+                sample.fields |= GPU_TELEMETRY_FIELD_UTILIZATION;
+            }
+            if (gpu.device.ReadUInt("mem_info_vram_used", value)) {
+                sample.memory_used_bytes = value;
+                sample.fields |= GPU_TELEMETRY_FIELD_MEMORY_USED;
+            }
+            if (gpu.device.ReadUInt("mem_info_vram_total", value)) {
+                sample.memory_budget_bytes = value;
+                sample.fields |= GPU_TELEMETRY_FIELD_MEMORY_BUDGET;
+            }
+            if (gpu.device.ReadUInt("mem_info_gtt_used", value)) {
+                sample.shared_memory_used_bytes = value;
+                sample.fields |= GPU_TELEMETRY_FIELD_SHARED_MEMORY_USED;
+            }
+        }
+        Publish(sample);
+    }
+}
+
+void PlatformClose() {
+    g_gpus.clear();
+}
+
+} // namespace gpu_telemetry
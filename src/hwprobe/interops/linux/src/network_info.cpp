@@ -0,0 +1,151 @@
+#include "network_info.h"
+#include "sysfs_helpers.h"
+#include "bench_stages.h"
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <netinet/in.h>
+
+// ---- Internal helpers ----
+
+namespace {
+
+struct NicEntry {
+    std::string interface;
+    std::string link_type;
+    std::string mac_address;
+    std::string ipv4_address;
+    std::string ipv6_address;
+    std::string device_slot;
+    std::string acpi_path;
+    std::string pci_path;
+    uint32_t vendor_id = 0;
+    uint32_t device_id = 0;
+    uint32_t if_index = 0;
+};
+
+// ARPHRD_* -> the name `ip link` prints for it (iproute2 lib/ll_types.c).
+std::string LinkTypeName(uint64_t type) {
+    switch (type) {
+    case 1: return "ether";
+    case 32: return "infiniband";
+    case 280: return "can";
+    case 512: return "ppp";
+    case 768: return "ipip";
+    case 769: return "tunnel6";
+    case 772: return "loopback";
+    case 776: return "sit";
+    case 778: return "gre";
+    case 801: return "ieee802.11";
+    case 802: return "ieee802.11/prism";
+    case 803: return "ieee802.11/radiotap";
+    case 804: return "ieee802.15.4";
+    case 823: return "gre6";
+    case 824: return "netlink";
+    case 825: return "6lowpan";
+    case 65534: return "none";
+    case 65535: return "void";
+    default: return "[" + std::to_string(type) + "]";
+    }
+}
+
+// First IPv4 and first IPv6 address of every interface, from one getifaddrs() call.
+void CollectAddresses(std::unordered_map<std::string, NicEntry> &nics) {
+    DEVICE_INFO_STAGE("getifaddrs");
+    ifaddrs *addresses = nullptr;
+    if (getifaddrs(&addresses) != 0) return;
+
+    char text[INET6_ADDRSTRLEN];
+    for (const ifaddrs *entry = addresses; entry; entry = entry->ifa_next) {
+        if (!entry->ifa_name || !entry->ifa_addr) continue;
+        const auto found = nics.find(entry->ifa_name);
+        if (found == nics.end()) continue;
+
+        NicEntry &nic = found->second;
+        const int family = entry->ifa_addr->sa_family;
+        if (family == AF_INET && nic.ipv4_address.empty()) {
+            const auto *address = reinterpret_cast<const sockaddr_in *>(entry->ifa_addr);
+            if (inet_ntop(AF_INET, &address->sin_addr, text, sizeof(text))) nic.ipv4_address = text;
+        } else if (family == AF_INET6 && nic.ipv6_address.empty()) {
+            const auto *address = reinterpret_cast<const sockaddr_in6 *>(entry->ifa_addr);
+            if (inet_ntop(AF_INET6, &address->sin6_addr, text, sizeof(text))) nic.ipv6_address = text;
+        }
+    }
+    freeifaddrs(addresses);
+}
+
+bool CollectNics(std::vector<NicEntry> &out) {
+    DEVICE_INFO_STAGE("collectNics");
+    const sysfs::Dir &interfaces = sysfs::Root("/sys/class/net");
+    if (!interfaces) return false;
+
+    std::unordered_map<std::string, NicEntry> nics;
+    std::string text;
+    for (const std::string &name : interfaces.List()) {
+        const sysfs::Dir interface = interfaces.Open(name.c_str());
+        if (!interface) continue;  // bonding_masters and other plain files
+
+        NicEntry nic;
+        nic.interface = name;
+        uint64_t value = 0;
+        if (interface.ReadUInt("type", value)) nic.link_type = LinkTypeName(value);
+        if (interface.ReadUInt("ifindex", value)) nic.if_index = static_cast<uint32_t>(value);
+        if (interface.Read("address", text)) nic.mac_address = text;
+
+        // Virtual interfaces (loopback, bridges, tunnels...) have no device link
+        if (interface.ReadLink("device", text)) {
+            nic.device_slot = std::string(sysfs::BaseName(text));
+            const sysfs::Dir device = interface.Open("device");
+            if (device.ReadUInt("vendor", value)) nic.vendor_id = static_cast<uint32_t>(value);
+            if (device.ReadUInt("device", value)) nic.device_id = static_cast<uint32_t>(value);
+            if (device.Read("firmware_node/path", text)) nic.acpi_path = text;
+            nic.pci_path = sysfs::PciPath(nic.device_slot);
+        }
+        nics.emplace(name, std::move(nic));
+    }
+
+    CollectAddresses(nics);
+
+    out.reserve(nics.size());
+    for (auto &entry : nics) out.push_back(std::move(entry.second));
+    std::sort(out.begin(), out.end(), [](const NicEntry &a, const NicEntry &b) { return a.if_index < b.if_index; });
+    return true;
+}
+
+} // namespace
+
+// ---- Exports ----
+
+int get_network_info_arena(DeviceArena **out) {
+    if (!out) return DEVICE_ARENA_STATUS_INVALID_ARG;
+    *out = nullptr;
+
+    std::vector<NicEntry> nics;
+    if (!CollectNics(nics))
+        return DEVICE_ARENA_STATUS_FAILURE;
+
+    arena::Builder builder(DEVICE_ARENA_KIND_LINUX_NIC, sizeof(NICRecord));
+    for (const NicEntry &entry : nics) {
+        NICRecord record{};
+        record.interface = builder.Intern(entry.interface);
+        record.link_type = builder.Intern(entry.link_type);
+        record.mac_address = builder.Intern(entry.mac_address);
+        record.ipv4_address = builder.Intern(entry.ipv4_address);
+        record.ipv6_address = builder.Intern(entry.ipv6_address);
+        record.device_slot = builder.Intern(entry.device_slot);
+        record.acpi_path = builder.Intern(entry.acpi_path);
+        record.pci_path = builder.Intern(entry.pci_path);
+        record.vendor_id = entry.vendor_id;
+        record.device_id = entry.device_id;
+        record.if_index = entry.if_index;
+        builder.Append(&record);
+    }
+
+    *out = builder.Finish();
+    return *out ? DEVICE_ARENA_STATUS_OK : DEVICE_ARENA_STATUS_FAILURE;
+}
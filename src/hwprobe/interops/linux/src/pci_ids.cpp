@@ -0,0 +1,143 @@
+#include "pci_ids.h"
+#include "sysfs_helpers.h"
+#include "bench_stages.h"
+
+#include <string_view>
+#include <unordered_map>
+
+namespace pci_ids {
+
+namespace {
+
+// Relative to "/"
+const char *const kDatabasePaths[] = {
+    "usr/share/hwdata/pci.ids",
+    "usr/share/misc/pci.ids",
+    "usr/share/pci.ids",
+    "usr/local/share/pci.ids",
+};
+
+int HexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Parses "xxxx" at the start of `text`; false if it is not four hex digits.
+bool ParseId(std::string_view text, uint16_t &id) {
+    if (text.size() < 4) return false;
+    unsigned value = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        const int digit = HexDigit(text[i]);
+        if (digit < 0) return false;
+        value = value << 4 | static_cast<unsigned>(digit);
+    }
+    id = static_cast<uint16_t>(value);
+    return true;
+}
+
+// The name after "<id>  " (two spaces), or empty.
+std::string_view NameAfter(std::string_view line, size_t id_end) {
+    if (line.size() <= id_end + 2 || line[id_end] != ' ' || line[id_end + 1] != ' ') return {};
+    return line.substr(id_end + 2);
+}
+
+// Line format (tabs are significant):
+//   vvvv  Vendor
+//   \tdddd  Device
+//   \t\tssss tttt  Subsystem
+// The vendor list is followed by the device class list ("C cc  Class"), which is not indexed.
+class Database {
+public:
+    Database() {
+        DEVICE_INFO_STAGE("PciIds::Load");
+        for (const char *path : kDatabasePaths)
+            if (sysfs::Root("/").ReadFile(path, text_) && !text_.empty()) break;
+
+        for (size_t pos = 0; pos < text_.size();) {
+            const std::string_view line = LineAt(pos);
+            if (line.size() >= 2 && line[0] == 'C' && line[1] == ' ') break;
+            uint16_t id;
+            if (!line.empty() && line[0] != '\t' && line[0] != '#' && ParseId(line, id))
+                vendors_.emplace(id, pos);
+            pos += line.size() + 1;
+        }
+    }
+
+    std::string_view Vendor(uint16_t vendor) const {
+        const auto found = vendors_.find(vendor);
+        return found == vendors_.end() ? std::string_view() : NameAfter(LineAt(found->second), 4);
+    }
+
+    // Device name and, if listed under it, the subsystem's name.
+    void Device(uint16_t vendor, uint16_t device, uint16_t subsystem_vendor, uint16_t subsystem_device,
+                std::string_view &device_name, std::string_view &subsystem_name) const {
+        device_name = subsystem_name = {};
+        const auto found = vendors_.find(vendor);
+        if (found == vendors_.end()) return;
+
+        size_t pos = found->second + LineAt(found->second).size() + 1;
+        bool in_device = false;
+        while (pos < text_.size()) {
+            const std::string_view line = LineAt(pos);
+            pos += line.size() + 1;
+            if (line.empty() || line[0] == '#') continue;
+            if (line[0] != '\t') break;  // next vendor
+
+            uint16_t id, sub_id;
+            if (line.size() > 1 && line[1] == '\t') {
+                if (in_device && ParseId(line.substr(2), id) && line.size() > 6 && line[6] == ' ' &&
+                    ParseId(line.substr(7), sub_id) && id == subsystem_vendor && sub_id == subsystem_device) {
+                    subsystem_name = NameAfter(line, 11);
+                    return;
+                }
+            } else if (in_device) {
+                return;  // past the device's subsystem lines
+            } else if (ParseId(line.substr(1), id) && id == device) {
+                device_name = NameAfter(line, 5);
+                in_device = true;
+            }
+        }
+    }
+
+private:
+    std::string_view LineAt(size_t pos) const {
+        const size_t end = text_.find('\n', pos);
+        return std::string_view(text_).substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+    }
+
+    std::string text_;
+    std::unordered_map<uint16_t, size_t> vendors_;  // vendor ID -> offset of its line
+};
+
+const Database &Instance() {
+    static const Database database;
+    return database;
+}
+
+} // namespace
+
+Names Lookup(uint16_t vendor, uint16_t device, uint16_t subsystem_vendor, uint16_t subsystem_device) {
+    const Database &database = Instance();
+    std::string_view device_name, subsystem_name;
+    database.Device(vendor, device, subsystem_vendor, subsystem_device, device_name, subsystem_name);
+
+    Names names;
+    names.vendor = database.Vendor(vendor);
+    names.device = device_name;
+    if (subsystem_vendor != 0 || subsystem_device != 0) {
+        names.subsystem_vendor = database.Vendor(subsystem_vendor);
+        // Like lspci: a subsystem that repeats the device's own IDs is named after the device
+        names.subsystem_device = !subsystem_name.empty() ? subsystem_name
+                               : (subsystem_vendor == vendor && subsystem_device == device) ? device_name
+                               : std::string_view();
+    }
+    return names;
+}
+
+void Preload() {
+    Instance();
+}
+
+} // namespace pci_ids
@@ -0,0 +1,237 @@
+#include "sysfs_helpers.h"
+
+#include "device_replay.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace sysfs {
+
+namespace {
+
+// A sysfs attribute is at most one page, so it takes a single pread(); procfs files loop.
+constexpr size_t kReadChunk = 4096;
+
+bool IsHex(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+std::string Hex(unsigned long value) {
+    char text[24];
+    std::snprintf(text, sizeof(text), "0x%lx", value);
+    return text;
+}
+
+bool ReadFileAt(int dir, const char *path, std::string &out) {
+    const int fd = openat(dir, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    bool ok = true;
+    for (;;) {
+        const size_t used = out.size();
+        out.resize(used + kReadChunk);
+        const ssize_t n = pread(fd, &out[used], kReadChunk, static_cast<off_t>(used));
+        if (n < 0 && errno == EINTR) {
+            out.resize(used);
+            continue;
+        }
+        if (n <= 0) {
+            out.resize(used);
+            ok = n == 0;
+            break;
+        }
+        out.resize(used + static_cast<size_t>(n));
+    }
+    close(fd);
+    return ok;
+}
+
+bool ReadLinkAt(int dir, const char *path, std::string &out) {
+    char target[4096];
+    const ssize_t n = readlinkat(dir, path, target, sizeof(target));
+    if (n <= 0 || static_cast<size_t>(n) >= sizeof(target)) return false;
+    out.assign(target, static_cast<size_t>(n));
+    return true;
+}
+
+void ListAt(int dir, std::vector<std::string> &names) {
+    // An O_PATH descriptor cannot be read, so list through a readable one (closed by closedir()).
+    const int fd = openat(dir, ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) return;
+    DIR *listing = fdopendir(fd);
+    if (!listing) {
+        close(fd);
+        return;
+    }
+    while (const dirent *entry = readdir(listing)) {
+        if (std::strcmp(entry->d_name, ".") == 0 || std::strcmp(entry->d_name, "..") == 0) continue;
+        names.emplace_back(entry->d_name);
+    }
+    closedir(listing);
+}
+
+// A directory that was just opened; recorded so that replaying knows it exists.
+Dir Opened(int fd, std::string path) {
+    if (fd >= 0 && replay::Active()) replay::Record(DEVICE_REPLAY_SYSFS_DIR, path, {});
+    return Dir(fd, std::move(path));
+}
+
+} // namespace
+
+Dir::~Dir() {
+    if (fd_ >= 0) close(fd_);
+}
+
+Dir &Dir::operator=(Dir &&other) noexcept {
+    if (this != &other) {
+        if (fd_ >= 0) close(fd_);
+        fd_ = other.fd_;
+        path_ = std::move(other.path_);
+        other.fd_ = -1;
+    }
+    return *this;
+}
+
+Dir::operator bool() const {
+    if (replay::Replaying()) {
+        std::string unused;
+        return replay::Lookup(DEVICE_REPLAY_SYSFS_DIR, path_, unused);
+    }
+    return fd_ >= 0;
+}
+
+Dir Dir::Open(const char *path) const {
+    if (replay::Replaying()) return Dir(-1, Child(path));
+    if (fd_ < 0) return Dir();
+    return Opened(openat(fd_, path, O_PATH | O_DIRECTORY | O_CLOEXEC), Child(path));
+}
+
+bool Dir::ReadFile(const char *path, std::string &out) const {
+    out.clear();
+    if (replay::Active()) {
+        if (replay::Replaying()) return replay::Lookup(DEVICE_REPLAY_SYSFS_FILE, Child(path), out);
+        if (fd_ < 0 || !ReadFileAt(fd_, path, out)) return false;
+        replay::Record(DEVICE_REPLAY_SYSFS_FILE, Child(path), out);
+        return true;
+    }
+    return fd_ >= 0 && ReadFileAt(fd_, path, out);
+}
+
+bool Dir::Read(const char *path, std::string &out) const {
+    if (!ReadFile(path, out)) return false;
+    while (!out.empty() && static_cast<unsigned char>(out.back()) <= ' ')
+        out.pop_back();
+    return true;
+}
+
+bool Dir::ReadUInt(const char *path, uint64_t &out) const {
+    std::string text;
+    if (!Read(path, text) || text.empty()) return false;
+    char *end = nullptr;
+    errno = 0;
+    const unsigned long long value = std::strtoull(text.c_str(), &end, 0);
+    if (errno != 0 || end == text.c_str()) return false;
+    out = value;
+    return true;
+}
+
+bool Dir::ReadLink(const char *path, std::string &out) const {
+    out.clear();
+    if (replay::Active()) {
+        if (replay::Replaying()) return replay::Lookup(DEVICE_REPLAY_SYSFS_LINK, Child(path), out);
+        if (fd_ < 0 || !ReadLinkAt(fd_, path, out)) return false;
+        replay::Record(DEVICE_REPLAY_SYSFS_LINK, Child(path), out);
+        return true;
+    }
+    return fd_ >= 0 && ReadLinkAt(fd_, path, out);
+}
+
+std::vector<std::string> Dir::List() const {
+    std::vector<std::string> names;
+    if (replay::Replaying()) {
+        std::string packed;
+        if (!replay::Lookup(DEVICE_REPLAY_SYSFS_LIST, path_, packed)) return names;
+        for (size_t begin = 0, end; (end = packed.find('\0', begin)) != std::string::npos; begin = end + 1)
+            names.emplace_back(packed, begin, end - begin);
+        return names;
+    }
+    if (fd_ < 0) return names;
+    ListAt(fd_, names);
+
+    if (replay::Active()) {
+        std::string packed;
+        for (const std::string &name : names) {
+            packed += name;
+            packed += '\0';
+        }
+        replay::Record(DEVICE_REPLAY_SYSFS_LIST, path_, packed);
+    }
+    return names;
+}
+
+const Dir &Root(const char *path) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, Dir> roots;  // nodes are stable, so references stay valid
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = roots.find(path);
+    if (found == roots.end())
+        found = roots.emplace(path, Dir(open(path, O_PATH | O_DIRECTORY | O_CLOEXEC), path)).first;
+
+    // The descriptor is cached, but a recording started after it was opened still needs the entry
+    if (found->second.fd() >= 0 && replay::Active())
+        replay::Record(DEVICE_REPLAY_SYSFS_DIR, found->second.path(), {});
+    return found->second;
+}
+
+bool IsPciSlot(std::string_view name) {
+    // dddd:bb:ss.f
+    if (name.size() != 12 || name[4] != ':' || name[7] != ':' || name[10] != '.') return false;
+    for (size_t i : {0, 1, 2, 3, 5, 6, 8, 9})
+        if (!IsHex(name[i])) return false;
+    return name[11] >= '0' && name[11] <= '7';
+}
+
+std::string_view BaseName(std::string_view path) {
+    const size_t slash = path.rfind('/');
+    return slash == std::string_view::npos ? path : path.substr(slash + 1);
+}
+
+std::string PciPath(std::string_view slot) {
+    if (!IsPciSlot(slot)) return {};
+
+    const std::string name(slot);
+    std::vector<std::string_view> chain;
+    std::string target;
+    if (Root("/sys/bus/pci/devices").ReadLink(name.c_str(), target)) {
+        // ../../../devices/pci0000:00/0000:00:01.0/0000:01:00.0: the root port, bridges, then the device.
+        std::string_view rest(target);
+        while (!rest.empty()) {
+            const size_t slash = rest.find('/');
+            const std::string_view part = rest.substr(0, slash);
+            if (IsPciSlot(part)) chain.push_back(part);
+            if (slash == std::string_view::npos) break;
+            rest.remove_prefix(slash + 1);
+        }
+    }
+    if (chain.empty() || chain.back() != slot) chain.assign(1, slot);
+
+    std::string path = "PciRoot(" + Hex(std::strtoul(name.substr(0, 4).c_str(), nullptr, 16)) + ")";
+    for (std::string_view part : chain) {
+        const std::string device(part.substr(8, 2));
+        const std::string function(part.substr(11, 1));
+        path += "/Pci(" + Hex(std::strtoul(device.c_str(), nullptr, 16)) + "," +
+                Hex(std::strtoul(function.c_str(), nullptr, 16)) + ")";
+    }
+    return path;
+}
+
+} // namespace sysfs
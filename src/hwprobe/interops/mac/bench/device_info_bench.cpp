@@ -0,0 +1,92 @@
+// Regression benchmark for the macOS exports: every case runs N times cold and warm, and the
+// report (JSON on stdout) gives p50/p99/max latency per case. For a libdevice_info.dylib
+// configured with -DDEVICE_INFO_BUILD_BENCHMARKS=ON it also gives allocations per call and the
+// share of each internal stage (collectGpus, PciPathCache::resolve, MediaIndex::build...).
+//
+//   device_info_bench [--iterations N] [--mode cold|warm|both] [--device-info path/to/libdevice_info.dylib]
+//
+// The library is opened at runtime so the same binary can compare two builds side by side.
+// Nothing in it is cached between calls, so cold and warm differ only by first-call costs
+// (IOKit matching tables, page faults).
+
+#include "bench_harness.h"
+#include "device_arena.h"
+#include "gpu_info.h"
+#include "storage_info.h"
+
+#include <dlfcn.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kMaxDevices = 32;
+
+template <typename Fn>
+Fn Resolve(void *lib, const char *name) {
+    return reinterpret_cast<Fn>(dlsym(lib, name));
+}
+
+// Query + exact-size copy + free, the way the Python binding reads an arena.
+bench::Case ArenaCase(void *lib, const char *name) {
+    auto query = Resolve<int (*)(DeviceArena **)>(lib, name);
+    auto size = Resolve<uint64_t (*)(const DeviceArena *)>(lib, "device_arena_size");
+    auto copy = Resolve<int (*)(const DeviceArena *, void *, uint64_t)>(lib, "device_arena_copy");
+    auto release = Resolve<void (*)(DeviceArena *)>(lib, "device_arena_free");
+    return bench::Case(name, "device_info", [=] {
+        DeviceArena *arena = nullptr;
+        if (!query || query(&arena) != DEVICE_ARENA_STATUS_OK || !arena) return false;
+        std::vector<unsigned char> blob(static_cast<size_t>(size(arena)));
+        const bool ok = copy(arena, blob.data(), blob.size()) == DEVICE_ARENA_STATUS_OK;
+        release(arena);
+        return ok;
+    }, true);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bench::Options options;
+    std::vector<std::string> rest;
+    if (!bench::ParseOptions(argc, argv, options, rest)) return 2;
+
+    std::string path = "libdevice_info.dylib";
+    for (size_t i = 0; i + 1 < rest.size(); i += 2)
+        if (rest[i] == "--device-info") path = rest[i + 1];
+
+    void *lib = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!lib) {
+        std::fprintf(stderr, "Error: could not load %s: %s\n", path.c_str(), dlerror());
+        return 1;
+    }
+
+    bench::StageApi stages;
+    stages.count = Resolve<int (*)(void)>(lib, "device_info_stage_count");
+    stages.get = Resolve<int (*)(int, DeviceInfoStageStats *)>(lib, "device_info_stage_get");
+    stages.reset = Resolve<void (*)(void)>(lib, "device_info_stage_reset");
+    stages.allocations = Resolve<uint64_t (*)(void)>(lib, "device_info_alloc_count");
+
+    std::vector<bench::Case> cases;
+    if (auto gpu_info = Resolve<int (*)(GPUProperties *, int)>(lib, "get_gpu_info")) {
+        cases.emplace_back("get_gpu_info", "device_info", [gpu_info] {
+            std::vector<GPUProperties> gpus(kMaxDevices);
+            return gpu_info(gpus.data(), kMaxDevices) >= 0;
+        }, true);
+    }
+    cases.push_back(ArenaCase(lib, "get_gpu_info_arena"));
+    if (auto storage_info = Resolve<int (*)(StorageDeviceProperties *, int)>(lib, "get_storage_info")) {
+        cases.emplace_back("get_storage_info", "device_info", [storage_info] {
+            std::vector<StorageDeviceProperties> disks(kMaxDevices);
+            return storage_info(disks.data(), kMaxDevices) >= 0;
+        }, true);
+    }
+    cases.push_back(ArenaCase(lib, "get_storage_info_arena"));
+    cases.push_back(ArenaCase(lib, "get_cpu_topology_arena"));
+
+    const int status = bench::Run("macos", cases, options, stages);
+    dlclose(lib);
+    return status;
+}
@@ -0,0 +1,30 @@
+"""
+cpu_topology.py  –  Python ctypes binding for libdevice_info.dylib (processor topology)
+
+Usage:
+    from hwprobe.interops.mac.bindings.cpu_topology import topology
+    info = topology.read()
+    print(info.cores, info.threads, info.core_classes, info.caches)
+
+Source code is in `interops/common/src/cpu_topology.cpp` and `interops/mac/src/cpu_topology_mac.cpp`.
+"""
+
+import ctypes
+import pathlib
+
+from hwprobe.interops.common.cpu_topology import CpuTopologyReader
+
+# ── locate the dylib ────────────────────────────────────────────────────────
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "libdevice_info.dylib"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"libdevice_info.dylib not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build cmake-build-debug"
+    )
+
+_lib = ctypes.CDLL(str(_LIB_PATH))
+
+# Inert (read() returns None) if the dylib predates the topology export
+topology = CpuTopologyReader(_lib)
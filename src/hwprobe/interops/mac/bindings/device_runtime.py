@@ -0,0 +1,30 @@
+"""
+device_runtime.py  –  Python ctypes binding for libdevice_info.dylib (process lifecycle)
+
+Usage:
+    from hwprobe.interops.mac.bindings.device_runtime import runtime
+    with runtime.session():
+        ...  # probes from any number of threads
+
+Source code is in `interops/common/src/device_runtime.cpp` and `interops/mac/src/device_runtime_mac.cpp`.
+"""
+
+import ctypes
+import pathlib
+
+from hwprobe.interops.common.device_runtime import DeviceRuntime
+
+# ── locate the dylib ────────────────────────────────────────────────────────
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "libdevice_info.dylib"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"libdevice_info.dylib not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build cmake-build-debug"
+    )
+
+_lib = ctypes.CDLL(str(_LIB_PATH))
+
+# Inert (init() returns False) if the dylib predates the lifecycle exports
+runtime = DeviceRuntime(_lib)
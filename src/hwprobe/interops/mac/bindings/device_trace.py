@@ -0,0 +1,32 @@
+"""
+device_trace.py  –  Python ctypes binding for libdevice_info.dylib (hot-path tracing)
+
+Usage:
+    from hwprobe.interops.mac.bindings.device_trace import trace
+    with trace.capture() as events:
+        fetch_storage_info()
+    print(slowest(events))
+
+Source code is in `interops/common/src/device_trace.cpp`; the trace points are the DEVICE_INFO_STAGE
+scopes in `interops/mac/src`.
+"""
+
+import ctypes
+import pathlib
+
+from hwprobe.interops.common.device_trace import DeviceTrace
+
+# ── locate the dylib ────────────────────────────────────────────────────────
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "libdevice_info.dylib"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"libdevice_info.dylib not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build cmake-build-debug"
+    )
+
+_lib = ctypes.CDLL(str(_LIB_PATH))
+
+# Shared by the whole process; inert if the dylib was built without DEVICE_INFO_TRACE
+trace = DeviceTrace(_lib)
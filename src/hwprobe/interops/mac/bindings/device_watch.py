@@ -0,0 +1,30 @@
+"""
+device_watch.py  –  Python ctypes binding for libdevice_info.dylib (hot-plug notifications)
+
+Usage:
+    from hwprobe.interops.mac.bindings.device_watch import watch
+    if watch.start():
+        print(watch.generation(DEVICE_WATCH_STORAGE))
+
+Source code is in `interops/mac/src/device_watch_mac.cpp` and `interops/common/src/device_watch.cpp`.
+"""
+
+import ctypes
+import pathlib
+
+from hwprobe.interops.common.device_watch import DeviceWatch
+
+# ── locate the dylib ────────────────────────────────────────────────────────
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "libdevice_info.dylib"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"libdevice_info.dylib not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build cmake-build-debug"
+    )
+
+_lib = ctypes.CDLL(str(_LIB_PATH))
+
+# Shared by all managers in the process; inert if the dylib predates the device_watch_* exports
+watch = DeviceWatch(_lib)
@@ -13,7 +13,11 @@ Source code is in `interops/mac/include/` and `interops/mac/src/`.
 import ctypes
 import pathlib
 from dataclasses import dataclass
-from typing import Optional
+from typing import List, Optional
+
+from hwprobe.interops.common.device_arena import (
+    DEVICE_ARENA_KIND_MAC_GPU, ArenaString, bind_arena_exports, fetch_arena,
+)
 
 # ── locate the dylib ────────────────────────────────────────────────────────
 _HERE = pathlib.Path(__file__).parent
@@ -52,10 +56,28 @@ class _GPUProperties(ctypes.Structure):
     ]
 
 
+class _GPURecord(ctypes.Structure):
+    _fields_ = [
+        ("name", ArenaString),
+        ("acpi_path", ArenaString),
+        ("pci_path", ArenaString),
+        ("vendor_id", ctypes.c_uint32),
+        ("device_id", ctypes.c_uint32),
+        ("is_apple_silicon", ctypes.c_int32),
+        ("apple_gpu", _AppleGPUProperties),
+        ("vram_mb", ctypes.c_uint64),
+    ]
+
+
 # ── function signature ───────────────────────────────────────────────────────
 _lib.get_gpu_info.restype = ctypes.c_int
 _lib.get_gpu_info.argtypes = [ctypes.POINTER(_GPUProperties), ctypes.c_int]
 
+# Older builds of the dylib only have the fixed-size export.
+_HAS_ARENA = hasattr(_lib, "get_gpu_info_arena")
+if _HAS_ARENA:
+    bind_arena_exports(_lib, _lib.get_gpu_info_arena)
+
 
 # ── Python-facing dataclasses ────────────────────────────────────────────────
 
@@ -110,8 +132,18 @@ class GPUProperties:
 _MAX_GPUS = 16
 
 
-def get_gpu_info() -> list[GPUProperties]:
-    """Return a list of GPUProperties for every GPU found on this machine."""
+def _apple_gpu(raw) -> Optional[AppleGPUProperties]:
+    if not raw.is_apple_silicon:
+        return None
+    return AppleGPUProperties(
+        core_count=raw.apple_gpu.core_count,
+        gpu_perf_shaders=raw.apple_gpu.gpu_perf_shaders,
+        gpu_gen=raw.apple_gpu.gpu_gen,
+        unified_memory_mb=raw.apple_gpu.unified_memory_mb,
+    )
+
+
+def _get_gpu_info_fixed() -> List[GPUProperties]:
     buf = (_GPUProperties * _MAX_GPUS)()
     count = _lib.get_gpu_info(buf, _MAX_GPUS)
     if count < 0:
@@ -120,14 +152,6 @@ def get_gpu_info() -> list[GPUProperties]:
     result = []
     for i in range(count):
         raw = buf[i]
-        apple = None
-        if raw.is_apple_silicon:
-            apple = AppleGPUProperties(
-                core_count=raw.apple_gpu.core_count,
-                gpu_perf_shaders=raw.apple_gpu.gpu_perf_shaders,
-                gpu_gen=raw.apple_gpu.gpu_gen,
-                unified_memory_mb=raw.apple_gpu.unified_memory_mb,
-            )
         acpi = raw.acpi_path.decode("utf-8", errors="replace").strip("\x00") or None
         pci = raw.pci_path.decode("utf-8", errors="replace").strip("\x00") or None
 
@@ -136,7 +160,7 @@ def get_gpu_info() -> list[GPUProperties]:
             vendor_id=raw.vendor_id,
             device_id=raw.device_id,
             is_apple_silicon=bool(raw.is_apple_silicon),
-            apple_gpu=apple,
+            apple_gpu=_apple_gpu(raw),
             acpi_path=acpi,
             pci_path=pci,
             vram_mb=raw.vram_mb,
@@ -144,6 +168,31 @@ def get_gpu_info() -> list[GPUProperties]:
     return result
 
 
+def get_gpu_info() -> List[GPUProperties]:
+    """Return a list of GPUProperties for every GPU found on this machine."""
+    if not _HAS_ARENA:
+        return _get_gpu_info_fixed()
+
+    arena = fetch_arena(_lib.get_gpu_info_arena, _lib, DEVICE_ARENA_KIND_MAC_GPU, _GPURecord)
+    if arena is None:
+        raise RuntimeError("get_gpu_info_arena() failed")
+
+    records, strings = arena
+    return [
+        GPUProperties(
+            name=strings.get(raw.name) or "",
+            vendor_id=raw.vendor_id,
+            device_id=raw.device_id,
+            is_apple_silicon=bool(raw.is_apple_silicon),
+            apple_gpu=_apple_gpu(raw),
+            acpi_path=strings.get(raw.acpi_path),
+            pci_path=strings.get(raw.pci_path),
+            vram_mb=raw.vram_mb,
+        )
+        for raw in records
+    ]
+
+
 # ── quick self-test ──────────────────────────────────────────────────────────
 if __name__ == "__main__":
     gpus = get_gpu_info()
@@ -0,0 +1,31 @@
+"""
+gpu_telemetry.py  –  Python ctypes binding for libdevice_info.dylib (live GPU telemetry)
+
+Usage:
+    from hwprobe.interops.mac.bindings.gpu_telemetry import telemetry
+    with telemetry.sampling(interval_ms=100):
+        time.sleep(1)
+        print(latest(telemetry.read()))
+
+Source code is in `interops/common/src/gpu_telemetry.cpp` and `interops/mac/src/gpu_telemetry_mac.cpp`.
+"""
+
+import ctypes
+import pathlib
+
+from hwprobe.interops.common.gpu_telemetry import GpuTelemetry
+
+# ── locate the dylib ────────────────────────────────────────────────────────
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "libdevice_info.dylib"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"libdevice_info.dylib not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build cmake-build-debug"
+    )
+
+_lib = ctypes.CDLL(str(_LIB_PATH))
+
+# Shared by the whole process; inert if the dylib predates the gpu_telemetry_* exports
+telemetry = GpuTelemetry(_lib)
@@ -0,0 +1,52 @@
+"""
+probe_all.py  -  Python ctypes binding for libdevice_info.dylib (parallel multi-category probe)
+
+Usage:
+    from hwprobe.interops.mac.bindings.probe_all import GPU_JOB, STORAGE_JOB, prefetch
+    with prefetch([GPU_JOB, STORAGE_JOB]):
+        fetch_graphics_info()      # both served from the batch
+        fetch_storage_info()
+
+The jobs run concurrently on native worker threads; inside the block the first query of each category is
+answered from its result, every other query runs as usual. Source code is in `interops/mac/src/device_probe_mac.cpp`
+and `interops/common/src/device_probe.cpp`.
+"""
+
+import ctypes
+import pathlib
+from contextlib import contextmanager
+from typing import Sequence
+
+from hwprobe.interops.common.device_probe import (
+    DEVICE_PROBE_GPU, DEVICE_PROBE_STORAGE, ProbeJob, bind_probe_exports, prefetched_arenas, probe_all,
+)
+
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "libdevice_info.dylib"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"libdevice_info.dylib not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build cmake-build-debug"
+    )
+
+_lib = ctypes.CDLL(str(_LIB_PATH))
+
+_SUPPORTED = bind_probe_exports(_lib)
+
+GPU_JOB = ProbeJob(DEVICE_PROBE_GPU)
+STORAGE_JOB = ProbeJob(DEVICE_PROBE_STORAGE)
+
+
+# ---- Public API ----
+
+@contextmanager
+def prefetch(jobs: Sequence[ProbeJob]):
+    """Run `jobs` concurrently up front and serve their results to the bindings inside the block."""
+    if not _SUPPORTED or not jobs:
+        yield
+        return
+
+    blobs = probe_all(_lib, jobs)
+    with prefetched_arenas(blob for blob in blobs if blob is not None):
+        yield
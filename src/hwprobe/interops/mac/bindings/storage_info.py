@@ -13,6 +13,11 @@ Source code is in `interops/mac/include/` and `interops/mac/src/`.
 import ctypes
 import pathlib
 from dataclasses import dataclass
+from typing import List
+
+from hwprobe.interops.common.device_arena import (
+    DEVICE_ARENA_KIND_MAC_STORAGE, ArenaString, bind_arena_exports, fetch_arena,
+)
 
 _HERE = pathlib.Path(__file__).parent
 _LIB_PATH = _HERE / "libdevice_info.dylib"
@@ -26,6 +31,8 @@ if not _LIB_PATH.exists():
 _lib = ctypes.CDLL(str(_LIB_PATH))
 
 
+# The fixed-size export keeps the layout of the first builds (904 bytes per device), so it reads the same from any
+# dylib; partition and container counts only come with the arena record.
 class _StorageDeviceProperties(ctypes.Structure):
     _fields_ = [
         ("product_name", ctypes.c_char * 256),
@@ -38,9 +45,28 @@ class _StorageDeviceProperties(ctypes.Structure):
     ]
 
 
+class _StorageDeviceRecord(ctypes.Structure):
+    _fields_ = [
+        ("product_name", ArenaString),
+        ("vendor_name", ArenaString),
+        ("medium_type", ArenaString),
+        ("interconnect", ArenaString),
+        ("location", ArenaString),
+        ("bsd_name", ArenaString),
+        ("size_bytes", ctypes.c_uint64),
+        ("partition_count", ctypes.c_int32),
+        ("container_count", ctypes.c_int32),
+    ]
+
+
 _lib.get_storage_info.restype = ctypes.c_int
 _lib.get_storage_info.argtypes = [ctypes.POINTER(_StorageDeviceProperties), ctypes.c_int]
 
+# Older builds of the dylib only have the fixed-size export.
+_HAS_ARENA = hasattr(_lib, "get_storage_info_arena")
+if _HAS_ARENA:
+    bind_arena_exports(_lib, _lib.get_storage_info_arena)
+
 
 @dataclass
 class StorageDeviceProperties:
@@ -51,6 +77,8 @@ class StorageDeviceProperties:
     location: str
     bsd_name: str
     size_bytes: int
+    partition_count: int = 0
+    container_count: int = 0
 
     def __str__(self) -> str:
         size_mb = self.size_bytes // (1024 * 1024) if self.size_bytes else 0
@@ -62,6 +90,8 @@ class StorageDeviceProperties:
             f"  Location:     {self.location}",
             f"  BSD Name:     {self.bsd_name}",
             f"  Size:         {size_mb} MB",
+            f"  Partitions:   {self.partition_count}",
+            f"  Containers:   {self.container_count}",
         ]
         return "\n".join(lines)
 
@@ -69,8 +99,7 @@ class StorageDeviceProperties:
 _MAX_DEVICES = 32
 
 
-def get_storage_info() -> list[StorageDeviceProperties]:
-    """Return a list of StorageDeviceProperties for every storage device found."""
+def _get_storage_info_fixed() -> List[StorageDeviceProperties]:
     buf = (_StorageDeviceProperties * _MAX_DEVICES)()
     count = _lib.get_storage_info(buf, _MAX_DEVICES)
     if count < 0:
@@ -91,6 +120,32 @@ def get_storage_info() -> list[StorageDeviceProperties]:
     return result
 
 
+def get_storage_info() -> List[StorageDeviceProperties]:
+    """Return a list of StorageDeviceProperties for every storage device found."""
+    if not _HAS_ARENA:
+        return _get_storage_info_fixed()
+
+    arena = fetch_arena(_lib.get_storage_info_arena, _lib, DEVICE_ARENA_KIND_MAC_STORAGE, _StorageDeviceRecord)
+    if arena is None:
+        raise RuntimeError("get_storage_info_arena() failed")
+
+    records, strings = arena
+    return [
+        StorageDeviceProperties(
+            product_name=strings.get(raw.product_name) or "",
+            vendor_name=strings.get(raw.vendor_name) or "",
+            medium_type=strings.get(raw.medium_type) or "",
+            interconnect=strings.get(raw.interconnect) or "",
+            location=strings.get(raw.location) or "",
+            bsd_name=strings.get(raw.bsd_name) or "",
+            size_bytes=raw.size_bytes,
+            partition_count=raw.partition_count,
+            container_count=raw.container_count,
+        )
+        for raw in records
+    ]
+
+
 if __name__ == "__main__":
     disks = get_storage_info()
     print(f"Found {len(disks)} storage device(s):\n")
@@ -2,6 +2,8 @@
 
 #include <cstdint>
 
+#include "device_arena.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -26,11 +28,40 @@ typedef struct {
     uint64_t vram_mb;
 } GPUProperties;
 
+// Compact record used by get_gpu_info_arena(); strings live in the arena's string pool.
+typedef struct {
+    ArenaString name;
+    ArenaString acpi_path;
+    ArenaString pci_path;
+    uint32_t vendor_id;
+    uint32_t device_id;
+    int32_t is_apple_silicon;
+    AppleGPUProperties apple_gpu;
+    uint64_t vram_mb;
+} GPURecord;
+
 // Fills `out` with GPU entries. Returns number of GPUs found, or -1 on error.
 // Caller does NOT need to free — output is written into a caller-supplied buffer.
+// GPUs beyond `max_count` are dropped and long strings truncated; prefer get_gpu_info_arena().
 int get_gpu_info(GPUProperties *out, int max_count);
 
+// Enumerates every GPU into a DeviceArena of GPURecord (kind DEVICE_ARENA_KIND_MAC_GPU).
+// On success `*out` must be released with device_arena_free().
+int get_gpu_info_arena(DeviceArena **out);
+
 #ifdef __cplusplus
 }
+
+#include <vector>
+#include <IOKit/IOKitLib.h>
+
+namespace gpu_info {
+
+// The IOKit service of every GPU, in get_gpu_info_arena() order. Each is retained: release it
+// with IOObjectRelease(). False if IOKit matching fails.
+bool collectServices(std::vector<io_service_t> &out);
+
+} // namespace gpu_info
+
 #endif
 
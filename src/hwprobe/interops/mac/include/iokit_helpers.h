@@ -8,6 +8,33 @@
 // Converts a CFStringRef to a std::string (UTF-8). Returns empty on failure.
 std::string readCFString(CFStringRef cfStr);
 
+// Owns a CF object from a Create/Copy call and releases it when it goes out of scope.
+class ScopedCFType {
+public:
+    explicit ScopedCFType(CFTypeRef ref = nullptr) : ref_(ref) {}
+    ~ScopedCFType() { if (ref_) CFRelease(ref_); }
+
+    ScopedCFType(const ScopedCFType &) = delete;
+    ScopedCFType &operator=(const ScopedCFType &) = delete;
+    ScopedCFType(ScopedCFType &&other) noexcept : ref_(other.ref_) { other.ref_ = nullptr; }
+
+    CFTypeRef get() const { return ref_; }
+    explicit operator bool() const { return ref_ != nullptr; }
+
+    // True if the held object is of the given CF type (e.g. CFStringGetTypeID()).
+    bool is(CFTypeID type) const { return ref_ && CFGetTypeID(ref_) == type; }
+
+private:
+    CFTypeRef ref_;
+};
+
+// Copies a single property of `entry` without materializing its whole property table.
+// Returns nullptr if the key is not set.
+ScopedCFType copyRegistryProperty(io_registry_entry_t entry, CFStringRef key);
+
+// Reads a uint32 value stored as CFData. Returns 0 if `ref` is not CFData.
+uint32_t readCFDataAsUInt32(CFTypeRef ref);
+
 // Reads a uint32 value stored as CFData inside a CFDictionary.
 uint32_t readUInt32(CFDictionaryRef dict, CFStringRef key);
 
@@ -2,6 +2,8 @@
 
 #include <cstdint>
 
+#include "device_arena.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -14,11 +16,29 @@ typedef struct {
     char location[64]; // e.g. "Internal", "External"
     char bsd_name[64]; // e.g. "disk0", "disk1"
     uint64_t size_bytes; // Total disk size from IOMedia
-} StorageDeviceProperties;
+} StorageDeviceProperties;  // fixed ABI (904 bytes) shared with older builds; new fields go in StorageDeviceRecord
+
+// Compact record used by get_storage_info_arena(); strings live in the arena's string pool.
+typedef struct {
+    ArenaString product_name;
+    ArenaString vendor_name;
+    ArenaString medium_type;
+    ArenaString interconnect;
+    ArenaString location;
+    ArenaString bsd_name;
+    uint64_t size_bytes;
+    int32_t partition_count;  // partitions on the whole-disk media
+    int32_t container_count;  // whole media nested below it (e.g. APFS containers)
+} StorageDeviceRecord;
 
 // Fills `out` with storage device entries. Returns the number of devices found, or -1 on error.
+// Devices beyond `max_count` are dropped; prefer get_storage_info_arena().
 int get_storage_info(StorageDeviceProperties *out, int max_count);
 
+// Enumerates every storage device into a DeviceArena of StorageDeviceRecord
+// (kind DEVICE_ARENA_KIND_MAC_STORAGE). On success `*out` must be released with device_arena_free().
+int get_storage_info_arena(DeviceArena **out);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
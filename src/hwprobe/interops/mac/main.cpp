@@ -1,70 +1,94 @@
+#include <cstring>
 #include <iostream>
 #include <iomanip>
+#include <string_view>
+#include <vector>
 #include "include/gpu_info.h"
 #include "include/storage_info.h"
 
-int main() {
-    // ── GPU info ────────────────────────────────────────────────────────────
-    GPUProperties gpus[16];
-    const int gpuCount = get_gpu_info(gpus, 16);
+// Collects the arena returned by `query` (arena::Collect), then calls fn(index, record, str) for
+// every record; `str` resolves an ArenaString against the string pool.
+// Returns the number of records, or -1 if the query failed.
+template <typename Record, typename Fn>
+static int forEachRecord(int (*query)(DeviceArena **), Fn &&fn) {
+    std::vector<unsigned char> blob;
+    if (!arena::Collect(query, blob))
+        return -1;
 
-    if (gpuCount < 0) {
-        std::cerr << "Failed to retrieve GPU info.\n";
-    } else {
-        std::cout << "Found " << gpuCount << " GPU(s):\n\n";
+    DeviceArenaHeader header;
+    std::memcpy(&header, blob.data(), sizeof(header));
+    if (header.magic != DEVICE_ARENA_MAGIC || header.record_size != sizeof(Record))
+        return -1;
 
-        for (int i = 0; i < gpuCount; ++i) {
-            const GPUProperties &g = gpus[i];
-            std::cout << "GPU " << i << ":\n";
-            std::cout << "  Name:         " << g.name << "\n";
-            std::cout << std::hex << std::setfill('0');
-            std::cout << "  Vendor ID:    0x" << std::setw(4) << g.vendor_id << "\n";
-            std::cout << "  Device ID:    0x" << std::setw(4) << g.device_id << "\n";
-            std::cout << std::dec << std::setfill(' ');
-            if (g.is_apple_silicon) {
-                std::cout << "  Apple Silicon GPU:\n";
-                std::cout << "    GPU Cores:     " << g.apple_gpu.core_count << "\n";
-                std::cout << "    Perf Shaders:  " << g.apple_gpu.gpu_perf_shaders << "\n";
-                std::cout << "    GPU Gen:       " << g.apple_gpu.gpu_gen << "\n";
-                std::cout << "    Unified Mem:   " << g.apple_gpu.unified_memory_mb << " MB\n";
-            }
-            if (g.acpi_path[0] != '\0')
-                std::cout << "  ACPI Path:    " << g.acpi_path << "\n";
-            if (g.pci_path[0] != '\0')
-                std::cout << "  PCI Path:     " << g.pci_path << "\n";
-            if (g.vram_mb > 0)
-                std::cout << "  VRAM:         " << g.vram_mb << " MB\n";
-            std::cout << "\n";
-        }
+    const char *pool = reinterpret_cast<const char *>(blob.data() + header.strings_offset);
+    auto str = [pool](ArenaString s) { return std::string_view(pool + s.offset, s.length); };
+
+    for (uint32_t i = 0; i < header.record_count; ++i) {
+        Record record;
+        std::memcpy(&record, blob.data() + header.records_offset + i * sizeof(Record), sizeof(Record));
+        fn(i, record, str);
     }
+    return static_cast<int>(header.record_count);
+}
 
-    // ── Storage info ────────────────────────────────────────────────────────
-    StorageDeviceProperties disks[32];
-    const int diskCount = get_storage_info(disks, 32);
+int main() {
+    // ── GPU info ────────────────────────────────────────────────────────────
+    std::cout << "GPU(s):\n\n";
+    const int gpuCount = forEachRecord<GPURecord>(get_gpu_info_arena, [](uint32_t i, const GPURecord &g, auto str) {
+        std::cout << "GPU " << i << ":\n";
+        std::cout << "  Name:         " << str(g.name) << "\n";
+        std::cout << std::hex << std::setfill('0');
+        std::cout << "  Vendor ID:    0x" << std::setw(4) << g.vendor_id << "\n";
+        std::cout << "  Device ID:    0x" << std::setw(4) << g.device_id << "\n";
+        std::cout << std::dec << std::setfill(' ');
+        if (g.is_apple_silicon) {
+            std::cout << "  Apple Silicon GPU:\n";
+            std::cout << "    GPU Cores:     " << g.apple_gpu.core_count << "\n";
+            std::cout << "    Perf Shaders:  " << g.apple_gpu.gpu_perf_shaders << "\n";
+            std::cout << "    GPU Gen:       " << g.apple_gpu.gpu_gen << "\n";
+            std::cout << "    Unified Mem:   " << g.apple_gpu.unified_memory_mb << " MB\n";
+        }
+        if (g.acpi_path.length)
+            std::cout << "  ACPI Path:    " << str(g.acpi_path) << "\n";
+        if (g.pci_path.length)
+            std::cout << "  PCI Path:     " << str(g.pci_path) << "\n";
+        if (g.vram_mb > 0)
+            std::cout << "  VRAM:         " << g.vram_mb << " MB\n";
+        std::cout << "\n";
+    });
 
-    if (diskCount < 0) {
-        std::cerr << "Failed to retrieve storage info.\n";
-    } else {
-        std::cout << "Found " << diskCount << " storage device(s):\n\n";
+    if (gpuCount < 0)
+        std::cerr << "Failed to retrieve GPU info.\n";
+    else
+        std::cout << "Found " << gpuCount << " GPU(s).\n\n";
 
-        for (int i = 0; i < diskCount; ++i) {
-            const StorageDeviceProperties &d = disks[i];
+    // ── Storage info ────────────────────────────────────────────────────────
+    std::cout << "Storage device(s):\n\n";
+    const int diskCount = forEachRecord<StorageDeviceRecord>(
+        get_storage_info_arena, [](uint32_t i, const StorageDeviceRecord &d, auto str) {
             std::cout << "Disk " << i << ":\n";
-            if (d.product_name[0] != '\0')
-                std::cout << "  Product:      " << d.product_name << "\n";
-            if (d.vendor_name[0] != '\0')
-                std::cout << "  Vendor:       " << d.vendor_name << "\n";
-            if (d.medium_type[0] != '\0')
-                std::cout << "  Medium Type:  " << d.medium_type << "\n";
-            if (d.interconnect[0] != '\0')
-                std::cout << "  Interconnect: " << d.interconnect << "\n";
-            if (d.location[0] != '\0')
-                std::cout << "  Location:     " << d.location << "\n";
+            if (d.product_name.length)
+                std::cout << "  Product:      " << str(d.product_name) << "\n";
+            if (d.vendor_name.length)
+                std::cout << "  Vendor:       " << str(d.vendor_name) << "\n";
+            if (d.medium_type.length)
+                std::cout << "  Medium Type:  " << str(d.medium_type) << "\n";
+            if (d.interconnect.length)
+                std::cout << "  Interconnect: " << str(d.interconnect) << "\n";
+            if (d.location.length)
+                std::cout << "  Location:     " << str(d.location) << "\n";
             if (d.size_bytes > 0)
                 std::cout << "  Size:         " << d.size_bytes / (1024 * 1024) << " MB\n";
+            std::cout << "  Partitions:   " << d.partition_count << "\n";
+            if (d.container_count > 0)
+                std::cout << "  Containers:   " << d.container_count << "\n";
             std::cout << "\n";
-        }
-    }
+        });
+
+    if (diskCount < 0)
+        std::cerr << "Failed to retrieve storage info.\n";
+    else
+        std::cout << "Found " << diskCount << " storage device(s).\n";
 
     return (gpuCount < 0 && diskCount < 0) ? 1 : 0;
 }
@@ -0,0 +1,142 @@
+#include "cpu_topology.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sys/sysctl.h>
+
+// ---- macOS backend: hw.* sysctls ----
+//
+// macOS does not say which logical CPU is which, so this backend reports summaries: one core
+// class per performance level (hw.perflevel<N>, 0 being the fastest) and the caches of each
+// level with how many CPUs share them. Intel Macs before the perflevel sysctls get one class and
+// their sharing from hw.cacheconfig.
+
+namespace {
+
+// Integer sysctl of either width (the cache sizes are 64-bit, the counts 32-bit). 0 if missing.
+uint64_t readSysctl(const char *name) {
+    uint64_t value = 0;
+    size_t size = sizeof(value);
+    if (sysctlbyname(name, &value, &size, nullptr, 0) != 0) return 0;
+    if (size == sizeof(uint32_t)) {
+        uint32_t narrow = 0;
+        std::memcpy(&narrow, &value, sizeof(narrow));
+        return narrow;
+    }
+    return value;
+}
+
+uint64_t readLevel(int level, const char *field) {
+    const std::string name = "hw.perflevel" + std::to_string(level) + "." + field;
+    return readSysctl(name.c_str());
+}
+
+std::string readString(const char *name) {
+    size_t size = 0;
+    if (sysctlbyname(name, nullptr, &size, nullptr, 0) != 0 || size == 0) return "";
+    std::string value(size, '\0');
+    if (sysctlbyname(name, &value[0], &size, nullptr, 0) != 0) return "";
+    value.resize(value.find('\0') == std::string::npos ? size : value.find('\0'));
+    return value;
+}
+
+void addCache(cpu_topology::Topology &out, uint32_t level, uint32_t type, uint64_t size, uint32_t coreClass,
+              uint64_t threads, uint64_t sharing) {
+    if (!size || !sharing) return;
+    cpu_topology::CacheSummary cache;
+    cache.level = level;
+    cache.type = type;
+    cache.size_bytes = size;
+    cache.line_size = static_cast<uint32_t>(readSysctl("hw.cachelinesize"));
+    cache.core_class = coreClass;
+    cache.threads_per_instance = static_cast<uint32_t>(sharing);
+    cache.instances = static_cast<uint32_t>((threads + sharing - 1) / sharing);
+    out.cache_summaries.push_back(cache);
+}
+
+void readPerformanceLevels(cpu_topology::Topology &out, int levels) {
+    for (int level = 0; level < levels; ++level) {
+        cpu_topology::CoreClassSummary summary;
+        summary.efficiency_class = static_cast<uint32_t>(levels - 1 - level);
+        summary.cores = static_cast<uint32_t>(readLevel(level, "physicalcpu"));
+        summary.threads = static_cast<uint32_t>(readLevel(level, "logicalcpu"));
+        out.classes.push_back(summary);
+
+        const uint32_t coreClass = static_cast<uint32_t>(level);
+        const uint64_t threadsPerCore = summary.cores ? summary.threads / summary.cores : 1;
+        addCache(out, 1, CPU_CACHE_INSTRUCTION, readLevel(level, "l1icachesize"), coreClass, summary.threads,
+                 threadsPerCore);
+        addCache(out, 1, CPU_CACHE_DATA, readLevel(level, "l1dcachesize"), coreClass, summary.threads,
+                 threadsPerCore);
+        addCache(out, 2, CPU_CACHE_UNIFIED, readLevel(level, "l2cachesize"), coreClass, summary.threads,
+                 readLevel(level, "cpusperl2"));
+        addCache(out, 3, CPU_CACHE_UNIFIED, readLevel(level, "l3cachesize"), coreClass, summary.threads,
+                 readLevel(level, "cpusperl3"));
+    }
+}
+
+// hw.cacheconfig: logical CPUs sharing each level, memory first
+void readLegacyCaches(cpu_topology::Topology &out, const cpu_topology::CoreClassSummary &summary) {
+    uint64_t sharing[10] = {};
+    size_t size = sizeof(sharing);
+    if (sysctlbyname("hw.cacheconfig", sharing, &size, nullptr, 0) != 0) return;
+
+    addCache(out, 1, CPU_CACHE_INSTRUCTION, readSysctl("hw.l1icachesize"), 0, summary.threads, sharing[1]);
+    addCache(out, 1, CPU_CACHE_DATA, readSysctl("hw.l1dcachesize"), 0, summary.threads, sharing[1]);
+    addCache(out, 2, CPU_CACHE_UNIFIED, readSysctl("hw.l2cachesize"), 0, summary.threads, sharing[2]);
+    addCache(out, 3, CPU_CACHE_UNIFIED, readSysctl("hw.l3cachesize"), 0, summary.threads, sharing[3]);
+}
+
+void readArmFeatures(uint64_t &features) {
+#if defined(__aarch64__) || defined(__arm64__)
+    const struct {
+        const char *name;
+        uint64_t feature;
+    } map[] = {
+        {"hw.optional.neon", CPU_FEATURE_NEON},
+        {"hw.optional.arm.FEAT_AES", CPU_FEATURE_ARM_AES},
+        {"hw.optional.arm.FEAT_SHA256", CPU_FEATURE_ARM_SHA2},
+        {"hw.optional.armv8_crc32", CPU_FEATURE_CRC32},
+        {"hw.optional.arm.FEAT_LSE", CPU_FEATURE_LSE},
+        {"hw.optional.arm.FEAT_DotProd", CPU_FEATURE_DOTPROD},
+        {"hw.optional.arm.FEAT_FP16", CPU_FEATURE_FP16},
+        {"hw.optional.arm.FEAT_BF16", CPU_FEATURE_BF16},
+        {"hw.optional.arm.FEAT_I8MM", CPU_FEATURE_I8MM},
+        {"hw.optional.arm.FEAT_SME", CPU_FEATURE_SME},
+        {"hw.optional.arm.FEAT_SME2", CPU_FEATURE_SME2},
+    };
+    for (const auto &entry : map)
+        if (readSysctl(entry.name)) features |= entry.feature;
+#else
+    (void)features;
+#endif
+}
+
+} // namespace
+
+namespace cpu_topology {
+
+bool PlatformTopology(Topology &out) {
+    out.packages = static_cast<uint32_t>(readSysctl("hw.packages"));
+    out.numa_nodes = 1;
+    if (out.brand.empty()) out.brand = readString("machdep.cpu.brand_string");
+
+    const int levels = static_cast<int>(readSysctl("hw.nperflevels"));
+    if (levels > 0) {
+        readPerformanceLevels(out, levels);
+    } else {
+        CoreClassSummary summary;
+        summary.cores = static_cast<uint32_t>(readSysctl("hw.physicalcpu"));
+        summary.threads = static_cast<uint32_t>(readSysctl("hw.logicalcpu"));
+        if (!summary.threads) return false;
+        out.classes.push_back(summary);
+        readLegacyCaches(out, summary);
+    }
+
+    readArmFeatures(out.features);
+    return !out.classes.empty();
+}
+
+} // namespace cpu_topology
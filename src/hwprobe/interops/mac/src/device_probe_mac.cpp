@@ -0,0 +1,28 @@
+#include "device_probe.h"
+#include "device_arena.h"
+#include "gpu_info.h"
+#include "storage_info.h"
+
+#include <vector>
+
+// ---- macOS jobs: IOKit GPU and storage enumeration ----
+
+namespace probe {
+
+int PlatformRunJob(const DeviceProbeJob &job, std::vector<unsigned char> &blob) {
+    switch (job.type) {
+        case DEVICE_PROBE_GPU:
+            return arena::Collect(get_gpu_info_arena, blob) ? DEVICE_PROBE_STATUS_OK : DEVICE_PROBE_STATUS_FAILURE;
+        case DEVICE_PROBE_STORAGE:
+            return arena::Collect(get_storage_info_arena, blob) ? DEVICE_PROBE_STATUS_OK
+                                                                 : DEVICE_PROBE_STATUS_FAILURE;
+        default:
+            return DEVICE_PROBE_STATUS_UNSUPPORTED;
+    }
+}
+
+// IOKit needs no per-thread setup.
+void PlatformThreadEnter() {}
+void PlatformThreadExit() {}
+
+} // namespace probe
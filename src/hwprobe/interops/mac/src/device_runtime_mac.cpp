@@ -0,0 +1,17 @@
+#include "device_runtime.h"
+
+// ---- macOS backend: nothing to set up ----
+//
+// The library keeps no process-wide state on macOS outside the opt-in services: each call
+// creates its own IOKit iterators and CF objects, owns every one it creates or copies
+// (ScopedCFType, IOObjectRelease) and shares none with another call.
+
+namespace runtime {
+
+bool PlatformInit() {
+    return true;
+}
+
+void PlatformShutdown() {}
+
+} // namespace runtime
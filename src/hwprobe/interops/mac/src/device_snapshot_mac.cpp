@@ -0,0 +1,88 @@
+#include "device_snapshot.h"
+#include "gpu_info.h"
+#include "iokit_helpers.h"
+#include "storage_info.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <sys/sysctl.h>
+#include <IOKit/IOKitLib.h>
+
+// ---- macOS snapshot key and file I/O ----
+
+namespace snapshot {
+
+namespace {
+
+// Registry entry IDs are never reused within a boot, so a re-attached device changes them too.
+bool addServiceIds(const char *ioClass, Fingerprint &fingerprint) {
+    io_iterator_t iterator = 0;
+    if (IOServiceGetMatchingServices(getIOKitMainPort(), IOServiceMatching(ioClass), &iterator) != KERN_SUCCESS)
+        return false;
+
+    while (io_object_t service = IOIteratorNext(iterator)) {
+        uint64_t id = 0;
+        if (IORegistryEntryGetRegistryEntryID(service, &id) == KERN_SUCCESS) fingerprint.Add(id);
+        IOObjectRelease(service);
+    }
+    IOObjectRelease(iterator);
+    return true;
+}
+
+} // namespace
+
+bool PlatformKey(DeviceSnapshotKey &key) {
+    size_t size = sizeof(key.boot_id);
+    if (sysctlbyname("kern.bootsessionuuid", key.boot_id, &size, nullptr, 0) != 0) return false;
+
+    Fingerprint fingerprint;
+    if (!addServiceIds("IOPCIDevice", fingerprint) || !addServiceIds("IOBlockStorageDevice", fingerprint))
+        return false;
+    key.hardware_fingerprint = fingerprint.value();
+    return true;
+}
+
+std::vector<ArenaQuery> PlatformQueries() {
+    return {get_gpu_info_arena, get_storage_info_arena};
+}
+
+std::vector<RecordSchema> PlatformSchemas() {
+    return {
+        {DEVICE_ARENA_KIND_MAC_GPU,
+         {SNAPSHOT_FIELD(GPURecord, name, String), SNAPSHOT_FIELD(GPURecord, acpi_path, String),
+          SNAPSHOT_FIELD(GPURecord, pci_path, String), SNAPSHOT_FIELD(GPURecord, vendor_id, U32),
+          SNAPSHOT_FIELD(GPURecord, device_id, U32), SNAPSHOT_FIELD(GPURecord, is_apple_silicon, I32),
+          SNAPSHOT_FIELD(GPURecord, apple_gpu.core_count, I32), SNAPSHOT_FIELD(GPURecord, apple_gpu.gpu_perf_shaders, I32),
+          SNAPSHOT_FIELD(GPURecord, apple_gpu.gpu_gen, I32), SNAPSHOT_FIELD(GPURecord, apple_gpu.unified_memory_mb, U64),
+          SNAPSHOT_FIELD(GPURecord, vram_mb, U64)},
+         // The integrated GPU of Apple silicon is not a PCI device
+         {"pci_path", "acpi_path", "name"}},
+        {DEVICE_ARENA_KIND_MAC_STORAGE,
+         {SNAPSHOT_FIELD(StorageDeviceRecord, product_name, String),
+          SNAPSHOT_FIELD(StorageDeviceRecord, vendor_name, String),
+          SNAPSHOT_FIELD(StorageDeviceRecord, medium_type, String),
+          SNAPSHOT_FIELD(StorageDeviceRecord, interconnect, String),
+          SNAPSHOT_FIELD(StorageDeviceRecord, location, String), SNAPSHOT_FIELD(StorageDeviceRecord, bsd_name, String),
+          SNAPSHOT_FIELD(StorageDeviceRecord, size_bytes, U64),
+          SNAPSHOT_FIELD(StorageDeviceRecord, partition_count, I32),
+          SNAPSHOT_FIELD(StorageDeviceRecord, container_count, I32)},
+         {"bsd_name"}},
+    };
+}
+
+bool PlatformWriteAtomically(const std::string &path, const std::vector<unsigned char> &data) {
+    const std::string temp = path + ".tmp";
+    FILE *file = std::fopen(temp.c_str(), "wb");
+    if (!file) return false;
+
+    bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::remove(temp.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace snapshot
@@ -0,0 +1,114 @@
+#include "device_watch.h"
+#include "iokit_helpers.h"
+
+#include <cstdint>
+#include <vector>
+#include <dispatch/dispatch.h>
+#include <IOKit/IOKitLib.h>
+
+// ---- macOS backend: IOKit matching notifications on a private dispatch queue ----
+
+namespace {
+
+struct WatchedClass {
+    const char *ioClass;
+    DeviceWatchCategory category;
+};
+
+const WatchedClass kWatchedClasses[] = {
+    {"IOPCIDevice", DEVICE_WATCH_GPU},          // eGPUs and other PCI(e) hot-plug
+    {"IOBlockStorageDevice", DEVICE_WATCH_STORAGE},
+    {"IONetworkInterface", DEVICE_WATCH_NETWORK},
+    {"IODisplayConnect", DEVICE_WATCH_DISPLAY},
+};
+
+IONotificationPortRef g_port = nullptr;
+dispatch_queue_t g_queue = nullptr;
+std::vector<io_iterator_t> g_iterators;
+
+// Releasing every entry re-arms the notification; IOKit only fires again once it is empty.
+bool drain(io_iterator_t iterator) {
+    bool any = false;
+    while (io_object_t service = IOIteratorNext(iterator)) {
+        IOObjectRelease(service);
+        any = true;
+    }
+    return any;
+}
+
+void onMatchingChange(void *refcon, io_iterator_t iterator) {
+    if (drain(iterator))
+        device_watch::MarkChanged(static_cast<DeviceWatchCategory>(reinterpret_cast<uintptr_t>(refcon)));
+}
+
+bool addNotification(const io_name_t type, const WatchedClass &watched) {
+    // IOServiceAddMatchingNotification consumes the matching dictionary.
+    CFMutableDictionaryRef matching = IOServiceMatching(watched.ioClass);
+    if (!matching) return false;
+
+    io_iterator_t iterator = 0;
+    void *refcon = reinterpret_cast<void *>(static_cast<uintptr_t>(watched.category));
+    if (IOServiceAddMatchingNotification(g_port, type, matching, onMatchingChange, refcon, &iterator) !=
+        KERN_SUCCESS)
+        return false;
+
+    // Devices already present are part of the first enumeration, not a change.
+    drain(iterator);
+    g_iterators.push_back(iterator);
+    return true;
+}
+
+void teardown(void * = nullptr) {
+    for (io_iterator_t iterator : g_iterators) IOObjectRelease(iterator);
+    g_iterators.clear();
+    if (g_port) IONotificationPortDestroy(g_port);
+    g_port = nullptr;
+}
+
+// Runs on the queue, so no callback can race the initial drain.
+void registerAll(void *ok) {
+    bool &registered = *static_cast<bool *>(ok);
+    for (const auto &watched : kWatchedClasses) {
+        if (!addNotification(kIOFirstMatchNotification, watched) ||
+            !addNotification(kIOTerminatedNotification, watched)) {
+            registered = false;
+            break;
+        }
+    }
+    if (!registered) teardown();
+}
+
+} // namespace
+
+namespace device_watch {
+
+bool PlatformStart() {
+    g_port = IONotificationPortCreate(getIOKitMainPort());
+    if (!g_port) return false;
+
+    g_queue = dispatch_queue_create("hwprobe.device_watch", DISPATCH_QUEUE_SERIAL);
+    if (!g_queue) {
+        teardown();
+        return false;
+    }
+    IONotificationPortSetDispatchQueue(g_port, g_queue);
+
+    bool ok = true;
+    dispatch_sync_f(g_queue, &ok, registerAll);
+
+    if (!ok) {
+        dispatch_release(g_queue);
+        g_queue = nullptr;
+    }
+    return ok;
+}
+
+void PlatformStop() {
+    if (!g_queue) return;
+    // Torn down on the queue: once this returns, no callback is running or pending.
+    dispatch_sync_f(g_queue, nullptr, teardown);
+    dispatch_release(g_queue);
+    g_queue = nullptr;
+}
+
+} // namespace device_watch
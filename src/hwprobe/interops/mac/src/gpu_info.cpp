@@ -1,11 +1,14 @@
 #include "gpu_info.h"
 #include "iokit_helpers.h"
+#include "bench_stages.h"
 
 #include <cstdint>
 #include <string>
 #include <cstring>
 #include <vector>
 #include <algorithm>
+#include <unordered_map>
+#include <utility>
 #include <CoreFoundation/CoreFoundation.h>
 #include <IOKit/IOKitLib.h>
 #include <sys/sysctl.h>
@@ -47,61 +50,110 @@ static CFDictionaryRef buildMatchingDict(bool is_arm) {
 
 // ---- PCI / ACPI path helpers ----
 
-static std::string constructPciPath(io_service_t service) {
-    std::vector<std::string> segments;
+// Path contributed by a registry entry and everything above it, e.g. "PciRoot(0x0)/Pci(0x1,0x0)".
+// `valid == false` means the walk reached an entry that is neither PCI nor ACPI, so no path exists.
+struct PciPathPrefix {
+    bool valid = true;
+    std::string path;
+};
+
+// Memoizes path prefixes by registry entry ID, so GPUs behind the same root port / bridges only
+// pay for the shared part of the walk once per get_gpu_info call.
+class PciPathCache {
+public:
+    std::string resolve(io_service_t service);
+
+private:
+    std::unordered_map<uint64_t, PciPathPrefix> prefixes_;
+};
+
+static bool readPciSegment(io_service_t entry, std::string &segment) {
+    io_name_t location{};
+    if (IORegistryEntryGetLocationInPlane(entry, kIOServicePlane, location) != KERN_SUCCESS)
+        return false;
+
+    std::string loc(location);
+    try {
+        unsigned long busVal = 0, funcVal = 0;
+        auto comma = loc.find(',');
+        if (comma != std::string::npos) {
+            busVal = std::stoul(loc.substr(0, comma), nullptr, 16);
+            funcVal = std::stoul(loc.substr(comma + 1), nullptr, 16);
+        } else {
+            busVal = std::stoul(loc, nullptr, 16);
+        }
+        char seg[64];
+        std::snprintf(seg, sizeof(seg), "Pci(0x%lx,0x%lx)", busVal, funcVal);
+        segment = seg;
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+static std::string readAcpiRootSegment(io_service_t entry) {
+    int uid = 0;
+    ScopedCFType uidRef = copyRegistryProperty(entry, CFSTR("_UID"));
+    if (uidRef.is(CFNumberGetTypeID())) {
+        CFNumberGetValue(static_cast<CFNumberRef>(uidRef.get()), kCFNumberIntType, &uid);
+    } else if (uidRef.is(CFStringGetTypeID())) {
+        std::string uidStr = readCFString(static_cast<CFStringRef>(uidRef.get()));
+        try { uid = std::stoi(uidStr); } catch (...) {
+        }
+    }
+    char seg[64];
+    std::snprintf(seg, sizeof(seg), "PciRoot(0x%x)", uid);
+    return seg;
+}
+
+static void appendSegment(std::string &path, const std::string &segment) {
+    if (segment.empty()) return;
+    if (!path.empty()) path += '/';
+    path += segment;
+}
+
+std::string PciPathCache::resolve(io_service_t service) {
+    DEVICE_INFO_STAGE("PciPathCache::resolve");
+    // Walk up the service plane until an entry whose prefix is known (cached or terminal),
+    // remembering the segments on the way, then fill the cache back down.
+    std::vector<std::pair<uint64_t, std::string>> pending;
+    PciPathPrefix base;
+
     io_service_t entry = service;
     IOObjectRetain(entry);
 
     while (entry) {
-        if (IOObjectConformsTo(entry, "IOPCIDevice")) {
-            io_name_t location{};
-            kern_return_t kr = IORegistryEntryGetLocationInPlane(entry, kIOServicePlane, location);
-            if (kr != KERN_SUCCESS) {
-                IOObjectRelease(entry);
-                break;
-            }
-            std::string loc(location);
-            try {
-                unsigned long busVal = 0, funcVal = 0;
-                auto comma = loc.find(',');
-                if (comma != std::string::npos) {
-                    busVal = std::stoul(loc.substr(0, comma), nullptr, 16);
-                    funcVal = std::stoul(loc.substr(comma + 1), nullptr, 16);
-                } else {
-                    busVal = std::stoul(loc, nullptr, 16);
-                }
-                char seg[64];
-                std::snprintf(seg, sizeof(seg), "Pci(0x%lx,0x%lx)", busVal, funcVal);
-                segments.emplace_back(seg);
-            } catch (...) {
-                IOObjectRelease(entry);
-                break;
-            }
-        } else if (IOObjectConformsTo(entry, "IOACPIPlatformDevice")) {
-            int uid = 0;
-            CFTypeRef uidRef = IORegistryEntryCreateCFProperty(entry, CFSTR("_UID"), kCFAllocatorDefault, kNilOptions);
-            if (uidRef) {
-                if (CFGetTypeID(uidRef) == CFNumberGetTypeID()) {
-                    CFNumberGetValue(static_cast<CFNumberRef>(uidRef), kCFNumberIntType, &uid);
-                } else if (CFGetTypeID(uidRef) == CFStringGetTypeID()) {
-                    std::string uidStr = readCFString(static_cast<CFStringRef>(uidRef));
-                    try { uid = std::stoi(uidStr); } catch (...) {
-                    }
-                }
-                CFRelease(uidRef);
-            }
-            char seg[64];
-            std::snprintf(seg, sizeof(seg), "PciRoot(0x%x)", uid);
-            segments.emplace_back(seg);
+        uint64_t id = 0;
+        IORegistryEntryGetRegistryEntryID(entry, &id);
+
+        auto cached = prefixes_.find(id);
+        if (cached != prefixes_.end()) {
+            base = cached->second;
             IOObjectRelease(entry);
             break;
+        }
+
+        std::string segment;
+        bool terminal = false;
+        if (IOObjectConformsTo(entry, "IOPCIDevice")) {
+            // An unreadable location ends the path here, keeping what was collected below it.
+            terminal = !readPciSegment(entry, segment);
+        } else if (IOObjectConformsTo(entry, "IOACPIPlatformDevice")) {
+            base.path = readAcpiRootSegment(entry);
+            terminal = true;
         } else if (IOObjectConformsTo(entry, "IOPCIBridge")) {
             // Skip bridges, keep walking
         } else {
-            segments.clear();
+            base.valid = false;
+            terminal = true;
+        }
+
+        if (terminal) {
+            prefixes_.emplace(id, base);
             IOObjectRelease(entry);
             break;
         }
+        pending.emplace_back(id, std::move(segment));
 
         io_service_t parent = 0;
         kern_return_t kr = IORegistryEntryGetParentEntry(entry, kIOServicePlane, &parent);
@@ -111,20 +163,16 @@ static std::string constructPciPath(io_service_t service) {
         entry = parent;
     }
 
-    if (segments.empty())
-        return {};
-
-    std::reverse(segments.begin(), segments.end());
-    std::string result;
-    for (size_t i = 0; i < segments.size(); ++i) {
-        if (i > 0) result += '/';
-        result += segments[i];
+    for (auto it = pending.rbegin(); it != pending.rend(); ++it) {
+        if (base.valid)
+            appendSegment(base.path, it->second);
+        prefixes_.emplace(it->first, base);
     }
-    return result;
+
+    return base.valid ? base.path : std::string{};
 }
 
-static std::string parseAcpiPath(CFDictionaryRef props) {
-    CFTypeRef ref = CFDictionaryGetValue(props, CFSTR("acpi-path"));
+static std::string parseAcpiPath(CFTypeRef ref) {
     if (!ref) return {};
 
     std::string raw;
@@ -182,26 +230,55 @@ static std::string parseAcpiPath(CFDictionaryRef props) {
 
 // ---- VRAM helper ----
 
-static uint64_t getDiscreteVramMB(io_service_t service) {
-    // Try "VRAM,totalMB" first (directly in MB).
-    // IOKit may store this as CFNumber or CFData depending on the GPU driver.
-    // Search the service and its children recursively.
-    CFTypeRef ref = IORegistryEntrySearchCFProperty(
-        service, kIOServicePlane, CFSTR("VRAM,totalMB"),
-        kCFAllocatorDefault, kIORegistryIterateRecursively);
-    if (ref) {
-        uint64_t mb = readCFTypeAsUInt64(ref);
-        CFRelease(ref);
-        if (mb > 0) return mb;
+// "VRAM,totalMB" is published on the IOPCIDevice itself or on the accelerator / framebuffer
+// driver attached under it, so there is no need to search the whole subtree below the GPU.
+constexpr int kVramSearchDepth = 2;
+
+// First positive value of `key` on `entry` or its children down to `depth` levels. Drivers can leave a
+// zero placeholder on one entry while another in the subtree carries the real size, so zero keeps searching.
+static uint64_t findPositiveValueToDepth(io_registry_entry_t entry, CFStringRef key, int depth) {
+    ScopedCFType ref = copyRegistryProperty(entry, key);
+    const uint64_t value = readCFTypeAsUInt64(ref.get());
+    if (value > 0 || depth <= 0)
+        return value;
+
+    io_iterator_t children = 0;
+    if (IORegistryEntryGetChildIterator(entry, kIOServicePlane, &children) != KERN_SUCCESS || !children)
+        return 0;
+
+    io_registry_entry_t child;
+    uint64_t found = 0;
+    while (!found && (child = IOIteratorNext(children)) != 0) {
+        found = findPositiveValueToDepth(child, key, depth - 1);
+        IOObjectRelease(child);
     }
-    return 0;
+    IOObjectRelease(children);
+    return found;
 }
 
-// ---- Public API ----
-
-int get_gpu_info(GPUProperties *out, int max_count) {
-    if (!out || max_count <= 0) return -1;
+static uint64_t getDiscreteVramMB(io_service_t service) {
+    DEVICE_INFO_STAGE("getDiscreteVramMB");
+    // IOKit may store this as CFNumber or CFData depending on the GPU driver.
+    return findPositiveValueToDepth(service, CFSTR("VRAM,totalMB"), kVramSearchDepth);
+}
 
+// ---- Enumeration ----
+
+struct GpuEntry {
+    std::string name;
+    std::string acpi_path;
+    std::string pci_path;
+    uint32_t vendor_id = 0;
+    uint32_t device_id = 0;
+    bool is_apple_silicon = false;
+    AppleGPUProperties apple_gpu{};
+    uint64_t vram_mb = 0;
+};
+
+// Enumerates GPU services (stopping after `limit` GPUs). Returns false if IOKit matching fails.
+// `services` (optional) receives each GPU's service, retained.
+static bool collectGpus(std::vector<GpuEntry> &gpus, size_t limit, std::vector<io_service_t> *services = nullptr) {
+    DEVICE_INFO_STAGE("collectGpus");
 #if defined(__arm64__)
     constexpr bool is_arm = true;
 #else
@@ -216,88 +293,136 @@ int get_gpu_info(GPUProperties *out, int max_count) {
     io_iterator_t iterator = 0;
     kern_return_t kr = IOServiceGetMatchingServices(ioPort, matching, &iterator);
     if (kr != KERN_SUCCESS)
-        return -1;
+        return false;
 
-    int count = 0;
     io_service_t service;
 
-    while ((service = IOIteratorNext(iterator)) != 0 && count < max_count) {
-        CFMutableDictionaryRef props = nullptr;
-        if (IORegistryEntryCreateCFProperties(service, &props, kCFAllocatorDefault, kNilOptions) != KERN_SUCCESS) {
-            IOObjectRelease(service);
-            continue;
-        }
-
+    // Only the keys below are read, one targeted copy each: the full property table of a GPU
+    // service also carries large blobs (performance statistics, EDIDs, firmware) we never use.
+    PciPathCache pciPaths;
+    while (gpus.size() < limit && (service = IOIteratorNext(iterator)) != 0) {
         // Filter non-GPU entries on ARM
         if (is_arm) {
-            std::string ioName = readCFString(
-                static_cast<CFStringRef>(CFDictionaryGetValue(props, CFSTR("IONameMatched"))));
-            std::string bundle = readCFString(
-                static_cast<CFStringRef>(CFDictionaryGetValue(props, CFSTR("CFBundleIdentifierKernel"))));
+            ScopedCFType ioNameRef = copyRegistryProperty(service, CFSTR("IONameMatched"));
+            ScopedCFType bundleRef = copyRegistryProperty(service, CFSTR("CFBundleIdentifierKernel"));
+            std::string ioName = ioNameRef.is(CFStringGetTypeID())
+                                     ? readCFString(static_cast<CFStringRef>(ioNameRef.get())) : std::string{};
+            std::string bundle = bundleRef.is(CFStringGetTypeID())
+                                     ? readCFString(static_cast<CFStringRef>(bundleRef.get())) : std::string{};
             if (ioName.find("gpu") == std::string::npos && bundle.find("AGX") == std::string::npos) {
-                CFRelease(props);
                 IOObjectRelease(service);
                 continue;
             }
         }
 
-        GPUProperties gpu{};
-        gpu.vendor_id = readUInt32(props, CFSTR("vendor-id"));
-        gpu.device_id = readUInt32(props, CFSTR("device-id"));
-
-        CFTypeRef modelRef = CFDictionaryGetValue(props, CFSTR("model"));
-        if (modelRef) {
-            if (CFGetTypeID(modelRef) == CFStringGetTypeID()) {
-                // Apple Silicon / some entries expose model as CFString
-                std::string n = readCFString(static_cast<CFStringRef>(modelRef));
-                std::strncpy(gpu.name, n.c_str(), sizeof(gpu.name) - 1);
-            } else if (CFGetTypeID(modelRef) == CFDataGetTypeID()) {
-                // PCI GPUs (AMD, NVIDIA, Intel) store model as a null-terminated
-                // byte sequence inside a CFData blob
-                auto data = static_cast<CFDataRef>(modelRef);
-                CFIndex len = CFDataGetLength(data);
-                if (len > 0) {
-                    CFIndex copy = std::min(len, static_cast<CFIndex>(sizeof(gpu.name) - 1));
-                    CFDataGetBytes(data, CFRangeMake(0, copy),
-                                   reinterpret_cast<UInt8 *>(gpu.name));
-                    gpu.name[copy] = '\0';
-                }
+        GpuEntry gpu;
+        gpu.vendor_id = readCFDataAsUInt32(copyRegistryProperty(service, CFSTR("vendor-id")).get());
+        gpu.device_id = readCFDataAsUInt32(copyRegistryProperty(service, CFSTR("device-id")).get());
+
+        ScopedCFType modelRef = copyRegistryProperty(service, CFSTR("model"));
+        if (modelRef.is(CFStringGetTypeID())) {
+            // Apple Silicon / some entries expose model as CFString
+            gpu.name = readCFString(static_cast<CFStringRef>(modelRef.get()));
+        } else if (modelRef.is(CFDataGetTypeID())) {
+            // PCI GPUs (AMD, NVIDIA, Intel) store model as a null-terminated
+            // byte sequence inside a CFData blob
+            auto data = static_cast<CFDataRef>(modelRef.get());
+            CFIndex len = CFDataGetLength(data);
+            if (len > 0) {
+                const auto *bytes = reinterpret_cast<const char *>(CFDataGetBytePtr(data));
+                gpu.name.assign(bytes, strnlen(bytes, static_cast<size_t>(len)));
             }
         }
 
-        if (gpu.name[0] != '\0' || gpu.vendor_id != 0) {
+        if (!gpu.name.empty() || gpu.vendor_id != 0) {
             if (is_arm) {
-                gpu.is_apple_silicon = 1;
+                gpu.is_apple_silicon = true;
                 gpu.apple_gpu.unified_memory_mb = getSystemMemoryMB();
 
-                CFTypeRef configRef = CFDictionaryGetValue(props, CFSTR("GPUConfigurationVariable"));
-                if (configRef && CFGetTypeID(configRef) == CFDictionaryGetTypeID()) {
-                    auto gpuConfig = static_cast<CFDictionaryRef>(configRef);
+                ScopedCFType configRef = copyRegistryProperty(service, CFSTR("GPUConfigurationVariable"));
+                if (configRef.is(CFDictionaryGetTypeID())) {
+                    auto gpuConfig = static_cast<CFDictionaryRef>(configRef.get());
                     gpu.apple_gpu.core_count = getAppleGpuProperty(gpuConfig, CFSTR("num_cores"));
                     gpu.apple_gpu.gpu_perf_shaders = getAppleGpuProperty(gpuConfig, CFSTR("num_gps"));
                     gpu.apple_gpu.gpu_gen = getAppleGpuProperty(gpuConfig, CFSTR("gpu_gen"));
                 }
             } else {
-                gpu.is_apple_silicon = 0;
+                gpu.is_apple_silicon = false;
 
-                std::string pciPath = constructPciPath(service);
-                if (!pciPath.empty())
-                    std::strncpy(gpu.pci_path, pciPath.c_str(), sizeof(gpu.pci_path) - 1);
+                gpu.pci_path = pciPaths.resolve(service);
 
-                std::string acpiPath = parseAcpiPath(props);
-                if (!acpiPath.empty())
-                    std::strncpy(gpu.acpi_path, acpiPath.c_str(), sizeof(gpu.acpi_path) - 1);
+                ScopedCFType acpiRef = copyRegistryProperty(service, CFSTR("acpi-path"));
+                gpu.acpi_path = parseAcpiPath(acpiRef.get());
 
                 gpu.vram_mb = getDiscreteVramMB(service);
             }
-            out[count++] = gpu;
+            gpus.push_back(std::move(gpu));
+            if (services) {
+                IOObjectRetain(service);
+                services->push_back(service);
+            }
         }
 
-        CFRelease(props);
         IOObjectRelease(service);
     }
 
     IOObjectRelease(iterator);
+    return true;
+}
+
+// ---- Public API ----
+
+bool gpu_info::collectServices(std::vector<io_service_t> &out) {
+    std::vector<GpuEntry> gpus;
+    return collectGpus(gpus, SIZE_MAX, &out);
+}
+
+int get_gpu_info(GPUProperties *out, int max_count) {
+    if (!out || max_count <= 0) return -1;
+
+    std::vector<GpuEntry> gpus;
+    if (!collectGpus(gpus, static_cast<size_t>(max_count)))
+        return -1;
+
+    int count = 0;
+    for (const GpuEntry &entry : gpus) {
+        GPUProperties gpu{};
+        std::strncpy(gpu.name, entry.name.c_str(), sizeof(gpu.name) - 1);
+        std::strncpy(gpu.acpi_path, entry.acpi_path.c_str(), sizeof(gpu.acpi_path) - 1);
+        std::strncpy(gpu.pci_path, entry.pci_path.c_str(), sizeof(gpu.pci_path) - 1);
+        gpu.vendor_id = entry.vendor_id;
+        gpu.device_id = entry.device_id;
+        gpu.is_apple_silicon = entry.is_apple_silicon ? 1 : 0;
+        gpu.apple_gpu = entry.apple_gpu;
+        gpu.vram_mb = entry.vram_mb;
+        out[count++] = gpu;
+    }
     return count;
 }
 
+int get_gpu_info_arena(DeviceArena **out) {
+    if (!out) return DEVICE_ARENA_STATUS_INVALID_ARG;
+    *out = nullptr;
+
+    std::vector<GpuEntry> gpus;
+    if (!collectGpus(gpus, SIZE_MAX))
+        return DEVICE_ARENA_STATUS_FAILURE;
+
+    arena::Builder builder(DEVICE_ARENA_KIND_MAC_GPU, sizeof(GPURecord));
+    for (const GpuEntry &entry : gpus) {
+        GPURecord record{};
+        record.name = builder.Intern(entry.name);
+        record.acpi_path = builder.Intern(entry.acpi_path);
+        record.pci_path = builder.Intern(entry.pci_path);
+        record.vendor_id = entry.vendor_id;
+        record.device_id = entry.device_id;
+        record.is_apple_silicon = entry.is_apple_silicon ? 1 : 0;
+        record.apple_gpu = entry.apple_gpu;
+        record.vram_mb = entry.vram_mb;
+        builder.Append(&record);
+    }
+
+    *out = builder.Finish();
+    return *out ? DEVICE_ARENA_STATUS_OK : DEVICE_ARENA_STATUS_FAILURE;
+}
+
@@ -0,0 +1,136 @@
+#include "gpu_telemetry.h"
+#include "gpu_info.h"
+#include "iokit_helpers.h"
+
+#include <cstdint>
+#include <vector>
+#include <CoreFoundation/CoreFoundation.h>
+#include <IOKit/IOKitLib.h>
+
+// ---- macOS backend: the accelerator's PerformanceStatistics dictionary ----
+
+namespace {
+
+// The IOAccelerator is the GPU service itself on Apple Silicon, and attached below the
+// IOPCIDevice (directly or under its framebuffer driver) otherwise.
+constexpr int kAcceleratorSearchDepth = 2;
+
+struct Gpu {
+    uint32_t index = 0;
+    io_service_t service = 0;      // the get_gpu_info service; IOPCIDevice on Intel Macs
+    io_registry_entry_t accelerator = 0;
+    bool pci = false;
+};
+
+std::vector<Gpu> g_gpus;
+
+io_registry_entry_t findAccelerator(io_registry_entry_t entry, int depth) {
+    if (IOObjectConformsTo(entry, "IOAccelerator")) {
+        IOObjectRetain(entry);
+        return entry;
+    }
+    if (depth <= 0) return 0;
+
+    io_iterator_t children = 0;
+    if (IORegistryEntryGetChildIterator(entry, kIOServicePlane, &children) != KERN_SUCCESS || !children)
+        return 0;
+
+    io_registry_entry_t found = 0;
+    io_registry_entry_t child;
+    while (!found && (child = IOIteratorNext(children)) != 0) {
+        found = findAccelerator(child, depth - 1);
+        IOObjectRelease(child);
+    }
+    IOObjectRelease(children);
+    return found;
+}
+
+bool readNumber(CFDictionaryRef stats, CFStringRef key, uint64_t &out) {
+    CFTypeRef value = CFDictionaryGetValue(stats, key);
+    if (!value || CFGetTypeID(value) != CFNumberGetTypeID()) return false;
+    out = readCFTypeAsUInt64(value);
+    return true;
+}
+
+void readStatistics(const Gpu &gpu, GpuTelemetrySample &sample) {
+    if (!gpu.accelerator) return;
+    ScopedCFType statsRef = copyRegistryProperty(gpu.accelerator, CFSTR("PerformanceStatistics"));
+    if (!statsRef.is(CFDictionaryGetTypeID())) return;
+    auto stats = static_cast<CFDictionaryRef>(statsRef.get());
+
+    // Key names differ between the Apple, AMD and Intel drivers
+    uint64_t value = 0;
+    if (readNumber(stats, CFSTR("Device Utilization %"), value) || readNumber(stats, CFSTR("GPU Activity(%)"), value)) {
+        sample.utilization_percent = static_cast<uint32_t>(value);
+        sample.fields |= GPU_TELEMETRY_FIELD_UTILIZATION;
+    }
+
+    uint64_t used = 0, free = 0;
+    if (readNumber(stats, CFSTR("vramUsedBytes"), used)) {
+        sample.memory_used_bytes = used;
+        sample.fields |= GPU_TELEMETRY_FIELD_MEMORY_USED;
+        if (readNumber(stats, CFSTR("vramFreeBytes"), free)) {
+            sample.memory_budget_bytes = used + free;
+            sample.fields |= GPU_TELEMETRY_FIELD_MEMORY_BUDGET;
+        }
+    }
+
+    // Unified memory (Apple Silicon, Intel integrated) is reported as system memory in use
+    if (readNumber(stats, CFSTR("gartUsedBytes"), value) || readNumber(stats, CFSTR("In use system memory"), value)) {
+        sample.shared_memory_used_bytes = value;
+        sample.fields |= GPU_TELEMETRY_FIELD_SHARED_MEMORY_USED;
+    }
+}
+
+// IOPCIExpressLinkStatus is the PCIe Link Status register: speed in bits 3:0, width in bits 9:4.
+void readLinkStatus(const Gpu &gpu, GpuTelemetrySample &sample) {
+    if (!gpu.pci) return;
+    ScopedCFType status = copyRegistryProperty(gpu.service, CFSTR("IOPCIExpressLinkStatus"));
+    if (!status.is(CFNumberGetTypeID())) return;
+
+    const uint64_t value = readCFTypeAsUInt64(status.get());
+    sample.pcie_gen = static_cast<int32_t>(value & 0xF);
+    sample.pcie_width = static_cast<int32_t>((value >> 4) & 0x3F);
+    sample.fields |= GPU_TELEMETRY_FIELD_PCIE_LINK;
+}
+
+} // namespace
+
+namespace gpu_telemetry {
+
+bool PlatformOpen() {
+    std::vector<io_service_t> services;
+    if (!gpu_info::collectServices(services) || services.empty()) return false;
+
+    g_gpus.clear();
+    for (size_t i = 0; i < services.size(); ++i) {
+        Gpu gpu;
+        gpu.index = static_cast<uint32_t>(i);
+        gpu.service = services[i];
+        gpu.accelerator = findAccelerator(services[i], kAcceleratorSearchDepth);
+        gpu.pci = IOObjectConformsTo(services[i], "IOPCIDevice");
+        g_gpus.push_back(gpu);
+    }
+    return true;
+}
+
+void PlatformSample() {
+    for (const Gpu &gpu : g_gpus) {
+        GpuTelemetrySample sample{};
+        sample.gpu_index = gpu.index;
+        sample.timestamp_ns = NowNs();
+        readStatistics(gpu, sample);
+        readLinkStatus(gpu, sample);
+        Publish(sample);
+    }
+}
+
+void PlatformClose() {
+    for (Gpu &gpu : g_gpus) {
+        if (gpu.accelerator) IOObjectRelease(gpu.accelerator);
+        IOObjectRelease(gpu.service);
+    }
+    g_gpus.clear();
+}
+
+} // namespace gpu_telemetry
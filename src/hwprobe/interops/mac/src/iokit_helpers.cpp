@@ -18,8 +18,15 @@ std::string readCFString(CFStringRef cfStr) {
     return {};
 }
 
+ScopedCFType copyRegistryProperty(io_registry_entry_t entry, CFStringRef key) {
+    return ScopedCFType(IORegistryEntryCreateCFProperty(entry, key, kCFAllocatorDefault, kNilOptions));
+}
+
 uint32_t readUInt32(const CFDictionaryRef dict, const CFStringRef key) {
-    const CFTypeRef ref = CFDictionaryGetValue(dict, key);
+    return readCFDataAsUInt32(CFDictionaryGetValue(dict, key));
+}
+
+uint32_t readCFDataAsUInt32(const CFTypeRef ref) {
     if (!ref || CFGetTypeID(ref) != CFDataGetTypeID())
         return 0;
     uint32_t value = 0;
@@ -1,136 +1,295 @@
 #include "storage_info.h"
 #include "iokit_helpers.h"
+#include "bench_stages.h"
 
+#include <cstdint>
 #include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <CoreFoundation/CoreFoundation.h>
 #include <IOKit/IOKitLib.h>
 
-// Recursively searches children of `entry` for a "Whole" IOMedia node.
-// Returns its properties dictionary (caller must CFRelease), or nullptr if not found.
-static CFMutableDictionaryRef findWholeMedia(io_service_t entry) {
+// ---- IOMedia index ----
+
+// What a block device's media tree looks like, gathered for every device in one pass.
+struct MediaSummary {
+    io_registry_entry_t whole = 0; // the device's own Whole IOMedia (retained), 0 if none
+    int partitions = 0; // non-Whole IOMedia directly on the device's whole media
+    int containers = 0; // Whole IOMedia nested below it (APFS containers, CoreStorage volumes...)
+};
+
+// Where a registry entry sits: the IOBlockStorageDevice above it and the nearest Whole IOMedia
+// at or above it. Zero IDs mean "none".
+struct MediaOwner {
+    uint64_t device = 0;
+    uint64_t whole = 0;
+};
+
+static bool isWholeMedia(io_registry_entry_t entry) {
+    ScopedCFType whole = copyRegistryProperty(entry, CFSTR("Whole"));
+    return whole.is(CFBooleanGetTypeID()) && CFBooleanGetValue(static_cast<CFBooleanRef>(whole.get()));
+}
+
+// Builds the per-device summaries from a single iteration over all IOMedia objects. Owners are
+// memoized by registry entry ID, so each partition scheme, container and driver above a media
+// object is visited once no matter how many media objects share it.
+class MediaIndex {
+public:
+    MediaIndex() { build(); }
+    ~MediaIndex() {
+        for (auto &entry : summaries_)
+            if (entry.second.whole) IOObjectRelease(entry.second.whole);
+    }
+
+    MediaIndex(const MediaIndex &) = delete;
+    MediaIndex &operator=(const MediaIndex &) = delete;
+
+    const MediaSummary *find(uint64_t device_id) const {
+        auto it = summaries_.find(device_id);
+        return it != summaries_.end() ? &it->second : nullptr;
+    }
+
+private:
+    void build();
+    MediaOwner ownerOf(io_registry_entry_t entry);
+
+    std::unordered_map<uint64_t, MediaOwner> owners_;
+    std::unordered_map<uint64_t, MediaSummary> summaries_;
+};
+
+MediaOwner MediaIndex::ownerOf(io_registry_entry_t entry) {
+    // Walk up to the first entry whose owner is known, then fill the cache back down.
+    std::vector<std::pair<uint64_t, bool>> pending; // (entry ID, is Whole IOMedia)
+    MediaOwner base;
+
+    IOObjectRetain(entry);
+    while (entry) {
+        uint64_t id = 0;
+        IORegistryEntryGetRegistryEntryID(entry, &id);
+
+        auto cached = owners_.find(id);
+        if (cached != owners_.end()) {
+            base = cached->second;
+            IOObjectRelease(entry);
+            break;
+        }
+        if (IOObjectConformsTo(entry, "IOBlockStorageDevice")) {
+            base.device = id;
+            owners_.emplace(id, base);
+            IOObjectRelease(entry);
+            break;
+        }
+        pending.emplace_back(id, IOObjectConformsTo(entry, "IOMedia") && isWholeMedia(entry));
+
+        io_registry_entry_t parent = 0;
+        kern_return_t kr = IORegistryEntryGetParentEntry(entry, kIOServicePlane, &parent);
+        IOObjectRelease(entry);
+        if (kr != KERN_SUCCESS)
+            break;
+        entry = parent;
+    }
+
+    for (auto it = pending.rbegin(); it != pending.rend(); ++it) {
+        if (it->second) base.whole = it->first;
+        owners_.emplace(it->first, base);
+    }
+    return base;
+}
+
+void MediaIndex::build() {
+    DEVICE_INFO_STAGE("MediaIndex::build");
+    // NOTE: IOServiceGetMatchingServices takes ownership of the matching dict.
     io_iterator_t iterator = 0;
-    kern_return_t kr = IORegistryEntryGetChildIterator(entry, kIOServicePlane, &iterator);
-    if (kr != KERN_SUCCESS || !iterator)
-        return nullptr;
-
-    io_service_t child;
-    while ((child = IOIteratorNext(iterator)) != 0) {
-        if (IOObjectConformsTo(child, "IOMedia")) {
-            CFMutableDictionaryRef props = nullptr;
-            if (IORegistryEntryCreateCFProperties(child, &props, kCFAllocatorDefault, kNilOptions) == KERN_SUCCESS &&
-                props) {
-                CFTypeRef wholeRef = CFDictionaryGetValue(props, CFSTR("Whole"));
-                if (wholeRef && CFGetTypeID(wholeRef) == CFBooleanGetTypeID() &&
-                    CFBooleanGetValue(static_cast<CFBooleanRef>(wholeRef))) {
-                    IOObjectRelease(child);
-                    IOObjectRelease(iterator);
-                    return props;
-                }
-                CFRelease(props);
-            }
+    if (IOServiceGetMatchingServices(getIOKitMainPort(), IOServiceMatching("IOMedia"), &iterator) != KERN_SUCCESS)
+        return;
+
+    // Media are classified by the nearest Whole IOMedia *above* them, so remember per whole media
+    // how many non-Whole children it has until we know which whole media is a device's own.
+    std::unordered_map<uint64_t, int> partitionsByWhole;
+
+    io_registry_entry_t media;
+    while ((media = IOIteratorNext(iterator)) != 0) {
+        MediaOwner self = ownerOf(media);
+        if (!self.device) {
+            IOObjectRelease(media);
+            continue;
         }
 
-        // Recurse into children
-        CFMutableDictionaryRef result = findWholeMedia(child);
-        IOObjectRelease(child);
-        if (result) {
-            IOObjectRelease(iterator);
-            return result;
+        uint64_t id = 0;
+        IORegistryEntryGetRegistryEntryID(media, &id);
+        const bool whole = self.whole == id;
+
+        io_registry_entry_t parent = 0;
+        MediaOwner above;
+        if (IORegistryEntryGetParentEntry(media, kIOServicePlane, &parent) == KERN_SUCCESS) {
+            above = ownerOf(parent);
+            IOObjectRelease(parent);
         }
-    }
 
+        MediaSummary &summary = summaries_[self.device];
+        if (whole && !above.whole && !summary.whole) {
+            summary.whole = media; // keeps the reference
+            continue;
+        }
+        if (whole)
+            ++summary.containers;
+        else if (above.whole)
+            ++partitionsByWhole[above.whole];
+        IOObjectRelease(media);
+    }
     IOObjectRelease(iterator);
-    return nullptr;
+
+    for (auto &entry : summaries_) {
+        MediaSummary &summary = entry.second;
+        if (!summary.whole) continue;
+        uint64_t wholeId = 0;
+        IORegistryEntryGetRegistryEntryID(summary.whole, &wholeId);
+        auto it = partitionsByWhole.find(wholeId);
+        if (it != partitionsByWhole.end())
+            summary.partitions = it->second;
+    }
 }
 
-static void copyTrimmedString(const std::string &src, char *dst, size_t dst_size) {
+static std::string trimmed(const std::string &src) {
     // Trim leading and trailing whitespace
     size_t start = src.find_first_not_of(" \t\n\r");
     size_t end = src.find_last_not_of(" \t\n\r");
-    if (start == std::string::npos) {
-        dst[0] = '\0';
-        return;
-    }
-    std::string trimmed = src.substr(start, end - start + 1);
-    std::strncpy(dst, trimmed.c_str(), dst_size - 1);
+    if (start == std::string::npos)
+        return {};
+    return src.substr(start, end - start + 1);
+}
+
+static void copyString(const std::string &src, char *dst, size_t dst_size) {
+    std::strncpy(dst, src.c_str(), dst_size - 1);
     dst[dst_size - 1] = '\0';
 }
 
-int get_storage_info(StorageDeviceProperties *out, int max_count) {
-    if (!out || max_count <= 0) return -1;
+// ---- Enumeration ----
+
+struct StorageEntry {
+    std::string product_name;
+    std::string vendor_name;
+    std::string medium_type;
+    std::string interconnect;
+    std::string location;
+    std::string bsd_name;
+    uint64_t size_bytes = 0;
+    int partition_count = 0;
+    int container_count = 0;
+};
 
+// Enumerates block storage devices (stopping after `limit`). Returns false if IOKit matching fails.
+static bool collectStorage(std::vector<StorageEntry> &devices, size_t limit) {
+    DEVICE_INFO_STAGE("collectStorage");
     mach_port_t ioPort = getIOKitMainPort();
 
     CFMutableDictionaryRef matching = IOServiceMatching("IOBlockStorageDevice");
-    if (!matching) return -1;
+    if (!matching) return false;
 
     io_iterator_t iterator = 0;
     kern_return_t kr = IOServiceGetMatchingServices(ioPort, matching, &iterator);
     if (kr != KERN_SUCCESS)
-        return -1;
+        return false;
 
-    int count = 0;
     io_service_t service;
 
-    while ((service = IOIteratorNext(iterator)) != 0 && count < max_count) {
-        CFMutableDictionaryRef props = nullptr;
-        if (IORegistryEntryCreateCFProperties(service, &props, kCFAllocatorDefault, kNilOptions) != KERN_SUCCESS || !
-            props) {
-            IOObjectRelease(service);
-            continue;
-        }
-
-        StorageDeviceProperties dev{};
+    MediaIndex media;
+    while (devices.size() < limit && (service = IOIteratorNext(iterator)) != 0) {
+        StorageEntry dev;
 
         // Read "Device Characteristics" sub-dictionary
-        CFTypeRef devCharRef = CFDictionaryGetValue(props, CFSTR("Device Characteristics"));
-        if (devCharRef && CFGetTypeID(devCharRef) == CFDictionaryGetTypeID()) {
-            auto devChar = static_cast<CFDictionaryRef>(devCharRef);
-
-            std::string productName = readCFStringFromDict(devChar, CFSTR("Product Name"));
-            copyTrimmedString(productName, dev.product_name, sizeof(dev.product_name));
-
-            std::string vendorName = readCFStringFromDict(devChar, CFSTR("Vendor Name"));
-            copyTrimmedString(vendorName, dev.vendor_name, sizeof(dev.vendor_name));
-
-            std::string mediumType = readCFStringFromDict(devChar, CFSTR("Medium Type"));
-            copyTrimmedString(mediumType, dev.medium_type, sizeof(dev.medium_type));
+        ScopedCFType devCharRef = copyRegistryProperty(service, CFSTR("Device Characteristics"));
+        if (devCharRef.is(CFDictionaryGetTypeID())) {
+            auto devChar = static_cast<CFDictionaryRef>(devCharRef.get());
+            dev.product_name = trimmed(readCFStringFromDict(devChar, CFSTR("Product Name")));
+            dev.vendor_name = trimmed(readCFStringFromDict(devChar, CFSTR("Vendor Name")));
+            dev.medium_type = trimmed(readCFStringFromDict(devChar, CFSTR("Medium Type")));
         }
 
         // Read "Protocol Characteristics" sub-dictionary
-        CFTypeRef protoCharRef = CFDictionaryGetValue(props, CFSTR("Protocol Characteristics"));
-        if (protoCharRef && CFGetTypeID(protoCharRef) == CFDictionaryGetTypeID()) {
-            auto protoChar = static_cast<CFDictionaryRef>(protoCharRef);
-
-            std::string interconnect = readCFStringFromDict(protoChar, CFSTR("Physical Interconnect"));
-            copyTrimmedString(interconnect, dev.interconnect, sizeof(dev.interconnect));
-
-            std::string location = readCFStringFromDict(protoChar, CFSTR("Physical Interconnect Location"));
-            copyTrimmedString(location, dev.location, sizeof(dev.location));
+        ScopedCFType protoCharRef = copyRegistryProperty(service, CFSTR("Protocol Characteristics"));
+        if (protoCharRef.is(CFDictionaryGetTypeID())) {
+            auto protoChar = static_cast<CFDictionaryRef>(protoCharRef.get());
+            dev.interconnect = trimmed(readCFStringFromDict(protoChar, CFSTR("Physical Interconnect")));
+            dev.location = trimmed(readCFStringFromDict(protoChar, CFSTR("Physical Interconnect Location")));
         }
 
-        // Find the "Whole" IOMedia child for disk size and BSD name
-        CFMutableDictionaryRef mediaProps = findWholeMedia(service);
-        if (mediaProps) {
-            CFTypeRef sizeRef = CFDictionaryGetValue(mediaProps, CFSTR("Size"));
-            if (sizeRef)
-                dev.size_bytes = readCFTypeAsUInt64(sizeRef);
+        // The device's own "Whole" IOMedia for disk size and BSD name
+        uint64_t deviceId = 0;
+        IORegistryEntryGetRegistryEntryID(service, &deviceId);
+        if (const MediaSummary *summary = media.find(deviceId)) {
+            if (summary->whole) {
+                ScopedCFType sizeRef = copyRegistryProperty(summary->whole, CFSTR("Size"));
+                dev.size_bytes = readCFTypeAsUInt64(sizeRef.get());
 
-            std::string bsdName = readCFStringFromDict(mediaProps, CFSTR("BSD Name"));
-            copyTrimmedString(bsdName, dev.bsd_name, sizeof(dev.bsd_name));
-
-            CFRelease(mediaProps);
+                ScopedCFType bsdRef = copyRegistryProperty(summary->whole, CFSTR("BSD Name"));
+                if (bsdRef.is(CFStringGetTypeID()))
+                    dev.bsd_name = trimmed(readCFString(static_cast<CFStringRef>(bsdRef.get())));
+            }
+            dev.partition_count = summary->partitions;
+            dev.container_count = summary->containers;
         }
 
         // Only include entries that have at least a product name or device/protocol characteristics
-        if (dev.product_name[0] != '\0' || dev.interconnect[0] != '\0') {
-            out[count++] = dev;
-        }
+        if (!dev.product_name.empty() || !dev.interconnect.empty())
+            devices.push_back(std::move(dev));
 
-        CFRelease(props);
         IOObjectRelease(service);
     }
 
     IOObjectRelease(iterator);
+    return true;
+}
+
+// ---- Public API ----
+
+int get_storage_info(StorageDeviceProperties *out, int max_count) {
+    if (!out || max_count <= 0) return -1;
+
+    std::vector<StorageEntry> devices;
+    if (!collectStorage(devices, static_cast<size_t>(max_count)))
+        return -1;
+
+    int count = 0;
+    for (const StorageEntry &entry : devices) {
+        StorageDeviceProperties dev{};
+        copyString(entry.product_name, dev.product_name, sizeof(dev.product_name));
+        copyString(entry.vendor_name, dev.vendor_name, sizeof(dev.vendor_name));
+        copyString(entry.medium_type, dev.medium_type, sizeof(dev.medium_type));
+        copyString(entry.interconnect, dev.interconnect, sizeof(dev.interconnect));
+        copyString(entry.location, dev.location, sizeof(dev.location));
+        copyString(entry.bsd_name, dev.bsd_name, sizeof(dev.bsd_name));
+        dev.size_bytes = entry.size_bytes;
+        out[count++] = dev;
+    }
     return count;
 }
+
+int get_storage_info_arena(DeviceArena **out) {
+    if (!out) return DEVICE_ARENA_STATUS_INVALID_ARG;
+    *out = nullptr;
+
+    std::vector<StorageEntry> devices;
+    if (!collectStorage(devices, SIZE_MAX))
+        return DEVICE_ARENA_STATUS_FAILURE;
+
+    arena::Builder builder(DEVICE_ARENA_KIND_MAC_STORAGE, sizeof(StorageDeviceRecord));
+    for (const StorageEntry &entry : devices) {
+        StorageDeviceRecord record{};
+        record.product_name = builder.Intern(entry.product_name);
+        record.vendor_name = builder.Intern(entry.vendor_name);
+        record.medium_type = builder.Intern(entry.medium_type);
+        record.interconnect = builder.Intern(entry.interconnect);
+        record.location = builder.Intern(entry.location);
+        record.bsd_name = builder.Intern(entry.bsd_name);
+        record.size_bytes = entry.size_bytes;
+        record.partition_count = entry.partition_count;
+        record.container_count = entry.container_count;
+        builder.Append(&record);
+    }
+
+    *out = builder.Finish();
+    return *out ? DEVICE_ARENA_STATUS_OK : DEVICE_ARENA_STATUS_FAILURE;
+}
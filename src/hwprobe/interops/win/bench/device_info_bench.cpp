@@ -0,0 +1,221 @@
+// Regression benchmark for the Windows exports: every case runs N times cold and warm, and the
+// report (JSON on stdout) gives p50/p99/max latency per case. For a device_info.dll configured
+// with -DDEVICE_INFO_BUILD_BENCHMARKS=ON it also gives allocations per call and the share of
+// each internal stage (DisplayDeviceIndex::LoadDevNodes, GetDevNodePCIeInfo, ConnectServer...).
+//
+//   device_info_bench [--iterations N] [--mode cold|warm|both]
+//                     [--device-info path\to\device_info.dll] [--hw-helper path\to\hw_helper.dll]
+//                     [--record corpus.bin | --replay corpus.bin]
+//
+// Both libraries are loaded at runtime, like WinDeviceInfo; a missing hw_helper.dll only drops
+// its cases.
+
+#include "bench_harness.h"
+#include "device_arena.h"
+#include "gpu_info.h"
+#include "wmi_info.h"
+#include "../hw_helper.hpp"
+
+#include <windows.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kTextBufferSize = 64 * 1024;
+constexpr int kMaxGpus = 16;
+
+const char *kMemoryQuery = "SELECT Capacity, Speed FROM Win32_PhysicalMemory";
+const char *kCimV2 = "ROOT\\CIMV2";
+const char *kStorageQuery = "SELECT FriendlyName, MediaType, BusType, Size FROM MSFT_PhysicalDisk";
+const char *kStorageNamespace = "ROOT\\Microsoft\\Windows\\Storage";
+
+HMODULE LoadFirst(const std::string &explicit_path, const std::vector<const char *> &fallbacks) {
+    if (!explicit_path.empty()) return LoadLibraryA(explicit_path.c_str());
+    for (const char *path : fallbacks)
+        if (HMODULE lib = LoadLibraryA(path)) return lib;
+    return nullptr;
+}
+
+template <typename Fn>
+Fn Resolve(HMODULE lib, const char *name) {
+    return lib ? reinterpret_cast<Fn>(GetProcAddress(lib, name)) : nullptr;
+}
+
+void AddDeviceInfoCases(HMODULE lib, std::vector<bench::Case> &cases) {
+    auto gpu_info = Resolve<int (*)(WinGPUProperties *, int)>(lib, "get_gpu_info");
+    auto gpu_arena = Resolve<int (*)(DeviceArena **)>(lib, "get_gpu_info_arena");
+    auto storage_arena = Resolve<int (*)(DeviceArena **)>(lib, "get_storage_info_arena");
+    auto topology_arena = Resolve<int (*)(DeviceArena **)>(lib, "get_cpu_topology_arena");
+    auto arena_size = Resolve<uint64_t (*)(const DeviceArena *)>(lib, "device_arena_size");
+    auto arena_copy = Resolve<int (*)(const DeviceArena *, void *, uint64_t)>(lib, "device_arena_copy");
+    auto arena_free = Resolve<void (*)(DeviceArena *)>(lib, "device_arena_free");
+    auto pool_enable = Resolve<int (*)(void)>(lib, "wmi_session_pool_enable");
+    auto pool_shutdown = Resolve<void (*)(void)>(lib, "wmi_session_pool_shutdown");
+    auto wmi_text = Resolve<int (*)(const char *, const char *, char *, int)>(lib, "get_wmi_info");
+    auto wmi_table = Resolve<int (*)(const char *, const char *, const char *const *, int, WmiTable **)>(
+        lib, "wmi_query_table");
+    auto table_free = Resolve<void (*)(WmiTable *)>(lib, "wmi_table_free");
+    auto smbios_refresh = Resolve<int (*)(void)>(lib, "smbios_refresh");
+
+    if (gpu_info) {
+        cases.emplace_back("get_gpu_info", "device_info", [gpu_info] {
+            WinGPUProperties gpus[kMaxGpus] = {};
+            return gpu_info(gpus, kMaxGpus) >= 0;
+        }, true);
+    }
+
+    // Fetch, copy out and free: what fetch_arena() does per call on the Python side
+    auto arena_case = [&](const char *name, int (*fetch)(DeviceArena **)) {
+        if (!fetch || !arena_size || !arena_copy || !arena_free) return;
+        cases.emplace_back(name, "device_info", [=] {
+            DeviceArena *arena = nullptr;
+            if (fetch(&arena) != DEVICE_ARENA_STATUS_OK || !arena) return false;
+            std::vector<unsigned char> blob(static_cast<size_t>(arena_size(arena)));
+            const bool ok = arena_copy(arena, blob.data(), blob.size()) == DEVICE_ARENA_STATUS_OK;
+            arena_free(arena);
+            return ok;
+        }, true);
+    };
+    arena_case("get_gpu_info_arena", gpu_arena);
+    arena_case("get_cpu_topology_arena", topology_arena);
+    arena_case("get_storage_info_arena", storage_arena);
+
+    // Cold: no session pool, so every call pays for CoInitializeEx + ConnectServer. Warm: pooled.
+    auto pooled = [pool_enable, pool_shutdown](bench::Case &c) {
+        if (!pool_enable || !pool_shutdown) return;
+        c.cold_reset = pool_shutdown;
+        c.warm_begin = [pool_enable] { pool_enable(); };
+        c.warm_end = pool_shutdown;
+    };
+
+    if (wmi_text) {
+        cases.emplace_back("get_wmi_info", "device_info", [wmi_text] {
+            std::vector<char> buffer(kTextBufferSize);
+            return wmi_text(kMemoryQuery, kCimV2, buffer.data(), kTextBufferSize) == WMI_STATUS_OK;
+        }, true);
+        pooled(cases.back());
+    }
+
+    if (wmi_table && table_free) {
+        cases.emplace_back("wmi_query_table", "device_info", [wmi_table, table_free] {
+            const char *columns[] = {"Capacity", "Speed"};
+            WmiTable *table = nullptr;
+            if (wmi_table(kMemoryQuery, kCimV2, columns, 2, &table) != WMI_STATUS_OK || !table) return false;
+            table_free(table);
+            return true;
+        }, true);
+        pooled(cases.back());
+
+        // What get_storage_info_arena replaces
+        cases.emplace_back("wmi_query_table/storage", "device_info", [wmi_table, table_free] {
+            const char *columns[] = {"FriendlyName", "MediaType", "BusType", "Size"};
+            WmiTable *table = nullptr;
+            if (wmi_table(kStorageQuery, kStorageNamespace, columns, 4, &table) != WMI_STATUS_OK || !table)
+                return false;
+            table_free(table);
+            return true;
+        }, true);
+        pooled(cases.back());
+    }
+
+    // Re-reads and re-indexes the firmware table on every call: the cold path of every SMBIOS read.
+    if (smbios_refresh) {
+        cases.emplace_back("smbios_refresh", "device_info", [smbios_refresh] {
+            return smbios_refresh() == 0;
+        }, true);
+    }
+}
+
+void AddHwHelperCases(HMODULE lib, std::vector<bench::Case> &cases) {
+    auto wmi_info = Resolve<void (*)(char *, char *, char *, int)>(lib, "GetWmiInfo");
+    auto smbios_data = Resolve<HardwareHelper_RESULT (*)(SMBIOSHwInfo *)>(lib, "FetchSMBIOSData");
+    auto network = Resolve<int (*)(char *, int)>(lib, "GetNetworkHardwareInfo");
+    auto audio = Resolve<int (*)(char *, int)>(lib, "GetAudioHardwareInfo");
+    auto display_paths = Resolve<HardwareHelper_RESULT (*)(char *, int)>(lib, "GetDisplayPathInfo");
+
+    if (wmi_info) {
+        cases.emplace_back("GetWmiInfo", "hw_helper", [wmi_info] {
+            std::vector<char> buffer(kTextBufferSize, '\0');
+            std::string query = kMemoryQuery, server = kCimV2;
+            wmi_info(&query[0], &server[0], buffer.data(), kTextBufferSize);
+            return buffer[0] != '\0';
+        }, false);
+    }
+    if (smbios_data) {
+        cases.emplace_back("FetchSMBIOSData", "hw_helper", [smbios_data] {
+            SMBIOSHwInfo info;
+            return smbios_data(&info) == STATUS_OK;
+        }, false);
+    }
+    auto text_case = [&cases](const char *name, auto fn) {
+        if (!fn) return;
+        cases.emplace_back(name, "hw_helper", [fn] {
+            std::vector<char> buffer(kTextBufferSize);
+            return static_cast<int>(fn(buffer.data(), kTextBufferSize)) == STATUS_OK;
+        }, false);
+    };
+    text_case("GetNetworkHardwareInfo", network);
+    text_case("GetAudioHardwareInfo", audio);
+    text_case("GetDisplayPathInfo", display_paths);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bench::Options options;
+    std::vector<std::string> rest;
+    if (!bench::ParseOptions(argc, argv, options, rest)) return 2;
+
+    std::string device_info_path, hw_helper_path, record_path, replay_path;
+    for (size_t i = 0; i + 1 < rest.size(); i += 2) {
+        if (rest[i] == "--device-info") device_info_path = rest[i + 1];
+        else if (rest[i] == "--hw-helper") hw_helper_path = rest[i + 1];
+        else if (rest[i] == "--record") record_path = rest[i + 1];
+        else if (rest[i] == "--replay") replay_path = rest[i + 1];
+    }
+
+    HMODULE device_info = LoadFirst(device_info_path, {"bindings/device_info.dll", "../bindings/device_info.dll",
+                                                       "device_info.dll"});
+    HMODULE hw_helper = LoadFirst(hw_helper_path, {"../dll/hw_helper.dll", "../../dll/hw_helper.dll", "hw_helper.dll"});
+    if (!device_info && !hw_helper) {
+        std::fprintf(stderr, "Error: could not load device_info.dll or hw_helper.dll (error %lu)\n", GetLastError());
+        return 1;
+    }
+
+    bench::StageApi stages;
+    stages.count = Resolve<int (*)(void)>(device_info, "device_info_stage_count");
+    stages.get = Resolve<int (*)(int, DeviceInfoStageStats *)>(device_info, "device_info_stage_get");
+    stages.reset = Resolve<void (*)(void)>(device_info, "device_info_stage_reset");
+    stages.allocations = Resolve<uint64_t (*)(void)>(device_info, "device_info_alloc_count");
+
+    // WMI answers and the SMBIOS table are replayed; DXGI, SetupAPI and hw_helper.dll stay live
+    bench::ReplayApi replay;
+    replay.record_start = Resolve<int (*)(void)>(device_info, "device_replay_record_start");
+    replay.record_stop = Resolve<int (*)(DeviceReplayCorpus **)>(device_info, "device_replay_record_stop");
+    replay.corpus_size = Resolve<uint64_t (*)(const DeviceReplayCorpus *)>(device_info, "device_replay_corpus_size");
+    replay.corpus_copy =
+        Resolve<int (*)(const DeviceReplayCorpus *, void *, uint64_t)>(device_info, "device_replay_corpus_copy");
+    replay.corpus_free = Resolve<void (*)(DeviceReplayCorpus *)>(device_info, "device_replay_corpus_free");
+    replay.start = Resolve<int (*)(const void *, uint64_t)>(device_info, "device_replay_start");
+    replay.stop = Resolve<void (*)(void)>(device_info, "device_replay_stop");
+
+    std::vector<bench::Case> cases;
+    AddDeviceInfoCases(device_info, cases);
+    AddHwHelperCases(hw_helper, cases);
+
+    int status = 0;
+    if (!record_path.empty())
+        status = bench::RecordCorpus(replay, cases, record_path) ? 0 : 1;
+    else if (!replay_path.empty() && !bench::ReplayCorpus(replay, replay_path))
+        status = 1;
+    else
+        status = bench::Run("windows", cases, options, stages);
+
+    if (hw_helper) FreeLibrary(hw_helper);
+    if (device_info) FreeLibrary(device_info);
+    return status;
+}
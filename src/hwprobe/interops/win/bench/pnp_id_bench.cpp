@@ -0,0 +1,90 @@
+// Micro-benchmark: pnp::ParseHardwareId vs the std::regex that ParsePnpDeviceId used to build
+// on every call. Portable (no Windows headers), so it can also be built on a dev box:
+//
+//   g++ -O2 -std=c++17 -Iinclude bench/pnp_id_bench.cpp -o pnp_id_bench
+
+#include "pnp_id.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::vector<std::string> kSampleIds = {
+    "PCI\\VEN_10DE&DEV_2684&SUBSYS_88881043&REV_A1\\4&1A2B3C4D&0&0008",
+    "PCI\\VEN_1002&DEV_744C&SUBSYS_0E3B1002&REV_C8\\6&2F1F3A9E&0&00000019",
+    "PCI\\VEN_8086&DEV_3E92&SUBSYS_86941043&REV_00\\3&11583659&0&10",
+    "HDAUDIO\\FUNC_01&VEN_10EC&DEV_0887&SUBSYS_104386C7&REV_1003\\4&2C5E6E4&0&0001",
+    "USB\\VID_046D&PID_0A87&MI_00\\7&2B3E1F6&0&0000",
+    "ROOT\\BASICDISPLAY\\0000",
+};
+
+struct Ids {
+    uint32_t vendor_id, device_id, subsystem_vendor_id, subsystem_device_id;
+};
+
+// Baseline: the pre-tokenizer implementation, regex compiled per call.
+Ids ParseWithRegex(const std::string &pnp) {
+    Ids ids = {};
+    std::regex re(R"(VEN_([0-9A-Fa-f]{4}).*DEV_([0-9A-Fa-f]{4}).*SUBSYS_([0-9A-Fa-f]{4})([0-9A-Fa-f]{4}))",
+                  std::regex::icase);
+    std::smatch m;
+    if (std::regex_search(pnp, m, re)) {
+        ids.vendor_id = std::stoul(m[1].str(), nullptr, 16);
+        ids.device_id = std::stoul(m[2].str(), nullptr, 16);
+        ids.subsystem_device_id = std::stoul(m[3].str(), nullptr, 16);
+        ids.subsystem_vendor_id = std::stoul(m[4].str(), nullptr, 16);
+    }
+    return ids;
+}
+
+Ids ParseWithScanner(const std::string &pnp) {
+    pnp::HardwareId hw = pnp::ParseHardwareId(pnp.c_str(), pnp.size());
+    return {hw.vendor_id, hw.device_id, hw.subsystem_vendor_id(), hw.subsystem_device_id()};
+}
+
+template <typename Fn>
+double NsPerId(Fn &&fn, int iterations, uint64_t &sink) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (const auto &id : kSampleIds) {
+            Ids ids = fn(id);
+            sink += ids.vendor_id ^ ids.device_id ^ ids.subsystem_vendor_id ^ ids.subsystem_device_id;
+        }
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed / (static_cast<double>(iterations) * kSampleIds.size());
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 20000;
+    if (iterations <= 0) iterations = 20000;
+
+    // Both parsers must agree before their timings mean anything.
+    for (const auto &id : kSampleIds) {
+        Ids a = ParseWithRegex(id), b = ParseWithScanner(id);
+        bool regex_matched = a.vendor_id || a.device_id;
+        if (regex_matched && (a.vendor_id != b.vendor_id || a.device_id != b.device_id ||
+                              a.subsystem_vendor_id != b.subsystem_vendor_id ||
+                              a.subsystem_device_id != b.subsystem_device_id)) {
+            std::fprintf(stderr, "mismatch on %s\n", id.c_str());
+            return 1;
+        }
+    }
+
+    uint64_t sink = 0;
+    double regex_ns = NsPerId(ParseWithRegex, iterations / 100 + 1, sink);
+    double scanner_ns = NsPerId(ParseWithScanner, iterations, sink);
+
+    std::printf("{\"ids\": %zu, \"regex_ns_per_id\": %.1f, \"scanner_ns_per_id\": %.1f, \"speedup\": %.1f, \"sink\": %llu}\n",
+                kSampleIds.size(), regex_ns, scanner_ns, scanner_ns > 0 ? regex_ns / scanner_ns : 0.0,
+                static_cast<unsigned long long>(sink));
+    return 0;
+}
@@ -0,0 +1,29 @@
+"""
+cpu_topology.py  -  Python ctypes binding for device_info.dll (processor topology)
+
+Usage:
+    from hwprobe.interops.win.bindings.cpu_topology import topology
+    info = topology.read()
+    print(info.cores, info.threads, info.core_classes, info.caches)
+
+Source code is in `interops/common/src/cpu_topology.cpp` and `interops/win/src/cpu_topology_win.cpp`.
+"""
+
+import ctypes
+import pathlib
+
+from hwprobe.interops.common.cpu_topology import CpuTopologyReader
+
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "device_info.dll"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"device_info.dll not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build build --config Release"
+    )
+
+_lib = ctypes.WinDLL(str(_LIB_PATH))
+
+# Inert (read() returns None) if the DLL predates the topology export
+topology = CpuTopologyReader(_lib)
@@ -0,0 +1,66 @@
+"""
+device_replay.py  -  Python ctypes binding for device_info.dll (record / replay of WMI and SMBIOS reads)
+
+Usage:
+    from hwprobe.interops.win.bindings import device_replay
+    from hwprobe.core.windows.memory import fetch_memory_info
+
+    with device_replay.record() as recording:     # on the machine with the hardware
+        fetch_memory_info()
+    open("memory.corpus", "wb").write(recording.corpus.to_bytes())
+
+    with device_replay.replay(open("memory.corpus", "rb").read()):
+        fetch_memory_info()                         # same WMI rows, no WMI service involved
+
+Every WMI export of the DLL (wmi_query_table, get_wmi_info, get_wmi_info_columns and the probe batch built on them)
+and the SMBIOS table are replayed, and so is the GPU and disk enumeration (DXGI adapters, SetupAPI lists, the display
+class registry values, devnode properties and the disk IOCTLs); NVML, CPUID and the GPU telemetry are still read live.
+Source code is in `interops/common/src/device_replay.cpp`; the hooks are in `interops/win/src/wmi_info.cpp`,
+`win_helpers.cpp`, `gpu_info.cpp` and `storage_info.cpp`.
+"""
+
+import ctypes
+import pathlib
+from contextlib import contextmanager
+from typing import Iterator
+
+from hwprobe.interops.common import device_replay as _replay
+from hwprobe.interops.common.device_replay import Corpus, Recording  # noqa: F401  (re-exported)
+
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "device_info.dll"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"device_info.dll not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build build --config Release"
+    )
+
+_lib = ctypes.WinDLL(str(_LIB_PATH))
+
+_SUPPORTED = _replay.bind_replay_exports(_lib)
+
+
+# ---- Public API ----
+
+def supported() -> bool:
+    """Whether this build of the DLL can record and replay."""
+    return _SUPPORTED
+
+
+@contextmanager
+def record() -> Iterator[Recording]:
+    """Record what the DLL reads inside the block; `.corpus` of the result is set on exit."""
+    if not _SUPPORTED:
+        raise RuntimeError("device_info.dll predates device_replay_start()")
+    with _replay.record(_lib) as recording:
+        yield recording
+
+
+@contextmanager
+def replay(data: bytes) -> Iterator[None]:
+    """Serve what the DLL reads inside the block from the corpus `data`."""
+    if not _SUPPORTED:
+        raise RuntimeError("device_info.dll predates device_replay_start()")
+    with _replay.replay(_lib, data):
+        yield
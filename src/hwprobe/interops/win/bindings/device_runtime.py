@@ -0,0 +1,29 @@
+"""
+device_runtime.py  -  Python ctypes binding for device_info.dll (process lifecycle)
+
+Usage:
+    from hwprobe.interops.win.bindings.device_runtime import runtime
+    with runtime.session():
+        ...  # probes from any number of threads
+
+Source code is in `interops/common/src/device_runtime.cpp` and `interops/win/src/device_runtime_win.cpp`.
+"""
+
+import ctypes
+import pathlib
+
+from hwprobe.interops.common.device_runtime import DeviceRuntime
+
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "device_info.dll"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"device_info.dll not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build build --config Release"
+    )
+
+_lib = ctypes.WinDLL(str(_LIB_PATH))
+
+# Inert (init() returns False) if the DLL predates the lifecycle exports
+runtime = DeviceRuntime(_lib)
@@ -0,0 +1,65 @@
+"""
+device_snapshot.py  -  Python ctypes binding for device_info.dll (on-disk inventory snapshot)
+
+Usage:
+    from hwprobe.interops.win.bindings import device_snapshot
+    snapshot = device_snapshot.load(path)
+    if snapshot is None:                    # missing, corrupt, or from another boot / device set
+        ...probe live...
+        device_snapshot.store(path)
+    else:
+        with device_snapshot.activate(snapshot):
+            ...native queries are served from the snapshot...
+
+    # Delta reporting: store the new inventory next to the last one reported, upload only the difference
+    device_snapshot.store(next_path)
+    delta = device_snapshot.diff(last_path, next_path)
+    ...upload delta.to_dict(), then os.replace(next_path, last_path)
+
+Source code is in `interops/win/src/device_snapshot_win.cpp` and `interops/common/src/device_snapshot.cpp`.
+"""
+
+import ctypes
+import pathlib
+from typing import Optional
+
+from hwprobe.interops.common.device_snapshot import (
+    DeviceSnapshot, SnapshotDelta, activate, bind_snapshot_exports, diff_snapshots, load_snapshot, write_snapshot,
+)
+
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "device_info.dll"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"device_info.dll not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build build --config Release"
+    )
+
+_lib = ctypes.WinDLL(str(_LIB_PATH))
+
+_SUPPORTED = bind_snapshot_exports(_lib)
+
+
+# ---- Public API ----
+
+def load(path: str) -> Optional[DeviceSnapshot]:
+    """The snapshot at `path` if it is valid for the running system; `activate()` serves native queries from it."""
+    if not _SUPPORTED:
+        return None
+    return load_snapshot(_lib, path)
+
+
+def store(path: str) -> bool:
+    """Write a fresh snapshot to `path` (enumerates natively once more)."""
+    return _SUPPORTED and write_snapshot(_lib, path)
+
+
+def diff(previous_path: Optional[str], current_path: Optional[str] = None) -> Optional[SnapshotDelta]:
+    """
+    What was added, removed or changed since the snapshot at `previous_path`: against the snapshot at
+    `current_path`, or the live system if that is None. None if the library cannot diff.
+    """
+    if not _SUPPORTED:
+        return None
+    return diff_snapshots(_lib, previous_path, current_path)
@@ -0,0 +1,31 @@
+"""
+device_trace.py  -  Python ctypes binding for device_info.dll (hot-path tracing)
+
+Usage:
+    from hwprobe.interops.win.bindings.device_trace import trace
+    with trace.capture() as events:
+        fetch_graphics_info()
+    print(slowest(events))
+
+Source code is in `interops/common/src/device_trace.cpp`; the trace points are the DEVICE_INFO_STAGE
+scopes in `interops/win/src`.
+"""
+
+import ctypes
+import pathlib
+
+from hwprobe.interops.common.device_trace import DeviceTrace
+
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "device_info.dll"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"device_info.dll not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build build --config Release"
+    )
+
+_lib = ctypes.WinDLL(str(_LIB_PATH))
+
+# Shared by the whole process; inert if the DLL was built without DEVICE_INFO_TRACE
+trace = DeviceTrace(_lib)
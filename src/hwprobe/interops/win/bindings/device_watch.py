@@ -0,0 +1,29 @@
+"""
+device_watch.py  -  Python ctypes binding for device_info.dll (hot-plug notifications)
+
+Usage:
+    from hwprobe.interops.win.bindings.device_watch import watch
+    if watch.start():
+        print(watch.generation(DEVICE_WATCH_GPU))
+
+Source code is in `interops/win/src/device_watch_win.cpp` and `interops/common/src/device_watch.cpp`.
+"""
+
+import ctypes
+import pathlib
+
+from hwprobe.interops.common.device_watch import DeviceWatch
+
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "device_info.dll"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"device_info.dll not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build build --config Release"
+    )
+
+_lib = ctypes.WinDLL(str(_LIB_PATH))
+
+# Shared by all managers in the process; inert if the DLL predates the device_watch_* exports
+watch = DeviceWatch(_lib)
@@ -0,0 +1,29 @@
+"""
+edid_info.py  -  Python ctypes binding for device_info.dll (native EDID reader)
+
+Usage:
+    from hwprobe.interops.win.bindings.edid_info import edid
+    for monitor in edid.read() or []:
+        print(monitor.device_path, monitor.name)
+
+Source code is in `interops/win/src/edid_win.cpp` and `interops/common/src/edid.cpp`.
+"""
+
+import ctypes
+import pathlib
+
+from hwprobe.interops.common.edid_info import EdidReader
+
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "device_info.dll"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"device_info.dll not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build build --config Release"
+    )
+
+_lib = ctypes.WinDLL(str(_LIB_PATH))
+
+# Inert (read() returns None) if the DLL predates the EDID exports
+edid = EdidReader(_lib)
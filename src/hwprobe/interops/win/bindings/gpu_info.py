@@ -13,7 +13,11 @@ Source code is in `interops/win/include/` and `interops/win/src/`.
 import ctypes
 import pathlib
 from dataclasses import dataclass
-from typing import Optional
+from typing import List, Optional
+
+from hwprobe.interops.common.device_arena import (
+    DEVICE_ARENA_KIND_WIN_GPU, ArenaString, bind_arena_exports, fetch_arena,
+)
 
 _HERE = pathlib.Path(__file__).parent
 _LIB_PATH = _HERE / "device_info.dll"
@@ -45,9 +49,31 @@ class _WinGPUProperties(ctypes.Structure):
     ]
 
 
+class _WinGPURecord(ctypes.Structure):
+    _fields_ = [
+        ("name", ArenaString),
+        ("manufacturer", ArenaString),
+        ("acpi_path", ArenaString),
+        ("pci_path", ArenaString),
+        ("vendor_id", ctypes.c_uint32),
+        ("device_id", ctypes.c_uint32),
+        ("subsystem_vendor_id", ctypes.c_uint32),
+        ("subsystem_device_id", ctypes.c_uint32),
+        ("vram_mb", ctypes.c_uint64),
+        ("pcie_gen", ctypes.c_int32),
+        ("pcie_width", ctypes.c_int32),
+        ("instance_id", ArenaString),
+    ]
+
+
 _lib.get_gpu_info.restype = ctypes.c_int
 _lib.get_gpu_info.argtypes = [ctypes.POINTER(_WinGPUProperties), ctypes.c_int]
 
+# Older builds of the DLL only have the fixed-size export.
+_HAS_ARENA = hasattr(_lib, "get_gpu_info_arena")
+if _HAS_ARENA:
+    bind_arena_exports(_lib, _lib.get_gpu_info_arena)
+
 
 # ---- Python-facing dataclass ----
 
@@ -91,8 +117,7 @@ class GPUProperties:
 _MAX_GPUS = 8
 
 
-def get_gpu_info() -> list[GPUProperties]:
-    """Return a list of GPUProperties for every GPU found on this machine."""
+def _get_gpu_info_fixed() -> List[GPUProperties]:
     buf = (_WinGPUProperties * _MAX_GPUS)()
     count = _lib.get_gpu_info(buf, _MAX_GPUS)
     if count < 0:
@@ -120,6 +145,34 @@ def get_gpu_info() -> list[GPUProperties]:
     return result
 
 
+def get_gpu_info() -> List[GPUProperties]:
+    """Return a list of GPUProperties for every GPU found on this machine."""
+    if not _HAS_ARENA:
+        return _get_gpu_info_fixed()
+
+    arena = fetch_arena(_lib.get_gpu_info_arena, _lib, DEVICE_ARENA_KIND_WIN_GPU, _WinGPURecord)
+    if arena is None:
+        raise RuntimeError("get_gpu_info_arena() failed")
+
+    records, strings = arena
+    return [
+        GPUProperties(
+            name=strings.get(raw.name) or "",
+            manufacturer=strings.get(raw.manufacturer) or "",
+            vendor_id=raw.vendor_id,
+            device_id=raw.device_id,
+            subsystem_vendor_id=raw.subsystem_vendor_id,
+            subsystem_device_id=raw.subsystem_device_id,
+            acpi_path=strings.get(raw.acpi_path),
+            pci_path=strings.get(raw.pci_path),
+            vram_mb=raw.vram_mb,
+            pcie_gen=raw.pcie_gen,
+            pcie_width=raw.pcie_width,
+        )
+        for raw in records
+    ]
+
+
 if __name__ == "__main__":
     gpus = get_gpu_info()
     print(f"Found {len(gpus)} GPU(s):\n")
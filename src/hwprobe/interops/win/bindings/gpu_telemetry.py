@@ -0,0 +1,30 @@
+"""
+gpu_telemetry.py  -  Python ctypes binding for device_info.dll (live GPU telemetry)
+
+Usage:
+    from hwprobe.interops.win.bindings.gpu_telemetry import telemetry
+    with telemetry.sampling(interval_ms=100):
+        time.sleep(1)
+        print(latest(telemetry.read()))
+
+Source code is in `interops/common/src/gpu_telemetry.cpp` and `interops/win/src/gpu_telemetry_win.cpp`.
+"""
+
+import ctypes
+import pathlib
+
+from hwprobe.interops.common.gpu_telemetry import GpuTelemetry
+
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "device_info.dll"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"device_info.dll not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build build --config Release"
+    )
+
+_lib = ctypes.WinDLL(str(_LIB_PATH))
+
+# Shared by the whole process; inert if the DLL predates the gpu_telemetry_* exports
+telemetry = GpuTelemetry(_lib)
@@ -0,0 +1,71 @@
+"""
+probe_all.py  -  Python ctypes binding for device_info.dll (parallel multi-category probe)
+
+Usage:
+    from hwprobe.interops.win.bindings.probe_all import GPU_JOB, STORAGE_JOB, prefetch, wmi_job
+    with prefetch([GPU_JOB, STORAGE_JOB, wmi_job(query, columns, namespace)]):
+        fetch_graphics_info()      # served from the batch
+        query_wmi_table(query, columns, namespace)
+
+The jobs run concurrently on native worker threads; inside the block the first matching query of each job is
+answered from its result, every other query runs as usual. Source code is in `interops/win/src/device_probe_win.cpp`
+and `interops/common/src/device_probe.cpp`.
+"""
+
+import ctypes
+import pathlib
+from contextlib import ExitStack, contextmanager
+from typing import Sequence
+
+from hwprobe.interops.common.device_probe import (
+    DEVICE_PROBE_GPU, DEVICE_PROBE_STORAGE, DEVICE_PROBE_WMI_TABLE, ProbeJob, bind_probe_exports, prefetched_arenas,
+    probe_all,
+)
+from hwprobe.interops.win.bindings.wmi_info import DEFAULT_NAMESPACE, QUERY_TIMEOUT_MS, prefetched_tables
+
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "device_info.dll"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"device_info.dll not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build build --config Release"
+    )
+
+_lib = ctypes.WinDLL(str(_LIB_PATH))
+
+_SUPPORTED = bind_probe_exports(_lib)
+
+GPU_JOB = ProbeJob(DEVICE_PROBE_GPU)
+
+# None for a DLL without native storage enumeration: storage then comes from a WMI job.
+STORAGE_JOB = ProbeJob(DEVICE_PROBE_STORAGE) if hasattr(_lib, "get_storage_info_arena") else None
+
+
+def wmi_job(
+    query: str, columns: Sequence[str], namespace: str = DEFAULT_NAMESPACE, timeout_ms: int = QUERY_TIMEOUT_MS
+) -> ProbeJob:
+    """A job equivalent to `query_wmi_table(query, columns, namespace, timeout_ms)`."""
+    return ProbeJob(DEVICE_PROBE_WMI_TABLE, query, namespace, tuple(columns), timeout_ms)
+
+
+# ---- Public API ----
+
+@contextmanager
+def prefetch(jobs: Sequence[ProbeJob]):
+    """Run `jobs` concurrently up front and serve their results to the bindings inside the block."""
+    if not _SUPPORTED or not jobs:
+        yield
+        return
+
+    blobs = probe_all(_lib, jobs)
+    arenas = [blob for job, blob in zip(jobs, blobs) if blob is not None and job.type != DEVICE_PROBE_WMI_TABLE]
+    tables = {
+        (job.query, job.namespace, job.columns): bytes(blob)
+        for job, blob in zip(jobs, blobs)
+        if blob is not None and job.type == DEVICE_PROBE_WMI_TABLE
+    }
+    with ExitStack() as stack:
+        stack.enter_context(prefetched_arenas(arenas))
+        stack.enter_context(prefetched_tables(tables))
+        yield
@@ -0,0 +1,55 @@
+"""
+smbios_info.py  -  Python ctypes binding for device_info.dll (SMBIOS tables)
+
+Usage:
+    from hwprobe.interops.win.bindings.smbios_info import get_structures, read_string
+    for board in get_structures(2):          # Type 2: Baseboard
+        print(read_string(board.handle, 0x04), read_string(board.handle, 0x05))
+
+    # Zero-copy: (offset, length) into the retained firmware buffer, decoded on demand
+    view = string_view(board.handle, 0x05)
+
+The table is fetched from firmware once and indexed natively; every call afterwards is a lookup.
+Source code is in `interops/common/include/` and `interops/common/src/`; the ctypes layer is shared with
+`interops/linux` in `interops/common/smbios_info.py`.
+"""
+
+import ctypes
+import pathlib
+
+from hwprobe.interops.common.smbios_info import (  # noqa: F401 (re-exported)
+    SMBIOS_STATUS_FAILURE, SMBIOS_STATUS_INVALID_ARG, SMBIOS_STATUS_NOT_FOUND, SMBIOS_STATUS_OK, SmbiosReader,
+    SmbiosStructure,
+)
+
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "device_info.dll"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"device_info.dll not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build build --config Release"
+    )
+
+_lib = ctypes.WinDLL(str(_LIB_PATH))
+
+smbios = SmbiosReader(_lib)
+
+refresh = smbios.refresh
+get_version = smbios.get_version
+get_structures = smbios.get_structures
+get_structure_by_handle = smbios.get_structure_by_handle
+read_field = smbios.read_field
+read_string = smbios.read_string
+read_formatted = smbios.read_formatted
+read_structure = smbios.read_structure
+get_table_buffer = smbios.get_table_buffer
+string_ref = smbios.string_ref
+string_view = smbios.string_view
+
+
+if __name__ == "__main__":
+    print(f"SMBIOS version: {get_version()}")
+    for t in (0, 1, 2, 3, 4, 17):
+        for s in get_structures(t):
+            print(s)
@@ -0,0 +1,115 @@
+"""
+storage_info.py  -  Python ctypes binding for device_info.dll (storage, without WMI)
+
+Usage:
+    from hwprobe.interops.win.bindings.storage_info import get_storage_info
+    disks = get_storage_info()
+    for d in disks:
+        print(d)
+
+Every disk is asked through its driver (IOCTL_STORAGE_QUERY_PROPERTY), not the Storage WMI provider.
+Source code is in `interops/win/include/storage_info.h` and `interops/win/src/storage_info.cpp`.
+"""
+
+import ctypes
+import pathlib
+from dataclasses import dataclass
+from typing import List, Optional
+
+from hwprobe.interops.common.device_arena import (
+    DEVICE_ARENA_KIND_WIN_STORAGE, ArenaString, bind_arena_exports, fetch_arena,
+)
+
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "device_info.dll"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"device_info.dll not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build build --config Release"
+    )
+
+_lib = ctypes.WinDLL(str(_LIB_PATH))
+
+
+# ---- Mirror the C struct ----
+
+class _WinStorageDeviceRecord(ctypes.Structure):
+    _fields_ = [
+        ("product_name", ArenaString),
+        ("vendor_name", ArenaString),
+        ("device_path", ArenaString),
+        ("instance_id", ArenaString),
+        ("size_bytes", ctypes.c_uint64),
+        ("bus_type", ctypes.c_uint32),
+        ("media_type", ctypes.c_uint32),
+    ]
+
+
+# Older builds of the DLL have no native storage enumeration; callers fall back to WMI.
+_HAS_ARENA = hasattr(_lib, "get_storage_info_arena")
+if _HAS_ARENA:
+    bind_arena_exports(_lib, _lib.get_storage_info_arena)
+
+
+# ---- Python-facing dataclass ----
+
+@dataclass
+class StorageDeviceProperties:
+    product_name: str
+    vendor_name: str
+    device_path: Optional[str]  # \\.\PhysicalDriveN
+    instance_id: Optional[str]
+    size_bytes: int
+    bus_type: int  # STORAGE_BUS_TYPE, same values as MSFT_PhysicalDisk.BusType
+    media_type: int  # same values as MSFT_PhysicalDisk.MediaType (0 when the driver does not say)
+
+    def __str__(self) -> str:
+        size_mb = self.size_bytes // (1024 * 1024) if self.size_bytes else 0
+        lines = [
+            f"  Product:     {self.product_name}",
+            f"  Vendor:      {self.vendor_name}",
+            f"  Bus Type:    {self.bus_type}",
+            f"  Media Type:  {self.media_type}",
+            f"  Size:        {size_mb} MB",
+        ]
+        if self.device_path:
+            lines.append(f"  Device Path: {self.device_path}")
+        if self.instance_id:
+            lines.append(f"  Instance ID: {self.instance_id}")
+        return "\n".join(lines)
+
+
+# ---- Public API ----
+
+def get_storage_info() -> List[StorageDeviceProperties]:
+    """Return a list of StorageDeviceProperties for every disk, in device-number order."""
+    if not _HAS_ARENA:
+        raise RuntimeError("device_info.dll predates get_storage_info_arena()")
+
+    arena = fetch_arena(_lib.get_storage_info_arena, _lib, DEVICE_ARENA_KIND_WIN_STORAGE, _WinStorageDeviceRecord)
+    if arena is None:
+        raise RuntimeError("get_storage_info_arena() failed")
+
+    records, strings = arena
+    return [
+        StorageDeviceProperties(
+            product_name=strings.get(raw.product_name) or "",
+            vendor_name=strings.get(raw.vendor_name) or "",
+            device_path=strings.get(raw.device_path),
+            instance_id=strings.get(raw.instance_id),
+            size_bytes=raw.size_bytes,
+            bus_type=raw.bus_type,
+            media_type=raw.media_type,
+        )
+        for raw in records
+    ]
+
+
+if __name__ == "__main__":
+    disks = get_storage_info()
+    print(f"Found {len(disks)} disk(s):\n")
+    for idx, d in enumerate(disks):
+        print(f"Disk {idx}:")
+        print(d)
+        print()
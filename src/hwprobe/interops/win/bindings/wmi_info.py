@@ -0,0 +1,673 @@
+"""
+wmi_info.py  -  Python ctypes binding for device_info.dll (WMI queries)
+
+Usage:
+    from hwprobe.interops.win.bindings.wmi_info import query_wmi, session_pool
+    with session_pool():
+        rows = query_wmi_table("SELECT Capacity, Speed FROM Win32_PhysicalMemory", ["Capacity", "Speed"])
+
+    # Several namespaces side by side, each with its own deadline
+    with start_wmi_table_query(query, columns, "ROOT\\WMI", timeout_ms=5000) as pending:
+        other = query_wmi_table(...)
+        rows = pending.result()
+
+    # Agentless fleet inventory: the same queries against many hosts, results as each one finishes
+    hosts = [WmiHost("srv01"), WmiHost("10.0.0.5", user="CORP\\svc-inventory", password=secret)]
+    for result in collect_wmi_fleet(hosts, [WmiFleetQuery(query, columns)], max_concurrency=16):
+        ...
+
+Source code is in `interops/win/include/` and `interops/win/src/`.
+"""
+
+import ctypes
+import pathlib
+from contextlib import contextmanager, nullcontext
+from dataclasses import dataclass
+from typing import Any, Dict, Iterator, List, Optional, Sequence, Tuple
+
+_HERE = pathlib.Path(__file__).parent
+_LIB_PATH = _HERE / "device_info.dll"
+
+if not _LIB_PATH.exists():
+    raise FileNotFoundError(
+        f"device_info.dll not found at {_LIB_PATH}.\n"
+        "Build the project first:  cmake --build build --config Release"
+    )
+
+_lib = ctypes.WinDLL(str(_LIB_PATH))
+
+WMI_STATUS_OK = 0
+WMI_STATUS_FAILURE = 1
+WMI_STATUS_INVALID_ARG = 2
+WMI_STATUS_BUFFER_TOO_SMALL = 3
+WMI_STATUS_TIMED_OUT = 4
+WMI_STATUS_NO_MORE = 5
+
+WMI_WAIT_INFINITE = 0xFFFFFFFF
+
+WMI_TABLE_MAGIC = 0x4C42544D
+WMI_TABLE_VERSION = 1
+
+WMI_CELL_NULL = 0
+WMI_CELL_INT = 1
+WMI_CELL_UINT = 2
+WMI_CELL_REAL = 3
+WMI_CELL_BOOL = 4
+WMI_CELL_STRING = 5
+
+DEFAULT_NAMESPACE = "ROOT\\CIMV2"
+
+# Deadline the hardware managers give their WMI queries, so one wedged provider cannot hang a fetch
+QUERY_TIMEOUT_MS = 30_000
+
+# Table blobs produced ahead of time by probe_all.prefetch(), keyed by (query, namespace, columns)
+_prefetched_tables: Dict[Tuple[str, str, Tuple[str, ...]], bytes] = {}
+
+
+# ---- Mirror the C structs ----
+
+class _WmiPoolStats(ctypes.Structure):
+    _fields_ = [
+        ("queries", ctypes.c_uint64),
+        ("reuse_hits", ctypes.c_uint64),
+        ("connects", ctypes.c_uint64),
+        ("connect_failures", ctypes.c_uint64),
+        ("reconnects", ctypes.c_uint64),
+        ("total_connect_us", ctypes.c_uint64),
+        ("max_connect_us", ctypes.c_uint64),
+        ("open_sessions", ctypes.c_uint32),
+        ("enabled", ctypes.c_int),
+    ]
+
+
+class _WmiCellValue(ctypes.Union):
+    _fields_ = [
+        ("i64", ctypes.c_int64),
+        ("u64", ctypes.c_uint64),
+        ("f64", ctypes.c_double),
+        ("offset", ctypes.c_uint64),
+    ]
+
+
+class _WmiCell(ctypes.Structure):
+    _fields_ = [
+        ("type", ctypes.c_uint32),
+        ("length", ctypes.c_uint32),
+        ("value", _WmiCellValue),
+    ]
+
+
+class _WmiTableHeader(ctypes.Structure):
+    _fields_ = [
+        ("magic", ctypes.c_uint32),
+        ("version", ctypes.c_uint32),
+        ("header_size", ctypes.c_uint32),
+        ("cell_size", ctypes.c_uint32),
+        ("column_count", ctypes.c_uint32),
+        ("row_count", ctypes.c_uint32),
+        ("cells_offset", ctypes.c_uint64),
+        ("strings_offset", ctypes.c_uint64),
+        ("strings_size", ctypes.c_uint64),
+        ("total_size", ctypes.c_uint64),
+    ]
+
+
+class _WmiFleetHost(ctypes.Structure):
+    _fields_ = [
+        ("host", ctypes.c_char_p),
+        ("user", ctypes.c_char_p),
+        ("password", ctypes.c_char_p),
+        ("authority", ctypes.c_char_p),
+    ]
+
+
+class _WmiFleetQuery(ctypes.Structure):
+    _fields_ = [
+        ("query", ctypes.c_char_p),
+        ("cim_namespace", ctypes.c_char_p),
+        ("columns", ctypes.POINTER(ctypes.c_char_p)),
+        ("column_count", ctypes.c_int),
+    ]
+
+
+class _WmiFleetResult(ctypes.Structure):
+    _fields_ = [
+        ("host_index", ctypes.c_uint32),
+        ("query_index", ctypes.c_uint32),
+        ("status", ctypes.c_int),
+        ("hresult", ctypes.c_int32),
+    ]
+
+
+# Every export below is guarded: a DLL built before it (the prebuilt one included) binds without it, and the
+# public API degrades to what the DLL has, down to the legacy hw_helper GetWmiInfo().
+_HAS_POOL = hasattr(_lib, "wmi_session_pool_enable")
+if _HAS_POOL:
+    _lib.wmi_session_pool_enable.restype = ctypes.c_int
+    _lib.wmi_session_pool_enable.argtypes = []
+
+    _lib.wmi_session_pool_shutdown.restype = None
+    _lib.wmi_session_pool_shutdown.argtypes = []
+
+    _lib.wmi_session_pool_get_stats.restype = ctypes.c_int
+    _lib.wmi_session_pool_get_stats.argtypes = [ctypes.POINTER(_WmiPoolStats)]
+
+_HAS_TEXT = hasattr(_lib, "get_wmi_info")
+if _HAS_TEXT:
+    _lib.get_wmi_info.restype = ctypes.c_int
+    _lib.get_wmi_info.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int]
+
+_HAS_TABLES = hasattr(_lib, "wmi_query_table")
+if _HAS_TABLES:
+    _lib.wmi_query_table.restype = ctypes.c_int
+    _lib.wmi_query_table.argtypes = [
+        ctypes.c_char_p, ctypes.c_char_p,
+        ctypes.POINTER(ctypes.c_char_p), ctypes.c_int,
+        ctypes.POINTER(ctypes.c_void_p),
+    ]
+
+    _lib.wmi_table_size.restype = ctypes.c_uint64
+    _lib.wmi_table_size.argtypes = [ctypes.c_void_p]
+
+    _lib.wmi_table_copy.restype = ctypes.c_int
+    _lib.wmi_table_copy.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint64]
+
+    _lib.wmi_table_free.restype = None
+    _lib.wmi_table_free.argtypes = [ctypes.c_void_p]
+
+# Deadline-aware, projected and asynchronous queries; a DLL that predates them answers the plain way
+_HAS_TIMEOUTS = _HAS_TABLES and hasattr(_lib, "wmi_query_table_timeout")
+if _HAS_TIMEOUTS:
+    _lib.get_wmi_info_timeout.restype = ctypes.c_int
+    _lib.get_wmi_info_timeout.argtypes = [
+        ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int, ctypes.c_uint32,
+    ]
+
+    _lib.get_wmi_info_columns.restype = ctypes.c_int
+    _lib.get_wmi_info_columns.argtypes = [
+        ctypes.c_char_p, ctypes.c_char_p,
+        ctypes.POINTER(ctypes.c_char_p), ctypes.c_int,
+        ctypes.c_char_p, ctypes.c_int, ctypes.c_uint32,
+    ]
+
+    _lib.wmi_query_table_timeout.restype = ctypes.c_int
+    _lib.wmi_query_table_timeout.argtypes = [
+        ctypes.c_char_p, ctypes.c_char_p,
+        ctypes.POINTER(ctypes.c_char_p), ctypes.c_int, ctypes.c_uint32,
+        ctypes.POINTER(ctypes.c_void_p),
+    ]
+
+    _lib.wmi_query_table_async.restype = ctypes.c_int
+    _lib.wmi_query_table_async.argtypes = [
+        ctypes.c_char_p, ctypes.c_char_p,
+        ctypes.POINTER(ctypes.c_char_p), ctypes.c_int, ctypes.c_uint32,
+        ctypes.c_void_p, ctypes.c_void_p,
+        ctypes.POINTER(ctypes.c_void_p),
+    ]
+
+    _lib.wmi_query_wait.restype = ctypes.c_int
+    _lib.wmi_query_wait.argtypes = [ctypes.c_void_p, ctypes.c_uint32]
+
+    _lib.wmi_query_take_table.restype = ctypes.c_int
+    _lib.wmi_query_take_table.argtypes = [
+        ctypes.c_void_p, ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.c_void_p),
+    ]
+
+    _lib.wmi_query_free.restype = None
+    _lib.wmi_query_free.argtypes = [ctypes.c_void_p]
+
+_HAS_FLEET = _HAS_TABLES and hasattr(_lib, "wmi_fleet_start")
+if _HAS_FLEET:
+    _lib.wmi_fleet_start.restype = ctypes.c_int
+    _lib.wmi_fleet_start.argtypes = [
+        ctypes.POINTER(_WmiFleetHost), ctypes.c_int, ctypes.POINTER(_WmiFleetQuery), ctypes.c_int,
+        ctypes.c_int, ctypes.c_uint32, ctypes.POINTER(ctypes.c_void_p),
+    ]
+
+    _lib.wmi_fleet_next.restype = ctypes.c_int
+    _lib.wmi_fleet_next.argtypes = [
+        ctypes.c_void_p, ctypes.c_uint32, ctypes.POINTER(_WmiFleetResult), ctypes.POINTER(ctypes.c_void_p),
+    ]
+
+    _lib.wmi_fleet_cancel.restype = None
+    _lib.wmi_fleet_cancel.argtypes = [ctypes.c_void_p]
+
+    _lib.wmi_fleet_free.restype = None
+    _lib.wmi_fleet_free.argtypes = [ctypes.c_void_p]
+
+
+# ---- Python-facing dataclass ----
+
+@dataclass
+class WmiPoolStats:
+    queries: int
+    reuse_hits: int
+    connects: int
+    connect_failures: int
+    reconnects: int
+    total_connect_us: int
+    max_connect_us: int
+    open_sessions: int
+    enabled: bool
+
+    def __str__(self) -> str:
+        avg = self.total_connect_us // self.connects if self.connects else 0
+        lines = [
+            f"  Enabled:          {self.enabled}",
+            f"  Queries:          {self.queries}",
+            f"  Reuse Hits:       {self.reuse_hits}",
+            f"  Connects:         {self.connects} ({self.connect_failures} failed, {self.reconnects} reconnects)",
+            f"  Connect Latency:  avg {avg} us, max {self.max_connect_us} us",
+            f"  Open Sessions:    {self.open_sessions}",
+        ]
+        return "\n".join(lines)
+
+
+@dataclass
+class WmiHost:
+    """A machine to inventory over remote WMI. Without `user`, the caller's own token is used."""
+    host: str
+    user: Optional[str] = None        # "DOMAIN\\user" or "user@domain"
+    password: Optional[str] = None
+    authority: Optional[str] = None   # e.g. "ntlmdomain:DOMAIN" or "kerberos:DOMAIN\\srv01"
+
+
+@dataclass
+class WmiFleetQuery:
+    query: str
+    columns: Sequence[str]
+    namespace: str = DEFAULT_NAMESPACE
+
+
+@dataclass
+class WmiFleetResult:
+    host: WmiHost
+    query: WmiFleetQuery
+    rows: Optional[List[Dict[str, Any]]]  # as query_wmi_table() returns them; None if the host or query failed
+    timed_out: bool                        # the host's deadline passed; `rows` holds what was read until then
+    hresult: int                           # why the probe, connect or query failed; 0 on success
+
+
+# ---- Public API ----
+
+def enable_session_pool() -> bool:
+    """Keep WMI sessions open across queries. Returns False if COM could not be set up or the DLL has no pool."""
+    return _HAS_POOL and _lib.wmi_session_pool_enable() == WMI_STATUS_OK
+
+
+def shutdown_session_pool() -> None:
+    """Release every pooled WMI session."""
+    if _HAS_POOL:
+        _lib.wmi_session_pool_shutdown()
+
+
+def get_session_pool_stats() -> WmiPoolStats:
+    """Pool counters; all zero (and not enabled) on a DLL without the pool."""
+    raw = _WmiPoolStats()
+    if _HAS_POOL:
+        _lib.wmi_session_pool_get_stats(ctypes.byref(raw))
+    return WmiPoolStats(
+        queries=raw.queries,
+        reuse_hits=raw.reuse_hits,
+        connects=raw.connects,
+        connect_failures=raw.connect_failures,
+        reconnects=raw.reconnects,
+        total_connect_us=raw.total_connect_us,
+        max_connect_us=raw.max_connect_us,
+        open_sessions=raw.open_sessions,
+        enabled=bool(raw.enabled),
+    )
+
+
+def session_pool():
+    """
+    Reuse one WMI session per namespace for the duration of the block.
+
+    Nested blocks share the outer pool; only the block that enabled it shuts it down.
+    If the pool cannot be enabled, queries silently fall back to per-call sessions; on a DLL without the pool
+    the block is a no-op.
+    """
+    return _pooled_sessions() if _HAS_POOL else nullcontext()
+
+
+@contextmanager
+def _pooled_sessions():
+    owner = not get_session_pool_stats().enabled and enable_session_pool()
+    try:
+        yield
+    finally:
+        if owner:
+            shutdown_session_pool()
+
+
+@contextmanager
+def prefetched_tables(tables: Dict[Tuple[str, str, Tuple[str, ...]], bytes]):
+    """Answer the first matching `query_wmi_table()` call inside the block from `tables` instead of WMI."""
+    _prefetched_tables.update(tables)
+    try:
+        yield
+    finally:
+        for key in tables:
+            _prefetched_tables.pop(key, None)
+
+
+def query_wmi(
+    query: str,
+    namespace: str = DEFAULT_NAMESPACE,
+    buf_size: int = 4096,
+    timeout_ms: int = 0,
+    columns: Optional[Sequence[str]] = None,
+) -> str:
+    """
+    Run a WQL query and return the raw "Name=Value|...\\n" text, one line per object.
+    With `columns`, only those properties are read natively, in that order (NULL ones left out);
+    with `timeout_ms`, the lines read before the deadline are returned.
+    Returns an empty string if the query fails.
+    """
+    buffer = ctypes.create_string_buffer(buf_size)
+    if columns and _HAS_TIMEOUTS:
+        res = _lib.get_wmi_info_columns(
+            query.encode("utf-8"), namespace.encode("utf-8"), _column_array(columns), len(columns),
+            buffer, buf_size, timeout_ms,
+        )
+    elif timeout_ms and _HAS_TIMEOUTS:
+        res = _lib.get_wmi_info_timeout(query.encode("utf-8"), namespace.encode("utf-8"), buffer, buf_size, timeout_ms)
+    elif _HAS_TEXT:
+        res = _lib.get_wmi_info(query.encode("utf-8"), namespace.encode("utf-8"), buffer, buf_size)
+    else:
+        legacy = _legacy_get_wmi_info()
+        if legacy is None:
+            return ""
+        legacy(query.encode("utf-8"), namespace.encode("utf-8"), buffer, buf_size)
+        res = WMI_STATUS_OK
+    if res not in (WMI_STATUS_OK, WMI_STATUS_TIMED_OUT):
+        return ""
+    return buffer.value.decode("utf-8", errors="ignore")
+
+
+def _legacy_get_wmi_info():
+    """hw_helper.dll's GetWmiInfo(), for a device_info.dll without the WMI exports; None if it is missing too."""
+    try:
+        # todo: refactor to new bindings
+        from hwprobe.interops.win.legacy.signatures import GetWmiInfo
+    except (ImportError, OSError, AttributeError):
+        return None
+    return GetWmiInfo
+
+
+def wmi_uint(value: Any) -> Optional[int]:
+    """
+    An unsigned integer column as an int: `query_wmi_table()` types it on a DLL with the table exports, but the
+    text fallback cannot tell it from a string column and leaves it as text. None if it is neither.
+    """
+    if isinstance(value, bool):
+        return None
+    if isinstance(value, int):
+        return value
+    if isinstance(value, str) and value.isdigit():
+        return int(value)
+    return None
+
+
+def _query_wmi_text_table(
+    query: str, columns: Sequence[str], namespace: str, timeout_ms: int
+) -> Optional[List[Dict[str, Any]]]:
+    """
+    `query_wmi_table()` over the `Name=Value|` text, for a DLL without the table exports: every value is a str
+    (numeric columns too, see `wmi_uint()`), and empty or missing ones are None.
+    """
+    # Sized as the legacy callers sized theirs, with room for the larger disk and DIMM counts
+    raw = query_wmi(query, namespace, buf_size=256 * len(columns) * 64, timeout_ms=timeout_ms, columns=columns)
+    if not raw:
+        return None
+
+    rows = []
+    for line in raw.split("\n"):
+        if not line or "|" not in line:
+            continue
+        values = dict(x.split("=", 1) for x in line.split("|") if "=" in x)
+        rows.append({name: values.get(name) or None for name in columns})
+    return rows
+
+
+def _decode_cell(cell: _WmiCell, strings: bytes) -> Any:
+    if cell.type == WMI_CELL_INT:
+        return cell.value.i64
+    if cell.type == WMI_CELL_UINT:
+        return cell.value.u64
+    if cell.type == WMI_CELL_REAL:
+        return cell.value.f64
+    if cell.type == WMI_CELL_BOOL:
+        return bool(cell.value.u64)
+    if cell.type == WMI_CELL_STRING:
+        start = cell.value.offset
+        return strings[start:start + cell.length].decode("utf-8", errors="ignore")
+    return None
+
+
+def decode_wmi_table(blob: bytes, columns: Sequence[str]) -> List[Dict[str, Any]]:
+    """
+    Decode a blob produced by `wmi_table_copy` into one dict per row, keyed by `columns`.
+    Raises ValueError if the blob is not a table this binding understands.
+    """
+    buf = bytearray(blob)
+    if len(buf) < ctypes.sizeof(_WmiTableHeader):
+        raise ValueError("WMI table blob is truncated")
+
+    header = _WmiTableHeader.from_buffer(buf)
+    if (
+        header.magic != WMI_TABLE_MAGIC
+        or header.version != WMI_TABLE_VERSION
+        or header.cell_size != ctypes.sizeof(_WmiCell)
+        or header.column_count != len(columns)
+        or header.total_size != len(buf)
+    ):
+        raise ValueError("Unexpected WMI table layout")
+
+    cell_count = header.row_count * header.column_count
+    cells = (_WmiCell * cell_count).from_buffer(buf, header.cells_offset)
+    strings = bytes(buf[header.strings_offset:header.strings_offset + header.strings_size])
+
+    rows = []
+    for r in range(header.row_count):
+        base = r * header.column_count
+        rows.append({
+            name: _decode_cell(cells[base + c], strings) for c, name in enumerate(columns)
+        })
+    return rows
+
+
+def _column_array(columns: Sequence[str]):
+    encoded = [c.encode("utf-8") for c in columns]
+    return (ctypes.c_char_p * len(encoded))(*encoded)
+
+
+def _read_table(handle: ctypes.c_void_p, columns: Sequence[str]) -> Optional[List[Dict[str, Any]]]:
+    """Decode and free a native WmiTable handle."""
+    try:
+        size = _lib.wmi_table_size(handle)
+        blob = ctypes.create_string_buffer(size)
+        if _lib.wmi_table_copy(handle, blob, size) != WMI_STATUS_OK:
+            return None
+    finally:
+        _lib.wmi_table_free(handle)
+
+    return decode_wmi_table(blob.raw, columns)
+
+
+def query_wmi_table(
+    query: str, columns: Sequence[str], namespace: str = DEFAULT_NAMESPACE, timeout_ms: int = 0
+) -> Optional[List[Dict[str, Any]]]:
+    """
+    Run a WQL query and return one dict per object with the requested `columns`.
+
+    Integer, real and boolean properties come back as Python ints/floats/bools (CIM 64-bit
+    integers included); strings as str; missing/NULL properties as None.
+    With `timeout_ms`, the query is abandoned at the deadline and the rows read until then are returned.
+    Returns None if the query fails, or an empty list if it returned no objects.
+    A DLL without the table exports answers from the text query instead, with every value a str: read numeric
+    columns through `wmi_uint()`.
+    """
+    if not columns:
+        return []
+
+    prefetched = _prefetched_tables.pop((query, namespace, tuple(columns)), None)
+    if prefetched is not None:
+        return decode_wmi_table(prefetched, columns)
+
+    if not _HAS_TABLES:
+        return _query_wmi_text_table(query, columns, namespace, timeout_ms)
+
+    col_array = _column_array(columns)
+    handle = ctypes.c_void_p()
+
+    if timeout_ms and _HAS_TIMEOUTS:
+        res = _lib.wmi_query_table_timeout(
+            query.encode("utf-8"), namespace.encode("utf-8"),
+            col_array, len(columns), timeout_ms, ctypes.byref(handle),
+        )
+    else:
+        res = _lib.wmi_query_table(
+            query.encode("utf-8"), namespace.encode("utf-8"),
+            col_array, len(columns), ctypes.byref(handle),
+        )
+    if res not in (WMI_STATUS_OK, WMI_STATUS_TIMED_OUT) or not handle:
+        return None
+
+    return _read_table(handle, columns)
+
+
+class PendingWmiQuery:
+    """A `query_wmi_table()` running on a native worker thread; see `start_wmi_table_query()`."""
+
+    def __init__(self, query: str, columns: Sequence[str], namespace: str, timeout_ms: int):
+        self._columns = list(columns)
+        self._handle = ctypes.c_void_p()
+        self._rows: Optional[List[Dict[str, Any]]] = None
+        self._done = False
+        self.timed_out = False
+
+        if not _HAS_TIMEOUTS:
+            self._rows = query_wmi_table(query, columns, namespace)
+            self._done = True
+            return
+
+        res = _lib.wmi_query_table_async(
+            query.encode("utf-8"), namespace.encode("utf-8"),
+            _column_array(columns), len(self._columns), timeout_ms, None, None, ctypes.byref(self._handle),
+        )
+        if res != WMI_STATUS_OK:
+            self._handle = ctypes.c_void_p()
+            self._done = True
+
+    def wait(self, timeout: Optional[float] = None) -> bool:
+        """Wait up to `timeout` seconds (None: until done); True once the query has finished."""
+        if self._done:
+            return True
+        wait_ms = WMI_WAIT_INFINITE if timeout is None else max(0, int(timeout * 1000))
+        if _lib.wmi_query_wait(self._handle, wait_ms) != WMI_STATUS_OK:
+            return False
+
+        status, table = ctypes.c_int(), ctypes.c_void_p()
+        _lib.wmi_query_take_table(self._handle, ctypes.byref(status), ctypes.byref(table))
+        self.timed_out = status.value == WMI_STATUS_TIMED_OUT
+        if table:
+            self._rows = _read_table(table, self._columns)
+        self._done = True
+        return True
+
+    def result(self) -> Optional[List[Dict[str, Any]]]:
+        """Rows as `query_wmi_table()` returns them; waits for the query first."""
+        self.wait()
+        return self._rows
+
+    def close(self) -> None:
+        """Release the native query, waiting for it to finish (at most its deadline)."""
+        if self._handle:
+            _lib.wmi_query_free(self._handle)
+            self._handle = ctypes.c_void_p()
+
+    def __enter__(self) -> "PendingWmiQuery":
+        return self
+
+    def __exit__(self, *exc) -> None:
+        self.close()
+
+    def __del__(self) -> None:
+        self.close()
+
+
+def start_wmi_table_query(
+    query: str, columns: Sequence[str], namespace: str = DEFAULT_NAMESPACE, timeout_ms: int = 0
+) -> PendingWmiQuery:
+    """
+    Start a `query_wmi_table()` on a native worker thread and return at once, so queries against several
+    namespaces run side by side. The GIL is not held while the query runs. A DLL without the async export
+    runs the query right here instead.
+    """
+    return PendingWmiQuery(query, columns, namespace, timeout_ms)
+
+
+def _fleet_text(value: Optional[str]) -> Optional[bytes]:
+    return value.encode("utf-8") if value else None
+
+
+def collect_wmi_fleet(
+    hosts: Sequence[WmiHost],
+    queries: Sequence[WmiFleetQuery],
+    max_concurrency: int = 8,
+    host_timeout_ms: int = QUERY_TIMEOUT_MS,
+) -> Iterator[WmiFleetResult]:
+    """
+    Run every query against every host natively, `max_concurrency` hosts at a time, one WMI connection per host
+    and namespace for all of its queries, and yield each (host, query) result as it completes.
+    `host_timeout_ms` bounds each host as a whole (0: no deadline). Closing the iterator early cancels the hosts
+    still pending. A DLL without the fleet exports yields nothing.
+    """
+    if not _HAS_FLEET or not hosts or not queries:
+        return
+
+    native_hosts = (_WmiFleetHost * len(hosts))(*[
+        _WmiFleetHost(_fleet_text(h.host), _fleet_text(h.user), _fleet_text(h.password), _fleet_text(h.authority))
+        for h in hosts
+    ])
+    column_arrays = [_column_array(q.columns) for q in queries]
+    native_queries = (_WmiFleetQuery * len(queries))(*[
+        _WmiFleetQuery(q.query.encode("utf-8"), q.namespace.encode("utf-8"), columns, len(q.columns))
+        for q, columns in zip(queries, column_arrays)
+    ])
+
+    fleet = ctypes.c_void_p()
+    if _lib.wmi_fleet_start(native_hosts, len(hosts), native_queries, len(queries), max(1, max_concurrency),
+                            host_timeout_ms, ctypes.byref(fleet)) != WMI_STATUS_OK:
+        return
+
+    try:
+        result, table = _WmiFleetResult(), ctypes.c_void_p()
+        while True:
+            # Wait in slices, so Ctrl+C reaches the caller between them
+            status = _lib.wmi_fleet_next(fleet, 500, ctypes.byref(result), ctypes.byref(table))
+            if status == WMI_STATUS_TIMED_OUT:
+                continue
+            if status != WMI_STATUS_OK:  # WMI_STATUS_NO_MORE
+                break
+
+            query = queries[result.query_index]
+            rows = _read_table(table, query.columns) if table else None
+            yield WmiFleetResult(
+                host=hosts[result.host_index],
+                query=query,
+                rows=rows,
+                timed_out=result.status == WMI_STATUS_TIMED_OUT,
+                hresult=result.hresult,
+            )
+    finally:
+        _lib.wmi_fleet_free(fleet)
+
+
+if __name__ == "__main__":
+    with session_pool():
+        print(query_wmi("SELECT Caption, Version FROM Win32_OperatingSystem"))
+        for row in query_wmi_table("SELECT Name, NumberOfCores FROM Win32_Processor", ["Name", "NumberOfCores"]) or []:
+            print(row)
+        print(get_session_pool_stats())
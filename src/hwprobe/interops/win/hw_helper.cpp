@@ -36,12 +36,20 @@
 
 #include <iostream>
 #include <sstream>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <algorithm>
+#include <unordered_map>
+#include <mutex>
 #include <cwctype>
 
 #include "hw_helper.hpp"
+#include "include/com_apartment.h"
+#include "include/pnp_id.h"
+#include "../common/include/bench_stages.h"
+#include "../common/include/smbios.h"
 
 #pragma comment(lib, "dxgi.lib")
 #pragma comment(lib, "wbemuuid.lib")
@@ -54,19 +62,14 @@
 #pragma comment(lib, "shlwapi.lib")
 #pragma comment(lib, "cfgmgr32.lib")
 
-// Helper: get SMBIOS string by index
-static char *GetSMBIOSString(const uint8_t *strings, uint8_t index)
+// Helper: copy an SMBIOS string view into one of the fixed SMBIOSHwInfo fields
+template <size_t N>
+static void CopySMBIOSString(char (&dst)[N], std::string_view src)
 {
-    if (index == 0)
-        return nullptr;
-
-    const char *p = reinterpret_cast<const char *>(strings);
-    while (--index && *p)
-    {
-        p += std::strlen(p) + 1;
-    }
-
-    return *p ? const_cast<char *>(p) : nullptr;
+    size_t len = src.size() < N - 1 ? src.size() : N - 1;
+    if (len)
+        memcpy(dst, src.data(), len);
+    dst[len] = '\0';
 }
 
 // Helper: convert wide string to char buffer
@@ -109,88 +112,97 @@ std::string WideToUtf8(PCWSTR src)
     return out;
 }
 
-// Helper: look up endpoint DataFlow from Core Audio API by matching friendly name
-std::string GetEndpointDataFlow(const std::string &endpointName)
+// Helper: uppercase copy of a wide string, used for case-insensitive map keys
+static std::wstring UpperCopy(const std::wstring &src)
 {
-    std::string dataFlow = "Unknown";
-
-    HRESULT hr = CoInitializeEx(NULL, COINIT_MULTITHREADED);
-    if (FAILED(hr) && hr != RPC_E_CHANGED_MODE)
-        return dataFlow;
-
-    IMMDeviceEnumerator *pEnumerator = NULL;
-    if (FAILED(CoCreateInstance(__uuidof(MMDeviceEnumerator), NULL, CLSCTX_ALL, IID_PPV_ARGS(&pEnumerator))))
-    {
-        if (hr == S_OK)
-            CoUninitialize();
-        return dataFlow;
-    }
-
-    EDataFlow flows[] = {eRender, eCapture};
-    const char *flowNames[] = {"Render", "Capture"};
+    std::wstring out = src;
+    for (auto &ch : out)
+        ch = towupper(ch);
+    return out;
+}
 
-    for (int flow = 0; flow < 2; flow++)
+// Helper: snapshot of the active Core Audio endpoints and their DataFlow, built once per
+// GetAudioHardwareInfo call. Keyed by endpoint ID (what the SWD\MMDEVAPI child devnode is
+// named after) and by friendly name. COM must already be initialized on the calling thread.
+class AudioEndpointMap
+{
+public:
+    void Build()
     {
-        IMMDeviceCollection *pDevices = NULL;
-        if (FAILED(pEnumerator->EnumAudioEndpoints(flows[flow], DEVICE_STATE_ACTIVE, &pDevices)))
-            continue;
+        DEVICE_INFO_STAGE("AudioEndpointMap::Build");
+        IMMDeviceEnumerator *pEnumerator = NULL;
+        if (FAILED(CoCreateInstance(__uuidof(MMDeviceEnumerator), NULL, CLSCTX_ALL, IID_PPV_ARGS(&pEnumerator))))
+            return;
 
-        UINT count = 0;
-        pDevices->GetCount(&count);
+        EDataFlow flows[] = {eRender, eCapture};
+        const char *flowNames[] = {"Render", "Capture"};
 
-        for (UINT d = 0; d < count; d++)
+        for (int flow = 0; flow < 2; flow++)
         {
-            IMMDevice *pDevice = NULL;
-            if (FAILED(pDevices->Item(d, &pDevice)))
+            IMMDeviceCollection *pDevices = NULL;
+            if (FAILED(pEnumerator->EnumAudioEndpoints(flows[flow], DEVICE_STATE_ACTIVE, &pDevices)))
                 continue;
 
-            IPropertyStore *pProps = NULL;
-            if (FAILED(pDevice->OpenPropertyStore(STGM_READ, &pProps)))
+            UINT count = 0;
+            pDevices->GetCount(&count);
+
+            for (UINT d = 0; d < count; d++)
             {
-                pDevice->Release();
-                continue;
-            }
+                IMMDevice *pDevice = NULL;
+                if (FAILED(pDevices->Item(d, &pDevice)))
+                    continue;
 
-            PROPVARIANT varName;
-            PropVariantInit(&varName);
+                LPWSTR endpointId = NULL;
+                if (SUCCEEDED(pDevice->GetId(&endpointId)) && endpointId)
+                {
+                    byId.emplace(UpperCopy(endpointId), flowNames[flow]);
+                    CoTaskMemFree(endpointId);
+                }
 
-            if (FAILED(pProps->GetValue(PKEY_Device_FriendlyName, &varName)))
-            {
-                pProps->Release();
-                pDevice->Release();
-                continue;
-            }
+                IPropertyStore *pProps = NULL;
+                if (SUCCEEDED(pDevice->OpenPropertyStore(STGM_READ, &pProps)))
+                {
+                    PROPVARIANT varName;
+                    PropVariantInit(&varName);
 
-            std::string currentName = WideToUtf8(varName.pwszVal);
+                    // first match wins, so Render takes precedence over Capture as before
+                    if (SUCCEEDED(pProps->GetValue(PKEY_Device_FriendlyName, &varName)) && varName.vt == VT_LPWSTR)
+                        byName.emplace(WideToUtf8(varName.pwszVal), flowNames[flow]);
+
+                    PropVariantClear(&varName);
+                    pProps->Release();
+                }
 
-            // match by friendly name
-            if (currentName == endpointName)
-            {
-                dataFlow = flowNames[flow];
-                PropVariantClear(&varName);
-                pProps->Release();
                 pDevice->Release();
-                pDevices->Release();
-                pEnumerator->Release();
-                if (hr == S_OK)
-                    CoUninitialize();
-                return dataFlow;
             }
 
-            PropVariantClear(&varName);
-            pProps->Release();
-            pDevice->Release();
+            pDevices->Release();
         }
 
-        pDevices->Release();
+        pEnumerator->Release();
     }
 
-    pEnumerator->Release();
-    if (hr == S_OK)
-        CoUninitialize();
+    // Resolves a child devnode to its endpoint's DataFlow, or "Unknown" if it is not an active endpoint.
+    std::string DataFlow(const std::wstring &childPnpId, const std::string &friendlyName) const
+    {
+        // SWD\MMDEVAPI\{0.0.0.00000000}.{guid} -> {0.0.0.00000000}.{guid}
+        std::wstring upperId = UpperCopy(childPnpId);
+        const std::wstring prefix = L"SWD\\MMDEVAPI\\";
+        if (upperId.compare(0, prefix.size(), prefix) == 0)
+        {
+            auto it = byId.find(upperId.substr(prefix.size()));
+            if (it != byId.end())
+                return it->second;
+        }
 
-    return dataFlow;
-}
+        auto it = byName.find(friendlyName);
+        return it != byName.end() ? it->second : "Unknown";
+    }
+
+private:
+    std::unordered_map<std::wstring, const char *> byId;
+    std::unordered_map<std::string, const char *> byName;
+};
 
 // Core function
 HardwareHelper_RESULT GetGPUForDisplayInternal(const char *deviceName, char *outGPUName, unsigned int bufSize)
@@ -204,6 +216,7 @@ HardwareHelper_RESULT GetGPUForDisplayInternal(const char *deviceName, char *out
     if (bufSize <= 0)
         return STATUS_INVALID_ARG;
 
+    DEVICE_INFO_STAGE("GetGPUForDisplay");
     IDXGIFactory6 *factory = nullptr;
     if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&factory))))
     {
@@ -274,34 +287,138 @@ extern "C" __declspec(dllexport) HardwareHelper_RESULT GetGPUForDisplay(const ch
     return GetGPUForDisplayInternal(deviceName, outGPUName, bufSize);
 }
 
-extern "C" __declspec(dllexport) HardwareHelper_RESULT GetDisplayPathInfo(char *connectorOut, int bufSize)
+// Batched GetGPUForDisplay: every DXGI output with the adapter driving it, from one factory.
+// Writes up to maxCount entries and sets *outCount to the total number of outputs; returns
+// STATUS_NOK if that total did not fit, so the caller can retry with a bigger buffer.
+extern "C" __declspec(dllexport) HardwareHelper_RESULT GetDisplayAdapterMap(DisplayAdapterEntry *out, int maxCount, int *outCount)
 {
-    long retCode;
-    std::string outputStr;
-    uint32_t pathCount, modeCount;
+    if (outCount == nullptr || maxCount < 0 || (out == nullptr && maxCount > 0))
+        return STATUS_INVALID_ARG;
+    *outCount = 0;
 
-    retCode = GetDisplayConfigBufferSizes(QDC_ONLY_ACTIVE_PATHS, &pathCount, &modeCount);
-    if (retCode != ERROR_SUCCESS)
+    DEVICE_INFO_STAGE("GetDisplayAdapterMap");
+    IDXGIFactory1 *factory = nullptr;
+    if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&factory))))
         return STATUS_FAILURE;
 
-    DISPLAYCONFIG_PATH_INFO *pathInfo = new DISPLAYCONFIG_PATH_INFO[pathCount];
-    DISPLAYCONFIG_MODE_INFO *modeInfo = new DISPLAYCONFIG_MODE_INFO[modeCount];
-    retCode = QueryDisplayConfig(QDC_ONLY_ACTIVE_PATHS, &pathCount, pathInfo, &modeCount, modeInfo, nullptr);
-    if (retCode != ERROR_SUCCESS)
+    int total = 0;
+    IDXGIAdapter1 *adapter = nullptr;
+    for (UINT a = 0; factory->EnumAdapters1(a, &adapter) != DXGI_ERROR_NOT_FOUND; ++a)
+    {
+        DXGI_ADAPTER_DESC1 descAdapter;
+        if (FAILED(adapter->GetDesc1(&descAdapter)))
+        {
+            adapter->Release();
+            continue;
+        }
+
+        // Converted once per adapter, and only if it drives at least one output
+        char adapterName[128] = {};
+        bool adapterNameReady = false;
+
+        IDXGIOutput *output = nullptr;
+        for (UINT o = 0; adapter->EnumOutputs(o, &output) != DXGI_ERROR_NOT_FOUND; ++o)
+        {
+            DXGI_OUTPUT_DESC descOutput;
+            if (FAILED(output->GetDesc(&descOutput)))
+            {
+                output->Release();
+                continue;
+            }
+
+            if (total < maxCount)
+            {
+                if (!adapterNameReady)
+                {
+                    ws2s(descAdapter.Description, adapterName, sizeof(adapterName));
+                    adapterNameReady = true;
+                }
+
+                DisplayAdapterEntry &entry = out[total];
+                entry = {};
+                ws2s(descOutput.DeviceName, entry.deviceName, sizeof(entry.deviceName));
+                memcpy(entry.adapterName, adapterName, sizeof(entry.adapterName));
+                entry.adapterLuidLow = descAdapter.AdapterLuid.LowPart;
+                entry.adapterLuidHigh = descAdapter.AdapterLuid.HighPart;
+                entry.vendorId = descAdapter.VendorId;
+                entry.deviceId = descAdapter.DeviceId;
+            }
+            ++total;
+            output->Release();
+        }
+
+        adapter->Release();
+    }
+
+    factory->Release();
+    *outCount = total;
+    return total <= maxCount ? STATUS_OK : STATUS_NOK;
+}
+
+// ---- Display topology ----
+// Pollers call this every few seconds: the QueryDisplayConfig buffers are kept per thread and
+// only grow, and a generation counter changes only when the set of active paths does.
+
+static constexpr int kTopologyQueryAttempts = 4;
+
+static thread_local std::vector<DISPLAYCONFIG_PATH_INFO> t_pathInfo;
+static thread_local std::vector<DISPLAYCONFIG_MODE_INFO> t_modeInfo;
+
+static std::mutex g_topologyMutex;
+static std::vector<DisplayPathRecord> g_lastTopology;
+static uint64_t g_topologyGeneration = 0;
+
+template <size_t N>
+static void CopyUtf8(char (&dst)[N], PCWSTR src)
+{
+    std::string utf8 = WideToUtf8(src);
+    CopySMBIOSString(dst, utf8);
+}
+
+// Active paths into the thread's buffers; retries when a hot-plug changes the path count
+// between GetDisplayConfigBufferSizes and QueryDisplayConfig.
+static LONG QueryActivePaths(uint32_t &pathCount, uint32_t &modeCount)
+{
+    DEVICE_INFO_STAGE("QueryDisplayConfig");
+    LONG retCode = ERROR_INSUFFICIENT_BUFFER;
+    for (int attempt = 0; attempt < kTopologyQueryAttempts && retCode == ERROR_INSUFFICIENT_BUFFER; ++attempt)
+    {
+        retCode = GetDisplayConfigBufferSizes(QDC_ONLY_ACTIVE_PATHS, &pathCount, &modeCount);
+        if (retCode != ERROR_SUCCESS)
+            return retCode;
+
+        if (t_pathInfo.size() < pathCount)
+            t_pathInfo.resize(pathCount);
+        if (t_modeInfo.size() < modeCount)
+            t_modeInfo.resize(modeCount);
+
+        pathCount = static_cast<uint32_t>(t_pathInfo.size());
+        modeCount = static_cast<uint32_t>(t_modeInfo.size());
+        retCode = QueryDisplayConfig(QDC_ONLY_ACTIVE_PATHS, &pathCount, t_pathInfo.data(),
+                                     &modeCount, t_modeInfo.data(), nullptr);
+    }
+    return retCode;
+}
+
+static HardwareHelper_RESULT CollectDisplayTopology(std::vector<DisplayPathRecord> &records)
+{
+    DEVICE_INFO_STAGE("CollectDisplayTopology");
+    uint32_t pathCount = 0, modeCount = 0;
+    if (QueryActivePaths(pathCount, modeCount) != ERROR_SUCCESS)
         return STATUS_FAILURE;
 
+    records.clear();
+    records.reserve(pathCount);
     for (uint32_t i = 0; i < pathCount; i++)
     {
-        DISPLAYCONFIG_PATH_INFO &path = pathInfo[i];
+        const DISPLAYCONFIG_PATH_INFO &path = t_pathInfo[i];
 
         DISPLAYCONFIG_SOURCE_DEVICE_NAME sourceDeviceName = {};
         sourceDeviceName.header.type = DISPLAYCONFIG_DEVICE_INFO_GET_SOURCE_NAME;
         sourceDeviceName.header.size = sizeof(sourceDeviceName);
         sourceDeviceName.header.adapterId = path.sourceInfo.adapterId;
         sourceDeviceName.header.id = path.sourceInfo.id;
-
-        retCode = DisplayConfigGetDeviceInfo(&sourceDeviceName.header);
-        if (retCode != ERROR_SUCCESS)
+        if (DisplayConfigGetDeviceInfo(&sourceDeviceName.header) != ERROR_SUCCESS)
             continue;
 
         DISPLAYCONFIG_TARGET_DEVICE_NAME targetDeviceName = {};
@@ -309,59 +426,180 @@ extern "C" __declspec(dllexport) HardwareHelper_RESULT GetDisplayPathInfo(char *
         targetDeviceName.header.size = sizeof(targetDeviceName);
         targetDeviceName.header.adapterId = path.targetInfo.adapterId;
         targetDeviceName.header.id = path.targetInfo.id;
-
-        retCode = DisplayConfigGetDeviceInfo(&targetDeviceName.header);
-        if (retCode != ERROR_SUCCESS)
+        if (DisplayConfigGetDeviceInfo(&targetDeviceName.header) != ERROR_SUCCESS)
             continue;
 
-        std::string displayId = WideToUtf8(sourceDeviceName.viewGdiDeviceName);
-        std::string displayPath = WideToUtf8(targetDeviceName.monitorDevicePath);
-        outputStr += "DisplayID=" + displayId + "|" +
-                     "DisplayPath=" + displayPath + "|" +
-                     "OutputTechnology=" + std::to_string(path.targetInfo.outputTechnology) + "\n";
+        // Zeroed so unchanged topologies compare equal byte for byte
+        DisplayPathRecord record = {};
+        CopyUtf8(record.gdiDeviceName, sourceDeviceName.viewGdiDeviceName);
+        CopyUtf8(record.monitorDevicePath, targetDeviceName.monitorDevicePath);
+        record.outputTechnology = static_cast<uint32_t>(path.targetInfo.outputTechnology);
+        record.refreshNumerator = path.targetInfo.refreshRate.Numerator;
+        record.refreshDenominator = path.targetInfo.refreshRate.Denominator;
+        record.adapterLuidLow = path.sourceInfo.adapterId.LowPart;
+        record.adapterLuidHigh = path.sourceInfo.adapterId.HighPart;
+        record.targetId = path.targetInfo.id;
+
+        const UINT32 sourceMode = path.sourceInfo.modeInfoIdx;
+        if (sourceMode != DISPLAYCONFIG_PATH_MODE_IDX_INVALID && sourceMode < modeCount &&
+            t_modeInfo[sourceMode].infoType == DISPLAYCONFIG_MODE_INFO_TYPE_SOURCE)
+        {
+            record.width = t_modeInfo[sourceMode].sourceMode.width;
+            record.height = t_modeInfo[sourceMode].sourceMode.height;
+        }
+
+        records.push_back(record);
+    }
+    return STATUS_OK;
+}
+
+// Bumps the generation if `records` differs from the previous snapshot
+static uint64_t PublishTopology(const std::vector<DisplayPathRecord> &records)
+{
+    std::lock_guard<std::mutex> lock(g_topologyMutex);
+    const bool unchanged = g_topologyGeneration != 0 && records.size() == g_lastTopology.size() &&
+                           (records.empty() ||
+                            memcmp(records.data(), g_lastTopology.data(),
+                                   records.size() * sizeof(DisplayPathRecord)) == 0);
+    if (!unchanged)
+    {
+        g_lastTopology = records;
+        ++g_topologyGeneration;
     }
+    return g_topologyGeneration;
+}
+
+// Active display paths as fixed-size records. Writes up to maxCount records and sets *outCount to
+// the number of active paths (STATUS_NOK if they did not fit). *outGeneration, if given, is a
+// counter that only changes when the topology does, so pollers can skip unchanged results.
+extern "C" __declspec(dllexport) HardwareHelper_RESULT GetDisplayTopology(DisplayPathRecord *out, int maxCount, int *outCount, uint64_t *outGeneration)
+{
+    if (outCount == nullptr || maxCount < 0 || (out == nullptr && maxCount > 0))
+        return STATUS_INVALID_ARG;
+    *outCount = 0;
+
+    thread_local std::vector<DisplayPathRecord> records;
+    HardwareHelper_RESULT result = CollectDisplayTopology(records);
+    if (result != STATUS_OK)
+        return result;
+
+    const uint64_t generation = PublishTopology(records);
+    if (outGeneration != nullptr)
+        *outGeneration = generation;
+
+    *outCount = static_cast<int>(records.size());
+    if (records.size() > static_cast<size_t>(maxCount))
+        return STATUS_NOK;
 
-    if (outputStr.length() > 0)
+    if (!records.empty())
+        memcpy(out, records.data(), records.size() * sizeof(DisplayPathRecord));
+    return STATUS_OK;
+}
+
+extern "C" __declspec(dllexport) HardwareHelper_RESULT GetDisplayPathInfo(char *connectorOut, int bufSize)
+{
+    if (connectorOut == nullptr || bufSize <= 0)
+        return STATUS_INVALID_ARG;
+
+    thread_local std::vector<DisplayPathRecord> records;
+    if (CollectDisplayTopology(records) != STATUS_OK || records.empty())
+        return STATUS_FAILURE;
+    PublishTopology(records);
+
+    std::string outputStr;
+    for (const DisplayPathRecord &record : records)
     {
-        strncpy_s(connectorOut, bufSize, outputStr.c_str(), _TRUNCATE);
-        retCode = STATUS_OK;
+        // Same LUID as DisplayAdapterEntry, so the two results can be joined per adapter
+        char adapterLuid[24];
+        snprintf(adapterLuid, sizeof(adapterLuid), "%08lX%08lX",
+                 static_cast<unsigned long>(static_cast<uint32_t>(record.adapterLuidHigh)),
+                 static_cast<unsigned long>(record.adapterLuidLow));
+
+        outputStr += std::string("DisplayID=") + record.gdiDeviceName + "|" +
+                     "DisplayPath=" + record.monitorDevicePath + "|" +
+                     "OutputTechnology=" + std::to_string(record.outputTechnology) + "|" +
+                     "AdapterLUID=" + adapterLuid + "\n";
     }
-    else
+
+    strncpy_s(connectorOut, bufSize, outputStr.c_str(), _TRUNCATE);
+    return STATUS_OK;
+}
+
+// Helper: appends one "Name=Value|Name=Value|...\n" line with every non-system property of `pclsObj`.
+static void AppendWmiObjectText(IWbemClassObject *pclsObj, std::string &result)
+{
+    SAFEARRAY *pNames = nullptr;
+    HRESULT hr = pclsObj->GetNames(
+        nullptr,
+        WBEM_FLAG_NONSYSTEM_ONLY,
+        nullptr,
+        &pNames);
+
+    if (FAILED(hr) || !pNames)
+        return;
+
+    LONG lBound = 0, uBound = -1;
+    SafeArrayGetLBound(pNames, 1, &lBound);
+    SafeArrayGetUBound(pNames, 1, &uBound);
+
+    for (LONG i = lBound; i <= uBound; i++)
     {
-        retCode = STATUS_FAILURE;
+        BSTR propName = nullptr;
+        SafeArrayGetElement(pNames, &i, &propName);
+
+        VARIANT vtProp;
+        VariantInit(&vtProp);
+
+        if (SUCCEEDED(pclsObj->Get(propName, 0, &vtProp, nullptr, nullptr)))
+        {
+            WCHAR variantStr[1024] = {};
+            VariantToString(vtProp, variantStr, 1024);
+
+            result += (const char *)_bstr_t(propName);
+            result += "=";
+            result += WideToUtf8(variantStr);
+            result += "|";
+        }
+
+        VariantClear(&vtProp);
+        SysFreeString(propName);
     }
 
-    delete[] pathInfo;
-    delete[] modeInfo;
-    return static_cast<HardwareHelper_RESULT>(retCode);
+    result += "\n";
+    SafeArrayDestroy(pNames);
 }
 
 extern "C" __declspec(dllexport) void GetWmiInfo(char *wmiQuery, char *cimServer, char *outBuffer, int maxLen)
 {
+    if (outBuffer == nullptr || maxLen <= 0)
+        return;
+    outBuffer[0] = '\0';
+    if (wmiQuery == nullptr)
+        return;
     if (cimServer == nullptr || strlen(cimServer) == 0)
         cimServer = "ROOT\\CIMV2";
 
-    HRESULT hr = CoInitializeEx(0, COINIT_MULTITHREADED);
-    if (FAILED(hr) && hr != RPC_E_CHANGED_MODE)
+    DEVICE_INFO_STAGE("GetWmiInfo");
+    // Joins this call to the MTA and leaves an STA caller as it was; the apartment and every
+    // interface below are released before it is left.
+    com::ComApartment apartment;
+    if (!apartment.usable())
         return;
-
-    hr = CoInitializeSecurity(NULL, -1, NULL, NULL, RPC_C_AUTHN_LEVEL_DEFAULT,
-                              RPC_C_IMP_LEVEL_IMPERSONATE, NULL, EOAC_NONE, NULL);
+    com::EnsureProcessSecurity();
 
     IWbemLocator *pLoc = NULL;
-    hr = CoCreateInstance(CLSID_WbemLocator, 0, CLSCTX_INPROC_SERVER, IID_IWbemLocator, (LPVOID *)&pLoc);
+    HRESULT hr = CoCreateInstance(CLSID_WbemLocator, 0, CLSCTX_INPROC_SERVER, IID_IWbemLocator, (LPVOID *)&pLoc);
     if (FAILED(hr))
-    {
-        CoUninitialize();
         return;
-    }
 
     IWbemServices *pSvc = NULL;
-    hr = pLoc->ConnectServer(_bstr_t(cimServer), NULL, NULL, 0, NULL, 0, 0, &pSvc);
+    {
+        DEVICE_INFO_STAGE("IWbemLocator::ConnectServer");
+        hr = pLoc->ConnectServer(_bstr_t(cimServer), NULL, NULL, 0, NULL, 0, 0, &pSvc);
+    }
     if (FAILED(hr))
     {
         pLoc->Release();
-        CoUninitialize();
         return;
     }
 
@@ -369,71 +607,40 @@ extern "C" __declspec(dllexport) void GetWmiInfo(char *wmiQuery, char *cimServer
                            RPC_C_AUTHN_LEVEL_CALL, RPC_C_IMP_LEVEL_IMPERSONATE, NULL, EOAC_NONE);
 
     IEnumWbemClassObject *pEnumerator = NULL;
-    hr = pSvc->ExecQuery(bstr_t("WQL"),
-                         bstr_t(wmiQuery),
-                         WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY, NULL, &pEnumerator);
+    {
+        DEVICE_INFO_STAGE("IWbemServices::ExecQuery");
+        hr = pSvc->ExecQuery(bstr_t("WQL"),
+                             bstr_t(wmiQuery),
+                             WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY, NULL, &pEnumerator);
+    }
 
     if (FAILED(hr))
     {
         pSvc->Release();
         pLoc->Release();
-        CoUninitialize();
         return;
     }
 
-    IWbemClassObject *pclsObj = NULL;
+    // Fetched in batches: one round trip to the provider per 64 objects instead of per object
+    IWbemClassObject *pObjects[64] = {};
     ULONG uReturn = 0;
     std::string result = "";
 
     while (pEnumerator)
     {
-        hr = pEnumerator->Next(WBEM_INFINITE, 1, &pclsObj, &uReturn);
-        if (0 == uReturn)
-            break;
-
-        SAFEARRAY *pNames = nullptr;
-        hr = pclsObj->GetNames(
-            nullptr,
-            WBEM_FLAG_NONSYSTEM_ONLY,
-            nullptr,
-            &pNames);
-
-        if (FAILED(hr) || !pNames)
         {
-            pclsObj->Release();
-            continue;
+            DEVICE_INFO_STAGE("IEnumWbemClassObject::Next");
+            hr = pEnumerator->Next(WBEM_INFINITE, ARRAYSIZE(pObjects), pObjects, &uReturn);
         }
-
-        LONG lBound = 0, uBound = -1;
-        SafeArrayGetLBound(pNames, 1, &lBound);
-        SafeArrayGetUBound(pNames, 1, &uBound);
-
-        for (LONG i = lBound; i <= uBound; i++)
+        for (ULONG o = 0; o < uReturn; o++)
         {
-            BSTR propName = nullptr;
-            SafeArrayGetElement(pNames, &i, &propName);
-
-            VARIANT vtProp;
-            VariantInit(&vtProp);
-
-            if (SUCCEEDED(pclsObj->Get(propName, 0, &vtProp, nullptr, nullptr)))
-            {
-                WCHAR variantStr[1024] = {};
-                VariantToString(vtProp, variantStr, 1024);
-
-                result += (const char *)_bstr_t(propName);
-                result += "=";
-                result += WideToUtf8(variantStr);
-                result += "|";
-            }
-
-            VariantClear(&vtProp);
-            SysFreeString(propName);
+            AppendWmiObjectText(pObjects[o], result);
+            pObjects[o]->Release();
         }
 
-        result += "\n";
-        SafeArrayDestroy(pNames);
-        pclsObj->Release();
+        // WBEM_S_FALSE (fewer objects than requested) ends the enumeration, as does any error
+        if (hr != WBEM_S_NO_ERROR)
+            break;
     }
 
     strncpy_s(outBuffer, maxLen, result.c_str(), _TRUNCATE);
@@ -443,46 +650,104 @@ extern "C" __declspec(dllexport) void GetWmiInfo(char *wmiQuery, char *cimServer
         pEnumerator->Release();
     pSvc->Release();
     pLoc->Release();
-    CoUninitialize();
 }
 
-extern "C" __declspec(dllexport) int GetNetworkHardwareInfo(char *outData, int outDataLen)
+// Helper: NetCfgInstanceId -> {PnP instance ID, manufacturer} for every present NET-class devnode,
+// built once per GetNetworkHardwareInfo call, so each driver key is opened once instead of once
+// per adapter. Keyed by the upper-cased GUID string IP Helper reports as AdapterName.
+class NetAdapterIndex
 {
-    if (outData == nullptr || outDataLen <= 0)
-        return STATUS_INVALID_ARG;
-
-    ULONG outBufLen = 15000;
-    PIP_ADAPTER_ADDRESSES pAddresses = NULL;
-    DWORD dwRetVal = 0;
-    ULONG iterations = 0;
+public:
+    struct Entry
+    {
+        std::wstring pnpInstanceId;
+        std::wstring manufacturer;
+    };
 
-    do
+    void Build()
     {
-        pAddresses = (PIP_ADAPTER_ADDRESSES)malloc(outBufLen);
-        if (pAddresses == NULL)
-            return STATUS_FAILURE; // OOM
+        DEVICE_INFO_STAGE("NetAdapterIndex::Build");
+        HDEVINFO devInfo = SetupDiGetClassDevs(&GUID_DEVCLASS_NET, NULL, NULL, DIGCF_PRESENT);
+        if (devInfo == INVALID_HANDLE_VALUE)
+            return;
 
-        dwRetVal = GetAdaptersAddresses(AF_UNSPEC, GAA_FLAG_INCLUDE_ALL_INTERFACES, NULL, pAddresses, &outBufLen);
-        if (dwRetVal == ERROR_BUFFER_OVERFLOW)
-        {
-            free(pAddresses);
-            pAddresses = NULL;
-        }
-        else
+        SP_DEVINFO_DATA devData = {sizeof(SP_DEVINFO_DATA)};
+        for (DWORD i = 0; SetupDiEnumDeviceInfo(devInfo, i, &devData); i++)
         {
-            break;
+            HKEY hKey = SetupDiOpenDevRegKey(devInfo, &devData, DICS_FLAG_GLOBAL, 0, DIREG_DRV, KEY_READ);
+            if (hKey == INVALID_HANDLE_VALUE)
+                continue;
+
+            WCHAR netCfgId[128] = {};
+            DWORD dwSize = sizeof(netCfgId) - sizeof(WCHAR);
+            const LONG status = RegQueryValueExW(hKey, L"NetCfgInstanceId", NULL, NULL, (LPBYTE)netCfgId, &dwSize);
+            RegCloseKey(hKey);
+            if (status != ERROR_SUCCESS)
+                continue;
+
+            Entry entry;
+            WCHAR pnpBuffer[MAX_DEVICE_ID_LEN];
+            if (SetupDiGetDeviceInstanceIdW(devInfo, &devData, pnpBuffer, MAX_DEVICE_ID_LEN, NULL))
+                entry.pnpInstanceId = pnpBuffer;
+
+            WCHAR mfgBuffer[256];
+            if (SetupDiGetDeviceRegistryPropertyW(devInfo, &devData, SPDRP_MFG, NULL, (PBYTE)mfgBuffer, sizeof(mfgBuffer), NULL))
+                entry.manufacturer = mfgBuffer;
+
+            // first devnode wins, as the linear search did
+            byGuid.emplace(UpperCopy(netCfgId), std::move(entry));
         }
-        iterations++;
-    } while ((dwRetVal == ERROR_BUFFER_OVERFLOW) && (iterations < 3));
 
-    if (dwRetVal != NO_ERROR)
+        SetupDiDestroyDeviceInfoList(devInfo);
+    }
+
+    const Entry *Find(const std::wstring &adapterGuid) const
     {
-        if (pAddresses)
-            free(pAddresses);
-        return STATUS_FAILURE;
+        auto it = byGuid.find(UpperCopy(adapterGuid));
+        return it != byGuid.end() ? &it->second : nullptr;
     }
 
-    HDEVINFO devInfo = SetupDiGetClassDevs(&GUID_DEVCLASS_NET, NULL, NULL, DIGCF_PRESENT);
+private:
+    std::unordered_map<std::wstring, Entry> byGuid;
+};
+
+static constexpr int kAdaptersQueryAttempts = 3;
+
+// Kept per thread and only grown, so a steady adapter list costs one GetAdaptersAddresses call
+static thread_local std::vector<unsigned char> t_adapterAddresses;
+
+// Adapter list into the thread's buffer; retries when adapters appear between the size guess and the call.
+static DWORD QueryAdapterAddresses(PIP_ADAPTER_ADDRESSES &out)
+{
+    DEVICE_INFO_STAGE("GetAdaptersAddresses");
+    if (t_adapterAddresses.empty())
+        t_adapterAddresses.resize(15000);
+
+    DWORD dwRetVal = ERROR_BUFFER_OVERFLOW;
+    for (int attempt = 0; attempt < kAdaptersQueryAttempts && dwRetVal == ERROR_BUFFER_OVERFLOW; ++attempt)
+    {
+        ULONG outBufLen = static_cast<ULONG>(t_adapterAddresses.size());
+        out = reinterpret_cast<PIP_ADAPTER_ADDRESSES>(t_adapterAddresses.data());
+        dwRetVal = GetAdaptersAddresses(AF_UNSPEC, GAA_FLAG_INCLUDE_ALL_INTERFACES, NULL, out, &outBufLen);
+        if (dwRetVal == ERROR_BUFFER_OVERFLOW)
+            t_adapterAddresses.resize(outBufLen);
+    }
+    return dwRetVal;
+}
+
+extern "C" __declspec(dllexport) int GetNetworkHardwareInfo(char *outData, int outDataLen)
+{
+    if (outData == nullptr || outDataLen <= 0)
+        return STATUS_INVALID_ARG;
+
+    DEVICE_INFO_STAGE("GetNetworkHardwareInfo");
+    PIP_ADAPTER_ADDRESSES pAddresses = NULL;
+    DWORD dwRetVal = QueryAdapterAddresses(pAddresses);
+    if (dwRetVal != NO_ERROR)
+        return STATUS_FAILURE;
+
+    NetAdapterIndex adapters;
+    adapters.Build();
     std::string result = "";
 
     for (PIP_ADAPTER_ADDRESSES aa = pAddresses; aa; aa = aa->Next)
@@ -491,57 +756,20 @@ extern "C" __declspec(dllexport) int GetNetworkHardwareInfo(char *outData, int o
             continue;
 
         std::wstring wDesc = (const wchar_t *)_bstr_t(aa->Description);
-        std::wstring wFriendly = (const wchar_t *)_bstr_t(aa->FriendlyName);
         std::wstring wAdapterGuid = (const wchar_t *)_bstr_t(aa->AdapterName);
 
         std::wstring wManufacturer = L"Unknown";
         std::wstring wPnpInstanceId = wAdapterGuid; // Fallback to GUID if PnP ID not found
 
-        bool foundInRegistry = false;
-
-        if (devInfo != INVALID_HANDLE_VALUE)
+        if (const NetAdapterIndex::Entry *entry = adapters.Find(wAdapterGuid))
         {
-            SP_DEVINFO_DATA devData = {sizeof(SP_DEVINFO_DATA)};
-            for (DWORD i = 0; SetupDiEnumDeviceInfo(devInfo, i, &devData); i++)
-            {
-                HKEY hKey = SetupDiOpenDevRegKey(devInfo, &devData, DICS_FLAG_GLOBAL, 0, DIREG_DRV, KEY_READ);
-                if (hKey == INVALID_HANDLE_VALUE)
-                    continue;
-
-                WCHAR netCfgId[128];
-                DWORD dwSize = sizeof(netCfgId);
-
-                if (RegQueryValueExW(hKey, L"NetCfgInstanceId", NULL, NULL, (LPBYTE)netCfgId, &dwSize) != ERROR_SUCCESS)
-                {
-                    RegCloseKey(hKey);
-                    continue;
-                }
-
-                if (_wcsicmp(netCfgId, wAdapterGuid.c_str()) != 0)
-                {
-                    RegCloseKey(hKey);
-                    continue;
-                }
-
-                // Found matching adapter
-                WCHAR pnpBuffer[MAX_DEVICE_ID_LEN];
-                if (SetupDiGetDeviceInstanceIdW(devInfo, &devData, pnpBuffer, MAX_DEVICE_ID_LEN, NULL))
-                    wPnpInstanceId = pnpBuffer;
-
-                WCHAR mfgBuffer[256];
-                if (SetupDiGetDeviceRegistryPropertyW(devInfo, &devData, SPDRP_MFG, NULL, (PBYTE)mfgBuffer, sizeof(mfgBuffer), NULL))
-                    wManufacturer = mfgBuffer;
-
-                foundInRegistry = true;
-                RegCloseKey(hKey);
-                break;
-            }
+            if (!entry->pnpInstanceId.empty())
+                wPnpInstanceId = entry->pnpInstanceId;
+            if (!entry->manufacturer.empty())
+                wManufacturer = entry->manufacturer;
         }
 
-        std::wstring upperPnp = wPnpInstanceId;
-        for (auto &ch : upperPnp)
-            ch = towupper(ch);
-
+        std::wstring upperPnp = UpperCopy(wPnpInstanceId);
         if (upperPnp.find(L"PCI") == std::wstring::npos && upperPnp.find(L"USB") == std::wstring::npos)
             continue;
 
@@ -550,11 +778,6 @@ extern "C" __declspec(dllexport) int GetNetworkHardwareInfo(char *outData, int o
         result += "Name=" + WideToUtf8(wDesc.c_str()) + "\n";
     }
 
-    if (devInfo != INVALID_HANDLE_VALUE)
-        SetupDiDestroyDeviceInfoList(devInfo);
-    if (pAddresses)
-        free(pAddresses);
-
     // Safety: if result is still empty, the machine has no adapters or permissions
     if (result.empty())
     {
@@ -572,6 +795,7 @@ extern "C" __declspec(dllexport) int GetAudioHardwareInfo(char *outData, int out
     if (outData == nullptr || outDataLen <= 0)
         return STATUS_INVALID_ARG;
 
+    DEVICE_INFO_STAGE("GetAudioHardwareInfo");
     std::string finalResult = "";
 
     // enumerate audio hardware devices
@@ -579,6 +803,12 @@ extern "C" __declspec(dllexport) int GetAudioHardwareInfo(char *outData, int out
     if (devInfo == INVALID_HANDLE_VALUE)
         return STATUS_FAILURE;
 
+    // one COM apartment and one endpoint snapshot for the whole enumeration
+    com::ComApartment apartment;
+    AudioEndpointMap endpoints;
+    if (apartment.usable())
+        endpoints.Build();
+
     SP_DEVINFO_DATA devData = {sizeof(SP_DEVINFO_DATA)};
 
     for (DWORD i = 0; SetupDiEnumDeviceInfo(devInfo, i, &devData); i++)
@@ -596,8 +826,8 @@ extern "C" __declspec(dllexport) int GetAudioHardwareInfo(char *outData, int out
             ch = towupper(ch);
 
         // skip software devices (SWD), virtual devices (ROOT), and non-audio buses
-        if (upperPnp.find(L"SWD\\") == 0 ||
-            upperPnp.find(L"ROOT\\") == 0 ||
+        if (pnp::HasEnumerator(pnpBuffer, "SWD") ||
+            pnp::HasEnumerator(pnpBuffer, "ROOT") ||
             upperPnp.find(L"SCPVBUS\\") != std::wstring::npos)
             continue;
 
@@ -657,14 +887,7 @@ extern "C" __declspec(dllexport) int GetAudioHardwareInfo(char *outData, int out
                                               NULL, (PBYTE)hwIdBuffer, sizeof(hwIdBuffer), &hwIdSize))
         {
             if (hwIdSize > 0)
-            {
-                std::wstring hwId = hwIdBuffer;
-                if (hwId.find(L"VEN_") != std::wstring::npos ||
-                    hwId.find(L"VID_") != std::wstring::npos)
-                {
-                    hasValidHwId = true;
-                }
-            }
+                hasValidHwId = pnp::ParseHardwareId(hwIdBuffer).has_vendor;
         }
 
         // only include devices that have actual hardware vendor IDs
@@ -704,8 +927,8 @@ extern "C" __declspec(dllexport) int GetAudioHardwareInfo(char *outData, int out
                 {
                     std::string childName = WideToUtf8(childNameBuffer);
 
-                    // lookup dataflow from core audio api by matching endpoint name
-                    std::string dataFlow = GetEndpointDataFlow(childName);
+                    // lookup dataflow from the core audio endpoint snapshot
+                    std::string dataFlow = endpoints.DataFlow(childPnpBuffer, childName);
 
                     // assumption: if the data flown isn't known, the endpoint is not active/usable
                     if (dataFlow != "Unknown")
@@ -747,6 +970,9 @@ extern "C" __declspec(dllexport) int GetAudioHardwareInfo(char *outData, int out
     - Motherboard Model
     - Chassis Type
     - CPU Socket Type
+
+ * The firmware table is read once per process and indexed by the shared SMBIOS engine;
+ * every field is read with a length check against the structure it belongs to.
  */
 extern "C" __declspec(dllexport)
 HardwareHelper_RESULT
@@ -757,109 +983,46 @@ FetchSMBIOSData(SMBIOSHwInfo *outInfo)
 
     memset(outInfo, 0, sizeof(SMBIOSHwInfo));
 
-    DWORD size = GetSystemFirmwareTable('RSMB', 0, nullptr, 0);
-    if (!size)
-        return STATUS_FAILURE;
-
-    std::vector<uint8_t> buffer(size);
-    if (!GetSystemFirmwareTable('RSMB', 0, buffer.data(), size))
+    std::shared_ptr<const smbios::Table> table = smbios::Current();
+    if (!table)
         return STATUS_FAILURE;
 
-    const uint8_t *p = buffer.data() + 8; // Skip SMBIOS entry header
-
-    while (true)
+    // Baseboard
+    if (const smbios::Structure *bb = table->Find(2))
     {
-        const auto *hdr = reinterpret_cast<const SMBIOSHeader *>(p);
-        if (hdr->Type == 127)
-            break;
-
-        const uint8_t *strings = p + hdr->Length;
-
-        switch (hdr->Type)
-        {
-        case 2: // Baseboard
-        {
-            const auto *bb = reinterpret_cast<const SMBIOSBaseboard *>(p);
-
-            const char *man =
-                GetSMBIOSString(strings, bb->Manufacturer);
-            const char *prod =
-                GetSMBIOSString(strings, bb->Product);
-
-            if (man)
-                strncpy_s(outInfo->motherboardManufacturer,
-                          man, _TRUNCATE);
-
-            if (prod)
-                strncpy_s(outInfo->motherboardModel,
-                          prod, _TRUNCATE);
-            break;
-        }
+        CopySMBIOSString(outInfo->motherboardManufacturer, bb->String(offsetof(SMBIOSBaseboard, Manufacturer)));
+        CopySMBIOSString(outInfo->motherboardModel, bb->String(offsetof(SMBIOSBaseboard, Product)));
+    }
 
-        case 3: // Chassis
-        {
-            const auto *ch = reinterpret_cast<const SMBIOSChassis *>(p);
+    // Chassis
+    if (const smbios::Structure *ch = table->Find(3))
+    {
+        // Bit 7 only flags a chassis lock; the type is in bits 0-6
+        uint8_t chassisType = SMBIOS_FIELD(*ch, SMBIOSChassis, ChassisType) & 0x7Fu;
+        const char *typeStr = chassisType < 0x25u ? CHASSIS_TYPE_MAPPING[chassisType] : nullptr;
+        CopySMBIOSString(outInfo->chassisType, typeStr ? typeStr : "Unknown");
+    }
 
-            if (ch->ChassisType >= 0x25u)
-            {
-                strncpy_s(outInfo->chassisType,
-                          "Unknown", _TRUNCATE);
-                break;
-            }
-            const char *typeStr = CHASSIS_TYPE_MAPPING[ch->ChassisType];
+    // Processor
+    if (const smbios::Structure *cpu = table->Find(4))
+    {
+        // Socket Type string only exists on SMBIOS 3.6+ structures; shorter ones read as empty
+        std::string_view socket = cpu->String(offsetof(SMBIOSProcessor, SocketType));
 
-            if (typeStr != nullptr && strlen(typeStr) > 0)
-                strncpy_s(outInfo->chassisType,
-                          typeStr, _TRUNCATE);
-            break;
-        }
+        // If not, try SocketDesignation string
+        if (socket.empty())
+            socket = cpu->String(offsetof(SMBIOSProcessor, SocketDesignation));
 
-        case 4: // Processor
+        // If SocketDesignation is empty, try ProcessorUpgrade field
+        // This enumeration is not the most reliable, but it can be useful as a last resort
+        if (socket.empty())
         {
-            const auto *cpu = reinterpret_cast<const SMBIOSProcessor *>(p);
-
-            // Are we dealing with SMBIOS 3.6+ structure?
-            if (hdr->Length >= 0x33)
-            {
-                const char *socketType = GetSMBIOSString(strings, cpu->SocketType);
-                if (socketType && strlen(socketType) > 0)
-                {
-                    strncpy_s(outInfo->cpuSocket, socketType, _TRUNCATE);
-                    break;
-                }
-            }
-
-            // If not, try SocketDesignation string
-            const char *socketDesignation = GetSMBIOSString(strings, cpu->SocketDesignation);
-            if (socketDesignation && strlen(socketDesignation) > 0)
-            {
-                strncpy_s(outInfo->cpuSocket, socketDesignation, _TRUNCATE);
-            }
-            // If SocketDesignation is empty, try ProcessorUpgrade field
-            // This enumeration is not the most reliable, but it can be useful as a last resort
-            else if (cpu->ProcessorUpgrade < 0xFFu)
-            {
-                const char *socketStr = PROCESSOR_UPGRADE_MAPPING[cpu->ProcessorUpgrade];
-                strncpy_s(outInfo->cpuSocket, socketStr, _TRUNCATE);
-            }
-
-            // If all enumeration methods fail, set to Unknown
-            else
-            {
-                strncpy_s(outInfo->cpuSocket, "Unknown", _TRUNCATE);
-            }
-            break;
-        }
-
-        default:
-            break;
+            uint8_t upgrade = SMBIOS_FIELD_OR(*cpu, SMBIOSProcessor, ProcessorUpgrade, 0x02u);
+            const char *socketStr = PROCESSOR_UPGRADE_MAPPING[upgrade];
+            socket = socketStr ? socketStr : "Unknown";
         }
 
-        // Advance to next SMBIOS structure
-        const uint8_t *next = strings;
-        while (!(next[0] == 0 && next[1] == 0))
-            ++next;
-        p = next + 2;
+        CopySMBIOSString(outInfo->cpuSocket, socket);
     }
 
     return STATUS_OK;
@@ -1,6 +1,7 @@
 #ifndef HW_HELPER_HPP
 #define HW_HELPER_HPP
 
+#include <cstddef>
 #include <cstdint>
 
 // Chasis type mapping based on SMBIOS Chassis Type field
@@ -170,33 +171,40 @@ struct SMBIOSProcessor
     uint8_t ProcessorType;             // 0x05
     uint8_t ProcessorFamily;           // 0x06
     uint8_t Manufacturer;              // 0x07
-    uint32_t ProcessorID;              // 0x08-0x0B
-    uint8_t Version;                   // 0x0C-0x0D
-    uint8_t Voltage;                   // 0x0E
-    uint16_t ExternalClock;            // 0x0F-0x10
-    uint16_t MaxSpeed;                 // 0x11-0x12
-    uint16_t CurrentSpeed;             // 0x13-0x14
-    uint8_t Status;                    // 0x15
-    uint8_t ProcessorUpgrade;          // 0x16
-    uint16_t L1CacheHandle;            // 0x17-0x18
-    uint16_t L2CacheHandle;            // 0x19-0x1A
-    uint16_t L3CacheHandle;            // 0x1B-0x1C
-    uint8_t SerialNumber;              // 0x1D
-    uint8_t AssetTag;                  // 0x1E
-    uint8_t PartNumber;                // 0x1F
-    uint8_t CoreCount;                 // 0x20
-    uint8_t CoreEnabled;               // 0x21
-    uint8_t ThreadCount;               // 0x22
-    uint16_t ProcessorCharacteristics; // 0x23-0x24
-    uint16_t ProcessorFamily2;         // 0x25-0x26
-    uint16_t CoreCount2;               // 0x27-0x28
-    uint16_t CoreEnabled2;             // 0x29-0x2A
-    uint16_t ThreadCount2;             // 0x2B-0x2C
-    uint16_t ThreadEnabled;            // 0x30-0x31
+    uint64_t ProcessorID;              // 0x08-0x0F
+    uint8_t Version;                   // 0x10
+    uint8_t Voltage;                   // 0x11
+    uint16_t ExternalClock;            // 0x12-0x13
+    uint16_t MaxSpeed;                 // 0x14-0x15
+    uint16_t CurrentSpeed;             // 0x16-0x17
+    uint8_t Status;                    // 0x18
+    uint8_t ProcessorUpgrade;          // 0x19
+    uint16_t L1CacheHandle;            // 0x1A-0x1B
+    uint16_t L2CacheHandle;            // 0x1C-0x1D
+    uint16_t L3CacheHandle;            // 0x1E-0x1F
+    uint8_t SerialNumber;              // 0x20
+    uint8_t AssetTag;                  // 0x21
+    uint8_t PartNumber;                // 0x22
+    uint8_t CoreCount;                 // 0x23
+    uint8_t CoreEnabled;               // 0x24
+    uint8_t ThreadCount;               // 0x25
+    uint16_t ProcessorCharacteristics; // 0x26-0x27
+    uint16_t ProcessorFamily2;         // 0x28-0x29
+    uint16_t CoreCount2;               // 0x2A-0x2B (SMBIOS 3.0+)
+    uint16_t CoreEnabled2;             // 0x2C-0x2D (SMBIOS 3.0+)
+    uint16_t ThreadCount2;             // 0x2E-0x2F (SMBIOS 3.0+)
+    uint16_t ThreadEnabled;            // 0x30-0x31 (SMBIOS 3.6+)
     uint8_t SocketType;                // 0x32 - Additional socket type string (SMBIOS 3.6+)
 };
 #pragma pack(pop)
 
+static_assert(offsetof(SMBIOSProcessor, ProcessorUpgrade) == 0x19, "SMBIOSProcessor layout");
+static_assert(offsetof(SMBIOSProcessor, ThreadCount2) == 0x2E, "SMBIOSProcessor layout");
+static_assert(offsetof(SMBIOSProcessor, SocketType) == 0x32, "SMBIOSProcessor layout");
+
+// Fields past a structure's Length are not present in its table (older SMBIOS version); read
+// these structs through SMBIOS_FIELD (interops/common/include/smbios.h), never by casting.
+
 struct SMBIOSHwInfo
 {
     char motherboardManufacturer[256];
@@ -205,6 +213,32 @@ struct SMBIOSHwInfo
     char cpuSocket[256];
 };
 
+// One DXGI output and the adapter driving it, as returned by GetDisplayAdapterMap
+struct DisplayAdapterEntry
+{
+    char deviceName[32];     // GDI device name of the output, e.g. "\\.\DISPLAY1"
+    char adapterName[128];   // DXGI adapter description
+    uint32_t adapterLuidLow; // adapter LUID, same value as DISPLAYCONFIG_PATH_SOURCE_INFO::adapterId
+    int32_t adapterLuidHigh;
+    uint32_t vendorId;
+    uint32_t deviceId;
+};
+
+// One active display path (source -> target), as returned by GetDisplayTopology
+struct DisplayPathRecord
+{
+    char gdiDeviceName[32];     // e.g. "\\.\DISPLAY1", UTF-8
+    char monitorDevicePath[256]; // e.g. "\\?\DISPLAY#DEL4123#...", UTF-8
+    uint32_t outputTechnology;  // DISPLAYCONFIG_VIDEO_OUTPUT_TECHNOLOGY
+    uint32_t refreshNumerator;  // target refresh rate = numerator / denominator Hz
+    uint32_t refreshDenominator;
+    uint32_t width;             // source mode (desktop) resolution, 0 if not reported
+    uint32_t height;
+    uint32_t adapterLuidLow;    // same LUID as DisplayAdapterEntry
+    int32_t adapterLuidHigh;
+    uint32_t targetId;
+};
+
 typedef enum gpuHelper_Result_ENUM
 {
     STATUS_OK = 0u,
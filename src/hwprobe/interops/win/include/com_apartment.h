@@ -0,0 +1,52 @@
+#pragma once
+
+#include <windows.h>
+#include <objbase.h>
+
+#include <mutex>
+
+// COM set-up shared by the exports that use COM (WMI, Core Audio). Each call joins the calling
+// thread to the MTA for its own duration and leaves the thread as it found it; the one
+// process-wide step, CoInitializeSecurity, runs once.
+
+namespace com {
+
+// Joins the calling thread to the MTA for the lifetime of the object.
+// CoUninitialize is only balanced when CoInitializeEx succeeded; a thread that is
+// already an STA (RPC_E_CHANGED_MODE) is left as it was.
+class ComApartment {
+public:
+    ComApartment() {
+        HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+        initialized_ = SUCCEEDED(hr);
+        usable_ = initialized_ || hr == RPC_E_CHANGED_MODE;
+    }
+
+    ~ComApartment() {
+        if (initialized_) CoUninitialize();
+    }
+
+    ComApartment(const ComApartment &) = delete;
+    ComApartment &operator=(const ComApartment &) = delete;
+
+    bool usable() const { return usable_; }
+
+    // S_OK / S_FALSE from CoInitializeEx(COINIT_MULTITHREADED) both mean we are in the MTA.
+    bool in_mta() const { return initialized_; }
+
+private:
+    bool initialized_ = false;
+    bool usable_ = false;
+};
+
+// CoInitializeSecurity is process-wide and may only succeed once; RPC_E_TOO_LATE just
+// means the host process (or an earlier call) already configured it.
+inline void EnsureProcessSecurity() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        CoInitializeSecurity(nullptr, -1, nullptr, nullptr, RPC_C_AUTHN_LEVEL_DEFAULT,
+                             RPC_C_IMP_LEVEL_IMPERSONATE, nullptr, EOAC_NONE, nullptr);
+    });
+}
+
+} // namespace com
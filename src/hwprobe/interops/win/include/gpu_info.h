@@ -2,6 +2,8 @@
 
 #include <cstdint>
 
+#include "device_arena.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -26,9 +28,48 @@ typedef enum {
     GPU_STATUS_INVALID_ARG = 2
 } GPUStatus;
 
+// Compact record used by get_gpu_info_arena(); strings live in the arena's string pool.
+typedef struct {
+    ArenaString name;
+    ArenaString manufacturer;
+    ArenaString acpi_path;
+    ArenaString pci_path;
+    uint32_t vendor_id;
+    uint32_t device_id;
+    uint32_t subsystem_vendor_id;
+    uint32_t subsystem_device_id;
+    uint64_t vram_mb;
+    int32_t pcie_gen;
+    int32_t pcie_width;
+    ArenaString instance_id;  // PnP instance ID of the display devnode, e.g. "PCI\\VEN_10DE&DEV_2684&..."
+} WinGPURecord;
+
 // Fills `out` with GPU entries. Returns number of GPUs found, or -1 on error.
+// GPUs beyond `max_count` are dropped and long strings truncated; prefer get_gpu_info_arena().
 int get_gpu_info(WinGPUProperties *out, int max_count);
 
+// Enumerates every GPU into a DeviceArena of WinGPURecord (kind DEVICE_ARENA_KIND_WIN_GPU).
+// On success `*out` must be released with device_arena_free().
+int get_gpu_info_arena(DeviceArena **out);
+
 #ifdef __cplusplus
 }
+
+#include <string>
+#include <vector>
+#include <windows.h>
+
+namespace gpu_info {
+
+// A GPU as get_gpu_info_arena() lists it: the DXGI adapter and the display devnode behind it.
+struct AdapterRef {
+    LUID luid;
+    std::wstring instance_id;  // empty if no devnode matched the adapter
+};
+
+// Same enumeration (and order) as get_gpu_info_arena(). False if DXGI is unavailable.
+bool CollectAdapters(std::vector<AdapterRef> &out);
+
+} // namespace gpu_info
+
 #endif
@@ -0,0 +1,160 @@
+#pragma once
+
+// Allocation-free tokenizer for PNP device instance IDs and hardware IDs, e.g.
+//
+//   PCI\VEN_10DE&DEV_2684&SUBSYS_88881043&REV_A1\4&1A2B3C4D&0&0008
+//   HDAUDIO\FUNC_01&VEN_10EC&DEV_0887&SUBSYS_104386C7&REV_1003
+//   USB\VID_046D&PID_0A87&MI_00
+//
+// The ID is split on '\' and '&'; each token is matched case-insensitively against a fixed
+// set of tags and the hex digits that follow are decoded in place. Works on both char and
+// wchar_t strings, has no Windows dependencies, and is usable in constant expressions.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace pnp {
+
+struct HardwareId {
+    uint32_t vendor_id = 0;  // VEN_xxxx (PCI, HDAUDIO) or VID_xxxx (USB)
+    uint32_t device_id = 0;  // DEV_xxxx or PID_xxxx
+    uint32_t subsys = 0;     // SUBSYS_ddddvvvv as one value (same layout as DXGI SubSysId)
+    uint32_t revision = 0;   // REV_xx / REV_xxxx
+    bool has_vendor = false;
+    bool has_device = false;
+    bool has_subsys = false;
+    bool has_revision = false;
+
+    constexpr uint32_t subsystem_device_id() const { return subsys >> 16; }
+    constexpr uint32_t subsystem_vendor_id() const { return subsys & 0xFFFF; }
+};
+
+namespace detail {
+
+template <typename CharT>
+constexpr CharT ToUpper(CharT ch) {
+    return (ch >= CharT('a') && ch <= CharT('z')) ? CharT(ch - CharT('a') + CharT('A')) : ch;
+}
+
+template <typename CharT>
+constexpr int HexValue(CharT ch) {
+    if (ch >= CharT('0') && ch <= CharT('9')) return int(ch - CharT('0'));
+    ch = ToUpper(ch);
+    if (ch >= CharT('A') && ch <= CharT('F')) return int(ch - CharT('A')) + 10;
+    return -1;
+}
+
+template <typename CharT>
+constexpr bool IsSeparator(CharT ch) {
+    return ch == CharT('\\') || ch == CharT('&');
+}
+
+// True if [begin, end) starts with the ASCII `tag` (case-insensitive).
+template <typename CharT, size_t N>
+constexpr bool HasPrefix(const CharT *begin, const CharT *end, const char (&tag)[N]) {
+    if (static_cast<size_t>(end - begin) < N - 1) return false;
+    for (size_t i = 0; i + 1 < N; ++i)
+        if (ToUpper(begin[i]) != CharT(tag[i])) return false;
+    return true;
+}
+
+// Decodes up to `max_digits` hex digits; at least `min_digits` must be present.
+template <typename CharT>
+constexpr bool ReadHex(const CharT *begin, const CharT *end, size_t min_digits, size_t max_digits,
+                       uint32_t &out) {
+    uint32_t value = 0;
+    size_t digits = 0;
+    for (const CharT *p = begin; p < end && digits < max_digits; ++p, ++digits) {
+        int v = HexValue(*p);
+        if (v < 0) break;
+        value = (value << 4) | static_cast<uint32_t>(v);
+    }
+    if (digits < min_digits) return false;
+    out = value;
+    return true;
+}
+
+template <typename CharT, size_t N>
+constexpr void MatchField(const CharT *begin, const CharT *end, const char (&tag)[N], size_t min_digits,
+                          size_t max_digits, uint32_t &value, bool &found) {
+    if (found || !HasPrefix(begin, end, tag)) return;
+    found = ReadHex(begin + (N - 1), end, min_digits, max_digits, value);
+}
+
+} // namespace detail
+
+// Parses `len` characters of `id`. Fields that are absent are left zero with has_* == false;
+// the first occurrence of each tag wins.
+template <typename CharT>
+constexpr HardwareId ParseHardwareId(const CharT *id, size_t len) {
+    HardwareId out;
+    if (!id) return out;
+
+    const CharT *end = id + len;
+    const CharT *token = id;
+    while (token < end) {
+        const CharT *token_end = token;
+        while (token_end < end && !detail::IsSeparator(*token_end)) ++token_end;
+
+        switch (detail::ToUpper(*token)) {
+            case CharT('V'):
+                detail::MatchField(token, token_end, "VEN_", 4, 4, out.vendor_id, out.has_vendor);
+                detail::MatchField(token, token_end, "VID_", 4, 4, out.vendor_id, out.has_vendor);
+                break;
+            case CharT('D'):
+                detail::MatchField(token, token_end, "DEV_", 4, 4, out.device_id, out.has_device);
+                break;
+            case CharT('P'):
+                detail::MatchField(token, token_end, "PID_", 4, 4, out.device_id, out.has_device);
+                break;
+            case CharT('S'):
+                detail::MatchField(token, token_end, "SUBSYS_", 8, 8, out.subsys, out.has_subsys);
+                break;
+            case CharT('R'):
+                detail::MatchField(token, token_end, "REV_", 2, 4, out.revision, out.has_revision);
+                break;
+            default:
+                break;
+        }
+
+        token = token_end + 1;
+    }
+    return out;
+}
+
+// Parses a NUL-terminated ID. For REG_MULTI_SZ values such as SPDRP_HARDWAREID this reads
+// the first (most specific) entry only.
+template <typename CharT>
+constexpr HardwareId ParseHardwareId(const CharT *id) {
+    size_t len = 0;
+    if (id)
+        while (id[len]) ++len;
+    return ParseHardwareId(id, len);
+}
+
+// True if the ID names the given enumerator (the part before the first '\'), e.g. "PCI".
+template <typename CharT, size_t N>
+constexpr bool HasEnumerator(const CharT *id, const char (&name)[N]) {
+    if (!id) return false;
+    for (size_t i = 0; i + 1 < N; ++i)
+        if (detail::ToUpper(id[i]) != CharT(name[i])) return false;
+    return id[N - 1] == CharT('\\');
+}
+
+// The parser runs at compile time; these pin it against the ID shapes in the file comment.
+static_assert(ParseHardwareId("PCI\\VEN_10DE&DEV_2684&SUBSYS_88881043&REV_A1\\4&1A2B3C4D&0&0008").vendor_id == 0x10DE,
+              "PCI vendor");
+static_assert(ParseHardwareId("PCI\\VEN_10DE&DEV_2684&SUBSYS_88881043&REV_A1\\4&1A2B3C4D&0&0008").device_id == 0x2684,
+              "PCI device");
+static_assert(ParseHardwareId("PCI\\VEN_10DE&DEV_2684&SUBSYS_88881043&REV_A1").subsystem_vendor_id() == 0x1043,
+              "PCI subsystem vendor");
+static_assert(ParseHardwareId("PCI\\VEN_10DE&DEV_2684&SUBSYS_88881043&REV_A1").revision == 0xA1, "PCI revision");
+static_assert(ParseHardwareId("hdaudio\\func_01&ven_10ec&dev_0887&subsys_104386c7&rev_1003").revision == 0x1003,
+              "tags are case-insensitive");
+static_assert(ParseHardwareId(L"USB\\VID_046D&PID_0A87&MI_00").device_id == 0x0A87, "USB product, wide string");
+static_assert(!ParseHardwareId(L"USB\\VID_046D&PID_0A87&MI_00").has_subsys, "absent field");
+static_assert(!ParseHardwareId("PCI\\VEN_10G&DEV_26").has_vendor && !ParseHardwareId("PCI\\VEN_10G&DEV_26").has_device,
+              "malformed IDs leave the fields unset");
+static_assert(HasEnumerator("PCI\\VEN_10DE", "PCI") && !HasEnumerator("PCIE\\VEN_10DE", "PCI"), "enumerator");
+
+} // namespace pnp
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+#include "device_arena.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Same values as MSFT_PhysicalDisk.MediaType, so one mapping serves both sources.
+typedef enum {
+    WIN_STORAGE_MEDIA_UNSPECIFIED = 0,  // the driver does not answer the seek-penalty query
+    WIN_STORAGE_MEDIA_HDD = 3,
+    WIN_STORAGE_MEDIA_SSD = 4
+} WinStorageMediaType;
+
+typedef struct {
+    char product_name[256];
+    char vendor_name[256];
+    char device_path[64];  // e.g. "\\.\PhysicalDrive0"; empty if the disk has no device number
+    uint64_t size_bytes;
+    uint32_t bus_type;     // STORAGE_BUS_TYPE; same values as MSFT_PhysicalDisk.BusType
+    uint32_t media_type;   // WinStorageMediaType
+} WinStorageDeviceProperties;
+
+// Compact record used by get_storage_info_arena(); strings live in the arena's string pool.
+typedef struct {
+    ArenaString product_name;
+    ArenaString vendor_name;
+    ArenaString device_path;
+    ArenaString instance_id;  // PnP instance ID of the disk devnode, e.g. "SCSI\\DISK&VEN_NVME&PROD_..."
+    uint64_t size_bytes;
+    uint32_t bus_type;
+    uint32_t media_type;
+} WinStorageDeviceRecord;
+
+// Fills `out` with one entry per disk, in device-number order. Returns the number of disks
+// found, or -1 on error. Disks beyond `max_count` are dropped; prefer get_storage_info_arena().
+int get_storage_info(WinStorageDeviceProperties *out, int max_count);
+
+// Enumerates every disk into a DeviceArena of WinStorageDeviceRecord
+// (kind DEVICE_ARENA_KIND_WIN_STORAGE). On success `*out` must be released with device_arena_free().
+int get_storage_info_arena(DeviceArena **out);
+
+#ifdef __cplusplus
+}
+#endif
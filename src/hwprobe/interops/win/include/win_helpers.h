@@ -21,8 +21,14 @@ void wide_to_utf8(const wchar_t *src, char *dst, int dst_size);
 #include <cfgmgr32.h>
 #include <devpkey.h>
 
+#include <string_view>
+#include <utility>
+#include <vector>
+
 std::string WideToUtf8(const wchar_t *src);
 
+std::wstring Utf8ToWide(const char *src);
+
 // DEVPROPKEY-based device property helpers
 bool GetDevNodeLocationPaths(const std::wstring &pnp_device_id,
                              std::string &out_acpi_path,
@@ -32,10 +38,64 @@ bool GetDevNodePCIeInfo(const std::wstring &pnp_device_id,
                         int &out_pcie_gen,
                         int &out_pcie_width);
 
+// Same, for a devnode already located with LocateDevNode() (e.g. re-read on every sample)
+bool GetDevNodePCIeInfo(DEVINST dn, int &out_pcie_gen, int &out_pcie_width);
+
+// Bus, device and function of a PCI devnode (the segment is not exposed)
+bool GetDevNodePciAddress(const std::wstring &pnp_device_id,
+                          uint32_t &out_bus,
+                          uint32_t &out_device,
+                          uint32_t &out_function);
+
+// 0 if the device instance is not present
+DEVINST LocateDevNode(const std::wstring &pnp_device_id);
+
 // Path formatting: raw PCIROOT(0)#PCI(1C05)#PCI(0000) -> PciRoot(0x0)/Pci(0x1C,0x5)/Pci(0x0,0x0)
 std::string FormatPciPath(const std::string &raw);
 
 // Path formatting: raw ACPI(_SB_)#ACPI(PCI0)#ACPI(RP05)#ACPI(PXSX) -> \_SB_.PCI0.RP05.PXSX
 std::string FormatAcpiPath(const std::string &raw);
 
+// ---- Record / replay (see device_replay.h) ----
+//
+// The devnode property helpers above are hooked by instance ID; the LocateDevNode() / DEVINST
+// overload of GetDevNodePCIeInfo() is not (the telemetry sampler re-reads it live).
+
+// A key under HKEY_LOCAL_MACHINE opened for reading, whose reads are recorded and replayed by
+// path. While replaying nothing is opened and every read is answered from the corpus.
+class RegistryKey {
+public:
+    explicit RegistryKey(const wchar_t *path);
+    RegistryKey(const RegistryKey &parent, const std::wstring &name);
+    ~RegistryKey();
+
+    RegistryKey(const RegistryKey &) = delete;
+    RegistryKey &operator=(const RegistryKey &) = delete;
+
+    bool ok() const { return key_ != nullptr || replaying_; }
+
+    // Names of the direct subkeys; false if the key could not be opened.
+    bool Subkeys(std::vector<std::wstring> &out) const;
+
+    // Type and data of value `name`; false if it does not exist.
+    bool Value(const wchar_t *name, DWORD &type, std::vector<BYTE> &data) const;
+
+    // REG_SZ / REG_EXPAND_SZ value, up to its first NUL; empty if absent or of another type.
+    std::wstring String(const wchar_t *name) const;
+
+    // Value of at most 8 bytes (REG_DWORD, REG_QWORD or a short REG_BINARY), zero-extended.
+    bool Scalar(const wchar_t *name, uint64_t &out) const;
+
+private:
+    std::wstring path_;
+    HKEY key_ = nullptr;
+    bool replaying_ = false;
+};
+
+// A SetupAPI listing as stored in a DEVICE_REPLAY_WIN_DEVICE_LIST entry: two strings per device.
+using DeviceList = std::vector<std::pair<std::wstring, std::wstring>>;
+
+std::string PackDeviceList(const DeviceList &devices);
+void UnpackDeviceList(std::string_view packed, DeviceList &out);
+
 #endif
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <cstdint>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    WMI_STATUS_OK = 0,
+    WMI_STATUS_FAILURE = 1,
+    WMI_STATUS_INVALID_ARG = 2,
+    WMI_STATUS_BUFFER_TOO_SMALL = 3,
+    WMI_STATUS_TIMED_OUT = 4,    // deadline passed; the results read until then are returned
+    WMI_STATUS_NO_MORE = 5       // wmi_fleet_next(): every result has been handed out
+} WmiStatus;
+
+// Counters published by the WMI session pool. Latencies are in microseconds.
+typedef struct {
+    uint64_t queries;           // queries served while the pool was enabled
+    uint64_t reuse_hits;        // queries that reused an already-open IWbemServices
+    uint64_t connects;          // successful ConnectServer handshakes
+    uint64_t connect_failures;  // failed ConnectServer handshakes
+    uint64_t reconnects;        // sessions dropped and re-opened after an RPC failure
+    uint64_t total_connect_us;  // sum of all ConnectServer + CoSetProxyBlanket latencies
+    uint64_t max_connect_us;    // slowest single handshake
+    uint32_t open_sessions;     // namespaces currently held open
+    int enabled;                // 1 while the pool is enabled
+} WmiPoolStats;
+
+// Opt-in: keep one IWbemServices per namespace (e.g. ROOT\CIMV2, ROOT\Microsoft\Windows\Storage)
+// open across queries. Holds a reference on the process MTA until wmi_session_pool_shutdown().
+// Safe to call more than once. Returns WMI_STATUS_OK, or WMI_STATUS_FAILURE if COM cannot be set up.
+int wmi_session_pool_enable(void);
+
+// Releases every pooled session and the MTA reference. Queries issued afterwards open
+// a private session per call again.
+void wmi_session_pool_shutdown(void);
+
+// Copies the pool counters into `out`. Counters survive shutdown and are reset by enable().
+int wmi_session_pool_get_stats(WmiPoolStats *out);
+
+// Runs a WQL query against `cim_namespace` (defaults to ROOT\CIMV2 if null/empty) and writes
+// one "Name=Value|Name=Value|...\n" line per object into `out` (truncated to `max_len`).
+// Uses the session pool when it is enabled, otherwise opens a private session for the call.
+int get_wmi_info(const char *query, const char *cim_namespace, char *out, int max_len);
+
+// Same with a deadline `timeout_ms` from the call (0: none). Objects are fetched in batches; once
+// the deadline passes the query is abandoned, and the lines read so far are written to `out`
+// with WMI_STATUS_TIMED_OUT. The deadline covers the query, not the connect: ConnectServer is
+// bounded by WMI itself (WBEM_FLAG_CONNECT_USE_MAX_WAIT, about two minutes).
+int get_wmi_info_timeout(const char *query, const char *cim_namespace, char *out, int max_len,
+                         uint32_t timeout_ms);
+
+// Projected form of get_wmi_info(): only `columns` are read, through property handles resolved
+// once per query (see wmi_query_table()), and written in that order as "Name=Value|...\n".
+// Missing/NULL properties are left out; booleans read True/False, integers and reals decimal.
+// `timeout_ms` as in get_wmi_info_timeout().
+int get_wmi_info_columns(const char *query, const char *cim_namespace, const char *const *columns,
+                         int column_count, char *out, int max_len, uint32_t timeout_ms);
+
+// ---- Columnar query results ----
+//
+// wmi_query_table() materialises the requested columns of every returned object into one
+// self-describing blob, laid out as:
+//
+//   WmiTableHeader
+//   WmiCell[row_count * column_count]   row-major, columns in the order they were requested
+//   string table                        UTF-8, every string NUL-terminated
+//
+// Integers, reals and booleans are stored inline in the cell. Strings (and any value that has
+// no native representation, e.g. arrays) are stored in the string table and referenced by
+// byte offset from `strings_offset`. CIM uint64/sint64 properties, which WMI hands out as
+// BSTRs, are parsed back into integers.
+
+#define WMI_TABLE_MAGIC 0x4C42544Du  // "MTBL"
+#define WMI_TABLE_VERSION 1
+
+typedef enum {
+    WMI_CELL_NULL = 0,    // property missing or NULL on this object
+    WMI_CELL_INT = 1,     // value.i64
+    WMI_CELL_UINT = 2,    // value.u64
+    WMI_CELL_REAL = 3,    // value.f64
+    WMI_CELL_BOOL = 4,    // value.u64 (0 or 1)
+    WMI_CELL_STRING = 5   // value.offset into the string table, `length` bytes (excluding NUL)
+} WmiCellType;
+
+typedef struct {
+    uint32_t type;
+    uint32_t length;
+    union {
+        int64_t i64;
+        uint64_t u64;
+        double f64;
+        uint64_t offset;
+    } value;
+} WmiCell;
+
+typedef struct {
+    uint32_t magic;           // WMI_TABLE_MAGIC
+    uint32_t version;         // WMI_TABLE_VERSION
+    uint32_t header_size;     // sizeof(WmiTableHeader)
+    uint32_t cell_size;       // sizeof(WmiCell)
+    uint32_t column_count;
+    uint32_t row_count;
+    uint64_t cells_offset;    // from the start of the blob
+    uint64_t strings_offset;  // from the start of the blob
+    uint64_t strings_size;
+    uint64_t total_size;      // size of the whole blob, equal to wmi_table_size()
+} WmiTableHeader;
+
+typedef struct WmiTable WmiTable;
+
+// Runs a WQL query and reads `columns` (property names) from each returned object.
+// On success `*out` receives a table handle that must be released with wmi_table_free().
+// Uses the session pool the same way get_wmi_info() does. Only the listed properties are read:
+// their IWbemObjectAccess handles are resolved from the first object and every row is then read
+// with typed reads, no name lookups (columns that have no handle, e.g. arrays, are read by name).
+int wmi_query_table(const char *query, const char *cim_namespace,
+                    const char *const *columns, int column_count, WmiTable **out);
+
+// Same with a deadline, like get_wmi_info_timeout(). On WMI_STATUS_TIMED_OUT `*out` still
+// receives a table, holding the rows read before the deadline.
+int wmi_query_table_timeout(const char *query, const char *cim_namespace, const char *const *columns,
+                            int column_count, uint32_t timeout_ms, WmiTable **out);
+
+// Exact number of bytes wmi_table_copy() needs.
+uint64_t wmi_table_size(const WmiTable *table);
+
+// Copies the blob into `out`. Returns WMI_STATUS_BUFFER_TOO_SMALL (and copies nothing)
+// if `out_size` is less than wmi_table_size().
+int wmi_table_copy(const WmiTable *table, void *out, uint64_t out_size);
+
+void wmi_table_free(WmiTable *table);
+
+// ---- Asynchronous queries ----
+//
+// wmi_query_table_async() runs wmi_query_table_timeout() on a worker thread of its own (joined to
+// the MTA, so it uses the session pool when enabled) and returns at once, so queries against
+// several namespaces run side by side. Each query is a semisynchronous one with batched Next
+// calls rather than ExecQueryAsync: no callback sink has to be reachable from winmgmt, so it
+// needs no unsecapp / DCOM callback security.
+
+#define WMI_WAIT_INFINITE 0xFFFFFFFFu
+
+typedef struct WmiQuery WmiQuery;
+
+// Called once on the worker thread when the query has finished; wmi_query_take_table() and
+// wmi_query_free() may be called from it.
+typedef void (*WmiQueryCallback)(WmiQuery *query, void *context);
+
+// Copies the arguments and starts the query. `callback` is optional. `*out` must be released
+// with wmi_query_free().
+int wmi_query_table_async(const char *query, const char *cim_namespace, const char *const *columns,
+                          int column_count, uint32_t timeout_ms, WmiQueryCallback callback, void *context,
+                          WmiQuery **out);
+
+// Waits up to `wait_ms` (WMI_WAIT_INFINITE: no limit) for the query to finish. Returns
+// WMI_STATUS_OK once it has, WMI_STATUS_TIMED_OUT if it is still running.
+int wmi_query_wait(WmiQuery *query, uint32_t wait_ms);
+
+// Result of a finished query: `*status` is what wmi_query_table_timeout() returned and `*out` its
+// table (null on failure), now owned by the caller. A second call hands out a null table.
+// Returns WMI_STATUS_INVALID_ARG while the query is still running.
+int wmi_query_take_table(WmiQuery *query, int *status, WmiTable **out);
+
+// Waits for the query (at most its timeout, plus the connect) and releases it, together with a
+// table that was not taken.
+void wmi_query_free(WmiQuery *query);
+
+// ---- Fleet collection ----
+//
+// wmi_fleet_start() runs one set of queries against many hosts (remote WMI over DCOM, for
+// machines without an agent), at most `max_concurrency` hosts at a time. A host is served by one
+// worker from start to finish: it connects once per namespace with the host's credentials, runs
+// all of the host's queries on that IWbemServices and releases it. Results are queued as each
+// query finishes and handed out by wmi_fleet_next() in completion order, so a slow host never
+// holds back the others.
+//
+// `host_timeout_ms` (0: none) is one deadline per host, from the moment a worker picks it up,
+// covering all of its queries. With a deadline, a remote host's RPC endpoint (TCP 135) is probed
+// first, so a host that is down costs the deadline, not WMI's two-minute connect limit; a
+// ConnectServer already under way against a host that answers is still only bounded by WMI.
+
+typedef struct {
+    const char *host;       // name or address; NULL / "" for the local machine
+    const char *user;       // "DOMAIN\user" or "user@domain"; NULL / "": the caller's token
+    const char *password;
+    const char *authority;  // ConnectServer strAuthority, e.g. "ntlmdomain:DOMAIN" or "kerberos:DOMAIN\srv01"
+} WmiFleetHost;
+
+typedef struct {
+    const char *query;
+    const char *cim_namespace;  // on every host; defaults to ROOT\CIMV2 if null/empty
+    const char *const *columns;
+    int column_count;
+} WmiFleetQuery;
+
+typedef struct {
+    uint32_t host_index;   // into the `hosts` of wmi_fleet_start()
+    uint32_t query_index;  // into its `queries`
+    int status;            // as wmi_query_table_timeout(): WMI_STATUS_TIMED_OUT once the host's deadline passed
+    int32_t hresult;       // HRESULT of the failed probe, connect or query; S_OK on success
+} WmiFleetResult;
+
+typedef struct WmiFleet WmiFleet;
+
+// Copies the arguments and starts the workers; returns at once. Every (host, query) pair yields
+// exactly one result. `*out` must be released with wmi_fleet_free().
+int wmi_fleet_start(const WmiFleetHost *hosts, int host_count, const WmiFleetQuery *queries, int query_count,
+                    int max_concurrency, uint32_t host_timeout_ms, WmiFleet **out);
+
+// Hands out the next finished result, waiting up to `wait_ms` (WMI_WAIT_INFINITE: no limit) for
+// one. `*table` receives its rows (null if none were read; release with wmi_table_free()).
+// Returns WMI_STATUS_TIMED_OUT if nothing finished in time, WMI_STATUS_NO_MORE once all
+// host_count * query_count results have been handed out.
+int wmi_fleet_next(WmiFleet *fleet, uint32_t wait_ms, WmiFleetResult *result, WmiTable **table);
+
+// Stops the collection early: hosts not started yet report E_ABORT, running queries stop at their
+// next batch with the rows read so far (WMI_STATUS_TIMED_OUT). Results keep coming until NO_MORE.
+void wmi_fleet_cancel(WmiFleet *fleet);
+
+// Cancels, waits for the workers and releases every result not handed out.
+void wmi_fleet_free(WmiFleet *fleet);
+
+#ifdef __cplusplus
+}
+#endif
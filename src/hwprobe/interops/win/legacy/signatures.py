@@ -1,5 +1,6 @@
 from importlib import resources
 
+from hwprobe.interops.common.device_trace import DeviceTrace
 from hwprobe.interops.win.legacy.structs import *
 
 user32 = ctypes.WinDLL("user32", use_last_error=True)
@@ -20,6 +21,31 @@ hw_helper.GetDisplayPathInfo.argtypes = [ctypes.c_char_p, ctypes.c_int]
 hw_helper.GetDisplayPathInfo.restype = ctypes.c_uint32
 GetDisplayPathInfo = hw_helper.GetDisplayPathInfo
 
+# Older hw_helper.dll builds lack the exports below; callers fall back to GetGPUForDisplay /
+# GetDisplayPathInfo when they are None.
+try:
+    hw_helper.GetDisplayAdapterMap.argtypes = [
+        ctypes.POINTER(DisplayAdapterEntry),
+        ctypes.c_int,
+        ctypes.POINTER(ctypes.c_int),
+    ]
+    hw_helper.GetDisplayAdapterMap.restype = ctypes.c_uint32
+    GetDisplayAdapterMap = hw_helper.GetDisplayAdapterMap
+except AttributeError:
+    GetDisplayAdapterMap = None
+
+try:
+    hw_helper.GetDisplayTopology.argtypes = [
+        ctypes.POINTER(DisplayPathRecord),
+        ctypes.c_int,
+        ctypes.POINTER(ctypes.c_int),
+        ctypes.POINTER(ctypes.c_uint64),
+    ]
+    hw_helper.GetDisplayTopology.restype = ctypes.c_uint32
+    GetDisplayTopology = hw_helper.GetDisplayTopology
+except AttributeError:
+    GetDisplayTopology = None
+
 hw_helper.GetWmiInfo.argtypes = [
     ctypes.c_char_p,
     ctypes.c_char_p,
@@ -41,6 +67,9 @@ hw_helper.FetchSMBIOSData.argtypes = [ctypes.POINTER(SMBIOSHwInfo)]
 hw_helper.FetchSMBIOSData.restype = ctypes.c_uint32
 FetchSMBIOSData = hw_helper.FetchSMBIOSData
 
+# Trace ring of hw_helper.dll (device_info_get_trace); inert for builds without -DDEVICE_INFO_TRACE
+hw_helper_trace = DeviceTrace(hw_helper)
+
 # --------------------
 # User32.dll
 # --------------------
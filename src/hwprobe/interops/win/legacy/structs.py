@@ -12,6 +12,32 @@ class SMBIOSHwInfo(ctypes.Structure):
     ]
 
 
+class DisplayAdapterEntry(ctypes.Structure):
+    _fields_ = [
+        ("deviceName", ctypes.c_char * 32),
+        ("adapterName", ctypes.c_char * 128),
+        ("adapterLuidLow", ctypes.c_uint32),
+        ("adapterLuidHigh", ctypes.c_int32),
+        ("vendorId", ctypes.c_uint32),
+        ("deviceId", ctypes.c_uint32),
+    ]
+
+
+class DisplayPathRecord(ctypes.Structure):
+    _fields_ = [
+        ("gdiDeviceName", ctypes.c_char * 32),
+        ("monitorDevicePath", ctypes.c_char * 256),
+        ("outputTechnology", ctypes.c_uint32),
+        ("refreshNumerator", ctypes.c_uint32),
+        ("refreshDenominator", ctypes.c_uint32),
+        ("width", ctypes.c_uint32),
+        ("height", ctypes.c_uint32),
+        ("adapterLuidLow", ctypes.c_uint32),
+        ("adapterLuidHigh", ctypes.c_int32),
+        ("targetId", ctypes.c_uint32),
+    ]
+
+
 # GUID Structure Helper
 class GUID(ctypes.Structure):
     _fields_ = [
@@ -0,0 +1,168 @@
+#include "cpu_topology.h"
+
+#include <windows.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+// ---- Windows backend: GetLogicalProcessorInformationEx(RelationAll) ----
+//
+// Unlike GetLogicalProcessorInformation, which only sees the calling thread's processor group
+// (64 logical processors at most), the Ex form reports every group, with a GROUP_AFFINITY per
+// group a core, package or cache spans.
+
+namespace {
+
+// IsProcessorFeaturePresent ids newer than some SDK headers
+constexpr DWORD kArmNeon = 19;         // PF_ARM_NEON_INSTRUCTIONS_AVAILABLE
+constexpr DWORD kArmCrypto = 30;       // PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE (AES, SHA-1, SHA-2)
+constexpr DWORD kArmCrc32 = 31;        // PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE
+constexpr DWORD kArmAtomics = 34;      // PF_ARM_V81_ATOMIC_INSTRUCTIONS_AVAILABLE
+constexpr DWORD kArmDotProduct = 43;   // PF_ARM_V82_DP_INSTRUCTIONS_AVAILABLE
+constexpr DWORD kArmSve = 46;          // PF_ARM_SVE_INSTRUCTIONS_AVAILABLE
+constexpr DWORD kArmSve2 = 47;         // PF_ARM_SVE2_INSTRUCTIONS_AVAILABLE
+constexpr DWORD kArmSme = 70;          // PF_ARM_SME_INSTRUCTIONS_AVAILABLE
+constexpr DWORD kArmSme2 = 71;         // PF_ARM_SME2_INSTRUCTIONS_AVAILABLE
+
+bool QueryRelations(std::vector<unsigned char> &buffer) {
+    DWORD size = 0;
+    if (GetLogicalProcessorInformationEx(RelationAll, nullptr, &size) || GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+        return false;
+    buffer.resize(size);
+    return GetLogicalProcessorInformationEx(
+        RelationAll, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &size) != FALSE;
+}
+
+// Calls `fn(info)` for every variable-sized record in the buffer.
+template <typename Fn>
+void ForEachRelation(const std::vector<unsigned char> &buffer, Fn &&fn) {
+    for (size_t offset = 0; offset < buffer.size();) {
+        const auto *info = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX *>(buffer.data() + offset);
+        if (info->Size == 0) break;
+        fn(*info);
+        offset += info->Size;
+    }
+}
+
+// Processors get one numbering across groups: group g's processor n is offsets[g] + n.
+class Numbering {
+public:
+    explicit Numbering(const GROUP_RELATIONSHIP &groups) {
+        uint32_t next = 0;
+        for (WORD g = 0; g < groups.ActiveGroupCount; ++g) {
+            offsets_.push_back(next);
+            next += groups.GroupInfo[g].MaximumProcessorCount;
+        }
+    }
+
+    template <typename Fn>
+    void ForEach(const GROUP_AFFINITY *masks, WORD count, Fn &&fn) const {
+        for (WORD i = 0; i < count; ++i) {
+            if (masks[i].Group >= offsets_.size()) continue;
+            for (uint32_t bit = 0; bit < sizeof(KAFFINITY) * 8; ++bit)
+                if (masks[i].Mask & (static_cast<KAFFINITY>(1) << bit)) fn(offsets_[masks[i].Group] + bit);
+        }
+    }
+
+private:
+    std::vector<uint32_t> offsets_;
+};
+
+void ReadArmFeatures(uint64_t &features) {
+#if defined(_M_ARM64) || defined(__aarch64__)
+    const struct {
+        DWORD id;
+        uint64_t feature;
+    } map[] = {
+        {kArmNeon, CPU_FEATURE_NEON},
+        {kArmCrypto, CPU_FEATURE_ARM_AES | CPU_FEATURE_ARM_SHA2},
+        {kArmCrc32, CPU_FEATURE_CRC32},
+        {kArmAtomics, CPU_FEATURE_LSE},
+        {kArmDotProduct, CPU_FEATURE_DOTPROD},
+        {kArmSve, CPU_FEATURE_SVE},
+        {kArmSve2, CPU_FEATURE_SVE2},
+        {kArmSme, CPU_FEATURE_SME},
+        {kArmSme2, CPU_FEATURE_SME2},
+    };
+    for (const auto &entry : map)
+        if (IsProcessorFeaturePresent(entry.id)) features |= entry.feature;
+#else
+    (void)features;
+#endif
+}
+
+} // namespace
+
+namespace cpu_topology {
+
+bool PlatformTopology(Topology &out) {
+    std::vector<unsigned char> buffer;
+    if (!QueryRelations(buffer)) return false;
+
+    const GROUP_RELATIONSHIP *groups = nullptr;
+    ForEachRelation(buffer, [&](const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX &info) {
+        if (info.Relationship == RelationGroup) groups = &info.Group;
+    });
+    if (!groups) return false;
+    const Numbering numbering(*groups);
+    out.processor_groups = groups->ActiveGroupCount;
+
+    std::map<uint32_t, uint32_t> package_of;
+    std::set<DWORD> numa_nodes;
+    uint32_t packages = 0, cores = 0;
+    ForEachRelation(buffer, [&](const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX &info) {
+        switch (info.Relationship) {
+            case RelationProcessorCore: {
+                // EfficiencyClass is 0 on CPUs that are not hybrid; a higher class is faster
+                const PROCESSOR_RELATIONSHIP &core = info.Processor;
+                numbering.ForEach(core.GroupMask, core.GroupCount, [&](uint32_t id) {
+                    Processor p;
+                    p.id = id;
+                    p.core = cores;
+                    p.efficiency_class = core.EfficiencyClass;
+                    out.processors.push_back(p);
+                });
+                ++cores;
+                break;
+            }
+            case RelationProcessorPackage: {
+                const PROCESSOR_RELATIONSHIP &package = info.Processor;
+                numbering.ForEach(package.GroupMask, package.GroupCount,
+                                  [&](uint32_t id) { package_of[id] = packages; });
+                ++packages;
+                break;
+            }
+            case RelationCache: {
+                // Only the first GROUP_AFFINITY is declared by every SDK; a cache spanning groups
+                // is reported once per group before Windows 11.
+                const CACHE_RELATIONSHIP &cache = info.Cache;
+                Cache instance;
+                instance.level = cache.Level;
+                instance.type = static_cast<uint32_t>(cache.Type);
+                instance.size_bytes = cache.CacheSize;
+                instance.line_size = cache.LineSize;
+                instance.associativity = cache.Associativity;
+                numbering.ForEach(&cache.GroupMask, 1, [&](uint32_t id) { instance.cpus.push_back(id); });
+                out.caches.push_back(std::move(instance));
+                break;
+            }
+            case RelationNumaNode:
+                numa_nodes.insert(info.NumaNode.NodeNumber);
+                break;
+            default:
+                break;
+        }
+    });
+    if (out.processors.empty()) return false;
+
+    for (Processor &p : out.processors) {
+        const auto it = package_of.find(p.id);
+        if (it != package_of.end()) p.package = it->second;
+    }
+    out.numa_nodes = static_cast<uint32_t>(numa_nodes.size());
+    ReadArmFeatures(out.features);
+    return true;
+}
+
+} // namespace cpu_topology
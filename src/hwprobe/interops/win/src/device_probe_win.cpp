@@ -0,0 +1,67 @@
+#include "device_probe.h"
+#include "device_arena.h"
+#include "gpu_info.h"
+#include "storage_info.h"
+#include "wmi_info.h"
+
+#include <windows.h>
+#include <objbase.h>
+
+#include <vector>
+
+#pragma comment(lib, "ole32.lib")
+
+// ---- Windows jobs: DXGI (GPU), storage IOCTLs and WMI tables ----
+
+namespace probe {
+
+namespace {
+
+// Whether this worker's CoInitializeEx succeeded, so it is balanced by exactly one CoUninitialize.
+thread_local bool t_comInitialized = false;
+
+int RunWmiTable(const DeviceProbeJob &job, std::vector<unsigned char> &blob) {
+    if (!job.query || !job.columns || job.column_count <= 0) return DEVICE_PROBE_STATUS_INVALID_ARG;
+
+    WmiTable *table = nullptr;
+    const int query_status =
+        wmi_query_table_timeout(job.query, job.cim_namespace, job.columns, job.column_count, job.timeout_ms, &table);
+    if ((query_status != WMI_STATUS_OK && query_status != WMI_STATUS_TIMED_OUT) || !table)
+        return DEVICE_PROBE_STATUS_FAILURE;
+
+    blob.resize(static_cast<size_t>(wmi_table_size(table)));
+    const int status = wmi_table_copy(table, blob.data(), blob.size());
+    wmi_table_free(table);
+    if (status != WMI_STATUS_OK) return DEVICE_PROBE_STATUS_FAILURE;
+    return query_status == WMI_STATUS_TIMED_OUT ? DEVICE_PROBE_STATUS_TIMED_OUT : DEVICE_PROBE_STATUS_OK;
+}
+
+} // namespace
+
+int PlatformRunJob(const DeviceProbeJob &job, std::vector<unsigned char> &blob) {
+    switch (job.type) {
+        case DEVICE_PROBE_GPU:
+            return arena::Collect(get_gpu_info_arena, blob) ? DEVICE_PROBE_STATUS_OK : DEVICE_PROBE_STATUS_FAILURE;
+        case DEVICE_PROBE_STORAGE:
+            return arena::Collect(get_storage_info_arena, blob) ? DEVICE_PROBE_STATUS_OK
+                                                                 : DEVICE_PROBE_STATUS_FAILURE;
+        case DEVICE_PROBE_WMI_TABLE:
+            return RunWmiTable(job, blob);
+        default:
+            return DEVICE_PROBE_STATUS_UNSUPPORTED;
+    }
+}
+
+void PlatformThreadEnter() {
+    // WMI and DXGI are both free-threaded; the MTA also matches the WMI session pool. S_FALSE
+    // (already in the MTA, e.g. the calling thread) still needs its CoUninitialize.
+    const HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+    t_comInitialized = SUCCEEDED(hr);
+}
+
+void PlatformThreadExit() {
+    if (t_comInitialized) CoUninitialize();
+    t_comInitialized = false;
+}
+
+} // namespace probe
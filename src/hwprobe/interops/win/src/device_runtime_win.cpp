@@ -0,0 +1,49 @@
+#include "device_runtime.h"
+#include "com_apartment.h"
+#include "smbios.h"
+
+#include <windows.h>
+#include <objbase.h>
+
+// ---- Windows backend: COM process security and an MTA usage reference ----
+//
+// Without a reference, the MTA is torn down whenever the last thread in it calls CoUninitialize,
+// so a caller issuing every call from a fresh thread would load and unload COM on each call.
+// CoIncrementMTAUsage keeps it alive without joining any thread to it. Windows 8+, resolved at
+// runtime as in the WMI session pool; on older systems init only does the rest.
+
+namespace {
+
+using MtaUsageIncrementFn = HRESULT(WINAPI *)(void **cookie);
+using MtaUsageDecrementFn = HRESULT(WINAPI *)(void *cookie);
+
+void *g_mtaCookie = nullptr;
+MtaUsageDecrementFn g_decrement = nullptr;
+
+} // namespace
+
+namespace runtime {
+
+bool PlatformInit() {
+    {
+        com::ComApartment apartment;
+        if (!apartment.usable()) return false;
+        com::EnsureProcessSecurity();
+    }
+
+    if (HMODULE ole32 = GetModuleHandleW(L"ole32.dll")) {
+        auto increment = reinterpret_cast<MtaUsageIncrementFn>(GetProcAddress(ole32, "CoIncrementMTAUsage"));
+        g_decrement = reinterpret_cast<MtaUsageDecrementFn>(GetProcAddress(ole32, "CoDecrementMTAUsage"));
+        if (!increment || !g_decrement || FAILED(increment(&g_mtaCookie))) g_mtaCookie = nullptr;
+    }
+
+    smbios::Current();
+    return true;
+}
+
+void PlatformShutdown() {
+    if (g_mtaCookie) g_decrement(g_mtaCookie);
+    g_mtaCookie = nullptr;
+}
+
+} // namespace runtime
@@ -0,0 +1,105 @@
+#include "device_snapshot.h"
+#include "gpu_info.h"
+#include "storage_info.h"
+#include "win_helpers.h"
+
+#include <windows.h>
+#include <cfgmgr32.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#pragma comment(lib, "cfgmgr32.lib")
+#pragma comment(lib, "advapi32.lib")
+
+// ---- Windows snapshot key and file I/O ----
+
+namespace snapshot {
+
+namespace {
+
+// Incremented by the kernel on every boot (Windows 8+).
+bool ReadBootId(DWORD &bootId) {
+    DWORD size = sizeof(bootId);
+    return RegGetValueW(HKEY_LOCAL_MACHINE,
+                        L"SYSTEM\\CurrentControlSet\\Control\\Session Manager\\Memory Management\\PrefetchParameters",
+                        L"BootId", RRF_RT_REG_DWORD, nullptr, &bootId, &size) == ERROR_SUCCESS;
+}
+
+} // namespace
+
+bool PlatformKey(DeviceSnapshotKey &key) {
+    DWORD bootId = 0;
+    if (ReadBootId(bootId)) {
+        std::snprintf(key.boot_id, sizeof(key.boot_id), "bootid-%lu", static_cast<unsigned long>(bootId));
+    } else {
+        // Boot time to the minute: stable within a boot, different across reboots.
+        FILETIME now;
+        GetSystemTimeAsFileTime(&now);
+        const ULONGLONG nowSeconds = ((static_cast<ULONGLONG>(now.dwHighDateTime) << 32) | now.dwLowDateTime) / 10000000ull;
+        const ULONGLONG bootMinute = (nowSeconds - GetTickCount64() / 1000) / 60;
+        std::snprintf(key.boot_id, sizeof(key.boot_id), "boottime-%llu", static_cast<unsigned long long>(bootMinute));
+    }
+
+    // Every present devnode instance ID: adding, removing or re-enumerating a device changes it.
+    ULONG length = 0;
+    if (CM_Get_Device_ID_List_SizeW(&length, nullptr, CM_GETIDLIST_FILTER_PRESENT) != CR_SUCCESS || length == 0)
+        return false;
+    std::vector<wchar_t> ids(length);
+    if (CM_Get_Device_ID_ListW(nullptr, ids.data(), length, CM_GETIDLIST_FILTER_PRESENT) != CR_SUCCESS)
+        return false;
+
+    Fingerprint fingerprint;
+    fingerprint.Add(ids.data(), ids.size() * sizeof(wchar_t));
+    key.hardware_fingerprint = fingerprint.value();
+    return true;
+}
+
+std::vector<ArenaQuery> PlatformQueries() {
+    return {get_gpu_info_arena, get_storage_info_arena};
+}
+
+std::vector<RecordSchema> PlatformSchemas() {
+    return {
+        {DEVICE_ARENA_KIND_WIN_GPU,
+         {SNAPSHOT_FIELD(WinGPURecord, name, String), SNAPSHOT_FIELD(WinGPURecord, manufacturer, String),
+          SNAPSHOT_FIELD(WinGPURecord, acpi_path, String), SNAPSHOT_FIELD(WinGPURecord, pci_path, String),
+          SNAPSHOT_FIELD(WinGPURecord, vendor_id, U32), SNAPSHOT_FIELD(WinGPURecord, device_id, U32),
+          SNAPSHOT_FIELD(WinGPURecord, subsystem_vendor_id, U32), SNAPSHOT_FIELD(WinGPURecord, subsystem_device_id, U32),
+          SNAPSHOT_FIELD(WinGPURecord, vram_mb, U64), SNAPSHOT_FIELD(WinGPURecord, pcie_gen, I32),
+          SNAPSHOT_FIELD(WinGPURecord, pcie_width, I32), SNAPSHOT_FIELD(WinGPURecord, instance_id, String)},
+         // A software adapter (Microsoft Basic Render Driver) has neither
+         {"pci_path", "instance_id"}},
+        {DEVICE_ARENA_KIND_WIN_STORAGE,
+         {SNAPSHOT_FIELD(WinStorageDeviceRecord, product_name, String),
+          SNAPSHOT_FIELD(WinStorageDeviceRecord, vendor_name, String),
+          SNAPSHOT_FIELD(WinStorageDeviceRecord, device_path, String),
+          SNAPSHOT_FIELD(WinStorageDeviceRecord, instance_id, String),
+          SNAPSHOT_FIELD(WinStorageDeviceRecord, size_bytes, U64), SNAPSHOT_FIELD(WinStorageDeviceRecord, bus_type, U32),
+          SNAPSHOT_FIELD(WinStorageDeviceRecord, media_type, U32)},
+         // PhysicalDriveN is reassigned when disks come and go; the devnode is not
+         {"instance_id", "device_path"}},
+    };
+}
+
+bool PlatformWriteAtomically(const std::string &path, const std::vector<unsigned char> &data) {
+    const std::wstring target = Utf8ToWide(path.c_str());
+    const std::wstring temp = target + L".tmp";
+
+    HANDLE file = CreateFileW(temp.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    DWORD written = 0;
+    const bool ok = WriteFile(file, data.data(), static_cast<DWORD>(data.size()), &written, nullptr) &&
+                    written == data.size();
+    CloseHandle(file);
+
+    if (!ok || !MoveFileExW(temp.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        DeleteFileW(temp.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace snapshot
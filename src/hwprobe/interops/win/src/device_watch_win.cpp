@@ -0,0 +1,76 @@
+#include "device_watch.h"
+
+#include <windows.h>
+#include <cfgmgr32.h>
+
+#include <iterator>
+#include <vector>
+
+#pragma comment(lib, "cfgmgr32.lib")
+
+// ---- Windows backend: CM_Register_Notification per device interface class ----
+//
+// Notifications are delivered on a system thread pool thread, so no window or message loop is
+// needed (RegisterDeviceNotification would require one).
+
+namespace {
+
+struct InterfaceClass {
+    GUID guid;
+    DeviceWatchCategory category;
+};
+
+// Spelled out instead of pulling ntddvdeo.h / ntddstor.h / ndisguid.h / ks.h in for one GUID each.
+const InterfaceClass kWatchedClasses[] = {
+    // GUID_DEVINTERFACE_DISPLAY_ADAPTER
+    {{0x5B45201D, 0xF2F2, 0x4F3B, {0x85, 0xBB, 0x30, 0xFF, 0x1F, 0x95, 0x35, 0x99}}, DEVICE_WATCH_GPU},
+    // GUID_DEVINTERFACE_DISK
+    {{0x53F56307, 0xB6BF, 0x11D0, {0x94, 0xF2, 0x00, 0xA0, 0xC9, 0x1E, 0xFB, 0x8B}}, DEVICE_WATCH_STORAGE},
+    // GUID_DEVINTERFACE_NET
+    {{0xCAC88484, 0x7515, 0x4C03, {0x82, 0xE6, 0x71, 0xA8, 0x7A, 0xBA, 0xC3, 0x61}}, DEVICE_WATCH_NETWORK},
+    // KSCATEGORY_AUDIO
+    {{0x6994AD04, 0x93EF, 0x11D0, {0xA3, 0xCC, 0x00, 0xA0, 0xC9, 0x22, 0x31, 0x96}}, DEVICE_WATCH_AUDIO},
+    // GUID_DEVINTERFACE_MONITOR
+    {{0xE6F07B5F, 0xEE97, 0x4A90, {0xB0, 0x76, 0x33, 0xF5, 0x7B, 0xF4, 0xEA, 0xA7}}, DEVICE_WATCH_DISPLAY},
+};
+
+std::vector<HCMNOTIFICATION> g_registrations;
+
+DWORD CALLBACK OnDeviceInterfaceChange(HCMNOTIFICATION, PVOID context, CM_NOTIFY_ACTION action,
+                                       PCM_NOTIFY_EVENT_DATA, DWORD) {
+    if (action == CM_NOTIFY_ACTION_DEVICEINTERFACEARRIVAL || action == CM_NOTIFY_ACTION_DEVICEINTERFACEREMOVAL)
+        device_watch::MarkChanged(static_cast<DeviceWatchCategory>(reinterpret_cast<UINT_PTR>(context)));
+    return ERROR_SUCCESS;
+}
+
+} // namespace
+
+namespace device_watch {
+
+bool PlatformStart() {
+    for (const auto &watched : kWatchedClasses) {
+        CM_NOTIFY_FILTER filter = {};
+        filter.cbSize = sizeof(filter);
+        filter.FilterType = CM_NOTIFY_FILTER_TYPE_DEVICEINTERFACE;
+        filter.u.DeviceInterface.ClassGuid = watched.guid;
+
+        HCMNOTIFICATION handle = nullptr;
+        void *context = reinterpret_cast<void *>(static_cast<UINT_PTR>(watched.category));
+        if (CM_Register_Notification(&filter, context, OnDeviceInterfaceChange, &handle) == CR_SUCCESS)
+            g_registrations.push_back(handle);
+    }
+    // All or nothing: a category without a registration would keep handing out a stale cache.
+    if (g_registrations.size() != std::size(kWatchedClasses)) {
+        PlatformStop();
+        return false;
+    }
+    return true;
+}
+
+void PlatformStop() {
+    // CM_Unregister_Notification waits for callbacks in flight, so none runs after this returns.
+    for (HCMNOTIFICATION handle : g_registrations) CM_Unregister_Notification(handle);
+    g_registrations.clear();
+}
+
+} // namespace device_watch
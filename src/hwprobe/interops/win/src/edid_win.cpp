@@ -0,0 +1,75 @@
+#include "edid.h"
+#include "win_helpers.h"
+#include "bench_stages.h"
+
+#include <windows.h>
+#include <setupapi.h>
+
+#pragma comment(lib, "setupapi.lib")
+#pragma comment(lib, "advapi32.lib")
+
+// ---- Windows backend: every monitor interface in one SetupAPI pass, EDID from its device key ----
+
+namespace {
+
+// GUID_DEVINTERFACE_MONITOR, spelled out like the device_watch classes
+const GUID kMonitorInterface = {0xE6F07B5F, 0xEE97, 0x4A90, {0xB0, 0x76, 0x33, 0xF5, 0x7B, 0xF4, 0xEA, 0xA7}};
+
+// Base block plus one extension, the usual size; larger EDIDs grow the buffer once.
+constexpr DWORD kInitialEdidSize = 2 * EDID_BLOCK_SIZE;
+
+bool ReadEdid(HKEY key, std::vector<uint8_t> &out) {
+    out.resize(kInitialEdidSize);
+    DWORD size = static_cast<DWORD>(out.size());
+    LONG status = RegQueryValueExW(key, L"EDID", nullptr, nullptr, out.data(), &size);
+    if (status == ERROR_MORE_DATA) {
+        out.resize(size);
+        status = RegQueryValueExW(key, L"EDID", nullptr, nullptr, out.data(), &size);
+    }
+    out.resize(status == ERROR_SUCCESS ? size : 0);
+    return status == ERROR_SUCCESS;
+}
+
+} // namespace
+
+namespace edid {
+
+bool PlatformMonitors(std::vector<Monitor> &out) {
+    HDEVINFO devInfo = SetupDiGetClassDevsW(&kMonitorInterface, nullptr, nullptr,
+                                            DIGCF_PRESENT | DIGCF_DEVICEINTERFACE);
+    if (devInfo == INVALID_HANDLE_VALUE) return false;
+
+    // Reused for every interface; only grows
+    std::vector<BYTE> detailBuffer(sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA_W) + MAX_PATH * sizeof(WCHAR));
+
+    SP_DEVICE_INTERFACE_DATA interfaceData = {sizeof(SP_DEVICE_INTERFACE_DATA)};
+    for (DWORD i = 0; SetupDiEnumDeviceInterfaces(devInfo, nullptr, &kMonitorInterface, i, &interfaceData); ++i) {
+        DWORD required = 0;
+        SetupDiGetDeviceInterfaceDetailW(devInfo, &interfaceData, nullptr, 0, &required, nullptr);
+        if (required == 0) continue;
+        if (detailBuffer.size() < required) detailBuffer.resize(required);
+
+        auto *detail = reinterpret_cast<SP_DEVICE_INTERFACE_DETAIL_DATA_W *>(detailBuffer.data());
+        detail->cbSize = sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA_W);
+        SP_DEVINFO_DATA devData = {sizeof(SP_DEVINFO_DATA)};
+        if (!SetupDiGetDeviceInterfaceDetailW(devInfo, &interfaceData, detail, static_cast<DWORD>(detailBuffer.size()),
+                                              nullptr, &devData))
+            continue;
+
+        Monitor monitor;
+        monitor.device_path = WideToUtf8(detail->DevicePath);
+
+        HKEY key = SetupDiOpenDevRegKey(devInfo, &devData, DICS_FLAG_GLOBAL, 0, DIREG_DEV, KEY_READ);
+        if (key != INVALID_HANDLE_VALUE) {
+            DEVICE_INFO_STAGE("RegQueryValueEx(EDID)");
+            ReadEdid(key, monitor.data);
+            RegCloseKey(key);
+        }
+        out.push_back(std::move(monitor));
+    }
+
+    SetupDiDestroyDeviceInfoList(devInfo);
+    return true;
+}
+
+} // namespace edid
@@ -1,252 +1,324 @@
 #include "gpu_info.h"
+#include "nvml_loader.h"
 #include "win_helpers.h"
+#include "pnp_id.h"
+#include "bench_stages.h"
+#include "device_replay.h"
 
 #include <windows.h>
 #include <dxgi.h>
 #include <setupapi.h>
 #include <devguid.h>
 
+#include <cstdint>
 #include <cstring>
+#include <cwchar>
+#include <cwctype>
+#include <algorithm>
+#include <iterator>
 #include <string>
-#include <regex>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
-#include <set>
 
 #pragma comment(lib, "dxgi.lib")
 #pragma comment(lib, "setupapi.lib")
 
-// ---- WMI-free GPU enumeration via DXGI + SetupAPI ----
+// ---- Display device index ----
+//
+// Built once per get_gpu_info() call: a single SetupAPI pass over the display class and a
+// single walk of the display class registry key. Every DXGI adapter is then resolved
+// against the index instead of re-scanning both for each adapter. Both are recorded and
+// replayed (see device_replay.h), so is the list of DXGI adapter descriptors.
 
-static std::wstring PnpDeviceIdFromDXGI(const DXGI_ADAPTER_DESC1 &desc) {
-    // DXGI gives us VendorId / DeviceId / SubSysId / Revision.
-    // We need to find the matching PNP device instance via SetupAPI.
-    wchar_t match_hw_id[128];
-    swprintf_s(match_hw_id, L"PCI\\VEN_%04X&DEV_%04X", desc.VendorId, desc.DeviceId);
+static const wchar_t *kDisplayClassKey =
+    L"SYSTEM\\CurrentControlSet\\Control\\Class\\{4d36e968-e325-11ce-bfc1-08002be10318}";
 
-    HDEVINFO devInfo = SetupDiGetClassDevsW(&GUID_DEVCLASS_DISPLAY, nullptr, nullptr, DIGCF_PRESENT);
-    if (devInfo == INVALID_HANDLE_VALUE) return {};
+// GUID_DEVCLASS_DISPLAY, the key of the display devnode list in a replay corpus
+static const char *kDisplayClassGuid = "{4d36e968-e325-11ce-bfc1-08002be10318}";
 
-    SP_DEVINFO_DATA devData = {sizeof(SP_DEVINFO_DATA)};
-    std::wstring result;
+struct DisplayClassEntry {
+    std::wstring driver_desc;
+    uint64_t memory_size = 0;   // bytes; HardwareInformation.qwMemorySize, else .MemorySize
+};
 
-    for (DWORD i = 0; SetupDiEnumDeviceInfo(devInfo, i, &devData); ++i) {
-        wchar_t pnpBuffer[MAX_DEVICE_ID_LEN];
-        if (!SetupDiGetDeviceInstanceIdW(devInfo, &devData, pnpBuffer, MAX_DEVICE_ID_LEN, nullptr))
-            continue;
+struct DisplayDevNode {
+    std::wstring instance_id;    // as reported by SetupAPI
+    pnp::HardwareId ids;         // VEN/DEV/SUBSYS decoded from instance_id
+    const DisplayClassEntry *driver = nullptr;
+    bool claimed = false;        // resolved to an adapter by Claim()
+};
 
-        std::wstring pnp(pnpBuffer);
-        // Case-insensitive prefix match for VEN_XXXX&DEV_XXXX
-        std::wstring upper_pnp = pnp;
-        for (auto &ch : upper_pnp) ch = towupper(ch);
-        std::wstring upper_match = match_hw_id;
-        for (auto &ch : upper_match) ch = towupper(ch);
-
-        if (upper_pnp.find(upper_match) != std::wstring::npos) {
-            // Further match SubSysId if there are multiple GPUs with the same vendor+device
-            wchar_t subsys_match[64];
-            swprintf_s(subsys_match, L"SUBSYS_%08X", desc.SubSysId);
-            std::wstring upper_subsys = subsys_match;
-            for (auto &ch : upper_subsys) ch = towupper(ch);
-
-            if (upper_pnp.find(upper_subsys) != std::wstring::npos) {
-                result = pnp;
-                break;
-            }
-            // If no subsys match yet, keep this as a fallback
-            if (result.empty()) result = pnp;
-        }
-    }
+static uint64_t LuidKey(const LUID &luid) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(luid.HighPart)) << 32) | luid.LowPart;
+}
 
-    SetupDiDestroyDeviceInfoList(devInfo);
-    return result;
+static uint32_t VendorDeviceKey(uint32_t vendor_id, uint32_t device_id) {
+    return (vendor_id << 16) | (device_id & 0xFFFF);
 }
 
-// ---- Registry VRAM fallback for >4GB cards ----
+class DisplayDeviceIndex {
+public:
+    void Build() {
+        LoadClassKey();
+        LoadDevNodes();
+    }
 
-static uint64_t FetchVramFromRegistry(const std::string &device_name, const std::string &driver_version) {
-    const char *key_path = "SYSTEM\\CurrentControlSet\\Control\\Class\\{4d36e968-e325-11ce-bfc1-08002be10318}";
-    HKEY hKey;
-    if (RegOpenKeyExA(HKEY_LOCAL_MACHINE, key_path, 0, KEY_READ, &hKey) != ERROR_SUCCESS)
-        return 0;
+    // Resolves a DXGI adapter to a devnode no earlier adapter claimed: VEN/DEV lookup, preferring an
+    // exact SUBSYS match. Identical cards share VEN/DEV/SUBSYS, so each takes the next unclaimed
+    // devnode in SetupAPI order. nullptr if there is none left (or none at all).
+    const DisplayDevNode *Claim(const DXGI_ADAPTER_DESC1 &desc) {
+        auto it = by_vendor_device_.find(VendorDeviceKey(desc.VendorId, desc.DeviceId));
+        if (it == by_vendor_device_.end()) return nullptr;
+
+        DisplayDevNode *match = nullptr;
+        for (size_t idx : it->second) {
+            DisplayDevNode &node = nodes_[idx];
+            if (node.claimed) continue;
+            if (node.ids.subsys == desc.SubSysId) {
+                match = &node;
+                break;
+            }
+            if (!match) match = &node;
+        }
+        if (match) match->claimed = true;
+        return match;
+    }
 
-    for (DWORD i = 0; i < 100; ++i) {
-        char sub_key_name[32];
-        DWORD name_size = sizeof(sub_key_name);
-        if (RegEnumKeyExA(hKey, i, sub_key_name, &name_size, nullptr, nullptr, nullptr, nullptr) != ERROR_SUCCESS)
-            continue;
+    // Whether any devnode has the adapter's VEN/DEV, claimed or not.
+    bool HasDevNode(const DXGI_ADAPTER_DESC1 &desc) const {
+        return by_vendor_device_.count(VendorDeviceKey(desc.VendorId, desc.DeviceId)) != 0;
+    }
 
-        HKEY hSubKey;
-        if (RegOpenKeyExA(hKey, sub_key_name, 0, KEY_READ, &hSubKey) != ERROR_SUCCESS)
-            continue;
+    // For adapters without a devnode: match the class subkey by driver description.
+    const DisplayClassEntry *FindDriverByDesc(const wchar_t *driver_desc) const {
+        auto it = by_desc_.find(driver_desc);
+        return it != by_desc_.end() ? it->second : nullptr;
+    }
 
-        char drv_desc[256] = {};
-        DWORD drv_desc_size = sizeof(drv_desc);
-        char drv_ver[256] = {};
-        DWORD drv_ver_size = sizeof(drv_ver);
-
-        bool got_desc = (RegQueryValueExA(hSubKey, "DriverDesc", nullptr, nullptr,
-                         reinterpret_cast<LPBYTE>(drv_desc), &drv_desc_size) == ERROR_SUCCESS);
-        bool got_ver = (RegQueryValueExA(hSubKey, "DriverVersion", nullptr, nullptr,
-                        reinterpret_cast<LPBYTE>(drv_ver), &drv_ver_size) == ERROR_SUCCESS);
-
-        if (got_desc && got_ver &&
-            device_name == drv_desc && driver_version == drv_ver) {
-
-            uint64_t vram_bytes = 0;
-            DWORD vram_size = sizeof(vram_bytes);
-            if (RegQueryValueExA(hSubKey, "HardwareInformation.qwMemorySize", nullptr, nullptr,
-                                 reinterpret_cast<LPBYTE>(&vram_bytes), &vram_size) == ERROR_SUCCESS && vram_bytes > 0) {
-                RegCloseKey(hSubKey);
-                RegCloseKey(hKey);
-                return vram_bytes / (1024 * 1024);
-            }
+private:
+    void LoadClassKey() {
+        DEVICE_INFO_STAGE("DisplayDeviceIndex::LoadClassKey");
+        RegistryKey class_key(kDisplayClassKey);
+        std::vector<std::wstring> sub_key_names;
+        if (!class_key.Subkeys(sub_key_names)) return;
+
+        for (const std::wstring &sub_key_name : sub_key_names) {
+            RegistryKey sub_key(class_key, sub_key_name);
+            if (!sub_key.ok()) continue;
+
+            DisplayClassEntry entry;
+            entry.driver_desc = sub_key.String(L"DriverDesc");
+
+            uint64_t size = 0;
+            if (sub_key.Scalar(L"HardwareInformation.qwMemorySize", size) && size > 0)
+                entry.memory_size = size;
+            else if (sub_key.Scalar(L"HardwareInformation.MemorySize", size) && size > 0)
+                entry.memory_size = size;
+
+            // Keyed by subkey name ("0000", "0001", ...), which is what SPDRP_DRIVER points at.
+            auto &slot = class_entries_[Upper(sub_key_name.c_str())];
+            slot = std::move(entry);
+            if (!slot.driver_desc.empty())
+                by_desc_.emplace(slot.driver_desc, &slot);
+        }
+    }
 
-            DWORD alt_vram = 0;
-            DWORD alt_size = sizeof(alt_vram);
-            if (RegQueryValueExA(hSubKey, "HardwareInformation.MemorySize", nullptr, nullptr,
-                                 reinterpret_cast<LPBYTE>(&alt_vram), &alt_size) == ERROR_SUCCESS && alt_vram > 0) {
-                RegCloseKey(hSubKey);
-                RegCloseKey(hKey);
-                return static_cast<uint64_t>(alt_vram) / (1024 * 1024);
+    // (instance ID, SPDRP_DRIVER) of every present display devnode
+    static void ListDevNodes(DeviceList &out) {
+        std::string replay_key;
+        if (replay::Active()) {
+            replay_key = kDisplayClassGuid;
+            std::string recorded;
+            if (replay::Replaying()) {
+                if (replay::Lookup(DEVICE_REPLAY_WIN_DEVICE_LIST, replay_key, recorded))
+                    UnpackDeviceList(recorded, out);
+                return;
             }
         }
 
-        RegCloseKey(hSubKey);
-    }
+        HDEVINFO dev_info = SetupDiGetClassDevsW(&GUID_DEVCLASS_DISPLAY, nullptr, nullptr, DIGCF_PRESENT);
+        if (dev_info == INVALID_HANDLE_VALUE) return;
 
-    RegCloseKey(hKey);
-    return 0;
-}
-
-// ---- Get driver version from registry for a PNP device ----
+        SP_DEVINFO_DATA dev_data = {sizeof(SP_DEVINFO_DATA)};
+        for (DWORD i = 0; SetupDiEnumDeviceInfo(dev_info, i, &dev_data); ++i) {
+            wchar_t pnp_buffer[MAX_DEVICE_ID_LEN];
+            if (!SetupDiGetDeviceInstanceIdW(dev_info, &dev_data, pnp_buffer, MAX_DEVICE_ID_LEN, nullptr))
+                continue;
 
-static std::string GetDriverVersion(const std::wstring &pnp_device_id) {
-    const char *key_path = "SYSTEM\\CurrentControlSet\\Control\\Class\\{4d36e968-e325-11ce-bfc1-08002be10318}";
-    HKEY hKey;
-    if (RegOpenKeyExA(HKEY_LOCAL_MACHINE, key_path, 0, KEY_READ, &hKey) != ERROR_SUCCESS)
-        return {};
+            wchar_t driver_key[128] = {};
+            SetupDiGetDeviceRegistryPropertyW(dev_info, &dev_data, SPDRP_DRIVER, nullptr,
+                                              reinterpret_cast<PBYTE>(driver_key), sizeof(driver_key) - sizeof(wchar_t),
+                                              nullptr);
+            out.emplace_back(pnp_buffer, driver_key);
+        }
 
-    std::string pnp_utf8 = WideToUtf8(pnp_device_id.c_str());
-    // Extract VEN_XXXX&DEV_XXXX portion for matching
-    std::string upper_pnp = pnp_utf8;
-    for (auto &ch : upper_pnp) ch = toupper(ch);
+        SetupDiDestroyDeviceInfoList(dev_info);
+        if (!replay_key.empty()) replay::Record(DEVICE_REPLAY_WIN_DEVICE_LIST, replay_key, PackDeviceList(out));
+    }
 
-    for (DWORD i = 0; i < 100; ++i) {
-        char sub_key_name[32];
-        DWORD name_size = sizeof(sub_key_name);
-        if (RegEnumKeyExA(hKey, i, sub_key_name, &name_size, nullptr, nullptr, nullptr, nullptr) != ERROR_SUCCESS)
-            continue;
+    void LoadDevNodes() {
+        DEVICE_INFO_STAGE("DisplayDeviceIndex::LoadDevNodes");
+        DeviceList devices;
+        ListDevNodes(devices);
 
-        HKEY hSubKey;
-        if (RegOpenKeyExA(hKey, sub_key_name, 0, KEY_READ, &hSubKey) != ERROR_SUCCESS)
-            continue;
+        for (const auto &device : devices) {
+            DisplayDevNode node;
+            node.instance_id = device.first;
+            node.ids = pnp::ParseHardwareId(device.first.c_str());
+            if (!node.ids.has_vendor || !node.ids.has_device)
+                continue;
 
-        char matching_id[512] = {};
-        DWORD mid_size = sizeof(matching_id);
-        if (RegQueryValueExA(hSubKey, "MatchingDeviceId", nullptr, nullptr,
-                             reinterpret_cast<LPBYTE>(matching_id), &mid_size) == ERROR_SUCCESS) {
-            std::string upper_mid = matching_id;
-            for (auto &ch : upper_mid) ch = toupper(ch);
-            if (upper_pnp.find(upper_mid) != std::string::npos || upper_mid.find("VEN_") != std::string::npos) {
-                char drv_ver[256] = {};
-                DWORD ver_size = sizeof(drv_ver);
-                if (RegQueryValueExA(hSubKey, "DriverVersion", nullptr, nullptr,
-                                     reinterpret_cast<LPBYTE>(drv_ver), &ver_size) == ERROR_SUCCESS) {
-                    RegCloseKey(hSubKey);
-                    RegCloseKey(hKey);
-                    return drv_ver;
-                }
+            // SPDRP_DRIVER is "{class-guid}\\NNNN"; NNNN is the subkey under the display class key.
+            if (!device.second.empty()) {
+                const wchar_t *driver_key = device.second.c_str();
+                const wchar_t *slash = wcsrchr(driver_key, L'\\');
+                auto it = class_entries_.find(Upper(slash ? slash + 1 : driver_key));
+                if (it != class_entries_.end()) node.driver = &it->second;
             }
+
+            by_vendor_device_[VendorDeviceKey(node.ids.vendor_id, node.ids.device_id)].push_back(nodes_.size());
+            nodes_.push_back(std::move(node));
         }
-        RegCloseKey(hSubKey);
     }
 
-    RegCloseKey(hKey);
-    return {};
-}
+    static std::wstring Upper(const wchar_t *src) {
+        std::wstring out = src;
+        for (auto &ch : out) ch = towupper(ch);
+        return out;
+    }
 
-// ---- Vendor/Device/Subsystem ID parsing from PNP Device ID ----
+    // DisplayDevNode::driver and by_desc_ point into this; unordered_map never moves its elements.
+    std::unordered_map<std::wstring, DisplayClassEntry> class_entries_;
+    std::unordered_map<std::wstring, const DisplayClassEntry *> by_desc_;
+    std::vector<DisplayDevNode> nodes_;
+    std::unordered_map<uint32_t, std::vector<size_t>> by_vendor_device_;
+};
 
-struct PciIds {
-    uint32_t vendor_id;
-    uint32_t device_id;
-    uint32_t subsystem_vendor_id;
-    uint32_t subsystem_device_id;
+// ---- Enumeration ----
+
+struct GpuEntry {
+    std::string name;
+    std::string manufacturer;
+    std::string acpi_path;
+    std::string pci_path;
+    uint32_t vendor_id = 0;
+    uint32_t device_id = 0;
+    uint32_t subsystem_vendor_id = 0;
+    uint32_t subsystem_device_id = 0;
+    uint64_t vram_mb = 0;
+    int pcie_gen = 0;
+    int pcie_width = 0;
+    LUID luid = {};
+    std::wstring instance_id;
 };
 
-static PciIds ParsePnpDeviceId(const std::string &pnp) {
-    PciIds ids = {};
-    std::regex re(R"(VEN_([0-9A-Fa-f]{4}).*DEV_([0-9A-Fa-f]{4}).*SUBSYS_([0-9A-Fa-f]{4})([0-9A-Fa-f]{4}))",
-                  std::regex::icase);
-    std::smatch m;
-    if (std::regex_search(pnp, m, re)) {
-        ids.vendor_id = std::stoul(m[1].str(), nullptr, 16);
-        ids.device_id = std::stoul(m[2].str(), nullptr, 16);
-        ids.subsystem_device_id = std::stoul(m[3].str(), nullptr, 16);
-        ids.subsystem_vendor_id = std::stoul(m[4].str(), nullptr, 16);
+// DXGI's DedicatedVideoMemory is a SIZE_T capped by the driver on some cards, and the registry
+// fallback is whatever the driver wrote there; NVML reports the exact size, and the current link
+// when the devnode lacks the PCIe properties. One NVML pass serves every NVIDIA adapter.
+static void AddNvmlInfo(std::vector<GpuEntry> &gpus) {
+    std::vector<nvml::Device> devices;
+    if (!nvml::QueryDevices(devices)) return;
+
+    for (GpuEntry &gpu : gpus) {
+        uint32_t bus = 0, slot = 0, function = 0;
+        if (gpu.vendor_id != 0x10DE || gpu.instance_id.empty() ||
+            !GetDevNodePciAddress(gpu.instance_id, bus, slot, function))
+            continue;
+        // The devnode has no PCI segment; the device ID disambiguates equal addresses on other segments
+        const uint32_t pci_device_id = (gpu.device_id << 16) | gpu.vendor_id;
+        const auto it = std::find_if(devices.begin(), devices.end(), [&](const nvml::Device &d) {
+            return d.bus == bus && d.slot == slot && d.function == function && d.pci_device_id == pci_device_id;
+        });
+        if (it == devices.end()) continue;
+
+        if (it->memory_total_bytes) gpu.vram_mb = it->memory_total_bytes / (1024 * 1024);
+        if (!gpu.pcie_gen) gpu.pcie_gen = it->pcie_gen;
+        if (!gpu.pcie_width) gpu.pcie_width = it->pcie_width;
     }
-    return ids;
 }
 
-// ---- Public API ----
-
-int get_gpu_info(WinGPUProperties *out, int max_count) {
-    if (!out || max_count <= 0) return -1;
+// DXGI_ADAPTER_DESC1 of every adapter, in enumeration order, recorded / replayed as one entry.
+// Returns false if DXGI is unavailable.
+static bool EnumAdapterDescs(std::vector<DXGI_ADAPTER_DESC1> &out) {
+    if (replay::Replaying()) {
+        std::string recorded;
+        if (!replay::Lookup(DEVICE_REPLAY_WIN_DXGI_ADAPTERS, {}, recorded)) return false;
+        out.resize(recorded.size() / sizeof(DXGI_ADAPTER_DESC1));
+        if (!out.empty()) std::memcpy(out.data(), recorded.data(), out.size() * sizeof(DXGI_ADAPTER_DESC1));
+        return true;
+    }
 
     IDXGIFactory1 *factory = nullptr;
-    if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&factory))))
-        return -1;
+    {
+        DEVICE_INFO_STAGE("CreateDXGIFactory1");
+        if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&factory))))
+            return false;
+    }
 
-    int count = 0;
     IDXGIAdapter1 *adapter = nullptr;
-    std::set<std::wstring> seen_pnp_ids;
-
-    for (UINT a = 0; factory->EnumAdapters1(a, &adapter) != DXGI_ERROR_NOT_FOUND && count < max_count; ++a) {
+    for (UINT a = 0; factory->EnumAdapters1(a, &adapter) != DXGI_ERROR_NOT_FOUND; ++a) {
         DXGI_ADAPTER_DESC1 desc;
-        if (FAILED(adapter->GetDesc1(&desc))) {
-            adapter->Release();
-            continue;
-        }
+        if (SUCCEEDED(adapter->GetDesc1(&desc))) out.push_back(desc);
+        adapter->Release();
+    }
+    factory->Release();
+
+    if (replay::Active())
+        replay::Record(DEVICE_REPLAY_WIN_DXGI_ADAPTERS, {},
+                       std::string_view(reinterpret_cast<const char *>(out.data()),
+                                        out.size() * sizeof(DXGI_ADAPTER_DESC1)));
+    return true;
+}
+
+// Enumerates DXGI adapters (stopping after `limit` GPUs). Returns false if DXGI is unavailable.
+static bool CollectGpus(std::vector<GpuEntry> &gpus, size_t limit) {
+    DEVICE_INFO_STAGE("CollectGpus");
+    std::vector<DXGI_ADAPTER_DESC1> descs;
+    if (!EnumAdapterDescs(descs))
+        return false;
+
+    DisplayDeviceIndex index;
+    index.Build();
+
+    std::unordered_set<uint64_t> seen_luids;
+
+    for (const DXGI_ADAPTER_DESC1 &desc : descs) {
+        if (gpus.size() == limit) break;
 
         // Skip software/remote adapters (DXGI_ADAPTER_FLAG_SOFTWARE = 2, defined in DXGI 1.2+)
         // On Windows 7 no adapter sets this flag, so the check is a safe no-op.
-        if (desc.Flags & 2u) {
-            adapter->Release();
+        if (desc.Flags & 2u)
             continue;
-        }
 
-        // Deduplicate: DXGI can enumerate the same physical GPU multiple times (common on AMD APUs)
-        std::wstring pnp_id_early = PnpDeviceIdFromDXGI(desc);
-        if (!pnp_id_early.empty()) {
-            std::wstring upper_pnp = pnp_id_early;
-            for (auto &ch : upper_pnp) ch = towupper(ch);
-            if (seen_pnp_ids.count(upper_pnp)) {
-                adapter->Release();
-                continue;
-            }
-            seen_pnp_ids.insert(upper_pnp);
-        }
+        // Deduplicate: DXGI can enumerate the same physical GPU multiple times (common on AMD APUs).
+        // A repeat carries the LUID of the first enumeration; one under a new LUID finds every devnode
+        // of its VEN/DEV already claimed. Two identical cards still have a devnode each.
+        if (!seen_luids.insert(LuidKey(desc.AdapterLuid)).second)
+            continue;
+        const DisplayDevNode *node = index.Claim(desc);
+        if (!node && index.HasDevNode(desc))
+            continue;
 
-        WinGPUProperties gpu = {};
+        GpuEntry gpu;
 
         // Name from DXGI
-        char name_buf[256];
-        WideCharToMultiByte(CP_UTF8, 0, desc.Description, -1, name_buf, sizeof(name_buf), nullptr, nullptr);
-        strncpy_s(gpu.name, name_buf, _TRUNCATE);
+        gpu.name = WideToUtf8(desc.Description);
 
         // IDs from DXGI
         gpu.vendor_id = desc.VendorId;
         gpu.device_id = desc.DeviceId;
 
+        gpu.luid = desc.AdapterLuid;
+
         // PNP device instance already resolved above for dedup
-        const std::wstring &pnp_id = pnp_id_early;
-        std::string pnp_utf8 = WideToUtf8(pnp_id.c_str());
-
-        // Parse subsystem IDs from PNP device ID string
-        if (!pnp_utf8.empty()) {
-            PciIds ids = ParsePnpDeviceId(pnp_utf8);
-            gpu.subsystem_vendor_id = ids.subsystem_vendor_id;
-            gpu.subsystem_device_id = ids.subsystem_device_id;
+        const std::wstring pnp_id = node ? node->instance_id : std::wstring();
+        gpu.instance_id = pnp_id;
+
+        // Subsystem IDs decoded from the PNP device ID while building the index
+        if (node && node->ids.has_subsys) {
+            gpu.subsystem_vendor_id = node->ids.subsystem_vendor_id();
+            gpu.subsystem_device_id = node->ids.subsystem_device_id();
         }
 
         // VRAM: DXGI reports DedicatedVideoMemory in bytes
@@ -254,9 +326,9 @@ int get_gpu_info(WinGPUProperties *out, int max_count) {
 
         // WMI/DXGI may report capped VRAM for >4GB cards; fall back to registry
         if (vram_mb == 0 || desc.DedicatedVideoMemory >= 4194304000ULL) {
-            std::string drv_ver = GetDriverVersion(pnp_id);
-            uint64_t reg_vram = FetchVramFromRegistry(std::string(gpu.name), drv_ver);
-            if (reg_vram > 0) vram_mb = reg_vram;
+            const DisplayClassEntry *driver = node ? node->driver : nullptr;
+            if (!driver) driver = index.FindDriverByDesc(desc.Description);
+            if (driver && driver->memory_size > 0) vram_mb = driver->memory_size / (1024 * 1024);
         }
         gpu.vram_mb = vram_mb;
 
@@ -264,8 +336,8 @@ int get_gpu_info(WinGPUProperties *out, int max_count) {
         if (!pnp_id.empty()) {
             std::string acpi, pci;
             if (GetDevNodeLocationPaths(pnp_id, acpi, pci)) {
-                strncpy_s(gpu.acpi_path, acpi.c_str(), _TRUNCATE);
-                strncpy_s(gpu.pci_path, pci.c_str(), _TRUNCATE);
+                gpu.acpi_path = std::move(acpi);
+                gpu.pci_path = std::move(pci);
             }
 
             int gen = 0, width = 0;
@@ -277,21 +349,89 @@ int get_gpu_info(WinGPUProperties *out, int max_count) {
 
         // Manufacturer: map common vendor IDs
         switch (gpu.vendor_id) {
-            case 0x10DE: strncpy_s(gpu.manufacturer, "NVIDIA", _TRUNCATE); break;
-            case 0x1002: strncpy_s(gpu.manufacturer, "AMD", _TRUNCATE); break;
-            case 0x8086: strncpy_s(gpu.manufacturer, "Intel", _TRUNCATE); break;
+            case 0x10DE: gpu.manufacturer = "NVIDIA"; break;
+            case 0x1002: gpu.manufacturer = "AMD"; break;
+            case 0x8086: gpu.manufacturer = "Intel"; break;
             default: {
                 char hex[16];
                 snprintf(hex, sizeof(hex), "0x%04X", gpu.vendor_id);
-                strncpy_s(gpu.manufacturer, hex, _TRUNCATE);
+                gpu.manufacturer = hex;
                 break;
             }
         }
 
-        out[count++] = gpu;
-        adapter->Release();
+        gpus.push_back(std::move(gpu));
     }
 
-    factory->Release();
+    if (std::any_of(gpus.begin(), gpus.end(), [](const GpuEntry &gpu) { return gpu.vendor_id == 0x10DE; }))
+        AddNvmlInfo(gpus);
+    return true;
+}
+
+// ---- Public API ----
+
+bool gpu_info::CollectAdapters(std::vector<AdapterRef> &out) {
+    std::vector<GpuEntry> gpus;
+    if (!CollectGpus(gpus, SIZE_MAX))
+        return false;
+
+    for (GpuEntry &entry : gpus)
+        out.push_back(AdapterRef{entry.luid, std::move(entry.instance_id)});
+    return true;
+}
+
+int get_gpu_info(WinGPUProperties *out, int max_count) {
+    if (!out || max_count <= 0) return -1;
+
+    std::vector<GpuEntry> gpus;
+    if (!CollectGpus(gpus, static_cast<size_t>(max_count)))
+        return -1;
+
+    int count = 0;
+    for (const GpuEntry &entry : gpus) {
+        WinGPUProperties gpu = {};
+        strncpy_s(gpu.name, entry.name.c_str(), _TRUNCATE);
+        strncpy_s(gpu.manufacturer, entry.manufacturer.c_str(), _TRUNCATE);
+        strncpy_s(gpu.acpi_path, entry.acpi_path.c_str(), _TRUNCATE);
+        strncpy_s(gpu.pci_path, entry.pci_path.c_str(), _TRUNCATE);
+        gpu.vendor_id = entry.vendor_id;
+        gpu.device_id = entry.device_id;
+        gpu.subsystem_vendor_id = entry.subsystem_vendor_id;
+        gpu.subsystem_device_id = entry.subsystem_device_id;
+        gpu.vram_mb = entry.vram_mb;
+        gpu.pcie_gen = entry.pcie_gen;
+        gpu.pcie_width = entry.pcie_width;
+        out[count++] = gpu;
+    }
     return count;
 }
+
+int get_gpu_info_arena(DeviceArena **out) {
+    if (!out) return DEVICE_ARENA_STATUS_INVALID_ARG;
+    *out = nullptr;
+
+    std::vector<GpuEntry> gpus;
+    if (!CollectGpus(gpus, SIZE_MAX))
+        return DEVICE_ARENA_STATUS_FAILURE;
+
+    arena::Builder builder(DEVICE_ARENA_KIND_WIN_GPU, sizeof(WinGPURecord));
+    for (const GpuEntry &entry : gpus) {
+        WinGPURecord record = {};
+        record.name = builder.Intern(entry.name);
+        record.manufacturer = builder.Intern(entry.manufacturer);
+        record.acpi_path = builder.Intern(entry.acpi_path);
+        record.pci_path = builder.Intern(entry.pci_path);
+        record.vendor_id = entry.vendor_id;
+        record.device_id = entry.device_id;
+        record.subsystem_vendor_id = entry.subsystem_vendor_id;
+        record.subsystem_device_id = entry.subsystem_device_id;
+        record.vram_mb = entry.vram_mb;
+        record.pcie_gen = entry.pcie_gen;
+        record.pcie_width = entry.pcie_width;
+        record.instance_id = builder.Intern(WideToUtf8(entry.instance_id.c_str()));
+        builder.Append(&record);
+    }
+
+    *out = builder.Finish();
+    return *out ? DEVICE_ARENA_STATUS_OK : DEVICE_ARENA_STATUS_FAILURE;
+}
@@ -0,0 +1,229 @@
+#include "gpu_telemetry.h"
+#include "gpu_info.h"
+#include "win_helpers.h"
+
+#include <windows.h>
+#include <dxgi1_4.h>
+#include <pdh.h>
+
+#include <algorithm>
+#include <cwchar>
+#include <string>
+#include <utility>
+#include <vector>
+
+#pragma comment(lib, "dxgi.lib")
+#pragma comment(lib, "pdh.lib")
+
+// ---- Windows backend ----
+//
+// System-wide usage comes from the GPU performance counters (what Task Manager shows): dedicated
+// and shared memory per adapter, and utilization per engine. QueryVideoMemoryInfo only knows the
+// calling process, so it provides the budget and this process's own usage. The current PCIe link
+// is re-read from the devnode located at start.
+
+namespace {
+
+struct Gpu {
+    uint32_t index = 0;
+    LUID luid = {};
+    IDXGIAdapter3 *adapter = nullptr;  // null before Windows 10
+    DEVINST devnode = 0;
+
+    // Per sample, from the counters
+    double dedicated = -1;
+    double shared = -1;
+    std::vector<std::pair<std::wstring, double>> engines;  // engtype -> summed utilization
+};
+
+std::vector<Gpu> g_gpus;
+
+PDH_HQUERY g_query = nullptr;
+PDH_HCOUNTER g_dedicatedCounter = nullptr;
+PDH_HCOUNTER g_sharedCounter = nullptr;
+PDH_HCOUNTER g_engineCounter = nullptr;
+
+// Reused for every counter array; only grows
+std::vector<unsigned char> g_counterBuffer;
+
+bool SameLuid(const LUID &a, const LUID &b) {
+    return a.LowPart == b.LowPart && a.HighPart == b.HighPart;
+}
+
+// The DXGI adapter with `luid`, as IDXGIAdapter3 (DXGI 1.4), or null.
+IDXGIAdapter3 *OpenAdapter(IDXGIFactory1 *factory, const LUID &luid) {
+    IDXGIAdapter1 *adapter = nullptr;
+    for (UINT a = 0; factory->EnumAdapters1(a, &adapter) != DXGI_ERROR_NOT_FOUND; ++a) {
+        DXGI_ADAPTER_DESC1 desc;
+        IDXGIAdapter3 *adapter3 = nullptr;
+        if (SUCCEEDED(adapter->GetDesc1(&desc)) && SameLuid(desc.AdapterLuid, luid))
+            adapter->QueryInterface(IID_PPV_ARGS(&adapter3));
+        adapter->Release();
+        if (adapter3) return adapter3;
+    }
+    return nullptr;
+}
+
+// Counter instances name their adapter: "luid_0x00000000_0x0000C2E8_phys_0",
+// "pid_1234_luid_0x00000000_0x0000C2E8_phys_0_eng_3_engtype_3D".
+Gpu *FindGpu(const wchar_t *instance) {
+    const wchar_t *luid = wcsstr(instance, L"luid_");
+    unsigned long high = 0, low = 0;
+    if (!luid || swscanf(luid, L"luid_0x%lx_0x%lx", &high, &low) != 2) return nullptr;
+
+    for (Gpu &gpu : g_gpus)
+        if (gpu.luid.HighPart == static_cast<LONG>(high) && gpu.luid.LowPart == static_cast<DWORD>(low))
+            return &gpu;
+    return nullptr;
+}
+
+// Calls `fn(gpu, instance, value)` for every instance of `counter` that belongs to one of our GPUs.
+template <typename Fn>
+void ForEachInstance(PDH_HCOUNTER counter, Fn &&fn) {
+    if (!counter) return;
+
+    DWORD size = static_cast<DWORD>(g_counterBuffer.size());
+    DWORD count = 0;
+    auto *items = reinterpret_cast<PDH_FMT_COUNTERVALUE_ITEM_W *>(g_counterBuffer.data());
+    PDH_STATUS status = PdhGetFormattedCounterArrayW(counter, PDH_FMT_DOUBLE | PDH_FMT_NOCAP100, &size, &count, items);
+    if (status == static_cast<PDH_STATUS>(PDH_MORE_DATA)) {
+        g_counterBuffer.resize(size);
+        items = reinterpret_cast<PDH_FMT_COUNTERVALUE_ITEM_W *>(g_counterBuffer.data());
+        status = PdhGetFormattedCounterArrayW(counter, PDH_FMT_DOUBLE | PDH_FMT_NOCAP100, &size, &count, items);
+    }
+    if (status != ERROR_SUCCESS) return;
+
+    for (DWORD i = 0; i < count; ++i) {
+        if (items[i].FmtValue.CStatus != PDH_CSTATUS_VALID_DATA && items[i].FmtValue.CStatus != PDH_CSTATUS_NEW_DATA)
+            continue;
+        if (Gpu *gpu = FindGpu(items[i].szName)) fn(*gpu, items[i].szName, items[i].FmtValue.doubleValue);
+    }
+}
+
+void OpenCounters() {
+    if (PdhOpenQueryW(nullptr, 0, &g_query) != ERROR_SUCCESS) {
+        g_query = nullptr;
+        return;
+    }
+    // English names, so the query works on every display language; any of them may be missing
+    // (the GPU counters exist since Windows 10 1709).
+    if (PdhAddEnglishCounterW(g_query, L"\\GPU Adapter Memory(*)\\Dedicated Usage", 0, &g_dedicatedCounter) != ERROR_SUCCESS)
+        g_dedicatedCounter = nullptr;
+    if (PdhAddEnglishCounterW(g_query, L"\\GPU Adapter Memory(*)\\Shared Usage", 0, &g_sharedCounter) != ERROR_SUCCESS)
+        g_sharedCounter = nullptr;
+    if (PdhAddEnglishCounterW(g_query, L"\\GPU Engine(*)\\Utilization Percentage", 0, &g_engineCounter) != ERROR_SUCCESS)
+        g_engineCounter = nullptr;
+
+    if (!g_dedicatedCounter && !g_sharedCounter && !g_engineCounter) {
+        PdhCloseQuery(g_query);
+        g_query = nullptr;
+        return;
+    }
+    // Utilization is a rate: it needs a first collection to have a value at the first sample.
+    PdhCollectQueryData(g_query);
+}
+
+void CollectCounters() {
+    for (Gpu &gpu : g_gpus) {
+        gpu.dedicated = gpu.shared = -1;
+        gpu.engines.clear();
+    }
+    if (!g_query || PdhCollectQueryData(g_query) != ERROR_SUCCESS) return;
+
+    ForEachInstance(g_dedicatedCounter, [](Gpu &gpu, const wchar_t *, double value) {
+        gpu.dedicated = std::max(gpu.dedicated, 0.0) + value;
+    });
+    ForEachInstance(g_sharedCounter, [](Gpu &gpu, const wchar_t *, double value) {
+        gpu.shared = std::max(gpu.shared, 0.0) + value;
+    });
+    // One instance per process and engine: sum the processes of each engine type (3D, Copy,
+    // VideoDecode, ...); the GPU is as busy as its busiest engine type.
+    ForEachInstance(g_engineCounter, [](Gpu &gpu, const wchar_t *instance, double value) {
+        const wchar_t *type = wcsstr(instance, L"engtype_");
+        const std::wstring engine = type ? type + 8 : L"";
+        auto it = std::find_if(gpu.engines.begin(), gpu.engines.end(),
+                               [&](const auto &entry) { return entry.first == engine; });
+        if (it == gpu.engines.end()) gpu.engines.emplace_back(engine, value);
+        else it->second += value;
+    });
+}
+
+} // namespace
+
+namespace gpu_telemetry {
+
+bool PlatformOpen() {
+    std::vector<gpu_info::AdapterRef> refs;
+    if (!gpu_info::CollectAdapters(refs) || refs.empty()) return false;
+
+    IDXGIFactory1 *factory = nullptr;
+    if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&factory)))) return false;
+
+    g_gpus.clear();
+    for (size_t i = 0; i < refs.size(); ++i) {
+        Gpu gpu;
+        gpu.index = static_cast<uint32_t>(i);
+        gpu.luid = refs[i].luid;
+        gpu.adapter = OpenAdapter(factory, refs[i].luid);
+        if (!refs[i].instance_id.empty()) gpu.devnode = LocateDevNode(refs[i].instance_id);
+        g_gpus.push_back(std::move(gpu));
+    }
+    factory->Release();
+
+    OpenCounters();
+    return true;
+}
+
+void PlatformSample() {
+    CollectCounters();
+
+    for (const Gpu &gpu : g_gpus) {
+        GpuTelemetrySample sample = {};
+        sample.gpu_index = gpu.index;
+        sample.timestamp_ns = NowNs();
+
+        if (gpu.dedicated >= 0) {
+            sample.memory_used_bytes = static_cast<uint64_t>(gpu.dedicated);
+            sample.fields |= GPU_TELEMETRY_FIELD_MEMORY_USED;
+        }
+        if (gpu.shared >= 0) {
+            sample.shared_memory_used_bytes = static_cast<uint64_t>(gpu.shared);
+            sample.fields |= GPU_TELEMETRY_FIELD_SHARED_MEMORY_USED;
+        }
+        if (!gpu.engines.empty()) {
+            double busiest = 0;
+            for (const auto &engine : gpu.engines) busiest = std::max(busiest, engine.second);
+            sample.utilization_percent = static_cast<uint32_t>(std::min(busiest, 100.0) + 0.5);
+            sample.fields |= GPU_TELEMETRY_FIELD_UTILIZATION;
+        }
+
+        // Node 0: a linked-node adapter reports its segments per node, and get_gpu_info_arena()
+        // lists it once.
+        DXGI_QUERY_VIDEO_MEMORY_INFO info;
+        if (gpu.adapter && SUCCEEDED(gpu.adapter->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &info))) {
+            sample.memory_budget_bytes = info.Budget;
+            sample.process_memory_used_bytes = info.CurrentUsage;
+            sample.fields |= GPU_TELEMETRY_FIELD_MEMORY_BUDGET | GPU_TELEMETRY_FIELD_PROCESS_MEMORY_USED;
+        }
+
+        int gen = 0, width = 0;
+        if (gpu.devnode && GetDevNodePCIeInfo(gpu.devnode, gen, width)) {
+            sample.pcie_gen = gen;
+            sample.pcie_width = width;
+            sample.fields |= GPU_TELEMETRY_FIELD_PCIE_LINK;
+        }
+        Publish(sample);
+    }
+}
+
+void PlatformClose() {
+    if (g_query) PdhCloseQuery(g_query);
+    g_query = nullptr;
+    g_dedicatedCounter = g_sharedCounter = g_engineCounter = nullptr;
+
+    for (Gpu &gpu : g_gpus)
+        if (gpu.adapter) gpu.adapter->Release();
+    g_gpus.clear();
+}
+
+} // namespace gpu_telemetry
@@ -0,0 +1,346 @@
+#include "storage_info.h"
+#include "win_helpers.h"
+#include "bench_stages.h"
+#include "device_replay.h"
+
+#include <windows.h>
+#include <setupapi.h>
+#include <winioctl.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#pragma comment(lib, "setupapi.lib")
+
+// ---- Disk interfaces ----
+//
+// One SetupAPI pass lists every present disk; each one is then asked directly through its
+// storage driver. That is where the Storage WMI provider gets the same answers, minus the
+// provider's start-up, its RPC round trips and its hangs on a disk that does not respond.
+// The listing and every driver answer are recorded and replayed (see device_replay.h).
+
+namespace {
+
+// GUID_DEVINTERFACE_DISK; winioctl.h only declares it, and windows.h has already included it
+// without INITGUID by the time this file could ask for the definition.
+const GUID kDiskInterface = {0x53f56307, 0xb6bf, 0x11d0, {0x94, 0xf2, 0x00, 0xa0, 0xc9, 0x1e, 0xfb, 0x8b}};
+const char *const kDiskInterfaceGuid = "{53f56307-b6bf-11d0-94f2-00a0c91efb8b}";
+
+// Opening a disk can block on a spun-down or unresponsive device; the others carry on.
+const size_t kMaxWorkers = 8;
+
+struct DiskInterface {
+    std::wstring device_path;  // \\?\scsi#disk&ven_...#{53f56307-b6bf-11d0-94f2-00a0c91efb8b}
+    std::wstring instance_id;
+};
+
+struct DiskEntry {
+    bool answered = false;     // the device descriptor was read
+    std::string product_name;
+    std::string vendor_name;
+    std::string device_path;   // \\.\PhysicalDriveN
+    std::string instance_id;
+    uint64_t size_bytes = 0;
+    uint32_t bus_type = BusTypeUnknown;
+    uint32_t media_type = WIN_STORAGE_MEDIA_UNSPECIFIED;
+    DWORD device_number = MAXDWORD;
+};
+
+bool ListDiskInterfaces(std::vector<DiskInterface> &out) {
+    DEVICE_INFO_STAGE("ListDiskInterfaces");
+    DeviceList devices;
+    if (replay::Replaying()) {
+        std::string recorded;
+        if (!replay::Lookup(DEVICE_REPLAY_WIN_DEVICE_LIST, kDiskInterfaceGuid, recorded)) return false;
+        UnpackDeviceList(recorded, devices);
+        for (auto &device : devices) out.push_back(DiskInterface{std::move(device.first), std::move(device.second)});
+        return true;
+    }
+
+    HDEVINFO dev_info =
+        SetupDiGetClassDevsW(&kDiskInterface, nullptr, nullptr, DIGCF_PRESENT | DIGCF_DEVICEINTERFACE);
+    if (dev_info == INVALID_HANDLE_VALUE) return false;
+
+    SP_DEVICE_INTERFACE_DATA iface = {sizeof(SP_DEVICE_INTERFACE_DATA)};
+    std::vector<unsigned char> buffer;
+    for (DWORD i = 0; SetupDiEnumDeviceInterfaces(dev_info, nullptr, &kDiskInterface, i, &iface); ++i) {
+        DWORD size = 0;
+        SetupDiGetDeviceInterfaceDetailW(dev_info, &iface, nullptr, 0, &size, nullptr);
+        if (size < sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA_W)) continue;
+
+        buffer.assign(size, 0);
+        auto *detail = reinterpret_cast<SP_DEVICE_INTERFACE_DETAIL_DATA_W *>(buffer.data());
+        detail->cbSize = sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA_W);
+        SP_DEVINFO_DATA dev_data = {sizeof(SP_DEVINFO_DATA)};
+        if (!SetupDiGetDeviceInterfaceDetailW(dev_info, &iface, detail, size, nullptr, &dev_data)) continue;
+
+        DiskInterface disk;
+        disk.device_path = detail->DevicePath;
+        wchar_t instance_id[MAX_DEVICE_ID_LEN];
+        if (SetupDiGetDeviceInstanceIdW(dev_info, &dev_data, instance_id, MAX_DEVICE_ID_LEN, nullptr))
+            disk.instance_id = instance_id;
+        out.push_back(std::move(disk));
+    }
+
+    SetupDiDestroyDeviceInfoList(dev_info);
+
+    if (replay::Active()) {
+        for (const DiskInterface &disk : out) devices.emplace_back(disk.device_path, disk.instance_id);
+        replay::Record(DEVICE_REPLAY_WIN_DEVICE_LIST, kDiskInterfaceGuid, PackDeviceList(devices));
+    }
+    return true;
+}
+
+// A disk opened for driver queries. While replaying nothing is opened: each query is answered
+// from the corpus, keyed by interface path, IOCTL code and input.
+class DiskDevice {
+public:
+    explicit DiskDevice(const std::wstring &device_path) {
+        if (replay::Active()) replay_path_ = WideToUtf8(device_path.c_str());
+        if (replay::Replaying()) {
+            replaying_ = true;
+            return;
+        }
+
+        DEVICE_INFO_STAGE("OpenDisk");
+        const DWORD share = FILE_SHARE_READ | FILE_SHARE_WRITE;
+        handle_ = CreateFileW(device_path.c_str(), GENERIC_READ, share, nullptr, OPEN_EXISTING, 0, nullptr);
+        if (handle_ == INVALID_HANDLE_VALUE && GetLastError() == ERROR_ACCESS_DENIED)
+            handle_ = CreateFileW(device_path.c_str(), 0, share, nullptr, OPEN_EXISTING, 0, nullptr);  // queries only
+    }
+
+    ~DiskDevice() {
+        if (handle_ != INVALID_HANDLE_VALUE) CloseHandle(handle_);
+    }
+
+    DiskDevice(const DiskDevice &) = delete;
+    DiskDevice &operator=(const DiskDevice &) = delete;
+
+    bool ok() const { return handle_ != INVALID_HANDLE_VALUE || replaying_; }
+
+    // DeviceIoControl() without OVERLAPPED; a replayed answer is cut to `out_size` as the driver would
+    bool Control(DWORD code, const void *in, DWORD in_size, void *out, DWORD out_size, DWORD &returned) const {
+        std::string replay_key;
+        if (!replay_path_.empty()) {
+            replay_key = ReplayKey(code, in, in_size);
+            if (replaying_) {
+                std::string recorded;
+                if (!replay::Lookup(DEVICE_REPLAY_WIN_DEVICE_IOCTL, replay_key, recorded)) return false;
+                returned = static_cast<DWORD>(std::min<size_t>(recorded.size(), out_size));
+                std::memcpy(out, recorded.data(), returned);
+                return true;
+            }
+        }
+
+        if (!DeviceIoControl(handle_, code, const_cast<void *>(in), in_size, out, out_size, &returned, nullptr))
+            return false;
+        if (!replay_key.empty())
+            replay::Record(DEVICE_REPLAY_WIN_DEVICE_IOCTL, replay_key,
+                           std::string_view(static_cast<const char *>(out), returned));
+        return true;
+    }
+
+private:
+    std::string ReplayKey(DWORD code, const void *in, DWORD in_size) const {
+        static const char kHex[] = "0123456789abcdef";
+        char code_hex[16];
+        std::snprintf(code_hex, sizeof(code_hex), "\n%08lx\n", static_cast<unsigned long>(code));
+        std::string key = replay_path_ + code_hex;
+        const auto *bytes = static_cast<const unsigned char *>(in);
+        for (DWORD i = 0; i < in_size; ++i) {
+            key += kHex[bytes[i] >> 4];
+            key += kHex[bytes[i] & 0xF];
+        }
+        return key;
+    }
+
+    HANDLE handle_ = INVALID_HANDLE_VALUE;
+    bool replaying_ = false;
+    std::string replay_path_;  // UTF-8, set while recording or replaying
+};
+
+// ---- Driver queries ----
+
+// A standard-query storage descriptor: the header first for its size, then the whole of it.
+bool QueryProperty(const DiskDevice &device, STORAGE_PROPERTY_ID id, std::vector<unsigned char> &out) {
+    STORAGE_PROPERTY_QUERY query = {};
+    query.PropertyId = id;
+    query.QueryType = PropertyStandardQuery;
+
+    STORAGE_DESCRIPTOR_HEADER header = {};
+    DWORD returned = 0;
+    if (!device.Control(IOCTL_STORAGE_QUERY_PROPERTY, &query, sizeof(query), &header, sizeof(header), returned) ||
+        header.Size < sizeof(header))
+        return false;
+
+    out.assign(header.Size, 0);
+    if (!device.Control(IOCTL_STORAGE_QUERY_PROPERTY, &query, sizeof(query), out.data(),
+                        static_cast<DWORD>(out.size()), returned))
+        return false;
+    out.resize(returned);
+    return returned >= sizeof(header);
+}
+
+// An ASCII field of STORAGE_DEVICE_DESCRIPTOR. ATA and SCSI pad them with spaces; 0 means absent.
+std::string DescriptorString(const std::vector<unsigned char> &descriptor, DWORD offset) {
+    if (offset == 0 || offset >= descriptor.size()) return {};
+    const char *text = reinterpret_cast<const char *>(descriptor.data() + offset);
+    std::string value(text, strnlen(text, descriptor.size() - offset));
+
+    const size_t first = value.find_first_not_of(' ');
+    if (first == std::string::npos) return {};
+    return value.substr(first, value.find_last_not_of(' ') - first + 1);
+}
+
+// IOCTL_DISK_GET_LENGTH_INFO needs read access, which only an administrator gets on a raw disk;
+// the geometry query needs none and reports the same size.
+uint64_t QueryDiskSize(const DiskDevice &device) {
+    DWORD returned = 0;
+    GET_LENGTH_INFORMATION length = {};
+    if (device.Control(IOCTL_DISK_GET_LENGTH_INFO, nullptr, 0, &length, sizeof(length), returned) &&
+        returned >= sizeof(length))
+        return static_cast<uint64_t>(length.Length.QuadPart);
+
+    // DISK_GEOMETRY_EX ends in partition and detection data the driver appends
+    alignas(DISK_GEOMETRY_EX) unsigned char geometry[512];
+    if (device.Control(IOCTL_DISK_GET_DRIVE_GEOMETRY_EX, nullptr, 0, geometry, sizeof(geometry), returned) &&
+        returned >= offsetof(DISK_GEOMETRY_EX, Data))
+        return static_cast<uint64_t>(reinterpret_cast<const DISK_GEOMETRY_EX *>(geometry)->DiskSize.QuadPart);
+    return 0;
+}
+
+void ProbeDisk(const DiskInterface &disk, DiskEntry &entry) {
+    DiskDevice device(disk.device_path);
+    if (!device.ok()) return;
+
+    std::vector<unsigned char> descriptor;
+    if (QueryProperty(device, StorageDeviceProperty, descriptor) &&
+        descriptor.size() >= offsetof(STORAGE_DEVICE_DESCRIPTOR, RawPropertiesLength)) {
+        const auto *device_desc = reinterpret_cast<const STORAGE_DEVICE_DESCRIPTOR *>(descriptor.data());
+        entry.answered = true;
+        entry.vendor_name = DescriptorString(descriptor, device_desc->VendorIdOffset);
+        entry.product_name = DescriptorString(descriptor, device_desc->ProductIdOffset);
+        entry.bus_type = device_desc->BusType;
+    }
+
+    // Some miniports leave the bus unknown on the disk and only report it for the adapter
+    std::vector<unsigned char> adapter;
+    if (entry.answered && entry.bus_type == BusTypeUnknown && QueryProperty(device, StorageAdapterProperty, adapter) &&
+        adapter.size() >= offsetof(STORAGE_ADAPTER_DESCRIPTOR, BusType) + sizeof(BYTE))
+        entry.bus_type = reinterpret_cast<const STORAGE_ADAPTER_DESCRIPTOR *>(adapter.data())->BusType;
+
+    // Windows' own SSD detection (defrag's, too): no seek penalty means solid state
+    std::vector<unsigned char> seek;
+    if (entry.answered && QueryProperty(device, StorageDeviceSeekPenaltyProperty, seek) &&
+        seek.size() >= sizeof(DEVICE_SEEK_PENALTY_DESCRIPTOR))
+        entry.media_type = reinterpret_cast<const DEVICE_SEEK_PENALTY_DESCRIPTOR *>(seek.data())->IncursSeekPenalty
+                               ? WIN_STORAGE_MEDIA_HDD
+                               : WIN_STORAGE_MEDIA_SSD;
+
+    if (entry.answered) {
+        entry.size_bytes = QueryDiskSize(device);
+
+        STORAGE_DEVICE_NUMBER number = {};
+        DWORD returned = 0;
+        if (device.Control(IOCTL_STORAGE_GET_DEVICE_NUMBER, nullptr, 0, &number, sizeof(number), returned) &&
+            returned >= sizeof(number)) {
+            char path[64];
+            std::snprintf(path, sizeof(path), "\\\\.\\PhysicalDrive%lu", number.DeviceNumber);
+            entry.device_number = number.DeviceNumber;
+            entry.device_path = path;
+        }
+        entry.instance_id = WideToUtf8(disk.instance_id.c_str());
+    }
+}
+
+// Every disk that answered, in device-number order. Returns false if SetupAPI is unavailable.
+bool CollectDisks(std::vector<DiskEntry> &disks) {
+    DEVICE_INFO_STAGE("CollectDisks");
+    std::vector<DiskInterface> interfaces;
+    if (!ListDiskInterfaces(interfaces)) return false;
+
+    // Each worker writes only its own entries
+    std::vector<DiskEntry> entries(interfaces.size());
+    std::atomic<size_t> next{0};
+    auto work = [&] {
+        for (size_t i = next.fetch_add(1); i < interfaces.size(); i = next.fetch_add(1))
+            ProbeDisk(interfaces[i], entries[i]);
+    };
+
+    // The calling thread is one of the workers, so a single disk never spawns a thread.
+    const size_t threads = std::min(interfaces.size(), kMaxWorkers);
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threads; ++i) {
+        try {
+            workers.emplace_back(work);
+        } catch (const std::system_error &) {
+            break;  // fewer workers, same result
+        }
+    }
+    work();
+    for (auto &worker : workers) worker.join();
+
+    for (DiskEntry &entry : entries)
+        if (entry.answered) disks.push_back(std::move(entry));
+    std::stable_sort(disks.begin(), disks.end(),
+                     [](const DiskEntry &a, const DiskEntry &b) { return a.device_number < b.device_number; });
+    return true;
+}
+
+} // namespace
+
+// ---- Public API ----
+
+int get_storage_info(WinStorageDeviceProperties *out, int max_count) {
+    if (!out || max_count <= 0) return -1;
+
+    std::vector<DiskEntry> disks;
+    if (!CollectDisks(disks)) return -1;
+
+    int count = 0;
+    for (const DiskEntry &entry : disks) {
+        if (count == max_count) break;
+        WinStorageDeviceProperties disk = {};
+        strncpy_s(disk.product_name, entry.product_name.c_str(), _TRUNCATE);
+        strncpy_s(disk.vendor_name, entry.vendor_name.c_str(), _TRUNCATE);
+        strncpy_s(disk.device_path, entry.device_path.c_str(), _TRUNCATE);
+        disk.size_bytes = entry.size_bytes;
+        disk.bus_type = entry.bus_type;
+        disk.media_type = entry.media_type;
+        out[count++] = disk;
+    }
+    return count;
+}
+
+int get_storage_info_arena(DeviceArena **out) {
+    if (!out) return DEVICE_ARENA_STATUS_INVALID_ARG;
+    *out = nullptr;
+
+    std::vector<DiskEntry> disks;
+    if (!CollectDisks(disks)) return DEVICE_ARENA_STATUS_FAILURE;
+
+    arena::Builder builder(DEVICE_ARENA_KIND_WIN_STORAGE, sizeof(WinStorageDeviceRecord));
+    for (const DiskEntry &entry : disks) {
+        WinStorageDeviceRecord record = {};
+        record.product_name = builder.Intern(entry.product_name);
+        record.vendor_name = builder.Intern(entry.vendor_name);
+        record.device_path = builder.Intern(entry.device_path);
+        record.instance_id = builder.Intern(entry.instance_id);
+        record.size_bytes = entry.size_bytes;
+        record.bus_type = entry.bus_type;
+        record.media_type = entry.media_type;
+        builder.Append(&record);
+    }
+
+    *out = builder.Finish();
+    return *out ? DEVICE_ARENA_STATUS_OK : DEVICE_ARENA_STATUS_FAILURE;
+}
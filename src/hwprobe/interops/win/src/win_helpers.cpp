@@ -1,4 +1,6 @@
 #include "win_helpers.h"
+#include "bench_stages.h"
+#include "device_replay.h"
 
 #include <windows.h>
 #include <cfgmgr32.h>
@@ -9,6 +11,8 @@
 #include <regex>
 #include <sstream>
 #include <cstdio>
+#include <cstring>
+#include <iterator>
 
 #pragma comment(lib, "cfgmgr32.lib")
 
@@ -23,6 +27,15 @@ std::string WideToUtf8(const wchar_t *src) {
     return out;
 }
 
+std::wstring Utf8ToWide(const char *src) {
+    if (!src || !*src) return {};
+    int len = MultiByteToWideChar(CP_UTF8, 0, src, -1, nullptr, 0);
+    if (len <= 1) return {};
+    std::wstring out(len - 1, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, src, -1, &out[0], len);
+    return out;
+}
+
 extern "C" void wide_to_utf8(const wchar_t *src, char *dst, int dst_size) {
     if (!src || !dst || dst_size <= 0) return;
     WideCharToMultiByte(CP_UTF8, 0, src, -1, dst, dst_size, nullptr, nullptr);
@@ -44,39 +57,88 @@ static const DEVPROPKEY DEVPKEY_PCIe_CurrentLinkWidth = {
 
 // ---- Internal helpers ----
 
-static DEVINST LocateDevNode(const std::wstring &pnp_device_id) {
+DEVINST LocateDevNode(const std::wstring &pnp_device_id) {
     DEVINST dn = 0;
     CONFIGRET cr = CM_Locate_DevNodeW(&dn, const_cast<DEVINSTID_W>(pnp_device_id.c_str()), CM_LOCATE_DEVNODE_NORMAL);
     return (cr == CR_SUCCESS) ? dn : 0;
 }
 
-static bool GetDevNodeStringListProperty(DEVINST dn, const DEVPROPKEY &key, std::vector<std::string> &out) {
+static bool GetDevNodeUInt32Property(DEVINST dn, const DEVPROPKEY &key, uint32_t &out) {
     DEVPROPTYPE propType = 0;
-    ULONG bufSize = 0;
+    ULONG bufSize = sizeof(uint32_t);
+    CONFIGRET cr = CM_Get_DevNode_PropertyW(dn, &key, &propType, reinterpret_cast<PBYTE>(&out), &bufSize, 0);
+    return (cr == CR_SUCCESS);
+}
+
+// "instance ID\n{fmtid} pid", the key of a DEVICE_REPLAY_WIN_DEVNODE_PROPERTY entry
+static std::string PropertyReplayKey(const std::wstring &pnp_device_id, const DEVPROPKEY &key) {
+    const GUID &id = key.fmtid;
+    char suffix[64];
+    std::snprintf(suffix, sizeof(suffix), "\n{%08lX-%04X-%04X-%02X%02X-%02X%02X%02X%02X%02X%02X} %lu",
+                  static_cast<unsigned long>(id.Data1), id.Data2, id.Data3, id.Data4[0], id.Data4[1], id.Data4[2],
+                  id.Data4[3], id.Data4[4], id.Data4[5], id.Data4[6], id.Data4[7], static_cast<unsigned long>(key.pid));
+    return WideToUtf8(pnp_device_id.c_str()) + suffix;
+}
 
-    CONFIGRET cr = CM_Get_DevNode_PropertyW(dn, &key, &propType, nullptr, &bufSize, 0);
-    if (cr != CR_BUFFER_SMALL && cr != CR_SUCCESS) return false;
+// Raw data of a devnode property, recorded / replayed by instance ID. `dn` is located on first
+// use, so several properties of one device locate it once; in replay mode it is never located.
+// `size_hint` bytes are tried first, so a fixed-size property takes one call.
+static bool ReadDevNodeProperty(const std::wstring &pnp_device_id, DEVINST &dn, const DEVPROPKEY &key,
+                                ULONG size_hint, std::vector<BYTE> &out) {
+    std::string replay_key;
+    if (replay::Active()) {
+        replay_key = PropertyReplayKey(pnp_device_id, key);
+        std::string recorded;
+        if (replay::Replaying()) {
+            if (!replay::Lookup(DEVICE_REPLAY_WIN_DEVNODE_PROPERTY, replay_key, recorded)) return false;
+            out.assign(recorded.begin(), recorded.end());
+            return true;
+        }
+    }
 
-    std::vector<BYTE> buf(bufSize);
-    cr = CM_Get_DevNode_PropertyW(dn, &key, &propType, buf.data(), &bufSize, 0);
+    if (!dn) dn = LocateDevNode(pnp_device_id);
+    if (!dn) return false;
+
+    DEVPROPTYPE propType = 0;
+    out.resize(size_hint);
+    ULONG bufSize = size_hint;
+    CONFIGRET cr = CM_Get_DevNode_PropertyW(dn, &key, &propType, out.data(), &bufSize, 0);
+    if (cr == CR_BUFFER_SMALL) {
+        out.resize(bufSize);
+        cr = CM_Get_DevNode_PropertyW(dn, &key, &propType, out.data(), &bufSize, 0);
+    }
     if (cr != CR_SUCCESS) return false;
+    out.resize(bufSize);
+
+    if (!replay_key.empty())
+        replay::Record(DEVICE_REPLAY_WIN_DEVNODE_PROPERTY, replay_key,
+                       std::string_view(reinterpret_cast<const char *>(out.data()), out.size()));
+    return true;
+}
+
+static bool GetDevNodeStringListProperty(const std::wstring &pnp_device_id, DEVINST &dn, const DEVPROPKEY &key,
+                                         std::vector<std::string> &out) {
+    std::vector<BYTE> buf;
+    if (!ReadDevNodeProperty(pnp_device_id, dn, key, 512, buf)) return false;
 
     const wchar_t *p = reinterpret_cast<const wchar_t *>(buf.data());
-    const wchar_t *end = p + (bufSize / sizeof(wchar_t));
+    const wchar_t *end = p + (buf.size() / sizeof(wchar_t));
 
     while (p < end && *p) {
-        std::wstring ws(p);
+        std::wstring ws(p, wcsnlen(p, static_cast<size_t>(end - p)));
         out.push_back(WideToUtf8(ws.c_str()));
         p += ws.size() + 1;
     }
     return !out.empty();
 }
 
-static bool GetDevNodeUInt32Property(DEVINST dn, const DEVPROPKEY &key, uint32_t &out) {
-    DEVPROPTYPE propType = 0;
-    ULONG bufSize = sizeof(uint32_t);
-    CONFIGRET cr = CM_Get_DevNode_PropertyW(dn, &key, &propType, reinterpret_cast<PBYTE>(&out), &bufSize, 0);
-    return (cr == CR_SUCCESS);
+static bool GetDevNodeUInt32Property(const std::wstring &pnp_device_id, DEVINST &dn, const DEVPROPKEY &key,
+                                     uint32_t &out) {
+    std::vector<BYTE> buf;
+    if (!ReadDevNodeProperty(pnp_device_id, dn, key, sizeof(uint32_t), buf) || buf.size() < sizeof(uint32_t))
+        return false;
+    std::memcpy(&out, buf.data(), sizeof(uint32_t));
+    return true;
 }
 
 // ---- Path formatting ----
@@ -152,11 +214,10 @@ std::string FormatAcpiPath(const std::string &raw) {
 bool GetDevNodeLocationPaths(const std::wstring &pnp_device_id,
                              std::string &out_acpi_path,
                              std::string &out_pci_path) {
-    DEVINST dn = LocateDevNode(pnp_device_id);
-    if (!dn) return false;
-
+    DEVICE_INFO_STAGE("GetDevNodeLocationPaths");
+    DEVINST dn = 0;
     std::vector<std::string> paths;
-    if (!GetDevNodeStringListProperty(dn, DEVPKEY_LocationPaths, paths))
+    if (!GetDevNodeStringListProperty(pnp_device_id, dn, DEVPKEY_LocationPaths, paths))
         return false;
 
     for (const auto &path : paths) {
@@ -171,9 +232,32 @@ bool GetDevNodeLocationPaths(const std::wstring &pnp_device_id,
 bool GetDevNodePCIeInfo(const std::wstring &pnp_device_id,
                         int &out_pcie_gen,
                         int &out_pcie_width) {
-    DEVINST dn = LocateDevNode(pnp_device_id);
-    if (!dn) return false;
+    DEVICE_INFO_STAGE("GetDevNodePCIeInfo");
+    DEVINST dn = 0;
+    uint32_t speed = 0, width = 0;
+    bool got_speed = GetDevNodeUInt32Property(pnp_device_id, dn, DEVPKEY_PCIe_CurrentLinkSpeed, speed);
+    bool got_width = GetDevNodeUInt32Property(pnp_device_id, dn, DEVPKEY_PCIe_CurrentLinkWidth, width);
+
+    if (got_speed) out_pcie_gen = static_cast<int>(speed);
+    if (got_width) out_pcie_width = static_cast<int>(width);
 
+    return got_speed || got_width;
+}
+
+bool GetDevNodePciAddress(const std::wstring &pnp_device_id, uint32_t &out_bus, uint32_t &out_device,
+                          uint32_t &out_function) {
+    DEVINST dn = 0;
+    uint32_t address = 0;
+    if (!GetDevNodeUInt32Property(pnp_device_id, dn, DEVPKEY_Device_BusNumber, out_bus) ||
+        !GetDevNodeUInt32Property(pnp_device_id, dn, DEVPKEY_Device_Address, address))
+        return false;
+    // PCI devnodes encode their address as (device << 16) | function
+    out_device = address >> 16;
+    out_function = address & 0xFFFF;
+    return true;
+}
+
+bool GetDevNodePCIeInfo(DEVINST dn, int &out_pcie_gen, int &out_pcie_width) {
     uint32_t speed = 0, width = 0;
     bool got_speed = GetDevNodeUInt32Property(dn, DEVPKEY_PCIe_CurrentLinkSpeed, speed);
     bool got_width = GetDevNodeUInt32Property(dn, DEVPKEY_PCIe_CurrentLinkWidth, width);
@@ -183,3 +267,116 @@ bool GetDevNodePCIeInfo(const std::wstring &pnp_device_id,
 
     return got_speed || got_width;
 }
+
+// ---- Record / replay ----
+
+RegistryKey::RegistryKey(const wchar_t *path) : path_(path), replaying_(replay::Replaying()) {
+    if (!replaying_ && RegOpenKeyExW(HKEY_LOCAL_MACHINE, path, 0, KEY_READ, &key_) != ERROR_SUCCESS)
+        key_ = nullptr;
+}
+
+RegistryKey::RegistryKey(const RegistryKey &parent, const std::wstring &name)
+    : path_(parent.path_ + L"\\" + name), replaying_(parent.replaying_) {
+    if (!replaying_ && (!parent.key_ || RegOpenKeyExW(parent.key_, name.c_str(), 0, KEY_READ, &key_) != ERROR_SUCCESS))
+        key_ = nullptr;
+}
+
+RegistryKey::~RegistryKey() {
+    if (key_) RegCloseKey(key_);
+}
+
+bool RegistryKey::Subkeys(std::vector<std::wstring> &out) const {
+    if (replaying_) {
+        std::string packed;
+        if (!replay::Lookup(DEVICE_REPLAY_WIN_REGISTRY_KEYS, WideToUtf8(path_.c_str()), packed)) return false;
+        for (size_t pos = 0, end; (end = packed.find('\0', pos)) != std::string::npos; pos = end + 1)
+            out.push_back(Utf8ToWide(packed.substr(pos, end - pos).c_str()));
+        return true;
+    }
+    if (!key_) return false;
+
+    std::string packed;
+    for (DWORD i = 0;; ++i) {
+        wchar_t sub_key_name[64];
+        DWORD name_size = static_cast<DWORD>(std::size(sub_key_name));
+        LONG rc = RegEnumKeyExW(key_, i, sub_key_name, &name_size, nullptr, nullptr, nullptr, nullptr);
+        if (rc == ERROR_NO_MORE_ITEMS) break;
+        if (rc != ERROR_SUCCESS) continue;
+        out.emplace_back(sub_key_name, name_size);
+        if (replay::Active()) packed += WideToUtf8(sub_key_name) + '\0';
+    }
+
+    if (replay::Active()) replay::Record(DEVICE_REPLAY_WIN_REGISTRY_KEYS, WideToUtf8(path_.c_str()), packed);
+    return true;
+}
+
+bool RegistryKey::Value(const wchar_t *name, DWORD &type, std::vector<BYTE> &data) const {
+    std::string replay_key;
+    if (replay::Active()) {
+        replay_key = WideToUtf8(path_.c_str()) + '\n' + WideToUtf8(name);
+        if (replaying_) {
+            std::string recorded;
+            if (!replay::Lookup(DEVICE_REPLAY_WIN_REGISTRY_VALUE, replay_key, recorded) ||
+                recorded.size() < sizeof(DWORD))
+                return false;
+            std::memcpy(&type, recorded.data(), sizeof(DWORD));
+            data.assign(recorded.begin() + sizeof(DWORD), recorded.end());
+            return true;
+        }
+    }
+    if (!key_) return false;
+
+    // Most values fit the first try, so they take one call
+    DWORD size = 256;
+    data.resize(size);
+    LONG rc = RegQueryValueExW(key_, name, nullptr, &type, data.data(), &size);
+    if (rc == ERROR_MORE_DATA) {
+        data.resize(size);
+        rc = RegQueryValueExW(key_, name, nullptr, &type, data.data(), &size);
+    }
+    if (rc != ERROR_SUCCESS) return false;
+    data.resize(size);
+
+    if (!replay_key.empty()) {
+        std::string value(reinterpret_cast<const char *>(&type), sizeof(DWORD));
+        value.append(reinterpret_cast<const char *>(data.data()), data.size());
+        replay::Record(DEVICE_REPLAY_WIN_REGISTRY_VALUE, replay_key, value);
+    }
+    return true;
+}
+
+std::wstring RegistryKey::String(const wchar_t *name) const {
+    DWORD type = 0;
+    std::vector<BYTE> data;
+    if (!Value(name, type, data) || (type != REG_SZ && type != REG_EXPAND_SZ) || data.size() < sizeof(wchar_t))
+        return {};
+
+    const auto *text = reinterpret_cast<const wchar_t *>(data.data());
+    return std::wstring(text, wcsnlen(text, data.size() / sizeof(wchar_t)));
+}
+
+bool RegistryKey::Scalar(const wchar_t *name, uint64_t &out) const {
+    DWORD type = 0;
+    std::vector<BYTE> data;
+    if (!Value(name, type, data) || data.size() > sizeof(uint64_t)) return false;
+    out = 0;
+    std::memcpy(&out, data.data(), data.size());
+    return true;
+}
+
+std::string PackDeviceList(const DeviceList &devices) {
+    std::string packed;
+    for (const auto &device : devices) {
+        packed += WideToUtf8(device.first.c_str()) + '\0';
+        packed += WideToUtf8(device.second.c_str()) + '\0';
+    }
+    return packed;
+}
+
+void UnpackDeviceList(std::string_view packed, DeviceList &out) {
+    std::vector<std::wstring> fields;
+    for (size_t pos = 0, end; (end = packed.find('\0', pos)) != std::string_view::npos; pos = end + 1)
+        fields.push_back(Utf8ToWide(std::string(packed.substr(pos, end - pos)).c_str()));
+    for (size_t i = 0; i + 1 < fields.size(); i += 2)
+        out.emplace_back(std::move(fields[i]), std::move(fields[i + 1]));
+}
@@ -0,0 +1,1324 @@
+#include "wmi_info.h"
+// Winsock 2 has to come before <windows.h>, which would pull in the old winsock.h
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include "com_apartment.h"
+#include "win_helpers.h"
+#include "bench_stages.h"
+#include "device_replay.h"
+
+#include <windows.h>
+#include <objbase.h>
+#include <oleauto.h>
+#include <wbemidl.h>
+#include <propvarutil.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <cwctype>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#pragma comment(lib, "ole32.lib")
+#pragma comment(lib, "oleaut32.lib")
+#pragma comment(lib, "wbemuuid.lib")
+#pragma comment(lib, "propsys.lib")
+#pragma comment(lib, "ws2_32.lib")
+
+// ---- COM apartment ----
+
+namespace {
+
+using com::ComApartment;
+using com::EnsureProcessSecurity;
+
+// Runs `fn` on a thread that belongs to the MTA. Pooled proxies live in the MTA, so
+// releasing them from an STA caller is handed to a short-lived worker thread instead.
+template <typename Fn>
+void RunInMta(Fn &&fn) {
+    {
+        ComApartment apt;
+        if (apt.in_mta()) {
+            fn();
+            return;
+        }
+    }
+    std::thread worker([&fn] {
+        ComApartment apt;
+        fn();
+    });
+    worker.join();
+}
+
+bool IsDisconnected(HRESULT hr) {
+    return hr == RPC_E_DISCONNECTED ||
+           hr == HRESULT_FROM_WIN32(RPC_S_SERVER_UNAVAILABLE) ||
+           hr == HRESULT_FROM_WIN32(RPC_S_CALL_FAILED) ||
+           hr == static_cast<HRESULT>(WBEM_E_TRANSPORT_FAILURE);
+}
+
+std::wstring NamespaceKey(const std::wstring &ns) {
+    std::wstring key = ns;
+    for (auto &ch : key) ch = towupper(ch);
+    return key;
+}
+
+// ---- Session setup ----
+
+HRESULT CreateLocator(IWbemLocator **out) {
+    return CoCreateInstance(CLSID_WbemLocator, nullptr, CLSCTX_INPROC_SERVER, IID_IWbemLocator,
+                            reinterpret_cast<void **>(out));
+}
+
+HRESULT ConnectNamespace(IWbemLocator *locator, const std::wstring &ns, IWbemServices **out) {
+    DEVICE_INFO_STAGE("IWbemLocator::ConnectServer");
+    BSTR bstr_ns = SysAllocString(ns.c_str());
+    // USE_MAX_WAIT bounds the handshake (about two minutes) instead of waiting on a wedged winmgmt forever
+    HRESULT hr = locator->ConnectServer(bstr_ns, nullptr, nullptr, nullptr, WBEM_FLAG_CONNECT_USE_MAX_WAIT,
+                                        nullptr, nullptr, out);
+    SysFreeString(bstr_ns);
+    if (FAILED(hr)) return hr;
+
+    CoSetProxyBlanket(*out, RPC_C_AUTHN_WINNT, RPC_C_AUTHZ_NONE, nullptr,
+                      RPC_C_AUTHN_LEVEL_CALL, RPC_C_IMP_LEVEL_IMPERSONATE, nullptr, EOAC_NONE);
+    return S_OK;
+}
+
+// Explicit credentials for a remote host. A proxy only inherits the identity it was created
+// with, so every proxy obtained through the session (the IEnumWbemClassObject of each query as
+// well) has the blanket applied again. The strings must outlive those proxies.
+class ProxySecurity {
+public:
+    // `user` as "DOMAIN\user" or "user@domain" (UPN, domain left empty); empty for the caller's token.
+    ProxySecurity(const std::wstring &user, const std::wstring &password, const std::wstring &authority)
+        : password_(password), authority_(authority), full_user_(user) {
+        const size_t slash = user.find(L'\\');
+        if (slash != std::wstring::npos) {
+            domain_ = user.substr(0, slash);
+            user_ = user.substr(slash + 1);
+        } else {
+            user_ = user;
+        }
+        identity_.User = reinterpret_cast<USHORT *>(user_.data());
+        identity_.UserLength = static_cast<ULONG>(user_.size());
+        identity_.Domain = reinterpret_cast<USHORT *>(domain_.data());
+        identity_.DomainLength = static_cast<ULONG>(domain_.size());
+        identity_.Password = reinterpret_cast<USHORT *>(password_.data());
+        identity_.PasswordLength = static_cast<ULONG>(password_.size());
+        identity_.Flags = SEC_WINNT_AUTH_IDENTITY_UNICODE;
+    }
+
+    ~ProxySecurity() { SecureZeroMemory(password_.data(), password_.size() * sizeof(wchar_t)); }
+
+    ProxySecurity(const ProxySecurity &) = delete;
+    ProxySecurity &operator=(const ProxySecurity &) = delete;
+
+    bool explicit_user() const { return !full_user_.empty(); }
+
+    // Arguments of ConnectServer; null when not given.
+    const wchar_t *user() const { return Optional(full_user_); }
+    const wchar_t *password() const { return explicit_user() ? Optional(password_) : nullptr; }
+    const wchar_t *authority() const { return Optional(authority_); }
+
+    // Packet privacy: hardened DCOM servers (KB5004442) refuse anything weaker from remote callers.
+    void Apply(IUnknown *proxy) const {
+        CoSetProxyBlanket(proxy, RPC_C_AUTHN_DEFAULT, RPC_C_AUTHZ_DEFAULT, COLE_DEFAULT_PRINCIPAL,
+                          RPC_C_AUTHN_LEVEL_PKT_PRIVACY, RPC_C_IMP_LEVEL_IMPERSONATE,
+                          explicit_user() ? const_cast<COAUTHIDENTITY *>(&identity_) : nullptr, EOAC_NONE);
+    }
+
+private:
+    static const wchar_t *Optional(const std::wstring &value) { return value.empty() ? nullptr : value.c_str(); }
+
+    std::wstring user_;
+    std::wstring domain_;
+    std::wstring password_;
+    std::wstring authority_;
+    std::wstring full_user_;
+    COAUTHIDENTITY identity_ = {};
+};
+
+HRESULT ConnectRemoteNamespace(IWbemLocator *locator, const std::wstring &path, const ProxySecurity &security,
+                               IWbemServices **out) {
+    DEVICE_INFO_STAGE("IWbemLocator::ConnectServer");
+    BSTR bstr_path = SysAllocString(path.c_str());
+    BSTR user = security.user() ? SysAllocString(security.user()) : nullptr;
+    BSTR password = security.password() ? SysAllocString(security.password()) : nullptr;
+    BSTR authority = security.authority() ? SysAllocString(security.authority()) : nullptr;
+    HRESULT hr = locator->ConnectServer(bstr_path, user, password, nullptr, WBEM_FLAG_CONNECT_USE_MAX_WAIT,
+                                        authority, nullptr, out);
+    if (password) {
+        SecureZeroMemory(password, SysStringByteLen(password));
+        SysFreeString(password);
+    }
+    SysFreeString(authority);
+    SysFreeString(user);
+    SysFreeString(bstr_path);
+    if (FAILED(hr)) return hr;
+
+    security.Apply(*out);
+    return S_OK;
+}
+
+// ---- Session pool ----
+
+using MtaUsageIncrementFn = HRESULT(WINAPI *)(void **cookie);
+using MtaUsageDecrementFn = HRESULT(WINAPI *)(void *cookie);
+
+class WmiSessionPool {
+public:
+    // Intentionally leaked: releasing COM proxies from a static destructor would run
+    // under the loader lock during DLL unload.
+    static WmiSessionPool &Instance() {
+        static auto *pool = new WmiSessionPool();
+        return *pool;
+    }
+
+    bool Enable() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (enabled_.load(std::memory_order_acquire)) return true;
+
+        // CoIncrementMTAUsage keeps the MTA (and every pooled proxy in it) alive even when
+        // no caller thread is currently initialized. Resolved at runtime, it is Windows 8+.
+        HMODULE ole32 = GetModuleHandleW(L"ole32.dll");
+        if (!ole32) return false;
+        auto increment = reinterpret_cast<MtaUsageIncrementFn>(GetProcAddress(ole32, "CoIncrementMTAUsage"));
+        decrement_ = reinterpret_cast<MtaUsageDecrementFn>(GetProcAddress(ole32, "CoDecrementMTAUsage"));
+        if (!increment || !decrement_ || FAILED(increment(&mta_cookie_)))
+            return false;
+
+        stats_ = {};
+        enabled_.store(true, std::memory_order_release);
+        return true;
+    }
+
+    void Shutdown() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!enabled_.load(std::memory_order_acquire)) return;
+        enabled_.store(false, std::memory_order_release);
+
+        RunInMta([this] {
+            for (auto &entry : sessions_)
+                entry.second->Release();
+            sessions_.clear();
+            if (locator_) {
+                locator_->Release();
+                locator_ = nullptr;
+            }
+        });
+
+        decrement_(mta_cookie_);
+        mta_cookie_ = nullptr;
+    }
+
+    bool Enabled() const { return enabled_.load(std::memory_order_acquire); }
+
+    // Returns an AddRef'd session for `ns`, connecting on first use. Caller must be in the MTA.
+    HRESULT Acquire(const std::wstring &ns, IWbemServices **out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!enabled_.load(std::memory_order_acquire)) return E_ABORT;
+        ++stats_.queries;
+
+        std::wstring key = NamespaceKey(ns);
+        auto it = sessions_.find(key);
+        if (it != sessions_.end()) {
+            ++stats_.reuse_hits;
+            it->second->AddRef();
+            *out = it->second;
+            return S_OK;
+        }
+
+        if (!locator_) {
+            HRESULT hr = CreateLocator(&locator_);
+            if (FAILED(hr)) return hr;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        IWbemServices *svc = nullptr;
+        HRESULT hr = ConnectNamespace(locator_, ns, &svc);
+        auto elapsed_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count());
+
+        if (FAILED(hr)) {
+            ++stats_.connect_failures;
+            return hr;
+        }
+
+        ++stats_.connects;
+        stats_.total_connect_us += elapsed_us;
+        if (elapsed_us > stats_.max_connect_us) stats_.max_connect_us = elapsed_us;
+
+        sessions_[key] = svc;
+        svc->AddRef();
+        *out = svc;
+        return S_OK;
+    }
+
+    // Drops a pooled session after an RPC/transport failure so the next Acquire reconnects.
+    void Evict(const std::wstring &ns, IWbemServices *svc) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = sessions_.find(NamespaceKey(ns));
+        if (it == sessions_.end() || it->second != svc) return;
+        it->second->Release();
+        sessions_.erase(it);
+        ++stats_.reconnects;
+    }
+
+    void Stats(WmiPoolStats *out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        *out = stats_;
+        out->open_sessions = static_cast<uint32_t>(sessions_.size());
+        out->enabled = enabled_.load(std::memory_order_acquire) ? 1 : 0;
+    }
+
+private:
+    WmiSessionPool() = default;
+
+    std::mutex mutex_;
+    std::atomic<bool> enabled_{false};
+    void *mta_cookie_ = nullptr;
+    MtaUsageDecrementFn decrement_ = nullptr;
+    IWbemLocator *locator_ = nullptr;
+    std::map<std::wstring, IWbemServices *> sessions_;
+    WmiPoolStats stats_{};
+};
+
+// Hands `fn` an IWbemServices for `ns`: a pooled one when the pool is enabled and the
+// caller is in the MTA, otherwise a private session that lives for this call only.
+template <typename Fn>
+HRESULT WithSession(const std::wstring &ns, bool in_mta, Fn &&fn) {
+    WmiSessionPool &pool = WmiSessionPool::Instance();
+
+    if (in_mta && pool.Enabled()) {
+        IWbemServices *svc = nullptr;
+        HRESULT hr = pool.Acquire(ns, &svc);
+        if (SUCCEEDED(hr)) {
+            hr = fn(svc);
+            if (IsDisconnected(hr)) {
+                // The provider host was restarted underneath us; reconnect once.
+                pool.Evict(ns, svc);
+                svc->Release();
+                svc = nullptr;
+                hr = pool.Acquire(ns, &svc);
+                if (SUCCEEDED(hr)) hr = fn(svc);
+            }
+            if (svc) svc->Release();
+            return hr;
+        }
+        if (hr != E_ABORT) return hr;
+        // Pool was shut down concurrently; fall back to a private session.
+    }
+
+    IWbemLocator *locator = nullptr;
+    HRESULT hr = CreateLocator(&locator);
+    if (FAILED(hr)) return hr;
+
+    IWbemServices *svc = nullptr;
+    hr = ConnectNamespace(locator, ns, &svc);
+    if (SUCCEEDED(hr)) {
+        hr = fn(svc);
+        svc->Release();
+    }
+    locator->Release();
+    return hr;
+}
+
+// ---- Query execution ----
+
+// Objects requested per IEnumWbemClassObject::Next round trip.
+constexpr ULONG kNextBatch = 64;
+
+// What a query returns when its deadline passed; the objects read until then are kept.
+const HRESULT kTimedOut = HRESULT_FROM_WIN32(ERROR_TIMEOUT);
+
+// Longest single wait of a cancellable query, so a cancel is noticed between Next() calls.
+constexpr long kCancelPollMs = 250;
+
+// Deadline of one query, `timeout_ms` from construction; 0 means none. With `cancelled`, the
+// deadline also passes as soon as that flag is set.
+class Deadline {
+public:
+    explicit Deadline(uint32_t timeout_ms, const std::atomic<bool> *cancelled = nullptr)
+        : infinite_(timeout_ms == 0), end_(std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms)),
+          cancelled_(cancelled) {}
+
+    bool infinite() const { return infinite_; }
+
+    // Milliseconds left, 0 once the deadline has passed. Meaningless without a deadline.
+    long LeftMs() const {
+        if (Cancelled()) return 0;
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(end_ - std::chrono::steady_clock::now());
+        return static_cast<long>(std::max<long long>(0, std::min<long long>(left.count(), 0x7FFFFFFF)));
+    }
+
+    // Timeout for the next Next() call: WBEM_INFINITE without a deadline, 0 once it has passed.
+    long RemainingMs() const {
+        if (Cancelled()) return 0;
+        if (!cancelled_) return infinite_ ? static_cast<long>(WBEM_INFINITE) : LeftMs();
+        return infinite_ ? kCancelPollMs : std::min(LeftMs(), kCancelPollMs);
+    }
+
+private:
+    bool Cancelled() const { return cancelled_ && cancelled_->load(std::memory_order_relaxed); }
+
+    bool infinite_;
+    std::chrono::steady_clock::time_point end_;
+    const std::atomic<bool> *cancelled_;
+};
+
+// Semisynchronous WQL query: hands every returned object to `fn`, fetching kNextBatch per round trip,
+// until the enumeration ends (S_OK), fails, or `deadline` passes (kTimedOut). `security` is the
+// identity `svc` was opened with, when it was opened with explicit credentials.
+template <typename Fn>
+HRESULT ForEachObject(IWbemServices *svc, const std::wstring &query, const Deadline &deadline, Fn &&fn,
+                      const ProxySecurity *security = nullptr) {
+    BSTR language = SysAllocString(L"WQL");
+    BSTR wql = SysAllocString(query.c_str());
+    IEnumWbemClassObject *enumerator = nullptr;
+    HRESULT hr;
+    {
+        DEVICE_INFO_STAGE("IWbemServices::ExecQuery");
+        hr = svc->ExecQuery(language, wql, WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY,
+                            nullptr, &enumerator);
+    }
+    SysFreeString(wql);
+    SysFreeString(language);
+    if (FAILED(hr)) return hr;
+    if (security) security->Apply(enumerator);
+
+    IWbemClassObject *objects[kNextBatch] = {};
+    while (true) {
+        const long wait_ms = deadline.RemainingMs();
+        if (wait_ms == 0) {
+            hr = kTimedOut;
+            break;
+        }
+
+        ULONG returned = 0;
+        {
+            DEVICE_INFO_STAGE("IEnumWbemClassObject::Next");
+            hr = enumerator->Next(wait_ms, kNextBatch, objects, &returned);
+        }
+        for (ULONG i = 0; i < returned; ++i) {
+            fn(objects[i]);
+            objects[i]->Release();
+        }
+        // WBEM_S_FALSE: fewer than requested because the enumeration is over. A full batch
+        // (WBEM_S_NO_ERROR) or an expired wait (WBEM_S_TIMEDOUT) goes round again.
+        if (FAILED(hr) || hr == WBEM_S_FALSE) break;
+    }
+
+    enumerator->Release();
+    return hr == WBEM_S_FALSE ? S_OK : hr;
+}
+
+void AppendObjectText(IWbemClassObject *obj, std::string &result) {
+    SAFEARRAY *names = nullptr;
+    if (FAILED(obj->GetNames(nullptr, WBEM_FLAG_NONSYSTEM_ONLY, nullptr, &names)) || !names)
+        return;
+
+    LONG lower = 0, upper = -1;
+    SafeArrayGetLBound(names, 1, &lower);
+    SafeArrayGetUBound(names, 1, &upper);
+
+    for (LONG i = lower; i <= upper; ++i) {
+        BSTR prop_name = nullptr;
+        if (FAILED(SafeArrayGetElement(names, &i, &prop_name)))
+            continue;
+
+        VARIANT value;
+        VariantInit(&value);
+        if (SUCCEEDED(obj->Get(prop_name, 0, &value, nullptr, nullptr))) {
+            WCHAR value_str[1024] = {};
+            VariantToString(value, value_str, 1024);
+
+            result += WideToUtf8(prop_name);
+            result += '=';
+            result += WideToUtf8(value_str);
+            result += '|';
+        }
+        VariantClear(&value);
+        SysFreeString(prop_name);
+    }
+
+    result += '\n';
+    SafeArrayDestroy(names);
+}
+
+HRESULT RunTextQuery(IWbemServices *svc, const std::wstring &query, const Deadline &deadline, std::string &result) {
+    return ForEachObject(svc, query, deadline, [&](IWbemClassObject *obj) { AppendObjectText(obj, result); });
+}
+
+// ---- Columnar results ----
+
+// Projection: only the requested columns of each object are read. Their IWbemObjectAccess
+// property handles are resolved once, from the first object, so a row costs one typed read per
+// column instead of a name lookup plus a VARIANT. A query returns objects of one class (or of
+// classes derived from it, which keep the handles of inherited properties). Columns without a
+// handle (arrays, embedded objects, properties the class lacks) and objects without
+// IWbemObjectAccess are read by name.
+class TableBuilder {
+public:
+    explicit TableBuilder(const std::vector<std::wstring> &columns) : columns_(columns), handles_(columns.size()) {}
+
+    // Keeps the resolved handles: a retry after a reconnect queries the same class.
+    void Reset() {
+        cells_.clear();
+        strings_.clear();
+        rows_ = 0;
+    }
+
+    void AppendRow(IWbemClassObject *obj) {
+        IWbemObjectAccess *access = nullptr;
+        if (FAILED(obj->QueryInterface(IID_IWbemObjectAccess, reinterpret_cast<void **>(&access))))
+            access = nullptr;
+        if (access && !handles_resolved_) ResolveHandles(access);
+
+        for (size_t c = 0; c < columns_.size(); ++c) {
+            WmiCell cell{};
+            if (!access || !ReadByHandle(access, handles_[c], cell)) ReadByName(obj, columns_[c], cell);
+            cells_.push_back(cell);
+        }
+        if (access) access->Release();
+        ++rows_;
+    }
+
+    uint32_t rows() const { return rows_; }
+    const WmiCell &cell(uint32_t row, size_t column) const { return cells_[row * columns_.size() + column]; }
+    const char *string(const WmiCell &cell) const { return strings_.data() + cell.value.offset; }
+
+    std::vector<uint8_t> Finish() const {
+        WmiTableHeader header{};
+        header.magic = WMI_TABLE_MAGIC;
+        header.version = WMI_TABLE_VERSION;
+        header.header_size = sizeof(WmiTableHeader);
+        header.cell_size = sizeof(WmiCell);
+        header.column_count = static_cast<uint32_t>(columns_.size());
+        header.row_count = rows_;
+        header.cells_offset = sizeof(WmiTableHeader);
+        header.strings_offset = header.cells_offset + cells_.size() * sizeof(WmiCell);
+        header.strings_size = strings_.size();
+        header.total_size = header.strings_offset + header.strings_size;
+
+        std::vector<uint8_t> blob(static_cast<size_t>(header.total_size));
+        std::memcpy(blob.data(), &header, sizeof(header));
+        if (!cells_.empty())
+            std::memcpy(blob.data() + header.cells_offset, cells_.data(), cells_.size() * sizeof(WmiCell));
+        if (!strings_.empty())
+            std::memcpy(blob.data() + header.strings_offset, strings_.data(), strings_.size());
+        return blob;
+    }
+
+private:
+    struct PropertyHandle {
+        long handle = 0;
+        CIMTYPE type = CIM_EMPTY;
+        bool valid = false;
+    };
+
+    void ResolveHandles(IWbemObjectAccess *access) {
+        for (size_t c = 0; c < columns_.size(); ++c) {
+            PropertyHandle &h = handles_[c];
+            h.valid = SUCCEEDED(access->GetPropertyHandle(columns_[c].c_str(), &h.type, &h.handle)) &&
+                      HasTypedRead(h.type);
+        }
+        handles_resolved_ = true;
+    }
+
+    static bool HasTypedRead(CIMTYPE type) {
+        switch (type) {
+            case CIM_SINT8: case CIM_UINT8: case CIM_SINT16: case CIM_UINT16:
+            case CIM_SINT32: case CIM_UINT32: case CIM_SINT64: case CIM_UINT64:
+            case CIM_REAL32: case CIM_REAL64: case CIM_BOOLEAN:
+            case CIM_STRING: case CIM_DATETIME: case CIM_REFERENCE:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // False if the read failed and the column should be read by name instead.
+    bool ReadByHandle(IWbemObjectAccess *access, const PropertyHandle &h, WmiCell &cell) {
+        if (!h.valid) return false;
+
+        if (h.type == CIM_STRING || h.type == CIM_DATETIME || h.type == CIM_REFERENCE) {
+            long bytes = 0;
+            HRESULT hr = access->ReadPropertyValue(h.handle, static_cast<long>(text_.size() * sizeof(wchar_t)),
+                                                   &bytes, reinterpret_cast<byte *>(text_.data()));
+            if (hr == static_cast<HRESULT>(WBEM_E_BUFFER_TOO_SMALL)) {
+                text_.resize(static_cast<size_t>(bytes) / sizeof(wchar_t) + 1);
+                hr = access->ReadPropertyValue(h.handle, static_cast<long>(text_.size() * sizeof(wchar_t)),
+                                               &bytes, reinterpret_cast<byte *>(text_.data()));
+            }
+            if (FAILED(hr)) return false;
+            if (hr == WBEM_S_FALSE || bytes == 0) return true;  // NULL
+            text_[std::min(static_cast<size_t>(bytes) / sizeof(wchar_t), text_.size() - 1)] = L'\0';
+            AddString(WideToUtf8(text_.data()), cell);
+            return true;
+        }
+
+        uint8_t raw[8] = {};
+        long bytes = 0;
+        const HRESULT hr = access->ReadPropertyValue(h.handle, sizeof(raw), &bytes, raw);
+        if (FAILED(hr)) return false;
+        if (hr == WBEM_S_FALSE || bytes == 0) return true;  // NULL
+
+        auto read = [&raw](auto value) {
+            std::memcpy(&value, raw, sizeof(value));
+            return value;
+        };
+        switch (h.type) {
+            case CIM_SINT8: cell.type = WMI_CELL_INT; cell.value.i64 = read(int8_t{}); break;
+            case CIM_SINT16: cell.type = WMI_CELL_INT; cell.value.i64 = read(int16_t{}); break;
+            case CIM_SINT32: cell.type = WMI_CELL_INT; cell.value.i64 = read(int32_t{}); break;
+            case CIM_SINT64: cell.type = WMI_CELL_INT; cell.value.i64 = read(int64_t{}); break;
+            case CIM_UINT8: cell.type = WMI_CELL_UINT; cell.value.u64 = read(uint8_t{}); break;
+            case CIM_UINT16: cell.type = WMI_CELL_UINT; cell.value.u64 = read(uint16_t{}); break;
+            case CIM_UINT32: cell.type = WMI_CELL_UINT; cell.value.u64 = read(uint32_t{}); break;
+            case CIM_UINT64: cell.type = WMI_CELL_UINT; cell.value.u64 = read(uint64_t{}); break;
+            case CIM_REAL32: cell.type = WMI_CELL_REAL; cell.value.f64 = read(float{}); break;
+            case CIM_REAL64: cell.type = WMI_CELL_REAL; cell.value.f64 = read(double{}); break;
+            case CIM_BOOLEAN: cell.type = WMI_CELL_BOOL; cell.value.u64 = read(uint16_t{}) != 0 ? 1 : 0; break;
+            default: return false;
+        }
+        return true;
+    }
+
+    void ReadByName(IWbemClassObject *obj, const std::wstring &column, WmiCell &cell) {
+        VARIANT value;
+        VariantInit(&value);
+        CIMTYPE cim_type = CIM_EMPTY;
+        if (SUCCEEDED(obj->Get(column.c_str(), 0, &value, &cim_type, nullptr)))
+            FillCell(value, cim_type, cell);
+        VariantClear(&value);
+    }
+
+    void FillCell(const VARIANT &value, CIMTYPE cim_type, WmiCell &cell) {
+        if (value.vt == VT_EMPTY || value.vt == VT_NULL) return;
+
+        if (!(cim_type & CIM_FLAG_ARRAY)) {
+            switch (cim_type) {
+                case CIM_SINT8:
+                case CIM_SINT16:
+                case CIM_SINT32:
+                case CIM_SINT64:
+                    if (ReadSigned(value, cell.value.i64)) {
+                        cell.type = WMI_CELL_INT;
+                        return;
+                    }
+                    break;
+                case CIM_UINT8:
+                case CIM_UINT16:
+                case CIM_UINT32:
+                case CIM_UINT64:
+                    if (ReadUnsigned(value, cell.value.u64)) {
+                        cell.type = WMI_CELL_UINT;
+                        return;
+                    }
+                    break;
+                case CIM_REAL32:
+                case CIM_REAL64:
+                    cell.type = WMI_CELL_REAL;
+                    cell.value.f64 = value.vt == VT_R4 ? value.fltVal : value.dblVal;
+                    return;
+                case CIM_BOOLEAN:
+                    cell.type = WMI_CELL_BOOL;
+                    cell.value.u64 = value.boolVal != VARIANT_FALSE ? 1 : 0;
+                    return;
+                default:
+                    break;
+            }
+        }
+
+        if (value.vt == VT_BSTR) {
+            AddString(WideToUtf8(value.bstrVal), cell);
+            return;
+        }
+
+        // Arrays, embedded objects etc. - no inline form, keep their display text.
+        PWSTR text = nullptr;
+        if (SUCCEEDED(VariantToStringAlloc(value, &text)) && text) {
+            AddString(WideToUtf8(text), cell);
+            CoTaskMemFree(text);
+        }
+    }
+
+    // WMI packs CIM integers into whatever VARIANT fits (uint32 arrives as VT_I4, 64-bit as VT_BSTR).
+    static bool ReadSigned(const VARIANT &value, int64_t &out) {
+        switch (value.vt) {
+            case VT_I1: out = value.cVal; return true;
+            case VT_UI1: out = value.bVal; return true;
+            case VT_I2: out = value.iVal; return true;
+            case VT_I4: out = value.lVal; return true;
+            case VT_I8: out = value.llVal; return true;
+            case VT_BSTR: return ParseSigned(value.bstrVal, out);
+            default: return false;
+        }
+    }
+
+    static bool ReadUnsigned(const VARIANT &value, uint64_t &out) {
+        switch (value.vt) {
+            case VT_UI1: out = value.bVal; return true;
+            case VT_I2: out = static_cast<uint16_t>(value.iVal); return true;
+            case VT_UI2: out = value.uiVal; return true;
+            case VT_I4: out = static_cast<uint32_t>(value.lVal); return true;
+            case VT_UI4: out = value.ulVal; return true;
+            case VT_I8: out = static_cast<uint64_t>(value.llVal); return true;
+            case VT_UI8: out = value.ullVal; return true;
+            case VT_BSTR: return ParseUnsigned(value.bstrVal, out);
+            default: return false;
+        }
+    }
+
+    static bool ParseSigned(const wchar_t *text, int64_t &out) {
+        if (!text || !*text) return false;
+        wchar_t *end = nullptr;
+        errno = 0;
+        out = wcstoll(text, &end, 10);
+        return errno == 0 && *end == L'\0';
+    }
+
+    static bool ParseUnsigned(const wchar_t *text, uint64_t &out) {
+        if (!text || !*text) return false;
+        wchar_t *end = nullptr;
+        errno = 0;
+        out = wcstoull(text, &end, 10);
+        return errno == 0 && *end == L'\0';
+    }
+
+    void AddString(const std::string &text, WmiCell &cell) {
+        cell.type = WMI_CELL_STRING;
+        cell.length = static_cast<uint32_t>(text.size());
+        cell.value.offset = strings_.size();
+        strings_ += text;
+        strings_ += '\0';
+    }
+
+    const std::vector<std::wstring> &columns_;
+    std::vector<PropertyHandle> handles_;
+    bool handles_resolved_ = false;
+    std::vector<wchar_t> text_ = std::vector<wchar_t>(256);  // string reads, reused across rows
+    std::vector<WmiCell> cells_;
+    std::string strings_;
+    uint32_t rows_ = 0;
+};
+
+// One "Name=Value|Name=Value|...\n" line per row of `builder`, in column order. NULL cells are left out.
+void AppendTableText(const TableBuilder &builder, const std::vector<std::string> &names, std::string &result) {
+    for (uint32_t row = 0; row < builder.rows(); ++row) {
+        for (size_t c = 0; c < names.size(); ++c) {
+            const WmiCell &cell = builder.cell(row, c);
+            char number[32];
+            const char *text = number;
+            switch (cell.type) {
+                case WMI_CELL_INT: snprintf(number, sizeof(number), "%lld", static_cast<long long>(cell.value.i64)); break;
+                case WMI_CELL_UINT: snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(cell.value.u64)); break;
+                case WMI_CELL_REAL: snprintf(number, sizeof(number), "%.17g", cell.value.f64); break;
+                case WMI_CELL_BOOL: text = cell.value.u64 ? "True" : "False"; break;
+                case WMI_CELL_STRING: text = builder.string(cell); break;
+                default: continue;
+            }
+            result += names[c];
+            result += '=';
+            result += text;
+            result += '|';
+        }
+        result += '\n';
+    }
+}
+
+HRESULT RunTableQuery(IWbemServices *svc, const std::wstring &query, const Deadline &deadline,
+                      TableBuilder &builder, const ProxySecurity *security = nullptr) {
+    return ForEachObject(svc, query, deadline, [&](IWbemClassObject *obj) { builder.AppendRow(obj); }, security);
+}
+
+// Replay key of a query: "namespace\nquery", then one line per column.
+std::string ReplayKey(const char *cim_namespace, const char *query, const char *const *columns, int column_count) {
+    std::string key = (cim_namespace && *cim_namespace) ? cim_namespace : "ROOT\\CIMV2";
+    key += '\n';
+    key += query;
+    for (int i = 0; i < column_count; ++i) {
+        key += '\n';
+        key += columns[i];
+    }
+    return key;
+}
+
+// Copies `text` into the caller's buffer, truncated like a live answer.
+void CopyText(const std::string &text, char *out, int max_len) {
+    size_t copy = std::min(text.size(), static_cast<size_t>(max_len - 1));
+    std::memcpy(out, text.data(), copy);
+    out[copy] = '\0';
+}
+
+} // namespace
+
+struct WmiTable {
+    std::vector<uint8_t> blob;
+};
+
+struct WmiQuery {
+    std::string query;
+    std::string cim_namespace;
+    std::vector<std::string> columns;
+    uint32_t timeout_ms = 0;
+    WmiQueryCallback callback = nullptr;
+    void *context = nullptr;
+
+    std::mutex mutex;
+    std::condition_variable finished_cv;
+    bool finished = false;
+    int status = WMI_STATUS_FAILURE;
+    WmiTable *table = nullptr;  // owned until wmi_query_take_table()
+    std::thread worker;
+};
+
+// ---- Public API ----
+
+extern "C" int wmi_session_pool_enable(void) {
+    return WmiSessionPool::Instance().Enable() ? WMI_STATUS_OK : WMI_STATUS_FAILURE;
+}
+
+extern "C" void wmi_session_pool_shutdown(void) {
+    WmiSessionPool::Instance().Shutdown();
+}
+
+extern "C" int wmi_session_pool_get_stats(WmiPoolStats *out) {
+    if (!out) return WMI_STATUS_INVALID_ARG;
+    WmiSessionPool::Instance().Stats(out);
+    return WMI_STATUS_OK;
+}
+
+extern "C" int get_wmi_info(const char *query, const char *cim_namespace, char *out, int max_len) {
+    return get_wmi_info_timeout(query, cim_namespace, out, max_len, 0);
+}
+
+extern "C" int get_wmi_info_timeout(const char *query, const char *cim_namespace, char *out, int max_len,
+                                    uint32_t timeout_ms) {
+    if (!query || !*query || !out || max_len <= 0) return WMI_STATUS_INVALID_ARG;
+    out[0] = '\0';
+
+    std::string replay_key;
+    if (replay::Active()) {
+        replay_key = ReplayKey(cim_namespace, query, nullptr, 0);
+        std::string recorded;
+        if (replay::Replaying()) {
+            if (!replay::Lookup(DEVICE_REPLAY_WMI_TEXT, replay_key, recorded)) return WMI_STATUS_FAILURE;
+            CopyText(recorded, out, max_len);
+            return WMI_STATUS_OK;
+        }
+    }
+
+    const Deadline deadline(timeout_ms);
+    std::wstring ns = (cim_namespace && *cim_namespace) ? Utf8ToWide(cim_namespace) : L"ROOT\\CIMV2";
+    std::wstring wquery = Utf8ToWide(query);
+
+    ComApartment apt;
+    if (!apt.usable()) return WMI_STATUS_FAILURE;
+    EnsureProcessSecurity();
+
+    std::string result;
+    HRESULT hr = WithSession(ns, apt.in_mta(), [&](IWbemServices *svc) {
+        result.clear();
+        return RunTextQuery(svc, wquery, deadline, result);
+    });
+
+    if (FAILED(hr) && hr != kTimedOut && result.empty()) return WMI_STATUS_FAILURE;
+    if (hr == S_OK && !replay_key.empty()) replay::Record(DEVICE_REPLAY_WMI_TEXT, replay_key, result);
+
+    CopyText(result, out, max_len);
+    return hr == kTimedOut ? WMI_STATUS_TIMED_OUT : WMI_STATUS_OK;
+}
+
+extern "C" int get_wmi_info_columns(const char *query, const char *cim_namespace, const char *const *columns,
+                                    int column_count, char *out, int max_len, uint32_t timeout_ms) {
+    if (!query || !*query || !columns || column_count <= 0 || !out || max_len <= 0) return WMI_STATUS_INVALID_ARG;
+    out[0] = '\0';
+
+    const Deadline deadline(timeout_ms);
+    std::vector<std::string> names;
+    std::vector<std::wstring> wcolumns;
+    names.reserve(column_count);
+    wcolumns.reserve(column_count);
+    for (int i = 0; i < column_count; ++i) {
+        if (!columns[i] || !*columns[i]) return WMI_STATUS_INVALID_ARG;
+        names.emplace_back(columns[i]);
+        wcolumns.push_back(Utf8ToWide(columns[i]));
+    }
+
+    std::string replay_key;
+    if (replay::Active()) {
+        replay_key = ReplayKey(cim_namespace, query, columns, column_count);
+        std::string recorded;
+        if (replay::Replaying()) {
+            if (!replay::Lookup(DEVICE_REPLAY_WMI_COLUMNS, replay_key, recorded)) return WMI_STATUS_FAILURE;
+            CopyText(recorded, out, max_len);
+            return WMI_STATUS_OK;
+        }
+    }
+
+    std::wstring ns = (cim_namespace && *cim_namespace) ? Utf8ToWide(cim_namespace) : L"ROOT\\CIMV2";
+    std::wstring wquery = Utf8ToWide(query);
+
+    ComApartment apt;
+    if (!apt.usable()) return WMI_STATUS_FAILURE;
+    EnsureProcessSecurity();
+
+    TableBuilder builder(wcolumns);
+    HRESULT hr = WithSession(ns, apt.in_mta(), [&](IWbemServices *svc) {
+        builder.Reset();
+        return RunTableQuery(svc, wquery, deadline, builder);
+    });
+    if (FAILED(hr) && hr != kTimedOut && builder.rows() == 0) return WMI_STATUS_FAILURE;
+
+    std::string result;
+    AppendTableText(builder, names, result);
+    if (hr == S_OK && !replay_key.empty()) replay::Record(DEVICE_REPLAY_WMI_COLUMNS, replay_key, result);
+
+    CopyText(result, out, max_len);
+    return hr == kTimedOut ? WMI_STATUS_TIMED_OUT : WMI_STATUS_OK;
+}
+
+extern "C" int wmi_query_table(const char *query, const char *cim_namespace,
+                               const char *const *columns, int column_count, WmiTable **out) {
+    return wmi_query_table_timeout(query, cim_namespace, columns, column_count, 0, out);
+}
+
+extern "C" int wmi_query_table_timeout(const char *query, const char *cim_namespace, const char *const *columns,
+                                       int column_count, uint32_t timeout_ms, WmiTable **out) {
+    if (!query || !*query || !columns || column_count <= 0 || !out) return WMI_STATUS_INVALID_ARG;
+    *out = nullptr;
+
+    const Deadline deadline(timeout_ms);
+    std::vector<std::wstring> wcolumns;
+    wcolumns.reserve(column_count);
+    for (int i = 0; i < column_count; ++i) {
+        if (!columns[i] || !*columns[i]) return WMI_STATUS_INVALID_ARG;
+        wcolumns.push_back(Utf8ToWide(columns[i]));
+    }
+
+    std::string replay_key;
+    if (replay::Active()) {
+        replay_key = ReplayKey(cim_namespace, query, columns, column_count);
+        std::string recorded;
+        if (replay::Replaying()) {
+            if (!replay::Lookup(DEVICE_REPLAY_WMI_TABLE, replay_key, recorded)) return WMI_STATUS_FAILURE;
+            auto *table = new (std::nothrow) WmiTable();
+            if (!table) return WMI_STATUS_FAILURE;
+            table->blob.assign(recorded.begin(), recorded.end());
+            *out = table;
+            return WMI_STATUS_OK;
+        }
+    }
+
+    std::wstring ns = (cim_namespace && *cim_namespace) ? Utf8ToWide(cim_namespace) : L"ROOT\\CIMV2";
+    std::wstring wquery = Utf8ToWide(query);
+
+    ComApartment apt;
+    if (!apt.usable()) return WMI_STATUS_FAILURE;
+    EnsureProcessSecurity();
+
+    TableBuilder builder(wcolumns);
+    HRESULT hr = WithSession(ns, apt.in_mta(), [&](IWbemServices *svc) {
+        builder.Reset();
+        return RunTableQuery(svc, wquery, deadline, builder);
+    });
+    if (FAILED(hr) && hr != kTimedOut) return WMI_STATUS_FAILURE;
+
+    auto *table = new (std::nothrow) WmiTable();
+    if (!table) return WMI_STATUS_FAILURE;
+    table->blob = builder.Finish();
+    // A timed-out table is partial; replaying it would pass it off as the whole answer
+    if (hr == S_OK && !replay_key.empty())
+        replay::Record(DEVICE_REPLAY_WMI_TABLE, replay_key,
+                       std::string_view(reinterpret_cast<const char *>(table->blob.data()), table->blob.size()));
+    *out = table;
+    return hr == kTimedOut ? WMI_STATUS_TIMED_OUT : WMI_STATUS_OK;
+}
+
+extern "C" uint64_t wmi_table_size(const WmiTable *table) {
+    return table ? table->blob.size() : 0;
+}
+
+extern "C" int wmi_table_copy(const WmiTable *table, void *out, uint64_t out_size) {
+    if (!table || !out) return WMI_STATUS_INVALID_ARG;
+    if (out_size < table->blob.size()) return WMI_STATUS_BUFFER_TOO_SMALL;
+    std::memcpy(out, table->blob.data(), table->blob.size());
+    return WMI_STATUS_OK;
+}
+
+extern "C" void wmi_table_free(WmiTable *table) {
+    delete table;
+}
+
+// ---- Asynchronous queries ----
+
+namespace {
+
+void RunQueryAsync(WmiQuery *q) {
+    // Wait until wmi_query_table_async() has stored `worker`, which wmi_query_free() may read from the callback
+    { std::lock_guard<std::mutex> lock(q->mutex); }
+
+    std::vector<const char *> columns;
+    columns.reserve(q->columns.size());
+    for (const auto &column : q->columns) columns.push_back(column.c_str());
+
+    // wmi_query_table_timeout() joins this thread to the MTA, so pooled sessions are used as well
+    WmiTable *table = nullptr;
+    const int status = wmi_query_table_timeout(q->query.c_str(), q->cim_namespace.c_str(), columns.data(),
+                                               static_cast<int>(columns.size()), q->timeout_ms, &table);
+    {
+        std::lock_guard<std::mutex> lock(q->mutex);
+        q->status = status;
+        q->table = table;
+        q->finished = true;
+    }
+    q->finished_cv.notify_all();
+    if (q->callback) q->callback(q, q->context);
+}
+
+} // namespace
+
+extern "C" int wmi_query_table_async(const char *query, const char *cim_namespace, const char *const *columns,
+                                     int column_count, uint32_t timeout_ms, WmiQueryCallback callback,
+                                     void *context, WmiQuery **out) {
+    if (!query || !*query || !columns || column_count <= 0 || !out) return WMI_STATUS_INVALID_ARG;
+    *out = nullptr;
+
+    auto *q = new (std::nothrow) WmiQuery();
+    if (!q) return WMI_STATUS_FAILURE;
+    try {
+        q->query = query;
+        q->cim_namespace = cim_namespace ? cim_namespace : "";
+        for (int i = 0; i < column_count; ++i) {
+            if (!columns[i] || !*columns[i]) {
+                delete q;
+                return WMI_STATUS_INVALID_ARG;
+            }
+            q->columns.emplace_back(columns[i]);
+        }
+        q->timeout_ms = timeout_ms;
+        q->callback = callback;
+        q->context = context;
+        std::lock_guard<std::mutex> lock(q->mutex);
+        q->worker = std::thread(RunQueryAsync, q);
+    } catch (const std::exception &) {
+        delete q;
+        return WMI_STATUS_FAILURE;
+    }
+
+    *out = q;
+    return WMI_STATUS_OK;
+}
+
+extern "C" int wmi_query_wait(WmiQuery *query, uint32_t wait_ms) {
+    if (!query) return WMI_STATUS_INVALID_ARG;
+    std::unique_lock<std::mutex> lock(query->mutex);
+    if (wait_ms == WMI_WAIT_INFINITE) {
+        query->finished_cv.wait(lock, [query] { return query->finished; });
+        return WMI_STATUS_OK;
+    }
+    const bool finished = query->finished_cv.wait_for(lock, std::chrono::milliseconds(wait_ms),
+                                                      [query] { return query->finished; });
+    return finished ? WMI_STATUS_OK : WMI_STATUS_TIMED_OUT;
+}
+
+extern "C" int wmi_query_take_table(WmiQuery *query, int *status, WmiTable **out) {
+    if (!query || !status || !out) return WMI_STATUS_INVALID_ARG;
+    std::lock_guard<std::mutex> lock(query->mutex);
+    if (!query->finished) return WMI_STATUS_INVALID_ARG;
+    *status = query->status;
+    *out = query->table;
+    query->table = nullptr;
+    return WMI_STATUS_OK;
+}
+
+extern "C" void wmi_query_free(WmiQuery *query) {
+    if (!query) return;
+    if (query->worker.joinable()) {
+        // Freed from its own callback: the worker finishes on its own once the callback returns.
+        if (query->worker.get_id() == std::this_thread::get_id()) query->worker.detach();
+        else query->worker.join();
+    }
+    wmi_table_free(query->table);
+    delete query;
+}
+
+// ---- Fleet collection ----
+
+struct WmiFleet {
+    struct Host {
+        std::wstring name;  // empty for the local machine
+        std::wstring user;
+        std::wstring password;
+        std::wstring authority;
+    };
+    struct Query {
+        std::wstring text;
+        std::wstring cim_namespace;
+        std::vector<std::wstring> columns;
+    };
+    struct Finished {
+        WmiFleetResult result;
+        WmiTable *table;
+    };
+
+    std::vector<Host> hosts;
+    std::vector<Query> queries;
+    uint32_t host_timeout_ms = 0;
+
+    std::atomic<bool> cancelled{false};
+    std::atomic<size_t> next_host{0};
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable ready_cv;
+    std::deque<Finished> ready;
+    size_t handed_out = 0;
+
+    ~WmiFleet() {
+        for (Finished &finished : ready) wmi_table_free(finished.table);
+    }
+
+    void Push(const WmiFleetResult &result, WmiTable *table) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ready.push_back({result, table});
+        }
+        ready_cv.notify_all();
+    }
+};
+
+namespace {
+
+// Path of `cim_namespace` on `host`, e.g. \\srv01\ROOT\CIMV2; the namespace itself for the local machine.
+std::wstring RemotePath(const std::wstring &host, const std::wstring &cim_namespace) {
+    if (host.empty() || cim_namespace.rfind(L"\\\\", 0) == 0) return cim_namespace;
+    return L"\\\\" + host + L"\\" + cim_namespace;
+}
+
+// TCP connect to the RPC endpoint mapper (port 135) within `deadline`. ConnectServer to a host
+// that is down waits for WMI's own limit (about two minutes) and cannot be interrupted, so an
+// unreachable host is told apart up front. S_OK if a connection was accepted.
+HRESULT ProbeRpcEndpoint(const std::wstring &host, const Deadline &deadline) {
+    static std::once_flag once;
+    static bool started = false;
+    std::call_once(once, [] {
+        WSADATA data;
+        started = WSAStartup(MAKEWORD(2, 2), &data) == 0;  // never cleaned up, like the other process-wide state
+    });
+    if (!started) return HRESULT_FROM_WIN32(WSANOTINITIALISED);
+
+    ADDRINFOW hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+    ADDRINFOW *addresses = nullptr;
+    if (GetAddrInfoW(host.c_str(), L"135", &hints, &addresses) != 0) return HRESULT_FROM_WIN32(WSAGetLastError());
+
+    HRESULT hr = HRESULT_FROM_WIN32(WSAEHOSTUNREACH);
+    for (ADDRINFOW *address = addresses; address; address = address->ai_next) {
+        SOCKET sock = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (sock == INVALID_SOCKET) continue;
+
+        u_long nonblocking = 1;
+        ioctlsocket(sock, FIONBIO, &nonblocking);
+        if (connect(sock, address->ai_addr, static_cast<int>(address->ai_addrlen)) == 0) {
+            closesocket(sock);
+            hr = S_OK;
+            break;
+        }
+        if (WSAGetLastError() != WSAEWOULDBLOCK) {
+            hr = HRESULT_FROM_WIN32(WSAGetLastError());
+            closesocket(sock);
+            continue;
+        }
+
+        fd_set writable, failed;
+        FD_ZERO(&writable);
+        FD_ZERO(&failed);
+        FD_SET(sock, &writable);
+        FD_SET(sock, &failed);
+        const long wait_ms = deadline.LeftMs();
+        timeval timeout = {wait_ms / 1000, (wait_ms % 1000) * 1000};
+        const int ready = select(0, nullptr, &writable, &failed, &timeout);
+        const bool accepted = ready > 0 && FD_ISSET(sock, &writable);
+        closesocket(sock);
+        if (accepted) {
+            hr = S_OK;
+            break;
+        }
+        if (ready == 0) {
+            hr = kTimedOut;  // the deadline is spent; another address would not get any time
+            break;
+        }
+        hr = HRESULT_FROM_WIN32(WSAECONNREFUSED);
+    }
+    FreeAddrInfoW(addresses);
+    return hr;
+}
+
+int FleetStatus(HRESULT hr) {
+    if (hr == kTimedOut) return WMI_STATUS_TIMED_OUT;
+    return SUCCEEDED(hr) ? WMI_STATUS_OK : WMI_STATUS_FAILURE;
+}
+
+// Runs every query of `fleet` against host `index`, one session per namespace for all of them.
+void CollectHost(WmiFleet &fleet, uint32_t index, IWbemLocator *locator, HRESULT locator_hr) {
+    const WmiFleet::Host &host = fleet.hosts[index];
+    const Deadline deadline(fleet.host_timeout_ms, &fleet.cancelled);
+    const ProxySecurity security(host.user, host.password, host.authority);
+
+    // The local machine with the caller's token goes the way of every other query here
+    const bool remote = !host.name.empty() || security.explicit_user();
+
+    HRESULT host_hr = locator ? S_OK : locator_hr;
+    if (SUCCEEDED(host_hr) && fleet.cancelled.load())
+        host_hr = E_ABORT;  // not started before the fleet was cancelled
+    else if (SUCCEEDED(host_hr) && !host.name.empty() && !deadline.infinite())
+        host_hr = ProbeRpcEndpoint(host.name, deadline);
+
+    std::map<std::wstring, IWbemServices *> sessions;
+    std::map<std::wstring, HRESULT> failed;
+    for (uint32_t q = 0; q < fleet.queries.size(); ++q) {
+        const WmiFleet::Query &query = fleet.queries[q];
+        HRESULT hr = host_hr;
+
+        IWbemServices *svc = nullptr;
+        const std::wstring path = RemotePath(host.name, query.cim_namespace);
+        const std::wstring key = NamespaceKey(path);
+        if (SUCCEEDED(hr)) {
+            if (auto it = sessions.find(key); it != sessions.end()) {
+                svc = it->second;
+            } else if (auto it = failed.find(key); it != failed.end()) {
+                hr = it->second;
+            } else if (deadline.RemainingMs() == 0) {
+                hr = kTimedOut;
+            } else {
+                hr = remote ? ConnectRemoteNamespace(locator, path, security, &svc)
+                            : ConnectNamespace(locator, path, &svc);
+                if (SUCCEEDED(hr)) sessions[key] = svc;
+                else failed[key] = hr;
+            }
+        }
+
+        WmiTable *table = nullptr;
+        if (svc) {
+            TableBuilder builder(query.columns);
+            hr = RunTableQuery(svc, query.text, deadline, builder, remote ? &security : nullptr);
+            if ((SUCCEEDED(hr) || hr == kTimedOut) && (table = new (std::nothrow) WmiTable()))
+                table->blob = builder.Finish();
+        }
+
+        fleet.Push({index, q, FleetStatus(hr), SUCCEEDED(hr) ? S_OK : static_cast<int32_t>(hr)}, table);
+    }
+
+    for (auto &entry : sessions) entry.second->Release();
+}
+
+void RunFleetWorker(WmiFleet *fleet) {
+    // A thread of its own: always joins the MTA
+    ComApartment apt;
+    IWbemLocator *locator = nullptr;
+    HRESULT locator_hr = CO_E_NOTINITIALIZED;
+    if (apt.usable()) {
+        EnsureProcessSecurity();
+        locator_hr = CreateLocator(&locator);
+    }
+
+    for (size_t index = fleet->next_host.fetch_add(1); index < fleet->hosts.size();
+         index = fleet->next_host.fetch_add(1))
+        CollectHost(*fleet, static_cast<uint32_t>(index), locator, locator_hr);
+
+    if (locator) locator->Release();
+}
+
+} // namespace
+
+extern "C" int wmi_fleet_start(const WmiFleetHost *hosts, int host_count, const WmiFleetQuery *queries,
+                               int query_count, int max_concurrency, uint32_t host_timeout_ms, WmiFleet **out) {
+    if (!hosts || host_count <= 0 || !queries || query_count <= 0 || max_concurrency <= 0 || !out)
+        return WMI_STATUS_INVALID_ARG;
+    *out = nullptr;
+
+    auto *fleet = new (std::nothrow) WmiFleet();
+    if (!fleet) return WMI_STATUS_FAILURE;
+    try {
+        for (int h = 0; h < host_count; ++h) {
+            const WmiFleetHost &host = hosts[h];
+            auto text = [](const char *value) { return value && *value ? Utf8ToWide(value) : std::wstring(); };
+            fleet->hosts.push_back({text(host.host), text(host.user), text(host.password), text(host.authority)});
+        }
+        for (int q = 0; q < query_count; ++q) {
+            const WmiFleetQuery &query = queries[q];
+            if (!query.query || !*query.query || !query.columns || query.column_count <= 0) {
+                delete fleet;
+                return WMI_STATUS_INVALID_ARG;
+            }
+            WmiFleet::Query copy;
+            copy.text = Utf8ToWide(query.query);
+            copy.cim_namespace = query.cim_namespace && *query.cim_namespace ? Utf8ToWide(query.cim_namespace)
+                                                                             : L"ROOT\\CIMV2";
+            for (int c = 0; c < query.column_count; ++c) {
+                if (!query.columns[c] || !*query.columns[c]) {
+                    delete fleet;
+                    return WMI_STATUS_INVALID_ARG;
+                }
+                copy.columns.push_back(Utf8ToWide(query.columns[c]));
+            }
+            fleet->queries.push_back(std::move(copy));
+        }
+        fleet->host_timeout_ms = host_timeout_ms;
+
+        const int workers = std::min(max_concurrency, host_count);
+        for (int i = 0; i < workers; ++i) fleet->workers.emplace_back(RunFleetWorker, fleet);
+    } catch (const std::exception &) {
+        wmi_fleet_free(fleet);
+        return WMI_STATUS_FAILURE;
+    }
+
+    *out = fleet;
+    return WMI_STATUS_OK;
+}
+
+extern "C" int wmi_fleet_next(WmiFleet *fleet, uint32_t wait_ms, WmiFleetResult *result, WmiTable **table) {
+    if (!fleet || !result || !table) return WMI_STATUS_INVALID_ARG;
+    *table = nullptr;
+
+    std::unique_lock<std::mutex> lock(fleet->mutex);
+    if (fleet->handed_out == fleet->hosts.size() * fleet->queries.size()) return WMI_STATUS_NO_MORE;
+
+    auto has_result = [fleet] { return !fleet->ready.empty(); };
+    if (wait_ms == WMI_WAIT_INFINITE) fleet->ready_cv.wait(lock, has_result);
+    else if (!fleet->ready_cv.wait_for(lock, std::chrono::milliseconds(wait_ms), has_result))
+        return WMI_STATUS_TIMED_OUT;
+
+    WmiFleet::Finished finished = fleet->ready.front();
+    fleet->ready.pop_front();
+    ++fleet->handed_out;
+    *result = finished.result;
+    *table = finished.table;
+    return WMI_STATUS_OK;
+}
+
+extern "C" void wmi_fleet_cancel(WmiFleet *fleet) {
+    if (fleet) fleet->cancelled.store(true);
+}
+
+extern "C" void wmi_fleet_free(WmiFleet *fleet) {
+    if (!fleet) return;
+    fleet->cancelled.store(true);
+    for (std::thread &worker : fleet->workers)
+        if (worker.joinable()) worker.join();
+    delete fleet;
+}
@@ -1,7 +1,28 @@
 from typing import List, Optional
 
 from hwprobe.models.component_model import ComponentInfo
-from pydantic import Field
+from hwprobe.models.size_models import StorageSize
+from pydantic import BaseModel, Field
+
+
+class CPUCacheInfo(BaseModel):
+    #: 1 for L1, 2 for L2, etc.
+    level: int
+
+    #: ``Data``, ``Instruction`` or ``Unified``
+    type: str
+
+    #: Size of one instance of the cache
+    size: Optional[StorageSize] = None
+
+    #: How many separate caches of this kind there are, e.g. one L2 per core
+    instances: int = 1
+
+    #: The number of logical threads that share one instance
+    shared_by_threads: Optional[int] = None
+
+    #: ``Performance`` or ``Efficiency`` on hybrid CPUs, when only one kind of core uses the cache
+    core_type: Optional[str] = None
 
 
 class CPUInfo(ComponentInfo):
@@ -28,3 +49,14 @@ class CPUInfo(ComponentInfo):
     cores: Optional[int] = None
     #: The number of logical threads supported by the CPU
     threads: Optional[int] = None
+
+    #: The number of physical CPU packages (sockets)
+    packages: Optional[int] = None
+
+    #: On hybrid CPUs (Intel P/E cores, Apple Silicon, ARM big.LITTLE), the number of cores of each kind.
+    #: ``null`` on CPUs with a single kind of core.
+    performance_cores: Optional[int] = None
+    efficiency_cores: Optional[int] = None
+
+    #: The cache hierarchy, by level
+    caches: List[CPUCacheInfo] = Field(default_factory=list)
@@ -0,0 +1,50 @@
+import pytest
+
+
+class FakeNativeLib:
+    """Stands in for a native library: each keyword becomes an export of that name."""
+
+    def __init__(self, **exports):
+        for name, function in exports.items():
+            setattr(self, name, self._export(function))
+
+    @staticmethod
+    def _export(function):
+        # A plain function, so the binding can set argtypes / restype on it like on a ctypes function
+        return lambda *args: function(*args)
+
+
+class FakeRing:
+    """
+    The sequence-numbered ring behind a `read(out, max_count, cursor, dropped)` export.
+    Items before `first_sequence` were overwritten; `fill(entry, item)` copies one item into an output struct.
+    """
+
+    def __init__(self, items, first_sequence, fill):
+        self.items = list(items)
+        self.first_sequence = first_sequence
+        self.fill = fill
+
+    def read(self, out, max_count, cursor, dropped):
+        cursor, dropped = cursor._obj, dropped._obj  # byref(c_uint64)
+        end = self.first_sequence + len(self.items)
+        start = max(cursor.value, self.first_sequence)
+        dropped.value = start - cursor.value
+        count = min(max_count, end - start)
+        for i in range(count):
+            out[i].sequence = start + i
+            self.fill(out[i], self.items[start - self.first_sequence + i])
+        cursor.value = start + count
+        return count
+
+
+@pytest.fixture
+def native_lib():
+    """FakeNativeLib(name=function, ...); with no exports it is a library that predates the wrapper."""
+    return FakeNativeLib
+
+
+@pytest.fixture
+def native_ring():
+    """FakeRing(items, first_sequence, fill), for the trace and telemetry ring exports."""
+    return FakeRing
@@ -0,0 +1,96 @@
+from types import SimpleNamespace
+
+from hwprobe.core.common.cpu import apply_cpu_topology
+from hwprobe.interops.common.cpu_topology import (
+    CPU_CACHE_ALL_CLASSES, CPU_CACHE_DATA, CPU_CACHE_UNIFIED, CPU_FEATURE_AVX2, CPU_FEATURE_LM, CPU_FEATURE_NEON,
+    CPU_FEATURE_SSE, CPU_FEATURE_SSE4_2, CpuTopologyReader, _CPUTopologyRecord, _topology,
+)
+from hwprobe.interops.common.device_arena import ArenaString
+from hwprobe.models.cpu_models import CPUInfo
+
+
+class FakeStrings:
+    """Stands in for the arena string pool: ArenaString.offset indexes `values`."""
+
+    def __init__(self, *values):
+        self.values = values
+
+    def get(self, ref):
+        return self.values[ref.offset] if ref.length else None
+
+
+def _ref(offset):
+    return ArenaString(offset, 1)
+
+
+def _hybrid_record():
+    raw = _CPUTopologyRecord()
+    raw.vendor, raw.brand = _ref(0), _ref(1)
+    raw.features = CPU_FEATURE_SSE | CPU_FEATURE_SSE4_2 | CPU_FEATURE_AVX2 | CPU_FEATURE_LM
+    raw.packages, raw.cores, raw.threads, raw.smt_width = 1, 14, 20, 2
+
+    raw.core_class_count = 2
+    raw.core_classes[0].efficiency_class, raw.core_classes[0].cores, raw.core_classes[0].threads = 1, 6, 12
+    raw.core_classes[0].cpus = _ref(2)
+    raw.core_classes[1].efficiency_class, raw.core_classes[1].cores, raw.core_classes[1].threads = 0, 8, 8
+    raw.core_classes[1].cpus = _ref(3)
+
+    raw.cache_count = 2
+    l1, l3 = raw.caches[0], raw.caches[1]
+    l1.level, l1.type, l1.size_bytes, l1.core_class, l1.instances, l1.threads_per_instance = \
+        1, CPU_CACHE_DATA, 48 << 10, 0, 6, 2
+    l1.shared_cpus = _ref(4)
+    l3.level, l3.type, l3.size_bytes, l3.core_class, l3.instances, l3.threads_per_instance = \
+        3, CPU_CACHE_UNIFIED, 24 << 20, CPU_CACHE_ALL_CLASSES, 1, 20
+    return raw, FakeStrings("GenuineIntel", "12th Gen Intel(R) Core(TM) i7-12700H", "0-11", "12-19",
+                            "0-1 2-3 4-5 6-7 8-9 10-11")
+
+
+class TestCpuTopologyMirror:
+
+    def test_decodes_classes_and_caches(self):
+        topology = _topology(*_hybrid_record())
+
+        assert (topology.vendor, topology.packages, topology.cores, topology.threads) == ("GenuineIntel", 1, 14, 20)
+        assert topology.hybrid
+        assert [(c.cores, c.threads, c.cpus) for c in topology.core_classes] == [(6, 12, "0-11"), (8, 8, "12-19")]
+
+        l1, l3 = topology.caches
+        assert l1.shared_cpus == ["0-1", "2-3", "4-5", "6-7", "8-9", "10-11"]
+        assert l1.core_class == 0
+        assert l3.core_class is None and l3.shared_cpus == []
+
+    def test_feature_bitset(self):
+        topology = _topology(*_hybrid_record())
+
+        assert topology.has(CPU_FEATURE_AVX2) and not topology.has(CPU_FEATURE_NEON)
+        assert topology.feature_names == ["SSE", "SSE4.2", "AVX2", "LM"]
+
+    def test_library_without_export_is_inert(self):
+        reader = CpuTopologyReader(object())
+
+        assert not reader.supported
+        assert reader.read() is None
+
+
+class TestApplyCpuTopology:
+
+    def test_hybrid(self):
+        cpu_info = CPUInfo()
+        apply_cpu_topology(cpu_info, _topology(*_hybrid_record()))
+
+        assert (cpu_info.packages, cpu_info.performance_cores, cpu_info.efficiency_cores) == (1, 6, 8)
+        assert [(c.level, c.type, c.size.capacity, c.size.unit, c.instances, c.shared_by_threads, c.core_type)
+                for c in cpu_info.caches] == [(1, "Data", 48, "KB", 6, 2, "Performance"),
+                                              (3, "Unified", 24576, "KB", 1, 20, None)]
+
+    def test_single_class_leaves_split_unset(self):
+        cpu_info = CPUInfo()
+        cache = SimpleNamespace(level=2, type=CPU_CACHE_UNIFIED, size_bytes=0, instances=0, threads_per_instance=0,
+                                core_class=0)
+        apply_cpu_topology(cpu_info, SimpleNamespace(packages=0, core_classes=[SimpleNamespace(cores=4)],
+                                                     caches=[cache]))
+
+        assert cpu_info.packages is None
+        assert cpu_info.performance_cores is None and cpu_info.efficiency_cores is None
+        assert (cpu_info.caches[0].size, cpu_info.caches[0].instances, cpu_info.caches[0].core_type) == (None, 1, None)
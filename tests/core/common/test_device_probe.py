@@ -0,0 +1,107 @@
+import ctypes
+
+from hwprobe.interops.common import device_arena
+from hwprobe.interops.common.device_arena import (
+    DEVICE_ARENA_KIND_MAC_GPU, DEVICE_ARENA_KIND_MAC_STORAGE, DEVICE_ARENA_MAGIC, DEVICE_ARENA_VERSION,
+    ArenaString, _DeviceArenaHeader,
+)
+from hwprobe.interops.common.device_probe import (
+    DEVICE_PROBE_STATUS_FAILURE, DEVICE_PROBE_STATUS_OK, DEVICE_PROBE_STATUS_TIMED_OUT, DEVICE_PROBE_WMI_TABLE,
+    ProbeJob, bind_probe_exports, prefetched_arenas, probe_all,
+)
+
+
+class _Record(ctypes.Structure):
+    _fields_ = [("name", ArenaString)]
+
+
+def build_arena(kind, name):
+    """Single-record arena blob laid out like arena::Builder::Finish()."""
+    records_offset = (ctypes.sizeof(_DeviceArenaHeader) + 7) // 8 * 8
+    strings_offset = (records_offset + ctypes.sizeof(_Record) + 7) // 8 * 8
+    pool = name + b"\0"
+    header = _DeviceArenaHeader(
+        DEVICE_ARENA_MAGIC, DEVICE_ARENA_VERSION, ctypes.sizeof(_DeviceArenaHeader), kind,
+        ctypes.sizeof(_Record), 1, records_offset, strings_offset, len(pool), strings_offset + len(pool),
+    )
+    blob = bytearray(header.total_size)
+    blob[:ctypes.sizeof(header)] = bytes(header)
+    blob[records_offset:records_offset + ctypes.sizeof(_Record)] = bytes(_Record(ArenaString(0, len(name))))
+    blob[strings_offset:] = pool
+    return blob
+
+
+def _names(result):
+    records, strings = result
+    return [strings.get(r.name) for r in records]
+
+
+class TestPrefetchedArenas:
+
+    def test_first_fetch_is_served_then_falls_back_to_live(self):
+        calls = []
+
+        def live_query(handle):
+            calls.append(handle)
+            return 1  # DEVICE_ARENA_STATUS_FAILURE
+
+        with prefetched_arenas([build_arena(DEVICE_ARENA_KIND_MAC_GPU, b"gpu0")]):
+            first = device_arena.fetch_arena(live_query, None, DEVICE_ARENA_KIND_MAC_GPU, _Record)
+            second = device_arena.fetch_arena(live_query, None, DEVICE_ARENA_KIND_MAC_GPU, _Record)
+
+        assert _names(first) == ["gpu0"]
+        assert second is None
+        assert len(calls) == 1
+
+    def test_other_kinds_go_to_previous_source(self):
+        served = build_arena(DEVICE_ARENA_KIND_MAC_STORAGE, b"disk0")
+
+        def previous(kind, record_type):
+            return device_arena.decode_arena(served, kind, record_type) if kind == DEVICE_ARENA_KIND_MAC_STORAGE else None
+
+        device_arena._arena_source = previous
+        try:
+            with prefetched_arenas([build_arena(DEVICE_ARENA_KIND_MAC_GPU, b"gpu0")]):
+                storage = device_arena.fetch_arena(None, None, DEVICE_ARENA_KIND_MAC_STORAGE, _Record)
+            assert device_arena._arena_source is previous
+        finally:
+            device_arena._arena_source = None
+
+        assert _names(storage) == ["disk0"]
+
+
+class FakeProbeLib:
+    """Stands in for device_info: job `i` finishes with statuses[i] and the blob b"job<i>"."""
+
+    def __init__(self, statuses):
+        self.statuses = statuses
+        self.timeouts = []
+        self.blobs = [ctypes.create_string_buffer(b"job%d" % i, 4) for i in range(len(statuses))]
+        # Plain functions, so bind_probe_exports() can set argtypes / restype on them
+        self.device_probe_all = lambda *args: self._probe_all(*args)
+        self.device_probe_result_get = lambda *args: self._result_get(*args)
+        self.device_probe_result_free = lambda handle: None
+
+    def _probe_all(self, jobs, count, max_threads, out):
+        self.timeouts = [jobs[i].timeout_ms for i in range(count)]
+        out._obj.value = 1
+        return DEVICE_PROBE_STATUS_OK
+
+    def _result_get(self, handle, index, status, data, size):
+        status._obj.value = self.statuses[index]
+        data._obj.value = ctypes.addressof(self.blobs[index])
+        size._obj.value = 4
+        return DEVICE_PROBE_STATUS_OK
+
+
+class TestProbeAll:
+
+    def test_timed_out_wmi_job_keeps_partial_rows(self):
+        lib = FakeProbeLib([DEVICE_PROBE_STATUS_OK, DEVICE_PROBE_STATUS_TIMED_OUT, DEVICE_PROBE_STATUS_FAILURE])
+        assert bind_probe_exports(lib)
+        jobs = [ProbeJob(DEVICE_PROBE_WMI_TABLE, "SELECT Name FROM Win32_DiskDrive", "ROOT\\CIMV2", ("Name",), 500)] * 3
+
+        blobs = probe_all(lib, jobs)
+
+        assert blobs == [bytearray(b"job0"), bytearray(b"job1"), None]
+        assert lib.timeouts == [500, 500, 500]
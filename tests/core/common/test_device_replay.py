@@ -0,0 +1,154 @@
+import ctypes
+
+import pytest
+
+from hwprobe.interops.common.device_replay import (
+    DEVICE_REPLAY_MAGIC, DEVICE_REPLAY_SMBIOS, DEVICE_REPLAY_STATUS_BUSY, DEVICE_REPLAY_STATUS_CORRUPT,
+    DEVICE_REPLAY_STATUS_OK, DEVICE_REPLAY_SYSFS_DIR, DEVICE_REPLAY_SYSFS_FILE, DEVICE_REPLAY_SYSFS_LINK,
+    DEVICE_REPLAY_SYSFS_LIST, DEVICE_REPLAY_WMI_TABLE, Corpus, pci_slot, record, replay,
+)
+
+ROOT = "/sys/bus/pci/devices"
+SLOT = "0000:01:00.0"
+
+
+def gpu_corpus():
+    corpus = Corpus()
+    corpus.put(DEVICE_REPLAY_SYSFS_DIR, ROOT)
+    corpus.put(DEVICE_REPLAY_SYSFS_LIST, ROOT, SLOT.encode() + b"\0")
+    corpus.put(DEVICE_REPLAY_SYSFS_DIR, f"{ROOT}/{SLOT}")
+    corpus.put(DEVICE_REPLAY_SYSFS_FILE, f"{ROOT}/{SLOT}/vendor", b"0x1002\n")
+    corpus.put(DEVICE_REPLAY_SYSFS_FILE, f"{ROOT}/{SLOT}/drm/card0/device/mem_info_vram_total", b"8589934592\n")
+    corpus.put(DEVICE_REPLAY_SYSFS_LINK, f"{ROOT}/{SLOT}", b"../../../devices/pci0000:00/0000:00:01.0/" + SLOT.encode())
+    corpus.put(DEVICE_REPLAY_SMBIOS, "", bytes([3, 4, 0, 0]) + b"\x7f\x04\x00\x00\0\0")
+    return corpus
+
+
+class FakeLib:
+    """device_replay_* exports over a Python corpus, the way the native library hands it out."""
+
+    def __init__(self, start_status=DEVICE_REPLAY_STATUS_OK, recorded=b""):
+        self.start_status = start_status
+        self.recorded = recorded
+        self.started = None
+        self.stops = 0
+
+    def device_replay_record_start(self):
+        return DEVICE_REPLAY_STATUS_OK
+
+    def device_replay_record_stop(self, out):
+        out._obj.value = 1  # byref(c_void_p)
+        return DEVICE_REPLAY_STATUS_OK
+
+    def device_replay_corpus_size(self, handle):
+        return len(self.recorded)
+
+    def device_replay_corpus_copy(self, handle, buffer, size):
+        ctypes.memmove(buffer, self.recorded, size)
+        return DEVICE_REPLAY_STATUS_OK
+
+    def device_replay_corpus_free(self, handle):
+        pass
+
+    def device_replay_start(self, data, size):
+        self.started = bytes(data[:size])
+        return self.start_status
+
+    def device_replay_stop(self):
+        self.stops += 1
+
+
+class TestCorpus:
+
+    def test_round_trip_keeps_every_entry(self):
+        corpus = gpu_corpus()
+        corpus.put(DEVICE_REPLAY_WMI_TABLE, "ROOT\\CIMV2\nSELECT Name FROM Win32_Processor\nName", b"\x01" * 13)
+
+        data = corpus.to_bytes()
+
+        assert int.from_bytes(data[:4], "little") == DEVICE_REPLAY_MAGIC
+        assert int.from_bytes(data[16:24], "little") == len(data)
+        assert len(data) % 8 == 0
+        assert Corpus.from_bytes(data).entries == corpus.entries
+
+    def test_entries_are_written_sorted(self):
+        corpus = Corpus()
+        corpus.put(DEVICE_REPLAY_SYSFS_FILE, "/b")
+        corpus.put(DEVICE_REPLAY_SYSFS_LINK, "/a")
+        corpus.put(DEVICE_REPLAY_SYSFS_FILE, "/a")
+
+        data = corpus.to_bytes()
+
+        # header, then (channel, key) in order: FILE /a, FILE /b, LINK /a; each entry 16 + 2 bytes, padded to 24
+        keys = [(data[24 + i * 24], data[24 + i * 24 + 16:24 + i * 24 + 18]) for i in range(3)]
+        assert keys == [(DEVICE_REPLAY_SYSFS_FILE, b"/a"), (DEVICE_REPLAY_SYSFS_FILE, b"/b"),
+                        (DEVICE_REPLAY_SYSFS_LINK, b"/a")]
+
+    def test_corrupt_corpus_is_rejected(self):
+        data = gpu_corpus().to_bytes()
+
+        with pytest.raises(ValueError):
+            Corpus.from_bytes(b"not a corpus")
+        with pytest.raises(ValueError):
+            Corpus.from_bytes(data[:-8])
+        with pytest.raises(ValueError):
+            Corpus.from_bytes(b"XXXX" + data[4:])
+
+    def test_clone_copies_device_tree_and_lists_it(self):
+        corpus = gpu_corpus()
+        slots = [pci_slot(i) for i in range(3)]
+
+        assert corpus.clone(ROOT, SLOT, slots) == 3
+
+        assert corpus.listing(ROOT) == [SLOT] + slots
+        for slot in slots:
+            assert corpus.get(DEVICE_REPLAY_SYSFS_DIR, f"{ROOT}/{slot}") == b""
+            assert corpus.get(DEVICE_REPLAY_SYSFS_FILE, f"{ROOT}/{slot}/vendor") == b"0x1002\n"
+            assert corpus.get(DEVICE_REPLAY_SYSFS_FILE, f"{ROOT}/{slot}/drm/card0/device/mem_info_vram_total")
+            assert corpus.get(DEVICE_REPLAY_SYSFS_LINK, f"{ROOT}/{slot}").endswith(b"/" + slot.encode())
+        assert len(corpus) == 7 + 3 * 4  # directory, two attributes and the link per clone
+
+    def test_clone_leaves_existing_names_and_other_channels(self):
+        corpus = gpu_corpus()
+        smbios = corpus.get(DEVICE_REPLAY_SMBIOS, "")
+
+        assert corpus.clone(ROOT, SLOT, [SLOT, pci_slot(0), pci_slot(0)]) == 1
+
+        assert corpus.listing(ROOT) == [SLOT, pci_slot(0)]
+        assert corpus.get(DEVICE_REPLAY_SMBIOS, "") == smbios
+
+    def test_pci_slots_are_distinct_and_well_formed(self):
+        slots = [pci_slot(i) for i in range(1000)]
+
+        assert len(set(slots)) == 1000
+        assert all(len(slot) == 12 and slot[4] == ":" and slot[7] == ":" and slot[10] == "." for slot in slots)
+
+
+class TestReplayExports:
+
+    def test_record_returns_the_native_corpus(self):
+        lib = FakeLib(recorded=gpu_corpus().to_bytes())
+
+        with record(lib) as recording:
+            assert recording.corpus is None
+
+        assert recording.corpus.entries == gpu_corpus().entries
+
+    def test_replay_stops_on_exit_even_after_an_error(self):
+        lib = FakeLib()
+        data = gpu_corpus().to_bytes()
+
+        with pytest.raises(KeyError):
+            with replay(lib, data):
+                raise KeyError("probe failed")
+
+        assert lib.started == data
+        assert lib.stops == 1
+
+    def test_rejected_corpus_raises(self):
+        with pytest.raises(ValueError):
+            with replay(FakeLib(DEVICE_REPLAY_STATUS_CORRUPT), b"junk"):
+                pass
+        with pytest.raises(RuntimeError):
+            with replay(FakeLib(DEVICE_REPLAY_STATUS_BUSY), b"junk"):
+                pass
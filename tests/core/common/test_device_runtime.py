@@ -0,0 +1,98 @@
+from concurrent.futures import ThreadPoolExecutor
+
+import pytest
+
+from hwprobe.interops.common.device_runtime import (
+    DEVICE_RUNTIME_STATUS_FAILURE, DEVICE_RUNTIME_STATUS_OK, DeviceRuntime,
+)
+
+
+@pytest.fixture
+def runtime_lib(native_lib):
+    """A library that records device_info_init / device_info_shutdown calls."""
+
+    def make(status=DEVICE_RUNTIME_STATUS_OK):
+        calls = []
+        lib = native_lib(device_info_init=lambda: calls.append("init") or status,
+                         device_info_shutdown=lambda: calls.append("shutdown"))
+        lib.calls = calls
+        return lib
+
+    return make
+
+
+@pytest.fixture
+def native_runtime():
+    """The built libdevice_info.so's runtime and trace ring; skips where it is not available."""
+    try:
+        from hwprobe.interops.linux.bindings.device_runtime import runtime
+        from hwprobe.interops.linux.bindings.device_trace import trace
+    except (FileNotFoundError, OSError):
+        pytest.skip("libdevice_info.so is not built for this platform")
+    if not runtime.supported or not trace.supported:
+        pytest.skip("libdevice_info.so predates the lifecycle or trace exports")
+    return runtime, trace
+
+
+def _platform_inits(events):
+    return sum(event.name == "runtime::PlatformInit" for event in events)
+
+
+class TestDeviceRuntime:
+
+    def test_session_balances_init(self, runtime_lib):
+        lib = runtime_lib()
+        runtime = DeviceRuntime(lib)
+
+        with runtime.session() as initialized:
+            assert initialized
+            assert lib.calls == ["init"]
+
+        assert lib.calls == ["init", "shutdown"]
+
+    def test_failed_init_is_not_shut_down(self, runtime_lib):
+        lib = runtime_lib(DEVICE_RUNTIME_STATUS_FAILURE)
+        runtime = DeviceRuntime(lib)
+
+        with runtime.session() as initialized:
+            assert not initialized
+
+        assert lib.calls == ["init"]
+
+    def test_library_without_exports_is_inert(self, native_lib):
+        runtime = DeviceRuntime(native_lib())
+
+        assert not runtime.supported
+        assert not runtime.init()
+        runtime.shutdown()
+        with runtime.session() as initialized:
+            assert not initialized
+
+    def test_nested_sessions_set_up_the_platform_once(self, native_runtime):
+        runtime, trace = native_runtime
+
+        with trace.capture() as events:
+            with runtime.session() as outer, runtime.session() as inner:
+                assert outer and inner
+            # The count went back to zero, so the next session sets up again
+            with runtime.session():
+                pass
+
+        assert _platform_inits(events) == 2
+
+    def test_concurrent_sessions_leave_the_count_balanced(self, native_runtime):
+        runtime, trace = native_runtime
+
+        def cycle(_):
+            with runtime.session() as initialized:
+                return initialized
+
+        with runtime.session():
+            with ThreadPoolExecutor(max_workers=8) as pool:
+                assert all(pool.map(cycle, range(64)))
+
+        with trace.capture() as events:
+            with runtime.session():
+                pass
+
+        assert _platform_inits(events) == 1
@@ -0,0 +1,184 @@
+import ctypes
+
+from hwprobe.interops.common import device_arena
+from hwprobe.interops.common.device_arena import (
+    DEVICE_ARENA_KIND_MAC_STORAGE, DEVICE_ARENA_KIND_SNAPSHOT_DELTA, DEVICE_ARENA_MAGIC, DEVICE_ARENA_VERSION,
+    ArenaString, _DeviceArenaHeader,
+)
+from hwprobe.interops.common.device_snapshot import (
+    DEVICE_DELTA_ADDED, DEVICE_DELTA_CHANGED, DEVICE_DELTA_REMOVED, DEVICE_SNAPSHOT_STATUS_OK,
+    DEVICE_SNAPSHOT_STATUS_STALE, _DeviceDeltaRecord, _DeviceSnapshotHeader, _DeviceSnapshotSection, activate,
+    diff_snapshots, load_snapshot,
+)
+
+
+class _Record(ctypes.Structure):
+    _fields_ = [("name", ArenaString)]
+
+
+def _align(value):
+    return (value + 7) // 8 * 8
+
+
+def layout_arena(kind, record_type, records, pool):
+    """Arena blob laid out like arena::Builder::Finish()."""
+    records_offset = _align(ctypes.sizeof(_DeviceArenaHeader))
+    strings_offset = _align(records_offset + len(records) * ctypes.sizeof(record_type))
+    header = _DeviceArenaHeader(
+        DEVICE_ARENA_MAGIC, DEVICE_ARENA_VERSION, ctypes.sizeof(_DeviceArenaHeader), kind,
+        ctypes.sizeof(record_type), len(records), records_offset, strings_offset, len(pool), strings_offset + len(pool),
+    )
+    blob = bytearray(header.total_size)
+    blob[:ctypes.sizeof(header)] = bytes(header)
+    for i, record in enumerate(records):
+        start = records_offset + i * ctypes.sizeof(record_type)
+        blob[start:start + ctypes.sizeof(record_type)] = bytes(record)
+    blob[strings_offset:] = pool
+    return bytes(blob)
+
+
+def build_arena(names):
+    pool = b""
+    records = []
+    for name in names:
+        records.append(_Record(ArenaString(len(pool), len(name))))
+        pool += name + b"\0"
+    return layout_arena(DEVICE_ARENA_KIND_MAC_STORAGE, _Record, records, pool)
+
+
+def build_delta(entries):
+    """Delta arena of (change, key, field, old, new) byte strings, as device_snapshot_diff() returns it."""
+    pool = b""
+
+    def intern(value):
+        nonlocal pool
+        if not value:
+            return ArenaString(0, 0)
+        ref = ArenaString(len(pool), len(value))
+        pool += value + b"\0"
+        return ref
+
+    records = [
+        _DeviceDeltaRecord(DEVICE_ARENA_KIND_MAC_STORAGE, change, intern(key), intern(field), intern(old), intern(new))
+        for change, key, field, old, new in entries
+    ]
+    return layout_arena(DEVICE_ARENA_KIND_SNAPSHOT_DELTA, _DeviceDeltaRecord, records, pool)
+
+
+def build_snapshot(arena):
+    offset = _align(ctypes.sizeof(_DeviceSnapshotHeader) + ctypes.sizeof(_DeviceSnapshotSection))
+    header = _DeviceSnapshotHeader()
+    header.section_count = 1
+    header.total_size = offset + len(arena)
+    section = _DeviceSnapshotSection(DEVICE_ARENA_KIND_MAC_STORAGE, 0, offset, len(arena))
+    head = bytes(header) + bytes(section)
+    return head + b"\0" * (offset - len(head)) + arena
+
+
+class FakeLib:
+    """Native validation is the library's job; the binding only acts on its verdict."""
+
+    def __init__(self, status):
+        self.status = status
+
+    def device_snapshot_validate(self, address, size):
+        return self.status
+
+
+class FakeDiffLib:
+    """Hands out a prepared delta arena through the two-phase device_arena_* calls."""
+
+    def __init__(self, delta):
+        self.delta = delta
+        self.sizes = None
+
+    def device_snapshot_diff(self, previous, previous_size, current, current_size, out):
+        self.sizes = (previous_size, current_size)
+        out._obj.value = 1
+        return 0
+
+    def device_arena_size(self, handle):
+        return len(self.delta)
+
+    def device_arena_copy(self, handle, buffer, size):
+        ctypes.memmove(buffer, self.delta, size)
+        return 0
+
+    def device_arena_free(self, handle):
+        pass
+
+
+class TestDeviceSnapshot:
+
+    def test_valid_snapshot_serves_fetch_arena(self, tmp_path):
+        path = tmp_path / "inventory.snap"
+        path.write_bytes(build_snapshot(build_arena([b"disk0", b"disk1"])))
+
+        snapshot = load_snapshot(FakeLib(DEVICE_SNAPSHOT_STATUS_OK), str(path))
+        assert snapshot.kinds() == [DEVICE_ARENA_KIND_MAC_STORAGE]
+
+        def live_query(handle):
+            raise AssertionError("a valid snapshot must not be re-probed")
+
+        with activate(snapshot):
+            records, strings = device_arena.fetch_arena(live_query, None, DEVICE_ARENA_KIND_MAC_STORAGE, _Record)
+
+        assert [strings.get(r.name) for r in records] == ["disk0", "disk1"]
+
+    def test_activate_restores_the_previous_source(self, tmp_path, monkeypatch):
+        path = tmp_path / "inventory.snap"
+        path.write_bytes(build_snapshot(build_arena([b"disk0"])))
+        snapshot = load_snapshot(FakeLib(DEVICE_SNAPSHOT_STATUS_OK), str(path))
+
+        def outer(kind, record_type):
+            return None
+
+        monkeypatch.setattr(device_arena, "_arena_source", outer)
+        with activate(snapshot):
+            assert device_arena._arena_source == snapshot.arena
+            with activate(None):
+                assert device_arena._arena_source is None
+            assert device_arena._arena_source == snapshot.arena
+
+        assert device_arena._arena_source is outer
+
+    def test_stale_or_missing_snapshot_is_rejected(self, tmp_path):
+        path = tmp_path / "inventory.snap"
+        path.write_bytes(build_snapshot(build_arena([b"disk0"])))
+
+        assert load_snapshot(FakeLib(DEVICE_SNAPSHOT_STATUS_STALE), str(path)) is None
+        assert load_snapshot(FakeLib(DEVICE_SNAPSHOT_STATUS_OK), str(tmp_path / "missing.snap")) is None
+
+    def test_section_with_other_layout_is_ignored(self, tmp_path):
+        class _Wider(ctypes.Structure):
+            _fields_ = [("name", ArenaString), ("extra", ctypes.c_uint64)]
+
+        path = tmp_path / "inventory.snap"
+        path.write_bytes(build_snapshot(build_arena([b"disk0"])))
+
+        snapshot = load_snapshot(FakeLib(DEVICE_SNAPSHOT_STATUS_OK), str(path))
+        assert snapshot.arena(DEVICE_ARENA_KIND_MAC_STORAGE, _Wider) is None
+
+    def test_diff_groups_delta_records_by_device(self, tmp_path):
+        previous = tmp_path / "last.snap"
+        previous.write_bytes(build_snapshot(build_arena([b"disk0"])))
+        lib = FakeDiffLib(build_delta([
+            (DEVICE_DELTA_ADDED, b"bsd_name=disk2", b"bsd_name", b"", b"disk2"),
+            (DEVICE_DELTA_ADDED, b"bsd_name=disk2", b"size_bytes", b"", b"512110190592"),
+            (DEVICE_DELTA_CHANGED, b"bsd_name=disk0", b"partition_count", b"2", b"3"),
+            (DEVICE_DELTA_REMOVED, b"bsd_name=disk1", b"", b"", b""),
+        ]))
+
+        delta = diff_snapshots(lib, str(previous))
+
+        assert lib.sizes == (previous.stat().st_size, 0)  # no current file: compared against the live system
+        kind = DEVICE_ARENA_KIND_MAC_STORAGE
+        assert delta.added == {(kind, "bsd_name=disk2"): {"bsd_name": "disk2", "size_bytes": "512110190592"}}
+        assert delta.changed == {(kind, "bsd_name=disk0"): {"partition_count": ("2", "3")}}
+        assert delta.removed == [(kind, "bsd_name=disk1")]
+        assert delta.to_dict()["changed"] == [
+            {"kind": kind, "key": "bsd_name=disk0", "fields": {"partition_count": {"old": "2", "new": "3"}}}
+        ]
+
+    def test_unchanged_inventory_gives_empty_delta(self, tmp_path):
+        assert not diff_snapshots(FakeDiffLib(build_delta([])), str(tmp_path / "missing.snap"))
@@ -0,0 +1,67 @@
+import pytest
+
+from hwprobe.interops.common.device_trace import DEVICE_TRACE_CAPACITY, DeviceTrace, slowest
+
+
+def _fill_event(entry, event):
+    entry.name, entry.duration_ns = event
+    entry.thread_id = 7
+
+
+@pytest.fixture
+def trace_lib(native_lib, native_ring):
+    """A library with a list of (name, duration_ns) events behind device_info_get_trace."""
+
+    def make(events=(), first_sequence=0):
+        ring = native_ring(events, first_sequence, _fill_event)
+        enabled = []
+        lib = native_lib(device_info_trace_enable=enabled.append, device_info_get_trace=ring.read)
+        lib.events, lib.enabled = ring.items, enabled
+        return lib
+
+    return make
+
+
+class TestDeviceTrace:
+
+    def test_reads_each_event_once(self, trace_lib):
+        lib = trace_lib([(b"CreateDXGIFactory1", 5), (b"GetDevNodePCIeInfo", 9)])
+        trace = DeviceTrace(lib)
+
+        assert [e.name for e in trace.read()] == ["CreateDXGIFactory1", "GetDevNodePCIeInfo"]
+        assert trace.read() == []
+
+        lib.events.append((b"IWbemLocator::ConnectServer", 1))
+        assert [e.sequence for e in trace.read()] == [2]
+
+    def test_reads_past_one_buffer_and_counts_overwritten_events(self, trace_lib):
+        lib = trace_lib([(b"stage", 1)] * (DEVICE_TRACE_CAPACITY + 3), first_sequence=10)
+        trace = DeviceTrace(lib)
+
+        assert len(trace.read()) == DEVICE_TRACE_CAPACITY + 3
+        assert trace.dropped == 10
+
+    def test_capture_switches_tracing_around_the_block(self, trace_lib):
+        lib = trace_lib([(b"before", 1)])
+        trace = DeviceTrace(lib)
+
+        with trace.capture() as events:
+            lib.events.append((b"inside", 2))
+            assert lib.enabled == [1]
+
+        assert lib.enabled == [1, 0]
+        assert [e.name for e in events] == ["inside"]
+
+    def test_library_without_exports_is_inert(self, native_lib):
+        trace = DeviceTrace(native_lib())
+
+        with trace.capture() as events:
+            pass
+
+        assert not trace.supported
+        assert events == [] and trace.read() == []
+
+    def test_slowest_orders_by_duration(self, trace_lib):
+        trace = DeviceTrace(trace_lib([(b"a", 3), (b"b", 9), (b"c", 1)]))
+
+        assert [e.name for e in slowest(trace.read(), 2)] == ["b", "a"]
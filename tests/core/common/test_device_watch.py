@@ -0,0 +1,73 @@
+from hwprobe.interops.common.device_watch import DEVICE_WATCH_GPU, DEVICE_WATCH_STORAGE, ChangeCache, DeviceWatch
+
+
+class FakeWatch:
+    """Stands in for DeviceWatch: generations are set by the test."""
+
+    def __init__(self, generation=1):
+        self.generations = {DEVICE_WATCH_GPU: generation, DEVICE_WATCH_STORAGE: generation}
+
+    def generation(self, category):
+        return self.generations[category]
+
+
+class Counter:
+    def __init__(self):
+        self.calls = 0
+
+    def __call__(self):
+        self.calls += 1
+        return self.calls
+
+
+class TestChangeCache:
+
+    def test_reuses_until_generation_changes(self):
+        watch, fetch = FakeWatch(), Counter()
+        cache = ChangeCache(watch)
+
+        assert cache.get(DEVICE_WATCH_GPU, fetch) == 1
+        assert cache.get(DEVICE_WATCH_GPU, fetch) == 1
+
+        watch.generations[DEVICE_WATCH_GPU] += 1
+        assert cache.get(DEVICE_WATCH_GPU, fetch) == 2
+        assert fetch.calls == 2
+
+    def test_categories_are_independent(self):
+        watch, fetch = FakeWatch(), Counter()
+        cache = ChangeCache(watch)
+
+        cache.get(DEVICE_WATCH_GPU, fetch)
+        cache.get(DEVICE_WATCH_STORAGE, fetch)
+        watch.generations[DEVICE_WATCH_STORAGE] += 1
+
+        assert cache.get(DEVICE_WATCH_GPU, fetch) == 1
+        assert cache.get(DEVICE_WATCH_STORAGE, fetch) == 3
+
+    def test_generation_zero_always_fetches(self):
+        fetch = Counter()
+        for cache in (ChangeCache(None), ChangeCache(FakeWatch(generation=0))):
+            cache.get(DEVICE_WATCH_GPU, fetch)
+            cache.get(DEVICE_WATCH_GPU, fetch)
+
+        assert fetch.calls == 4
+
+    def test_rejected_values_are_not_cached(self):
+        fetch = Counter()
+        cache = ChangeCache(FakeWatch(), keep=lambda value: value > 1)
+
+        assert cache.get(DEVICE_WATCH_GPU, fetch) == 1
+        assert cache.get(DEVICE_WATCH_GPU, fetch) == 2
+        assert cache.get(DEVICE_WATCH_GPU, fetch) == 2
+
+
+class TestDeviceWatch:
+
+    def test_library_without_exports_is_inert(self):
+        watch = DeviceWatch(object())
+
+        assert not watch.supported
+        assert not watch.start()
+        assert watch.generation(DEVICE_WATCH_GPU) == 0
+        watch.invalidate(DEVICE_WATCH_GPU)
+        watch.stop()
@@ -1,8 +1,10 @@
 import struct
+from types import SimpleNamespace
 
 import pytest
 
-from hwprobe.core.common.edid import parse_edid
+from hwprobe.core.common import edid as edid_module
+from hwprobe.core.common.edid import module_from_native_edid, parse_edid
 
 
 def _build_edid(
@@ -227,3 +229,77 @@ class TestCommonFieldsAcrossVersions:
         result = parse_edid(edid)
         assert result.name == "My Display"
         assert result.serial_number == "ABC123"
+
+
+def _native_monitor(**fields):
+    """An EDIDProperties as interops/common/edid_info.py returns it."""
+    record = dict(device_path="card0-DP-1", name="DELL U2720Q", serial_text="ABC123", manufacturer_code="DEL",
+                  acpi_path=None, pci_path=None, hash=1, vendor_id=0x10AC, product_id=0x4109, serial_number=0,
+                  size=256, year=2020, version=1, revision=4, extension_count=1, interface=5, bit_depth=10,
+                  flags=0x07, width_cm=60, height_cm=34, preferred_width=3840, preferred_height=2160,
+                  preferred_refresh_mhz=59997, max_width=3840, max_height=2160, max_refresh_mhz=59997)
+    record.update(fields)
+    return SimpleNamespace(**record)
+
+
+class TestModuleFromNativeEdid:
+
+    @pytest.fixture(autouse=True)
+    def _empty_cache(self, monkeypatch):
+        monkeypatch.setattr(edid_module, "_native_fields_cache", {})
+
+    def test_same_fields_as_parse_edid(self):
+        module = module_from_native_edid(_native_monitor())
+
+        assert module.name == "DELL U2720Q"
+        assert module.serial_number == "ABC123"
+        assert module.manufacturer_code == "DEL"
+        assert module.year == 2020
+        assert module.interface == "DisplayPort"
+        assert module.resolution.bit_depth == 10
+        assert (module.resolution.width, module.resolution.height) == (3840, 2160)
+        assert module.resolution.refresh_rate == 60.0
+
+    def test_analog_has_no_bit_depth(self):
+        module = module_from_native_edid(_native_monitor(interface=0xFE, bit_depth=0))
+
+        assert module.interface == "Analog"
+        assert module.resolution.bit_depth is None
+
+    def test_pre_v14_digital_reports_no_interface(self):
+        module = module_from_native_edid(_native_monitor(revision=3, interface=0xFF, bit_depth=0))
+
+        assert module.interface is None
+        assert module.resolution.bit_depth is None
+
+    def test_undefined_interface_with_hdmi_block_is_hdmi(self):
+        module = module_from_native_edid(_native_monitor(interface=0, flags=0x17))
+
+        assert module.interface == "HDMI"
+
+    def test_no_detailed_timing_leaves_resolution_empty(self):
+        module = module_from_native_edid(_native_monitor(max_width=0, max_height=0, max_refresh_mhz=0))
+
+        assert module.resolution.width is None
+        assert module.resolution.refresh_rate is None
+
+    def test_unchanged_hash_reuses_fields(self):
+        module_from_native_edid(_native_monitor(hash=7, name="First"))
+        module = module_from_native_edid(_native_monitor(hash=7, name="Second"))
+
+        assert module.name == "First"
+
+    def test_changed_hash_decodes_again(self):
+        module_from_native_edid(_native_monitor(hash=7, name="First"))
+        module = module_from_native_edid(_native_monitor(hash=8, name="Second"))
+
+        assert module.name == "Second"
+
+    def test_modules_are_independent(self):
+        first = module_from_native_edid(_native_monitor())
+        first.interface = "HDMI"
+        first.resolution.width = 1
+
+        second = module_from_native_edid(_native_monitor())
+        assert second.interface == "DisplayPort"
+        assert second.resolution.width == 3840
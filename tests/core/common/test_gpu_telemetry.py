@@ -0,0 +1,93 @@
+import pytest
+
+from hwprobe.interops.common.gpu_telemetry import (
+    GPU_TELEMETRY_CAPACITY, GPU_TELEMETRY_FIELD_MEMORY_USED, GPU_TELEMETRY_FIELD_PCIE_LINK,
+    GPU_TELEMETRY_FIELD_UTILIZATION, GPU_TELEMETRY_STATUS_FAILURE, GPU_TELEMETRY_STATUS_OK, GpuTelemetry, latest,
+)
+
+
+def _fill_sample(entry, sample):
+    entry.gpu_index, entry.fields, entry.utilization_percent = sample
+    entry.memory_used_bytes = 1 << 30
+    entry.pcie_gen = 4
+    entry.pcie_width = 16
+
+
+@pytest.fixture
+def telemetry_lib(native_lib, native_ring):
+    """A library with a list of (gpu_index, fields, utilization) samples behind gpu_telemetry_read."""
+
+    def make(samples=(), first_sequence=0, start_status=GPU_TELEMETRY_STATUS_OK):
+        ring = native_ring(samples, first_sequence, _fill_sample)
+        calls = []
+        lib = native_lib(gpu_telemetry_start=lambda interval_ms: calls.append(("start", interval_ms)) or start_status,
+                         gpu_telemetry_stop=lambda: calls.append(("stop",)),
+                         gpu_telemetry_read=ring.read)
+        lib.samples, lib.calls = ring.items, calls
+        return lib
+
+    return make
+
+
+class TestGpuTelemetry:
+
+    def test_reads_each_sample_once(self, telemetry_lib):
+        lib = telemetry_lib([(0, GPU_TELEMETRY_FIELD_UTILIZATION, 40), (1, GPU_TELEMETRY_FIELD_UTILIZATION, 5)])
+        telemetry = GpuTelemetry(lib)
+
+        assert [(s.gpu_index, s.utilization_percent) for s in telemetry.read()] == [(0, 40), (1, 5)]
+        assert telemetry.read() == []
+
+        lib.samples.append((0, GPU_TELEMETRY_FIELD_UTILIZATION, 90))
+        assert [s.sequence for s in telemetry.read()] == [2]
+
+    def test_unreported_fields_are_none(self, telemetry_lib):
+        lib = telemetry_lib([(0, GPU_TELEMETRY_FIELD_MEMORY_USED, 0), (0, GPU_TELEMETRY_FIELD_PCIE_LINK, 0)])
+        memory, link = GpuTelemetry(lib).read()
+
+        assert memory.memory_used_bytes == 1 << 30
+        assert memory.utilization_percent is None and memory.pcie_gen is None and memory.memory_budget_bytes is None
+        assert (link.pcie_gen, link.pcie_width) == (4, 16)
+        assert link.memory_used_bytes is None
+
+    def test_reads_past_one_buffer_and_counts_overwritten_samples(self, telemetry_lib):
+        lib = telemetry_lib([(0, 0, 0)] * (GPU_TELEMETRY_CAPACITY + 3), first_sequence=10)
+        telemetry = GpuTelemetry(lib)
+
+        assert len(telemetry.read()) == GPU_TELEMETRY_CAPACITY + 3
+        assert telemetry.dropped == 10
+
+    def test_starts_once_per_instance(self, telemetry_lib):
+        lib = telemetry_lib()
+        telemetry = GpuTelemetry(lib)
+
+        assert telemetry.start(50) and telemetry.start(10)
+        telemetry.stop()
+        telemetry.stop()
+        assert lib.calls == [("start", 50), ("stop",)]
+
+    def test_sampling_reports_failure_and_skips_old_samples(self, telemetry_lib):
+        lib = telemetry_lib([(0, 0, 0)], start_status=GPU_TELEMETRY_STATUS_FAILURE)
+        telemetry = GpuTelemetry(lib)
+
+        with telemetry.sampling(interval_ms=100) as started:
+            assert started is False
+            lib.samples.append((1, 0, 0))
+
+        assert [s.gpu_index for s in telemetry.read()] == [1]
+        assert lib.calls == [("start", 100)]
+
+    def test_latest_keeps_the_newest_sample_per_gpu(self, telemetry_lib):
+        lib = telemetry_lib([(0, GPU_TELEMETRY_FIELD_UTILIZATION, 10), (1, GPU_TELEMETRY_FIELD_UTILIZATION, 20),
+                                (0, GPU_TELEMETRY_FIELD_UTILIZATION, 30)])
+
+        newest = latest(GpuTelemetry(lib).read())
+        assert {index: s.utilization_percent for index, s in newest.items()} == {0: 30, 1: 20}
+
+    def test_library_without_exports_is_inert(self, native_lib):
+        telemetry = GpuTelemetry(native_lib())
+
+        assert not telemetry.supported
+        assert telemetry.start() is False
+        assert telemetry.read() == []
+        telemetry.stop()
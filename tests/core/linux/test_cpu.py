@@ -1,5 +1,7 @@
 import builtins
 import subprocess
+from types import SimpleNamespace
+from unittest.mock import MagicMock, patch
 
 from hwprobe.core.linux.cpu import (
     _arm_cpu_cores,
@@ -574,3 +576,101 @@ class TestLinuxCPURealWorld:
         assert cpu.cores == 2
         assert cpu.threads == 4
         assert "SSE4.2" in cpu.sse_flags
+
+
+def _patch_cpu_binding(topology=None, **fields):
+    """
+    Patches the lazy imports in _native_cpu_info so get_cpu_info() returns a record with `fields`
+    and the topology probe returns `topology`.
+    """
+    record = dict(machine="x86_64", model_name=None, vendor=None, arch_version=None, flags=None,
+                  threads=0, cores_per_package=0, cores=0)
+    record.update(fields)
+    mock_module = MagicMock()
+    mock_module.get_cpu_info.return_value = SimpleNamespace(**record)
+    topology_module = MagicMock()
+    topology_module.topology.read.return_value = topology
+    return patch.dict("sys.modules", {"hwprobe.interops.linux.bindings.cpu_info": mock_module,
+                                      "hwprobe.interops.linux.bindings.cpu_topology": topology_module})
+
+
+def _topology(classes, caches=(), packages=1):
+    """A native CPUTopology with core classes [(cores, threads), ...] and caches [(level, type, size, class), ...]."""
+    return SimpleNamespace(
+        packages=packages,
+        core_classes=[SimpleNamespace(cores=cores, threads=threads) for cores, threads in classes],
+        caches=[SimpleNamespace(level=level, type=cache_type, size_bytes=size, instances=instances,
+                                threads_per_instance=threads, core_class=core_class)
+                for level, cache_type, size, instances, threads, core_class in caches],
+    )
+
+
+class TestFetchCpuInfoNative:
+    """Tests for fetch_cpu_info(native=True), backed by interops/linux."""
+
+    def test_x86_record(self, monkeypatch):
+        monkeypatch.setattr(subprocess, "run", MagicMock(side_effect=AssertionError("spawned a process")))
+
+        with _patch_cpu_binding(model_name="AMD Ryzen 7 5800X", flags="fpu sse sse2 sse4_1 lm",
+                                threads=16, cores_per_package=8, cores=8):
+            cpu = fetch_cpu_info(native=True)
+
+        assert cpu.status.type == StatusType.SUCCESS
+        assert cpu.architecture == "x86"
+        assert cpu.vendor == "amd"
+        assert cpu.sse_flags == ["SSE", "SSE2", "SSE4.1"]
+        assert cpu.bitness == 64
+        assert (cpu.cores, cpu.threads) == (8, 16)
+
+    def test_arm_record_uses_topology_cores(self, monkeypatch):
+        monkeypatch.setattr(subprocess, "run", MagicMock(side_effect=AssertionError("spawned a process")))
+
+        with _patch_cpu_binding(machine="aarch64", model_name="BCM2711", arch_version="8", threads=4, cores=4):
+            cpu = fetch_cpu_info(native=True)
+
+        assert cpu.status.type == StatusType.SUCCESS
+        assert cpu.architecture == "ARM"
+        assert (cpu.name, cpu.arch_version, cpu.cores, cpu.threads) == ("BCM2711", "8", 4, 4)
+
+    def test_hybrid_topology(self):
+        topology = _topology([(6, 12), (8, 8)], caches=[(1, 2, 48 << 10, 6, 2, 0), (2, 0, 2 << 20, 2, 4, 1),
+                                                        (3, 0, 24 << 20, 1, 20, None)])
+        with _patch_cpu_binding(topology, model_name="Intel(R) Core(TM) i7-12700H", flags="sse lm",
+                                threads=20, cores_per_package=14, cores=14):
+            cpu = fetch_cpu_info(native=True)
+
+        assert (cpu.cores, cpu.threads, cpu.packages) == (14, 20, 1)
+        assert (cpu.performance_cores, cpu.efficiency_cores) == (6, 8)
+        assert [(c.level, c.type, c.size.capacity, c.instances, c.shared_by_threads, c.core_type)
+                for c in cpu.caches] == [(1, "Data", 48, 6, 2, "Performance"), (2, "Unified", 2048, 2, 4, "Efficiency"),
+                                         (3, "Unified", 24576, 1, 20, None)]
+
+    def test_single_core_class_is_not_split(self):
+        with _patch_cpu_binding(_topology([(64, 128)], packages=2), model_name="AMD EPYC", flags="sse lm",
+                                threads=128, cores_per_package=32, cores=64):
+            cpu = fetch_cpu_info(native=True)
+
+        assert cpu.packages == 2
+        assert cpu.performance_cores is None and cpu.efficiency_cores is None
+
+    def test_missing_fields_are_partial(self):
+        with _patch_cpu_binding(model_name="Intel CPU", threads=2):
+            cpu = fetch_cpu_info(native=True)
+
+        assert cpu.status.type == StatusType.PARTIAL
+        assert "Could not find CPU flags" in cpu.status.messages
+        assert "Could not find cpu cores" in cpu.status.messages
+
+    def test_falls_back_when_library_missing(self, monkeypatch):
+        mock_module = MagicMock()
+        mock_module.get_cpu_info.side_effect = RuntimeError("get_cpu_info_arena() failed")
+        monkeypatch.setattr(builtins, "open", lambda *args, **kwargs: __import__("io").StringIO(
+            "model name\t: Intel CPU\nflags\t\t: lm sse\ncpu cores\t: 4\n\n"))
+        monkeypatch.setattr(subprocess, "run", lambda *args, **kwargs: subprocess.CompletedProcess(args, 0,
+                                                                                                 stdout="x86_64"))
+
+        with patch.dict("sys.modules", {"hwprobe.interops.linux.bindings.cpu_info": mock_module}):
+            cpu = fetch_cpu_info(native=True)
+
+        assert cpu.name == "Intel CPU"
+        assert cpu.cores == 4
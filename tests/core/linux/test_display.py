@@ -1,9 +1,11 @@
 import builtins
 import os
-from unittest.mock import mock_open
+from types import SimpleNamespace
+from unittest.mock import MagicMock, mock_open, patch
 
 import pytest
 
+from hwprobe.core.common import edid as edid_module
 from hwprobe.core.linux.display import (
     _extract_pci_bdf_from_sysfs_path,
     _parse_connector_type,
@@ -264,3 +266,72 @@ class TestParseConnectorType:
 
         assert monitor is not None
         assert monitor.interface == "HDMI"
+
+
+def _native_monitor(**fields):
+    record = dict(device_path="card0-HDMI-A-1", name="LG ULTRAFINE", serial_text=None, manufacturer_code="GSM",
+                  acpi_path="\\_SB_.PCI0.GFX0.DD02", pci_path="PciRoot(0x0)/Pci(0x2,0x0)", hash=1, vendor_id=0x1E6D,
+                  product_id=0x5B09, serial_number=0, size=256, year=2019, version=1, revision=3, extension_count=1,
+                  interface=0xFF, bit_depth=0, flags=0x07, width_cm=60, height_cm=34, preferred_width=3840,
+                  preferred_height=2160, preferred_refresh_mhz=60000, max_width=3840, max_height=2160,
+                  max_refresh_mhz=60000)
+    record.update(fields)
+    return SimpleNamespace(valid=bool(record["flags"] & 0x01), **record)
+
+
+def _patch_edid_binding(monitors):
+    """Patches the lazy import in _native_display_info so edid.read() returns `monitors`."""
+    mock_module = MagicMock()
+    mock_module.edid.read.return_value = monitors
+    return patch.dict("sys.modules", {"hwprobe.interops.linux.bindings.edid_info": mock_module})
+
+
+class TestFetchDisplayInfoNative:
+    """Tests for fetch_display_info(native=True), backed by interops/linux."""
+
+    def _empty_cache(self, monkeypatch):
+        monkeypatch.setattr(edid_module, "_native_fields_cache", {})
+
+    def test_builds_modules_without_reading_sysfs(self, monkeypatch):
+        self._empty_cache(monkeypatch)
+        monkeypatch.setattr(os, "listdir", MagicMock(side_effect=AssertionError("walked /sys/class/drm")))
+
+        with _patch_edid_binding([_native_monitor()]):
+            info = fetch_display_info(native=True)
+
+        assert info.status.type == StatusType.SUCCESS
+        module = info.modules[0]
+        assert module.name == "LG ULTRAFINE"
+        assert module.interface == "HDMI"  # from the connector name
+        assert module.pci_path == "PciRoot(0x0)/Pci(0x2,0x0)"
+        assert module.acpi_path == "\\_SB_.PCI0.GFX0.DD02"
+        assert (module.resolution.width, module.resolution.height) == (3840, 2160)
+
+    def test_undecodable_edid_is_partial(self, monkeypatch):
+        self._empty_cache(monkeypatch)
+        monitors = [_native_monitor(device_path="card0-eDP-1", flags=0), _native_monitor()]
+
+        with _patch_edid_binding(monitors):
+            info = fetch_display_info(native=True)
+
+        assert info.status.type == StatusType.PARTIAL
+        assert any("card0-eDP-1" in m for m in info.status.messages)
+        assert len(info.modules) == 1
+
+    def test_connected_without_edid_is_skipped(self, monkeypatch):
+        self._empty_cache(monkeypatch)
+
+        with _patch_edid_binding([_native_monitor(flags=0, size=0)]):
+            info = fetch_display_info(native=True)
+
+        assert info.status.type == StatusType.SUCCESS
+        assert info.modules == []
+
+    def test_falls_back_when_reader_unavailable(self, monkeypatch):
+        monkeypatch.setattr(os.path, "isdir", lambda p: False)
+
+        with _patch_edid_binding(None):
+            info = fetch_display_info(native=True)
+
+        assert info.status.type == StatusType.FAILED
+        assert any("/sys/class/drm" in m for m in info.status.messages)
@@ -1,7 +1,8 @@
 import builtins
 import os
 import subprocess
-from unittest.mock import mock_open
+from types import SimpleNamespace
+from unittest.mock import MagicMock, mock_open, patch
 
 from hwprobe.core.linux.graphics import (
     _vram_amd,
@@ -806,3 +807,106 @@ class TestFetchGraphicsInfo:
         assert len(info.modules) == 0
         assert info.status.type == StatusType.PARTIAL
         assert any("Could not open file" in msg for msg in info.status.messages)
+
+
+def _native_gpu(**fields):
+    record = dict(slot="0000:00:02.0", vendor_name=None, device_name=None, subsystem_vendor_name=None,
+                  subsystem_device_name=None, acpi_path=None, pci_path=None, vendor_id=0x8086, device_id=0x5917,
+                  subsystem_vendor_id=0, subsystem_device_id=0, pcie_width=0, pcie_gen=0, vram_mb=0,
+                  product_name=None)
+    record.update(fields)
+    return SimpleNamespace(**record)
+
+
+def _patch_gpu_binding(gpus):
+    """Patches the lazy import in _native_graphics_info so get_gpu_info() returns `gpus`."""
+    mock_module = MagicMock()
+    mock_module.get_gpu_info.return_value = gpus
+    return patch.dict("sys.modules", {"hwprobe.interops.linux.bindings.gpu_info": mock_module})
+
+
+class TestFetchGraphicsInfoNative:
+    """Tests for fetch_graphics_info(native=True), backed by interops/linux."""
+
+    def test_pci_ids_names_replace_lspci(self, monkeypatch):
+        monkeypatch.setattr(subprocess, "run", MagicMock(side_effect=AssertionError("spawned a process")))
+        gpu = _native_gpu(vendor_name="Intel Corporation", device_name="UHD Graphics 620",
+                          subsystem_vendor_name="Lenovo", subsystem_device_name="ThinkPad",
+                          acpi_path="\\_SB.PCI0.GFX0", pci_path="PciRoot(0x0)/Pci(0x2,0x0)", pcie_gen=3)
+
+        with _patch_gpu_binding([gpu]):
+            info = fetch_graphics_info(native=True)
+
+        assert info.status.type == StatusType.SUCCESS
+        module = info.modules[0]
+        assert (module.vendor_id, module.device_id) == ("0x8086", "0x5917")
+        assert (module.manufacturer, module.name) == ("Intel Corporation", "UHD Graphics 620")
+        assert (module.subsystem_manufacturer, module.subsystem_model) == ("Lenovo", "ThinkPad")
+        assert module.pci_path == "PciRoot(0x0)/Pci(0x2,0x0)"
+        assert module.pcie_gen == 3
+        assert module.pcie_width is None
+
+    def test_amd_vram_from_record(self):
+        gpu = _native_gpu(vendor_id=0x1002, device_id=0x73bf, device_name="Navi 21", vendor_name="AMD",
+                          acpi_path="\\_SB.PCI0.GPP0", pcie_width=16, pcie_gen=4, vram_mb=16368)
+
+        with _patch_gpu_binding([gpu]):
+            info = fetch_graphics_info(native=True)
+
+        assert info.modules[0].vram.capacity == 16368
+        assert info.modules[0].pcie_width == 16
+
+    def test_nvidia_vram_from_nvml(self, monkeypatch):
+        monkeypatch.setattr(subprocess, "run", MagicMock(side_effect=AssertionError("spawned a process")))
+        gpu = _native_gpu(slot="0000:01:00.0", vendor_id=0x10de, device_id=0x1c03, vendor_name="NVIDIA Corporation",
+                          device_name="GP106 [GeForce GTX 1060 6GB]", acpi_path="\\_SB.PCI0.PEG0", pcie_gen=3,
+                          vram_mb=6144, product_name="NVIDIA GeForce GTX 1060 6GB")
+
+        with _patch_gpu_binding([gpu]):
+            info = fetch_graphics_info(native=True)
+
+        assert info.status.type == StatusType.SUCCESS
+        module = info.modules[0]
+        assert module.vram.capacity == 6144
+        assert module.name == "GP106 [GeForce GTX 1060 6GB]"
+
+    def test_nvidia_without_nvml_is_partial(self, monkeypatch):
+        monkeypatch.setattr(subprocess, "run", MagicMock(side_effect=AssertionError("spawned a process")))
+        gpu = _native_gpu(slot="0000:01:00.0", vendor_id=0x10de, device_id=0x1c03, vendor_name="NVIDIA Corporation",
+                          device_name="GP106 [GeForce GTX 1060 6GB]", acpi_path="\\_SB.PCI0.PEG0", pcie_gen=3)
+
+        with _patch_gpu_binding([gpu]):
+            info = fetch_graphics_info(native=True)
+
+        assert info.status.type == StatusType.PARTIAL
+        assert any("NVML" in msg for msg in info.status.messages)
+        assert info.modules[0].vram is None
+
+    def test_nvml_name_when_missing_from_pci_ids(self):
+        gpu = _native_gpu(slot="0000:01:00.0", vendor_id=0x10de, device_id=0x2684, acpi_path="\\_SB.PCI0.PEG0",
+                          pcie_gen=4, vram_mb=24564, product_name="NVIDIA GeForce RTX 4090")
+
+        with _patch_gpu_binding([gpu]):
+            info = fetch_graphics_info(native=True)
+
+        assert info.status.type == StatusType.SUCCESS
+        assert info.modules[0].name == "NVIDIA GeForce RTX 4090"
+
+    def test_unknown_device_is_partial(self):
+        with _patch_gpu_binding([_native_gpu(acpi_path="\\_SB.PCI0.GFX0", pcie_gen=3)]):
+            info = fetch_graphics_info(native=True)
+
+        assert info.status.type == StatusType.PARTIAL
+        assert any("pci.ids" in msg for msg in info.status.messages)
+        assert info.modules[0].name is None
+
+    def test_falls_back_when_library_missing(self, monkeypatch):
+        mock_module = MagicMock()
+        mock_module.get_gpu_info.side_effect = RuntimeError("get_gpu_info_arena() failed")
+        monkeypatch.setattr(os.path, "exists", lambda x: False)
+
+        with patch.dict("sys.modules", {"hwprobe.interops.linux.bindings.gpu_info": mock_module}):
+            info = fetch_graphics_info(native=True)
+
+        assert info.status.type == StatusType.FAILED
+        assert "not found" in info.status.messages[0]
@@ -1,6 +1,7 @@
 import builtins
 import os
-from unittest.mock import MagicMock
+from types import SimpleNamespace
+from unittest.mock import MagicMock, patch
 
 from hwprobe.core.linux.memory import (
     fetch_memory_info,
@@ -530,3 +531,46 @@ class TestLinuxMemory:
         # The exception is caught by outer except block
         assert memory_info.status.type == StatusType.PARTIAL
         assert any("Error while fetching Memory Info" in msg for msg in memory_info.status.messages)
+
+
+def _patch_smbios_binding(structures, version=(3, 4, 0)):
+    """Patches the lazy import in _native_memory_info so the binding reports `structures` (raw Type 17 bytes)."""
+    mock_module = MagicMock()
+    mock_module.get_version.return_value = version
+    mock_module.get_structures.return_value = [SimpleNamespace(handle=i) for i in range(len(structures))]
+    mock_module.read_structure.side_effect = lambda handle: structures[handle]
+    return patch.dict("sys.modules", {"hwprobe.interops.linux.bindings.smbios_info": mock_module})
+
+
+class TestFetchMemoryInfoNative:
+    """Tests for fetch_memory_info(native=True), backed by the SMBIOS table of interops/linux."""
+
+    def test_modules_come_from_the_native_table(self, monkeypatch):
+        monkeypatch.setattr(os.path, "isdir", lambda x: False)
+        blobs = [TestLinuxMemory()._create_dmi_blob(dev_loc="DIMM 0"),
+                 TestLinuxMemory()._create_dmi_blob(dev_loc="DIMM 1", extended_size=32768)]
+
+        with _patch_smbios_binding(blobs):
+            memory_info = fetch_memory_info(native=True)
+
+        assert memory_info.status.type == StatusType.SUCCESS
+        assert [m.slot.channel for m in memory_info.modules] == ["DIMM 0", "DIMM 1"]
+        assert memory_info.modules[1].capacity.capacity == 32768
+
+    def test_unreadable_table_falls_back_to_dmi_entries(self, monkeypatch):
+        monkeypatch.setattr(os.path, "isdir", lambda x: False)
+
+        with _patch_smbios_binding([], version=None):
+            memory_info = fetch_memory_info(native=True)
+
+        # The sysfs reader runs and reports why it failed
+        assert memory_info.status.type == StatusType.FAILED
+        assert any("/sys/firmware/dmi/entries" in msg for msg in memory_info.status.messages)
+
+    def test_library_without_read_structure_falls_back(self, monkeypatch):
+        monkeypatch.setattr(os.path, "isdir", lambda x: False)
+
+        with _patch_smbios_binding([None]):
+            memory_info = fetch_memory_info(native=True)
+
+        assert memory_info.status.type == StatusType.FAILED
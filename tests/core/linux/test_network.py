@@ -0,0 +1,61 @@
+import subprocess
+from types import SimpleNamespace
+from unittest.mock import MagicMock, patch
+
+from hwprobe.core.linux.network import fetch_network_info
+from hwprobe.models.status_models import StatusType
+
+
+def _native_nic(**fields):
+    record = dict(interface="enp3s0", link_type="ether", mac_address="00:1a:2b:3c:4d:5e", ipv4_address=None,
+                  ipv6_address=None, device_slot="0000:03:00.0", acpi_path="\\_SB.PCI0.RP05.PXSX",
+                  pci_path="PciRoot(0x0)/Pci(0x1c,0x4)/Pci(0x0,0x0)", vendor_id=0x10ec, device_id=0x8168, if_index=2)
+    record.update(fields)
+    return SimpleNamespace(**record)
+
+
+def _patch_network_binding(nics):
+    """Patches the lazy import in _native_network_info so get_network_info() returns `nics`."""
+    mock_module = MagicMock()
+    mock_module.get_network_info.return_value = nics
+    return patch.dict("sys.modules", {"hwprobe.interops.linux.bindings.network_info": mock_module})
+
+
+class TestFetchNetworkInfoNative:
+    """Tests for fetch_network_info(native=True), backed by interops/linux."""
+
+    def test_physical_interfaces_without_ip_command(self, monkeypatch):
+        monkeypatch.setattr(subprocess, "check_output", MagicMock(side_effect=AssertionError("spawned a process")))
+        nics = [
+            _native_nic(interface="lo", link_type="loopback", device_slot=None, acpi_path=None, pci_path=None,
+                        vendor_id=0, device_id=0, ipv4_address="127.0.0.1", if_index=1),
+            _native_nic(ipv4_address="192.168.1.20", ipv6_address="fe80::1"),
+        ]
+
+        with _patch_network_binding(nics):
+            info = fetch_network_info(native=True)
+
+        assert info.status.type == StatusType.SUCCESS
+        assert len(info.modules) == 1
+        nic = info.modules[0]
+        assert (nic.interface, nic.type, nic.mac_address) == ("enp3s0", "ether", "00:1a:2b:3c:4d:5e")
+        assert nic.ip_address == "192.168.1.20"
+        assert (nic.vendor_id, nic.device_id) == ("0x10ec", "0x8168")
+        assert nic.pci_path == "PciRoot(0x0)/Pci(0x1c,0x4)/Pci(0x0,0x0)"
+
+    def test_ipv6_when_no_ipv4(self):
+        with _patch_network_binding([_native_nic(ipv6_address="fd00::2")]):
+            info = fetch_network_info(native=True)
+
+        assert info.modules[0].ip_address == "fd00::2"
+
+    def test_usb_nic_without_pci_ids_is_partial(self):
+        nic = _native_nic(interface="enx001122", device_slot="2-1:1.0", acpi_path=None, pci_path=None,
+                          vendor_id=0, device_id=0)
+
+        with _patch_network_binding([nic]):
+            info = fetch_network_info(native=True)
+
+        assert info.status.type == StatusType.PARTIAL
+        assert "Vendor ID not found for interface enx001122" in info.status.messages
+        assert info.modules[0].pci_path is None
@@ -379,3 +379,114 @@ class TestGPU:
         data = display.find_monitor_gpu("Empty")
 
         assert data[1] == exp_status
+
+    def test_adapter_map_resolves_without_per_monitor_lookup(self, monkeypatch):
+        def fake_GetDisplayAdapterMap(entries, capacity, count_ptr):
+            count = deref(count_ptr, ctypes.c_int)
+            count.value = 2
+            entries[0].deviceName = b"\\\\.\\DISPLAY1"
+            entries[0].adapterName = b"GPU A"
+            entries[0].adapterLuidLow = 0x1234
+            entries[1].deviceName = b"\\\\.\\DISPLAY2"
+            entries[1].adapterName = b"GPU B"
+            entries[1].adapterLuidLow = 0x5678
+            return STATUS_OK
+
+        def fail_find_monitor_gpu(device_name):
+            raise AssertionError("per-monitor lookup should not be needed")
+
+        monkeypatch.setattr(display, "GetDisplayAdapterMap", fake_GetDisplayAdapterMap)
+        monkeypatch.setattr(display, "find_monitor_gpu", fail_find_monitor_gpu)
+
+        adapter_map = display._fetch_display_adapter_map()
+
+        assert display._resolve_monitor_gpu("\\\\.\\DISPLAY2", None, adapter_map) == "GPU B"
+        assert display._resolve_monitor_gpu(
+            "\\\\.\\DISPLAY9", {"AdapterLUID": "0000000000001234"}, adapter_map
+        ) == "GPU A"
+
+    def test_adapter_map_grows_to_reported_count(self, monkeypatch):
+        capacities = []
+
+        def fake_GetDisplayAdapterMap(entries, capacity, count_ptr):
+            capacities.append(capacity)
+            deref(count_ptr, ctypes.c_int).value = 20
+            return STATUS_OK if capacity >= 20 else STATUS_NOK
+
+        monkeypatch.setattr(display, "GetDisplayAdapterMap", fake_GetDisplayAdapterMap)
+
+        adapter_map = display._fetch_display_adapter_map()
+
+        assert capacities == [16, 20]
+        assert adapter_map is not None
+
+    def test_adapter_map_missing_export_falls_back(self, monkeypatch):
+        monkeypatch.setattr(display, "GetDisplayAdapterMap", None)
+        monkeypatch.setattr(display, "find_monitor_gpu", lambda name: ("GPU C", STATUS_OK))
+
+        assert display._fetch_display_adapter_map() is None
+        assert display._resolve_monitor_gpu("\\\\.\\DISPLAY1", None, None) == "GPU C"
+
+
+class TestDisplayTopology:
+    """Coverage for the binary topology path: GetDisplayTopology(...)"""
+
+    @staticmethod
+    def fake_topology(generation, calls):
+        def fake_GetDisplayTopology(records, capacity, count_ptr, generation_ptr):
+            calls.append(capacity)
+            deref(count_ptr, ctypes.c_int).value = 1
+            deref(generation_ptr, ctypes.c_uint64).value = generation[0]
+            records[0].gdiDeviceName = b"\\\\.\\DISPLAY1"
+            records[0].monitorDevicePath = b"\\\\?\\DISPLAY#TST1234#1&0&UID0"
+            records[0].outputTechnology = 10
+            records[0].refreshNumerator = 144000
+            records[0].refreshDenominator = 1000
+            records[0].width = 2560
+            records[0].height = 1440
+            records[0].adapterLuidLow = 0x1234
+            return STATUS_OK
+
+        return fake_GetDisplayTopology
+
+    def test_records_match_string_format(self, monkeypatch):
+        generation, calls = [1], []
+        monkeypatch.setattr(display, "GetDisplayTopology", self.fake_topology(generation, calls))
+        monkeypatch.setattr(display, "_topology_cache", {"generation": None, "connector_info": None})
+
+        connector_info, error = display._fetch_connector_info()
+
+        assert error is None
+        entry = connector_info["\\\\.\\DISPLAY1"]
+        assert entry["DisplayPath"] == "\\\\?\\DISPLAY#TST1234#1&0&UID0"
+        assert entry["AdapterLUID"] == "0000000000001234"
+        assert entry["RefreshRate"] == 144.0
+        assert (entry["Width"], entry["Height"]) == (2560, 1440)
+        assert display._get_connection_type(entry) == display.DISPLAY_CON_TYPE.get(10)
+
+    def test_unchanged_generation_reuses_result(self, monkeypatch):
+        generation, calls = [7], []
+        monkeypatch.setattr(display, "GetDisplayTopology", self.fake_topology(generation, calls))
+        monkeypatch.setattr(display, "_topology_cache", {"generation": None, "connector_info": None})
+
+        first = display._fetch_display_topology()
+        second = display._fetch_display_topology()
+        generation[0] = 8
+        third = display._fetch_display_topology()
+
+        assert first is second
+        assert third is not first
+        assert len(calls) == 3
+
+    def test_missing_export_uses_string_path(self, monkeypatch):
+        def fake_GetDisplayPathInfo(buffer, size):
+            buffer.value = b"DisplayID=\\\\.\\DISPLAY1|DisplayPath=X|OutputTechnology=5"
+            return STATUS_OK
+
+        monkeypatch.setattr(display, "GetDisplayTopology", None)
+        monkeypatch.setattr(display, "GetDisplayPathInfo", fake_GetDisplayPathInfo)
+
+        connector_info, error = display._fetch_connector_info()
+
+        assert error is None
+        assert connector_info["\\\\.\\DISPLAY1"]["DisplayPath"] == "X"
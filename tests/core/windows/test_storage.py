@@ -0,0 +1,204 @@
+"""
+Tests for hwprobe.core.windows.storage
+
+Strategy: patch the WMI and native storage binding imports so we never load the
+real device_info.dll. The fake `query_wmi_table` returns typed rows, mirroring what
+the binding decodes from the native columnar result; the fake `get_storage_info`
+returns StorageDeviceProperties-like records. A native binding patched to None
+behaves like a DLL without it, so those tests exercise the WMI path.
+
+As with test_graphics.py, the module is loaded directly via importlib to avoid the
+package __init__ chaining into Win32-only ctypes structs.
+"""
+
+import importlib.util
+import pathlib
+import sys
+from dataclasses import dataclass
+from typing import Optional
+from unittest.mock import patch, MagicMock
+
+from hwprobe.models.status_models import StatusType
+
+_MODULE_PATH = (
+    pathlib.Path(__file__).resolve().parents[3]
+    / "src" / "hwprobe" / "core" / "windows" / "storage.py"
+)
+
+_BINDING = "hwprobe.interops.win.bindings.wmi_info"
+_NATIVE_BINDING = "hwprobe.interops.win.bindings.storage_info"
+_MODULE = "hwprobe.core.windows.storage"
+
+
+def _load_storage_module():
+    """Load storage.py directly without triggering the package __init__."""
+    spec = importlib.util.spec_from_file_location(_MODULE, _MODULE_PATH)
+    mod = importlib.util.module_from_spec(spec)
+    sys.modules[_MODULE] = mod
+    spec.loader.exec_module(mod)
+    return mod
+
+
+def _disk(
+    friendly_name="Samsung SSD 980 PRO 1TB",
+    media_type=4,
+    bus_type=17,
+    size=1000204886016,
+    manufacturer=None,
+    model="Samsung SSD 980 PRO 1TB",
+):
+    return {
+        "FriendlyName": friendly_name,
+        "MediaType": media_type,
+        "BusType": bus_type,
+        "Size": size,
+        "Manufacturer": manufacturer,
+        "Model": model,
+    }
+
+
+@dataclass
+class FakeStorageDeviceProperties:
+    product_name: str = "Samsung SSD 980 PRO 1TB"
+    vendor_name: str = ""
+    device_path: Optional[str] = "\\\\.\\PhysicalDrive0"
+    instance_id: Optional[str] = "SCSI\\DISK&VEN_NVME&PROD_SAMSUNG_SSD_980\\5&1A2B3C4D&0&000000"
+    size_bytes: int = 1000204886016
+    bus_type: int = 17
+    media_type: int = 4
+
+
+def _run(rows, native=None):
+    """`native`: the disks the native binding returns, an exception it raises, or None for no binding."""
+    mock_module = MagicMock()
+    mock_module.query_wmi_table.return_value = rows
+    # The rows are typed, as the table exports decode them
+    mock_module.wmi_uint.side_effect = lambda value: value if isinstance(value, int) else None
+    native_module = None
+    if native is not None:
+        native_module = MagicMock()
+        if isinstance(native, Exception):
+            native_module.get_storage_info.side_effect = native
+        else:
+            native_module.get_storage_info.return_value = native
+    sys.modules.pop(_MODULE, None)
+    with patch.dict("sys.modules", {_BINDING: mock_module, _NATIVE_BINDING: native_module}):
+        mod = _load_storage_module()
+        info = mod.fetch_storage_info()
+    sys.modules.pop(_MODULE, None)
+    return info, mock_module
+
+
+class TestHappyPath:
+
+    def test_single_disk_success(self):
+        info, _ = _run([_disk()])
+
+        assert info.status.type == StatusType.SUCCESS
+        assert len(info.modules) == 1
+
+        disk = info.modules[0]
+        assert disk.model == "Samsung SSD 980 PRO 1TB"
+        assert disk.type == "Solid State Drive (SSD)"
+        assert disk.size.capacity == 1000204886016 // (1024 * 1024)
+
+    def test_requests_only_needed_columns(self):
+        _, binding = _run([_disk()])
+
+        query, columns, namespace = binding.query_wmi_table.call_args.args
+        assert columns == ["FriendlyName", "MediaType", "BusType", "Size", "Manufacturer", "Model"]
+        assert query == f"SELECT {', '.join(columns)} FROM MSFT_PhysicalDisk"
+        assert namespace == "ROOT\\Microsoft\\Windows\\Storage"
+
+    def test_many_disks_are_not_truncated(self):
+        rows = [_disk(friendly_name=f"Disk {i}", model=f"Disk {i}", media_type=3, bus_type=11)
+                for i in range(48)]
+        info, _ = _run(rows)
+
+        assert len(info.modules) == 48
+        assert info.modules[-1].model == "Disk 47"
+
+    def test_size_beyond_32_bits(self):
+        size = 20 * 1000 ** 4  # 20 TB
+        info, _ = _run([_disk(size=size, media_type=3, bus_type=11)])
+        assert info.modules[0].size.capacity == size // (1024 * 1024)
+
+
+class TestFieldMapping:
+
+    def test_model_falls_back_to_friendly_name(self):
+        info, _ = _run([_disk(model=None, friendly_name="  WD Red Plus  ")])
+        assert info.modules[0].model == "WD Red Plus"
+
+    def test_nvme_bus_forces_ssd(self):
+        info, _ = _run([_disk(media_type=0, bus_type=17)])
+        assert info.modules[0].type == "Solid State Drive (SSD)"
+
+    def test_unknown_media_type(self):
+        info, _ = _run([_disk(media_type=None, bus_type=11)])
+        assert info.modules[0].type == "Unknown"
+
+    def test_null_size_results_in_none(self):
+        info, _ = _run([_disk(size=None)])
+        assert info.modules[0].size is None
+
+
+class TestErrorHandling:
+
+    def test_query_failure_returns_failed_status(self):
+        info, _ = _run(None)
+        assert info.status.type == StatusType.FAILED
+        assert len(info.modules) == 0
+
+    def test_no_disks_returns_failed_status(self):
+        info, _ = _run([])
+        assert info.status.type == StatusType.FAILED
+        assert any("No storage modules" in msg for msg in info.status.messages)
+
+
+class TestNativeEnumeration:
+
+    def test_native_disks_skip_wmi(self):
+        info, binding = _run([_disk()], native=[FakeStorageDeviceProperties()])
+
+        assert info.status.type == StatusType.SUCCESS
+        binding.query_wmi_table.assert_not_called()
+        disk = info.modules[0]
+        assert disk.model == "Samsung SSD 980 PRO 1TB"
+        assert disk.manufacturer is None
+        assert disk.identifier == "PhysicalDrive0"
+        assert disk.connector == "NVMe"
+        assert disk.type == "Solid State Drive (SSD)"
+        assert disk.size.capacity == 1000204886016 // (1024 * 1024)
+
+    def test_codes_map_like_wmi(self):
+        native = FakeStorageDeviceProperties(product_name="  WDC WD40EFRX-68N32N0  ", vendor_name="WDC ",
+                                             bus_type=11, media_type=3, size_bytes=4000787030016)
+        native_info, _ = _run(None, native=[native])
+        wmi_info, _ = _run([_disk(model="WDC WD40EFRX-68N32N0", manufacturer="WDC", bus_type=11,
+                                  media_type=3, size=4000787030016)])
+
+        for field in ("model", "manufacturer", "type", "connector", "location", "size"):
+            assert getattr(native_info.modules[0], field) == getattr(wmi_info.modules[0], field)
+
+    def test_unknown_seek_penalty_and_size(self):
+        native = FakeStorageDeviceProperties(bus_type=7, media_type=0, size_bytes=0, device_path=None)
+        info, _ = _run(None, native=[native])
+
+        disk = info.modules[0]
+        assert disk.type == "Unspecified"
+        assert disk.location == "External"
+        assert disk.size is None
+        assert disk.identifier is None
+
+    def test_native_failure_falls_back_to_wmi(self):
+        info, binding = _run([_disk()], native=RuntimeError("get_storage_info_arena() failed"))
+
+        binding.query_wmi_table.assert_called_once()
+        assert info.status.type == StatusType.SUCCESS
+
+    def test_no_native_disks_falls_back_to_wmi(self):
+        info, binding = _run([_disk(model="WMI disk")], native=[])
+
+        binding.query_wmi_table.assert_called_once()
+        assert info.modules[0].model == "WMI disk"
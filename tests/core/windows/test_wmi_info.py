@@ -0,0 +1,107 @@
+"""
+Tests for hwprobe.interops.win.bindings.wmi_info against a device_info.dll without the WMI exports
+
+Strategy: load wmi_info.py with ctypes.WinDLL patched to hand out a library that has only the exports of the
+prebuilt DLL (get_gpu_info, wide_to_utf8). The legacy hw_helper binding is patched in sys.modules: a fake
+GetWmiInfo that writes `Name=Value|` text, or None for a checkout without hw_helper.dll.
+
+As with test_storage.py, the modules are loaded directly via importlib to avoid the package __init__
+chaining into Win32-only ctypes structs.
+"""
+
+import importlib.util
+import pathlib
+import sys
+from types import SimpleNamespace
+from unittest.mock import patch
+
+from hwprobe.models.status_models import StatusType
+
+_SRC = pathlib.Path(__file__).resolve().parents[3] / "src" / "hwprobe"
+_BINDING = "hwprobe.interops.win.bindings.wmi_info"
+_LEGACY = "hwprobe.interops.win.legacy.signatures"
+_MEMORY = "hwprobe.core.windows.memory"
+
+
+def _load(name, path, **patches):
+    spec = importlib.util.spec_from_file_location(name, path)
+    mod = importlib.util.module_from_spec(spec)
+    with patch("ctypes.WinDLL", create=True, **patches):
+        spec.loader.exec_module(mod)
+    return mod
+
+
+def _load_binding():
+    """wmi_info bound to a library with the prebuilt DLL's exports only."""
+    prebuilt = SimpleNamespace(get_gpu_info=lambda *args: 0, wide_to_utf8=lambda *args: None)
+    return _load(_BINDING, _SRC / "interops" / "win" / "bindings" / "wmi_info.py", return_value=prebuilt)
+
+
+def _legacy(text_by_query):
+    """A legacy signatures module whose GetWmiInfo answers `text_by_query`, recording its calls."""
+    calls = []
+
+    def get_wmi_info(query, namespace, buffer, size):
+        calls.append((query, namespace))
+        buffer.value = text_by_query.get(query.decode(), "").encode()[:size - 1]
+
+    return SimpleNamespace(GetWmiInfo=get_wmi_info), calls
+
+
+class TestWithoutExports:
+
+    def test_binding_loads_and_pool_is_a_no_op(self):
+        wmi_info = _load_binding()
+
+        assert not wmi_info.enable_session_pool()
+        assert not wmi_info.get_session_pool_stats().enabled
+        with wmi_info.session_pool():
+            pass
+        wmi_info.shutdown_session_pool()
+
+    def test_table_query_falls_back_to_the_legacy_text(self):
+        wmi_info = _load_binding()
+        legacy, calls = _legacy({
+            "SELECT Size, Model FROM MSFT_PhysicalDisk":
+                "Model=0198 SSD|Size=512110190592|\nModel=|Size=|\n",
+        })
+
+        with patch.dict("sys.modules", {_LEGACY: legacy}):
+            rows = wmi_info.query_wmi_table("SELECT Size, Model FROM MSFT_PhysicalDisk", ["Size", "Model"],
+                                            "ROOT\\Microsoft\\Windows\\Storage", timeout_ms=1000)
+
+        assert calls == [(b"SELECT Size, Model FROM MSFT_PhysicalDisk", b"ROOT\\Microsoft\\Windows\\Storage")]
+        assert rows == [{"Size": "512110190592", "Model": "0198 SSD"}, {"Size": None, "Model": None}]
+        assert wmi_info.wmi_uint(rows[0]["Size"]) == 512110190592
+        assert wmi_info.wmi_uint(rows[1]["Size"]) is None
+
+    def test_queries_fail_without_hw_helper(self):
+        wmi_info = _load_binding()
+
+        with patch.dict("sys.modules", {_LEGACY: None}):  # importing it raises ImportError
+            assert wmi_info.query_wmi("SELECT Name FROM Win32_Processor") == ""
+            assert wmi_info.query_wmi_table("SELECT Name FROM Win32_Processor", ["Name"]) is None
+
+    def test_memory_is_collected_through_the_fallback(self):
+        wmi_info = _load_binding()
+        legacy, _ = _legacy({
+            "SELECT MemoryErrorCorrection FROM Win32_PhysicalMemoryArray": "MemoryErrorCorrection=3|\n",
+            "SELECT BankLabel, Capacity, Manufacturer, PartNumber, Speed, DeviceLocator, SMBIOSMemoryType, "
+            "DataWidth, TotalWidth FROM Win32_PhysicalMemory":
+                "BankLabel=BANK 0|Capacity=17179869184|Manufacturer=Kingston|PartNumber=KF3200C16D4/16GX|"
+                "Speed=3200|DeviceLocator=DIMM1|SMBIOSMemoryType=26|DataWidth=64|TotalWidth=64|\n",
+        })
+
+        with patch.dict("sys.modules", {_BINDING: wmi_info}):
+            memory = _load(_MEMORY, _SRC / "core" / "windows" / "memory.py")
+            with patch.dict("sys.modules", {_LEGACY: legacy}):
+                info = memory.fetch_memory_info()
+        sys.modules.pop(_MEMORY, None)
+
+        assert info.status.type != StatusType.FAILED
+        module = info.modules[0]
+        assert module.capacity.capacity == 16384
+        assert module.frequency_mhz == 3200
+        assert module.part_number == "KF3200C16D4/16GX"
+        assert module.type == "DDR4"
+        assert not module.supports_ecc